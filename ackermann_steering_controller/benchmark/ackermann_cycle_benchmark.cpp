@@ -0,0 +1,258 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Replays the control cycle of an AckermannSteeringController on a simulated Ackermann steering bot, with synthetic
+// velocity commands and a simulated clock, so that it runs headless with no ROS master. Odometry, limiter and
+// publishing stages are measured separately, then together as a full cycle.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <ackermann_steering_controller/odometry.h>
+#include <diff_drive_controller/odometry_publisher.h>
+#include <diff_drive_controller/speed_limiter.h>
+#include <nav_msgs/Odometry.h>
+#include <tf2_msgs/TFMessage.h>
+
+using ackermann_steering_controller::Odometry;
+using diff_drive_controller::OdometrySample;
+using diff_drive_controller::SpeedLimiter;
+
+namespace
+{
+
+const double PERIOD = 0.01;
+const ros::Duration PUBLISH_PERIOD(0.02);
+
+/// Geometry of the Ackermann steering test bot:
+const double WHEEL_SEPARATION_H = 0.5;
+const double WHEEL_RADIUS       = 0.11;
+
+/** Synthetic cmd_vel: square waves saturating the limits, switching every 0.64 s and 0.32 s. */
+double linearCommand(unsigned int i)   {return (i & 64) ? 2.0 : -2.0;}
+double steeringCommand(unsigned int i) {return (i & 32) ? 0.8 : -0.8;}
+
+/** Ackermann steering bot with rear wheel and front steering tracking their commands exactly. */
+struct SimulatedAckermannBot
+{
+  SimulatedAckermannBot() : wheel_pos(0.0), wheel_vel(0.0), steer_pos(0.0) {}
+
+  void step() {wheel_pos += wheel_vel * PERIOD;}
+
+  double wheel_pos;
+  double wheel_vel;
+  double steer_pos;
+};
+
+/** Control cycle of AckermannSteeringController::update(), split in stages, with publishers replaced by messages. */
+class AckermannCycle
+{
+public:
+  AckermannCycle()
+    : time_(0.0),
+      last_publish_time_(0.0),
+      cycle_(0),
+      published_(0),
+      limiter_lin_(true, true, true, -1.0, 1.0, -0.5, 0.5, -2.0, 2.0),
+      limiter_ang_(true, true, false, -0.5, 0.5, -1.0, 1.0),
+      last0_lin_(0.0),
+      last1_lin_(0.0),
+      last0_ang_(0.0),
+      last1_ang_(0.0)
+  {
+    odometry_.setWheelParams(WHEEL_SEPARATION_H, WHEEL_RADIUS);
+    odometry_.init(time_);
+
+    odom_.header.frame_id = "odom";
+    odom_.child_frame_id  = "base_link";
+    tf_odom_.transforms.resize(1);
+    tf_odom_.transforms[0].header.frame_id = "odom";
+    tf_odom_.transforms[0].child_frame_id  = "base_link";
+  }
+
+  /** Move the robot along a slalom, for stages measured without the command stage. */
+  void driveWheels()
+  {
+    robot_.wheel_vel = 5.0;
+    robot_.steer_pos = (cycle_ & 64) ? 0.3 : -0.3;
+  }
+
+  void updateOdometry()
+  {
+    odometry_.update(robot_.wheel_pos, robot_.steer_pos, time_);
+
+    sample_.stamp   = time_;
+    sample_.x       = odometry_.getX();
+    sample_.y       = odometry_.getY();
+    sample_.heading = odometry_.getHeading();
+    sample_.linear  = odometry_.getLinear();
+    sample_.angular = odometry_.getAngular();
+  }
+
+  /** Publish schedule and messages of the realtime publishers path. */
+  void publish()
+  {
+    if (!(last_publish_time_ + PUBLISH_PERIOD < sample_.stamp))
+    {
+      return;
+    }
+    last_publish_time_ += PUBLISH_PERIOD;
+
+    const geometry_msgs::Quaternion orientation(diff_drive_controller::quaternionFromYaw(sample_.heading));
+    diff_drive_controller::setOdometry(sample_, orientation, odom_);
+    tf_odom_.transforms[0].header.stamp = sample_.stamp;
+    diff_drive_controller::setOdometryTransform(sample_, orientation, tf_odom_.transforms[0].transform);
+    ++published_;
+  }
+
+  void updateCommand()
+  {
+    double lin = linearCommand(cycle_);
+    double ang = steeringCommand(cycle_);
+    limiter_lin_.limit(lin, last0_lin_, last1_lin_, PERIOD);
+    limiter_ang_.limit(ang, last0_ang_, last1_ang_, PERIOD);
+    last1_lin_ = last0_lin_;
+    last0_lin_ = lin;
+    last1_ang_ = last0_ang_;
+    last0_ang_ = ang;
+
+    robot_.wheel_vel = lin / WHEEL_RADIUS;
+    robot_.steer_pos = ang;
+  }
+
+  /** Advance the simulated clock and robot by one period. */
+  void step()
+  {
+    time_ += ros::Duration(PERIOD);
+    robot_.step();
+    ++cycle_;
+  }
+
+  void cycle()
+  {
+    updateOdometry();
+    publish();
+    updateCommand();
+    step();
+  }
+
+  const OdometrySample& sample() const {return sample_;}
+  const nav_msgs::Odometry& odom() const {return odom_;}
+  double wheelVelocity() const {return robot_.wheel_vel;}
+  unsigned int published() const {return published_;}
+
+private:
+  ros::Time time_;
+  ros::Time last_publish_time_;
+  unsigned int cycle_;
+  unsigned int published_;
+
+  SimulatedAckermannBot robot_;
+  Odometry odometry_;
+  SpeedLimiter limiter_lin_;
+  SpeedLimiter limiter_ang_;
+  double last0_lin_;
+  double last1_lin_;
+  double last0_ang_;
+  double last1_ang_;
+
+  OdometrySample sample_;
+  nav_msgs::Odometry odom_;
+  tf2_msgs::TFMessage tf_odom_;
+};
+
+} // namespace
+
+static void BM_AckermannOdometry(benchmark::State& state)
+{
+  AckermannCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.driveWheels();
+    cycle.updateOdometry();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.sample());
+}
+BENCHMARK(BM_AckermannOdometry);
+
+static void BM_AckermannLimiter(benchmark::State& state)
+{
+  AckermannCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.updateCommand();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.wheelVelocity());
+}
+BENCHMARK(BM_AckermannLimiter);
+
+// Includes the odometry stage, which provides the published samples
+static void BM_AckermannPublish(benchmark::State& state)
+{
+  AckermannCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.driveWheels();
+    cycle.updateOdometry();
+    cycle.publish();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.odom());
+  state.counters["published"] = benchmark::Counter(cycle.published(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_AckermannPublish);
+
+static void BM_AckermannCycle(benchmark::State& state)
+{
+  AckermannCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.cycle();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.odom());
+  benchmark::DoNotOptimize(cycle.wheelVelocity());
+}
+BENCHMARK(BM_AckermannCycle);
+
+BENCHMARK_MAIN();
@@ -36,16 +36,18 @@
  * Author: Masaru Morita, Bence Magyar, Enrique Fernández
  */
 
+#include <ackermann_msgs/AckermannDriveStamped.h>
 #include <ackermann_steering_controller/odometry.h>
+#include <ackermann_steering_controller/steering_scheduler.h>
+#include <controller_instrumentation/command_channel_monitor.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
 #include <controller_interface/controller.h>
 #include <controller_interface/multi_interface_controller.h>
+#include <diff_drive_controller/base_odometry_publisher.h>
 #include <diff_drive_controller/speed_limiter.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <memory>
-#include <nav_msgs/Odometry.h>
-#include <realtime_tools/realtime_buffer.h>
-#include <realtime_tools/realtime_publisher.h>
-#include <tf/tfMessage.h>
 
 namespace ackermann_steering_controller{
 
@@ -99,9 +101,14 @@ namespace ackermann_steering_controller{
   private:
     std::string name_;
 
+    /// Audit of realtime-unsafe operations in update():
+    controller_instrumentation::RealtimeAudit rt_audit_;
+
+    /// Write statistics of the velocity command channels:
+    controller_instrumentation::CommandChannelMonitor command_monitor_;
+
     /// Odometry related:
     ros::Duration publish_period_;
-    ros::Time last_state_publish_time_;
     bool open_loop_;
 
     /// Hardware handles:
@@ -113,18 +120,24 @@ namespace ackermann_steering_controller{
     {
       double lin;
       double ang;
+      /// Steering velocity limit [rad/s], 0 for none:
+      double steering_velocity;
       ros::Time stamp;
 
-      Commands() : lin(0.0), ang(0.0), stamp(0.0) {}
+      Commands() : lin(0.0), ang(0.0), steering_velocity(0.0), stamp(0.0) {}
     };
-    realtime_tools::RealtimeBuffer<Commands> command_;
+    controller_instrumentation::CommandChannel<Commands> command_;
     Commands command_struct_;
     ros::Subscriber sub_command_;
 
+    /// Ackermann command related, the most recent of the twist and Ackermann commands applies:
+    controller_instrumentation::CommandChannel<Commands> command_ackermann_;
+    Commands command_struct_ackermann_;
+    ros::Subscriber sub_command_ackermann_;
+
     /// Odometry related:
-    std::shared_ptr<realtime_tools::RealtimePublisher<nav_msgs::Odometry> > odom_pub_;
-    std::shared_ptr<realtime_tools::RealtimePublisher<tf::tfMessage> > tf_odom_pub_;
     Odometry odometry_;
+    diff_drive_controller::BaseOdometryPublisher odom_publisher_;
 
     /// Wheel separation, wrt the midpoint of the wheel width:
     double wheel_separation_h_;
@@ -164,6 +177,10 @@ namespace ackermann_steering_controller{
     diff_drive_controller::SpeedLimiter limiter_lin_;
     diff_drive_controller::SpeedLimiter limiter_ang_;
 
+    /// Whether to schedule the commands around the steering actuator lag:
+    bool steering_lag_enabled_;
+    SteeringScheduler steering_scheduler_;
+
   private:
     /**
      * \brief Brakes the wheels, i.e. sets the velocity to 0
@@ -176,6 +193,12 @@ namespace ackermann_steering_controller{
      */
     void cmdVelCallback(const geometry_msgs::Twist& command);
 
+    /**
+     * \brief Ackermann command callback
+     * \param command Speed, steering angle and steering angle velocity command message
+     */
+    void cmdAckermannCallback(const ackermann_msgs::AckermannDriveStamped& command);
+
     /**
      * \brief Sets odometry parameters from the URDF, i.e. the wheel radius and separation
      * \param root_nh Root node handle
@@ -188,13 +211,6 @@ namespace ackermann_steering_controller{
                                bool lookup_wheel_separation_h,
                                bool lookup_wheel_radius);
 
-    /**
-     * \brief Sets the odometry publishing fields
-     * \param root_nh Root node handle
-     * \param controller_nh Node handle inside the controller namespace
-     */
-    void setOdomPubFields(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh);
-
   };
 
 } // namespace ackermann_drive_controller
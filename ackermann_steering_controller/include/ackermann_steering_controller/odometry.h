@@ -44,15 +44,10 @@
 #define ODOMETRY_ACKERMANN_STEERING_H_
 
 #include <ros/time.h>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/rolling_mean.hpp>
-#include <boost/function.hpp>
+#include <controller_instrumentation/rolling_mean.h>
 
 namespace ackermann_steering_controller
 {
-  namespace bacc = boost::accumulators;
-
   /**
    * \brief The Odometry class handles odometry readings
    * (2D pose and velocity with related timestamp)
@@ -61,8 +56,12 @@ namespace ackermann_steering_controller
   {
   public:
 
-    /// Integration function, used to integrate the odometry:
-    typedef boost::function<void(double, double)> IntegrationFunction;
+    /// Method used to integrate the odometry:
+    enum IntegrationMethod
+    {
+      EXACT,
+      RUNGE_KUTTA_2
+    };
 
     /**
      * \brief Constructor
@@ -153,11 +152,23 @@ namespace ackermann_steering_controller
      */
     void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
 
+    /**
+     * \brief Integration method setter
+     * \param integration_method Method used to integrate the odometry, exact by default
+     */
+    void setIntegrationMethod(IntegrationMethod integration_method);
+
   private:
 
-    /// Rolling mean accumulator and window:
-    typedef bacc::accumulator_set<double, bacc::stats<bacc::tag::rolling_mean> > RollingMeanAcc;
-    typedef bacc::tag::rolling_window RollingWindow;
+    /// Rolling mean accumulator, preallocated to the velocity rolling window size:
+    typedef controller_instrumentation::RollingMean<double> RollingMeanAcc;
+
+    /**
+     * \brief Integrates the velocities (linear and angular) with the configured integration method
+     * \param linear  Linear  velocity   [m] (linear  displacement, i.e. m/s * dt) computed by encoders
+     * \param angular Angular velocity [rad] (angular displacement, i.e. m/s * dt) computed by encoders
+     */
+    void integrate(double linear, double angular);
 
     /**
      * \brief Integrates the velocities (linear and angular) using 2nd order Runge-Kutta
@@ -202,8 +213,8 @@ namespace ackermann_steering_controller
     RollingMeanAcc linear_acc_;
     RollingMeanAcc angular_acc_;
 
-    /// Integration funcion, used to integrate the odometry:
-    IntegrationFunction integrate_fun_;
+    /// Integration method, dispatched with a switch so the integrator inlines into the updates:
+    IntegrationMethod integration_method_;
   };
 }
 
@@ -0,0 +1,93 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef STEERING_SCHEDULER_ACKERMANN_STEERING_H_
+#define STEERING_SCHEDULER_ACKERMANN_STEERING_H_
+
+namespace ackermann_steering_controller
+{
+  /**
+   * \brief The SteeringScheduler class schedules the steering and wheel commands around a steering actuator modelled
+   * as a first order lag
+   *
+   * The steering actuator is commanded with a lead, so that under the lag model it reaches the commanded angle within
+   * the preview time, and the wheel speed is reduced while the measured steering angle is away from the commanded
+   * one, so that the wheel doesn't drive out of the commanded curvature.
+   */
+  class SteeringScheduler
+  {
+  public:
+    SteeringScheduler();
+
+    /**
+     * \brief Sets the actuator model and scheduling parameters
+     * \param time_constant   Time constant of the steering actuator [s], 0 disables the lead
+     * \param preview_time    Time to reach the commanded angle [s], 0 disables the lead
+     * \param tolerance       Steering angle error under which the wheel speed is not reduced [rad]
+     * \param min_speed_ratio Lowest ratio the wheel speed is reduced to, within [0, 1]
+     * \return true if the parameters are valid; false otherwise
+     */
+    bool setParams(double time_constant, double preview_time, double tolerance, double min_speed_ratio);
+
+    /**
+     * \brief Steering actuator command
+     * \param steering          Commanded steering angle [rad]
+     * \param measured_steering Measured steering angle [rad]
+     * \return Steering angle to command to the actuator [rad]
+     * \note This method is realtime-safe
+     */
+    double steeringCommand(double steering, double measured_steering) const
+    {
+      return measured_steering + lead_gain_*(steering - measured_steering);
+    }
+
+    /**
+     * \brief Wheel speed ratio
+     * \param steering          Commanded steering angle [rad]
+     * \param measured_steering Measured steering angle [rad]
+     * \return Ratio to apply to the commanded wheel speed, within [min_speed_ratio, 1]
+     * \note This method is realtime-safe
+     */
+    double speedRatio(double steering, double measured_steering) const;
+
+  private:
+    /// Gain on the steering error, so that the lag model reaches the commanded angle within the preview time:
+    double lead_gain_;
+
+    double tolerance_;
+    double min_speed_ratio_;
+  };
+}
+
+#endif /* STEERING_SCHEDULER_ACKERMANN_STEERING_H_ */
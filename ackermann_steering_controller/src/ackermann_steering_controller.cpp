@@ -36,10 +36,10 @@
  * Author: Masaru Morita, Bence Magyar, Enrique Fernández
  */
 
+#include <algorithm>
 #include <cmath>
+#include <diff_drive_controller/urdf_model_cache.h>
 #include <pluginlib/class_list_macros.h>
-#include <tf/transform_datatypes.h>
-#include <urdf_parser/urdf_parser.h>
 
 #include <ackermann_steering_controller/ackermann_steering_controller.h>
 
@@ -108,6 +108,7 @@ namespace ackermann_steering_controller{
   AckermannSteeringController::AckermannSteeringController()
     : open_loop_(false)
     , command_struct_()
+    , command_struct_ackermann_()
     , wheel_separation_h_(0.0)
     , wheel_radius_(0.0)
     , wheel_separation_h_multiplier_(1.0)
@@ -119,6 +120,7 @@ namespace ackermann_steering_controller{
     , odom_frame_id_("odom")
     , enable_odom_tf_(true)
     , wheel_joints_size_(0)
+    , steering_lag_enabled_(false)
   {
   }
 
@@ -139,6 +141,11 @@ namespace ackermann_steering_controller{
     std::size_t id = complete_ns.find_last_of("/");
     name_ = complete_ns.substr(id + 1);
 
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope =
+      controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh, name_);
+    if (!thread_placement_scope) {return false;}
+
     //-- single rear wheel joint
     std::string rear_wheel_name = "rear_wheel_joint";
     controller_nh.param("rear_wheel", rear_wheel_name, rear_wheel_name);
@@ -215,6 +222,30 @@ namespace ackermann_steering_controller{
     controller_nh.param("angular/z/max_jerk"               , limiter_ang_.max_jerk               ,  limiter_ang_.max_jerk              );
     controller_nh.param("angular/z/min_jerk"               , limiter_ang_.min_jerk               , -limiter_ang_.max_jerk              );
 
+    // Steering actuator lag:
+    controller_nh.param("steering_lag/enabled", steering_lag_enabled_, steering_lag_enabled_);
+    if (steering_lag_enabled_)
+    {
+      double time_constant, preview_time, tolerance, min_speed_ratio;
+      controller_nh.param("steering_lag/time_constant"  , time_constant  , 0.0 );
+      controller_nh.param("steering_lag/preview_time"   , preview_time   , 0.0 );
+      controller_nh.param("steering_lag/tolerance"      , tolerance      , 0.05);
+      controller_nh.param("steering_lag/min_speed_ratio", min_speed_ratio, 0.0 );
+      if (!steering_scheduler_.setParams(time_constant, preview_time, tolerance, min_speed_ratio))
+      {
+        ROS_ERROR_STREAM_NAMED(name_,
+            "Invalid steering lag params: time constant " << time_constant
+            << " and preview time " << preview_time << " must not be negative, tolerance " << tolerance
+            << " must be positive and min speed ratio " << min_speed_ratio << " within [0, 1].");
+        return false;
+      }
+      ROS_INFO_STREAM_NAMED(name_,
+                            "Steering lag compensation: time constant " << time_constant
+                            << "s, preview time " << preview_time
+                            << "s, tolerance " << tolerance
+                            << "rad, min speed ratio " << min_speed_ratio << ".");
+    }
+
     // If either parameter is not available, we need to look up the value in the URDF
     bool lookup_wheel_separation_h = !controller_nh.getParam("wheel_separation_h", wheel_separation_h_);
     bool lookup_wheel_radius = !controller_nh.getParam("wheel_radius", wheel_radius_);
@@ -237,7 +268,7 @@ namespace ackermann_steering_controller{
                           "Odometry params : wheel separation height " << ws_h
                           << ", wheel radius " << wr);
 
-    setOdomPubFields(root_nh, controller_nh);
+    odom_publisher_.init(name_, root_nh, controller_nh, odom_frame_id_, base_frame_id_, publish_period_, enable_odom_tf_);
 
     //-- rear wheel
     //---- handles need to be previously registerd in ackermann_steering_test.cpp
@@ -251,6 +282,13 @@ namespace ackermann_steering_controller{
     ROS_INFO_STREAM_NAMED(name_,
                           "Adding the subscriber: cmd_vel");
     sub_command_ = controller_nh.subscribe("cmd_vel", 1, &AckermannSteeringController::cmdVelCallback, this);
+    ROS_INFO_STREAM_NAMED(name_,
+                          "Adding the subscriber: cmd_ackermann");
+    sub_command_ackermann_ = controller_nh.subscribe("cmd_ackermann", 1, &AckermannSteeringController::cmdAckermannCallback, this);
+    rt_audit_.init(controller_nh, name_);
+    command_monitor_.add("cmd_vel", command_.stats());
+    command_monitor_.add("cmd_ackermann", command_ackermann_.stats());
+    command_monitor_.init(controller_nh, name_);
     ROS_INFO_STREAM_NAMED(name_, "Finished controller initialization");
 
     return true;
@@ -258,6 +296,8 @@ namespace ackermann_steering_controller{
 
   void AckermannSteeringController::update(const ros::Time& time, const ros::Duration& period)
   {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
     // COMPUTE AND PUBLISH ODOMETRY
     if (open_loop_)
     {
@@ -277,40 +317,21 @@ namespace ackermann_steering_controller{
     }
 
     // Publish odometry message
-    if (last_state_publish_time_ + publish_period_ < time)
-    {
-      last_state_publish_time_ += publish_period_;
-      // Compute and store orientation info
-      const geometry_msgs::Quaternion orientation(
-            tf::createQuaternionMsgFromYaw(odometry_.getHeading()));
-
-      // Populate odom message and publish
-      if (odom_pub_->trylock())
-      {
-        odom_pub_->msg_.header.stamp = time;
-        odom_pub_->msg_.pose.pose.position.x = odometry_.getX();
-        odom_pub_->msg_.pose.pose.position.y = odometry_.getY();
-        odom_pub_->msg_.pose.pose.orientation = orientation;
-        odom_pub_->msg_.twist.twist.linear.x  = odometry_.getLinear();
-        odom_pub_->msg_.twist.twist.angular.z = odometry_.getAngular();
-        odom_pub_->unlockAndPublish();
-      }
-
-      // Publish tf /odom frame
-      if (enable_odom_tf_ && tf_odom_pub_->trylock())
-      {
-        geometry_msgs::TransformStamped& odom_frame = tf_odom_pub_->msg_.transforms[0];
-        odom_frame.header.stamp = time;
-        odom_frame.transform.translation.x = odometry_.getX();
-        odom_frame.transform.translation.y = odometry_.getY();
-        odom_frame.transform.rotation = orientation;
-        tf_odom_pub_->unlockAndPublish();
-      }
-    }
+    diff_drive_controller::OdometrySample sample;
+    sample.stamp   = time;
+    sample.x       = odometry_.getX();
+    sample.y       = odometry_.getY();
+    sample.heading = odometry_.getHeading();
+    sample.linear  = odometry_.getLinear();
+    sample.angular = odometry_.getAngular();
+    odom_publisher_.update(sample);
 
     // MOVE ROBOT
     // Retreive current velocity command and time step:
     Commands curr_cmd = *(command_.readFromRT());
+    const Commands& curr_cmd_ackermann = *(command_ackermann_.readFromRT());
+    if (curr_cmd_ackermann.stamp > curr_cmd.stamp)
+      curr_cmd = curr_cmd_ackermann;
     const double dt = (time - curr_cmd.stamp).toSec();
 
     // Brake if cmd_vel has timeout:
@@ -326,13 +347,34 @@ namespace ackermann_steering_controller{
     limiter_lin_.limit(curr_cmd.lin, last0_cmd_.lin, last1_cmd_.lin, cmd_dt);
     limiter_ang_.limit(curr_cmd.ang, last0_cmd_.ang, last1_cmd_.ang, cmd_dt);
 
+    // Limit the steering velocity requested along with an Ackermann command:
+    if (curr_cmd.steering_velocity > 0.0)
+    {
+      const double max_steering_step = curr_cmd.steering_velocity * cmd_dt;
+      curr_cmd.ang = std::min(std::max(curr_cmd.ang, last0_cmd_.ang - max_steering_step),
+                              last0_cmd_.ang + max_steering_step);
+    }
+
+    // Lead the steering actuator, and hold the wheel back until the steering converges.
+    // The reduced speed is what the limiters ramp up from on the next cycles:
+    double steer_cmd = curr_cmd.ang;
+    if (steering_lag_enabled_)
+    {
+      const double steer_pos = front_steer_joint_.getPosition();
+      if (!std::isnan(steer_pos))
+      {
+        curr_cmd.lin *= steering_scheduler_.speedRatio(curr_cmd.ang, steer_pos);
+        steer_cmd = steering_scheduler_.steeringCommand(curr_cmd.ang, steer_pos);
+      }
+    }
+
     last1_cmd_ = last0_cmd_;
     last0_cmd_ = curr_cmd;
 
     // Set Command
     const double wheel_vel = curr_cmd.lin/wheel_radius_; // omega = linear_vel / radius
     rear_wheel_joint_.setCommand(wheel_vel);
-    front_steer_joint_.setCommand(curr_cmd.ang);
+    front_steer_joint_.setCommand(steer_cmd);
 
   }
 
@@ -341,7 +383,7 @@ namespace ackermann_steering_controller{
     brake();
 
     // Register starting time used to keep fixed rate
-    last_state_publish_time_ = time;
+    odom_publisher_.starting(time);
 
     odometry_.init(time);
   }
@@ -349,6 +391,7 @@ namespace ackermann_steering_controller{
   void AckermannSteeringController::stopping(const ros::Time& /*time*/)
   {
     brake();
+    odom_publisher_.stopping();
   }
 
   void AckermannSteeringController::brake()
@@ -389,6 +432,35 @@ namespace ackermann_steering_controller{
     }
   }
 
+  void AckermannSteeringController::cmdAckermannCallback(const ackermann_msgs::AckermannDriveStamped& command)
+  {
+    if (isRunning())
+    {
+      if (std::isnan(command.drive.speed) || std::isnan(command.drive.steering_angle) ||
+          std::isnan(command.drive.steering_angle_velocity))
+      {
+        ROS_WARN_THROTTLE_NAMED(1.0, name_, "Received NaN in ackermann_msgs::AckermannDriveStamped. Ignoring command.");
+        return;
+      }
+
+      // The steering angle is commanded as is, so it skips the twist conversion:
+      command_struct_ackermann_.ang   = command.drive.steering_angle;
+      command_struct_ackermann_.lin   = command.drive.speed;
+      command_struct_ackermann_.steering_velocity = std::abs(command.drive.steering_angle_velocity);
+      command_struct_ackermann_.stamp = ros::Time::now();
+      command_ackermann_.writeFromNonRT (command_struct_ackermann_);
+      ROS_DEBUG_STREAM_NAMED(name_,
+                             "Added values to Ackermann command. "
+                             << "Steering angle: "    << command_struct_ackermann_.ang << ", "
+                             << "Speed: "             << command_struct_ackermann_.lin << ", "
+                             << "Steering velocity: " << command_struct_ackermann_.steering_velocity << ", "
+                             << "Stamp: "             << command_struct_ackermann_.stamp);
+    }
+    else
+    {
+      ROS_ERROR_NAMED(name_, "Can't accept new commands. Controller is not running.");
+    }
+  }
 
   bool AckermannSteeringController::setOdomParamsFromUrdf(ros::NodeHandle& root_nh,
                              const std::string rear_wheel_name,
@@ -412,7 +484,12 @@ namespace ackermann_steering_controller{
       return false;
     }
 
-    urdf::ModelInterfaceSharedPtr model(urdf::parseURDF(robot_model_str));
+    urdf::ModelInterfaceConstSharedPtr model(diff_drive_controller::UrdfModelCache::get(robot_model_str));
+    if (!model)
+    {
+      ROS_ERROR_NAMED(name_, "Robot description couldn't be parsed.");
+      return false;
+    }
 
     urdf::JointConstSharedPtr rear_wheel_joint(model->getJoint(rear_wheel_name));
     urdf::JointConstSharedPtr front_steer_joint(model->getJoint(front_steer_name));
@@ -465,52 +542,5 @@ namespace ackermann_steering_controller{
     return true;
   }
 
-  void AckermannSteeringController::setOdomPubFields(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh)
-  {
-    // Get and check params for covariances
-    XmlRpc::XmlRpcValue pose_cov_list;
-    controller_nh.getParam("pose_covariance_diagonal", pose_cov_list);
-    ROS_ASSERT(pose_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-    ROS_ASSERT(pose_cov_list.size() == 6);
-    for (int i = 0; i < pose_cov_list.size(); ++i)
-      ROS_ASSERT(pose_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-
-    XmlRpc::XmlRpcValue twist_cov_list;
-    controller_nh.getParam("twist_covariance_diagonal", twist_cov_list);
-    ROS_ASSERT(twist_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-    ROS_ASSERT(twist_cov_list.size() == 6);
-    for (int i = 0; i < twist_cov_list.size(); ++i)
-      ROS_ASSERT(twist_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-
-    // Setup odometry realtime publisher + odom message constant fields
-    odom_pub_.reset(new realtime_tools::RealtimePublisher<nav_msgs::Odometry>(controller_nh, "odom", 100));
-    odom_pub_->msg_.header.frame_id = odom_frame_id_;
-    odom_pub_->msg_.child_frame_id = base_frame_id_;
-    odom_pub_->msg_.pose.pose.position.z = 0;
-    odom_pub_->msg_.pose.covariance = {
-        static_cast<double>(pose_cov_list[0]), 0., 0., 0., 0., 0.,
-        0., static_cast<double>(pose_cov_list[1]), 0., 0., 0., 0.,
-        0., 0., static_cast<double>(pose_cov_list[2]), 0., 0., 0.,
-        0., 0., 0., static_cast<double>(pose_cov_list[3]), 0., 0.,
-        0., 0., 0., 0., static_cast<double>(pose_cov_list[4]), 0.,
-        0., 0., 0., 0., 0., static_cast<double>(pose_cov_list[5]) };
-    odom_pub_->msg_.twist.twist.linear.y  = 0;
-    odom_pub_->msg_.twist.twist.linear.z  = 0;
-    odom_pub_->msg_.twist.twist.angular.x = 0;
-    odom_pub_->msg_.twist.twist.angular.y = 0;
-    odom_pub_->msg_.twist.covariance = {
-        static_cast<double>(twist_cov_list[0]), 0., 0., 0., 0., 0.,
-        0., static_cast<double>(twist_cov_list[1]), 0., 0., 0., 0.,
-        0., 0., static_cast<double>(twist_cov_list[2]), 0., 0., 0.,
-        0., 0., 0., static_cast<double>(twist_cov_list[3]), 0., 0.,
-        0., 0., 0., 0., static_cast<double>(twist_cov_list[4]), 0.,
-        0., 0., 0., 0., 0., static_cast<double>(twist_cov_list[5]) };
-    tf_odom_pub_.reset(new realtime_tools::RealtimePublisher<tf::tfMessage>(root_nh, "/tf", 100));
-    tf_odom_pub_->msg_.transforms.resize(1);
-    tf_odom_pub_->msg_.transforms[0].transform.translation.z = 0.0;
-    tf_odom_pub_->msg_.transforms[0].child_frame_id = base_frame_id_;
-    tf_odom_pub_->msg_.transforms[0].header.frame_id = odom_frame_id_;
-  }
-
   PLUGINLIB_EXPORT_CLASS(ackermann_steering_controller::AckermannSteeringController, controller_interface::ControllerBase)
 } // namespace ackermann_steering_controller
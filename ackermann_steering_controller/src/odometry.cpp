@@ -40,14 +40,12 @@
  * Author: Masaru Morita
  */
 
-#include <ackermann_steering_controller/odometry.h>
+#include <cmath>
 
-#include <boost/bind.hpp>
+#include <ackermann_steering_controller/odometry.h>
 
 namespace ackermann_steering_controller
 {
-  namespace bacc = boost::accumulators;
-
   Odometry::Odometry(size_t velocity_rolling_window_size)
   : timestamp_(0.0)
   , x_(0.0)
@@ -59,9 +57,9 @@ namespace ackermann_steering_controller
   , wheel_radius_(0.0)
   , rear_wheel_old_pos_(0.0)
   , velocity_rolling_window_size_(velocity_rolling_window_size)
-  , linear_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , angular_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , integrate_fun_(boost::bind(&Odometry::integrateExact, this, _1, _2))
+  , linear_acc_(velocity_rolling_window_size)
+  , angular_acc_(velocity_rolling_window_size)
+  , integration_method_(EXACT)
   {
   }
 
@@ -92,7 +90,7 @@ namespace ackermann_steering_controller
     const double angular = tan(front_steer_pos) * linear / wheel_separation_h_;
 
     /// Integrate odometry:
-    integrate_fun_(linear, angular);
+    integrate(linear, angular);
 
     /// We cannot estimate the speed with very small time intervals:
     const double dt = (time - timestamp_).toSec();
@@ -102,11 +100,11 @@ namespace ackermann_steering_controller
     timestamp_ = time;
 
     /// Estimate speeds using a rolling mean to filter them out:
-    linear_acc_(linear/dt);
-    angular_acc_(angular/dt);
+    linear_acc_.push(linear/dt);
+    angular_acc_.push(angular/dt);
 
-    linear_ = bacc::rolling_mean(linear_acc_);
-    angular_ = bacc::rolling_mean(angular_acc_);
+    linear_ = linear_acc_.mean();
+    angular_ = angular_acc_.mean();
 
     return true;
   }
@@ -120,7 +118,7 @@ namespace ackermann_steering_controller
     /// Integrate odometry:
     const double dt = (time - timestamp_).toSec();
     timestamp_ = time;
-    integrate_fun_(linear * dt, angular * dt);
+    integrate(linear * dt, angular * dt);
   }
 
   void Odometry::setWheelParams(double wheel_separation_h, double wheel_radius)
@@ -133,7 +131,28 @@ namespace ackermann_steering_controller
   {
     velocity_rolling_window_size_ = velocity_rolling_window_size;
 
-    resetAccumulators();
+    // Preallocate the rolling windows, so that resetting them from the control loop does not allocate
+    linear_acc_.resize(velocity_rolling_window_size_);
+    angular_acc_.resize(velocity_rolling_window_size_);
+  }
+
+  void Odometry::setIntegrationMethod(IntegrationMethod integration_method)
+  {
+    integration_method_ = integration_method;
+  }
+
+  void Odometry::integrate(double linear, double angular)
+  {
+    switch (integration_method_)
+    {
+      case RUNGE_KUTTA_2:
+        integrateRungeKutta2(linear, angular);
+        break;
+      case EXACT:
+      default:
+        integrateExact(linear, angular);
+        break;
+    }
   }
 
   void Odometry::integrateRungeKutta2(double linear, double angular)
@@ -168,8 +187,8 @@ namespace ackermann_steering_controller
 
   void Odometry::resetAccumulators()
   {
-    linear_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
-    angular_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
+    linear_acc_.reset();
+    angular_acc_.reset();
   }
 
 } // namespace diff_drive_controller
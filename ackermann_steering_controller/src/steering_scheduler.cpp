@@ -0,0 +1,77 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <ackermann_steering_controller/steering_scheduler.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ackermann_steering_controller
+{
+  SteeringScheduler::SteeringScheduler()
+  : lead_gain_(1.0)
+  , tolerance_(0.0)
+  , min_speed_ratio_(1.0)
+  {
+  }
+
+  bool SteeringScheduler::setParams(double time_constant, double preview_time,
+                                    double tolerance, double min_speed_ratio)
+  {
+    if (time_constant < 0.0 || preview_time < 0.0 || tolerance <= 0.0 ||
+        min_speed_ratio < 0.0 || min_speed_ratio > 1.0)
+      return false;
+
+    // Under the first order lag, the error decays by exp(-preview_time/time_constant) within the preview time, so the
+    // error is amplified for the remainder to be the commanded angle:
+    if (time_constant > 0.0 && preview_time > 0.0)
+      lead_gain_ = 1.0/(1.0 - std::exp(-preview_time/time_constant));
+    else
+      lead_gain_ = 1.0;
+
+    tolerance_ = tolerance;
+    min_speed_ratio_ = min_speed_ratio;
+    return true;
+  }
+
+  double SteeringScheduler::speedRatio(double steering, double measured_steering) const
+  {
+    // Slow down in proportion to the steering error beyond the tolerance:
+    const double error = std::abs(steering - measured_steering);
+    if (error <= tolerance_)
+      return 1.0;
+    return std::max(min_speed_ratio_, tolerance_/error);
+  }
+
+} // namespace ackermann_steering_controller
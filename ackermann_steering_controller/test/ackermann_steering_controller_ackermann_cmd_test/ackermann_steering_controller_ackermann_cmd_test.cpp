@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2013, PAL Robotics S.L.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of PAL Robotics, Inc. nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../common/include/test_common.h"
+#include <ackermann_msgs/AckermannDriveStamped.h>
+
+class AckermannCmdTest : public AckermannSteeringControllerTest
+{
+public:
+  AckermannCmdTest()
+  : cmd_ackermann_pub(nh.advertise<ackermann_msgs::AckermannDriveStamped>("cmd_ackermann", 100))
+  {
+  }
+
+  void publishAckermann(double speed, double steering_angle, double steering_angle_velocity = 0.0)
+  {
+    ackermann_msgs::AckermannDriveStamped cmd;
+    cmd.drive.speed = speed;
+    cmd.drive.steering_angle = steering_angle;
+    cmd.drive.steering_angle_velocity = steering_angle_velocity;
+    cmd_ackermann_pub.publish(cmd);
+  }
+
+  void waitForController()
+  {
+    while(!isControllerAlive() || cmd_ackermann_pub.getNumSubscribers() == 0)
+    {
+      ros::Duration(0.1).sleep();
+    }
+  }
+
+private:
+  ros::NodeHandle nh;
+  ros::Publisher cmd_ackermann_pub;
+};
+
+// TEST CASES
+TEST_F(AckermannCmdTest, testForward)
+{
+  waitForController();
+  // zero everything before test
+  publishAckermann(0.0, 0.0);
+  ros::Duration(0.1).sleep();
+  // get initial odom
+  nav_msgs::Odometry old_odom = getLastOdom();
+  // send a speed command of 0.1 m/s
+  publishAckermann(0.1, 0.0);
+  // wait for 10s
+  ros::Duration(10.0).sleep();
+
+  nav_msgs::Odometry new_odom = getLastOdom();
+
+  // check if the robot traveled 1 meter in XY plane
+  const double dx = new_odom.pose.pose.position.x - old_odom.pose.pose.position.x;
+  const double dy = new_odom.pose.pose.position.y - old_odom.pose.pose.position.y;
+  EXPECT_NEAR(sqrt(dx*dx + dy*dy), 1.0, POSITION_TOLERANCE);
+  EXPECT_NEAR(fabs(new_odom.twist.twist.linear.x), 0.1, EPS);
+  EXPECT_LT(fabs(new_odom.twist.twist.angular.z), EPS);
+}
+
+TEST_F(AckermannCmdTest, testSteeringVelocityLimit)
+{
+  waitForController();
+  // zero everything before test
+  publishAckermann(0.0, 0.0);
+  ros::Duration(0.5).sleep();
+
+  // steer at 0.1 rad/s towards 0.5 rad: after 1s the steering is at most 0.1 rad
+  publishAckermann(0.5, 0.5, 0.1);
+  ros::Duration(1.0).sleep();
+  const double limited_angular = getLastOdom().twist.twist.angular.z;
+
+  // without limit, the steering reaches 0.5 rad at once
+  publishAckermann(0.5, 0.5);
+  ros::Duration(1.0).sleep();
+  const double angular = getLastOdom().twist.twist.angular.z;
+
+  EXPECT_GT(angular, ANGULAR_VELOCITY_TOLERANCE);
+  EXPECT_LT(limited_angular, angular * tan(0.1 + EPS) / tan(0.5));
+
+  publishAckermann(0.0, 0.0);
+  ros::Duration(0.5).sleep();
+}
+
+TEST_F(AckermannCmdTest, testLatestCommandApplies)
+{
+  waitForController();
+  publishAckermann(0.0, 0.0);
+  ros::Duration(0.5).sleep();
+
+  // a twist command sent after the Ackermann command overrides it
+  publishAckermann(0.2, 0.0);
+  ros::Duration(0.5).sleep();
+  geometry_msgs::Twist cmd_vel;
+  cmd_vel.linear.x = 0.0;
+  cmd_vel.angular.z = 0.0;
+  publish(cmd_vel);
+  ros::Duration(1.0).sleep();
+
+  EXPECT_LT(fabs(getLastOdom().twist.twist.linear.x), EPS);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "ackermann_steering_controller_ackermann_cmd_test");
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+  int ret = RUN_ALL_TESTS();
+  spinner.stop();
+  ros::shutdown();
+  return ret;
+}
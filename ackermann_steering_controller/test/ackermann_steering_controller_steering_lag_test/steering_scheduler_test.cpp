@@ -0,0 +1,102 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <ackermann_steering_controller/steering_scheduler.h>
+
+using ackermann_steering_controller::SteeringScheduler;
+
+namespace
+{
+
+const double TIME_CONSTANT = 0.2;
+const double DT = 0.001;
+
+// First order lag steering actuator:
+double actuate(double steering, double command)
+{
+  return steering + (command - steering)*(1.0 - std::exp(-DT/TIME_CONSTANT));
+}
+
+}
+
+TEST(SteeringSchedulerTest, rejectsInvalidParams)
+{
+  SteeringScheduler scheduler;
+  EXPECT_FALSE(scheduler.setParams(-0.1, 0.1, 0.05, 0.0));
+  EXPECT_FALSE(scheduler.setParams(0.1, -0.1, 0.05, 0.0));
+  EXPECT_FALSE(scheduler.setParams(0.1, 0.1, 0.0, 0.0));
+  EXPECT_FALSE(scheduler.setParams(0.1, 0.1, 0.05, 1.5));
+  EXPECT_TRUE(scheduler.setParams(0.1, 0.0, 0.05, 0.0));
+}
+
+TEST(SteeringSchedulerTest, passesThroughWithoutLead)
+{
+  SteeringScheduler scheduler;
+  ASSERT_TRUE(scheduler.setParams(TIME_CONSTANT, 0.0, 0.05, 0.0));
+  EXPECT_DOUBLE_EQ(scheduler.steeringCommand(0.4, 0.1), 0.4);
+  EXPECT_DOUBLE_EQ(scheduler.speedRatio(0.4, 0.38), 1.0);
+}
+
+TEST(SteeringSchedulerTest, holdsSpeedUntilSteeringConverges)
+{
+  SteeringScheduler scheduler;
+  ASSERT_TRUE(scheduler.setParams(TIME_CONSTANT, 0.0, 0.05, 0.0));
+
+  double steering = 0.0;
+  double previous_ratio = 0.0;
+  for (int i = 0; i < 2000; ++i)
+  {
+    const double ratio = scheduler.speedRatio(0.5, steering);
+    EXPECT_GE(ratio, previous_ratio);
+    EXPECT_LE(ratio, 1.0);
+    if (std::abs(0.5 - steering) > 0.05)
+    {
+      EXPECT_LT(ratio, 1.0);
+    }
+    previous_ratio = ratio;
+    steering = actuate(steering, scheduler.steeringCommand(0.5, steering));
+  }
+  EXPECT_DOUBLE_EQ(previous_ratio, 1.0);
+}
+
+TEST(SteeringSchedulerTest, respectsMinSpeedRatio)
+{
+  SteeringScheduler scheduler;
+  ASSERT_TRUE(scheduler.setParams(TIME_CONSTANT, 0.0, 0.01, 0.25));
+  EXPECT_DOUBLE_EQ(scheduler.speedRatio(1.0, 0.0), 0.25);
+  EXPECT_DOUBLE_EQ(scheduler.speedRatio(-1.0, 0.0), 0.25);
+}
+
+TEST(SteeringSchedulerTest, leadReachesSteeringWithinPreviewTime)
+{
+  const double preview_time = 0.1;
+  SteeringScheduler scheduler;
+  ASSERT_TRUE(scheduler.setParams(TIME_CONSTANT, preview_time, 0.02, 0.0));
+
+  // Holding the first command over the preview time brings the lag model to the commanded angle:
+  double steering = 0.0;
+  const double command = scheduler.steeringCommand(0.5, steering);
+  EXPECT_GT(command, 0.5);
+  for (int i = 0; i < preview_time/DT; ++i)
+  {
+    steering = actuate(steering, command);
+  }
+  EXPECT_NEAR(steering, 0.5, 1e-6);
+
+  // Commanded every cycle, the lead converges faster than the plain actuator:
+  double lead_steering = 0.0, plain_steering = 0.0;
+  for (int i = 0; i < preview_time/DT; ++i)
+  {
+    lead_steering = actuate(lead_steering, scheduler.steeringCommand(0.5, lead_steering));
+    plain_steering = actuate(plain_steering, 0.5);
+  }
+  EXPECT_LT(std::abs(0.5 - lead_steering), std::abs(0.5 - plain_steering));
+  EXPECT_LE(lead_steering, 0.5);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,34 @@
+# Realtime audit build: instrument controller update() methods with allocation and mutex auditing.
+# See controller_instrumentation/realtime_audit.h
+option(CONTROLLER_INSTRUMENTATION_RT_AUDIT "Audit controller update() for realtime-unsafe operations" OFF)
+if(CONTROLLER_INSTRUMENTATION_RT_AUDIT)
+  add_definitions(-DCONTROLLER_INSTRUMENTATION_RT_AUDIT)
+endif()
+
+# Static tracepoints: USDT probes at key points of the controllers realtime loops, with near-zero overhead unless a
+# tracer enables them. See controller_instrumentation/tracepoints.h
+option(CONTROLLER_INSTRUMENTATION_TRACEPOINTS "Compile static tracepoints into controllers, if sys/sdt.h is available" ON)
+if(CONTROLLER_INSTRUMENTATION_TRACEPOINTS)
+  include(CheckIncludeFileCXX)
+  check_include_file_cxx(sys/sdt.h CONTROLLER_INSTRUMENTATION_HAVE_SDT_H)
+  if(CONTROLLER_INSTRUMENTATION_HAVE_SDT_H)
+    add_definitions(-DCONTROLLER_INSTRUMENTATION_TRACEPOINTS)
+  endif()
+endif()
+
+# Library interposing the allocation and mutex functions. Link it to executables hosting audited controllers (or
+# preload it), but never to controller libraries
+if(TARGET controller_instrumentation_hooks)
+  set(controller_instrumentation_HOOKS_LIBRARIES controller_instrumentation_hooks)
+else()
+  find_library(controller_instrumentation_HOOKS_LIBRARIES controller_instrumentation_hooks
+               PATHS ${controller_instrumentation_DIR}/../../../lib NO_DEFAULT_PATH)
+endif()
+# Executables only reference the hooks through a weak symbol, so keep linkers defaulting to --as-needed from dropping them
+if(controller_instrumentation_HOOKS_LIBRARIES)
+  set(controller_instrumentation_HOOKS_LIBRARIES
+      -Wl,--no-as-needed ${controller_instrumentation_HOOKS_LIBRARIES} -Wl,--as-needed)
+endif()
+
+# Telemetry rings and shared commands use POSIX shared memory
+list(APPEND controller_instrumentation_LIBRARIES rt)
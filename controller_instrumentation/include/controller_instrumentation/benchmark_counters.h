@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_BENCHMARK_COUNTERS_H
+#define CONTROLLER_INSTRUMENTATION_BENCHMARK_COUNTERS_H
+
+#include <benchmark/benchmark.h>
+
+#include <controller_instrumentation/realtime_audit_counters.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Counters of the controller microbenchmarks, compared against the recorded baseline by
+ * \p compare_benchmarks.
+ *
+ * Only include this header from benchmark executables, which link Google Benchmark.
+ */
+namespace benchmark_counters
+{
+
+/** Name of the counter of memory allocations per benchmark iteration, i.e. per control cycle. */
+constexpr const char* ALLOCATIONS = "allocs_per_cycle";
+
+/** Name of the counter of the time taken per 1000 trajectory points, e.g. to fit a trajectory message [s]. */
+constexpr const char* TIME_PER_1K_POINTS = "time_per_1k_points";
+
+/** \return Counter of the time per 1000 of the \p points processed by each iteration [s]. */
+inline benchmark::Counter timePer1kPoints(double points)
+{
+  return benchmark::Counter(points / 1000.0, benchmark::Counter::kIsIterationInvariantRate |
+                                             benchmark::Counter::kInvert);
+}
+
+} // namespace benchmark_counters
+
+/**
+ * \brief Counts the memory allocations of a benchmark loop, reported per iteration as the
+ * \ref benchmark_counters::ALLOCATIONS counter.
+ *
+ * Construct right before the loop and report right after it, so that neither the benchmark setup nor the reporting of
+ * other counters is counted:
+ * \code
+ * controller_instrumentation::BenchmarkAllocations allocations;
+ * for (auto _ : state) {...}
+ * allocations.report(state);
+ * \endcode
+ * Counting relies on the \p controller_instrumentation_hooks library, linked into the benchmark executable. Without
+ * it, no counter is reported rather than a misleading zero.
+ */
+class BenchmarkAllocations
+{
+public:
+  BenchmarkAllocations()
+    : state_(controller_instrumentation_thread_audit_state ? controller_instrumentation_thread_audit_state() : nullptr)
+  {
+    if (!state_) {return;}
+    start_ = state_->counts;
+    state_->active = true;
+  }
+
+  ~BenchmarkAllocations() {stop();}
+
+  BenchmarkAllocations(const BenchmarkAllocations&) = delete;
+  BenchmarkAllocations& operator=(const BenchmarkAllocations&) = delete;
+
+  /** \brief Stop counting, and report the allocations per iteration of \p state. */
+  void report(benchmark::State& state)
+  {
+    stop();
+    if (!state_) {return;}
+    state.counters[benchmark_counters::ALLOCATIONS] = benchmark::Counter(static_cast<double>(counts_.allocations),
+                                                                         benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  internal::ThreadAuditState* state_;
+  RealtimeAuditCounts         start_;
+  RealtimeAuditCounts         counts_;
+
+  void stop()
+  {
+    if (!state_ || !state_->active) {return;}
+    state_->active = false;
+    counts_ = state_->counts - start_;
+  }
+};
+
+} // namespace controller_instrumentation
+
+#endif // header guard
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef CONTROLLER_INSTRUMENTATION_COMMAND_CHANNEL_H
+#define CONTROLLER_INSTRUMENTATION_COMMAND_CHANNEL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include <controller_instrumentation/latency_histogram.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Statistics of a CommandChannel.
+ *
+ * Counters are updated with relaxed atomics and can be read from any thread.
+ */
+class CommandChannelStats
+{
+public:
+  CommandChannelStats() : writes_(0), contended_writes_(0), overwritten_(0) {}
+
+  CommandChannelStats(const CommandChannelStats&) = delete;
+  CommandChannelStats& operator=(const CommandChannelStats&) = delete;
+
+  /** \return Number of writes. */
+  std::uint64_t writes() const {return writes_.load(std::memory_order_relaxed);}
+
+  /** \return Number of writes that had to wait for another writer. */
+  std::uint64_t contendedWrites() const {return contended_writes_.load(std::memory_order_relaxed);}
+
+  /** \return Number of writes replaced by a newer one before the reader picked them up. */
+  std::uint64_t overwritten() const {return overwritten_.load(std::memory_order_relaxed);}
+
+  /** \return Histogram of the time from a write to its pickup by the reader, in nanoseconds. */
+  LatencyHistogram& latency() {return latency_;}
+
+private:
+  template <class T> friend class CommandChannel;
+
+  static void increment(std::atomic<std::uint64_t>& counter)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  std::atomic<std::uint64_t> writes_;           ///< Only modified with the write lock held.
+  std::atomic<std::uint64_t> contended_writes_; ///< Only modified with the write lock held.
+  std::atomic<std::uint64_t> overwritten_;      ///< Only modified with the write lock held.
+  LatencyHistogram           latency_;          ///< Only recorded by the reader.
+};
+
+/**
+ * \brief Hands commands over from non-realtime callbacks to the realtime thread.
+ *
+ * Drop-in replacement of realtime_tools::RealtimeBuffer for the latest command of a controller. It is a triple buffer:
+ * the writer fills its own copy of the data and exchanges it atomically with a middle copy, which the reader exchanges
+ * with its own copy when it holds new data. The reader never blocks, and always gets the latest complete write, whereas
+ * RealtimeBuffer::readFromRT() returns stale data whenever a write holds its mutex.
+ *
+ * Writers are serialized by a mutex, so several callback threads can write concurrently. The number of writes, how many
+ * had to wait for another writer, how many were never read, and the write-to-read latency are kept in stats().
+ *
+ * \tparam T Data type. Must be default-constructible and copy-assignable.
+ */
+template <class T>
+class CommandChannel
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  CommandChannel() : middle_(1), write_index_(0), read_index_(2) {}
+
+  CommandChannel(const CommandChannel&) = delete;
+  CommandChannel& operator=(const CommandChannel&) = delete;
+
+  /**
+   * \brief Set all copies of the data to \p data, discarding unread writes.
+   * \note This method is \b not thread-safe. Neither writers nor the reader may access the channel concurrently.
+   */
+  void initRT(const T& data)
+  {
+    for (Slot& slot : slots_)
+    {
+      slot.data = data;
+      slot.stamp = Clock::time_point();
+    }
+    middle_.store(1, std::memory_order_release);
+    write_index_ = 0;
+    read_index_  = 2;
+  }
+
+  /**
+   * \brief Make \p data available to the reader.
+   * \note This method is \b not real-time safe, as it may wait for other writers.
+   */
+  void writeFromNonRT(const T& data)
+  {
+    fillFromNonRT([&data](T& slot_data) {slot_data = data;});
+  }
+
+  /**
+   * \brief Make data written in place by \p fill available to the reader.
+   *
+   * \p fill is called with the writer copy of the data, which holds an older write, and must overwrite all of it. For
+   * data of fixed size, such as a command array set up by initRT(), this avoids building a temporary copy of the data.
+   * \note This method is \b not real-time safe, as it may wait for other writers.
+   */
+  template <class Fill>
+  void fillFromNonRT(Fill fill)
+  {
+    std::unique_lock<std::mutex> lock(write_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+      lock.lock();
+      CommandChannelStats::increment(stats_.contended_writes_);
+    }
+
+    Slot& slot = slots_[write_index_];
+    fill(slot.data);
+    slot.stamp = Clock::now();
+    const unsigned int prev = middle_.exchange(write_index_ | NEW_DATA, std::memory_order_acq_rel);
+    write_index_ = prev & INDEX_MASK;
+
+    CommandChannelStats::increment(stats_.writes_);
+    if (prev & NEW_DATA) {CommandChannelStats::increment(stats_.overwritten_);}
+  }
+
+  /**
+   * \return Latest data written. The pointed data remains valid until the next call. The reader may modify it, e.g. to
+   * reset the command when starting a controller, which then holds until a newer write is picked up.
+   * \note This method is wait-free, but must only be called from a single thread.
+   */
+  T* readFromRT()
+  {
+    bool new_data;
+    return readFromRT(new_data);
+  }
+
+  /**
+   * \brief Same as readFromRT(), also telling whether the data changed since the previous call.
+   * \param[out] new_data True if a new write was picked up.
+   */
+  T* readFromRT(bool& new_data)
+  {
+    new_data = middle_.load(std::memory_order_relaxed) & NEW_DATA;
+    if (new_data)
+    {
+      const unsigned int prev = middle_.exchange(read_index_, std::memory_order_acq_rel);
+      read_index_ = prev & INDEX_MASK;
+
+      const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                                slots_[read_index_].stamp).count();
+      stats_.latency_.record(static_cast<std::uint64_t>(latency < 0 ? 0 : latency));
+    }
+    return &slots_[read_index_].data;
+  }
+
+  /** \return Channel statistics. */
+  CommandChannelStats& stats() {return stats_;}
+
+private:
+  static const unsigned int INDEX_MASK = 0x3;
+  static const unsigned int NEW_DATA   = 0x4;
+
+  struct Slot
+  {
+    T                 data;
+    Clock::time_point stamp; ///< Time of the write.
+  };
+
+  std::array<Slot, 3>       slots_;
+  std::atomic<unsigned int> middle_;      ///< Index of the middle copy, plus the NEW_DATA flag.
+  std::mutex                write_mutex_; ///< Serializes writers.
+  unsigned int              write_index_; ///< Only accessed with write_mutex_ held.
+  unsigned int              read_index_;  ///< Only accessed by the reader.
+  CommandChannelStats       stats_;
+};
+
+} // namespace
+
+#endif // header guard
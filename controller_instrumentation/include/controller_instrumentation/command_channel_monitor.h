@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef CONTROLLER_INSTRUMENTATION_COMMAND_CHANNEL_MONITOR_H
+#define CONTROLLER_INSTRUMENTATION_COMMAND_CHANNEL_MONITOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <ros/node_handle.h>
+#include <ros/timer.h>
+
+#include <controller_instrumentation/command_channel.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Publisher of the statistics of a controller's command channels.
+ *
+ * A ROS timer, i.e. a non-realtime thread, periodically publishes, for every channel added with add(), the number of
+ * writes, contended writes and overwritten writes since its previous run, and the p50, p99 and maximum write-to-read
+ * latency, as a \p diagnostic_msgs/DiagnosticStatus named <tt>"<controller name>: command channels"</tt> on the
+ * \p /diagnostics topic. Latencies are in microseconds.
+ *
+ * \section ROS interface
+ *
+ * \param command_stats_publish_rate Rate at which statistics are published. Defaults to 1Hz, zero disables publishing.
+ */
+class CommandChannelMonitor
+{
+public:
+  /**
+   * \brief Add a channel to monitor. Must be called before init().
+   * \param label Channel name, prefixing its values in the diagnostics.
+   * \param stats Channel statistics. Must outlive the monitor.
+   * \note This method is \b not real-time safe.
+   */
+  void add(const std::string& label, CommandChannelStats& stats)
+  {
+    channels_.push_back(Channel());
+    channels_.back().label = label;
+    channels_.back().stats = &stats;
+  }
+
+  /**
+   * \brief Initialize the monitor.
+   * \param nh Controller node handle, used to read parameters and advertise the diagnostics topic.
+   * \param name Name of the monitored controller.
+   * \note This method is \b not real-time safe.
+   */
+  void init(ros::NodeHandle& nh, const std::string& name)
+  {
+    name_ = name;
+
+    double publish_rate = 1.0;
+    nh.param("command_stats_publish_rate", publish_rate, publish_rate);
+    if (publish_rate <= 0.0 || channels_.empty()) {return;}
+
+    for (Channel& channel : channels_) {channel.startWindow();}
+    diagnostics_pub_ = nh.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 1);
+    publish_timer_ = nh.createTimer(ros::Duration(1.0 / publish_rate), &CommandChannelMonitor::publishCB, this);
+  }
+
+private:
+  struct Channel
+  {
+    std::string                label;
+    CommandChannelStats*       stats;
+    LatencyHistogram::Snapshot latency_window_start;
+    std::uint64_t              writes_window_start;
+    std::uint64_t              contended_writes_window_start;
+    std::uint64_t              overwritten_window_start;
+
+    void startWindow()
+    {
+      latency_window_start          = stats->latency().snapshot();
+      writes_window_start           = stats->writes();
+      contended_writes_window_start = stats->contendedWrites();
+      overwritten_window_start      = stats->overwritten();
+    }
+  };
+
+  std::string          name_;
+  std::vector<Channel> channels_;
+  ros::Publisher       diagnostics_pub_;
+  ros::Timer           publish_timer_;
+
+  static void addValue(const std::string& key, const std::string& value, diagnostic_msgs::DiagnosticStatus& status)
+  {
+    diagnostic_msgs::KeyValue key_value;
+    key_value.key   = key;
+    key_value.value = value;
+    status.values.push_back(key_value);
+  }
+
+  static std::string toMicroseconds(std::uint64_t nanoseconds)
+  {
+    return std::to_string(nanoseconds / 1000.0);
+  }
+
+  void publishCB(const ros::TimerEvent&)
+  {
+    diagnostic_msgs::DiagnosticStatus status;
+    status.name        = name_ + ": command channels";
+    status.hardware_id = name_;
+    status.level       = diagnostic_msgs::DiagnosticStatus::OK;
+    status.message     = "Command channel statistics over last publish period";
+
+    for (Channel& channel : channels_)
+    {
+      const LatencyHistogram::Snapshot latency_now = channel.stats->latency().snapshot();
+      const LatencyHistogram::Snapshot latency_window =
+          latency_now.since(channel.latency_window_start, channel.stats->latency().exchangeWindowMax());
+      const std::uint64_t writes           = channel.stats->writes();
+      const std::uint64_t contended_writes = channel.stats->contendedWrites();
+      const std::uint64_t overwritten      = channel.stats->overwritten();
+
+      addValue(channel.label + " writes", std::to_string(writes - channel.writes_window_start), status);
+      addValue(channel.label + " contended writes",
+               std::to_string(contended_writes - channel.contended_writes_window_start), status);
+      addValue(channel.label + " overwritten", std::to_string(overwritten - channel.overwritten_window_start), status);
+      addValue(channel.label + " latency p50 [us]", toMicroseconds(latency_window.percentile(0.5)), status);
+      addValue(channel.label + " latency p99 [us]", toMicroseconds(latency_window.percentile(0.99)), status);
+      addValue(channel.label + " latency max [us]", toMicroseconds(latency_window.max()), status);
+
+      channel.latency_window_start          = latency_now;
+      channel.writes_window_start           = writes;
+      channel.contended_writes_window_start = contended_writes;
+      channel.overwritten_window_start      = overwritten;
+    }
+
+    diagnostic_msgs::DiagnosticArray msg;
+    msg.header.stamp = ros::Time::now();
+    msg.status.push_back(status);
+    diagnostics_pub_.publish(msg);
+  }
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,394 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_FLIGHT_RECORDER_H
+#define CONTROLLER_INSTRUMENTATION_FLIGHT_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include <ros/node_handle.h>
+
+#include <controller_instrumentation/telemetry_ring.h>
+
+namespace controller_instrumentation
+{
+
+namespace internal
+{
+
+/**
+ * \brief Layout of the files written by a \ref FlightRecorder.
+ *
+ * Files start with this header, followed by the channel labels (\p labels_size bytes of null-terminated strings,
+ * padded to a multiple of 8 bytes) and \p record_count records, oldest first. Each record is the record time stamp
+ * followed by \p record_size values. All fields are in the byte order of the host that wrote the file.
+ */
+struct FlightRecordHeader
+{
+  static const std::uint32_t MAGIC   = 0x52464c43; // "CLFR"
+  static const std::uint32_t VERSION = 1;
+
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint32_t record_size;
+  std::uint32_t labels_size;
+  std::uint64_t record_count;
+  std::uint64_t first_index;  ///< Index of the first record since the recorder was opened.
+};
+
+} // namespace internal
+
+/**
+ * \brief Lock-free single-producer ring of the last controller update cycles, dumped to a file on demand.
+ *
+ * A controller writes one record per update cycle, as with a \ref TelemetryRingWriter, to a ring preallocated in
+ * process memory. Nobody reads it until a dump is requested, e.g. when a goal is aborted: the recorder thread then
+ * copies the ring and writes it to a binary file (see \ref internal::FlightRecordHeader and \ref readFlightRecord),
+ * while the writer keeps going. Each record is guarded by a sequence number (seqlock), so records overwritten
+ * while being copied are left out of the dump rather than written half-updated.
+ *
+ * \section ROS interface
+ *
+ * \param flight_recorder_capacity Number of records of the ring, e.g. 5000 for the last 5 s of a 1 kHz control loop.
+ * Zero (default) disables the recorder.
+ * \param flight_recorder_directory Directory dump files are written to. Defaults to \p /tmp.
+ */
+class FlightRecorder
+{
+public:
+  FlightRecorder()
+    : record_size_(0),
+      capacity_(0),
+      index_(0),
+      write_count_(0),
+      dump_request_(nullptr),
+      dump_count_(0),
+      keep_running_(false)
+  {}
+
+  ~FlightRecorder() {close();}
+
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  /**
+   * \brief Open the recorder configured by the ROS parameters of \p nh, if any.
+   * \param nh Controller node handle.
+   * \param labels Channel names, one per value of each record.
+   * \param prefix Prefix of the dump file names, e.g. the controller name.
+   * \return False if a recorder was configured but could not be created.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh, const std::vector<std::string>& labels, const std::string& prefix)
+  {
+    close();
+
+    int capacity = 0;
+    nh.getParam("flight_recorder_capacity", capacity);
+    if (capacity == 0) {return true;}
+
+    std::string directory = "/tmp";
+    nh.getParam("flight_recorder_directory", directory);
+    if (capacity < 0 || !open(labels, capacity, directory + "/" + prefix))
+    {
+      ROS_ERROR_STREAM("Could not create flight recorder with capacity " << capacity << ".");
+      return false;
+    }
+    ROS_DEBUG_STREAM("The last " << capacity << " records of " << labels.size() << " channels will be dumped to '" <<
+                     directory << "' on request.");
+    return true;
+  }
+
+  /**
+   * \brief Allocate the ring, and start the thread that serves dump requests.
+   * \param labels Channel names, one per value of each record.
+   * \param capacity Number of records of the ring.
+   * \param path_prefix Path prefix of the dump files, to which a time stamp, a sequence number and the dump reason are
+   * appended.
+   * \return True on success.
+   * \note This method is \b not real-time safe.
+   */
+  bool open(const std::vector<std::string>& labels, std::size_t capacity, const std::string& path_prefix)
+  {
+    close();
+    if (labels.empty() || capacity == 0) {return false;}
+
+    labels_      = labels;
+    path_prefix_ = path_prefix;
+    record_size_ = labels.size();
+    capacity_    = capacity;
+    index_       = 0;
+    write_count_.store(0, std::memory_order_relaxed);
+    dump_request_.store(nullptr, std::memory_order_relaxed);
+    sequences_.reset(new std::atomic<std::uint64_t>[capacity]);
+    for (std::size_t i = 0; i < capacity; ++i) {sequences_[i].store(0, std::memory_order_relaxed);}
+    data_.assign(capacity * (1 + record_size_), 0.0);
+
+    // Lock the pages so that writing never page faults in the realtime thread
+    ::mlock(data_.data(), data_.size() * sizeof(double));
+
+    keep_running_.store(true);
+    thread_ = std::thread(&FlightRecorder::run, this);
+    return true;
+  }
+
+  /**
+   * \brief Stop the recorder thread, and release the ring. Pending dump requests are served first.
+   * \note This method is \b not real-time safe.
+   */
+  void close()
+  {
+    if (!isOpen()) {return;}
+    keep_running_.store(false);
+    thread_.join();
+    ::munlock(data_.data(), data_.size() * sizeof(double));
+    std::vector<double>().swap(data_);
+    sequences_.reset();
+    capacity_ = 0;
+  }
+
+  /** \return True if the recorder is open. */
+  bool isOpen() const {return capacity_ != 0;}
+
+  /** \return Number of values of each record. */
+  std::size_t recordSize() const {return record_size_;}
+
+  /** \return Number of records of the ring. */
+  std::size_t capacity() const {return capacity_;}
+
+  /**
+   * \brief Start writing a record, overwriting the oldest one if the ring is full.
+   * \param stamp Time of the sample, in seconds.
+   * \return Pointer to the \ref recordSize values of the record, to be filled in before calling \ref commit. Null if
+   * the recorder is not open.
+   * \note This method is realtime-safe.
+   */
+  double* beginWrite(double stamp)
+  {
+    if (!isOpen()) {return nullptr;}
+
+    const std::size_t slot = index_ % capacity_;
+
+    // An odd sequence number marks a record being written
+    sequences_[slot].store(2 * index_ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    double* data = &data_[slot * (1 + record_size_)];
+    data[0] = stamp;
+    return data + 1;
+  }
+
+  /**
+   * \brief Complete the record started by the last call to \ref beginWrite.
+   * \note This method is realtime-safe.
+   */
+  void commit()
+  {
+    if (!isOpen()) {return;}
+
+    sequences_[index_ % capacity_].store(2 * index_ + 2, std::memory_order_release);
+    write_count_.store(++index_, std::memory_order_release);
+  }
+
+  /**
+   * \brief Have the recorder thread dump the ring to a file.
+   *
+   * Requests made before the previous one is served are merged with it.
+   * \param reason Short description of the dump cause, used in the file name. Must be a string literal, or otherwise
+   * outlive the dump.
+   * \note This method is realtime-safe.
+   */
+  void requestDump(const char* reason)
+  {
+    if (!isOpen()) {return;}
+    const char* expected = nullptr;
+    dump_request_.compare_exchange_strong(expected, reason);
+  }
+
+  /**
+   * \brief Dump the ring to a file from the calling thread.
+   * \param reason Short description of the dump cause, used in the file name.
+   * \param[out] path Path of the written file.
+   * \return True on success.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  bool dump(const std::string& reason, std::string& path)
+  {
+    if (!isOpen()) {return false;}
+    std::lock_guard<std::mutex> lock(dump_mutex_);
+
+    // Copy the records still held by the ring, oldest first. Records are overwritten in order, so when one is
+    // overwritten during the copy, it and those copied before it are dropped, and the copy continues from the next one
+    const std::size_t stride = 1 + record_size_;
+    const std::uint64_t written = write_count_.load(std::memory_order_acquire);
+    std::uint64_t first = written > capacity_ ? written - capacity_ : 0;
+    dump_data_.clear();
+    dump_data_.reserve((written - first) * stride);
+    for (std::uint64_t i = first; i < written; ++i)
+    {
+      const std::size_t slot = i % capacity_;
+      const std::uint64_t expected = 2 * i + 2;
+      bool valid = sequences_[slot].load(std::memory_order_acquire) == expected;
+      if (valid)
+      {
+        dump_data_.insert(dump_data_.end(), data_.begin() + slot * stride, data_.begin() + (slot + 1) * stride);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        valid = sequences_[slot].load(std::memory_order_relaxed) == expected;
+      }
+      if (!valid)
+      {
+        dump_data_.clear();
+        first = i + 1;
+      }
+    }
+
+    // File name: prefix, local time, dump sequence number and reason
+    char time_string[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(time_string, sizeof(time_string), "%Y%m%d-%H%M%S", std::localtime(&now));
+    path = path_prefix_ + "_" + time_string + "_" + std::to_string(++dump_count_) + "_" + reason + ".flight";
+
+    std::string labels_data;
+    for (const std::string& label : labels_) {labels_data.append(label.c_str(), label.size() + 1);}
+    labels_data.resize(internal::telemetryRingLabelsSize(labels_data.size()), '\0');
+
+    internal::FlightRecordHeader header;
+    header.magic        = internal::FlightRecordHeader::MAGIC;
+    header.version      = internal::FlightRecordHeader::VERSION;
+    header.record_size  = record_size_;
+    header.labels_size  = labels_data.size();
+    header.record_count = dump_data_.size() / stride;
+    header.first_index  = first;
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(labels_data.data(), labels_data.size());
+    file.write(reinterpret_cast<const char*>(dump_data_.data()), dump_data_.size() * sizeof(double));
+    return static_cast<bool>(file);
+  }
+
+private:
+  std::vector<std::string>                      labels_;
+  std::string                                   path_prefix_;
+  std::size_t                                   record_size_;
+  std::size_t                                   capacity_;
+  std::uint64_t                                 index_;       ///< Index of the record being written.
+  std::atomic<std::uint64_t>                    write_count_; ///< Number of records written so far.
+  std::unique_ptr<std::atomic<std::uint64_t>[]> sequences_;   ///< Per-record sequence number.
+  std::vector<double>                           data_;        ///< Per-record time stamp and values.
+
+  std::atomic<const char*> dump_request_; ///< Reason of the pending dump request, null if none.
+  std::mutex               dump_mutex_;   ///< Serializes dumps.
+  std::vector<double>      dump_data_;    ///< Copy of the ring being dumped. Guarded by dump_mutex_.
+  unsigned int             dump_count_;   ///< Guarded by dump_mutex_.
+  std::atomic<bool>        keep_running_;
+  std::thread              thread_;
+
+  void run()
+  {
+    const std::chrono::milliseconds poll_period(10);
+    bool keep_running = true;
+    while (keep_running)
+    {
+      keep_running = keep_running_.load();
+      const char* reason = dump_request_.load();
+      if (reason)
+      {
+        std::string path;
+        if (dump(reason, path)) {ROS_INFO_STREAM("Flight recorder dumped to '" << path << "'.");}
+        else                    {ROS_ERROR_STREAM("Could not write flight recorder dump '" << path << "'.");}
+        dump_request_.store(nullptr);
+      }
+      else if (keep_running)
+      {
+        std::this_thread::sleep_for(poll_period);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Read a file written by \ref FlightRecorder::dump.
+ * \param path File path.
+ * \param[out] labels Channel names, one per value of each record.
+ * \param[out] records Records, oldest first.
+ * \return False if the file could not be read, or is not a flight recorder dump.
+ * \note This function is \b not real-time safe.
+ */
+inline bool readFlightRecord(const std::string& path, std::vector<std::string>& labels,
+                             std::vector<TelemetryRecord>& records)
+{
+  std::ifstream file(path.c_str(), std::ios::binary);
+  internal::FlightRecordHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != internal::FlightRecordHeader::MAGIC ||
+      header.version != internal::FlightRecordHeader::VERSION)
+  {
+    return false;
+  }
+
+  std::string labels_data(header.labels_size, '\0');
+  if (!file.read(&labels_data[0], labels_data.size())) {return false;}
+  labels.clear();
+  for (std::size_t begin = 0; begin < labels_data.size() && labels_data[begin] != '\0';)
+  {
+    labels.push_back(labels_data.c_str() + begin);
+    begin += labels.back().size() + 1;
+  }
+  if (labels.size() != header.record_size) {return false;}
+
+  records.resize(header.record_count);
+  for (std::uint64_t i = 0; i < header.record_count; ++i)
+  {
+    TelemetryRecord& record = records[i];
+    record.index = header.first_index + i;
+    record.data.resize(header.record_size);
+    if (!file.read(reinterpret_cast<char*>(&record.stamp), sizeof(double)) ||
+        !file.read(reinterpret_cast<char*>(record.data.data()), record.data.size() * sizeof(double)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_KINEMATIC_FILTER_H
+#define CONTROLLER_INSTRUMENTATION_KINEMATIC_FILTER_H
+
+#include <cstddef>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Estimates a signal and its first two derivatives from noisy samples of the signal.
+ *
+ * Critically damped alpha-beta-gamma filter, i.e. a fading memory fit of a parabola to the samples: The state is
+ * predicted with a constant second derivative model, and corrected by the prediction residual with gains set by a
+ * single discount factor. The discount factor is chosen so that samples have the same mean age as in a rolling mean of
+ * \p windowSize() samples, and for a window of one the filter fits a parabola to the last three samples exactly.
+ *
+ * The state is three values, so update() is O(1) and nothing allocates. The first derivative is seeded by a finite
+ * difference of the first two samples after a reset, so that a signal with a non zero initial slope does not start
+ * with a transient.
+ */
+template <class Scalar = double>
+class KinematicFilter
+{
+public:
+  /**
+   * \param window_size Rolling window size with the same smoothing. Values below one are clamped to one.
+   */
+  explicit KinematicFilter(std::size_t window_size = 1)
+  {
+    setWindowSize(window_size);
+  }
+
+  /**
+   * \brief Change the smoothing and discard the state.
+   * \note This method is realtime-safe.
+   */
+  void setWindowSize(std::size_t window_size)
+  {
+    window_size_ = window_size < 1 ? 1 : window_size;
+
+    const Scalar theta = static_cast<Scalar>(window_size_ - 1) / static_cast<Scalar>(window_size_ + 1);
+    const Scalar one_minus_theta = Scalar(1) - theta;
+    gain_value_  = Scalar(1) - theta * theta * theta;
+    gain_first_  = Scalar(1.5) * one_minus_theta * one_minus_theta * (Scalar(1) + theta);
+    gain_second_ = one_minus_theta * one_minus_theta * one_minus_theta; // Twice the gamma gain
+    reset();
+  }
+
+  /**
+   * \brief Discard the state, keeping the smoothing.
+   * \note This method is realtime-safe.
+   */
+  void reset()
+  {
+    samples_ = 0;
+    value_   = Scalar(0);
+    first_   = Scalar(0);
+    second_  = Scalar(0);
+  }
+
+  /**
+   * \brief Add a sample.
+   * \param sample Sample of the signal.
+   * \param dt     Time since the previous sample. Must be positive.
+   * \note This method is realtime-safe.
+   */
+  void update(const Scalar& sample, const Scalar& dt)
+  {
+    if (samples_ == 0)
+    {
+      value_ = sample;
+      ++samples_;
+      return;
+    }
+    if (samples_ == 1)
+    {
+      first_ = (sample - value_) / dt;
+      value_ = sample;
+      ++samples_;
+      return;
+    }
+
+    const Scalar predicted = value_ + (first_ + Scalar(0.5) * second_ * dt) * dt;
+    const Scalar residual  = sample - predicted;
+    value_   = predicted + gain_value_ * residual;
+    first_  += second_ * dt + gain_first_ * residual / dt;
+    second_ += gain_second_ * residual / (dt * dt);
+  }
+
+  /** \return Filtered signal, or zero if there are no samples. */
+  Scalar value() const {return value_;}
+
+  /** \return Estimated first derivative of the signal, or zero if there are less than two samples. */
+  Scalar firstDerivative() const {return first_;}
+
+  /** \return Estimated second derivative of the signal, or zero if there are less than three samples. */
+  Scalar secondDerivative() const {return second_;}
+
+  /** \return Rolling window size with the same smoothing. */
+  std::size_t windowSize() const {return window_size_;}
+
+private:
+  std::size_t window_size_; ///< Rolling window size with the same smoothing.
+  Scalar gain_value_;       ///< Residual gain of the signal.
+  Scalar gain_first_;       ///< Residual gain of the first derivative, times the sample period.
+  Scalar gain_second_;      ///< Residual gain of the second derivative, times the squared sample period.
+  std::size_t samples_;     ///< Number of samples since the last reset, saturated at two.
+  Scalar value_;            ///< Filtered signal.
+  Scalar first_;            ///< First derivative estimate.
+  Scalar second_;           ///< Second derivative estimate.
+};
+
+} // namespace
+
+#endif // header guard
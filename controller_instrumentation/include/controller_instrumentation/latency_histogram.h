@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_LATENCY_HISTOGRAM_H
+#define CONTROLLER_INSTRUMENTATION_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Lock-free histogram of latency samples.
+ *
+ * Samples are non-negative integers (typically nanoseconds) binned into log-linear buckets: values below
+ * \p SUB_BUCKETS are stored exactly, larger ones in buckets whose width is 1/SUB_BUCKETS of their power-of-two range,
+ * which bounds the relative error of reported percentiles to 1/SUB_BUCKETS.
+ *
+ * A single thread records samples with record(), which is wait-free. Any number of threads can concurrently take
+ * snapshots, which they can difference to obtain the distribution of samples over a time window.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr unsigned int SUB_BUCKET_BITS = 4;
+  static constexpr unsigned int SUB_BUCKETS     = 1u << SUB_BUCKET_BITS;
+  static constexpr std::size_t  BUCKETS         = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  typedef std::array<std::uint64_t, BUCKETS> Counts;
+
+  /** \brief Bucket counts of a histogram at a point in time. */
+  class Snapshot
+  {
+  public:
+    Snapshot() : count_(0), sum_(0), max_(0) {counts_.fill(0);}
+
+    /** \return Number of samples. */
+    std::uint64_t count() const {return count_;}
+
+    /** \return Sum of the samples. */
+    std::uint64_t sum() const {return sum_;}
+
+    /** \return Largest sample, or zero if there are none. */
+    std::uint64_t max() const {return max_;}
+
+    /**
+     * \param quantile Quantile to compute, in the <tt>[0, 1]</tt> range.
+     * \return Upper bound of the bucket containing the requested quantile, capped to max(). Zero if there are no
+     * samples.
+     */
+    std::uint64_t percentile(double quantile) const
+    {
+      if (count_ == 0) {return 0;}
+      quantile = std::min(std::max(quantile, 0.0), 1.0);
+      const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(quantile * count_ + 0.5));
+      std::uint64_t accumulated = 0;
+      for (std::size_t i = 0; i < BUCKETS; ++i)
+      {
+        accumulated += counts_[i];
+        if (accumulated >= rank) {return std::min(bucketUpperBound(i), max_);}
+      }
+      return max_;
+    }
+
+    /**
+     * \brief Distribution of the samples recorded between two snapshots.
+     * \param earlier Snapshot of the same histogram taken before this one.
+     * \param window_max Largest sample recorded in the window, see LatencyHistogram::exchangeWindowMax().
+     */
+    Snapshot since(const Snapshot& earlier, std::uint64_t window_max) const
+    {
+      Snapshot result;
+      for (std::size_t i = 0; i < BUCKETS; ++i)
+      {
+        result.counts_[i] = counts_[i] - earlier.counts_[i];
+        result.count_    += result.counts_[i];
+      }
+      result.sum_ = sum_ - earlier.sum_;
+      result.max_ = window_max;
+      return result;
+    }
+
+  private:
+    friend class LatencyHistogram;
+
+    Counts        counts_;
+    std::uint64_t count_;
+    std::uint64_t sum_;
+    std::uint64_t max_;
+  };
+
+  LatencyHistogram() : sum_(0), max_(0), window_max_(0)
+  {
+    for (auto& count : counts_) {count.store(0, std::memory_order_relaxed);}
+  }
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  /**
+   * \brief Record a sample.
+   * \note This method is realtime-safe, but must only be called from a single thread.
+   */
+  void record(std::uint64_t value)
+  {
+    std::atomic<std::uint64_t>& bucket = counts_[bucketIndex(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+
+    if (value > max_.load(std::memory_order_relaxed)) {max_.store(value, std::memory_order_relaxed);}
+
+    // Readers reset the window maximum concurrently, so this must be a read-modify-write loop
+    std::uint64_t window_max = window_max_.load(std::memory_order_relaxed);
+    while (value > window_max &&
+           !window_max_.compare_exchange_weak(window_max, value, std::memory_order_relaxed)) {}
+  }
+
+  /**
+   * \return Current bucket counts. Samples recorded concurrently may or may not be included.
+   * \note This method is realtime-safe.
+   */
+  Snapshot snapshot() const
+  {
+    Snapshot result;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+      result.counts_[i] = counts_[i].load(std::memory_order_relaxed);
+      result.count_    += result.counts_[i];
+    }
+    result.sum_ = sum_.load(std::memory_order_relaxed);
+    result.max_ = max_.load(std::memory_order_relaxed);
+    return result;
+  }
+
+  /**
+   * \return Largest sample recorded since the previous call, starting a new window.
+   * \note This method is realtime-safe.
+   */
+  std::uint64_t exchangeWindowMax() {return window_max_.exchange(0, std::memory_order_relaxed);}
+
+  /** \return Index of the bucket containing \p value. */
+  static std::size_t bucketIndex(std::uint64_t value)
+  {
+    if (value < SUB_BUCKETS) {return static_cast<std::size_t>(value);}
+    const unsigned int msb   = 63 - __builtin_clzll(value);
+    const unsigned int shift = msb - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<std::size_t>((value >> shift) & (SUB_BUCKETS - 1));
+  }
+
+  /** \return Smallest value contained in bucket \p index. */
+  static std::uint64_t bucketLowerBound(std::size_t index)
+  {
+    if (index < SUB_BUCKETS) {return index;}
+    const unsigned int shift = static_cast<unsigned int>(index / SUB_BUCKETS) - 1;
+    return (static_cast<std::uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS)) << shift;
+  }
+
+  /** \return Largest value contained in bucket \p index. */
+  static std::uint64_t bucketUpperBound(std::size_t index)
+  {
+    if (index < SUB_BUCKETS) {return index;}
+    const unsigned int shift = static_cast<unsigned int>(index / SUB_BUCKETS) - 1;
+    return bucketLowerBound(index) + ((static_cast<std::uint64_t>(1) << shift) - 1);
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, BUCKETS> counts_;
+  std::atomic<std::uint64_t>                      sum_;
+  std::atomic<std::uint64_t>                      max_;
+  std::atomic<std::uint64_t>                      window_max_;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,513 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_METRICS_H
+#define CONTROLLER_INSTRUMENTATION_METRICS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <ros/node_handle.h>
+
+#include <controller_instrumentation/latency_histogram.h>
+#include <controller_instrumentation/tracepoints.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Metric of a controller, exported in the Prometheus text format by the \ref MetricsRegistry.
+ *
+ * Metrics are members of the controllers that update them, and are registered under their name with a
+ * <tt>controller="<controller name>"</tt> label by their init() method. Several controllers can therefore register
+ * metrics of the same name, that only differ by their label. Metrics unregister themselves on destruction.
+ */
+class Metric
+{
+public:
+  Metric(const Metric&) = delete;
+  Metric& operator=(const Metric&) = delete;
+
+  virtual ~Metric() {unregisterMetric();}
+
+  const std::string& name() const {return name_;}
+  const std::string& help() const {return help_;}
+
+  /** \return Prometheus type of the metric, e.g. \c "counter". */
+  virtual const char* type() const = 0;
+
+  /**
+   * \brief Write the samples of the metric, one line each, to \p out.
+   * \note Called by the exporter thread, concurrently with the updates of the metric.
+   */
+  virtual void writeSamples(std::ostream& out) const = 0;
+
+protected:
+  Metric() : registered_(false) {}
+
+  /** \note This method is \b not real-time safe. */
+  void registerMetric(const std::string& name, const std::string& help, const std::string& controller);
+
+  /**
+   * \brief Stop exporting the metric. Once this returns, the exporter thread no longer accesses it.
+   *
+   * Must be called by the destructor of derived classes, so that the metric is not exported while partly destroyed.
+   * \note This method is \b not real-time safe.
+   */
+  void unregisterMetric();
+
+  /** \brief Write a sample named after the metric followed by \p suffix, with an additional \p label if not empty. */
+  void writeSample(std::ostream& out, const char* suffix, const std::string& label, double value) const
+  {
+    out << name_ << suffix;
+    if (!labels_.empty() || !label.empty())
+    {
+      out << '{' << labels_ << (!labels_.empty() && !label.empty() ? "," : "") << label << '}';
+    }
+    out << ' ' << value << '\n';
+  }
+
+private:
+  std::string name_;
+  std::string help_;
+  std::string labels_; ///< Label pairs, without the enclosing braces.
+  bool        registered_;
+};
+
+/**
+ * \brief Monotonic count of events, e.g. of rejected goals.
+ *
+ * Any thread can increment the counter, without locking nor allocating.
+ */
+class Counter : public Metric
+{
+public:
+  Counter() : value_(0) {}
+  ~Counter() {unregisterMetric();}
+
+  /**
+   * \brief Export the counter.
+   * \param name Metric name, which should end with \c _total.
+   * \param help Description of the counted events.
+   * \param controller Name of the controller owning the counter, empty for a process-wide counter.
+   * \note This method is \b not real-time safe.
+   */
+  void init(const std::string& name, const std::string& help, const std::string& controller)
+  {
+    registerMetric(name, help, controller);
+  }
+
+  /**
+   * \brief Count \p count events.
+   * \note This method is realtime-safe.
+   */
+  void increment(std::uint64_t count = 1) {value_.fetch_add(count, std::memory_order_relaxed);}
+
+  std::uint64_t value() const {return value_.load(std::memory_order_relaxed);}
+
+  const char* type() const override {return "counter";}
+
+  void writeSamples(std::ostream& out) const override
+  {
+    writeSample(out, "", "", static_cast<double>(value()));
+  }
+
+private:
+  std::atomic<std::uint64_t> value_;
+};
+
+/**
+ * \brief Summary of the samples of a \ref LatencyHistogram, exported as their p50, p99 and p99.9 quantiles, sum and
+ * count since the histogram was created.
+ *
+ * The histogram is recorded by its owner as usual, and only read by the exporter thread.
+ */
+class LatencySummary : public Metric
+{
+public:
+  LatencySummary() : histogram_(nullptr), scale_(1.0) {}
+  ~LatencySummary() {unregisterMetric();}
+
+  /**
+   * \brief Export the samples of \p histogram.
+   * \param name Metric name, which should end with its unit, e.g. \c _seconds.
+   * \param help Description of the samples.
+   * \param controller Name of the controller owning the histogram.
+   * \param histogram Histogram to export, which must outlive the summary.
+   * \param scale Factor converting samples to the exported unit, e.g. \c 1e-9 for samples in nanoseconds exported in
+   * seconds.
+   * \note This method is \b not real-time safe.
+   */
+  void init(const std::string& name, const std::string& help, const std::string& controller,
+            const LatencyHistogram& histogram, double scale)
+  {
+    histogram_ = &histogram;
+    scale_     = scale;
+    registerMetric(name, help, controller);
+  }
+
+  const char* type() const override {return "summary";}
+
+  void writeSamples(std::ostream& out) const override
+  {
+    const LatencyHistogram::Snapshot snapshot = histogram_->snapshot();
+    const std::pair<const char*, double> quantiles[] = {{"0.5", 0.5}, {"0.99", 0.99}, {"0.999", 0.999}};
+    for (const auto& quantile : quantiles)
+    {
+      writeSample(out, "", std::string("quantile=\"") + quantile.first + "\"",
+                  scale_ * static_cast<double>(snapshot.percentile(quantile.second)));
+    }
+    writeSample(out, "_sum", "", scale_ * static_cast<double>(snapshot.sum()));
+    writeSample(out, "_count", "", static_cast<double>(snapshot.count()));
+  }
+
+private:
+  const LatencyHistogram* histogram_;
+  double                  scale_;
+};
+
+/**
+ * \brief Metrics of the controllers of the process.
+ *
+ * Controllers update their metrics from the realtime thread with relaxed atomic operations only. The registry, which
+ * is only accessed when metrics are (un)registered and by the \ref MetricsExporter thread, is the only part guarded by
+ * a mutex.
+ */
+class MetricsRegistry
+{
+public:
+  /**
+   * \return The registry of the process.
+   * \note This method is thread-safe.
+   */
+  static MetricsRegistry& instance()
+  {
+    // Never destroyed, so that metrics of controllers outliving static destruction can still unregister
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+  }
+
+  /** \note This method is thread-safe, but \b not real-time safe. */
+  void add(const Metric* metric)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.push_back(metric);
+  }
+
+  /** \note This method is thread-safe, but \b not real-time safe. */
+  void remove(const Metric* metric)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.erase(std::remove(metrics_.begin(), metrics_.end(), metric), metrics_.end());
+  }
+
+  /** \return Number of registered metrics. */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_.size();
+  }
+
+  /**
+   * \return All metrics in the Prometheus text exposition format, grouped by name.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  std::string text() const
+  {
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out.precision(12);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<const Metric*> metrics(metrics_);
+    std::stable_sort(metrics.begin(), metrics.end(),
+                     [](const Metric* lhs, const Metric* rhs) {return lhs->name() < rhs->name();});
+    for (std::size_t i = 0; i < metrics.size(); ++i)
+    {
+      if (i == 0 || metrics[i]->name() != metrics[i - 1]->name())
+      {
+        writeHeader(out, metrics[i]->name(), metrics[i]->help(), metrics[i]->type());
+      }
+      metrics[i]->writeSamples(out);
+    }
+
+    writeHeader(out, "ros_controllers_publisher_trylock_failures_total",
+                "Realtime publisher messages dropped because the previous message was still being published.",
+                "counter");
+    out << "ros_controllers_publisher_trylock_failures_total "
+        << internal::publisherTrylockFailures().load(std::memory_order_relaxed) << '\n';
+    return out.str();
+  }
+
+  /** \return \p value escaped to be used in a double-quoted label value. */
+  static std::string escapeLabel(const std::string& value)
+  {
+    std::string escaped;
+    for (const char c : value)
+    {
+      if      (c == '\\') {escaped += "\\\\";}
+      else if (c == '"')  {escaped += "\\\"";}
+      else if (c == '\n') {escaped += "\\n";}
+      else                {escaped += c;}
+    }
+    return escaped;
+  }
+
+private:
+  mutable std::mutex         mutex_;
+  std::vector<const Metric*> metrics_;
+
+  MetricsRegistry() {}
+
+  static void writeHeader(std::ostream& out, const std::string& name, const std::string& help, const char* type)
+  {
+    std::string escaped_help;
+    for (const char c : help)
+    {
+      if      (c == '\\') {escaped_help += "\\\\";}
+      else if (c == '\n') {escaped_help += "\\n";}
+      else                {escaped_help += c;}
+    }
+    out << "# HELP " << name << ' ' << escaped_help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+  }
+};
+
+inline void Metric::registerMetric(const std::string& name, const std::string& help, const std::string& controller)
+{
+  unregisterMetric();
+  name_   = name;
+  help_   = help;
+  labels_ = controller.empty() ? std::string() : "controller=\"" + MetricsRegistry::escapeLabel(controller) + "\"";
+  MetricsRegistry::instance().add(this);
+  registered_ = true;
+}
+
+inline void Metric::unregisterMetric()
+{
+  if (!registered_) {return;}
+  MetricsRegistry::instance().remove(this);
+  registered_ = false;
+}
+
+/**
+ * \brief HTTP server exporting the \ref MetricsRegistry of the process, for scraping by Prometheus.
+ *
+ * A single non-realtime thread answers <tt>GET /metrics</tt> requests with MetricsRegistry::text(). There is one
+ * exporter per process, shared by all controllers that enable it, see \ref get.
+ */
+class MetricsExporter
+{
+public:
+  /**
+   * \param port TCP port to listen on, zero for any free port. Ignored if the exporter already exists.
+   * \return The exporter of the process, created if it does not exist. It is destroyed along with the last reference.
+   * Null if it could not listen on \p port.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  static std::shared_ptr<MetricsExporter> get(unsigned short port)
+  {
+    static std::mutex instance_mutex;
+    static std::weak_ptr<MetricsExporter> instance;
+
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    std::shared_ptr<MetricsExporter> exporter = instance.lock();
+    if (!exporter)
+    {
+      exporter.reset(new MetricsExporter());
+      if (!exporter->listen(port)) {return std::shared_ptr<MetricsExporter>();}
+      instance = exporter;
+    }
+    return exporter;
+  }
+
+  ~MetricsExporter()
+  {
+    keep_running_.store(false);
+    if (thread_.joinable()) {thread_.join();}
+    if (socket_ >= 0) {::close(socket_);}
+  }
+
+  /** \return TCP port the exporter listens on. */
+  unsigned short port() const {return port_;}
+
+private:
+  int socket_;
+  unsigned short port_;
+  std::atomic<bool> keep_running_;
+  std::thread thread_;
+
+  MetricsExporter() : socket_(-1), port_(0), keep_running_(true) {}
+
+  bool listen(unsigned short port)
+  {
+    socket_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_ < 0) {return false;}
+    const int reuse = 1;
+    ::setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port        = htons(port);
+    socklen_t length = sizeof(address);
+    if (::bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(socket_, 8) != 0 ||
+        ::getsockname(socket_, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+      return false;
+    }
+    port_ = ntohs(address.sin_port);
+    thread_ = std::thread(&MetricsExporter::run, this);
+    return true;
+  }
+
+  void run()
+  {
+    while (keep_running_.load())
+    {
+      // Wake up periodically to check whether the exporter is being destroyed
+      pollfd request = {socket_, POLLIN, 0};
+      if (::poll(&request, 1, 100) <= 0) {continue;}
+      const int client = ::accept4(socket_, nullptr, nullptr, SOCK_CLOEXEC);
+      if (client < 0) {continue;}
+      serve(client);
+      ::close(client);
+    }
+  }
+
+  void serve(int client) const
+  {
+    // Bound the time spent on a client, so that a stalled one can't block the exporter
+    const timeval timeout = {1, 0};
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+    {
+      const ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+      if (received <= 0) {return;}
+      request.append(buffer, static_cast<std::size_t>(received));
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.compare(0, 4, "GET ") != 0)
+    {
+      status = "405 Method Not Allowed";
+    }
+    else
+    {
+      const std::string path = request.substr(4, request.find_first_of(" ?\r", 4) - 4);
+      if (path == "/metrics" || path == "/") {body = MetricsRegistry::instance().text();}
+      else                                   {status = "404 Not Found";}
+    }
+
+    const std::string response = "HTTP/1.0 " + status + "\r\n"
+                                 "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                 "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                                 "Connection: close\r\n\r\n" + body;
+    std::size_t sent = 0;
+    while (sent < response.size())
+    {
+      const ssize_t count = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+      if (count <= 0) {return;}
+      sent += static_cast<std::size_t>(count);
+    }
+  }
+};
+
+/**
+ * \brief Reference of a controller to the \ref MetricsExporter of the process, if enabled by its parameters.
+ *
+ * The exporter serves the metrics of all controllers of the process, and runs as long as a controller that enabled it
+ * is loaded. Its port is set by the first of them, others only log a warning if they request a different one.
+ *
+ * \section ROS interface
+ *
+ * \param metrics_port TCP port of the Prometheus metrics endpoint. Unset or zero by default, which does not start
+ * the exporter. Metrics are still registered, and exported if another controller starts it.
+ */
+class MetricsEndpoint
+{
+public:
+  /**
+   * \brief Start or join the exporter, if enabled by the parameters of \p nh.
+   * \return False if the parameters are invalid. Failing to listen on the requested port is only logged.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh)
+  {
+    int port = 0;
+    nh.getParam("metrics_port", port);
+    if (port < 0 || port > 65535)
+    {
+      ROS_ERROR_STREAM("Metrics port must be in the [0, 65535] range, got " << port << ".");
+      return false;
+    }
+    if (port == 0) {return true;}
+
+    exporter_ = MetricsExporter::get(static_cast<unsigned short>(port));
+    if (!exporter_)
+    {
+      ROS_ERROR_STREAM("Failed to export metrics on port " << port << ".");
+    }
+    else if (exporter_->port() != port)
+    {
+      ROS_WARN_STREAM("Metrics are already exported on port " << exporter_->port() << ", ignoring port " << port <<
+                      ".");
+    }
+    else
+    {
+      ROS_DEBUG_STREAM("Exporting metrics on port " << port << ".");
+    }
+    return true;
+  }
+
+private:
+  std::shared_ptr<MetricsExporter> exporter_;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_PUBLISH_SCHEDULE_H
+#define CONTROLLER_INSTRUMENTATION_PUBLISH_SCHEDULE_H
+
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+#include <ros/time.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Process-wide allocator of publish phases, shared by all controllers of a controller manager.
+ *
+ * Phases are handed out as fractions of the publish period following the van der Corput sequence (0, 1/2, 1/4, 3/4,
+ * 1/8, ...), so that however many publishers there are, their phases stay evenly spread over the period.
+ */
+class PublishPhaseAllocator
+{
+public:
+  /**
+   * \return Phase of a new publisher, as a fraction of its period in [0, 1).
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  static double next()
+  {
+    static std::mutex mutex;
+    static std::uint32_t count = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::uint32_t bits = count++;
+
+    // reverse the bits of the publisher index
+    bits = ((bits >> 1) & 0x55555555u) | ((bits & 0x55555555u) << 1);
+    bits = ((bits >> 2) & 0x33333333u) | ((bits & 0x33333333u) << 2);
+    bits = ((bits >> 4) & 0x0F0F0F0Fu) | ((bits & 0x0F0F0F0Fu) << 4);
+    bits = ((bits >> 8) & 0x00FF00FFu) | ((bits & 0x00FF00FFu) << 8);
+    bits = (bits >> 16) | (bits << 16);
+    return bits / 4294967296.0;
+  }
+};
+
+/**
+ * \brief Rate limiter of a realtime publisher.
+ *
+ * Replaces the <tt>last_publish_time + Duration(1.0/publish_rate) < time</tt> pattern, precomputing the period. When
+ * many publishers have the same rate, they would all publish in the same update cycle, causing periodic bursts of
+ * serialization load. With staggering enabled, publish times are instead aligned to a grid of the publish period,
+ * anchored at the epoch and offset by a phase from the \ref PublishPhaseAllocator, so that publishers spread over the
+ * period regardless of when their controllers were started.
+ *
+ * \code
+ * // init()
+ * schedule.init(publish_rate, stagger);
+ * // starting()
+ * schedule.reset(time);
+ * // update()
+ * if (schedule.due(time) && publisher.trylock()){
+ *   schedule.advance();
+ *   ...
+ * }
+ * \endcode
+ */
+class PublishSchedule
+{
+public:
+  PublishSchedule() : period_ns_(0), phase_ns_(0), next_ns_(0) {}
+
+  /**
+   * \param rate Publish rate [Hz]. Non-positive values disable publishing.
+   * \param stagger Whether to take a phase from the \ref PublishPhaseAllocator. Otherwise the first publish is one
+   * period after reset().
+   * \note This method is \b not real-time safe when \p stagger is set.
+   */
+  void init(double rate, bool stagger)
+  {
+    period_ns_ = rate > 0.0 ? static_cast<std::int64_t>(std::llround(1e9 / rate)) : 0;
+    phase_ns_  = stagger && period_ns_ > 0
+               ? static_cast<std::int64_t>(PublishPhaseAllocator::next() * period_ns_) : -1;
+    next_ns_   = 0;
+  }
+
+  /**
+   * \brief Restart scheduling at \p time, typically from the controller starting().
+   * \note This method is realtime-safe.
+   */
+  void reset(const ros::Time& time)
+  {
+    const std::int64_t now = time.toNSec();
+    if (period_ns_ <= 0 || phase_ns_ < 0)
+    {
+      next_ns_ = now + period_ns_;
+      return;
+    }
+
+    // first point of the grid strictly after now
+    const std::int64_t offset = ((now - phase_ns_) % period_ns_ + period_ns_) % period_ns_;
+    next_ns_ = now - offset + period_ns_;
+  }
+
+  /**
+   * \return Whether a message is due at \p time.
+   * \note This method is realtime-safe.
+   */
+  bool due(const ros::Time& time) const {return period_ns_ > 0 && next_ns_ < time.toNSec();}
+
+  /**
+   * \brief Move to the next publish time, once a message is actually published.
+   *
+   * On each call the schedule moves by a single period, so a publisher that fell behind catches up on the following
+   * cycles.
+   * \note This method is realtime-safe.
+   */
+  void advance() {next_ns_ += period_ns_;}
+
+  /** \return Whether publishing is enabled, i.e. the rate is positive. */
+  bool enabled() const {return period_ns_ > 0;}
+
+  /** \return Publish period, zero if publishing is disabled. */
+  ros::Duration period() const {ros::Duration period; period.fromNSec(period_ns_); return period;}
+
+private:
+  std::int64_t period_ns_; ///< Publish period.
+  std::int64_t phase_ns_;  ///< Offset of the publish grid from the epoch, negative if not staggered.
+  std::int64_t next_ns_;   ///< Time after which the next message is due.
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_PUBLISHER_POOL_H
+#define CONTROLLER_INSTRUMENTATION_PUBLISHER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ros/node_handle.h>
+#include <ros/publisher.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Single thread publishing the messages of many realtime publishers.
+ *
+ * Each \c realtime_tools::RealtimePublisher owns a thread, so that with many controllers loaded the number of threads
+ * competing with the control loop grows with the number of topics. The topics of a pool are instead all serviced by
+ * one thread, which polls them often enough for the fastest of them: a quarter of its publish period, between 1 ms
+ * and 10 ms.
+ *
+ * There is one pool per process, shared by all controllers of a controller manager, see \ref get.
+ */
+class PublisherPool
+{
+public:
+  /// Topic serviced by a pool.
+  class Topic
+  {
+  public:
+    virtual ~Topic() {}
+
+    /// Publish the pending message, if any. Called from the pool thread only.
+    virtual void publishPending() = 0;
+  };
+
+  /**
+   * \return The pool of the process, created if it does not exist. It is destroyed along with the last reference.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  static std::shared_ptr<PublisherPool> get()
+  {
+    static std::mutex instance_mutex;
+    static std::weak_ptr<PublisherPool> instance;
+
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    std::shared_ptr<PublisherPool> pool = instance.lock();
+    if (!pool)
+    {
+      pool.reset(new PublisherPool());
+      instance = pool;
+    }
+    return pool;
+  }
+
+  ~PublisherPool()
+  {
+    keep_running_.store(false);
+    if (thread_.joinable()) {thread_.join();}
+  }
+
+  /**
+   * \brief Start servicing \p topic.
+   * \param publish_rate Rate at which messages are expected [Hz], non-positive if unknown.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  void add(Topic* topic, double publish_rate)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    topics_.push_back(Entry{topic, publish_rate});
+    updatePollPeriod();
+  }
+
+  /**
+   * \brief Stop servicing \p topic. Once this returns, the pool thread no longer accesses it.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  void remove(Topic* topic)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    topics_.erase(std::remove_if(topics_.begin(), topics_.end(),
+                                 [topic](const Entry& entry) {return entry.topic == topic;}),
+                  topics_.end());
+    updatePollPeriod();
+  }
+
+  /** \return Number of topics serviced by the pool. */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return topics_.size();
+  }
+
+  /** \return Time the pool thread sleeps between polls of the topics. */
+  std::chrono::microseconds pollPeriod() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return poll_period_;
+  }
+
+private:
+  struct Entry
+  {
+    Topic* topic;
+    double publish_rate;
+  };
+
+  mutable std::mutex mutex_;   ///< Guards topics_ and poll_period_, held while publishing
+  std::vector<Entry> topics_;
+  std::chrono::microseconds poll_period_;
+  std::atomic<bool> keep_running_;
+  std::thread thread_;
+
+  PublisherPool()
+    : keep_running_(true)
+  {
+    updatePollPeriod();
+    thread_ = std::thread(&PublisherPool::run, this);
+  }
+
+  void updatePollPeriod()
+  {
+    const std::int64_t min_period = 1000;  // [us]
+    std::int64_t period = 10000;           // [us], also used when no rate is known
+    for (const Entry& entry : topics_)
+    {
+      if (entry.publish_rate > 0.0)
+      {
+        period = std::min(period, static_cast<std::int64_t>(0.25e6 / entry.publish_rate));
+      }
+    }
+    poll_period_ = std::chrono::microseconds(std::max(period, min_period));
+  }
+
+  void run()
+  {
+    while (keep_running_.load())
+    {
+      std::chrono::microseconds poll_period;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Entry& entry : topics_) {entry.topic->publishPending();}
+        poll_period = poll_period_;
+      }
+      std::this_thread::sleep_for(poll_period);
+    }
+  }
+};
+
+/**
+ * \brief Realtime publisher serviced by the \ref PublisherPool of the process, instead of a thread of its own.
+ *
+ * It has the same interface as \c realtime_tools::RealtimePublisher: the control loop fills \c msg_ between a
+ * successful trylock() and unlockAndPublish(), and trylock() fails until the pool has published the previous message.
+ */
+template <class Msg>
+class PooledPublisher : public PublisherPool::Topic
+{
+public:
+  Msg msg_;
+
+  /**
+   * \param publish_rate Rate at which messages are expected [Hz], used to poll the publisher often enough.
+   * \note This method is \b not real-time safe.
+   */
+  PooledPublisher(ros::NodeHandle& nh, const std::string& topic, uint32_t queue_size, double publish_rate,
+                  bool latched = false)
+    : pending_(false),
+      pool_(PublisherPool::get())
+  {
+    publisher_ = nh.advertise<Msg>(topic, queue_size, latched);
+    pool_->add(this, publish_rate);
+  }
+
+  ~PooledPublisher()
+  {
+    pool_->remove(this);
+  }
+
+  /**
+   * \return True if \c msg_ was locked, false if it is being used, or has not been published yet.
+   * \note This method is realtime-safe.
+   */
+  bool trylock()
+  {
+    if (pending_.load(std::memory_order_acquire)) {return false;}
+    return msg_mutex_.try_lock();
+  }
+
+  /// Lock \c msg_, blocking. \note This method is \b not real-time safe.
+  void lock() {msg_mutex_.lock();}
+
+  /// Unlock \c msg_ without publishing it.
+  void unlock() {msg_mutex_.unlock();}
+
+  /**
+   * \brief Unlock \c msg_ and have the pool thread publish it.
+   * \note This method is realtime-safe.
+   */
+  void unlockAndPublish()
+  {
+    pending_.store(true, std::memory_order_release);
+    msg_mutex_.unlock();
+  }
+
+  void publishPending() override
+  {
+    if (!pending_.load(std::memory_order_acquire)) {return;}
+
+    std::lock_guard<std::mutex> lock(msg_mutex_);
+    publisher_.publish(msg_);
+    pending_.store(false, std::memory_order_release);
+  }
+
+private:
+  std::mutex msg_mutex_;           ///< Guards msg_
+  std::atomic<bool> pending_;      ///< Whether msg_ is waiting to be published by the pool thread
+  ros::Publisher publisher_;
+  std::shared_ptr<PublisherPool> pool_;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_REALTIME_AUDIT_H
+#define CONTROLLER_INSTRUMENTATION_REALTIME_AUDIT_H
+
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <ros/node_handle.h>
+#include <ros/time.h>
+#include <realtime_tools/realtime_publisher.h>
+
+#include <controller_instrumentation/realtime_audit_counters.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Audit of realtime-unsafe operations performed by a controller's realtime loop.
+ *
+ * Memory allocations, deallocations and blocking mutex locks performed inside a RealtimeAuditScope are counted and
+ * published as a \p diagnostic_msgs/DiagnosticStatus named <tt>"<controller name>: realtime audit"</tt> on the
+ * \p /diagnostics topic. Violations are also reported to rosconsole.
+ *
+ * Auditing is only active when the controller is compiled with the \p CONTROLLER_INSTRUMENTATION_RT_AUDIT CMake
+ * option and the process hosting it links or preloads the \p controller_instrumentation_hooks library. Otherwise all
+ * methods are no-ops that compile away.
+ */
+class RealtimeAudit
+{
+public:
+  /** Period at which audit results are published. */
+  static constexpr double PUBLISH_PERIOD = 1.0;
+
+  RealtimeAudit() : state_(nullptr), enclosing_active_(false), cycles_(0), violating_cycles_(0) {}
+
+  /**
+   * \brief Initialize the audit.
+   * \param nh Node handle used to advertise the diagnostics topic.
+   * \param name Name of the audited controller.
+   * \note This method is \b not real-time safe.
+   */
+  void init(ros::NodeHandle& nh, const std::string& name)
+  {
+#ifdef CONTROLLER_INSTRUMENTATION_RT_AUDIT
+    name_ = name;
+    if (!controller_instrumentation_thread_audit_state)
+    {
+      ROS_WARN_STREAM_NAMED(name_, "Realtime audit requested, but the controller_instrumentation_hooks library is " <<
+                            "not loaded. No realtime-unsafe operations will be detected.");
+    }
+
+    publisher_.reset(new DiagnosticsPublisher(nh, "/diagnostics", 1));
+    publisher_->lock();
+    publisher_->msg_.status.resize(1);
+    diagnostic_msgs::DiagnosticStatus& status = publisher_->msg_.status[0];
+    status.name        = name_ + ": realtime audit";
+    status.hardware_id = name_;
+    status.message.reserve(MAX_MESSAGE_SIZE);
+    const char* keys[] = {"cycles", "violating cycles", "allocations", "deallocations", "mutex locks"};
+    status.values.resize(sizeof(keys) / sizeof(keys[0]));
+    for (unsigned int i = 0; i < status.values.size(); ++i)
+    {
+      status.values[i].key = keys[i];
+      status.values[i].value.reserve(MAX_VALUE_SIZE);
+    }
+    publisher_->unlock();
+#else
+    (void) nh;
+    (void) name;
+#endif
+  }
+
+  /**
+   * \brief Initialize the audit, naming it after the last component of the controller namespace.
+   * \param nh Controller node handle.
+   * \note This method is \b not real-time safe.
+   */
+  void init(ros::NodeHandle& nh)
+  {
+    const std::string& ns = nh.getNamespace();
+    init(nh, ns.substr(ns.find_last_of('/') + 1));
+  }
+
+  /**
+   * \brief Start auditing the calling thread.
+   * \param time Current time, used to throttle the publication of audit results.
+   * \note This method is realtime-safe.
+   */
+  void begin(const ros::Time& time)
+  {
+#ifdef CONTROLLER_INSTRUMENTATION_RT_AUDIT
+    if (time - last_publish_time_ >= ros::Duration(PUBLISH_PERIOD)) {publish(time);}
+
+    state_ = controller_instrumentation_thread_audit_state ? controller_instrumentation_thread_audit_state() : nullptr;
+    if (!state_) {return;}
+    enclosing_active_ = state_->active;
+    start_counts_     = state_->counts;
+    state_->active    = true;
+#else
+    (void) time;
+#endif
+  }
+
+  /**
+   * \brief Stop auditing the calling thread, accumulating the operations performed since begin().
+   * \note This method is realtime-safe.
+   */
+  void end()
+  {
+#ifdef CONTROLLER_INSTRUMENTATION_RT_AUDIT
+    if (!state_) {return;}
+    state_->active = enclosing_active_;
+    const RealtimeAuditCounts cycle_counts = state_->counts - start_counts_;
+    state_ = nullptr;
+
+    ++cycles_;
+    if (cycle_counts.empty()) {return;}
+    ++violating_cycles_;
+    totals_.allocations   += cycle_counts.allocations;
+    totals_.deallocations += cycle_counts.deallocations;
+    totals_.mutex_locks   += cycle_counts.mutex_locks;
+    ROS_WARN_THROTTLE_NAMED(PUBLISH_PERIOD, name_, "Realtime violation in update(): %" PRIu64 " allocations, %"
+                            PRIu64 " deallocations, %" PRIu64 " mutex locks.", cycle_counts.allocations,
+                            cycle_counts.deallocations, cycle_counts.mutex_locks);
+#endif
+  }
+
+  /** \return Operations accumulated over all audited cycles. */
+  const RealtimeAuditCounts& totals() const {return totals_;}
+
+  /** \return Number of audited cycles. */
+  std::uint64_t cycles() const {return cycles_;}
+
+private:
+  typedef realtime_tools::RealtimePublisher<diagnostic_msgs::DiagnosticArray> DiagnosticsPublisher;
+  typedef std::unique_ptr<DiagnosticsPublisher>                               DiagnosticsPublisherPtr;
+
+  static constexpr std::size_t MAX_MESSAGE_SIZE = 64;
+  static constexpr std::size_t MAX_VALUE_SIZE   = 24;
+
+  std::string                         name_;
+  DiagnosticsPublisherPtr             publisher_;
+  ros::Time                           last_publish_time_;
+  internal::ThreadAuditState*         state_;
+  bool                                enclosing_active_;
+  RealtimeAuditCounts                 start_counts_;
+  RealtimeAuditCounts                 totals_;
+  std::uint64_t                       cycles_;
+  std::uint64_t                       violating_cycles_;
+
+  static void assign(std::string& str, std::uint64_t value)
+  {
+    // Strings have preallocated capacity, so assignment does not allocate
+    char buffer[MAX_VALUE_SIZE];
+    std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+    str.assign(buffer);
+  }
+
+  void publish(const ros::Time& time)
+  {
+    if (!publisher_ || !publisher_->trylock()) {return;}
+    last_publish_time_ = time;
+
+    publisher_->msg_.header.stamp = time;
+    diagnostic_msgs::DiagnosticStatus& status = publisher_->msg_.status[0];
+    if (controller_instrumentation_thread_audit_state)
+    {
+      status.level = totals_.empty() ? diagnostic_msgs::DiagnosticStatus::OK : diagnostic_msgs::DiagnosticStatus::WARN;
+      status.message.assign(totals_.empty() ? "No realtime violations" : "Realtime violations detected");
+    }
+    else
+    {
+      status.level = diagnostic_msgs::DiagnosticStatus::STALE;
+      status.message.assign("Audit hooks not loaded");
+    }
+    assign(status.values[0].value, cycles_);
+    assign(status.values[1].value, violating_cycles_);
+    assign(status.values[2].value, totals_.allocations);
+    assign(status.values[3].value, totals_.deallocations);
+    assign(status.values[4].value, totals_.mutex_locks);
+    publisher_->unlockAndPublish();
+  }
+};
+
+/**
+ * \brief Audits the realtime-unsafe operations performed during its lifetime.
+ *
+ * Place at the top of a controller's update() method:
+ * \code
+ * controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+ * \endcode
+ */
+class RealtimeAuditScope
+{
+public:
+  RealtimeAuditScope(RealtimeAudit& audit, const ros::Time& time) : audit_(audit) {audit_.begin(time);}
+  ~RealtimeAuditScope() {audit_.end();}
+
+  RealtimeAuditScope(const RealtimeAuditScope&) = delete;
+  RealtimeAuditScope& operator=(const RealtimeAuditScope&) = delete;
+
+private:
+  RealtimeAudit& audit_;
+};
+
+} // namespace
+
+#endif // header guard
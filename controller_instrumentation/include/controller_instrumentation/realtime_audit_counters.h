@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_REALTIME_AUDIT_COUNTERS_H
+#define CONTROLLER_INSTRUMENTATION_REALTIME_AUDIT_COUNTERS_H
+
+#include <cstdint>
+
+namespace controller_instrumentation
+{
+
+/** \brief Number of realtime-unsafe operations performed while auditing. */
+struct RealtimeAuditCounts
+{
+  constexpr RealtimeAuditCounts() : allocations(0), deallocations(0), mutex_locks(0) {}
+
+  std::uint64_t allocations;   ///< Calls to malloc, calloc, realloc and aligned allocation functions.
+  std::uint64_t deallocations; ///< Calls to free with a non-null pointer.
+  std::uint64_t mutex_locks;   ///< Blocking mutex acquisitions. Non-blocking attempts (trylock) are not counted.
+
+  bool empty() const {return allocations == 0 && deallocations == 0 && mutex_locks == 0;}
+};
+
+inline RealtimeAuditCounts operator-(const RealtimeAuditCounts& lhs, const RealtimeAuditCounts& rhs)
+{
+  RealtimeAuditCounts result;
+  result.allocations   = lhs.allocations   - rhs.allocations;
+  result.deallocations = lhs.deallocations - rhs.deallocations;
+  result.mutex_locks   = lhs.mutex_locks   - rhs.mutex_locks;
+  return result;
+}
+
+namespace internal
+{
+
+/** Per-thread audit state, owned by the hooks library. */
+struct ThreadAuditState
+{
+  bool                active; ///< Whether operations performed by the thread are being counted.
+  RealtimeAuditCounts counts;
+};
+
+} // namespace
+
+} // namespace
+
+/**
+ * \brief Audit state of the calling thread.
+ *
+ * Defined by the \p controller_instrumentation_hooks library, which interposes the memory allocation and mutex
+ * functions of the C library. The symbol is weak, so it is null unless the hooks library is linked into the executable
+ * or preloaded with \p LD_PRELOAD.
+ */
+extern "C" controller_instrumentation::internal::ThreadAuditState* controller_instrumentation_thread_audit_state()
+__attribute__((weak));
+
+#endif // header guard
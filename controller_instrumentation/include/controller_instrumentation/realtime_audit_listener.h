@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_REALTIME_AUDIT_LISTENER_H
+#define CONTROLLER_INSTRUMENTATION_REALTIME_AUDIT_LISTENER_H
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <ros/node_handle.h>
+
+#include <controller_instrumentation/realtime_audit_counters.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Collects the realtime audit results of a controller from the \p /diagnostics topic.
+ *
+ * Meant for tests checking that a controller's update() method is realtime-safe.
+ */
+class RealtimeAuditListener
+{
+public:
+  RealtimeAuditListener(ros::NodeHandle& nh, const std::string& controller_name)
+    : status_name_(controller_name + ": realtime audit"),
+      received_(false),
+      cycles_(0),
+      sub_(nh.subscribe("/diagnostics", 10, &RealtimeAuditListener::diagnosticsCB, this))
+  {}
+
+  /** \return Whether audit results for the controller have been received. */
+  bool received() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return received_;
+  }
+
+  /** \return Number of cycles audited so far. */
+  std::uint64_t cycles() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cycles_;
+  }
+
+  /** \return Operations accumulated over all audited cycles so far. */
+  RealtimeAuditCounts totals() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totals_;
+  }
+
+private:
+  std::string         status_name_;
+  mutable std::mutex  mutex_;
+  bool                received_;
+  std::uint64_t       cycles_;
+  RealtimeAuditCounts totals_;
+  ros::Subscriber     sub_;
+
+  void diagnosticsCB(const diagnostic_msgs::DiagnosticArrayConstPtr& msg)
+  {
+    for (const auto& status : msg->status)
+    {
+      if (status.name != status_name_) {continue;}
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& value : status.values)
+      {
+        const std::uint64_t count = std::strtoull(value.value.c_str(), nullptr, 10);
+        if      (value.key == "cycles")        {cycles_ = count;}
+        else if (value.key == "allocations")   {totals_.allocations = count;}
+        else if (value.key == "deallocations") {totals_.deallocations = count;}
+        else if (value.key == "mutex locks")   {totals_.mutex_locks = count;}
+      }
+      received_ = true;
+    }
+  }
+};
+
+} // namespace
+
+#endif // header guard
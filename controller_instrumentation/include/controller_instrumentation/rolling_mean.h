@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_ROLLING_MEAN_H
+#define CONTROLLER_INSTRUMENTATION_ROLLING_MEAN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Mean of the last \p windowSize() samples pushed into a fixed-capacity ring buffer.
+ *
+ * A running sum of the samples in the window is kept, so push(), mean() and reset() are O(1) and do not allocate.
+ * Storage is only (re)allocated by the constructor and resize().
+ */
+template <class Scalar = double>
+class RollingMean
+{
+public:
+  /**
+   * \param window_size Number of samples the mean is computed over. Values below one are clamped to one.
+   */
+  explicit RollingMean(std::size_t window_size = 1)
+  {
+    resize(window_size);
+  }
+
+  /**
+   * \brief Change the window size and discard all samples.
+   * \note This method is \b not real-time safe.
+   */
+  void resize(std::size_t window_size)
+  {
+    buffer_.assign(std::max<std::size_t>(window_size, 1), Scalar(0));
+    reset();
+  }
+
+  /**
+   * \brief Discard all samples, keeping the window size.
+   * \note This method is realtime-safe.
+   */
+  void reset()
+  {
+    next_  = 0;
+    count_ = 0;
+    sum_   = Scalar(0);
+  }
+
+  /**
+   * \brief Add a sample, evicting the oldest one if the window is full.
+   * \note This method is realtime-safe.
+   */
+  void push(const Scalar& value)
+  {
+    if (count_ == buffer_.size()) {sum_ -= buffer_[next_];}
+    else                          {++count_;}
+
+    buffer_[next_] = value;
+    sum_ += value;
+    if (++next_ == buffer_.size()) {next_ = 0;}
+  }
+
+  /**
+   * \return Mean of the samples in the window, or zero if there are none.
+   * \note This method is realtime-safe.
+   */
+  Scalar mean() const
+  {
+    return count_ == 0 ? Scalar(0) : sum_ / static_cast<Scalar>(count_);
+  }
+
+  /** \return Number of samples currently in the window. */
+  std::size_t size() const {return count_;}
+
+  /** \return Maximum number of samples the mean is computed over. */
+  std::size_t windowSize() const {return buffer_.size();}
+
+private:
+  std::vector<Scalar> buffer_; ///< Ring buffer of samples, sized to the window.
+  std::size_t next_;           ///< Index the next sample is written to.
+  std::size_t count_;          ///< Number of valid samples in the buffer.
+  Scalar sum_;                 ///< Sum of the valid samples.
+};
+
+} // namespace
+
+#endif // header guard
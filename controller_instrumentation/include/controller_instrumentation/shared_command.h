@@ -0,0 +1,399 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_SHARED_COMMAND_H
+#define CONTROLLER_INSTRUMENTATION_SHARED_COMMAND_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ros/node_handle.h>
+#include <ros/timer.h>
+
+namespace controller_instrumentation
+{
+
+namespace internal
+{
+
+/**
+ * \brief Layout of the shared memory object of a \ref SharedCommandSource.
+ *
+ * The object starts with this header, followed by \p size command values. The sequence number is odd while a write is
+ * in progress (seqlock), and zero until the first write.
+ */
+struct SharedCommandHeader
+{
+  static const std::uint32_t MAGIC   = 0x43534c43; // "CLSC"
+  static const std::uint32_t VERSION = 1;
+
+  std::uint32_t              magic;
+  std::uint32_t              version;
+  std::uint32_t              size;
+  std::uint32_t              reserved;
+  std::atomic<std::uint64_t> sequence;
+  std::int64_t               stamp;    ///< Time of the last write, in nanoseconds of std::chrono::steady_clock.
+};
+
+inline std::size_t sharedCommandSize(std::size_t size)
+{
+  return sizeof(SharedCommandHeader) + size * sizeof(double);
+}
+
+inline double* sharedCommandData(SharedCommandHeader* header)
+{
+  return reinterpret_cast<double*>(reinterpret_cast<char*>(header) + sizeof(SharedCommandHeader));
+}
+
+} // namespace internal
+
+/**
+ * \brief Command of a controller, read from POSIX shared memory.
+ *
+ * An external process on the same host (e.g. a model predictive controller) writes the command with a
+ * \ref SharedCommandWriter, and the controller copies it in its update cycle, without going through ROS serialization and
+ * callback queues. Only the latest command is kept, guarded by a sequence number (seqlock), so the realtime thread
+ * never blocks and never copies a partially written command.
+ *
+ * Every command is stamped by its writer. A command older than the configured timeout is stale and not applied, e.g.
+ * because the writer process stopped. The realtime thread only counts the commands that became stale, in
+ * staleCount(), and a ROS timer warns about them from a non-realtime thread.
+ *
+ * \section ROS interface
+ *
+ * \param shared_command_name Shared memory object name, e.g. <tt>"/arm_controller_command"</tt>. Empty (default)
+ * disables the shared command.
+ * \param shared_command_timeout Maximum age of an applied command [s]. Defaults to 0.1.
+ * \param shared_command_mode Permissions of the shared memory object, e.g. \c 0660 to let the group of the controller
+ * process write commands. Defaults to \c 0600, i.e. only the user of the controller process may open it.
+ *
+ * \note The controller creates the shared memory object, and only one writer may exist per object.
+ */
+class SharedCommandSource
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  enum Result
+  {
+    UPDATED,   ///< A new command was copied.
+    UNCHANGED, ///< No command has been written since the last read, and the previous one is not stale.
+    STALE,     ///< The latest command is older than the timeout, and was not copied.
+    EMPTY      ///< No complete command is available: The source is closed, nothing was written yet, or a write is in
+               ///< progress.
+  };
+
+  SharedCommandSource()
+    : header_(nullptr), size_(0), timeout_(0), last_sequence_(0), last_result_(EMPTY), stale_count_(0),
+      reported_stale_count_(0) {}
+  ~SharedCommandSource() {close();}
+
+  SharedCommandSource(const SharedCommandSource&) = delete;
+  SharedCommandSource& operator=(const SharedCommandSource&) = delete;
+
+  /**
+   * \brief Open the shared command configured by the ROS parameters of \p nh, if any.
+   * \param nh Controller node handle.
+   * \param size Number of values of the command.
+   * \return False if a shared command was configured but could not be created.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh, std::size_t size)
+  {
+    close();
+
+    std::string name;
+    nh.getParam("shared_command_name", name);
+    if (name.empty()) {return true;}
+
+    double timeout = 0.1;
+    nh.getParam("shared_command_timeout", timeout);
+    int mode = DEFAULT_MODE;
+    nh.getParam("shared_command_mode", mode);
+    if (!(timeout > 0.0) || mode < 0 || mode > 0777 ||
+        !open(name, size, std::chrono::duration<double>(timeout), static_cast<mode_t>(mode)))
+    {
+      ROS_ERROR_STREAM("Could not create shared command '" << name << "' of " << size << " values with timeout " <<
+                       timeout << "s and mode " << std::oct << mode << std::dec << ".");
+      return false;
+    }
+    stale_timer_ = nh.createTimer(ros::Duration(STALE_REPORT_PERIOD), &SharedCommandSource::reportStaleCB, this);
+    ROS_DEBUG_STREAM("Commands of " << size << " values will be read from shared memory '" << name << "'.");
+    return true;
+  }
+
+  /**
+   * \brief Create (or replace) the shared memory object \p name and map it.
+   * \param name Shared memory object name.
+   * \param size Number of values of the command.
+   * \param timeout Maximum age of an applied command.
+   * \param mode Permissions of the shared memory object, also applied to an object that already exists.
+   * \return True on success.
+   * \note This method is \b not real-time safe.
+   */
+  template <class Rep, class Period>
+  bool open(const std::string& name, std::size_t size, const std::chrono::duration<Rep, Period>& timeout,
+            mode_t mode = DEFAULT_MODE)
+  {
+    close();
+    if (name.empty() || size == 0) {return false;}
+
+    const std::size_t bytes = internal::sharedCommandSize(size);
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, mode);
+    if (fd < 0) {return false;}
+    if (::fchmod(fd, mode) != 0 || ::ftruncate(fd, bytes) != 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {return false;}
+
+    // Lock the pages so that reading never page faults in the realtime thread
+    ::mlock(address, bytes);
+
+    name_          = name;
+    size_          = size;
+    timeout_       = std::chrono::duration_cast<Clock::duration>(timeout);
+    last_sequence_ = 0;
+    last_result_   = EMPTY;
+    stale_count_.store(0, std::memory_order_relaxed);
+    reported_stale_count_ = 0;
+    scratch_.assign(size, 0.0);
+    header_        = new (address) internal::SharedCommandHeader();
+    header_->size    = size_;
+    header_->version = internal::SharedCommandHeader::VERSION;
+    header_->stamp   = 0;
+    header_->sequence.store(0, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = internal::SharedCommandHeader::MAGIC; // Writers check the magic number last
+    return true;
+  }
+
+  /**
+   * \brief Unmap and remove the shared memory object. Writers that already mapped it keep their mapping.
+   * \note This method is \b not real-time safe.
+   */
+  void close()
+  {
+    stale_timer_.stop();
+    if (!header_) {return;}
+    ::munmap(header_, internal::sharedCommandSize(size_));
+    ::shm_unlink(name_.c_str());
+    header_ = nullptr;
+  }
+
+  /** \return True if the shared command is open. */
+  bool isOpen() const {return header_ != nullptr;}
+
+  /** \return Number of values of the command. */
+  std::size_t size() const {return size_;}
+
+  /**
+   * \return Number of times the applied command became stale since the source was opened.
+   * \note This method is realtime-safe, and may be called from any thread.
+   */
+  std::uint64_t staleCount() const {return stale_count_.load(std::memory_order_relaxed);}
+
+  /**
+   * \brief Copy the latest command, if it changed and is not stale.
+   * \param[out] data Array of \ref size values, only written if \ref UPDATED is returned.
+   * \param now Current time.
+   * \note This method is realtime-safe, and must only be called from a single thread.
+   */
+  Result read(double* data, Clock::time_point now = Clock::now())
+  {
+    const Result result = readImpl(data, now);
+    if (result == STALE && (last_result_ == UPDATED || last_result_ == UNCHANGED))
+    {
+      stale_count_.store(stale_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    last_result_ = result;
+    return result;
+  }
+
+private:
+  static const unsigned int READ_ATTEMPTS       = 4;    ///< Reads interrupted by a write before giving up this cycle.
+  static const mode_t       DEFAULT_MODE        = 0600; ///< Only the user of the controller process may open it.
+  static constexpr double   STALE_REPORT_PERIOD = 1.0;  ///< Period at which stale commands are reported [s].
+
+  std::string                    name_;
+  internal::SharedCommandHeader* header_;
+  std::size_t                    size_;
+  Clock::duration                timeout_;
+  std::uint64_t                  last_sequence_; ///< Sequence number of the last copied command.
+  Result                         last_result_;
+  std::vector<double>            scratch_;       ///< Copy of the command, until checked to be consistent.
+  std::atomic<std::uint64_t>     stale_count_;
+  std::uint64_t                  reported_stale_count_;
+  ros::Timer                     stale_timer_;
+
+  void reportStaleCB(const ros::TimerEvent&)
+  {
+    const std::uint64_t stale_count = staleCount();
+    if (stale_count == reported_stale_count_) {return;}
+    ROS_WARN_STREAM("Shared command '" << name_ << "' became stale " << stale_count - reported_stale_count_ <<
+                    " time(s), it is not applied until it is written again.");
+    reported_stale_count_ = stale_count;
+  }
+
+  Result readImpl(double* data, Clock::time_point now)
+  {
+    if (!header_) {return EMPTY;}
+
+    const double* shared = internal::sharedCommandData(header_);
+    for (unsigned int attempt = 0; attempt < READ_ATTEMPTS; ++attempt)
+    {
+      const std::uint64_t sequence = header_->sequence.load(std::memory_order_acquire);
+      if (sequence == 0) {return EMPTY;}
+      if (sequence & 1) {continue;}
+
+      // Only copy the data of a new command, but check the age of any
+      const bool updated = sequence != last_sequence_;
+      if (updated) {std::memcpy(scratch_.data(), shared, size_ * sizeof(double));}
+      const std::int64_t stamp = header_->stamp;
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (header_->sequence.load(std::memory_order_relaxed) != sequence) {continue;}
+
+      const Clock::time_point write_time(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(stamp)));
+      if (now - write_time > timeout_) {return STALE;}
+      if (!updated) {return UNCHANGED;}
+
+      std::memcpy(data, scratch_.data(), size_ * sizeof(double));
+      last_sequence_ = sequence;
+      return UPDATED;
+    }
+    return EMPTY;
+  }
+};
+
+/**
+ * \brief Writer of the command read by a \ref SharedCommandSource, typically in another process.
+ */
+class SharedCommandWriter
+{
+public:
+  typedef SharedCommandSource::Clock Clock;
+
+  SharedCommandWriter() : header_(nullptr), size_(0) {}
+  ~SharedCommandWriter() {close();}
+
+  SharedCommandWriter(const SharedCommandWriter&) = delete;
+  SharedCommandWriter& operator=(const SharedCommandWriter&) = delete;
+
+  /**
+   * \brief Map the existing shared memory object \p name for writing.
+   * \param name Shared memory object name.
+   * \param size Expected number of values of the command.
+   * \return True on success.
+   */
+  bool open(const std::string& name, std::size_t size)
+  {
+    close();
+
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {return false;}
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != internal::sharedCommandSize(size))
+    {
+      ::close(fd);
+      return false;
+    }
+    void* address = ::mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {return false;}
+
+    header_ = static_cast<internal::SharedCommandHeader*>(address);
+    size_   = size;
+    const bool valid = header_->magic == internal::SharedCommandHeader::MAGIC &&
+                       header_->version == internal::SharedCommandHeader::VERSION &&
+                       header_->size == size_;
+    if (!valid)
+    {
+      close();
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
+
+  /** \brief Unmap the shared memory object. */
+  void close()
+  {
+    if (!header_) {return;}
+    ::munmap(header_, internal::sharedCommandSize(size_));
+    header_ = nullptr;
+  }
+
+  /** \return True if the shared command is open. */
+  bool isOpen() const {return header_ != nullptr;}
+
+  /** \return Number of values of the command. */
+  std::size_t size() const {return size_;}
+
+  /**
+   * \brief Write a command.
+   * \param data Array of \ref size values.
+   * \param stamp Time of the command, checked by the reader for staleness.
+   * \pre The shared command is open.
+   */
+  void write(const double* data, Clock::time_point stamp = Clock::now())
+  {
+    // An odd sequence number marks a write in progress. It is left odd by a writer that died while writing
+    std::uint64_t sequence = header_->sequence.load(std::memory_order_relaxed);
+    if (!(sequence & 1)) {++sequence;}
+    header_->sequence.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(internal::sharedCommandData(header_), data, size_ * sizeof(double));
+    header_->stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(stamp.time_since_epoch()).count();
+
+    header_->sequence.store(sequence + 1, std::memory_order_release);
+  }
+
+private:
+  internal::SharedCommandHeader* header_;
+  std::size_t                    size_;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_SPSC_QUEUE_H
+#define CONTROLLER_INSTRUMENTATION_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Fixed-capacity, lock-free queue with a single producer and a single consumer.
+ *
+ * The producer (typically the realtime control loop) calls push(), and the consumer (a non-realtime thread) calls
+ * pop(). Both are wait-free and do not allocate: storage is only allocated by the constructor and reset(), which must
+ * not run concurrently with push() or pop().
+ *
+ * Elements owning storage, such as vectors, can be preallocated by resetting the queue with a prototype element, and
+ * written in place with beginPush() and commitPush(), so that pushing them does not allocate either.
+ */
+template <class T>
+class SpscQueue
+{
+public:
+  /**
+   * \param capacity Maximum number of elements the queue holds.
+   */
+  explicit SpscQueue(std::size_t capacity = 0)
+  {
+    reset(capacity);
+  }
+
+  /**
+   * \brief Discard all elements and change the queue capacity.
+   * \note This method is \b not real-time safe, nor thread-safe.
+   */
+  void reset(std::size_t capacity)
+  {
+    reset(capacity, T());
+  }
+
+  /**
+   * \brief Discard all elements and change the queue capacity, initializing the storage of every slot to \p prototype.
+   * \note This method is \b not real-time safe, nor thread-safe.
+   */
+  void reset(std::size_t capacity, const T& prototype)
+  {
+    buffer_.assign(capacity, prototype);
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * \brief Append an element. To be called from the producer thread only.
+   * \return False if the queue is full, in which case \p value is not stored.
+   * \note This method is realtime-safe.
+   */
+  bool push(const T& value)
+  {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= buffer_.size()) {return false;}
+
+    buffer_[tail % buffer_.size()] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Start appending an element in place. To be called from the producer thread only.
+   * \return Slot of the element, holding a previously popped element or the reset() prototype, or null if the queue is
+   * full. It is only visible to the consumer after commitPush().
+   * \note This method is realtime-safe.
+   */
+  T* beginPush()
+  {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= buffer_.size()) {return nullptr;}
+
+    return &buffer_[tail % buffer_.size()];
+  }
+
+  /**
+   * \brief Append the element written in the slot returned by the last successful beginPush().
+   * \note This method is realtime-safe.
+   */
+  void commitPush()
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * \brief Remove the oldest element. To be called from the consumer thread only.
+   * \return False if the queue is empty, in which case \p value is left untouched.
+   * \note This method is realtime-safe.
+   */
+  bool pop(T& value)
+  {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {return false;}
+
+    value = buffer_[head % buffer_.size()];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \return Maximum number of elements the queue holds. */
+  std::size_t capacity() const {return buffer_.size();}
+
+private:
+  std::vector<T> buffer_;
+
+  // Monotonic element counts, kept on separate cache lines to avoid false sharing between producer and consumer
+  alignas(64) std::atomic<std::size_t> head_; ///< Number of elements popped so far.
+  alignas(64) std::atomic<std::size_t> tail_; ///< Number of elements pushed so far.
+};
+
+} // namespace
+
+#endif // header guard
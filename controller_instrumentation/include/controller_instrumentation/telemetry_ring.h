@@ -0,0 +1,424 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_TELEMETRY_RING_H
+#define CONTROLLER_INSTRUMENTATION_TELEMETRY_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ros/node_handle.h>
+
+namespace controller_instrumentation
+{
+
+namespace internal
+{
+
+/**
+ * \brief Layout of the shared memory object of a \ref TelemetryRingWriter.
+ *
+ * The object starts with this header, followed by the channel labels (\p labels_size bytes of null-terminated strings,
+ * padded to a multiple of 8 bytes) and \p capacity records. Each record is a sequence number followed by the record
+ * time stamp and \p record_size values.
+ */
+struct TelemetryRingHeader
+{
+  static const std::uint32_t MAGIC   = 0x52544c43; // "CLTR"
+  static const std::uint32_t VERSION = 1;
+
+  std::uint32_t              magic;
+  std::uint32_t              version;
+  std::uint32_t              record_size;
+  std::uint32_t              capacity;
+  std::uint32_t              labels_size;
+  std::uint32_t              reserved;
+  std::atomic<std::uint64_t> write_count; ///< Number of records written so far.
+};
+
+inline std::size_t telemetryRingLabelsSize(std::size_t labels_size)
+{
+  return (labels_size + 7) & ~std::size_t(7);
+}
+
+inline std::size_t telemetryRingRecordSize(std::size_t record_size)
+{
+  // Sequence number, time stamp and values
+  return sizeof(std::uint64_t) + sizeof(double) + record_size * sizeof(double);
+}
+
+inline std::size_t telemetryRingSize(std::size_t labels_size, std::size_t record_size, std::size_t capacity)
+{
+  return sizeof(TelemetryRingHeader) + telemetryRingLabelsSize(labels_size) +
+         capacity * telemetryRingRecordSize(record_size);
+}
+
+} // namespace internal
+
+/**
+ * \brief Telemetry sample read from a \ref TelemetryRingReader.
+ */
+struct TelemetryRecord
+{
+  std::uint64_t       index; ///< Index of the record since the ring was created.
+  double              stamp; ///< Time of the update cycle the sample belongs to, in seconds.
+  std::vector<double> data;  ///< One value per channel, in the order of the ring labels.
+};
+
+/**
+ * \brief Lock-free single-producer ring buffer of controller telemetry in POSIX shared memory.
+ *
+ * A controller writes one record per update cycle, made of a fixed number of named channels (e.g. joint positions).
+ * Recorders on the same host map the ring with a \ref TelemetryRingReader and drain every sample, without going
+ * through ROS serialization. The writer never blocks: a reader that falls behind by more than the ring capacity loses
+ * the overwritten records, and is told so. Each record is guarded by a sequence number (seqlock), so readers never
+ * return records that were overwritten while being copied.
+ *
+ * \section ROS interface
+ *
+ * \param telemetry_ring_name Shared memory object name, e.g. <tt>"/arm_controller"</tt>. Empty (default) disables the ring.
+ * \param telemetry_ring_capacity Number of records of the ring. Defaults to 4096.
+ *
+ * \note Only one writer may exist per shared memory object.
+ */
+class TelemetryRingWriter
+{
+public:
+  TelemetryRingWriter() : header_(nullptr), records_(nullptr), size_(0), record_size_(0), capacity_(0), index_(0) {}
+  ~TelemetryRingWriter() {close();}
+
+  TelemetryRingWriter(const TelemetryRingWriter&) = delete;
+  TelemetryRingWriter& operator=(const TelemetryRingWriter&) = delete;
+
+  /**
+   * \brief Open the ring configured by the ROS parameters of \p nh, if any.
+   * \param nh Controller node handle.
+   * \param labels Channel names, one per value of each record.
+   * \return False if a ring was configured but could not be created.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh, const std::vector<std::string>& labels)
+  {
+    close();
+
+    std::string name;
+    nh.getParam("telemetry_ring_name", name);
+    if (name.empty()) {return true;}
+
+    int capacity = 4096;
+    nh.getParam("telemetry_ring_capacity", capacity);
+    if (capacity <= 0 || !open(name, labels, capacity))
+    {
+      ROS_ERROR_STREAM("Could not create telemetry ring '" << name << "' with capacity " << capacity << ".");
+      return false;
+    }
+    ROS_DEBUG_STREAM("Telemetry of " << labels.size() << " channels will be written to shared memory ring '" <<
+                     name << "' of " << capacity << " records.");
+    return true;
+  }
+
+  /**
+   * \brief Create (or replace) the shared memory object \p name and map it.
+   * \param name Shared memory object name.
+   * \param labels Channel names, one per value of each record.
+   * \param capacity Number of records of the ring.
+   * \return True on success.
+   * \note This method is \b not real-time safe.
+   */
+  bool open(const std::string& name, const std::vector<std::string>& labels, std::size_t capacity)
+  {
+    close();
+    if (name.empty() || labels.empty() || capacity == 0) {return false;}
+
+    std::size_t labels_size = 0;
+    for (const std::string& label : labels) {labels_size += label.size() + 1;}
+
+    const std::size_t size = internal::telemetryRingSize(labels_size, labels.size(), capacity);
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {return false;}
+    if (::ftruncate(fd, size) != 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {return false;}
+
+    // Lock the pages so that writing never page faults in the realtime thread
+    ::mlock(address, size);
+
+    name_        = name;
+    size_        = size;
+    record_size_ = labels.size();
+    capacity_    = capacity;
+    index_       = 0;
+    header_      = new (address) internal::TelemetryRingHeader();
+    header_->record_size = record_size_;
+    header_->capacity    = capacity_;
+    header_->labels_size = labels_size;
+    header_->version     = internal::TelemetryRingHeader::VERSION;
+    header_->write_count.store(0, std::memory_order_relaxed);
+
+    char* labels_data = static_cast<char*>(address) + sizeof(internal::TelemetryRingHeader);
+    for (const std::string& label : labels)
+    {
+      std::memcpy(labels_data, label.c_str(), label.size() + 1);
+      labels_data += label.size() + 1;
+    }
+    records_ = static_cast<char*>(address) + sizeof(internal::TelemetryRingHeader) +
+               internal::telemetryRingLabelsSize(labels_size);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = internal::TelemetryRingHeader::MAGIC; // Readers check the magic number last
+    return true;
+  }
+
+  /**
+   * \brief Unmap and remove the shared memory object. Readers that already mapped it keep their mapping.
+   * \note This method is \b not real-time safe.
+   */
+  void close()
+  {
+    if (!header_) {return;}
+    ::munmap(header_, size_);
+    ::shm_unlink(name_.c_str());
+    header_  = nullptr;
+    records_ = nullptr;
+  }
+
+  /** \return True if the ring is open. */
+  bool isOpen() const {return header_ != nullptr;}
+
+  /** \return Number of values of each record. */
+  std::size_t recordSize() const {return record_size_;}
+
+  /**
+   * \brief Start writing a record.
+   * \param stamp Time of the sample, in seconds.
+   * \return Pointer to the \ref recordSize values of the record, to be filled in before calling \ref commit. Null if
+   * the ring is not open.
+   * \note This method is realtime-safe.
+   */
+  double* beginWrite(double stamp)
+  {
+    if (!header_) {return nullptr;}
+
+    char* record = records_ + (index_ % capacity_) * internal::telemetryRingRecordSize(record_size_);
+
+    // An odd sequence number marks a record being written
+    sequence(record)->store(2 * index_ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    double* data = reinterpret_cast<double*>(record + sizeof(std::uint64_t));
+    data[0] = stamp;
+    return data + 1;
+  }
+
+  /**
+   * \brief Make the record started by the last call to \ref beginWrite available to readers.
+   * \note This method is realtime-safe.
+   */
+  void commit()
+  {
+    if (!header_) {return;}
+
+    char* record = records_ + (index_ % capacity_) * internal::telemetryRingRecordSize(record_size_);
+    sequence(record)->store(2 * index_ + 2, std::memory_order_release);
+    header_->write_count.store(++index_, std::memory_order_release);
+  }
+
+private:
+  std::string                    name_;
+  internal::TelemetryRingHeader* header_;
+  char*                          records_;
+  std::size_t                    size_;
+  std::size_t                    record_size_;
+  std::size_t                    capacity_;
+  std::uint64_t                  index_;   ///< Index of the record being written.
+
+  static std::atomic<std::uint64_t>* sequence(char* record)
+  {
+    return reinterpret_cast<std::atomic<std::uint64_t>*>(record);
+  }
+};
+
+/**
+ * \brief Reader of the telemetry written by a \ref TelemetryRingWriter, typically in another process.
+ *
+ * Records are read in order. A reader that falls behind the writer by more than the ring capacity loses the
+ * overwritten records, which is reported by \ref read.
+ */
+class TelemetryRingReader
+{
+public:
+  enum Result
+  {
+    OK,      ///< A record was read.
+    EMPTY,   ///< No record has been written since the last read.
+    OVERRUN  ///< Records were overwritten before being read. The next read continues from the oldest available one.
+  };
+
+  TelemetryRingReader() : header_(nullptr), records_(nullptr), size_(0), record_size_(0), capacity_(0), next_(0) {}
+  ~TelemetryRingReader() {close();}
+
+  TelemetryRingReader(const TelemetryRingReader&) = delete;
+  TelemetryRingReader& operator=(const TelemetryRingReader&) = delete;
+
+  /**
+   * \brief Map the existing shared memory object \p name for reading.
+   *
+   * Reading starts at the oldest record still held by the ring.
+   * \return True on success.
+   */
+  bool open(const std::string& name)
+  {
+    close();
+
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {return false;}
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(internal::TelemetryRingHeader))
+    {
+      ::close(fd);
+      return false;
+    }
+    void* address = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {return false;}
+
+    header_ = static_cast<const internal::TelemetryRingHeader*>(address);
+    size_   = info.st_size;
+    const bool valid = header_->magic == internal::TelemetryRingHeader::MAGIC &&
+                       header_->version == internal::TelemetryRingHeader::VERSION &&
+                       header_->capacity > 0 &&
+                       size_ >= internal::telemetryRingSize(header_->labels_size, header_->record_size,
+                                                            header_->capacity);
+    if (!valid)
+    {
+      close();
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    record_size_ = header_->record_size;
+    capacity_    = header_->capacity;
+
+    const char* labels_data = static_cast<const char*>(address) + sizeof(internal::TelemetryRingHeader);
+    const char* labels_end  = labels_data + header_->labels_size;
+    labels_.clear();
+    while (labels_data < labels_end)
+    {
+      labels_.push_back(labels_data);
+      labels_data += labels_.back().size() + 1;
+    }
+    records_ = static_cast<const char*>(address) + sizeof(internal::TelemetryRingHeader) +
+               internal::telemetryRingLabelsSize(header_->labels_size);
+
+    const std::uint64_t written = header_->write_count.load(std::memory_order_acquire);
+    next_ = written > capacity_ ? written - capacity_ : 0;
+    return true;
+  }
+
+  /** \brief Unmap the shared memory object. */
+  void close()
+  {
+    if (!header_) {return;}
+    ::munmap(const_cast<internal::TelemetryRingHeader*>(header_), size_);
+    header_  = nullptr;
+    records_ = nullptr;
+  }
+
+  /** \return True if the ring is open. */
+  bool isOpen() const {return header_ != nullptr;}
+
+  /** \return Channel names, one per value of each record. Only valid if the ring is open. */
+  const std::vector<std::string>& labels() const {return labels_;}
+
+  /**
+   * \brief Read the next record.
+   * \param[out] record Record read. Its data are only valid if \ref OK is returned.
+   * \pre The ring is open.
+   */
+  Result read(TelemetryRecord& record)
+  {
+    const std::uint64_t written = header_->write_count.load(std::memory_order_acquire);
+    if (next_ >= written) {return EMPTY;}
+    if (written - next_ > capacity_)
+    {
+      next_ = written - capacity_;
+      return OVERRUN;
+    }
+
+    const char* slot = records_ + (next_ % capacity_) * internal::telemetryRingRecordSize(record_size_);
+    const std::atomic<std::uint64_t>* sequence = reinterpret_cast<const std::atomic<std::uint64_t>*>(slot);
+    const std::uint64_t expected = 2 * next_ + 2;
+    if (sequence->load(std::memory_order_acquire) != expected) {return skipOverwritten();}
+
+    const double* data = reinterpret_cast<const double*>(slot + sizeof(std::uint64_t));
+    record.data.resize(record_size_);
+    std::memcpy(&record.stamp, data, sizeof(double));
+    std::memcpy(record.data.data(), data + 1, record_size_ * sizeof(double));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence->load(std::memory_order_relaxed) != expected) {return skipOverwritten();}
+
+    record.index = next_++;
+    return OK;
+  }
+
+private:
+  const internal::TelemetryRingHeader* header_;
+  const char*                          records_;
+  std::size_t                          size_;
+  std::size_t                          record_size_;
+  std::size_t                          capacity_;
+  std::uint64_t                        next_;   ///< Index of the next record to read.
+  std::vector<std::string>             labels_;
+
+  Result skipOverwritten()
+  {
+    // The record being read was overwritten, so the writer is at least one full ring ahead of it: Continue from the
+    // oldest record that will survive the write in progress
+    next_ = header_->write_count.load(std::memory_order_acquire) - capacity_ + 1;
+    return OVERRUN;
+  }
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_THREAD_PLACEMENT_H
+#define CONTROLLER_INSTRUMENTATION_THREAD_PLACEMENT_H
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <linux/capability.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ros/node_handle.h>
+
+namespace controller_instrumentation
+{
+
+class ThreadPlacementScope;
+
+/**
+ * \brief CPU affinity and niceness of the non-realtime threads of a controller.
+ *
+ * Controllers create helper threads as they are initialized: one per \c realtime_tools::RealtimePublisher, and those
+ * of publisher pools, worker pools or flight recorders. Linux threads inherit the affinity and niceness of the thread
+ * that creates them, so applying a placement with a \ref ThreadPlacementScope while these are created keeps them off
+ * the cores reserved for the control loop.
+ *
+ * Parameters, looked up from the node handle passed to \ref init up the namespace hierarchy, so that they can be set
+ * once for all controllers of a controller manager:
+ * - \p nonrt_thread_affinity, list of CPU indices the threads may run on. Empty (default) leaves the affinity unchanged.
+ * - \p nonrt_thread_nice, niceness of the threads, from -20 to 19. Left unchanged if not set, or if the calling thread
+ *   could not restore its own niceness afterwards, see \ref ThreadPlacementScope.
+ */
+class ThreadPlacement
+{
+public:
+  ThreadPlacement() : nice_set_(false), nice_(0) {}
+
+  /**
+   * \brief Read the placement parameters.
+   * \param name Controller name, only used to prefix log messages.
+   * \return False if a parameter is invalid.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh, const std::string& name)
+  {
+    name_ = name;
+    cpus_.clear();
+    nice_set_ = false;
+
+    std::string key;
+    if (nh.searchParam("nonrt_thread_affinity", key) && !nh.getParam(key, cpus_))
+    {
+      ROS_ERROR_STREAM_NAMED(name, "Parameter '" << key << "' must be a list of CPU indices.");
+      return false;
+    }
+    for (int cpu : cpus_)
+    {
+      if (cpu < 0 || cpu >= CPU_SETSIZE)
+      {
+        ROS_ERROR_STREAM_NAMED(name, "Invalid CPU index " << cpu << " in parameter '" << key << "'.");
+        return false;
+      }
+    }
+
+    if (nh.searchParam("nonrt_thread_nice", key))
+    {
+      if (!nh.getParam(key, nice_) || nice_ < -20 || nice_ > 19)
+      {
+        ROS_ERROR_STREAM_NAMED(name, "Parameter '" << key << "' must be an integer between -20 and 19.");
+        return false;
+      }
+      nice_set_ = true;
+    }
+    return true;
+  }
+
+  /**
+   * \brief Read the placement parameters of \p nh, see init(), and apply them to the calling thread until the returned
+   * scope is destroyed. Meant to wrap the initialization of a controller:
+   * \code
+   * const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh);
+   * if (!thread_placement_scope) {return false;}
+   * \endcode
+   * \param name Controller name, only used to prefix log messages. Defaults to the namespace of \p nh.
+   * \return Null if a parameter is invalid.
+   * \note This method is \b not real-time safe.
+   */
+  static std::unique_ptr<ThreadPlacementScope> scopeFromParam(const ros::NodeHandle& nh,
+                                                              const std::string& name = std::string());
+
+  /** \brief Set the placement, bypassing the parameter server. An empty \p cpus list leaves the affinity unchanged. */
+  void set(const std::vector<int>& cpus) {cpus_ = cpus;}
+  void setNice(int nice) {nice_ = nice; nice_set_ = true;}
+
+  const std::string& name() const {return name_;}
+  const std::vector<int>& cpus() const {return cpus_;}
+  bool niceSet() const {return nice_set_;}
+  int nice() const {return nice_;}
+
+  /** \return True if the placement changes neither the affinity nor the niceness of threads. */
+  bool empty() const {return cpus_.empty() && !nice_set_;}
+
+private:
+  std::string name_;
+  std::vector<int> cpus_;
+  bool nice_set_;
+  int nice_;
+};
+
+/**
+ * \brief Apply a \ref ThreadPlacement to the calling thread for the lifetime of the scope, so that the threads it
+ * creates inherit it, and restore the previous placement on exit.
+ *
+ * Failures are reported as warnings, as they do not prevent the controller from working. Restoring a lower niceness
+ * than the one applied requires the \p CAP_SYS_NICE capability or a suitable \p RLIMIT_NICE. Without them, the niceness
+ * is left unchanged, as the calling thread, usually one serving the controller manager, would otherwise stay
+ * de-prioritized for the lifetime of the process.
+ * \note This class is \b not real-time safe. It is meant to wrap the initialization of a controller, which runs in a
+ * non-realtime thread of the controller manager.
+ */
+class ThreadPlacementScope
+{
+public:
+  explicit ThreadPlacementScope(const ThreadPlacement& placement)
+    : name_(placement.name()),
+      cpus_applied_(false),
+      nice_applied_(false),
+      saved_nice_(0)
+  {
+    if (!placement.cpus().empty())
+    {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (int cpu : placement.cpus()) {CPU_SET(cpu, &cpus);}
+
+      if (sched_getaffinity(0, sizeof(saved_cpus_), &saved_cpus_) != 0 ||
+          sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+      {
+        ROS_WARN_STREAM_NAMED(name_, "Could not set the CPU affinity of non-realtime threads: " << std::strerror(errno));
+      }
+      else {cpus_applied_ = true;}
+    }
+
+    if (placement.niceSet())
+    {
+      errno = 0;
+      saved_nice_ = getpriority(PRIO_PROCESS, threadId());
+      if (errno != 0)
+      {
+        ROS_WARN_STREAM_NAMED(name_, "Could not get the niceness of the calling thread: " << std::strerror(errno));
+      }
+      else if (placement.nice() > saved_nice_ && !canLowerNice(saved_nice_))
+      {
+        ROS_WARN_STREAM_NAMED(name_, "Not setting the niceness of non-realtime threads to " << placement.nice() <<
+                              ": the calling thread could not restore its niceness of " << saved_nice_ <<
+                              " afterwards without CAP_SYS_NICE or an RLIMIT_NICE of at least " << 20 - saved_nice_ <<
+                              ".");
+      }
+      else if (setpriority(PRIO_PROCESS, threadId(), placement.nice()) != 0)
+      {
+        ROS_WARN_STREAM_NAMED(name_, "Could not set the niceness of non-realtime threads: " << std::strerror(errno));
+      }
+      else {nice_applied_ = true;}
+    }
+  }
+
+  ~ThreadPlacementScope()
+  {
+    if (cpus_applied_ && sched_setaffinity(0, sizeof(saved_cpus_), &saved_cpus_) != 0)
+    {
+      ROS_WARN_STREAM_NAMED(name_, "Could not restore the CPU affinity of the calling thread: " << std::strerror(errno));
+    }
+    if (nice_applied_ && setpriority(PRIO_PROCESS, threadId(), saved_nice_) != 0)
+    {
+      ROS_WARN_STREAM_NAMED(name_, "Could not restore the niceness of the calling thread: " << std::strerror(errno));
+    }
+  }
+
+  /**
+   * \return True if the calling process may lower the niceness of its threads down to \p nice, that is if it has the
+   * \p CAP_SYS_NICE capability or an \p RLIMIT_NICE of at least <tt>20 - nice</tt>.
+   */
+  static bool canLowerNice(int nice)
+  {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NICE, &limit) == 0 &&
+        (limit.rlim_cur == RLIM_INFINITY || static_cast<rlim_t>(20 - nice) <= limit.rlim_cur))
+    {
+      return true;
+    }
+
+    __user_cap_header_struct header;
+    header.version = _LINUX_CAPABILITY_VERSION_3;
+    header.pid = 0;
+    __user_cap_data_struct data[_LINUX_CAPABILITY_U32S_3];
+    return syscall(SYS_capget, &header, data) == 0 &&
+           (data[CAP_TO_INDEX(CAP_SYS_NICE)].effective & CAP_TO_MASK(CAP_SYS_NICE)) != 0;
+  }
+
+  ThreadPlacementScope(const ThreadPlacementScope&) = delete;
+  ThreadPlacementScope& operator=(const ThreadPlacementScope&) = delete;
+
+private:
+  std::string name_;
+  bool cpus_applied_;
+  bool nice_applied_;
+  cpu_set_t saved_cpus_;
+  int saved_nice_;
+
+  /// Niceness is a per-thread attribute on Linux, addressed by thread id
+  static id_t threadId() {return static_cast<id_t>(syscall(SYS_gettid));}
+};
+
+inline std::unique_ptr<ThreadPlacementScope> ThreadPlacement::scopeFromParam(const ros::NodeHandle& nh,
+                                                                             const std::string& name)
+{
+  ThreadPlacement placement;
+  if (!placement.init(nh, name.empty() ? nh.getNamespace() : name)) {return nullptr;}
+  return std::unique_ptr<ThreadPlacementScope>(new ThreadPlacementScope(placement));
+}
+
+} // namespace
+
+#endif // header guard
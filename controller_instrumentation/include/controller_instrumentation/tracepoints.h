@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_TRACEPOINTS_H
+#define CONTROLLER_INSTRUMENTATION_TRACEPOINTS_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * \file
+ * \brief Static tracepoints (USDT probes) of the controllers realtime loops.
+ *
+ * Probes belong to the \p ros_controllers provider and can be enabled at runtime by tracers that support user-space
+ * statically defined tracing, e.g. <tt>perf probe sdt_ros_controllers:update_begin</tt>, bpftrace, SystemTap or
+ * LTTng, without rebuilding the controllers. Disabled probes are a single \p nop instruction, and their arguments are
+ * only computed into registers. Arguments must therefore be integers or pointers, such as a controller name or the
+ * index of a joint, and not require expensive computations.
+ *
+ * Probes are compiled in when the \p CONTROLLER_INSTRUMENTATION_TRACEPOINTS CMake option is enabled (default) and
+ * \p sys/sdt.h is available, e.g. from the \p systemtap-sdt-dev package. Otherwise they compile away.
+ */
+
+#ifdef CONTROLLER_INSTRUMENTATION_TRACEPOINTS
+#include <sys/sdt.h>
+#define CONTROLLER_TRACEPOINT(name)                 DTRACE_PROBE(ros_controllers, name)
+#define CONTROLLER_TRACEPOINT1(name, a1)            DTRACE_PROBE1(ros_controllers, name, a1)
+#define CONTROLLER_TRACEPOINT2(name, a1, a2)        DTRACE_PROBE2(ros_controllers, name, a1, a2)
+#define CONTROLLER_TRACEPOINT3(name, a1, a2, a3)    DTRACE_PROBE3(ros_controllers, name, a1, a2, a3)
+#else
+#define CONTROLLER_TRACEPOINT(name)                 do {} while (false)
+#define CONTROLLER_TRACEPOINT1(name, a1)            do {(void) sizeof(a1);} while (false)
+#define CONTROLLER_TRACEPOINT2(name, a1, a2)        do {(void) sizeof(a1); (void) sizeof(a2);} while (false)
+#define CONTROLLER_TRACEPOINT3(name, a1, a2, a3)    do {(void) sizeof(a1); (void) sizeof(a2); (void) sizeof(a3);} \
+                                                    while (false)
+#endif
+
+namespace controller_instrumentation
+{
+
+namespace internal
+{
+
+/** \return Number of failed tracedTrylock() calls of the process, exported by the \ref MetricsRegistry. */
+inline std::atomic<std::uint64_t>& publisherTrylockFailures()
+{
+  static std::atomic<std::uint64_t> failures(0);
+  return failures;
+}
+
+} // namespace
+
+/**
+ * \brief Fire the \p update_begin and \p update_end tracepoints at the start and end of the enclosing scope.
+ *
+ * Both tracepoints take the controller name as argument.
+ * \note This class is realtime-safe.
+ */
+class UpdateTraceScope
+{
+public:
+  explicit UpdateTraceScope(const char* name) : name_(name) {CONTROLLER_TRACEPOINT1(update_begin, name_);}
+  ~UpdateTraceScope() {CONTROLLER_TRACEPOINT1(update_end, name_);}
+
+  UpdateTraceScope(const UpdateTraceScope&) = delete;
+  UpdateTraceScope& operator=(const UpdateTraceScope&) = delete;
+
+private:
+  const char* name_;
+};
+
+/**
+ * \brief Try to lock a realtime publisher, firing the \p publisher_trylock_failed tracepoint if it is busy.
+ *
+ * Failures are also counted in the \p ros_controllers_publisher_trylock_failures_total metric.
+ * \param publisher Realtime publisher, e.g. a \c realtime_tools::RealtimePublisher or a \ref PooledPublisher.
+ * \param topic Topic name, the argument of the tracepoint. Must be a string literal, or a string that outlives it.
+ * \return The result of \c publisher.trylock().
+ * \note This function is realtime-safe.
+ */
+template <class Publisher>
+inline bool tracedTrylock(Publisher& publisher, const char* topic)
+{
+  if (publisher.trylock()) {return true;}
+  CONTROLLER_TRACEPOINT1(publisher_trylock_failed, topic);
+  internal::publisherTrylockFailures().fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+} // namespace
+
+#endif // header guard
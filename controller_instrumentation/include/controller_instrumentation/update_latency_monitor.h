@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_UPDATE_LATENCY_MONITOR_H
+#define CONTROLLER_INSTRUMENTATION_UPDATE_LATENCY_MONITOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <ros/node_handle.h>
+#include <ros/timer.h>
+
+#include <controller_instrumentation/latency_histogram.h>
+#include <controller_instrumentation/metrics.h>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Monitor of the duration and jitter of a controller's update cycles.
+ *
+ * The realtime thread records, for every cycle, the duration of update() and its jitter, defined as the absolute
+ * difference between the intervals separating the starts of the last two pairs of consecutive cycles. Both are
+ * measured with \p std::chrono::steady_clock and stored in lock-free histograms.
+ *
+ * A ROS timer, i.e. a non-realtime thread, periodically publishes the p50, p99, p99.9 and maximum of the samples
+ * recorded since its previous run as a \p diagnostic_msgs/DiagnosticStatus named <tt>"<controller name>: update
+ * latency"</tt> on the \p /diagnostics topic. All values are in microseconds.
+ *
+ * Both histograms are also exported as the \p ros_controllers_update_duration_seconds and
+ * \p ros_controllers_update_jitter_seconds summaries of the \ref MetricsRegistry.
+ *
+ * \section ROS interface
+ *
+ * \param latency_publish_rate Rate at which statistics are published. Defaults to 1Hz, zero disables publishing.
+ */
+class UpdateLatencyMonitor
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  UpdateLatencyMonitor() : last_interval_(0), has_start_(false), has_interval_(false) {}
+
+  /**
+   * \brief Initialize the monitor.
+   * \param nh Controller node handle, used to read parameters and advertise the diagnostics topic.
+   * \param name Name of the monitored controller.
+   * \note This method is \b not real-time safe.
+   */
+  void init(ros::NodeHandle& nh, const std::string& name)
+  {
+    name_ = name;
+    duration_summary_.init("ros_controllers_update_duration_seconds", "Duration of the controller update cycles.",
+                           name_, duration_, 1e-9);
+    jitter_summary_.init("ros_controllers_update_jitter_seconds", "Jitter of the controller update cycles.",
+                         name_, jitter_, 1e-9);
+
+    double publish_rate = 1.0;
+    nh.param("latency_publish_rate", publish_rate, publish_rate);
+    if (publish_rate <= 0.0) {return;}
+
+    diagnostics_pub_ = nh.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 1);
+    duration_window_start_ = duration_.snapshot();
+    jitter_window_start_   = jitter_.snapshot();
+    publish_timer_ = nh.createTimer(ros::Duration(1.0 / publish_rate), &UpdateLatencyMonitor::publishCB, this);
+  }
+
+  /**
+   * \brief Forget the start time of the last cycle, so that the next cycle does not contribute a jitter sample.
+   *
+   * Call when the controller is (re)started, as cycles are not periodic across restarts.
+   * \note This method is realtime-safe.
+   */
+  void restart()
+  {
+    has_start_    = false;
+    has_interval_ = false;
+  }
+
+  /**
+   * \brief Mark the start of an update cycle.
+   * \note This method is realtime-safe.
+   */
+  void begin()
+  {
+    const Clock::time_point start = Clock::now();
+    if (has_start_)
+    {
+      const std::int64_t interval = toNanoseconds(start - cycle_start_);
+      if (has_interval_)
+      {
+        const std::int64_t deviation = interval - last_interval_;
+        jitter_.record(static_cast<std::uint64_t>(deviation < 0 ? -deviation : deviation));
+      }
+      last_interval_ = interval;
+      has_interval_  = true;
+    }
+    cycle_start_ = start;
+    has_start_   = true;
+  }
+
+  /**
+   * \brief Mark the end of the update cycle started by the last call to begin().
+   * \note This method is realtime-safe.
+   */
+  void end()
+  {
+    const std::int64_t duration = toNanoseconds(Clock::now() - cycle_start_);
+    duration_.record(static_cast<std::uint64_t>(duration < 0 ? 0 : duration));
+  }
+
+  /** \return Histogram of update cycle durations, in nanoseconds. */
+  LatencyHistogram& duration() {return duration_;}
+
+  /** \return Histogram of update cycle jitter, in nanoseconds. */
+  LatencyHistogram& jitter() {return jitter_;}
+
+private:
+  std::string       name_;
+
+  // Realtime thread
+  LatencyHistogram  duration_;
+  LatencyHistogram  jitter_;
+  Clock::time_point cycle_start_;
+  std::int64_t      last_interval_;
+  bool              has_start_;
+  bool              has_interval_;
+
+  // Non-realtime publishing and export
+  LatencySummary              duration_summary_;
+  LatencySummary              jitter_summary_;
+  ros::Publisher              diagnostics_pub_;
+  ros::Timer                  publish_timer_;
+  LatencyHistogram::Snapshot  duration_window_start_;
+  LatencyHistogram::Snapshot  jitter_window_start_;
+
+  static std::int64_t toNanoseconds(Clock::duration duration)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  }
+
+  static std::string toMicroseconds(std::uint64_t nanoseconds)
+  {
+    return std::to_string(nanoseconds / 1000.0);
+  }
+
+  static void addStatistics(const std::string& prefix,
+                            const LatencyHistogram::Snapshot& window,
+                            diagnostic_msgs::DiagnosticStatus& status)
+  {
+    const std::pair<const char*, double> quantiles[] = {{"p50", 0.5}, {"p99", 0.99}, {"p99.9", 0.999}};
+    for (const auto& quantile : quantiles)
+    {
+      diagnostic_msgs::KeyValue value;
+      value.key   = prefix + " " + quantile.first + " [us]";
+      value.value = toMicroseconds(window.percentile(quantile.second));
+      status.values.push_back(value);
+    }
+    diagnostic_msgs::KeyValue value;
+    value.key   = prefix + " max [us]";
+    value.value = toMicroseconds(window.max());
+    status.values.push_back(value);
+  }
+
+  void publishCB(const ros::TimerEvent&)
+  {
+    const LatencyHistogram::Snapshot duration_now = duration_.snapshot();
+    const LatencyHistogram::Snapshot jitter_now   = jitter_.snapshot();
+    const LatencyHistogram::Snapshot duration_window =
+        duration_now.since(duration_window_start_, duration_.exchangeWindowMax());
+    const LatencyHistogram::Snapshot jitter_window =
+        jitter_now.since(jitter_window_start_, jitter_.exchangeWindowMax());
+    duration_window_start_ = duration_now;
+    jitter_window_start_   = jitter_now;
+
+    diagnostic_msgs::DiagnosticStatus status;
+    status.name        = name_ + ": update latency";
+    status.hardware_id = name_;
+    status.level       = duration_window.count() > 0 ? diagnostic_msgs::DiagnosticStatus::OK
+                                                     : diagnostic_msgs::DiagnosticStatus::STALE;
+    status.message     = duration_window.count() > 0 ? "Update statistics over last publish period"
+                                                     : "No update cycles in last publish period";
+
+    diagnostic_msgs::KeyValue samples;
+    samples.key   = "samples";
+    samples.value = std::to_string(duration_window.count());
+    status.values.push_back(samples);
+    addStatistics("duration", duration_window, status);
+    addStatistics("jitter",   jitter_window,   status);
+
+    diagnostic_msgs::DiagnosticArray msg;
+    msg.header.stamp = ros::Time::now();
+    msg.status.push_back(status);
+    diagnostics_pub_.publish(msg);
+  }
+};
+
+/**
+ * \brief Records the duration of an update cycle spanning its lifetime.
+ *
+ * Place at the top of a controller's update() method:
+ * \code
+ * controller_instrumentation::UpdateLatencyScope latency_scope(latency_monitor_);
+ * \endcode
+ */
+class UpdateLatencyScope
+{
+public:
+  explicit UpdateLatencyScope(UpdateLatencyMonitor& monitor) : monitor_(monitor) {monitor_.begin();}
+  ~UpdateLatencyScope() {monitor_.end();}
+
+  UpdateLatencyScope(const UpdateLatencyScope&) = delete;
+  UpdateLatencyScope& operator=(const UpdateLatencyScope&) = delete;
+
+private:
+  UpdateLatencyMonitor& monitor_;
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONTROLLER_INSTRUMENTATION_VERSIONED_BUFFER_H
+#define CONTROLLER_INSTRUMENTATION_VERSIONED_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace controller_instrumentation
+{
+
+/**
+ * \brief Value written by non-realtime threads and read by the realtime thread only when it changes.
+ *
+ * Every write bumps a version counter. The realtime thread compares it against the version it last copied, so
+ * unchanged values cost a single atomic load per cycle, instead of the copy and recomputation of derived quantities
+ * done when reading a realtime_tools::RealtimeBuffer every cycle.
+ */
+template <class T>
+class VersionedBuffer
+{
+public:
+  VersionedBuffer() : version_(0), rt_version_(0) {}
+
+  /**
+   * \brief Store a new value, to be picked up by the realtime thread.
+   * \note This method is \b not real-time safe.
+   */
+  void writeFromNonRT(const T& value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    non_rt_value_ = value;
+    version_.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * \brief Copy the latest value written by writeFromNonRT(), if it changed since the last call.
+   * \return True if the value returned by readFromRT() changed. If a non-realtime write is in progress, the new value
+   * is picked up by a later call.
+   * \note This method is realtime-safe.
+   */
+  bool updateFromRT()
+  {
+    if (version_.load(std::memory_order_acquire) == rt_version_) {return false;}
+
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {return false;}
+
+    rt_value_   = non_rt_value_;
+    rt_version_ = version_.load(std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * \return Value as of the last successful updateFromRT().
+   * \note This method is realtime-safe.
+   */
+  const T& readFromRT() const {return rt_value_;}
+
+private:
+  std::mutex                 mutex_;        ///< Protects non_rt_value_.
+  T                          non_rt_value_;
+  std::atomic<std::uint64_t> version_;      ///< Number of writes so far.
+
+  T             rt_value_;
+  std::uint64_t rt_version_; ///< Version of rt_value_.
+};
+
+} // namespace
+
+#endif // header guard
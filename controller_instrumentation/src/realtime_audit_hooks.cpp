@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+// Interposes the C library memory allocation and mutex functions to count calls made while a thread is audited.
+// Requires glibc, which exports the underlying implementations as __libc_* symbols.
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <cstddef>
+
+#include <controller_instrumentation/realtime_audit_counters.h>
+
+using controller_instrumentation::RealtimeAuditCounts;
+using controller_instrumentation::internal::ThreadAuditState;
+
+extern "C"
+{
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void  __libc_free(void* ptr);
+}
+
+namespace
+{
+
+// Initial-exec TLS does not allocate on first access, which is required when called from within malloc
+__thread ThreadAuditState thread_state __attribute__((tls_model("initial-exec"))) = {false, RealtimeAuditCounts()};
+
+typedef int (*MutexLockFunction)(pthread_mutex_t*);
+MutexLockFunction real_pthread_mutex_lock = nullptr;
+
+inline void countAllocation()
+{
+  if (thread_state.active) {++thread_state.counts.allocations;}
+}
+
+} // namespace
+
+extern "C"
+{
+
+ThreadAuditState* controller_instrumentation_thread_audit_state()
+{
+  return &thread_state;
+}
+
+void* malloc(std::size_t size)
+{
+  countAllocation();
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size)
+{
+  countAllocation();
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, std::size_t size)
+{
+  countAllocation();
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size)
+{
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size)
+{
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {return 22;} // EINVAL
+  countAllocation();
+  void* result = __libc_memalign(alignment, size);
+  if (!result) {return 12;} // ENOMEM
+  *ptr = result;
+  return 0;
+}
+
+void free(void* ptr)
+{
+  if (ptr && thread_state.active) {++thread_state.counts.deallocations;}
+  __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+  if (!real_pthread_mutex_lock)
+  {
+    // Benign race: all threads resolve the same address
+    real_pthread_mutex_lock = reinterpret_cast<MutexLockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+  }
+  if (thread_state.active) {++thread_state.counts.mutex_locks;}
+  return real_pthread_mutex_lock(mutex);
+}
+
+} // extern "C"
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/command_channel.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+
+struct Command
+{
+  Command() : a(0), b(0) {}
+  Command(long a, long b) : a(a), b(b) {}
+
+  long a;
+  long b;
+};
+
+} // namespace
+
+TEST(CommandChannelTest, LatestWrite)
+{
+  CommandChannel<int> channel;
+  channel.initRT(1);
+  EXPECT_EQ(1, *channel.readFromRT());
+
+  channel.writeFromNonRT(2);
+  EXPECT_EQ(2, *channel.readFromRT());
+  EXPECT_EQ(2, *channel.readFromRT());
+
+  // Only the last of several writes is seen
+  channel.writeFromNonRT(3);
+  channel.writeFromNonRT(4);
+  EXPECT_EQ(4, *channel.readFromRT());
+
+  EXPECT_EQ(3u, channel.stats().writes());
+  EXPECT_EQ(1u, channel.stats().overwritten());
+  EXPECT_EQ(0u, channel.stats().contendedWrites());
+  EXPECT_EQ(2u, channel.stats().latency().snapshot().count());
+}
+
+TEST(CommandChannelTest, ConcurrentWriters)
+{
+  CommandChannel<Command> channel;
+  const long WRITES = 100000;
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> writers;
+  for (long w = 1; w <= 3; ++w)
+  {
+    writers.emplace_back([&channel, w]
+    {
+      for (long i = 0; i < WRITES; ++i) {channel.writeFromNonRT(Command(w * i, -w * i));}
+    });
+  }
+
+  // The reader must never see a torn write
+  long torn = 0;
+  std::thread reader([&]
+  {
+    while (!done.load())
+    {
+      const Command* command = channel.readFromRT();
+      if (command->a != -command->b) {++torn;}
+    }
+  });
+
+  for (std::thread& writer : writers) {writer.join();}
+  done.store(true);
+  reader.join();
+
+  EXPECT_EQ(0, torn);
+  EXPECT_EQ(static_cast<std::uint64_t>(3 * WRITES), channel.stats().writes());
+  EXPECT_LE(channel.stats().overwritten(), channel.stats().writes());
+}
+
+TEST(CommandChannelTest, FillInPlace)
+{
+  CommandChannel<std::vector<double> > channel;
+  channel.initRT(std::vector<double>(3, 0.0));
+
+  const double* source = nullptr;
+  const std::vector<double> command = {1.0, 2.0, 3.0};
+  channel.fillFromNonRT([&](std::vector<double>& data)
+  {
+    EXPECT_EQ(3u, data.size());
+    source = data.data();
+    std::copy(command.begin(), command.end(), data.begin());
+  });
+  const std::vector<double>* read = channel.readFromRT();
+  EXPECT_EQ(command, *read);
+  EXPECT_EQ(source, read->data()); // No copy between write and read
+
+  // Modifications of the reader hold until a newer write
+  channel.readFromRT()->assign(3, 0.0);
+  EXPECT_EQ(std::vector<double>(3, 0.0), *channel.readFromRT());
+  channel.writeFromNonRT(command);
+  EXPECT_EQ(command, *channel.readFromRT());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <controller_instrumentation/flight_recorder.h>
+
+using controller_instrumentation::FlightRecorder;
+using controller_instrumentation::TelemetryRecord;
+using controller_instrumentation::readFlightRecord;
+
+namespace
+{
+
+std::string pathPrefix()
+{
+  return "/tmp/flight_recorder_test_" + std::to_string(::getpid());
+}
+
+std::vector<std::string> labels(unsigned int size)
+{
+  std::vector<std::string> result;
+  for (unsigned int i = 0; i < size; ++i) {result.push_back("channel" + std::to_string(i));}
+  return result;
+}
+
+void write(FlightRecorder& recorder, double stamp, double value)
+{
+  double* data = recorder.beginWrite(stamp);
+  for (unsigned int i = 0; i < recorder.recordSize(); ++i) {data[i] = value + i;}
+  recorder.commit();
+}
+
+/// Dump files whose path starts with \p path_prefix
+std::vector<std::string> dumpFiles(const std::string& path_prefix)
+{
+  const std::size_t separator = path_prefix.find_last_of('/');
+  const std::string directory = path_prefix.substr(0, separator);
+  const std::string prefix    = path_prefix.substr(separator + 1);
+
+  std::vector<std::string> result;
+  DIR* dir = ::opendir(directory.c_str());
+  if (!dir) {return result;}
+  while (const dirent* entry = ::readdir(dir))
+  {
+    const std::string name(entry->d_name);
+    if (name.compare(0, prefix.size(), prefix) == 0) {result.push_back(directory + "/" + name);}
+  }
+  ::closedir(dir);
+  return result;
+}
+
+void removeDumpFiles(const std::string& path_prefix)
+{
+  for (const std::string& path : dumpFiles(path_prefix)) {std::remove(path.c_str());}
+}
+
+} // namespace
+
+TEST(FlightRecorderTest, OpenFailures)
+{
+  FlightRecorder recorder;
+  EXPECT_FALSE(recorder.open(labels(0), 8, pathPrefix()));
+  EXPECT_FALSE(recorder.open(labels(2), 0, pathPrefix()));
+  EXPECT_FALSE(recorder.isOpen());
+
+  // Writing to and dumping a closed recorder are no-ops
+  EXPECT_EQ(nullptr, recorder.beginWrite(0.0));
+  recorder.commit();
+  recorder.requestDump("test");
+  std::string path;
+  EXPECT_FALSE(recorder.dump("test", path));
+
+  // Unwritable directory
+  ASSERT_TRUE(recorder.open(labels(2), 8, "/nonexistent_directory/flight_recorder_test"));
+  EXPECT_FALSE(recorder.dump("test", path));
+}
+
+TEST(FlightRecorderTest, Dump)
+{
+  const unsigned int size = 5;
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.open(labels(size), 8, pathPrefix()));
+  EXPECT_EQ(size, recorder.recordSize());
+  EXPECT_EQ(8u, recorder.capacity());
+
+  for (unsigned int k = 0; k < 5; ++k) {write(recorder, k * 0.01, 10.0 * k);}
+
+  std::string path;
+  ASSERT_TRUE(recorder.dump("test", path));
+  EXPECT_EQ(0u, path.find(pathPrefix()));
+  EXPECT_NE(std::string::npos, path.find("_test.flight"));
+
+  std::vector<std::string> read_labels;
+  std::vector<TelemetryRecord> records;
+  ASSERT_TRUE(readFlightRecord(path, read_labels, records));
+  EXPECT_EQ(labels(size), read_labels);
+  ASSERT_EQ(5u, records.size());
+  for (unsigned int k = 0; k < 5; ++k)
+  {
+    EXPECT_EQ(k, records[k].index);
+    EXPECT_EQ(k * 0.01, records[k].stamp);
+    ASSERT_EQ(size, records[k].data.size());
+    for (unsigned int i = 0; i < size; ++i) {EXPECT_EQ(10.0 * k + i, records[k].data[i]);}
+  }
+
+  // Successive dumps are written to different files
+  std::string other_path;
+  ASSERT_TRUE(recorder.dump("test", other_path));
+  EXPECT_NE(path, other_path);
+
+  // Files that are not dumps are rejected
+  EXPECT_FALSE(readFlightRecord("/nonexistent_file", read_labels, records));
+  EXPECT_FALSE(readFlightRecord("/proc/self/cmdline", read_labels, records));
+
+  removeDumpFiles(pathPrefix());
+}
+
+TEST(FlightRecorderTest, Wraparound)
+{
+  const unsigned int capacity = 4;
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.open(labels(1), capacity, pathPrefix()));
+  for (unsigned int k = 0; k < 10; ++k) {write(recorder, k, k);}
+
+  // Only the last records are held
+  std::string path;
+  ASSERT_TRUE(recorder.dump("test", path));
+  std::vector<std::string> read_labels;
+  std::vector<TelemetryRecord> records;
+  ASSERT_TRUE(readFlightRecord(path, read_labels, records));
+  ASSERT_EQ(capacity, records.size());
+  for (unsigned int k = 0; k < capacity; ++k)
+  {
+    EXPECT_EQ(10 - capacity + k, records[k].index);
+    EXPECT_EQ(10 - capacity + k, records[k].data[0]);
+  }
+
+  removeDumpFiles(pathPrefix());
+}
+
+TEST(FlightRecorderTest, RequestDump)
+{
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.open(labels(2), 16, pathPrefix()));
+  for (unsigned int k = 0; k < 3; ++k) {write(recorder, k, k);}
+
+  // Requests are served by the recorder thread
+  recorder.requestDump("aborted");
+  std::vector<std::string> files;
+  for (unsigned int attempt = 0; attempt < 500 && files.empty(); ++attempt)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    files = dumpFiles(pathPrefix());
+  }
+  ASSERT_EQ(1u, files.size());
+  EXPECT_NE(std::string::npos, files[0].find("_aborted.flight"));
+
+  // Closing serves pending requests
+  removeDumpFiles(pathPrefix());
+  recorder.requestDump("closed");
+  recorder.close();
+  files = dumpFiles(pathPrefix());
+  ASSERT_EQ(1u, files.size());
+
+  std::vector<std::string> read_labels;
+  std::vector<TelemetryRecord> records;
+  ASSERT_TRUE(readFlightRecord(files[0], read_labels, records));
+  EXPECT_EQ(3u, records.size());
+
+  removeDumpFiles(pathPrefix());
+}
+
+TEST(FlightRecorderTest, ConcurrentDumpWrite)
+{
+  const unsigned int size = 21;
+  const unsigned int n = 200000;
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.open(labels(size), 64, pathPrefix()));
+
+  std::thread writer_thread([&recorder, n]()
+  {
+    for (unsigned int k = 0; k < n; ++k) {write(recorder, k, k);}
+  });
+
+  // Dumped records are never torn, and have consecutive indices
+  bool ok = true;
+  for (unsigned int dump = 0; dump < 20; ++dump)
+  {
+    std::string path;
+    std::vector<std::string> read_labels;
+    std::vector<TelemetryRecord> records;
+    ASSERT_TRUE(recorder.dump("test", path));
+    ASSERT_TRUE(readFlightRecord(path, read_labels, records));
+    std::remove(path.c_str());
+    for (std::size_t k = 0; k < records.size(); ++k)
+    {
+      const TelemetryRecord& record = records[k];
+      ok = ok && record.index == records.front().index + k && record.stamp == record.index;
+      for (unsigned int i = 0; i < size; ++i) {ok = ok && record.data[i] == record.index + i;}
+    }
+  }
+  writer_thread.join();
+  EXPECT_TRUE(ok);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
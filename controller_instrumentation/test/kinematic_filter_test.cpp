@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/kinematic_filter.h>
+
+using namespace controller_instrumentation;
+
+TEST(KinematicFilterTest, EmptyStateIsZero)
+{
+  KinematicFilter<double> filter(4);
+  EXPECT_EQ(4u, filter.windowSize());
+  EXPECT_EQ(0.0, filter.value());
+  EXPECT_EQ(0.0, filter.firstDerivative());
+  EXPECT_EQ(0.0, filter.secondDerivative());
+
+  // A zero window behaves as a window of one
+  filter.setWindowSize(0);
+  EXPECT_EQ(1u, filter.windowSize());
+}
+
+TEST(KinematicFilterTest, SeedsFirstDerivative)
+{
+  KinematicFilter<double> filter(10);
+  filter.update(1.0, 0.1);
+  EXPECT_DOUBLE_EQ(1.0, filter.value());
+  EXPECT_EQ(0.0, filter.firstDerivative());
+
+  filter.update(1.5, 0.1);
+  EXPECT_DOUBLE_EQ(1.5, filter.value());
+  EXPECT_DOUBLE_EQ(5.0, filter.firstDerivative());
+  EXPECT_EQ(0.0, filter.secondDerivative());
+
+  // A ramp is then tracked without error
+  for (int i = 2; i < 20; ++i)
+  {
+    filter.update(1.0 + 0.5 * i, 0.1);
+    EXPECT_NEAR(1.0 + 0.5 * i, filter.value(), 1e-9);
+    EXPECT_NEAR(5.0, filter.firstDerivative(), 1e-9);
+    EXPECT_NEAR(0.0, filter.secondDerivative(), 1e-9);
+  }
+}
+
+TEST(KinematicFilterTest, WindowOfOneFitsParabola)
+{
+  const double dt = 0.01;
+  KinematicFilter<double> filter(1);
+  for (int i = 0; i < 3; ++i)
+  {
+    const double t = i * dt;
+    filter.update(2.0 + 3.0 * t + 4.0 * t * t, dt);
+  }
+  const double t = 2 * dt;
+  EXPECT_NEAR(2.0 + 3.0 * t + 4.0 * t * t, filter.value(), 1e-9);
+  EXPECT_NEAR(3.0 + 8.0 * t, filter.firstDerivative(), 1e-6);
+  EXPECT_NEAR(8.0, filter.secondDerivative(), 1e-6);
+}
+
+TEST(KinematicFilterTest, ConvergesOnParabola)
+{
+  const double dt = 0.01;
+  KinematicFilter<double> filter(10);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double t = i * dt;
+    filter.update(-1.0 + 0.5 * t - 1.5 * t * t, dt);
+  }
+  const double t = 999 * dt;
+  EXPECT_NEAR(-1.0 + 0.5 * t - 1.5 * t * t, filter.value(), 1e-6);
+  EXPECT_NEAR(0.5 - 3.0 * t, filter.firstDerivative(), 1e-6);
+  EXPECT_NEAR(-3.0, filter.secondDerivative(), 1e-6);
+}
+
+TEST(KinematicFilterTest, SmoothsNoise)
+{
+  // Alternating noise on a constant signal is attenuated more with a longer window
+  const double dt = 0.01;
+  KinematicFilter<double> short_filter(2);
+  KinematicFilter<double> long_filter(20);
+  double short_max = 0.0, long_max = 0.0;
+  for (int i = 0; i < 500; ++i)
+  {
+    const double sample = (i % 2) ? 0.01 : -0.01;
+    short_filter.update(sample, dt);
+    long_filter.update(sample, dt);
+    if (i > 200)
+    {
+      short_max = std::max(short_max, std::fabs(short_filter.firstDerivative()));
+      long_max  = std::max(long_max,  std::fabs(long_filter.firstDerivative()));
+    }
+  }
+  EXPECT_LT(long_max, short_max);
+  EXPECT_LT(long_max, 0.1 * 2.0 * 0.01 / dt); // Raw finite difference amplitude is 2
+}
+
+TEST(KinematicFilterTest, ResetKeepsWindowSize)
+{
+  KinematicFilter<double> filter(5);
+  filter.update(1.0, 0.1);
+  filter.update(2.0, 0.1);
+  filter.update(4.0, 0.1);
+  filter.reset();
+  EXPECT_EQ(5u, filter.windowSize());
+  EXPECT_EQ(0.0, filter.value());
+  EXPECT_EQ(0.0, filter.firstDerivative());
+  EXPECT_EQ(0.0, filter.secondDerivative());
+
+  filter.update(3.0, 0.1);
+  EXPECT_DOUBLE_EQ(3.0, filter.value());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
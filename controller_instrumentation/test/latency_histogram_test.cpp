@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/latency_histogram.h>
+
+using namespace controller_instrumentation;
+
+TEST(LatencyHistogramTest, BucketBoundaries)
+{
+  // Small values are stored exactly
+  for (std::uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value)
+  {
+    EXPECT_EQ(value, LatencyHistogram::bucketIndex(value));
+    EXPECT_EQ(value, LatencyHistogram::bucketLowerBound(value));
+    EXPECT_EQ(value, LatencyHistogram::bucketUpperBound(value));
+  }
+
+  // Buckets are contiguous and partition the value range
+  for (std::size_t i = 0; i + 1 < LatencyHistogram::BUCKETS; ++i)
+  {
+    const std::uint64_t lower = LatencyHistogram::bucketLowerBound(i);
+    const std::uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+    EXPECT_LE(lower, upper);
+    EXPECT_EQ(upper + 1, LatencyHistogram::bucketLowerBound(i + 1));
+    EXPECT_EQ(i, LatencyHistogram::bucketIndex(lower));
+    EXPECT_EQ(i, LatencyHistogram::bucketIndex(upper));
+  }
+
+  const std::uint64_t max_value = std::numeric_limits<std::uint64_t>::max();
+  EXPECT_EQ(LatencyHistogram::BUCKETS - 1, LatencyHistogram::bucketIndex(max_value));
+  EXPECT_EQ(max_value, LatencyHistogram::bucketUpperBound(LatencyHistogram::BUCKETS - 1));
+}
+
+TEST(LatencyHistogramTest, BoundedRelativeError)
+{
+  for (std::uint64_t value = LatencyHistogram::SUB_BUCKETS; value < 10000000; value = value * 3 / 2)
+  {
+    const std::size_t index = LatencyHistogram::bucketIndex(value);
+    const double width = LatencyHistogram::bucketUpperBound(index) - LatencyHistogram::bucketLowerBound(index);
+    EXPECT_LE(width / value, 1.0 / LatencyHistogram::SUB_BUCKETS);
+  }
+}
+
+TEST(LatencyHistogramTest, EmptySnapshot)
+{
+  LatencyHistogram histogram;
+  const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(0u, snapshot.count());
+  EXPECT_EQ(0u, snapshot.sum());
+  EXPECT_EQ(0u, snapshot.max());
+  EXPECT_EQ(0u, snapshot.percentile(0.5));
+  EXPECT_EQ(0u, histogram.exchangeWindowMax());
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+  LatencyHistogram histogram;
+  for (std::uint64_t value = 1; value <= 1000; ++value) {histogram.record(value * 1000);}
+
+  const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(1000u, snapshot.count());
+  EXPECT_EQ(500500000u, snapshot.sum());
+  EXPECT_EQ(1000000u, snapshot.max());
+
+  const double tolerance = 1.0 / LatencyHistogram::SUB_BUCKETS;
+  EXPECT_NEAR(500000.0, snapshot.percentile(0.5),   500000.0 * tolerance);
+  EXPECT_NEAR(990000.0, snapshot.percentile(0.99),  990000.0 * tolerance);
+  EXPECT_NEAR(999000.0, snapshot.percentile(0.999), 999000.0 * tolerance);
+  EXPECT_EQ(1000000u, snapshot.percentile(1.0));
+  EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(1000)), snapshot.percentile(0.0));
+
+  // Percentiles never exceed the largest sample
+  EXPECT_LE(snapshot.percentile(0.9999), snapshot.max());
+}
+
+TEST(LatencyHistogramTest, Window)
+{
+  LatencyHistogram histogram;
+  for (unsigned int i = 0; i < 100; ++i) {histogram.record(5000);}
+  histogram.record(100000);
+  const LatencyHistogram::Snapshot first = histogram.snapshot();
+  EXPECT_EQ(100000u, histogram.exchangeWindowMax());
+
+  for (unsigned int i = 0; i < 10; ++i) {histogram.record(200);}
+  const LatencyHistogram::Snapshot window = histogram.snapshot().since(first, histogram.exchangeWindowMax());
+  EXPECT_EQ(10u, window.count());
+  EXPECT_EQ(2000u, window.sum());
+  EXPECT_EQ(200u, window.max());
+  EXPECT_NEAR(200.0, window.percentile(0.99), 200.0 / LatencyHistogram::SUB_BUCKETS);
+
+  // Overall maximum is kept
+  EXPECT_EQ(100000u, histogram.snapshot().max());
+  EXPECT_EQ(0u, histogram.exchangeWindowMax());
+}
+
+TEST(LatencyHistogramTest, ConcurrentSnapshots)
+{
+  LatencyHistogram histogram;
+  const std::uint64_t samples = 1000000;
+
+  std::thread writer([&histogram, samples]()
+  {
+    for (std::uint64_t i = 0; i < samples; ++i) {histogram.record(i % 4096);}
+  });
+
+  // Snapshot counts are monotonic while samples are being recorded
+  std::uint64_t last_count = 0;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    const std::uint64_t count = histogram.snapshot().count();
+    EXPECT_GE(count, last_count);
+    last_count = count;
+  }
+  writer.join();
+
+  EXPECT_EQ(samples, histogram.snapshot().count());
+  EXPECT_EQ(4095u, histogram.snapshot().max());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
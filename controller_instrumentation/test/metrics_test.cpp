@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/metrics.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+bool contains(const std::string& text, const std::string& line)
+{
+  return text.find(line + "\n") != std::string::npos;
+}
+
+std::size_t occurrences(const std::string& text, const std::string& substring)
+{
+  std::size_t count = 0;
+  for (std::size_t pos = text.find(substring); pos != std::string::npos; pos = text.find(substring, pos + 1)) {++count;}
+  return count;
+}
+
+std::string httpGet(unsigned short port, const std::string& path)
+{
+  const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address = {};
+  address.sin_family      = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port        = htons(port);
+  std::string response;
+  if (::connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+  {
+    const std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ::send(client, request.data(), request.size(), MSG_NOSIGNAL);
+    char buffer[1024];
+    ssize_t received;
+    while ((received = ::recv(client, buffer, sizeof(buffer), 0)) > 0) {response.append(buffer, received);}
+  }
+  ::close(client);
+  return response;
+}
+} // namespace
+
+TEST(MetricsTest, Counter)
+{
+  Counter counter;
+  counter.init("test_events_total", "Test events.", "my_controller");
+  counter.increment();
+  counter.increment(2);
+  EXPECT_EQ(3u, counter.value());
+
+  const std::string text = MetricsRegistry::instance().text();
+  EXPECT_TRUE(contains(text, "# HELP test_events_total Test events."));
+  EXPECT_TRUE(contains(text, "# TYPE test_events_total counter"));
+  EXPECT_TRUE(contains(text, "test_events_total{controller=\"my_controller\"} 3"));
+}
+
+TEST(MetricsTest, SharedName)
+{
+  // Metrics of the same name are grouped under a single header, whatever their registration order
+  Counter first, other, second;
+  first.init("test_shared_total", "Shared.", "first");
+  other.init("test_other_total", "Other.", "first");
+  second.init("test_shared_total", "Shared.", "second");
+  second.increment(5);
+
+  const std::string text = MetricsRegistry::instance().text();
+  EXPECT_EQ(1u, occurrences(text, "# TYPE test_shared_total counter"));
+  const std::size_t header = text.find("# TYPE test_shared_total");
+  const std::size_t first_sample  = text.find("test_shared_total{controller=\"first\"} 0\n");
+  const std::size_t second_sample = text.find("test_shared_total{controller=\"second\"} 5\n");
+  ASSERT_NE(std::string::npos, first_sample);
+  ASSERT_NE(std::string::npos, second_sample);
+  EXPECT_LT(header, first_sample);
+  EXPECT_LT(header, second_sample);
+  EXPECT_EQ(1u, occurrences(text, "# TYPE test_other_total counter"));
+}
+
+TEST(MetricsTest, Unregister)
+{
+  const std::size_t size = MetricsRegistry::instance().size();
+  {
+    Counter counter;
+    counter.init("test_scoped_total", "Scoped.", "my_controller");
+    EXPECT_EQ(size + 1, MetricsRegistry::instance().size());
+
+    // Registering again replaces the previous registration
+    counter.init("test_renamed_total", "Renamed.", "my_controller");
+    EXPECT_EQ(size + 1, MetricsRegistry::instance().size());
+    EXPECT_EQ(std::string::npos, MetricsRegistry::instance().text().find("test_scoped_total"));
+  }
+  EXPECT_EQ(size, MetricsRegistry::instance().size());
+  EXPECT_EQ(std::string::npos, MetricsRegistry::instance().text().find("test_renamed_total"));
+}
+
+TEST(MetricsTest, LatencySummary)
+{
+  LatencyHistogram histogram;
+  for (std::uint64_t value = 1; value <= 1000; ++value) {histogram.record(value >= 999 ? 4000000 : 1000);}
+
+  LatencySummary summary;
+  summary.init("test_latency_seconds", "Test latency.", "my_controller", histogram, 1e-9);
+
+  const std::string text = MetricsRegistry::instance().text();
+  EXPECT_TRUE(contains(text, "# TYPE test_latency_seconds summary"));
+  // Quantiles are the upper bound of their bucket, capped to the largest sample
+  EXPECT_TRUE(contains(text, "test_latency_seconds{controller=\"my_controller\",quantile=\"0.5\"} 1.023e-06"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds{controller=\"my_controller\",quantile=\"0.999\"} 0.004"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_sum{controller=\"my_controller\"} 0.008998"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_count{controller=\"my_controller\"} 1000"));
+}
+
+TEST(MetricsTest, LabelEscaping)
+{
+  EXPECT_EQ("a\\\\b\\\"c\\nd", MetricsRegistry::escapeLabel("a\\b\"c\nd"));
+}
+
+TEST(MetricsTest, TrylockFailures)
+{
+  struct BusyPublisher
+  {
+    bool trylock() {return false;}
+  } publisher;
+
+  const std::uint64_t failures = internal::publisherTrylockFailures().load();
+  EXPECT_FALSE(tracedTrylock(publisher, "busy"));
+  EXPECT_TRUE(contains(MetricsRegistry::instance().text(),
+                       "ros_controllers_publisher_trylock_failures_total " + std::to_string(failures + 1)));
+}
+
+TEST(MetricsTest, Exporter)
+{
+  Counter counter;
+  counter.init("test_exported_total", "Exported.", "my_controller");
+  counter.increment(7);
+
+  std::shared_ptr<MetricsExporter> exporter = MetricsExporter::get(0);
+  ASSERT_TRUE(exporter);
+  EXPECT_NE(0u, exporter->port());
+  EXPECT_EQ(exporter, MetricsExporter::get(0));
+
+  const std::string response = httpGet(exporter->port(), "/metrics");
+  EXPECT_EQ(0u, response.find("HTTP/1.0 200 OK\r\n"));
+  EXPECT_NE(std::string::npos, response.find("Content-Type: text/plain; version=0.0.4"));
+  EXPECT_NE(std::string::npos, response.find("\r\n\r\n# HELP"));
+  EXPECT_NE(std::string::npos, response.find("test_exported_total{controller=\"my_controller\"} 7\n"));
+
+  EXPECT_EQ(0u, httpGet(exporter->port(), "/other").find("HTTP/1.0 404 Not Found\r\n"));
+
+  // The exporter stops along with its last reference
+  const unsigned short port = exporter->port();
+  exporter.reset();
+  EXPECT_TRUE(httpGet(port, "/metrics").empty());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
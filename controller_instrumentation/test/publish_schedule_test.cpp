@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/publish_schedule.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+// Update cycles in which \p schedule publishes, out of \p cycles cycles of \p dt seconds starting at \p start
+std::vector<int> publishCycles(PublishSchedule& schedule, double start, double dt, int cycles)
+{
+  std::vector<int> published;
+  schedule.reset(ros::Time(start));
+  for (int i = 1; i <= cycles; ++i)
+  {
+    if (schedule.due(ros::Time(start + i * dt)))
+    {
+      schedule.advance();
+      published.push_back(i);
+    }
+  }
+  return published;
+}
+}
+
+TEST(PublishScheduleTest, PhasesAreSpread)
+{
+  // Every prefix of the sequence splits the period in intervals no larger than twice the smallest one
+  std::vector<double> phases;
+  for (unsigned i = 0; i < 12; ++i)
+  {
+    const double phase = PublishPhaseAllocator::next();
+    EXPECT_GE(phase, 0.0);
+    EXPECT_LT(phase, 1.0);
+    phases.push_back(phase);
+  }
+  std::sort(phases.begin(), phases.end());
+  double min_gap = 1.0 - phases.back() + phases.front();
+  double max_gap = min_gap;
+  for (unsigned i = 1; i < phases.size(); ++i)
+  {
+    min_gap = std::min(min_gap, phases[i] - phases[i - 1]);
+    max_gap = std::max(max_gap, phases[i] - phases[i - 1]);
+  }
+  EXPECT_GT(min_gap, 0.0);
+  EXPECT_LE(max_gap, 2.0 * min_gap + 1e-12);
+}
+
+TEST(PublishScheduleTest, DisabledNeverDue)
+{
+  PublishSchedule schedule;
+  schedule.init(0.0, true);
+  EXPECT_FALSE(schedule.enabled());
+  EXPECT_TRUE(publishCycles(schedule, 100.0, 0.001, 1000).empty());
+}
+
+TEST(PublishScheduleTest, UnstaggeredMatchesLastPublishTime)
+{
+  // Same cycles as the last_publish_time + Duration(1.0/publish_rate) < time pattern
+  PublishSchedule schedule;
+  schedule.init(100.0, false);
+  EXPECT_EQ(ros::Duration(0.01), schedule.period());
+
+  std::vector<int> expected;
+  ros::Time last_publish_time(100.0);
+  for (int i = 1; i <= 100; ++i)
+  {
+    if (last_publish_time + ros::Duration(0.01) < ros::Time(100.0 + i * 0.001))
+    {
+      last_publish_time += ros::Duration(0.01);
+      expected.push_back(i);
+    }
+  }
+  EXPECT_EQ(expected, publishCycles(schedule, 100.0, 0.001, 100));
+}
+
+TEST(PublishScheduleTest, StaggeredPublishersAreSpread)
+{
+  // Eight publishers at 100 Hz with a 1 kHz update loop, started at different times: at most two of them publish in
+  // the same cycle, instead of all of them
+  std::vector<int> publishers_per_cycle(10, 0);
+  for (unsigned i = 0; i < 8; ++i)
+  {
+    PublishSchedule schedule;
+    schedule.init(100.0, true);
+    const std::vector<int> published = publishCycles(schedule, 100.0 + 0.0137 * i, 0.001, 1000);
+    EXPECT_EQ(100u, published.size());
+    // cycle index relative to the absolute 1 kHz grid
+    const int offset = static_cast<int>(std::lround(0.0137 * i / 0.001));
+    ++publishers_per_cycle[(published.front() + offset) % 10];
+  }
+  EXPECT_LE(*std::max_element(publishers_per_cycle.begin(), publishers_per_cycle.end()), 2);
+}
+
+TEST(PublishScheduleTest, CatchesUpAfterMissedCycles)
+{
+  PublishSchedule schedule;
+  schedule.init(100.0, false);
+  schedule.reset(ros::Time(10.0));
+
+  // publisher busy until 10.05
+  EXPECT_TRUE(schedule.due(ros::Time(10.051)));
+  unsigned published = 0;
+  for (int i = 51; i < 60; ++i)
+  {
+    if (schedule.due(ros::Time(10.0 + i * 0.001)))
+    {
+      schedule.advance();
+      ++published;
+    }
+  }
+  EXPECT_EQ(5u, published);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/publisher_pool.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+class CountingTopic : public PublisherPool::Topic
+{
+public:
+  CountingTopic() : pending(false), published(0) {}
+
+  void publishPending() override
+  {
+    if (pending.exchange(false)) {++published;}
+  }
+
+  std::atomic<bool> pending;
+  std::atomic<unsigned> published;
+};
+
+bool waitFor(const std::atomic<unsigned>& count, unsigned value)
+{
+  for (unsigned i = 0; i < 1000 && count.load() != value; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return count.load() == value;
+}
+}
+
+TEST(PublisherPoolTest, SharedAcrossUsers)
+{
+  std::shared_ptr<PublisherPool> pool = PublisherPool::get();
+  EXPECT_EQ(pool, PublisherPool::get());
+  EXPECT_EQ(0u, pool->size());
+}
+
+TEST(PublisherPoolTest, PublishesPendingMessages)
+{
+  std::shared_ptr<PublisherPool> pool = PublisherPool::get();
+  CountingTopic first, second;
+  pool->add(&first, 100.0);
+  pool->add(&second, 0.0);
+  EXPECT_EQ(2u, pool->size());
+
+  first.pending.store(true);
+  EXPECT_TRUE(waitFor(first.published, 1));
+  second.pending.store(true);
+  EXPECT_TRUE(waitFor(second.published, 1));
+  EXPECT_EQ(1u, first.published.load());
+
+  pool->remove(&first);
+  EXPECT_EQ(1u, pool->size());
+  first.pending.store(true);
+  second.pending.store(true);
+  EXPECT_TRUE(waitFor(second.published, 2));
+  EXPECT_TRUE(first.pending.load());
+
+  pool->remove(&second);
+}
+
+TEST(PublisherPoolTest, PollPeriodFollowsFastestTopic)
+{
+  std::shared_ptr<PublisherPool> pool = PublisherPool::get();
+  EXPECT_EQ(std::chrono::microseconds(10000), pool->pollPeriod());
+
+  CountingTopic slow, fast, very_fast;
+  pool->add(&slow, 10.0);
+  EXPECT_EQ(std::chrono::microseconds(10000), pool->pollPeriod());
+  pool->add(&fast, 100.0);
+  EXPECT_EQ(std::chrono::microseconds(2500), pool->pollPeriod());
+  pool->add(&very_fast, 1000.0);
+  EXPECT_EQ(std::chrono::microseconds(1000), pool->pollPeriod());
+
+  pool->remove(&very_fast);
+  EXPECT_EQ(std::chrono::microseconds(2500), pool->pollPeriod());
+  pool->remove(&fast);
+  pool->remove(&slow);
+  EXPECT_EQ(std::chrono::microseconds(10000), pool->pollPeriod());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/realtime_audit_counters.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+
+// Audits the operations performed by the calling thread during its lifetime
+struct ThreadAudit
+{
+  ThreadAudit() : state(controller_instrumentation_thread_audit_state()), start(state->counts) {state->active = true;}
+  ~ThreadAudit() {state->active = false;}
+
+  RealtimeAuditCounts counts() const {return state->counts - start;}
+
+  internal::ThreadAuditState* state;
+  RealtimeAuditCounts         start;
+};
+
+// Prevent the compiler from eliding allocations
+template <class T>
+void doNotOptimize(T& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace
+
+TEST(RealtimeAuditHooksTest, HooksLoaded)
+{
+  ASSERT_TRUE(controller_instrumentation_thread_audit_state != nullptr);
+  const internal::ThreadAuditState* state = controller_instrumentation_thread_audit_state();
+  ASSERT_TRUE(state != nullptr);
+  EXPECT_FALSE(state->active);
+}
+
+TEST(RealtimeAuditHooksTest, CountAllocations)
+{
+  RealtimeAuditCounts counts;
+  {
+    ThreadAudit audit;
+    void* ptr = std::malloc(16);
+    doNotOptimize(ptr);
+    ptr = std::realloc(ptr, 1024);
+    doNotOptimize(ptr);
+    std::free(ptr);
+    std::free(nullptr);
+
+    std::vector<double>* vec = new std::vector<double>(8);
+    doNotOptimize(vec);
+    delete vec;
+    counts = audit.counts();
+  }
+  EXPECT_EQ(4u, counts.allocations);
+  EXPECT_EQ(3u, counts.deallocations);
+  EXPECT_EQ(0u, counts.mutex_locks);
+}
+
+TEST(RealtimeAuditHooksTest, CountMutexLocks)
+{
+  std::mutex mutex;
+  RealtimeAuditCounts counts;
+  {
+    ThreadAudit audit;
+    mutex.lock();
+    mutex.unlock();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+    }
+    // Non-blocking attempts are not counted
+    if (mutex.try_lock()) {mutex.unlock();}
+    counts = audit.counts();
+  }
+  EXPECT_EQ(0u, counts.allocations);
+  EXPECT_EQ(2u, counts.mutex_locks);
+}
+
+TEST(RealtimeAuditHooksTest, InactiveThreadNotCounted)
+{
+  const internal::ThreadAuditState* state = controller_instrumentation_thread_audit_state();
+  const RealtimeAuditCounts start = state->counts;
+
+  void* ptr = std::malloc(16);
+  doNotOptimize(ptr);
+  std::free(ptr);
+
+  EXPECT_TRUE((state->counts - start).empty());
+}
+
+TEST(RealtimeAuditHooksTest, PerThreadCounts)
+{
+  ThreadAudit audit;
+
+  // Allocations of an unaudited thread do not count towards the audited one
+  std::thread worker([]()
+  {
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+      void* ptr = std::malloc(16);
+      doNotOptimize(ptr);
+      std::free(ptr);
+    }
+  });
+  const RealtimeAuditCounts before_join = audit.counts();
+  audit.state->active = false;
+  worker.join();
+  audit.state->active = true;
+
+  // Thread creation allocates in the audited thread, but the worker's loop is not counted
+  EXPECT_LT(before_join.allocations, 100u);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
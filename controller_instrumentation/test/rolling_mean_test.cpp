@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/rolling_mean.h>
+
+using namespace controller_instrumentation;
+
+TEST(RollingMeanTest, EmptyMeanIsZero)
+{
+  RollingMean<double> acc(4);
+  EXPECT_EQ(0u, acc.size());
+  EXPECT_EQ(4u, acc.windowSize());
+  EXPECT_EQ(0.0, acc.mean());
+}
+
+TEST(RollingMeanTest, PartialAndFullWindow)
+{
+  RollingMean<double> acc(3);
+  acc.push(1.0);
+  EXPECT_DOUBLE_EQ(1.0, acc.mean());
+  acc.push(2.0);
+  EXPECT_DOUBLE_EQ(1.5, acc.mean());
+  acc.push(3.0);
+  EXPECT_DOUBLE_EQ(2.0, acc.mean());
+  EXPECT_EQ(3u, acc.size());
+
+  // Oldest samples are evicted once the window is full
+  acc.push(10.0);
+  EXPECT_DOUBLE_EQ(5.0, acc.mean());
+  acc.push(20.0);
+  EXPECT_DOUBLE_EQ(11.0, acc.mean());
+  EXPECT_EQ(3u, acc.size());
+}
+
+TEST(RollingMeanTest, ResetKeepsWindowSize)
+{
+  RollingMean<double> acc(2);
+  acc.push(5.0);
+  acc.push(7.0);
+  acc.reset();
+  EXPECT_EQ(0u, acc.size());
+  EXPECT_EQ(2u, acc.windowSize());
+  EXPECT_EQ(0.0, acc.mean());
+
+  acc.push(3.0);
+  EXPECT_DOUBLE_EQ(3.0, acc.mean());
+}
+
+TEST(RollingMeanTest, Resize)
+{
+  RollingMean<double> acc(2);
+  acc.push(1.0);
+  acc.resize(4);
+  EXPECT_EQ(0u, acc.size());
+  EXPECT_EQ(4u, acc.windowSize());
+
+  for (int i = 1; i <= 6; ++i) {acc.push(i);}
+  EXPECT_DOUBLE_EQ(4.5, acc.mean()); // (3 + 4 + 5 + 6) / 4
+
+  // A zero window behaves as a window of one
+  acc.resize(0);
+  EXPECT_EQ(1u, acc.windowSize());
+  acc.push(8.0);
+  acc.push(9.0);
+  EXPECT_DOUBLE_EQ(9.0, acc.mean());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <controller_instrumentation/shared_command.h>
+
+using controller_instrumentation::SharedCommandSource;
+using controller_instrumentation::SharedCommandWriter;
+
+namespace
+{
+
+std::string commandName()
+{
+  return "/shared_command_test_" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(SharedCommandTest, OpenFailures)
+{
+  SharedCommandSource source;
+  EXPECT_FALSE(source.open("", 2, std::chrono::milliseconds(10)));
+  EXPECT_FALSE(source.open(commandName(), 0, std::chrono::milliseconds(10)));
+  EXPECT_FALSE(source.isOpen());
+
+  // Nonexistent command
+  SharedCommandWriter writer;
+  EXPECT_FALSE(writer.open(commandName(), 2));
+
+  // Size mismatch
+  ASSERT_TRUE(source.open(commandName(), 2, std::chrono::milliseconds(10)));
+  EXPECT_FALSE(writer.open(commandName(), 3));
+  EXPECT_TRUE(writer.open(commandName(), 2));
+
+  // Reading a closed source is a no-op
+  source.close();
+  double data[2];
+  EXPECT_EQ(SharedCommandSource::EMPTY, source.read(data));
+}
+
+TEST(SharedCommandTest, LatestCommand)
+{
+  SharedCommandSource source;
+  ASSERT_TRUE(source.open(commandName(), 3, std::chrono::milliseconds(100)));
+  SharedCommandWriter writer;
+  ASSERT_TRUE(writer.open(commandName(), 3));
+
+  double data[3] = {0.0, 0.0, 0.0};
+  EXPECT_EQ(SharedCommandSource::EMPTY, source.read(data));
+
+  const double first[3] = {1.0, 2.0, 3.0};
+  const double second[3] = {4.0, 5.0, 6.0};
+  writer.write(first);
+  writer.write(second);
+  EXPECT_EQ(SharedCommandSource::UPDATED, source.read(data));
+  EXPECT_EQ(std::vector<double>(second, second + 3), std::vector<double>(data, data + 3));
+
+  // The same command is not copied again
+  data[0] = 0.0;
+  EXPECT_EQ(SharedCommandSource::UNCHANGED, source.read(data));
+  EXPECT_EQ(0.0, data[0]);
+}
+
+TEST(SharedCommandTest, StaleCommand)
+{
+  typedef SharedCommandSource::Clock Clock;
+
+  SharedCommandSource source;
+  ASSERT_TRUE(source.open(commandName(), 1, std::chrono::milliseconds(100)));
+  SharedCommandWriter writer;
+  ASSERT_TRUE(writer.open(commandName(), 1));
+
+  const Clock::time_point now = Clock::now();
+  const double command = 1.0;
+  double data = 0.0;
+
+  // An old command is never applied
+  writer.write(&command, now - std::chrono::milliseconds(200));
+  EXPECT_EQ(SharedCommandSource::STALE, source.read(&data, now));
+  EXPECT_EQ(0.0, data);
+
+  // A fresh command is, until it gets old
+  writer.write(&command, now);
+  EXPECT_EQ(SharedCommandSource::UPDATED, source.read(&data, now));
+  EXPECT_EQ(1.0, data);
+  EXPECT_EQ(SharedCommandSource::UNCHANGED, source.read(&data, now + std::chrono::milliseconds(50)));
+  EXPECT_EQ(SharedCommandSource::STALE, source.read(&data, now + std::chrono::milliseconds(150)));
+
+  // Becoming stale is counted once, until a fresh command is applied again
+  EXPECT_EQ(1u, source.staleCount());
+  EXPECT_EQ(SharedCommandSource::STALE, source.read(&data, now + std::chrono::milliseconds(160)));
+  EXPECT_EQ(1u, source.staleCount());
+  writer.write(&command, now + std::chrono::milliseconds(160));
+  EXPECT_EQ(SharedCommandSource::UPDATED, source.read(&data, now + std::chrono::milliseconds(160)));
+  EXPECT_EQ(SharedCommandSource::STALE, source.read(&data, now + std::chrono::milliseconds(300)));
+  EXPECT_EQ(2u, source.staleCount());
+}
+
+TEST(SharedCommandTest, Permissions)
+{
+  struct stat info;
+  SharedCommandSource source;
+
+  // Only the owner may open the shared memory object by default
+  ASSERT_TRUE(source.open(commandName(), 1, std::chrono::milliseconds(100)));
+  int fd = ::shm_open(commandName().c_str(), O_RDONLY, 0);
+  ASSERT_LE(0, fd);
+  ASSERT_EQ(0, ::fstat(fd, &info));
+  ::close(fd);
+  EXPECT_EQ(0600u, info.st_mode & 0777u);
+
+  source.close();
+
+  // The configured mode also applies when replacing an existing object, e.g. left over by a crashed controller
+  fd = ::shm_open(commandName().c_str(), O_CREAT | O_RDWR, 0644);
+  ASSERT_LE(0, fd);
+  ::close(fd);
+  ASSERT_TRUE(source.open(commandName(), 1, std::chrono::milliseconds(100), 0640));
+  fd = ::shm_open(commandName().c_str(), O_RDONLY, 0);
+  ASSERT_LE(0, fd);
+  ASSERT_EQ(0, ::fstat(fd, &info));
+  ::close(fd);
+  EXPECT_EQ(0640u, info.st_mode & 0777u);
+}
+
+TEST(SharedCommandTest, ConcurrentWriter)
+{
+  const std::size_t SIZE = 64;
+  SharedCommandSource source;
+  ASSERT_TRUE(source.open(commandName(), SIZE, std::chrono::seconds(10)));
+  SharedCommandWriter writer;
+  ASSERT_TRUE(writer.open(commandName(), SIZE));
+
+  std::atomic<bool> done(false);
+  std::thread writer_thread([&]
+  {
+    std::vector<double> command(SIZE);
+    for (unsigned int i = 1; !done.load(); ++i)
+    {
+      command.assign(SIZE, i);
+      writer.write(command.data());
+    }
+  });
+
+  // The reader must never see a torn write
+  std::vector<double> data(SIZE);
+  unsigned int updated = 0;
+  unsigned int torn = 0;
+  const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+  while (std::chrono::steady_clock::now() < end)
+  {
+    if (source.read(data.data()) != SharedCommandSource::UPDATED) {continue;}
+    ++updated;
+    for (double value : data) {if (value != data[0]) {++torn; break;}}
+  }
+  done.store(true);
+  writer_thread.join();
+
+  EXPECT_GT(updated, 0u);
+  EXPECT_EQ(0u, torn);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/spsc_queue.h>
+
+using namespace controller_instrumentation;
+
+TEST(SpscQueueTest, PushPop)
+{
+  SpscQueue<int> queue(3);
+  EXPECT_EQ(3u, queue.capacity());
+
+  int value = -1;
+  EXPECT_FALSE(queue.pop(value));
+  EXPECT_EQ(-1, value);
+
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_TRUE(queue.push(3));
+  EXPECT_FALSE(queue.push(4)); // Full
+
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(queue.push(5)); // Wraps around
+
+  EXPECT_TRUE(queue.pop(value)); EXPECT_EQ(2, value);
+  EXPECT_TRUE(queue.pop(value)); EXPECT_EQ(3, value);
+  EXPECT_TRUE(queue.pop(value)); EXPECT_EQ(5, value);
+  EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(SpscQueueTest, Reset)
+{
+  SpscQueue<int> queue(2);
+  EXPECT_TRUE(queue.push(1));
+  queue.reset(4);
+  EXPECT_EQ(4u, queue.capacity());
+
+  int value = -1;
+  EXPECT_FALSE(queue.pop(value));
+
+  // A queue without capacity rejects all elements
+  queue.reset(0);
+  EXPECT_FALSE(queue.push(1));
+  EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(SpscQueueTest, PushInPlace)
+{
+  SpscQueue<std::vector<double> > queue;
+  queue.reset(2, std::vector<double>(3, 0.0));
+
+  // Slots hold the prototype storage, and are only popped once committed
+  std::vector<double>* slot = queue.beginPush();
+  ASSERT_NE(nullptr, slot);
+  ASSERT_EQ(3u, slot->size());
+  const double* const storage = slot->data();
+  (*slot)[0] = 1.0;
+
+  std::vector<double> value;
+  EXPECT_FALSE(queue.pop(value));
+  queue.commitPush();
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(std::vector<double>({1.0, 0.0, 0.0}), value);
+
+  // Wrapping around reuses the storage of the popped slots
+  ASSERT_NE(nullptr, queue.beginPush());
+  queue.commitPush();
+  slot = queue.beginPush();
+  ASSERT_NE(nullptr, slot);
+  EXPECT_EQ(storage, slot->data());
+  queue.commitPush();
+  EXPECT_EQ(nullptr, queue.beginPush()); // Full
+}
+
+TEST(SpscQueueTest, ConcurrentProducerConsumer)
+{
+  const std::size_t count = 100000;
+  SpscQueue<std::size_t> queue(16);
+
+  std::thread producer([&queue, count]()
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      while (!queue.push(i)) {std::this_thread::yield();}
+    }
+  });
+
+  // Elements are received in order, without loss or duplication
+  std::size_t expected = 0;
+  while (expected < count)
+  {
+    std::size_t value;
+    if (queue.pop(value))
+    {
+      ASSERT_EQ(expected, value);
+      ++expected;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
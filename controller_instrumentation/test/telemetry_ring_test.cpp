@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <controller_instrumentation/telemetry_ring.h>
+
+using controller_instrumentation::TelemetryRecord;
+using controller_instrumentation::TelemetryRingReader;
+using controller_instrumentation::TelemetryRingWriter;
+
+namespace
+{
+
+std::string ringName()
+{
+  return "/telemetry_ring_test_" + std::to_string(::getpid());
+}
+
+std::vector<std::string> labels(unsigned int size)
+{
+  std::vector<std::string> result;
+  for (unsigned int i = 0; i < size; ++i) {result.push_back("channel" + std::to_string(i));}
+  return result;
+}
+
+void write(TelemetryRingWriter& writer, double stamp, double value)
+{
+  double* data = writer.beginWrite(stamp);
+  for (unsigned int i = 0; i < writer.recordSize(); ++i) {data[i] = value + i;}
+  writer.commit();
+}
+
+} // namespace
+
+TEST(TelemetryRingTest, OpenFailures)
+{
+  TelemetryRingWriter writer;
+  EXPECT_FALSE(writer.open("", labels(2), 8));
+  EXPECT_FALSE(writer.open(ringName(), labels(0), 8));
+  EXPECT_FALSE(writer.open(ringName(), labels(2), 0));
+  EXPECT_FALSE(writer.isOpen());
+
+  // Nonexistent ring
+  TelemetryRingReader reader;
+  EXPECT_FALSE(reader.open(ringName()));
+  EXPECT_FALSE(reader.isOpen());
+
+  // Writing to a closed ring is a no-op
+  EXPECT_EQ(nullptr, writer.beginWrite(0.0));
+  writer.commit();
+}
+
+TEST(TelemetryRingTest, ReadInOrder)
+{
+  const unsigned int size = 5;
+  TelemetryRingWriter writer;
+  ASSERT_TRUE(writer.open(ringName(), labels(size), 8));
+  EXPECT_EQ(size, writer.recordSize());
+
+  TelemetryRingReader reader;
+  ASSERT_TRUE(reader.open(ringName()));
+  EXPECT_EQ(labels(size), reader.labels());
+
+  TelemetryRecord record;
+  EXPECT_EQ(TelemetryRingReader::EMPTY, reader.read(record));
+
+  for (unsigned int k = 0; k < 5; ++k) {write(writer, k * 0.01, 10.0 * k);}
+
+  for (unsigned int k = 0; k < 5; ++k)
+  {
+    ASSERT_EQ(TelemetryRingReader::OK, reader.read(record));
+    EXPECT_EQ(k, record.index);
+    EXPECT_EQ(k * 0.01, record.stamp);
+    ASSERT_EQ(size, record.data.size());
+    for (unsigned int i = 0; i < size; ++i) {EXPECT_EQ(10.0 * k + i, record.data[i]);}
+  }
+  EXPECT_EQ(TelemetryRingReader::EMPTY, reader.read(record));
+}
+
+TEST(TelemetryRingTest, Overrun)
+{
+  const unsigned int capacity = 4;
+  TelemetryRingWriter writer;
+  ASSERT_TRUE(writer.open(ringName(), labels(1), capacity));
+  TelemetryRingReader reader;
+  ASSERT_TRUE(reader.open(ringName()));
+
+  for (unsigned int k = 0; k < 10; ++k) {write(writer, k, k);}
+
+  // The oldest records were overwritten: Reading resumes from the oldest available one
+  TelemetryRecord record;
+  EXPECT_EQ(TelemetryRingReader::OVERRUN, reader.read(record));
+  for (unsigned int k = 10 - capacity; k < 10; ++k)
+  {
+    ASSERT_EQ(TelemetryRingReader::OK, reader.read(record));
+    EXPECT_EQ(k, record.index);
+    EXPECT_EQ(k, record.data[0]);
+  }
+  EXPECT_EQ(TelemetryRingReader::EMPTY, reader.read(record));
+
+  // A reader opened late starts at the oldest available record
+  TelemetryRingReader late_reader;
+  ASSERT_TRUE(late_reader.open(ringName()));
+  ASSERT_EQ(TelemetryRingReader::OK, late_reader.read(record));
+  EXPECT_EQ(10 - capacity, record.index);
+}
+
+TEST(TelemetryRingTest, ConcurrentReadWrite)
+{
+  const unsigned int size = 21;
+  const unsigned int n = 20000;
+  TelemetryRingWriter writer;
+  ASSERT_TRUE(writer.open(ringName(), labels(size), 64));
+  TelemetryRingReader reader;
+  ASSERT_TRUE(reader.open(ringName()));
+
+  std::thread writer_thread([&writer, n]()
+  {
+    for (unsigned int k = 0; k < n; ++k) {write(writer, k, k);}
+  });
+
+  // Records read are never torn, and indices only increase
+  TelemetryRecord record;
+  bool ok = true;
+  std::uint64_t last_index = 0;
+  bool has_last = false;
+  while (ok && (!has_last || last_index + 1 < n))
+  {
+    if (reader.read(record) != TelemetryRingReader::OK) {continue;}
+    ok = ok && (!has_last || record.index > last_index) && record.stamp == record.index;
+    for (unsigned int i = 0; i < size; ++i) {ok = ok && record.data[i] == record.index + i;}
+    last_index = record.index;
+    has_last   = true;
+  }
+  writer_thread.join();
+  EXPECT_TRUE(ok);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
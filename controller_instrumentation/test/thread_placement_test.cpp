@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <linux/capability.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/thread_placement.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+
+cpu_set_t currentAffinity()
+{
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  sched_getaffinity(0, sizeof(cpus), &cpus);
+  return cpus;
+}
+
+int currentNice()
+{
+  return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+}
+
+/// Drop CAP_SYS_NICE and any RLIMIT_NICE headroom, as for a process run by an unprivileged user
+bool dropNicePrivileges()
+{
+  const rlimit no_headroom = {0, 0};
+  if (setrlimit(RLIMIT_NICE, &no_headroom) != 0) {return false;}
+
+  __user_cap_header_struct header;
+  header.version = _LINUX_CAPABILITY_VERSION_3;
+  header.pid = 0;
+  __user_cap_data_struct data[_LINUX_CAPABILITY_U32S_3];
+  if (syscall(SYS_capget, &header, data) != 0) {return false;}
+  data[CAP_TO_INDEX(CAP_SYS_NICE)].effective &= ~CAP_TO_MASK(CAP_SYS_NICE);
+  return syscall(SYS_capset, &header, data) == 0 && !ThreadPlacementScope::canLowerNice(currentNice());
+}
+
+/// Exit code of the unprivileged niceness test: 0 on success, the failed step otherwise
+int unprivilegedNiceScope()
+{
+  if (!dropNicePrivileges()) {return 1;}
+
+  const int before = currentNice();
+  if (before >= 19) {return 0;}
+
+  ThreadPlacement placement;
+  placement.setNice(before + 1);
+  {
+    ThreadPlacementScope scope(placement);
+  }
+  return currentNice() == before ? 0 : 2;
+}
+
+int firstCpu(const cpu_set_t& cpus)
+{
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &cpus)) {return cpu;}
+  }
+  return -1;
+}
+
+} // namespace
+
+TEST(ThreadPlacementTest, EmptyPlacement)
+{
+  ThreadPlacement placement;
+  EXPECT_TRUE(placement.empty());
+
+  const cpu_set_t before = currentAffinity();
+  {
+    ThreadPlacementScope scope(placement);
+    const cpu_set_t during = currentAffinity();
+    EXPECT_TRUE(CPU_EQUAL(&before, &during));
+  }
+}
+
+TEST(ThreadPlacementTest, AffinityInheritedAndRestored)
+{
+  const cpu_set_t before = currentAffinity();
+  const int cpu = firstCpu(before);
+  ASSERT_GE(cpu, 0);
+
+  ThreadPlacement placement;
+  placement.set(std::vector<int>(1, cpu));
+  EXPECT_FALSE(placement.empty());
+
+  cpu_set_t child_cpus;
+  CPU_ZERO(&child_cpus);
+  {
+    ThreadPlacementScope scope(placement);
+    const cpu_set_t during = currentAffinity();
+    EXPECT_EQ(1, CPU_COUNT(&during));
+    EXPECT_TRUE(CPU_ISSET(cpu, &during));
+
+    std::thread child([&child_cpus] {child_cpus = currentAffinity();});
+    child.join();
+  }
+  EXPECT_EQ(1, CPU_COUNT(&child_cpus));
+  EXPECT_TRUE(CPU_ISSET(cpu, &child_cpus));
+
+  const cpu_set_t after = currentAffinity();
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}
+
+TEST(ThreadPlacementTest, NiceInherited)
+{
+  // Raising the niceness is always permitted, lowering it back is not without privileges, see UnprivilegedNice
+  const int before = currentNice();
+  if (!ThreadPlacementScope::canLowerNice(before)) {return;}
+  const int nice = std::min(before + 1, 19);
+
+  ThreadPlacement placement;
+  placement.setNice(nice);
+
+  int child_nice = 0;
+  {
+    ThreadPlacementScope scope(placement);
+    EXPECT_EQ(nice, currentNice());
+
+    std::thread child([&child_nice] {child_nice = currentNice();});
+    child.join();
+  }
+  EXPECT_EQ(nice, child_nice);
+  EXPECT_EQ(before, currentNice());
+}
+
+TEST(ThreadPlacementTest, UnprivilegedNiceUnchanged)
+{
+  // The niceness could not be restored, so it must not be changed at all. Run in a child process, as dropping
+  // privileges is irreversible
+  EXPECT_EXIT(std::exit(unprivilegedNiceScope()), testing::ExitedWithCode(0), "");
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/tracepoints.h>
+
+using namespace controller_instrumentation;
+
+namespace
+{
+
+struct FakePublisher
+{
+  FakePublisher() : locked(false), trylock_calls(0) {}
+
+  bool trylock()
+  {
+    ++trylock_calls;
+    if (locked) {return false;}
+    locked = true;
+    return true;
+  }
+
+  bool locked;
+  int  trylock_calls;
+};
+
+} // namespace
+
+TEST(TracepointsTest, TracedTrylock)
+{
+  FakePublisher publisher;
+  EXPECT_TRUE(tracedTrylock(publisher, "state"));
+  EXPECT_TRUE(publisher.locked);
+
+  // Busy publisher
+  EXPECT_FALSE(tracedTrylock(publisher, "state"));
+  EXPECT_EQ(2, publisher.trylock_calls);
+}
+
+TEST(TracepointsTest, ArgumentsNotEvaluatedTwice)
+{
+  int evaluations = 0;
+  CONTROLLER_TRACEPOINT(begin);
+  CONTROLLER_TRACEPOINT2(values, ++evaluations, "controller");
+  EXPECT_LE(evaluations, 1);
+
+  {
+    UpdateTraceScope scope("controller");
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <controller_instrumentation/versioned_buffer.h>
+
+using namespace controller_instrumentation;
+
+TEST(VersionedBufferTest, UpdatesOnlyOnChange)
+{
+  VersionedBuffer<int> buffer;
+  EXPECT_FALSE(buffer.updateFromRT());
+
+  buffer.writeFromNonRT(1);
+  EXPECT_TRUE(buffer.updateFromRT());
+  EXPECT_EQ(1, buffer.readFromRT());
+  EXPECT_FALSE(buffer.updateFromRT());
+  EXPECT_EQ(1, buffer.readFromRT());
+
+  // Writing an equal value is still a change
+  buffer.writeFromNonRT(1);
+  EXPECT_TRUE(buffer.updateFromRT());
+
+  // Only the last of several writes is seen
+  buffer.writeFromNonRT(2);
+  buffer.writeFromNonRT(3);
+  EXPECT_TRUE(buffer.updateFromRT());
+  EXPECT_EQ(3, buffer.readFromRT());
+  EXPECT_FALSE(buffer.updateFromRT());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Replays the control cycle of a DiffDriveController on a simulated diffbot, with synthetic velocity commands and a
+// simulated clock, so that it runs headless with no ROS master. Odometry, limiter and publishing stages are measured
+// separately, then together as a full cycle.
+
+#include <algorithm>
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <diff_drive_controller/odometry.h>
+#include <diff_drive_controller/odometry_publisher.h>
+#include <diff_drive_controller/speed_limiter.h>
+#include <nav_msgs/Odometry.h>
+#include <tf2_msgs/TFMessage.h>
+
+using diff_drive_controller::Odometry;
+using diff_drive_controller::OdometrySample;
+using diff_drive_controller::SpeedLimiter;
+using diff_drive_controller::TwistLimiter;
+
+namespace
+{
+
+const double PERIOD = 0.01;
+const ros::Duration PUBLISH_PERIOD(0.02);
+
+/// Geometry of the diffbot test robot:
+const double WHEEL_SEPARATION = 0.6;
+const double WHEEL_RADIUS     = 0.11;
+
+/** Synthetic cmd_vel: square waves saturating the limits, switching every 0.64 s and 0.32 s. */
+double linearCommand(unsigned int i)  {return (i & 64) ? 2.0 : -2.0;}
+double angularCommand(unsigned int i) {return (i & 32) ? 3.0 : -3.0;}
+
+/** Diffbot with wheels tracking their velocity commands exactly. */
+struct SimulatedDiffBot
+{
+  SimulatedDiffBot() : left_pos(0.0), right_pos(0.0), left_vel(0.0), right_vel(0.0) {}
+
+  void step()
+  {
+    left_pos  += left_vel  * PERIOD;
+    right_pos += right_vel * PERIOD;
+  }
+
+  double left_pos;
+  double right_pos;
+  double left_vel;
+  double right_vel;
+};
+
+/** Control cycle of DiffDriveController::update(), split in stages, with publishers replaced by their messages. */
+class DiffDriveCycle
+{
+public:
+  DiffDriveCycle()
+    : time_(0.0),
+      last_publish_time_(0.0),
+      cycle_(0),
+      published_(0)
+  {
+    odometry_.setWheelParams(WHEEL_SEPARATION, WHEEL_RADIUS, WHEEL_RADIUS);
+    odometry_.init(time_);
+
+    limiter_.setAxisLimits(TwistLimiter::LINEAR_X,  SpeedLimiter(true, true, true, -1.0, 1.0, -0.5, 0.5, -2.0, 2.0));
+    limiter_.setAxisLimits(TwistLimiter::ANGULAR_Z, SpeedLimiter(true, true, true, -2.0, 2.0, -1.0, 1.0, -4.0, 4.0));
+    last0_cmd_.fill(0.0);
+    last1_cmd_.fill(0.0);
+
+    odom_.header.frame_id = "odom";
+    odom_.child_frame_id  = "base_link";
+    tf_odom_.transforms.resize(1);
+    tf_odom_.transforms[0].header.frame_id = "odom";
+    tf_odom_.transforms[0].child_frame_id  = "base_link";
+  }
+
+  /** Move the wheels as a turning motion, for stages measured without the command stage. */
+  void driveWheels()
+  {
+    robot_.left_vel  = 1.0 + 0.5 * ((cycle_ & 64) ? 1.0 : -1.0);
+    robot_.right_vel = 1.5;
+  }
+
+  void updateOdometry()
+  {
+    odometry_.update(robot_.left_pos, robot_.right_pos, time_);
+
+    sample_.stamp   = time_;
+    sample_.x       = odometry_.getX();
+    sample_.y       = odometry_.getY();
+    sample_.heading = odometry_.getHeading();
+    sample_.linear  = odometry_.getLinear();
+    sample_.angular = odometry_.getAngular();
+  }
+
+  /** Publish schedule and messages of the realtime publishers path. */
+  void publish()
+  {
+    if (!(last_publish_time_ + PUBLISH_PERIOD < sample_.stamp))
+    {
+      return;
+    }
+    last_publish_time_ += PUBLISH_PERIOD;
+
+    const geometry_msgs::Quaternion orientation(diff_drive_controller::quaternionFromYaw(sample_.heading));
+    diff_drive_controller::setOdometry(sample_, orientation, odom_);
+    tf_odom_.transforms[0].header.stamp = sample_.stamp;
+    diff_drive_controller::setOdometryTransform(sample_, orientation, tf_odom_.transforms[0].transform);
+    ++published_;
+  }
+
+  void updateCommand()
+  {
+    TwistLimiter::Twist cmd = {{linearCommand(cycle_), 0.0, angularCommand(cycle_)}};
+    limiter_.limit(cmd, last0_cmd_, last1_cmd_, PERIOD);
+    last1_cmd_ = last0_cmd_;
+    last0_cmd_ = cmd;
+
+    const double lin = cmd[TwistLimiter::LINEAR_X];
+    const double ang = cmd[TwistLimiter::ANGULAR_Z];
+    robot_.left_vel  = (lin - ang * WHEEL_SEPARATION / 2.0) / WHEEL_RADIUS;
+    robot_.right_vel = (lin + ang * WHEEL_SEPARATION / 2.0) / WHEEL_RADIUS;
+  }
+
+  /** Advance the simulated clock and robot by one period. */
+  void step()
+  {
+    time_ += ros::Duration(PERIOD);
+    robot_.step();
+    ++cycle_;
+  }
+
+  void cycle()
+  {
+    updateOdometry();
+    publish();
+    updateCommand();
+    step();
+  }
+
+  const OdometrySample& sample() const {return sample_;}
+  const nav_msgs::Odometry& odom() const {return odom_;}
+  double leftVelocity() const {return robot_.left_vel;}
+  unsigned int published() const {return published_;}
+
+private:
+  ros::Time time_;
+  ros::Time last_publish_time_;
+  unsigned int cycle_;
+  unsigned int published_;
+
+  SimulatedDiffBot robot_;
+  Odometry odometry_;
+  TwistLimiter limiter_;
+  TwistLimiter::Twist last0_cmd_;
+  TwistLimiter::Twist last1_cmd_;
+
+  OdometrySample sample_;
+  nav_msgs::Odometry odom_;
+  tf2_msgs::TFMessage tf_odom_;
+};
+
+} // namespace
+
+static void BM_DiffDriveOdometry(benchmark::State& state)
+{
+  DiffDriveCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.driveWheels();
+    cycle.updateOdometry();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.sample());
+}
+BENCHMARK(BM_DiffDriveOdometry);
+
+static void BM_DiffDriveLimiter(benchmark::State& state)
+{
+  DiffDriveCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.updateCommand();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.leftVelocity());
+}
+BENCHMARK(BM_DiffDriveLimiter);
+
+// Includes the odometry stage, which provides the published samples
+static void BM_DiffDrivePublish(benchmark::State& state)
+{
+  DiffDriveCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.driveWheels();
+    cycle.updateOdometry();
+    cycle.publish();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.odom());
+  state.counters["published"] = benchmark::Counter(cycle.published(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DiffDrivePublish);
+
+static void BM_DiffDriveCycle(benchmark::State& state)
+{
+  DiffDriveCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.cycle();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.odom());
+  benchmark::DoNotOptimize(cycle.leftVelocity());
+}
+BENCHMARK(BM_DiffDriveCycle);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Measures the cost of one odometry update from wheel positions and from commanded velocities.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <diff_drive_controller/odometry.h>
+
+using diff_drive_controller::Odometry;
+
+namespace
+{
+
+const double PERIOD = 0.01;
+
+/** Odometry of a 0.5 m wide base with 0.1 m wheels, initialized at time zero. */
+void initOdometry(Odometry& odom)
+{
+  odom.setWheelParams(0.5, 0.1, 0.1);
+  odom.init(ros::Time(0.0));
+}
+
+} // namespace
+
+static void BM_OdometryUpdate(benchmark::State& state)
+{
+  Odometry odom;
+  initOdometry(odom);
+
+  // Turning motion, so that the exact integrator does not fall back to Runge-Kutta
+  double left = 0.0, right = 0.0, t = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    left  += 0.01;
+    right += 0.02;
+    t     += PERIOD;
+    benchmark::DoNotOptimize(odom.update(left, right, ros::Time(t)));
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(odom.getHeading());
+}
+BENCHMARK(BM_OdometryUpdate);
+
+static void BM_OdometryUpdateZeroOrderHold(benchmark::State& state)
+{
+  Odometry odom;
+  initOdometry(odom);
+  odom.setIntegrationMethod(Odometry::ZERO_ORDER_HOLD);
+
+  double left = 0.0, right = 0.0, t = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    left  += 0.01;
+    right += 0.02;
+    t     += PERIOD;
+    benchmark::DoNotOptimize(odom.update(left, right, ros::Time(t)));
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(odom.getHeading());
+}
+BENCHMARK(BM_OdometryUpdateZeroOrderHold);
+
+static void BM_OdometryUpdateCovariance(benchmark::State& state)
+{
+  Odometry odom;
+  initOdometry(odom);
+  odom.setCovarianceParams(0.01, 0.01);
+
+  double left = 0.0, right = 0.0, t = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    left  += 0.01;
+    right += 0.02;
+    t     += PERIOD;
+    benchmark::DoNotOptimize(odom.update(left, right, ros::Time(t)));
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(odom.getPoseCovariance(1, 1));
+}
+BENCHMARK(BM_OdometryUpdateCovariance);
+
+static void BM_OdometryUpdateOpenLoop(benchmark::State& state)
+{
+  Odometry odom;
+  initOdometry(odom);
+
+  double t = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    t += PERIOD;
+    odom.updateOpenLoop(0.5, 0.2, ros::Time(t));
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(odom.getHeading());
+}
+BENCHMARK(BM_OdometryUpdateOpenLoop);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Compares limiting the linear and angular velocity commands of a diff drive with one SpeedLimiter per axis against a
+// TwistLimiter, with all limits enabled and commands saturating them.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <diff_drive_controller/speed_limiter.h>
+
+using diff_drive_controller::SpeedLimiter;
+using diff_drive_controller::TwistLimiter;
+
+namespace
+{
+
+const double PERIOD = 0.01;
+
+const SpeedLimiter LINEAR_LIMITS(true, true, true, -1.0, 1.0, -0.5, 0.5, -2.0, 2.0);
+const SpeedLimiter ANGULAR_LIMITS(true, true, true, -2.0, 2.0, -1.0, 1.0, -4.0, 4.0);
+
+/** Square wave commands exceeding the limits. */
+double linearCommand(unsigned int i)  {return (i & 64) ? 2.0 : -2.0;}
+double angularCommand(unsigned int i) {return (i & 32) ? 3.0 : -3.0;}
+
+} // namespace
+
+static void BM_SpeedLimiterPerAxis(benchmark::State& state)
+{
+  SpeedLimiter limiter_lin(LINEAR_LIMITS);
+  SpeedLimiter limiter_ang(ANGULAR_LIMITS);
+
+  double lin0 = 0.0, lin1 = 0.0, ang0 = 0.0, ang1 = 0.0;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    double lin = linearCommand(++i);
+    double ang = angularCommand(i);
+    limiter_lin.limit(lin, lin0, lin1, PERIOD);
+    limiter_ang.limit(ang, ang0, ang1, PERIOD);
+    lin1 = lin0; lin0 = lin;
+    ang1 = ang0; ang0 = ang;
+    benchmark::DoNotOptimize(lin);
+    benchmark::DoNotOptimize(ang);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_SpeedLimiterPerAxis);
+
+static void BM_TwistLimiter(benchmark::State& state)
+{
+  TwistLimiter limiter;
+  limiter.setAxisLimits(TwistLimiter::LINEAR_X, LINEAR_LIMITS);
+  limiter.setAxisLimits(TwistLimiter::ANGULAR_Z, ANGULAR_LIMITS);
+
+  TwistLimiter::Twist v0 = {{0.0, 0.0, 0.0}};
+  TwistLimiter::Twist v1 = v0;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    TwistLimiter::Twist v = {{linearCommand(++i), 0.0, angularCommand(i)}};
+    limiter.limit(v, v0, v1, PERIOD);
+    v1 = v0;
+    v0 = v;
+    benchmark::DoNotOptimize(v);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_TwistLimiter);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,132 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2013, PAL Robotics, S.L.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the PAL Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef BASE_ODOMETRY_PUBLISHER_H
+#define BASE_ODOMETRY_PUBLISHER_H
+
+#include <memory>
+#include <string>
+
+#include <diff_drive_controller/odometry_publisher.h>
+#include <diff_drive_controller/tf_batcher.h>
+#include <nav_msgs/Odometry.h>
+#include <realtime_tools/realtime_publisher.h>
+#include <ros/node_handle.h>
+#include <ros/time.h>
+#include <tf2_msgs/TFMessage.h>
+
+namespace diff_drive_controller
+{
+
+  /**
+   * \brief Publishes the odometry of a mobile base and its tf frame at the publish rate
+   *
+   * Shared by the mobile base controllers, whatever their kinematics: it builds the messages constant fields from the
+   * frames and the covariance params, keeps the publish schedule, and publishes either through realtime publishers
+   * from the control loop, or through an OdometryPublisher thread if the odom_publish_thread param is set.
+   * With the tf_batching param set, the realtime path publishes the odom frame through the TfBatcher shared by the
+   * controllers of the process, instead of a tf message of its own.
+   */
+  class BaseOdometryPublisher
+  {
+  public:
+    BaseOdometryPublisher();
+    ~BaseOdometryPublisher();
+
+    /**
+     * \brief Read the covariance and publisher thread params, and advertise the odometry and tf topics
+     * \param name          Controller name, used for logging
+     * \param root_nh       Node handle the tf topic is advertised in
+     * \param controller_nh Node handle the odometry topic is advertised in, and the params are read from
+     * \param odom_frame_id Frame of the odometry and odom tf
+     * \param base_frame_id Frame of the robot base
+     * \param publish_period Publish period
+     * \param publish_tf    Whether to publish the odometry frame to tf
+     * \note This method is \b not real-time safe
+     */
+    void init(const std::string& name, ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh,
+              const std::string& odom_frame_id, const std::string& base_frame_id,
+              const ros::Duration& publish_period, bool publish_tf);
+
+    /**
+     * \brief Restart the publish schedule, and activate the odom frame in the tf batcher
+     * \param time Current time
+     */
+    void starting(const ros::Time& time);
+
+    /**
+     * \brief Deactivate the odom frame in the tf batcher, so that the other controllers do not wait for it
+     */
+    void stopping();
+
+    /**
+     * \brief Publish the odometry \p sample if the publish period elapsed since the last publication
+     * \param sample Odometry estimate of the current control cycle
+     * \return True on the cycles the publish period elapsed, so that controllers can publish their own state along
+     * \note This method is realtime-safe
+     */
+    bool update(const OdometrySample& sample);
+
+    /**
+     * \brief Publish period setter
+     * \note This method is realtime-safe
+     */
+    void setPublishPeriod(const ros::Duration& publish_period);
+
+    /**
+     * \brief Whether to publish the odometry frame to tf
+     * \note This method is realtime-safe
+     */
+    void setPublishTf(bool publish_tf);
+
+  private:
+    /// Publish schedule:
+    ros::Duration publish_period_;
+    ros::Time last_publish_time_;
+    bool publish_tf_;
+
+    /// Odometry realtime publishers:
+    std::shared_ptr<realtime_tools::RealtimePublisher<nav_msgs::Odometry> > odom_pub_;
+    std::shared_ptr<realtime_tools::RealtimePublisher<tf2_msgs::TFMessage> > tf_odom_pub_;
+
+    /// Shared tf batcher and odom frame index, used instead of the tf realtime publisher above if enabled:
+    std::shared_ptr<TfBatcher> tf_batcher_;
+    std::size_t tf_frame_index_;
+
+    /// Odometry publisher thread, used instead of the realtime publishers above if enabled:
+    OdometryPublisher odom_publisher_;
+  };
+}
+
+#endif // BASE_ODOMETRY_PUBLISHER_H
@@ -0,0 +1,130 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <array>
+#include <cstddef>
+
+#include <ros/time.h>
+
+namespace diff_drive_controller
+{
+
+  /**
+   * \brief Velocity command to apply from a given time on
+   */
+  struct TimedCommand
+  {
+    double lin;
+    double ang;
+    ros::Time stamp;
+
+    TimedCommand() : lin(0.0), ang(0.0), stamp(0.0) {}
+    TimedCommand(double lin, double ang, const ros::Time& stamp) : lin(lin), ang(ang), stamp(stamp) {}
+  };
+
+  /**
+   * \brief Short queue of stamped velocity commands, each applied from its stamp on
+   *
+   * Commands are kept sorted by stamp, so late or reordered messages are applied at the right time. Past the newest
+   * command, its trend with respect to the previous one can be extrapolated for a limited time, so that a late message
+   * doesn't turn a ramp into a step. The queue has a fixed capacity and no dynamic memory, so it can be copied through a
+   * controller_instrumentation::CommandChannel.
+   */
+  class CommandQueue
+  {
+  public:
+    /// Maximum number of queued commands:
+    static const size_t MAX_CAPACITY = 32;
+
+    CommandQueue();
+
+    /**
+     * \brief Set the number of queued commands, clamped to [1, MAX_CAPACITY]. Drops the oldest commands if needed
+     * \param capacity Number of commands
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * \brief Set for how long the trend of the last two commands is extrapolated past the newest one
+     * \param extrapolation_time Extrapolation time [s], 0 to hold the newest command
+     */
+    void setExtrapolationTime(double extrapolation_time);
+
+    /**
+     * \brief Insert a command, dropping those that are superseded at \p now
+     * \param command Command to insert
+     * \param now     Current time
+     * \note This method is \b not real-time safe
+     */
+    void push(const TimedCommand& command, const ros::Time& now);
+
+    /**
+     * \brief Get the command to apply at \p time
+     * \param [in]  time    Current time
+     * \param [out] command Command to apply. Its stamp is the one of the queued command it comes from
+     * \return False if no queued command applies at \p time yet, in which case \p command is not written
+     * \note This method is realtime-safe
+     */
+    bool sample(const ros::Time& time, TimedCommand& command) const;
+
+    /// Maximum number of queued commands:
+    size_t capacity() const
+    {
+      return capacity_;
+    }
+
+    /// Number of queued commands:
+    size_t size() const
+    {
+      return size_;
+    }
+
+    /// Drop all commands:
+    void clear()
+    {
+      size_ = 0;
+    }
+
+  private:
+    std::array<TimedCommand, MAX_CAPACITY> commands_;
+    size_t size_;
+    size_t capacity_;
+    double extrapolation_time_;
+  };
+}
+
+#endif // COMMAND_QUEUE_H
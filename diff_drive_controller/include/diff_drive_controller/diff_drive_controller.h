@@ -36,20 +36,29 @@
  * Author: Bence Magyar, Enrique Fernández
  */
 
-#include <control_msgs/JointTrajectoryControllerState.h>
-#include <controller_interface/controller.h>
+#include <controller_instrumentation/command_channel_monitor.h>
+#include <controller_instrumentation/metrics.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/telemetry_ring.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_instrumentation/tracepoints.h>
+#include <controller_instrumentation/update_latency_monitor.h>
+#include <controller_instrumentation/versioned_buffer.h>
+#include <controller_interface/multi_interface_controller.h>
 #include <diff_drive_controller/DiffDriveControllerConfig.h>
+#include <diff_drive_controller/base_odometry_publisher.h>
+#include <diff_drive_controller/command_queue.h>
 #include <diff_drive_controller/odometry.h>
 #include <diff_drive_controller/speed_limiter.h>
+#include <diff_drive_controller/wheel_group.h>
+#include <diff_drive_controller/wheel_state_publisher.h>
 #include <dynamic_reconfigure/server.h>
 #include <geometry_msgs/TwistStamped.h>
+#include <hardware_interface/imu_sensor_interface.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <memory>
-#include <nav_msgs/Odometry.h>
 #include <pluginlib/class_list_macros.hpp>
-#include <realtime_tools/realtime_buffer.h>
 #include <realtime_tools/realtime_publisher.h>
-#include <tf/tfMessage.h>
 
 namespace diff_drive_controller{
 
@@ -61,20 +70,29 @@ namespace diff_drive_controller{
    *  - the wheels have the same parent frame
    *  - a wheel collision geometry is a cylinder or sphere in the urdf
    *  - a wheel joint frame center's vertical projection on the floor must lie within the contact patch
+   *
+   * Wheel velocity limits apply to the wheel joint commands, after the linear and angular twist limits:
+   *  - wheel/has_velocity_limits (default false)
+   *  - wheel/max_velocity [rad/s], default limit of both sides
+   *  - left_wheel/max_velocity, right_wheel/max_velocity [rad/s], default to wheel/max_velocity
+   * When a wheel would exceed its limit, both wheel commands and the twist are scaled by the same factor, so the
+   * commanded curvature is preserved.
    */
   class DiffDriveController
-      : public controller_interface::Controller<hardware_interface::VelocityJointInterface>
+      : public controller_interface::MultiInterfaceController<hardware_interface::VelocityJointInterface,
+                                                              hardware_interface::ImuSensorInterface>
   {
   public:
     DiffDriveController();
 
     /**
      * \brief Initialize controller
-     * \param hw            Velocity joint interface for the wheels
+     * \param robot_hw      Robot hardware, with a velocity joint interface for the wheels, and optionally an IMU
+     *                      sensor interface for the yaw rate fusion
      * \param root_nh       Node handle at root namespace
      * \param controller_nh Node handle inside the controller namespace
      */
-    bool init(hardware_interface::VelocityJointInterface* hw,
+    bool init(hardware_interface::RobotHW* robot_hw,
               ros::NodeHandle& root_nh,
               ros::NodeHandle &controller_nh);
 
@@ -100,25 +118,41 @@ namespace diff_drive_controller{
   private:
     std::string name_;
 
+    /// Audit of realtime-unsafe operations in update():
+    controller_instrumentation::RealtimeAudit rt_audit_;
+
+    /// Write statistics of the velocity command channels:
+    controller_instrumentation::CommandChannelMonitor command_monitor_;
+
+    /// Duration and jitter statistics of update():
+    controller_instrumentation::UpdateLatencyMonitor latency_monitor_;
+
+    /// Metrics of command timeouts and brakes:
+    controller_instrumentation::MetricsEndpoint metrics_endpoint_;
+    controller_instrumentation::Counter cmd_vel_timeouts_metric_;
+    controller_instrumentation::Counter brakes_metric_;
+
+    /// Wheel states and commands of every update cycle, if enabled:
+    controller_instrumentation::TelemetryRingWriter telemetry_ring_;
+
     /// Odometry related:
     ros::Duration publish_period_;
-    ros::Time last_state_publish_time_;
     bool open_loop_;
 
+    /// Whether to integrate as exact arcs, over the update period in open loop, rather than the update timestamps:
+    bool odom_zero_order_hold_;
+
+    /// Gyro whose yaw rate is fused into the odometry heading, if enabled:
+    bool fuse_imu_;
+    hardware_interface::ImuSensorHandle imu_;
+
     /// Hardware handles:
     std::vector<hardware_interface::JointHandle> left_wheel_joints_;
     std::vector<hardware_interface::JointHandle> right_wheel_joints_;
 
-    // Previous time
-    ros::Time time_previous_;
-
-    /// Previous velocities from the encoders:
-    std::vector<double> vel_left_previous_;
-    std::vector<double> vel_right_previous_;
-
-    /// Previous velocities from the encoders:
-    double vel_left_desired_previous_;
-    double vel_right_desired_previous_;
+    /// Left and right wheels, read and commanded as one wheel per side:
+    WheelGroup left_wheels_;
+    WheelGroup right_wheels_;
 
     /// Velocity command related:
     struct Commands
@@ -129,20 +163,27 @@ namespace diff_drive_controller{
 
       Commands() : lin(0.0), ang(0.0), stamp(0.0) {}
     };
-    realtime_tools::RealtimeBuffer<Commands> command_;
+    controller_instrumentation::CommandChannel<Commands> command_;
     Commands command_struct_;
     ros::Subscriber sub_command_;
 
+    /// Stamped velocity commands, applied at their stamp, if enabled:
+    bool cmd_vel_stamped_;
+    controller_instrumentation::CommandChannel<CommandQueue> command_queue_;
+    CommandQueue command_queue_struct_;
+
     /// Publish executed commands
     std::shared_ptr<realtime_tools::RealtimePublisher<geometry_msgs::TwistStamped> > cmd_vel_pub_;
 
     /// Odometry related:
-    std::shared_ptr<realtime_tools::RealtimePublisher<nav_msgs::Odometry> > odom_pub_;
-    std::shared_ptr<realtime_tools::RealtimePublisher<tf::tfMessage> > tf_odom_pub_;
     Odometry odometry_;
+    BaseOdometryPublisher odom_publisher_;
 
-    /// Controller state publisher
-    std::shared_ptr<realtime_tools::RealtimePublisher<control_msgs::JointTrajectoryControllerState> > controller_state_pub_;
+    /// Wheel joint controller state publisher, and desired wheel positions integrated every cycle, left wheels first:
+    WheelStatePublisher wheel_state_pub_;
+    std::vector<double> desired_wheel_positions_;
+    ros::Time last_wheel_state_publish_time_;
+    bool wheel_state_restart_;
 
     /// Wheel separation, wrt the midpoint of the wheel width:
     double wheel_separation_;
@@ -158,6 +199,9 @@ namespace diff_drive_controller{
     /// Timeout to consider cmd_vel commands old:
     double cmd_vel_timeout_;
 
+    /// Whether the last cmd_vel command timed out, so that each timeout is only counted once:
+    bool cmd_vel_timed_out_;
+
     /// Whether to allow multiple publishers on cmd_vel topic or not:
     bool allow_multiple_cmd_vel_publishers_;
 
@@ -173,11 +217,18 @@ namespace diff_drive_controller{
     /// Number of wheel joints:
     size_t wheel_joints_size_;
 
+    /// Whether to leave wheels with an invalid position out of odometry, instead of skipping the update:
+    bool drop_faulty_wheels_;
+
     /// Speed limiters:
     Commands last1_cmd_;
     Commands last0_cmd_;
-    SpeedLimiter limiter_lin_;
-    SpeedLimiter limiter_ang_;
+    TwistLimiter limiter_;
+
+    /// Wheel velocity limits [rad/s], saturating both wheels together to preserve curvature:
+    bool has_wheel_velocity_limits_;
+    double max_left_wheel_velocity_;
+    double max_right_wheel_velocity_;
 
     /// Publish limited velocity:
     bool publish_cmd_;
@@ -227,7 +278,8 @@ namespace diff_drive_controller{
       }
     };
 
-    realtime_tools::RealtimeBuffer<DynamicParams> dynamic_params_;
+    /// Dynamic parameters, only reapplied in the RT loop when dynamic reconfigure changes them:
+    controller_instrumentation::VersionedBuffer<DynamicParams> dynamic_params_;
 
     /// Dynamic Reconfigure server
     typedef dynamic_reconfigure::Server<DiffDriveControllerConfig> ReconfigureServer;
@@ -246,6 +298,18 @@ namespace diff_drive_controller{
      */
     void cmdVelCallback(const geometry_msgs::Twist& command);
 
+    /**
+     * \brief Stamped velocity command callback
+     * \param command Velocity command message (twist), applied from its stamp on, or right away if it is zero
+     */
+    void cmdVelStampedCallback(const geometry_msgs::TwistStamped& command);
+
+    /**
+     * \brief Check whether velocity commands can be accepted, braking if there are too many publishers
+     * \return False if commands must be ignored
+     */
+    bool acceptCommands();
+
     /**
      * \brief Get the wheel names from a wheel param
      * \param [in]  controller_nh Controller node handler
@@ -270,13 +334,6 @@ namespace diff_drive_controller{
                                bool lookup_wheel_separation,
                                bool lookup_wheel_radius);
 
-    /**
-     * \brief Sets the odometry publishing fields
-     * \param root_nh Root node handle
-     * \param controller_nh Node handle inside the controller namespace
-     */
-    void setOdomPubFields(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh);
-
     /**
      * \brief Callback for dynamic_reconfigure server
      * \param config The config set from dynamic_reconfigure server
@@ -287,11 +344,12 @@ namespace diff_drive_controller{
 
     /**
      * \brief Update the dynamic parameters in the RT loop
+     * \return True if the parameters changed since the last call
      */
-    void updateDynamicParams();
+    bool updateDynamicParams();
 
     /**
-     * \brief
+     * \brief Integrates the desired wheel positions, and queues the wheel states for publication once per publish period
      * \param time Current time
      * \param period Time since the last called to update
      * \param curr_cmd Current velocity command
@@ -305,6 +363,12 @@ namespace diff_drive_controller{
                           double wheel_separation,
                           double left_wheel_radius,
                           double right_wheel_radius);
+
+    /**
+     * \brief Writes the wheel states and commands to the telemetry ring, if enabled
+     * \param time Current time
+     */
+    void writeTelemetry(const ros::Time& time);
   };
 
   PLUGINLIB_EXPORT_CLASS(diff_drive_controller::DiffDriveController, controller_interface::ControllerBase);
@@ -42,16 +42,13 @@
 #ifndef ODOMETRY_H_
 #define ODOMETRY_H_
 
+#include <cstddef>
+
 #include <ros/time.h>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/rolling_mean.hpp>
-#include <boost/function.hpp>
+#include <controller_instrumentation/rolling_mean.h>
 
 namespace diff_drive_controller
 {
-  namespace bacc = boost::accumulators;
-
   /**
    * \brief The Odometry class handles odometry readings
    * (2D pose and velocity with related timestamp)
@@ -60,8 +57,13 @@ namespace diff_drive_controller
   {
   public:
 
-    /// Integration function, used to integrate the odometry:
-    typedef boost::function<void(double, double)> IntegrationFunction;
+    /// Method used to integrate the odometry:
+    enum IntegrationMethod
+    {
+      EXACT,
+      RUNGE_KUTTA_2,
+      ZERO_ORDER_HOLD
+    };
 
     /**
      * \brief Constructor
@@ -86,6 +88,18 @@ namespace diff_drive_controller
      */
     bool update(double left_pos, double right_pos, const ros::Time &time);
 
+    /**
+     * \brief Updates the odometry class with latest wheels position and a gyro yaw rate
+     * The heading follows the gyro at time scales shorter than the fusion time constant, and the wheel odometry
+     * heading at longer ones, so that wheel slip does not jump the heading while the gyro bias does not drift it.
+     * \param left_pos  Left  wheel position [rad]
+     * \param right_pos Right wheel position [rad]
+     * \param yaw_rate  Yaw rate of the base measured by a gyro [rad/s]
+     * \param time      Current time
+     * \return true if the odometry is actually updated
+     */
+    bool updateFused(double left_pos, double right_pos, double yaw_rate, const ros::Time &time);
+
     /**
      * \brief Updates the odometry class with latest velocity command
      * \param linear  Linear velocity [m/s]
@@ -94,6 +108,16 @@ namespace diff_drive_controller
      */
     void updateOpenLoop(double linear, double angular, const ros::Time &time);
 
+    /**
+     * \brief Updates the odometry class with latest velocity command, held over the controller update period
+     * Unlike the overload above, the integration interval does not depend on the jitter of the update times.
+     * \param linear  Linear velocity [m/s]
+     * \param angular Angular velocity [rad/s]
+     * \param time    Current time
+     * \param period  Time since the last controller update
+     */
+    void updateOpenLoop(double linear, double angular, const ros::Time &time, const ros::Duration &period);
+
     /**
      * \brief heading getter
      * \return heading [rad]
@@ -139,6 +163,26 @@ namespace diff_drive_controller
       return angular_;
     }
 
+    /**
+     * \brief Whether the pose covariance is propagated online
+     * \return true if enabled with setCovarianceParams
+     */
+    bool hasPoseCovariance() const
+    {
+      return propagate_covariance_;
+    }
+
+    /**
+     * \brief Pose covariance getter, zero until the first update
+     * \param row Row of the covariance, in order x, y and heading
+     * \param col Column of the covariance, in order x, y and heading
+     * \return Pose covariance entry, in [m^2], [m rad] or [rad^2]
+     */
+    double getPoseCovariance(std::size_t row, std::size_t col) const
+    {
+      return pose_covariance_[row][col];
+    }
+
     /**
      * \brief Sets the wheel parameters: radius and separation
      * \param wheel_separation   Separation between left and right wheels [m]
@@ -153,11 +197,56 @@ namespace diff_drive_controller
      */
     void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
 
+    /**
+     * \brief Integration method setter
+     * \param integration_method Method used to integrate the odometry, exact by default
+     */
+    void setIntegrationMethod(IntegrationMethod integration_method);
+
+    /**
+     * \brief Enables the online pose covariance propagation
+     * Each wheel displacement is assumed to have an independent error, whose variance is proportional to the
+     * displacement, and the pose covariance is propagated through the integration Jacobians every update.
+     * \param left_wheel_slip  Variance of the left  wheel displacement per travelled distance [m^2/m]
+     * \param right_wheel_slip Variance of the right wheel displacement per travelled distance [m^2/m]
+     */
+    void setCovarianceParams(double left_wheel_slip, double right_wheel_slip);
+
+    /**
+     * \brief Yaw rate fusion time constant setter
+     * \param time_constant Time constant of the complementary filter between the gyro and wheel headings [s], positive
+     */
+    void setYawRateFusionTimeConstant(double time_constant);
+
   private:
 
-    /// Rolling mean accumulator and window:
-    typedef bacc::accumulator_set<double, bacc::stats<bacc::tag::rolling_mean> > RollingMeanAcc;
-    typedef bacc::tag::rolling_window RollingWindow;
+    /// Rolling mean accumulator, preallocated to the velocity rolling window size:
+    typedef controller_instrumentation::RollingMean<double> RollingMeanAcc;
+
+    /**
+     * \brief Computes the displacements since the last wheels position, and stores it as the last one
+     * \param [in]  left_pos  Left  wheel position [rad]
+     * \param [in]  right_pos Right wheel position [rad]
+     * \param [out] linear    Linear  displacement   [m]
+     * \param [out] angular   Angular displacement [rad]
+     */
+    void wheelDisplacements(double left_pos, double right_pos, double& linear, double& angular);
+
+    /**
+     * \brief Updates the velocity estimates with the displacements since the last update
+     * \param linear  Linear  displacement   [m]
+     * \param angular Angular displacement [rad]
+     * \param time    Current time
+     * \return true if the interval since the last update is long enough to estimate the velocities
+     */
+    bool updateVelocity(double linear, double angular, const ros::Time &time);
+
+    /**
+     * \brief Integrates the velocities (linear and angular) with the configured integration method
+     * \param linear  Linear  velocity   [m] (linear  displacement, i.e. m/s * dt) computed by encoders
+     * \param angular Angular velocity [rad] (angular displacement, i.e. m/s * dt) computed by encoders
+     */
+    void integrate(double linear, double angular);
 
     /**
      * \brief Integrates the velocities (linear and angular) using 2nd order Runge-Kutta
@@ -173,6 +262,26 @@ namespace diff_drive_controller
      */
     void integrateExact(double linear, double angular);
 
+    /**
+     * \brief Integrates the velocities (linear and angular) as an exact arc, without a straight line fallback
+     * The arc is a chord along the mean heading, shortened by sin(angular / 2) / (angular / 2), whose series expansion
+     * near zero keeps it accurate at any angular velocity with the same constant cost.
+     * \param linear  Linear velocity   [m] (linear  displacement, i.e. m/s * dt) computed by encoders
+     * \param angular Angular velocity [rad] (angular displacement, i.e. m/s * dt) computed by encoders
+     */
+    void integrateZeroOrderHold(double linear, double angular);
+
+    /**
+     * \brief Propagates the pose covariance through one integration step
+     * \param linear  Linear  displacement   [m]
+     * \param angular Angular displacement [rad]
+     * \param jacobian_heading      Derivatives of x and y wrt the previous heading
+     * \param jacobian_displacement Derivatives of x (first row) and y (second row) wrt the linear and angular
+     *                              displacements; heading only depends on the angular one with a unit derivative
+     */
+    void propagateCovariance(double linear, double angular,
+                             const double (&jacobian_heading)[2], const double (&jacobian_displacement)[2][2]);
+
     /**
      *  \brief Reset linear and angular accumulators
      */
@@ -186,6 +295,10 @@ namespace diff_drive_controller
     double y_;        //   [m]
     double heading_;  // [rad]
 
+    /// Heading integrated from the wheels only, which the fused heading converges to, and its time constant [s]:
+    double wheel_heading_; // [rad]
+    double yaw_rate_fusion_time_constant_;
+
     /// Current velocity:
     double linear_;  //   [m/s]
     double angular_; // [rad/s]
@@ -204,8 +317,14 @@ namespace diff_drive_controller
     RollingMeanAcc linear_acc_;
     RollingMeanAcc angular_acc_;
 
-    /// Integration funcion, used to integrate the odometry:
-    IntegrationFunction integrate_fun_;
+    /// Integration method, dispatched with a switch so the integrator inlines into the updates:
+    IntegrationMethod integration_method_;
+
+    /// Online pose covariance, of x, y and heading, and variances of the wheel displacements per distance [m^2/m]:
+    bool propagate_covariance_;
+    double left_wheel_slip_;
+    double right_wheel_slip_;
+    double pose_covariance_[3][3];
   };
 }
 
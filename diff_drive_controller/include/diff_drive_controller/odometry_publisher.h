@@ -0,0 +1,220 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef ODOMETRY_PUBLISHER_H
+#define ODOMETRY_PUBLISHER_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+
+#include <controller_instrumentation/spsc_queue.h>
+#include <geometry_msgs/TransformStamped.h>
+#include <nav_msgs/Odometry.h>
+#include <ros/node_handle.h>
+#include <ros/time.h>
+#include <tf2_msgs/TFMessage.h>
+
+namespace diff_drive_controller
+{
+
+  /// Odometry estimate at a point in time:
+  struct OdometrySample
+  {
+    ros::Time stamp;
+    double x;        //   [m]
+    double y;        //   [m]
+    double heading;  // [rad]
+    double linear;   //   [m/s]
+    double linear_y; //   [m/s], zero for non-holonomic bases
+    double angular;  // [rad/s]
+
+    /// Covariance of x, y and heading, row-major, if propagated online instead of the static pose covariance:
+    bool has_pose_covariance;
+    double pose_covariance[9];
+
+    OdometrySample()
+      : stamp(0.0), x(0.0), y(0.0), heading(0.0), linear(0.0), linear_y(0.0), angular(0.0)
+      , has_pose_covariance(false), pose_covariance() {}
+  };
+
+  /**
+   * \brief Write the pose covariance of \p sample, if any, into the x, y and yaw entries of \p odom
+   * \note This method is realtime-safe
+   */
+  void setPoseCovariance(const OdometrySample& sample, nav_msgs::Odometry& odom);
+
+  /**
+   * \brief Write the stamp, pose, twist and pose covariance of \p sample into \p odom, leaving its constant fields
+   * \param orientation Orientation of \p sample, see quaternionFromYaw()
+   * \note This method is realtime-safe
+   */
+  void setOdometry(const OdometrySample& sample, const geometry_msgs::Quaternion& orientation,
+                   nav_msgs::Odometry& odom);
+
+  /**
+   * \brief Write the pose of \p sample into the odometry \p transform
+   * \param orientation Orientation of \p sample, see quaternionFromYaw()
+   * \note This method is realtime-safe
+   */
+  void setOdometryTransform(const OdometrySample& sample, const geometry_msgs::Quaternion& orientation,
+                            geometry_msgs::Transform& transform);
+
+  /**
+   * \brief Planar orientation quaternion, i.e. rotation of \p yaw around the z axis
+   * \note This method is realtime-safe
+   */
+  inline geometry_msgs::Quaternion quaternionFromYaw(double yaw)
+  {
+    geometry_msgs::Quaternion q;
+    q.x = 0.0;
+    q.y = 0.0;
+    q.z = std::sin(0.5 * yaw);
+    q.w = std::cos(0.5 * yaw);
+    return q;
+  }
+
+  /**
+   * \brief Publishes odometry and its tf frame from a dedicated non-realtime thread
+   *
+   * The control loop only pushes odometry samples into a lock-free queue, and the publisher thread builds and publishes
+   * the messages, so the control loop neither locks nor builds messages, and no sample is dropped because a publisher
+   * is busy.
+   *
+   * Without interpolation, every pushed sample is published as is. With interpolation, samples are expected every
+   * control cycle, and messages are published at exact multiples of the publish period, interpolating between the
+   * samples around each publish time. The publish schedule restarts at the newest sample when two consecutive samples
+   * are more than one publish period apart, e.g. when the controller is restarted.
+   */
+  class OdometryPublisher
+  {
+  public:
+    OdometryPublisher();
+    ~OdometryPublisher();
+
+    /**
+     * \brief Advertise the odometry and tf topics and start the publisher thread
+     * \param root_nh       Node handle the tf topic is advertised in
+     * \param controller_nh Node handle the odometry topic is advertised in
+     * \param odom          Odometry message with the constant fields (frames and covariances) set
+     * \param odom_frame    Odometry transform with the constant fields (frames) set
+     * \param publish_period Initial publish period, used for interpolation
+     * \param interpolate   Whether to interpolate samples to the publish times
+     * \param queue_size    Capacity of the sample queue
+     * \note This method is \b not real-time safe
+     */
+    void start(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh,
+               const nav_msgs::Odometry& odom, const geometry_msgs::TransformStamped& odom_frame,
+               const ros::Duration& publish_period, bool interpolate, std::size_t queue_size);
+
+    /**
+     * \brief Stop and join the publisher thread, dropping all samples not yet published
+     * \note This method is \b not real-time safe
+     */
+    void stop();
+
+    /**
+     * \return True if the publisher thread is running
+     */
+    bool isRunning() const
+    {
+      return thread_.joinable();
+    }
+
+    /**
+     * \return True if samples are interpolated to the publish times, so they should be pushed every control cycle
+     */
+    bool interpolates() const
+    {
+      return interpolate_;
+    }
+
+    /**
+     * \brief Queue a sample for publication. Samples must be pushed in time order, from a single thread
+     * \return False if the queue is full and the sample was dropped
+     * \note This method is realtime-safe
+     */
+    bool push(const OdometrySample& sample);
+
+    /**
+     * \brief Publish period setter, used for interpolation
+     * \note This method is realtime-safe
+     */
+    void setPublishPeriod(const ros::Duration& publish_period)
+    {
+      publish_period_.store(publish_period.toSec(), std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Whether to publish the odometry frame to tf
+     * \note This method is realtime-safe
+     */
+    void setPublishTf(bool publish_tf)
+    {
+      publish_tf_.store(publish_tf, std::memory_order_relaxed);
+    }
+
+  private:
+    /// Publisher thread main loop:
+    void run();
+
+    /// Publish the messages of one sample:
+    void publish(const OdometrySample& sample);
+
+    /// Queue of samples pushed by the control loop:
+    controller_instrumentation::SpscQueue<OdometrySample> queue_;
+    std::atomic<std::size_t> dropped_samples_;
+
+    std::atomic<double> publish_period_; // [s]
+    std::atomic<bool> publish_tf_;
+    bool interpolate_;
+
+    /// Publishers and messages, only accessed by the publisher thread once started:
+    ros::Publisher odom_pub_;
+    ros::Publisher tf_pub_;
+    nav_msgs::Odometry odom_;
+    tf2_msgs::TFMessage tf_odom_;
+
+    /// Interpolation state: last sample received, and time of the next publication:
+    bool has_last_sample_;
+    OdometrySample last_sample_;
+    ros::Time next_publish_time_;
+
+    std::atomic<bool> keep_running_;
+    std::thread thread_;
+  };
+}
+
+#endif // ODOMETRY_PUBLISHER_H
@@ -39,6 +39,8 @@
 #ifndef SPEED_LIMITER_H
 #define SPEED_LIMITER_H
 
+#include <array>
+
 namespace diff_drive_controller
 {
 
@@ -71,7 +73,10 @@ namespace diff_drive_controller
     );
 
     /**
-     * \brief Limit the velocity and acceleration
+     * \brief Limit the jerk, acceleration and velocity
+     *
+     * Each enabled limit clamps \p v to an interval, so this is equivalent to, and cheaper than, calling limit_jerk(),
+     * limit_acceleration() and limit_velocity() in sequence.
      * \param [in, out] v  Velocity [m/s]
      * \param [in]      v0 Previous velocity to v  [m/s]
      * \param [in]      v1 Previous velocity to v0 [m/s]
@@ -126,6 +131,53 @@ namespace diff_drive_controller
     double max_jerk;
   };
 
+  /**
+   * \brief Limits linear x, linear y and angular z velocities together
+   *
+   * Each axis is limited by its own SpeedLimiter limits. Wheel velocity limits depend on the kinematics, and are applied
+   * by the controllers to their wheel commands.
+   */
+  class TwistLimiter
+  {
+  public:
+    enum Axis
+    {
+      LINEAR_X = 0,
+      LINEAR_Y,
+      ANGULAR_Z,
+      AXES
+    };
+
+    /// Velocities along each axis [m/s, m/s, rad/s]:
+    typedef std::array<double, AXES> Twist;
+
+    TwistLimiter();
+
+    /**
+     * \brief Set the limits of one axis. Axes are unlimited by default
+     */
+    void setAxisLimits(Axis axis, const SpeedLimiter& limits);
+
+    /**
+     * \brief Limit the jerk, acceleration and velocity of each axis
+     * \param [in, out] v  Velocity
+     * \param [in]      v0 Previous velocity to v
+     * \param [in]      v1 Previous velocity to v0
+     * \param [in]      dt Time step [s]
+     */
+    void limit(Twist& v, const Twist& v0, const Twist& v1, double dt) const;
+
+  private:
+    // Limits of each axis, stored per limit rather than per axis so that limit() processes all axes at once.
+    // Disabled limits are infinite:
+    Twist min_velocity_;
+    Twist max_velocity_;
+    Twist min_acceleration_;
+    Twist max_acceleration_;
+    Twist min_jerk_;
+    Twist max_jerk_;
+  };
+
 } // namespace diff_drive_controller
 
 #endif // SPEED_LIMITER_H
@@ -0,0 +1,127 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef TF_BATCHER_H
+#define TF_BATCHER_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <geometry_msgs/TransformStamped.h>
+#include <realtime_tools/realtime_publisher.h>
+#include <ros/node_handle.h>
+#include <tf2_msgs/TFMessage.h>
+
+namespace diff_drive_controller
+{
+
+  /**
+   * \brief Coalesces the transforms of the controllers of a process into one tf message
+   *
+   * Controllers add their frame at initialization, activate it while they run, and set its transform from the control
+   * loop. The new transforms are published together once every active frame has one, or as soon as a frame gets a second one, e.g. when the
+   * other controllers are stopped or run at a lower rate. Controllers updated in the same cycle thus publish a single
+   * message, instead of one each.
+   *
+   * The control loop never blocks: a transform is dropped if another controller is setting one at the same time, and
+   * the transforms of a cycle are dropped if the previous message is still being published.
+   */
+  class TfBatcher
+  {
+  public:
+    /**
+     * \brief Shared batcher of the process, created on first use and destroyed with its last user
+     * \param root_nh Node handle the tf topic is advertised in, when the batcher is created
+     * \note This method is \b not real-time safe
+     */
+    static std::shared_ptr<TfBatcher> get(ros::NodeHandle& root_nh);
+
+    explicit TfBatcher(ros::NodeHandle& root_nh);
+
+    /**
+     * \brief Add an inactive frame to the batch
+     * \param frame Transform with the constant fields (frames) set
+     * \return Index of the frame, to activate it and set its transform
+     * \note This method is \b not real-time safe
+     */
+    std::size_t addFrame(const geometry_msgs::TransformStamped& frame);
+
+    /**
+     * \brief Activate a frame, so that batches wait for its transform, e.g. when its controller is started
+     * \param index Index of the frame
+     * \note This method is realtime-safe, but waits for a transform being set by another controller
+     */
+    void activateFrame(std::size_t index);
+
+    /**
+     * \brief Deactivate a frame, so that the others are not waited for it, e.g. when its controller is stopped
+     * \param index Index of the frame
+     * \note This method is realtime-safe, but waits for a transform being set by another controller
+     */
+    void deactivateFrame(std::size_t index);
+
+    /**
+     * \brief Set the transform of a frame, publishing the batch if complete
+     * \param index     Index of the frame
+     * \param stamp     Transform stamp
+     * \param transform Transform value
+     * \return False if the transform was dropped
+     * \note This method is realtime-safe
+     */
+    bool setTransform(std::size_t index, const ros::Time& stamp, const geometry_msgs::Transform& transform);
+
+  private:
+    struct Frame
+    {
+      geometry_msgs::TransformStamped transform;
+      bool active;
+      bool fresh;
+    };
+
+    /// Publish the fresh transforms, with the frames lock held:
+    void publish();
+
+    /// Frames and count of the active and fresh ones, guarded by the mutex:
+    std::mutex mutex_;
+    std::vector<Frame> frames_;
+    std::size_t active_count_;
+    std::size_t fresh_count_;
+
+    realtime_tools::RealtimePublisher<tf2_msgs::TFMessage> tf_pub_;
+  };
+}
+
+#endif // TF_BATCHER_H
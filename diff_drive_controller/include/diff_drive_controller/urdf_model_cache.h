@@ -0,0 +1,76 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef URDF_MODEL_CACHE_H
+#define URDF_MODEL_CACHE_H
+
+#include <cstddef>
+#include <string>
+
+#include <urdf/urdfdom_compatibility.h>
+
+namespace diff_drive_controller
+{
+
+  /**
+   * \brief Process-wide cache of parsed robot descriptions
+   *
+   * Controllers reading their kinematic parameters from the URDF parse the whole robot description in init(), which is
+   * slow for large descriptions and repeated on every controller reload. The cache keeps the models of the most
+   * recently used descriptions, looked up by a hash of the description and then compared in full, so a changed
+   * description is always parsed again.
+   */
+  class UrdfModelCache
+  {
+  public:
+    /// Number of cached models:
+    static const size_t CAPACITY = 4;
+
+    /**
+     * \brief Get the model of a robot description, parsing it only if it is not cached
+     * \param robot_description Robot description (URDF XML)
+     * \return Parsed model, or null if parsing failed. Failures are not cached
+     * \note This method is \b not real-time safe. It is thread-safe
+     */
+    static urdf::ModelInterfaceConstSharedPtr get(const std::string& robot_description);
+
+    /**
+     * \brief Drop all cached models
+     * \note This method is \b not real-time safe. It is thread-safe
+     */
+    static void clear();
+  };
+}
+
+#endif // URDF_MODEL_CACHE_H
@@ -0,0 +1,121 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef WHEEL_GROUP_H
+#define WHEEL_GROUP_H
+
+#include <cstddef>
+#include <vector>
+
+#include <hardware_interface/joint_command_interface.h>
+
+namespace diff_drive_controller
+{
+
+  /**
+   * \brief Wheels on one side of the robot, read and commanded as a single wheel
+   *
+   * The position and command pointers of the wheel handles are cached at initialization, and used directly as arrays
+   * when the hardware interface keeps them in contiguous buffers.
+   *
+   * The group position is the weighted average of the wheel positions. After the first reading it is advanced by the
+   * weighted average of the wheel position increments, so that wheels with an invalid (NaN) position can be left out of
+   * a reading without making the group position jump. A wheel is used again one reading after it becomes valid.
+   */
+  class WheelGroup
+  {
+  public:
+    WheelGroup();
+
+    /**
+     * \brief Cache the state and command pointers of \p wheel_joints
+     * \param wheel_joints Wheel handles
+     * \param weights      Weight of each wheel in the group position, or empty for equal weights
+     * \return False if \p weights does not match \p wheel_joints, or has negative values or no positive one
+     * \note This method is \b not real-time safe
+     */
+    bool init(std::vector<hardware_interface::JointHandle>& wheel_joints, const std::vector<double>& weights);
+
+    /**
+     * \brief Read the group position
+     * \param [out] position    Group position [rad], only written on success
+     * \param [in]  drop_faulty Whether to leave out wheels with an invalid position instead of failing
+     * \return False if a wheel position is invalid and \p drop_faulty is false, or if no wheel position is valid
+     * \note This method is realtime-safe
+     */
+    bool readPosition(double& position, bool drop_faulty);
+
+    /**
+     * \brief Set the same command on every wheel
+     * \note This method is realtime-safe
+     */
+    void setCommand(double command);
+
+    /**
+     * \return Number of wheels with an invalid position in the last reading
+     */
+    std::size_t getFaultyCount() const
+    {
+      return faulty_count_;
+    }
+
+    /**
+     * \return Number of wheels
+     */
+    std::size_t size() const
+    {
+      return commands_.size();
+    }
+
+  private:
+    /// Wheel positions and commands:
+    std::vector<const double*> positions_;
+    std::vector<double*> commands_;
+    bool contiguous_positions_;
+    bool contiguous_commands_;
+
+    /// Wheel weights:
+    std::vector<double> weights_;
+
+    /// Wheel positions of the current and previous readings, and group position:
+    std::vector<double> current_positions_;
+    std::vector<double> previous_positions_;
+    double position_;
+    bool has_position_;
+
+    std::size_t faulty_count_;
+  };
+}
+
+#endif // WHEEL_GROUP_H
@@ -0,0 +1,158 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef WHEEL_STATE_PUBLISHER_H
+#define WHEEL_STATE_PUBLISHER_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <control_msgs/JointTrajectoryControllerState.h>
+#include <controller_instrumentation/spsc_queue.h>
+#include <ros/node_handle.h>
+#include <ros/time.h>
+
+namespace diff_drive_controller
+{
+
+  /// Measured and desired states of all wheels at a point in time, left wheels first:
+  struct WheelStateSample
+  {
+    ros::Time stamp;
+    std::vector<double> position;
+    std::vector<double> velocity;
+    std::vector<double> effort;
+    std::vector<double> desired_position;
+    std::vector<double> desired_velocity;
+
+    /// Whether the sample starts a new sequence, e.g. after the controller is restarted:
+    bool restart;
+
+    WheelStateSample() : stamp(0.0), restart(true) {}
+
+    /// Sample with preallocated storage for \p size wheels:
+    explicit WheelStateSample(std::size_t size)
+      : stamp(0.0)
+      , position(size, 0.0), velocity(size, 0.0), effort(size, 0.0)
+      , desired_position(size, 0.0), desired_velocity(size, 0.0)
+      , restart(true) {}
+  };
+
+  /**
+   * \brief Fill the desired, actual and error states of \p msg from \p sample
+   *
+   * Accelerations are the velocity differences to \p previous over the time elapsed since it, so they are averaged over
+   * the publish period. They are zero when there is no previous sample. Desired efforts, unknown, are NaN.
+   * \param previous Previous sample, or null if \p sample is the first of its sequence
+   * \param msg      Message with all state arrays sized to the number of wheels
+   * \note This method is realtime-safe
+   */
+  void fillWheelState(const WheelStateSample* previous, const WheelStateSample& sample,
+                      control_msgs::JointTrajectoryControllerState& msg);
+
+  /**
+   * \brief Publishes the wheel joint controller state from a dedicated non-realtime thread
+   *
+   * The control loop only copies the measured and desired wheel states into a preallocated sample of a lock-free
+   * queue, once per publish period, and the publisher thread derives the accelerations and errors and publishes the
+   * message.
+   */
+  class WheelStatePublisher
+  {
+  public:
+    WheelStatePublisher();
+    ~WheelStatePublisher();
+
+    /**
+     * \brief Advertise the wheel_joint_controller_state topic and start the publisher thread
+     * \param controller_nh Node handle the topic is advertised in
+     * \param joint_names   Wheel joint names, left wheels first
+     * \param queue_size    Capacity of the sample queue
+     * \note This method is \b not real-time safe
+     */
+    void start(ros::NodeHandle& controller_nh, const std::vector<std::string>& joint_names, std::size_t queue_size);
+
+    /**
+     * \brief Stop and join the publisher thread, dropping all samples not yet published
+     * \note This method is \b not real-time safe
+     */
+    void stop();
+
+    /**
+     * \return True if the publisher thread is running
+     */
+    bool isRunning() const
+    {
+      return thread_.joinable();
+    }
+
+    /**
+     * \brief Start writing a sample in place, see controller_instrumentation::SpscQueue::beginPush()
+     * \return Sample to fill, with storage for every wheel, or null if the queue is full and the sample is dropped
+     * \note This method is realtime-safe
+     */
+    WheelStateSample* beginPush();
+
+    /**
+     * \brief Queue the sample returned by the last successful beginPush() for publication
+     * \note This method is realtime-safe
+     */
+    void commitPush()
+    {
+      queue_.commitPush();
+    }
+
+  private:
+    /// Publisher thread main loop:
+    void run();
+
+    /// Queue of samples pushed by the control loop:
+    controller_instrumentation::SpscQueue<WheelStateSample> queue_;
+    std::atomic<std::size_t> dropped_samples_;
+
+    /// Publisher, message and previous sample, only accessed by the publisher thread once started:
+    ros::Publisher pub_;
+    control_msgs::JointTrajectoryControllerState msg_;
+    WheelStateSample last_sample_;
+    bool has_last_sample_;
+
+    std::atomic<bool> keep_running_;
+    std::thread thread_;
+  };
+}
+
+#endif // WHEEL_STATE_PUBLISHER_H
@@ -0,0 +1,228 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2013, PAL Robotics, S.L.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the PAL Robotics nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <controller_instrumentation/tracepoints.h>
+#include <diff_drive_controller/base_odometry_publisher.h>
+
+namespace diff_drive_controller
+{
+
+  BaseOdometryPublisher::BaseOdometryPublisher()
+  : publish_period_(0.0)
+  , last_publish_time_(0.0)
+  , publish_tf_(true)
+  , tf_frame_index_(0)
+  {
+  }
+
+  BaseOdometryPublisher::~BaseOdometryPublisher()
+  {
+    if (tf_batcher_)
+    {
+      tf_batcher_->deactivateFrame(tf_frame_index_);
+    }
+  }
+
+  void BaseOdometryPublisher::init(const std::string& name, ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh,
+                                   const std::string& odom_frame_id, const std::string& base_frame_id,
+                                   const ros::Duration& publish_period, bool publish_tf)
+  {
+    publish_period_ = publish_period;
+    publish_tf_ = publish_tf;
+
+    // Get and check params for covariances
+    XmlRpc::XmlRpcValue pose_cov_list;
+    controller_nh.getParam("pose_covariance_diagonal", pose_cov_list);
+    ROS_ASSERT(pose_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
+    ROS_ASSERT(pose_cov_list.size() == 6);
+    for (int i = 0; i < pose_cov_list.size(); ++i)
+      ROS_ASSERT(pose_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
+
+    XmlRpc::XmlRpcValue twist_cov_list;
+    controller_nh.getParam("twist_covariance_diagonal", twist_cov_list);
+    ROS_ASSERT(twist_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
+    ROS_ASSERT(twist_cov_list.size() == 6);
+    for (int i = 0; i < twist_cov_list.size(); ++i)
+      ROS_ASSERT(twist_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
+
+    // Odometry message and transform constant fields
+    nav_msgs::Odometry odom;
+    odom.header.frame_id = odom_frame_id;
+    odom.child_frame_id = base_frame_id;
+    odom.pose.pose.position.z = 0;
+    odom.pose.covariance = {
+        static_cast<double>(pose_cov_list[0]), 0., 0., 0., 0., 0.,
+        0., static_cast<double>(pose_cov_list[1]), 0., 0., 0., 0.,
+        0., 0., static_cast<double>(pose_cov_list[2]), 0., 0., 0.,
+        0., 0., 0., static_cast<double>(pose_cov_list[3]), 0., 0.,
+        0., 0., 0., 0., static_cast<double>(pose_cov_list[4]), 0.,
+        0., 0., 0., 0., 0., static_cast<double>(pose_cov_list[5]) };
+    odom.twist.twist.linear.y  = 0;
+    odom.twist.twist.linear.z  = 0;
+    odom.twist.twist.angular.x = 0;
+    odom.twist.twist.angular.y = 0;
+    odom.twist.covariance = {
+        static_cast<double>(twist_cov_list[0]), 0., 0., 0., 0., 0.,
+        0., static_cast<double>(twist_cov_list[1]), 0., 0., 0., 0.,
+        0., 0., static_cast<double>(twist_cov_list[2]), 0., 0., 0.,
+        0., 0., 0., static_cast<double>(twist_cov_list[3]), 0., 0.,
+        0., 0., 0., 0., static_cast<double>(twist_cov_list[4]), 0.,
+        0., 0., 0., 0., 0., static_cast<double>(twist_cov_list[5]) };
+
+    geometry_msgs::TransformStamped odom_frame;
+    odom_frame.transform.translation.z = 0.0;
+    odom_frame.child_frame_id = base_frame_id;
+    odom_frame.header.frame_id = odom_frame_id;
+
+    // Publish from a dedicated thread, so that the control loop only queues odometry estimates
+    bool odom_publish_thread = false;
+    controller_nh.param("odom_publish_thread", odom_publish_thread, odom_publish_thread);
+    if (odom_publish_thread)
+    {
+      bool odom_publish_interpolation = false;
+      controller_nh.param("odom_publish_interpolation", odom_publish_interpolation, odom_publish_interpolation);
+      ROS_INFO_STREAM_NAMED(name, "Odometry will be published from a dedicated thread"
+                            << (odom_publish_interpolation ? ", interpolated to the publish times" : "") << ".");
+
+      // Holds well over one polling period of samples pushed every control cycle
+      const std::size_t odom_queue_size = 1024;
+      odom_publisher_.setPublishTf(publish_tf_);
+      odom_publisher_.start(root_nh, controller_nh, odom, odom_frame, publish_period_, odom_publish_interpolation,
+                            odom_queue_size);
+      return;
+    }
+
+    // Setup odometry realtime publishers
+    odom_pub_.reset(new realtime_tools::RealtimePublisher<nav_msgs::Odometry>(controller_nh, "odom", 100));
+    odom_pub_->msg_ = odom;
+
+    // Publish the odom frame along the other controllers ones, in a single tf message per control cycle
+    bool tf_batching = false;
+    controller_nh.param("tf_batching", tf_batching, tf_batching);
+    if (tf_batching)
+    {
+      ROS_INFO_STREAM_NAMED(name, "Odometry tf will be batched with the other controllers of the process.");
+      tf_batcher_ = TfBatcher::get(root_nh);
+      tf_frame_index_ = tf_batcher_->addFrame(odom_frame);
+      return;
+    }
+
+    tf_odom_pub_.reset(new realtime_tools::RealtimePublisher<tf2_msgs::TFMessage>(root_nh, "/tf", 100));
+    tf_odom_pub_->msg_.transforms.assign(1, odom_frame);
+  }
+
+  void BaseOdometryPublisher::starting(const ros::Time& time)
+  {
+    // Register starting time used to keep fixed rate
+    last_publish_time_ = time;
+
+    // Batches of the other controllers wait for the odom frame while running only
+    if (tf_batcher_)
+    {
+      tf_batcher_->activateFrame(tf_frame_index_);
+    }
+  }
+
+  void BaseOdometryPublisher::stopping()
+  {
+    if (tf_batcher_)
+    {
+      tf_batcher_->deactivateFrame(tf_frame_index_);
+    }
+  }
+
+  bool BaseOdometryPublisher::update(const OdometrySample& sample)
+  {
+    const bool publish = last_publish_time_ + publish_period_ < sample.stamp;
+    if (publish)
+    {
+      last_publish_time_ += publish_period_;
+    }
+
+    if (odom_publisher_.isRunning())
+    {
+      // Only queue the odometry estimate: messages are built and published by the odometry publisher thread
+      if (publish || odom_publisher_.interpolates())
+      {
+        odom_publisher_.push(sample);
+      }
+      return publish;
+    }
+
+    if (!publish)
+    {
+      return false;
+    }
+
+    // Compute and store orientation info
+    const geometry_msgs::Quaternion orientation(quaternionFromYaw(sample.heading));
+
+    // Populate odom message and publish
+    if (controller_instrumentation::tracedTrylock(*odom_pub_, "odom"))
+    {
+      setOdometry(sample, orientation, odom_pub_->msg_);
+      odom_pub_->unlockAndPublish();
+    }
+
+    // Publish tf /odom frame
+    if (publish_tf_ && tf_batcher_)
+    {
+      geometry_msgs::Transform transform;
+      transform.translation.z = 0.0;
+      setOdometryTransform(sample, orientation, transform);
+      tf_batcher_->setTransform(tf_frame_index_, sample.stamp, transform);
+    }
+    else if (publish_tf_ && controller_instrumentation::tracedTrylock(*tf_odom_pub_, "/tf"))
+    {
+      geometry_msgs::TransformStamped& odom_frame = tf_odom_pub_->msg_.transforms[0];
+      odom_frame.header.stamp = sample.stamp;
+      setOdometryTransform(sample, orientation, odom_frame.transform);
+      tf_odom_pub_->unlockAndPublish();
+    }
+    return true;
+  }
+
+  void BaseOdometryPublisher::setPublishPeriod(const ros::Duration& publish_period)
+  {
+    publish_period_ = publish_period;
+    odom_publisher_.setPublishPeriod(publish_period);
+  }
+
+  void BaseOdometryPublisher::setPublishTf(bool publish_tf)
+  {
+    publish_tf_ = publish_tf;
+    odom_publisher_.setPublishTf(publish_tf);
+  }
+
+} // namespace diff_drive_controller
@@ -0,0 +1,134 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+
+#include <diff_drive_controller/command_queue.h>
+
+namespace diff_drive_controller
+{
+
+  const size_t CommandQueue::MAX_CAPACITY;
+
+  CommandQueue::CommandQueue()
+    : size_(0)
+    , capacity_(MAX_CAPACITY)
+    , extrapolation_time_(0.0)
+  {
+  }
+
+  void CommandQueue::setCapacity(size_t capacity)
+  {
+    capacity_ = std::min(std::max(capacity, size_t(1)), MAX_CAPACITY);
+    if (size_ > capacity_)
+    {
+      std::copy(commands_.begin() + (size_ - capacity_), commands_.begin() + size_, commands_.begin());
+      size_ = capacity_;
+    }
+  }
+
+  void CommandQueue::setExtrapolationTime(double extrapolation_time)
+  {
+    extrapolation_time_ = std::max(extrapolation_time, 0.0);
+  }
+
+  void CommandQueue::push(const TimedCommand& command, const ros::Time& now)
+  {
+    // Drop the commands superseded by a newer one that already applies, but keep the one in effect:
+    size_t superseded = 0;
+    while (superseded + 1 < size_ && commands_[superseded + 1].stamp <= now)
+    {
+      ++superseded;
+    }
+
+    // Make room by dropping the oldest command:
+    if (size_ - superseded == capacity_)
+    {
+      ++superseded;
+    }
+
+    if (superseded > 0)
+    {
+      std::copy(commands_.begin() + superseded, commands_.begin() + size_, commands_.begin());
+      size_ -= superseded;
+    }
+
+    // Insert sorted by stamp; commands with the same stamp are kept in arrival order:
+    size_t i = size_;
+    while (i > 0 && command.stamp < commands_[i - 1].stamp)
+    {
+      commands_[i] = commands_[i - 1];
+      --i;
+    }
+    commands_[i] = command;
+    ++size_;
+  }
+
+  bool CommandQueue::sample(const ros::Time& time, TimedCommand& command) const
+  {
+    // Find the newest command that applies at time:
+    size_t i = size_;
+    while (i > 0 && time < commands_[i - 1].stamp)
+    {
+      --i;
+    }
+    if (i == 0)
+    {
+      return false;
+    }
+
+    const TimedCommand& curr = commands_[i - 1];
+    command = curr;
+
+    // Extrapolate past the newest command:
+    if (i == size_ && i > 1 && extrapolation_time_ > 0.0)
+    {
+      const TimedCommand& prev = commands_[i - 2];
+      const double dt = (curr.stamp - prev.stamp).toSec();
+      if (dt > 0.0)
+      {
+        const double ratio = std::min((time - curr.stamp).toSec(), extrapolation_time_) / dt;
+
+        // Don't extrapolate across zero, which would reverse the motion:
+        const double lin = curr.lin + (curr.lin - prev.lin) * ratio;
+        const double ang = curr.ang + (curr.ang - prev.ang) * ratio;
+        command.lin = lin * curr.lin > 0.0 ? lin : 0.0;
+        command.ang = ang * curr.ang > 0.0 ? ang : 0.0;
+      }
+    }
+
+    return true;
+  }
+
+} // namespace diff_drive_controller
@@ -36,11 +36,12 @@
  * Author: Bence Magyar, Enrique Fernández
  */
 
+#include <algorithm>
 #include <cmath>
+#include <boost/bind.hpp>
 #include <diff_drive_controller/diff_drive_controller.h>
-#include <tf/transform_datatypes.h>
+#include <diff_drive_controller/urdf_model_cache.h>
 #include <urdf/urdfdom_compatibility.h>
-#include <urdf_parser/urdf_parser.h>
 
 static double euclideanOfVectors(const urdf::Vector3& vec1, const urdf::Vector3& vec2)
 {
@@ -144,25 +145,36 @@ static bool getWheelRadius(const urdf::LinkConstSharedPtr& wheel_link, double& w
 namespace diff_drive_controller{
 
   DiffDriveController::DiffDriveController()
-    : open_loop_(false)
+    : controller_interface::MultiInterfaceController<hardware_interface::VelocityJointInterface,
+                                                     hardware_interface::ImuSensorInterface>(true)
+    , open_loop_(false)
+    , odom_zero_order_hold_(false)
+    , fuse_imu_(false)
     , command_struct_()
+    , cmd_vel_stamped_(false)
+    , wheel_state_restart_(true)
     , wheel_separation_(0.0)
     , wheel_radius_(0.0)
     , wheel_separation_multiplier_(1.0)
     , left_wheel_radius_multiplier_(1.0)
     , right_wheel_radius_multiplier_(1.0)
     , cmd_vel_timeout_(0.5)
+    , cmd_vel_timed_out_(false)
     , allow_multiple_cmd_vel_publishers_(true)
     , base_frame_id_("base_link")
     , odom_frame_id_("odom")
     , enable_odom_tf_(true)
     , wheel_joints_size_(0)
+    , drop_faulty_wheels_(false)
+    , has_wheel_velocity_limits_(false)
+    , max_left_wheel_velocity_(0.0)
+    , max_right_wheel_velocity_(0.0)
     , publish_cmd_(false)
     , publish_wheel_joint_controller_state_(false)
   {
   }
 
-  bool DiffDriveController::init(hardware_interface::VelocityJointInterface* hw,
+  bool DiffDriveController::init(hardware_interface::RobotHW* robot_hw,
             ros::NodeHandle& root_nh,
             ros::NodeHandle &controller_nh)
   {
@@ -170,6 +182,19 @@ namespace diff_drive_controller{
     std::size_t id = complete_ns.find_last_of("/");
     name_ = complete_ns.substr(id + 1);
 
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope =
+      controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh, name_);
+    if (!thread_placement_scope) {return false;}
+
+    // The IMU sensor interface is optional, but not the wheels one
+    hardware_interface::VelocityJointInterface* const hw = robot_hw->get<hardware_interface::VelocityJointInterface>();
+    if (!hw)
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Robot hardware has no velocity joint interface for the wheels.");
+      return false;
+    }
+
     // Get joint names from the parameter server
     std::vector<std::string> left_wheel_names, right_wheel_names;
     if (!getWheelNames(controller_nh, "left_wheel", left_wheel_names) ||
@@ -202,6 +227,41 @@ namespace diff_drive_controller{
 
     controller_nh.param("open_loop", open_loop_, open_loop_);
 
+    // Zero-order hold integration, insensitive to the update period jitter
+    controller_nh.param("odom_zero_order_hold", odom_zero_order_hold_, odom_zero_order_hold_);
+    if (odom_zero_order_hold_)
+    {
+      ROS_INFO_STREAM_NAMED(name_, "Odometry will be integrated as exact arcs"
+                            << (open_loop_ ? ", over the controller update period." : "."));
+      odometry_.setIntegrationMethod(Odometry::ZERO_ORDER_HOLD);
+    }
+
+    // Gyro yaw rate fusion, with an IMU of the same controller manager, whose z axis must be the base one
+    std::string imu_sensor;
+    controller_nh.param("imu_sensor", imu_sensor, imu_sensor);
+    if (!imu_sensor.empty())
+    {
+      hardware_interface::ImuSensorInterface* const imu_hw = robot_hw->get<hardware_interface::ImuSensorInterface>();
+      if (!imu_hw)
+      {
+        ROS_ERROR_STREAM_NAMED(name_, "Robot hardware has no IMU sensor interface for " << imu_sensor << ".");
+        return false;
+      }
+      imu_ = imu_hw->getHandle(imu_sensor);  // throws on failure
+
+      double imu_time_constant = 1.0;
+      controller_nh.param("imu_time_constant", imu_time_constant, imu_time_constant);
+      if (!(imu_time_constant > 0.0))
+      {
+        ROS_ERROR_STREAM_NAMED(name_, "IMU time constant must be positive, not " << imu_time_constant << ".");
+        return false;
+      }
+      odometry_.setYawRateFusionTimeConstant(imu_time_constant);
+      fuse_imu_ = true;
+      ROS_INFO_STREAM_NAMED(name_, "Yaw rate of " << imu_sensor << " will be fused into the odometry heading, "
+                            "with a time constant of " << imu_time_constant << "s.");
+    }
+
     controller_nh.param("wheel_separation_multiplier", wheel_separation_multiplier_, wheel_separation_multiplier_);
     ROS_INFO_STREAM_NAMED(name_, "Wheel separation will be multiplied by "
                           << wheel_separation_multiplier_ << ".");
@@ -232,6 +292,18 @@ namespace diff_drive_controller{
 
     odometry_.setVelocityRollingWindowSize(velocity_rolling_window_size);
 
+    // Online pose covariance, propagated from the wheel displacement variances instead of the static diagonal
+    bool pose_covariance_propagation = false;
+    controller_nh.param("pose_covariance_propagation", pose_covariance_propagation, pose_covariance_propagation);
+    if (pose_covariance_propagation)
+    {
+      double wheel_slip_variance = 0.01;
+      controller_nh.param("wheel_slip_variance", wheel_slip_variance, wheel_slip_variance);
+      ROS_INFO_STREAM_NAMED(name_, "Pose covariance will be propagated from a wheel slip variance of "
+                            << wheel_slip_variance << "m^2/m.");
+      odometry_.setCovarianceParams(wheel_slip_variance, wheel_slip_variance);
+    }
+
     // Twist command related:
     controller_nh.param("cmd_vel_timeout", cmd_vel_timeout_, cmd_vel_timeout_);
     ROS_INFO_STREAM_NAMED(name_, "Velocity commands will be considered old if they are older than "
@@ -241,6 +313,20 @@ namespace diff_drive_controller{
     ROS_INFO_STREAM_NAMED(name_, "Allow mutiple cmd_vel publishers is "
                           << (allow_multiple_cmd_vel_publishers_?"enabled":"disabled"));
 
+    controller_nh.param("cmd_vel_stamped", cmd_vel_stamped_, cmd_vel_stamped_);
+    if (cmd_vel_stamped_)
+    {
+      int cmd_vel_queue_size = 10;
+      double cmd_vel_extrapolation = 0.0;
+      controller_nh.param("cmd_vel_queue_size", cmd_vel_queue_size, cmd_vel_queue_size);
+      controller_nh.param("cmd_vel_extrapolation", cmd_vel_extrapolation, cmd_vel_extrapolation);
+      command_queue_struct_.setCapacity(std::max(cmd_vel_queue_size, 1));
+      command_queue_struct_.setExtrapolationTime(cmd_vel_extrapolation);
+      command_queue_.initRT(command_queue_struct_);
+      ROS_INFO_STREAM_NAMED(name_, "Stamped velocity commands will be queued up to " << command_queue_struct_.capacity()
+                            << " and extrapolated for " << cmd_vel_extrapolation << "s past the newest one.");
+    }
+
     controller_nh.param("base_frame_id", base_frame_id_, base_frame_id_);
     ROS_INFO_STREAM_NAMED(name_, "Base frame_id set to " << base_frame_id_);
 
@@ -251,25 +337,48 @@ namespace diff_drive_controller{
     ROS_INFO_STREAM_NAMED(name_, "Publishing to tf is " << (enable_odom_tf_?"enabled":"disabled"));
 
     // Velocity and acceleration limits:
-    controller_nh.param("linear/x/has_velocity_limits"    , limiter_lin_.has_velocity_limits    , limiter_lin_.has_velocity_limits    );
-    controller_nh.param("linear/x/has_acceleration_limits", limiter_lin_.has_acceleration_limits, limiter_lin_.has_acceleration_limits);
-    controller_nh.param("linear/x/has_jerk_limits"        , limiter_lin_.has_jerk_limits        , limiter_lin_.has_jerk_limits        );
-    controller_nh.param("linear/x/max_velocity"           , limiter_lin_.max_velocity           ,  limiter_lin_.max_velocity          );
-    controller_nh.param("linear/x/min_velocity"           , limiter_lin_.min_velocity           , -limiter_lin_.max_velocity          );
-    controller_nh.param("linear/x/max_acceleration"       , limiter_lin_.max_acceleration       ,  limiter_lin_.max_acceleration      );
-    controller_nh.param("linear/x/min_acceleration"       , limiter_lin_.min_acceleration       , -limiter_lin_.max_acceleration      );
-    controller_nh.param("linear/x/max_jerk"               , limiter_lin_.max_jerk               ,  limiter_lin_.max_jerk              );
-    controller_nh.param("linear/x/min_jerk"               , limiter_lin_.min_jerk               , -limiter_lin_.max_jerk              );
-
-    controller_nh.param("angular/z/has_velocity_limits"    , limiter_ang_.has_velocity_limits    , limiter_ang_.has_velocity_limits    );
-    controller_nh.param("angular/z/has_acceleration_limits", limiter_ang_.has_acceleration_limits, limiter_ang_.has_acceleration_limits);
-    controller_nh.param("angular/z/has_jerk_limits"        , limiter_ang_.has_jerk_limits        , limiter_ang_.has_jerk_limits        );
-    controller_nh.param("angular/z/max_velocity"           , limiter_ang_.max_velocity           ,  limiter_ang_.max_velocity          );
-    controller_nh.param("angular/z/min_velocity"           , limiter_ang_.min_velocity           , -limiter_ang_.max_velocity          );
-    controller_nh.param("angular/z/max_acceleration"       , limiter_ang_.max_acceleration       ,  limiter_ang_.max_acceleration      );
-    controller_nh.param("angular/z/min_acceleration"       , limiter_ang_.min_acceleration       , -limiter_ang_.max_acceleration      );
-    controller_nh.param("angular/z/max_jerk"               , limiter_ang_.max_jerk               ,  limiter_ang_.max_jerk              );
-    controller_nh.param("angular/z/min_jerk"               , limiter_ang_.min_jerk               , -limiter_ang_.max_jerk              );
+    SpeedLimiter limiter_lin;
+    SpeedLimiter limiter_ang;
+    controller_nh.param("linear/x/has_velocity_limits"    , limiter_lin.has_velocity_limits    , limiter_lin.has_velocity_limits    );
+    controller_nh.param("linear/x/has_acceleration_limits", limiter_lin.has_acceleration_limits, limiter_lin.has_acceleration_limits);
+    controller_nh.param("linear/x/has_jerk_limits"        , limiter_lin.has_jerk_limits        , limiter_lin.has_jerk_limits        );
+    controller_nh.param("linear/x/max_velocity"           , limiter_lin.max_velocity           ,  limiter_lin.max_velocity          );
+    controller_nh.param("linear/x/min_velocity"           , limiter_lin.min_velocity           , -limiter_lin.max_velocity          );
+    controller_nh.param("linear/x/max_acceleration"       , limiter_lin.max_acceleration       ,  limiter_lin.max_acceleration      );
+    controller_nh.param("linear/x/min_acceleration"       , limiter_lin.min_acceleration       , -limiter_lin.max_acceleration      );
+    controller_nh.param("linear/x/max_jerk"               , limiter_lin.max_jerk               ,  limiter_lin.max_jerk              );
+    controller_nh.param("linear/x/min_jerk"               , limiter_lin.min_jerk               , -limiter_lin.max_jerk              );
+
+    controller_nh.param("angular/z/has_velocity_limits"    , limiter_ang.has_velocity_limits    , limiter_ang.has_velocity_limits    );
+    controller_nh.param("angular/z/has_acceleration_limits", limiter_ang.has_acceleration_limits, limiter_ang.has_acceleration_limits);
+    controller_nh.param("angular/z/has_jerk_limits"        , limiter_ang.has_jerk_limits        , limiter_ang.has_jerk_limits        );
+    controller_nh.param("angular/z/max_velocity"           , limiter_ang.max_velocity           ,  limiter_ang.max_velocity          );
+    controller_nh.param("angular/z/min_velocity"           , limiter_ang.min_velocity           , -limiter_ang.max_velocity          );
+    controller_nh.param("angular/z/max_acceleration"       , limiter_ang.max_acceleration       ,  limiter_ang.max_acceleration      );
+    controller_nh.param("angular/z/min_acceleration"       , limiter_ang.min_acceleration       , -limiter_ang.max_acceleration      );
+    controller_nh.param("angular/z/max_jerk"               , limiter_ang.max_jerk               ,  limiter_ang.max_jerk              );
+    controller_nh.param("angular/z/min_jerk"               , limiter_ang.min_jerk               , -limiter_ang.max_jerk              );
+
+    limiter_.setAxisLimits(TwistLimiter::LINEAR_X, limiter_lin);
+    limiter_.setAxisLimits(TwistLimiter::ANGULAR_Z, limiter_ang);
+
+    // Wheel velocity limits [rad/s] of the wheel joint commands, scaling both together to preserve curvature:
+    double max_wheel_velocity = 0.0;
+    controller_nh.param("wheel/has_velocity_limits", has_wheel_velocity_limits_, has_wheel_velocity_limits_);
+    controller_nh.param("wheel/max_velocity"       , max_wheel_velocity        , max_wheel_velocity        );
+    controller_nh.param("left_wheel/max_velocity"  , max_left_wheel_velocity_  , max_wheel_velocity        );
+    controller_nh.param("right_wheel/max_velocity" , max_right_wheel_velocity_ , max_wheel_velocity        );
+    if (has_wheel_velocity_limits_)
+    {
+      if (max_left_wheel_velocity_ <= 0.0 || max_right_wheel_velocity_ <= 0.0)
+      {
+        ROS_ERROR_STREAM_NAMED(name_, "Wheel velocity limits must be positive, got left: " << max_left_wheel_velocity_
+                               << ", right: " << max_right_wheel_velocity_ << ".");
+        return false;
+      }
+      ROS_INFO_STREAM_NAMED(name_, "Wheel velocities will be limited to " << max_left_wheel_velocity_
+                            << " (left) and " << max_right_wheel_velocity_ << " (right) rad/s.");
+    }
 
     // Publish limited velocity:
     controller_nh.param("publish_cmd", publish_cmd_, publish_cmd_);
@@ -301,7 +410,7 @@ namespace diff_drive_controller{
                           << ", left wheel radius "  << lwr
                           << ", right wheel radius " << rwr);
 
-    setOdomPubFields(root_nh, controller_nh);
+    odom_publisher_.init(name_, root_nh, controller_nh, odom_frame_id_, base_frame_id_, publish_period_, enable_odom_tf_);
 
     if (publish_cmd_)
     {
@@ -311,35 +420,10 @@ namespace diff_drive_controller{
     // Wheel joint controller state:
     if (publish_wheel_joint_controller_state_)
     {
-      controller_state_pub_.reset(new realtime_tools::RealtimePublisher<control_msgs::JointTrajectoryControllerState>(controller_nh, "wheel_joint_controller_state", 100));
-
-      const size_t num_wheels = wheel_joints_size_ * 2;
-
-      controller_state_pub_->msg_.joint_names.resize(num_wheels);
-
-      controller_state_pub_->msg_.desired.positions.resize(num_wheels);
-      controller_state_pub_->msg_.desired.velocities.resize(num_wheels);
-      controller_state_pub_->msg_.desired.accelerations.resize(num_wheels);
-      controller_state_pub_->msg_.desired.effort.resize(num_wheels);
-
-      controller_state_pub_->msg_.actual.positions.resize(num_wheels);
-      controller_state_pub_->msg_.actual.velocities.resize(num_wheels);
-      controller_state_pub_->msg_.actual.accelerations.resize(num_wheels);
-      controller_state_pub_->msg_.actual.effort.resize(num_wheels);
-
-      controller_state_pub_->msg_.error.positions.resize(num_wheels);
-      controller_state_pub_->msg_.error.velocities.resize(num_wheels);
-      controller_state_pub_->msg_.error.accelerations.resize(num_wheels);
-      controller_state_pub_->msg_.error.effort.resize(num_wheels);
-
-      for (size_t i = 0; i < wheel_joints_size_; ++i)
-      {
-        controller_state_pub_->msg_.joint_names[i] = left_wheel_names[i];
-        controller_state_pub_->msg_.joint_names[i + wheel_joints_size_] = right_wheel_names[i];
-      }
-
-      vel_left_previous_.resize(wheel_joints_size_, 0.0);
-      vel_right_previous_.resize(wheel_joints_size_, 0.0);
+      std::vector<std::string> wheel_names(left_wheel_names);
+      wheel_names.insert(wheel_names.end(), right_wheel_names.begin(), right_wheel_names.end());
+      wheel_state_pub_.start(controller_nh, wheel_names, 16);
+      desired_wheel_positions_.assign(wheel_names.size(), 0.0);
     }
 
     // Get the joint object to use in the realtime loop
@@ -352,7 +436,31 @@ namespace diff_drive_controller{
       right_wheel_joints_[i] = hw->getHandle(right_wheel_names[i]);  // throws on failure
     }
 
-    sub_command_ = controller_nh.subscribe("cmd_vel", 1, &DiffDriveController::cmdVelCallback, this);
+    // Wheel groups: optional per-wheel weights in odometry, e.g. to trust some wheels more
+    std::vector<double> left_wheel_weights, right_wheel_weights;
+    controller_nh.param("left_wheel_weights", left_wheel_weights, left_wheel_weights);
+    controller_nh.param("right_wheel_weights", right_wheel_weights, right_wheel_weights);
+    if (!left_wheels_.init(left_wheel_joints_, left_wheel_weights) ||
+        !right_wheels_.init(right_wheel_joints_, right_wheel_weights))
+    {
+      ROS_ERROR_STREAM_NAMED(name_,
+          "Wheel weights must have one non-negative value per wheel, and at least one positive value.");
+      return false;
+    }
+
+    controller_nh.param("drop_faulty_wheels", drop_faulty_wheels_, drop_faulty_wheels_);
+    ROS_INFO_STREAM_NAMED(name_, "Wheels with an invalid position will "
+                          << (drop_faulty_wheels_ ? "be left out of odometry" : "skip the update") << ".");
+
+    if (cmd_vel_stamped_)
+    {
+      sub_command_ = controller_nh.subscribe("cmd_vel", command_queue_struct_.capacity(),
+                                             &DiffDriveController::cmdVelStampedCallback, this);
+    }
+    else
+    {
+      sub_command_ = controller_nh.subscribe("cmd_vel", 1, &DiffDriveController::cmdVelCallback, this);
+    }
 
     // Initialize dynamic parameters
     DynamicParams dynamic_params;
@@ -378,102 +486,171 @@ namespace diff_drive_controller{
     dyn_reconf_server_->updateConfig(config);
     dyn_reconf_server_->setCallback(boost::bind(&DiffDriveController::reconfCallback, this, _1, _2));
 
+    rt_audit_.init(controller_nh, name_);
+    latency_monitor_.init(controller_nh, name_);
+    if (!metrics_endpoint_.init(controller_nh)) {return false;}
+    cmd_vel_timeouts_metric_.init("ros_controllers_diff_drive_cmd_vel_timeouts_total",
+                                  "Velocity commands that timed out.", name_);
+    brakes_metric_.init("ros_controllers_diff_drive_brakes_total",
+                        "Brakes on start, stop or when multiple velocity command publishers are detected.", name_);
+    if (cmd_vel_stamped_)
+    {
+      command_monitor_.add("cmd_vel", command_queue_.stats());
+    }
+    else
+    {
+      command_monitor_.add("cmd_vel", command_.stats());
+    }
+    command_monitor_.init(controller_nh, name_);
+
+    // Telemetry ring: state and command of each wheel, left wheels first
+    std::vector<std::string> wheel_names(left_wheel_names);
+    wheel_names.insert(wheel_names.end(), right_wheel_names.begin(), right_wheel_names.end());
+    std::vector<std::string> telemetry_labels;
+    const char* const telemetry_quantities[] = {"position", "velocity", "effort", "command"};
+    for (const char* quantity : telemetry_quantities)
+    {
+      for (const std::string& wheel_name : wheel_names)
+      {
+        telemetry_labels.push_back(wheel_name + "/" + quantity);
+      }
+    }
+    if (!telemetry_ring_.init(controller_nh, telemetry_labels))
+    {
+      return false;
+    }
+
     return true;
   }
 
   void DiffDriveController::update(const ros::Time& time, const ros::Duration& period)
   {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+    controller_instrumentation::UpdateLatencyScope latency_scope(latency_monitor_);
+
     // update parameter from dynamic reconf
-    updateDynamicParams();
+    const bool dynamic_params_changed = updateDynamicParams();
 
     // Apply (possibly new) multipliers:
     const double ws  = wheel_separation_multiplier_   * wheel_separation_;
     const double lwr = left_wheel_radius_multiplier_  * wheel_radius_;
     const double rwr = right_wheel_radius_multiplier_ * wheel_radius_;
 
-    odometry_.setWheelParams(ws, lwr, rwr);
+    if (dynamic_params_changed)
+    {
+      odometry_.setWheelParams(ws, lwr, rwr);
+    }
 
     // COMPUTE AND PUBLISH ODOMETRY
     if (open_loop_)
     {
-      odometry_.updateOpenLoop(last0_cmd_.lin, last0_cmd_.ang, time);
+      if (odom_zero_order_hold_)
+        odometry_.updateOpenLoop(last0_cmd_.lin, last0_cmd_.ang, time, period);
+      else
+        odometry_.updateOpenLoop(last0_cmd_.lin, last0_cmd_.ang, time);
     }
     else
     {
       double left_pos  = 0.0;
       double right_pos = 0.0;
-      for (size_t i = 0; i < wheel_joints_size_; ++i)
-      {
-        const double lp = left_wheel_joints_[i].getPosition();
-        const double rp = right_wheel_joints_[i].getPosition();
-        if (std::isnan(lp) || std::isnan(rp))
-          return;
-
-        left_pos  += lp;
-        right_pos += rp;
-      }
-      left_pos  /= wheel_joints_size_;
-      right_pos /= wheel_joints_size_;
+      if (!left_wheels_.readPosition(left_pos, drop_faulty_wheels_) ||
+          !right_wheels_.readPosition(right_pos, drop_faulty_wheels_))
+        return;
 
-      // Estimate linear and angular velocity using joint information
-      odometry_.update(left_pos, right_pos, time);
+      // Estimate linear and angular velocity using joint information, and the gyro yaw rate if valid
+      const double yaw_rate = fuse_imu_ ? imu_.getAngularVelocity()[2] : 0.0;
+      if (fuse_imu_ && std::isfinite(yaw_rate))
+        odometry_.updateFused(left_pos, right_pos, yaw_rate, time);
+      else
+        odometry_.update(left_pos, right_pos, time);
     }
+    CONTROLLER_TRACEPOINT1(odometry_updated, name_.c_str());
 
     // Publish odometry message
-    if (last_state_publish_time_ + publish_period_ < time)
+    OdometrySample sample;
+    sample.stamp   = time;
+    sample.x       = odometry_.getX();
+    sample.y       = odometry_.getY();
+    sample.heading = odometry_.getHeading();
+    sample.linear  = odometry_.getLinear();
+    sample.angular = odometry_.getAngular();
+    sample.has_pose_covariance = odometry_.hasPoseCovariance();
+    if (sample.has_pose_covariance)
     {
-      last_state_publish_time_ += publish_period_;
-      // Compute and store orientation info
-      const geometry_msgs::Quaternion orientation(
-            tf::createQuaternionMsgFromYaw(odometry_.getHeading()));
-
-      // Populate odom message and publish
-      if (odom_pub_->trylock())
-      {
-        odom_pub_->msg_.header.stamp = time;
-        odom_pub_->msg_.pose.pose.position.x = odometry_.getX();
-        odom_pub_->msg_.pose.pose.position.y = odometry_.getY();
-        odom_pub_->msg_.pose.pose.orientation = orientation;
-        odom_pub_->msg_.twist.twist.linear.x  = odometry_.getLinear();
-        odom_pub_->msg_.twist.twist.angular.z = odometry_.getAngular();
-        odom_pub_->unlockAndPublish();
-      }
-
-      // Publish tf /odom frame
-      if (enable_odom_tf_ && tf_odom_pub_->trylock())
-      {
-        geometry_msgs::TransformStamped& odom_frame = tf_odom_pub_->msg_.transforms[0];
-        odom_frame.header.stamp = time;
-        odom_frame.transform.translation.x = odometry_.getX();
-        odom_frame.transform.translation.y = odometry_.getY();
-        odom_frame.transform.rotation = orientation;
-        tf_odom_pub_->unlockAndPublish();
-      }
+      for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+          sample.pose_covariance[3 * i + j] = odometry_.getPoseCovariance(i, j);
     }
+    odom_publisher_.update(sample);
 
     // MOVE ROBOT
     // Retreive current velocity command and time step:
-    Commands curr_cmd = *(command_.readFromRT());
+    Commands curr_cmd;
+    if (cmd_vel_stamped_)
+    {
+      TimedCommand timed_cmd;
+      if (command_queue_.readFromRT()->sample(time, timed_cmd))
+      {
+        curr_cmd.lin   = timed_cmd.lin;
+        curr_cmd.ang   = timed_cmd.ang;
+        curr_cmd.stamp = timed_cmd.stamp;
+      }
+    }
+    else
+    {
+      curr_cmd = *(command_.readFromRT());
+    }
     const double dt = (time - curr_cmd.stamp).toSec();
 
     // Brake if cmd_vel has timeout:
-    if (dt > cmd_vel_timeout_)
+    const bool cmd_vel_timed_out = dt > cmd_vel_timeout_;
+    if (cmd_vel_timed_out)
     {
       curr_cmd.lin = 0.0;
       curr_cmd.ang = 0.0;
+      if (!cmd_vel_timed_out_) {cmd_vel_timeouts_metric_.increment();}
     }
+    cmd_vel_timed_out_ = cmd_vel_timed_out;
 
     // Limit velocities and accelerations:
     const double cmd_dt(period.toSec());
 
-    limiter_lin_.limit(curr_cmd.lin, last0_cmd_.lin, last1_cmd_.lin, cmd_dt);
-    limiter_ang_.limit(curr_cmd.ang, last0_cmd_.ang, last1_cmd_.ang, cmd_dt);
+    TwistLimiter::Twist cmd_twist = {{curr_cmd.lin, 0.0, curr_cmd.ang}};
+    limiter_.limit(cmd_twist,
+                   {{last0_cmd_.lin, 0.0, last0_cmd_.ang}},
+                   {{last1_cmd_.lin, 0.0, last1_cmd_.ang}},
+                   cmd_dt);
+    if (cmd_twist[TwistLimiter::LINEAR_X] != curr_cmd.lin || cmd_twist[TwistLimiter::ANGULAR_Z] != curr_cmd.ang)
+    {
+      CONTROLLER_TRACEPOINT1(command_limited, name_.c_str());
+    }
+    curr_cmd.lin = cmd_twist[TwistLimiter::LINEAR_X];
+    curr_cmd.ang = cmd_twist[TwistLimiter::ANGULAR_Z];
+
+    // Compute wheels velocities:
+    double vel_left  = (curr_cmd.lin - curr_cmd.ang * ws / 2.0)/lwr;
+    double vel_right = (curr_cmd.lin + curr_cmd.ang * ws / 2.0)/rwr;
+
+    // Saturate both wheels by the same factor, so the robot follows the commanded curvature as fast as it can:
+    if (has_wheel_velocity_limits_)
+    {
+      const double scale = std::min(1.0, std::min(max_left_wheel_velocity_  / std::abs(vel_left),
+                                                   max_right_wheel_velocity_ / std::abs(vel_right)));
+      if (scale < 1.0)
+      {
+        CONTROLLER_TRACEPOINT1(wheel_velocity_saturated, name_.c_str());
+        vel_left     *= scale;
+        vel_right    *= scale;
+        curr_cmd.lin *= scale;
+        curr_cmd.ang *= scale;
+      }
+    }
 
     last1_cmd_ = last0_cmd_;
     last0_cmd_ = curr_cmd;
 
     // Publish limited velocity:
-    if (publish_cmd_ && cmd_vel_pub_ && cmd_vel_pub_->trylock())
+    if (publish_cmd_ && cmd_vel_pub_ && controller_instrumentation::tracedTrylock(*cmd_vel_pub_, "cmd_vel_out"))
     {
       cmd_vel_pub_->msg_.header.stamp = time;
       cmd_vel_pub_->msg_.twist.linear.x = curr_cmd.lin;
@@ -481,19 +658,12 @@ namespace diff_drive_controller{
       cmd_vel_pub_->unlockAndPublish();
     }
 
-    // Compute wheels velocities:
-    const double vel_left  = (curr_cmd.lin - curr_cmd.ang * ws / 2.0)/lwr;
-    const double vel_right = (curr_cmd.lin + curr_cmd.ang * ws / 2.0)/rwr;
-
     // Set wheels velocities:
-    for (size_t i = 0; i < wheel_joints_size_; ++i)
-    {
-      left_wheel_joints_[i].setCommand(vel_left);
-      right_wheel_joints_[i].setCommand(vel_right);
-    }
+    left_wheels_.setCommand(vel_left);
+    right_wheels_.setCommand(vel_right);
 
     publishWheelData(time, period, curr_cmd, ws, lwr, rwr);
-    time_previous_ = time;
+    writeTelemetry(time);
   }
 
   void DiffDriveController::starting(const ros::Time& time)
@@ -501,54 +671,88 @@ namespace diff_drive_controller{
     brake();
 
     // Register starting time used to keep fixed rate
-    last_state_publish_time_ = time;
-    time_previous_ = time;
+    odom_publisher_.starting(time);
+    last_wheel_state_publish_time_ = time;
+    wheel_state_restart_ = true;
 
     odometry_.init(time);
+
+    // Only timeouts of commands received while running are counted
+    cmd_vel_timed_out_ = true;
+
+    latency_monitor_.restart();
   }
 
   void DiffDriveController::stopping(const ros::Time& /*time*/)
   {
     brake();
+    odom_publisher_.stopping();
   }
 
   void DiffDriveController::brake()
   {
     const double vel = 0.0;
-    for (size_t i = 0; i < wheel_joints_size_; ++i)
+    left_wheels_.setCommand(vel);
+    right_wheels_.setCommand(vel);
+    brakes_metric_.increment();
+  }
+
+  bool DiffDriveController::acceptCommands()
+  {
+    if (!isRunning())
     {
-      left_wheel_joints_[i].setCommand(vel);
-      right_wheel_joints_[i].setCommand(vel);
+      ROS_ERROR_NAMED(name_, "Can't accept new commands. Controller is not running.");
+      return false;
     }
+
+    // check that we don't have multiple publishers on the command topic
+    if (!allow_multiple_cmd_vel_publishers_ && sub_command_.getNumPublishers() > 1)
+    {
+      ROS_ERROR_STREAM_THROTTLE_NAMED(1.0, name_, "Detected " << sub_command_.getNumPublishers()
+          << " publishers. Only 1 publisher is allowed. Going to brake.");
+      brake();
+      return false;
+    }
+
+    return true;
   }
 
   void DiffDriveController::cmdVelCallback(const geometry_msgs::Twist& command)
   {
-    if (isRunning())
+    if (!acceptCommands())
     {
-      // check that we don't have multiple publishers on the command topic
-      if (!allow_multiple_cmd_vel_publishers_ && sub_command_.getNumPublishers() > 1)
-      {
-        ROS_ERROR_STREAM_THROTTLE_NAMED(1.0, name_, "Detected " << sub_command_.getNumPublishers()
-            << " publishers. Only 1 publisher is allowed. Going to brake.");
-        brake();
-        return;
-      }
-
-      command_struct_.ang   = command.angular.z;
-      command_struct_.lin   = command.linear.x;
-      command_struct_.stamp = ros::Time::now();
-      command_.writeFromNonRT (command_struct_);
-      ROS_DEBUG_STREAM_NAMED(name_,
-                             "Added values to command. "
-                             << "Ang: "   << command_struct_.ang << ", "
-                             << "Lin: "   << command_struct_.lin << ", "
-                             << "Stamp: " << command_struct_.stamp);
+      return;
     }
-    else
+
+    command_struct_.ang   = command.angular.z;
+    command_struct_.lin   = command.linear.x;
+    command_struct_.stamp = ros::Time::now();
+    command_.writeFromNonRT (command_struct_);
+    ROS_DEBUG_STREAM_NAMED(name_,
+                           "Added values to command. "
+                           << "Ang: "   << command_struct_.ang << ", "
+                           << "Lin: "   << command_struct_.lin << ", "
+                           << "Stamp: " << command_struct_.stamp);
+  }
+
+  void DiffDriveController::cmdVelStampedCallback(const geometry_msgs::TwistStamped& command)
+  {
+    if (!acceptCommands())
     {
-      ROS_ERROR_NAMED(name_, "Can't accept new commands. Controller is not running.");
+      return;
     }
+
+    const ros::Time now = ros::Time::now();
+    const TimedCommand timed_cmd(command.twist.linear.x, command.twist.angular.z,
+                                 command.header.stamp.isZero() ? now : command.header.stamp);
+    command_queue_struct_.push(timed_cmd, now);
+    command_queue_.writeFromNonRT(command_queue_struct_);
+    ROS_DEBUG_STREAM_NAMED(name_,
+                           "Queued command. "
+                           << "Ang: "   << timed_cmd.ang << ", "
+                           << "Lin: "   << timed_cmd.lin << ", "
+                           << "Stamp: " << timed_cmd.stamp << ", "
+                           << "Queued: " << command_queue_struct_.size());
   }
 
   bool DiffDriveController::getWheelNames(ros::NodeHandle& controller_nh,
@@ -626,7 +830,12 @@ namespace diff_drive_controller{
       return false;
     }
 
-    urdf::ModelInterfaceSharedPtr model(urdf::parseURDF(robot_model_str));
+    urdf::ModelInterfaceConstSharedPtr model(UrdfModelCache::get(robot_model_str));
+    if (!model)
+    {
+      ROS_ERROR_NAMED(name_, "Robot description couldn't be parsed.");
+      return false;
+    }
 
     urdf::JointConstSharedPtr left_wheel_joint(model->getJoint(left_wheel_name));
     urdf::JointConstSharedPtr right_wheel_joint(model->getJoint(right_wheel_name));
@@ -673,53 +882,6 @@ namespace diff_drive_controller{
     return true;
   }
 
-  void DiffDriveController::setOdomPubFields(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh)
-  {
-    // Get and check params for covariances
-    XmlRpc::XmlRpcValue pose_cov_list;
-    controller_nh.getParam("pose_covariance_diagonal", pose_cov_list);
-    ROS_ASSERT(pose_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-    ROS_ASSERT(pose_cov_list.size() == 6);
-    for (int i = 0; i < pose_cov_list.size(); ++i)
-      ROS_ASSERT(pose_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-
-    XmlRpc::XmlRpcValue twist_cov_list;
-    controller_nh.getParam("twist_covariance_diagonal", twist_cov_list);
-    ROS_ASSERT(twist_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-    ROS_ASSERT(twist_cov_list.size() == 6);
-    for (int i = 0; i < twist_cov_list.size(); ++i)
-      ROS_ASSERT(twist_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-
-    // Setup odometry realtime publisher + odom message constant fields
-    odom_pub_.reset(new realtime_tools::RealtimePublisher<nav_msgs::Odometry>(controller_nh, "odom", 100));
-    odom_pub_->msg_.header.frame_id = odom_frame_id_;
-    odom_pub_->msg_.child_frame_id = base_frame_id_;
-    odom_pub_->msg_.pose.pose.position.z = 0;
-    odom_pub_->msg_.pose.covariance = {
-        static_cast<double>(pose_cov_list[0]), 0., 0., 0., 0., 0.,
-        0., static_cast<double>(pose_cov_list[1]), 0., 0., 0., 0.,
-        0., 0., static_cast<double>(pose_cov_list[2]), 0., 0., 0.,
-        0., 0., 0., static_cast<double>(pose_cov_list[3]), 0., 0.,
-        0., 0., 0., 0., static_cast<double>(pose_cov_list[4]), 0.,
-        0., 0., 0., 0., 0., static_cast<double>(pose_cov_list[5]) };
-    odom_pub_->msg_.twist.twist.linear.y  = 0;
-    odom_pub_->msg_.twist.twist.linear.z  = 0;
-    odom_pub_->msg_.twist.twist.angular.x = 0;
-    odom_pub_->msg_.twist.twist.angular.y = 0;
-    odom_pub_->msg_.twist.covariance = {
-        static_cast<double>(twist_cov_list[0]), 0., 0., 0., 0., 0.,
-        0., static_cast<double>(twist_cov_list[1]), 0., 0., 0., 0.,
-        0., 0., static_cast<double>(twist_cov_list[2]), 0., 0., 0.,
-        0., 0., 0., static_cast<double>(twist_cov_list[3]), 0., 0.,
-        0., 0., 0., 0., static_cast<double>(twist_cov_list[4]), 0.,
-        0., 0., 0., 0., 0., static_cast<double>(twist_cov_list[5]) };
-    tf_odom_pub_.reset(new realtime_tools::RealtimePublisher<tf::tfMessage>(root_nh, "/tf", 100));
-    tf_odom_pub_->msg_.transforms.resize(1);
-    tf_odom_pub_->msg_.transforms[0].transform.translation.z = 0.0;
-    tf_odom_pub_->msg_.transforms[0].child_frame_id = base_frame_id_;
-    tf_odom_pub_->msg_.transforms[0].header.frame_id = odom_frame_id_;
-  }
-
   void DiffDriveController::reconfCallback(DiffDriveControllerConfig& config, uint32_t /*level*/)
   {
     DynamicParams dynamic_params;
@@ -736,10 +898,14 @@ namespace diff_drive_controller{
     ROS_INFO_STREAM_NAMED(name_, "Dynamic Reconfigure:\n" << dynamic_params);
   }
 
-  void DiffDriveController::updateDynamicParams()
+  bool DiffDriveController::updateDynamicParams()
   {
-    // Retreive dynamic params:
-    const DynamicParams dynamic_params = *(dynamic_params_.readFromRT());
+    // Retreive dynamic params, if changed:
+    if (!dynamic_params_.updateFromRT())
+    {
+      return false;
+    }
+    const DynamicParams& dynamic_params = dynamic_params_.readFromRT();
 
     left_wheel_radius_multiplier_  = dynamic_params.left_wheel_radius_multiplier;
     right_wheel_radius_multiplier_ = dynamic_params.right_wheel_radius_multiplier;
@@ -747,77 +913,79 @@ namespace diff_drive_controller{
 
     publish_period_ = ros::Duration(1.0 / dynamic_params.publish_rate);
     enable_odom_tf_ = dynamic_params.enable_odom_tf;
+
+    odom_publisher_.setPublishPeriod(publish_period_);
+    odom_publisher_.setPublishTf(enable_odom_tf_);
+    return true;
   }
 
   void DiffDriveController::publishWheelData(const ros::Time& time, const ros::Duration& period, Commands& curr_cmd,
           double wheel_separation, double left_wheel_radius, double right_wheel_radius)
   {
-    if (publish_wheel_joint_controller_state_ && controller_state_pub_->trylock())
+    if (!publish_wheel_joint_controller_state_)
+      return;
+
+    // Compute desired wheels velocities, that is before applying limits, and integrate them every cycle:
+    const double vel_left_desired  = (curr_cmd.lin - curr_cmd.ang * wheel_separation / 2.0) / left_wheel_radius;
+    const double vel_right_desired = (curr_cmd.lin + curr_cmd.ang * wheel_separation / 2.0) / right_wheel_radius;
+    const double cmd_dt(period.toSec());
+    for (size_t i = 0; i < wheel_joints_size_; ++i)
     {
-      const double cmd_dt(period.toSec());
+      desired_wheel_positions_[i]                      += vel_left_desired * cmd_dt;
+      desired_wheel_positions_[i + wheel_joints_size_] += vel_right_desired * cmd_dt;
+    }
+
+    // Copy the wheel states once per publish period, the publisher thread builds the message:
+    if (last_wheel_state_publish_time_ + publish_period_ >= time)
+      return;
+    last_wheel_state_publish_time_ += publish_period_;
 
-      // Compute desired wheels velocities, that is before applying limits:
-      const double vel_left_desired  = (curr_cmd.lin - curr_cmd.ang * wheel_separation / 2.0) / left_wheel_radius;
-      const double vel_right_desired = (curr_cmd.lin + curr_cmd.ang * wheel_separation / 2.0) / right_wheel_radius;
-      controller_state_pub_->msg_.header.stamp = time;
+    WheelStateSample* const sample = wheel_state_pub_.beginPush();
+    if (!sample)
+      return;
 
-      for (size_t i = 0; i < wheel_joints_size_; ++i)
+    sample->stamp = time;
+    sample->restart = wheel_state_restart_;
+    for (size_t i = 0; i < wheel_joints_size_; ++i)
+    {
+      const size_t j = i + wheel_joints_size_;
+      sample->position[i] = left_wheel_joints_[i].getPosition();
+      sample->velocity[i] = left_wheel_joints_[i].getVelocity();
+      sample->effort[i]   = left_wheel_joints_[i].getEffort();
+      sample->position[j] = right_wheel_joints_[i].getPosition();
+      sample->velocity[j] = right_wheel_joints_[i].getVelocity();
+      sample->effort[j]   = right_wheel_joints_[i].getEffort();
+
+      sample->desired_velocity[i] = vel_left_desired;
+      sample->desired_velocity[j] = vel_right_desired;
+    }
+    sample->desired_position = desired_wheel_positions_;
+    wheel_state_pub_.commitPush();
+    wheel_state_restart_ = false;
+  }
+
+  void DiffDriveController::writeTelemetry(const ros::Time& time)
+  {
+    double* data = telemetry_ring_.beginWrite(time.toSec());
+    if (!data)
+    {
+      return;
+    }
+
+    const size_t num_wheels = wheel_joints_size_ * 2;
+    for (size_t i = 0; i < wheel_joints_size_; ++i)
+    {
+      const hardware_interface::JointHandle* wheels[] = {&left_wheel_joints_[i], &right_wheel_joints_[i]};
+      for (size_t side = 0; side < 2; ++side)
       {
-        const double control_duration = (time - time_previous_).toSec();
-
-        const double left_wheel_acc = (left_wheel_joints_[i].getVelocity() - vel_left_previous_[i]) / control_duration;
-        const double right_wheel_acc = (right_wheel_joints_[i].getVelocity() - vel_right_previous_[i]) / control_duration;
-
-        // Actual
-        controller_state_pub_->msg_.actual.positions[i]     = left_wheel_joints_[i].getPosition();
-        controller_state_pub_->msg_.actual.velocities[i]    = left_wheel_joints_[i].getVelocity();
-        controller_state_pub_->msg_.actual.accelerations[i] = left_wheel_acc;
-        controller_state_pub_->msg_.actual.effort[i]        = left_wheel_joints_[i].getEffort();
-
-        controller_state_pub_->msg_.actual.positions[i + wheel_joints_size_]     = right_wheel_joints_[i].getPosition();
-        controller_state_pub_->msg_.actual.velocities[i + wheel_joints_size_]    = right_wheel_joints_[i].getVelocity();
-        controller_state_pub_->msg_.actual.accelerations[i + wheel_joints_size_] = right_wheel_acc;
-        controller_state_pub_->msg_.actual.effort[i+ wheel_joints_size_]         = right_wheel_joints_[i].getEffort();
-
-        // Desired
-        controller_state_pub_->msg_.desired.positions[i]    += vel_left_desired * cmd_dt;
-        controller_state_pub_->msg_.desired.velocities[i]    = vel_left_desired;
-        controller_state_pub_->msg_.desired.accelerations[i] = (vel_left_desired - vel_left_desired_previous_) * cmd_dt;
-        controller_state_pub_->msg_.desired.effort[i]        = std::numeric_limits<double>::quiet_NaN();
-
-        controller_state_pub_->msg_.desired.positions[i + wheel_joints_size_]    += vel_right_desired * cmd_dt;
-        controller_state_pub_->msg_.desired.velocities[i + wheel_joints_size_]    = vel_right_desired;
-        controller_state_pub_->msg_.desired.accelerations[i + wheel_joints_size_] = (vel_right_desired - vel_right_desired_previous_) * cmd_dt;
-        controller_state_pub_->msg_.desired.effort[i+ wheel_joints_size_]         = std::numeric_limits<double>::quiet_NaN();
-
-        // Error
-        controller_state_pub_->msg_.error.positions[i]     = controller_state_pub_->msg_.desired.positions[i] -
-                                                                              controller_state_pub_->msg_.actual.positions[i];
-        controller_state_pub_->msg_.error.velocities[i]    = controller_state_pub_->msg_.desired.velocities[i] -
-                                                                              controller_state_pub_->msg_.actual.velocities[i];
-        controller_state_pub_->msg_.error.accelerations[i] = controller_state_pub_->msg_.desired.accelerations[i] -
-                                                                              controller_state_pub_->msg_.actual.accelerations[i];
-        controller_state_pub_->msg_.error.effort[i]        = controller_state_pub_->msg_.desired.effort[i] -
-                                                                              controller_state_pub_->msg_.actual.effort[i];
-
-        controller_state_pub_->msg_.error.positions[i + wheel_joints_size_]     = controller_state_pub_->msg_.desired.positions[i + wheel_joints_size_] -
-                                                                                                   controller_state_pub_->msg_.actual.positions[i + wheel_joints_size_];
-        controller_state_pub_->msg_.error.velocities[i + wheel_joints_size_]    = controller_state_pub_->msg_.desired.velocities[i + wheel_joints_size_] -
-                                                                                                   controller_state_pub_->msg_.actual.velocities[i + wheel_joints_size_];
-        controller_state_pub_->msg_.error.accelerations[i + wheel_joints_size_] = controller_state_pub_->msg_.desired.accelerations[i + wheel_joints_size_] -
-                                                                                                   controller_state_pub_->msg_.actual.accelerations[i + wheel_joints_size_];
-        controller_state_pub_->msg_.error.effort[i+ wheel_joints_size_]         = controller_state_pub_->msg_.desired.effort[i + wheel_joints_size_] -
-                                                                                                   controller_state_pub_->msg_.actual.effort[i + wheel_joints_size_];
-
-        // Save previous velocities to compute acceleration
-        vel_left_previous_[i] = left_wheel_joints_[i].getVelocity();
-        vel_right_previous_[i] = right_wheel_joints_[i].getVelocity();
-        vel_left_desired_previous_ = vel_left_desired;
-        vel_right_desired_previous_ = vel_right_desired;
+        const size_t j = i + side * wheel_joints_size_;
+        data[j]                  = wheels[side]->getPosition();
+        data[j + num_wheels]     = wheels[side]->getVelocity();
+        data[j + 2 * num_wheels] = wheels[side]->getEffort();
+        data[j + 3 * num_wheels] = wheels[side]->getCommand();
       }
-
-      controller_state_pub_->unlockAndPublish();
     }
+    telemetry_ring_.commit();
   }
 
 } // namespace diff_drive_controller
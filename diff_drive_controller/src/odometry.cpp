@@ -39,19 +39,48 @@
  * Author: Paul Mathieu
  */
 
-#include <diff_drive_controller/odometry.h>
+#include <cmath>
 
-#include <boost/bind.hpp>
+#include <diff_drive_controller/odometry.h>
 
 namespace diff_drive_controller
 {
-  namespace bacc = boost::accumulators;
+  namespace
+  {
+    /// Squared argument below which the series expansions are used, accurate to double precision there:
+    const double SERIES_THRESHOLD = 1e-2;
+
+    /**
+     * \brief sin(x) / x, from its Taylor series near zero
+     * Both values are computed and one selected, so that the cost does not depend on x.
+     */
+    inline double sinc(double x)
+    {
+      const double x2 = x * x;
+      const double series = 1.0 - x2 / 6.0 * (1.0 - x2 / 20.0 * (1.0 - x2 / 42.0 * (1.0 - x2 / 72.0)));
+      const double ratio = sin(x) / x;
+      return x2 < SERIES_THRESHOLD ? series : ratio;
+    }
+
+    /**
+     * \brief Derivative of sinc, (cos(x) - sinc(x)) / x, from its Taylor series near zero
+     */
+    inline double sincDerivative(double x)
+    {
+      const double x2 = x * x;
+      const double series = -x / 3.0 * (1.0 - x2 / 10.0 * (1.0 - x2 / 28.0 * (1.0 - x2 / 54.0)));
+      const double ratio = (cos(x) - sinc(x)) / x;
+      return x2 < SERIES_THRESHOLD ? series : ratio;
+    }
+  }
 
   Odometry::Odometry(size_t velocity_rolling_window_size)
   : timestamp_(0.0)
   , x_(0.0)
   , y_(0.0)
   , heading_(0.0)
+  , wheel_heading_(0.0)
+  , yaw_rate_fusion_time_constant_(1.0)
   , linear_(0.0)
   , angular_(0.0)
   , wheel_separation_(0.0)
@@ -60,9 +89,13 @@ namespace diff_drive_controller
   , left_wheel_old_pos_(0.0)
   , right_wheel_old_pos_(0.0)
   , velocity_rolling_window_size_(velocity_rolling_window_size)
-  , linear_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , angular_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , integrate_fun_(boost::bind(&Odometry::integrateExact, this, _1, _2))
+  , linear_acc_(velocity_rolling_window_size)
+  , angular_acc_(velocity_rolling_window_size)
+  , integration_method_(EXACT)
+  , propagate_covariance_(false)
+  , left_wheel_slip_(0.0)
+  , right_wheel_slip_(0.0)
+  , pose_covariance_()
   {
   }
 
@@ -71,9 +104,65 @@ namespace diff_drive_controller
     // Reset accumulators and timestamp:
     resetAccumulators();
     timestamp_ = time;
+
+    // Restart the wheel heading from the current one, so that the fused heading does not jump:
+    wheel_heading_ = heading_;
   }
 
   bool Odometry::update(double left_pos, double right_pos, const ros::Time &time)
+  {
+    double linear, angular;
+    wheelDisplacements(left_pos, right_pos, linear, angular);
+    wheel_heading_ += angular;
+
+    /// Integrate odometry:
+    integrate(linear, angular);
+
+    return updateVelocity(linear, angular, time);
+  }
+
+  bool Odometry::updateFused(double left_pos, double right_pos, double yaw_rate, const ros::Time &time)
+  {
+    double linear, wheel_angular;
+    wheelDisplacements(left_pos, right_pos, linear, wheel_angular);
+    wheel_heading_ += wheel_angular;
+
+    /// Complementary filter: integrate the gyro, pulling towards the wheel heading with the fusion time constant.
+    /// Without elapsed time there is no gyro rotation to integrate, so the wheels alone give the heading change:
+    const double dt = (time - timestamp_).toSec();
+    double angular = wheel_angular;
+    if (dt > 0.0)
+    {
+      const double gyro_angular = yaw_rate * dt;
+      const double correction = dt / (yaw_rate_fusion_time_constant_ + dt);
+      angular = gyro_angular + correction * (wheel_heading_ - heading_ - gyro_angular);
+    }
+
+    /// Integrate odometry:
+    integrate(linear, angular);
+
+    return updateVelocity(linear, angular, time);
+  }
+
+  void Odometry::updateOpenLoop(double linear, double angular, const ros::Time &time)
+  {
+    updateOpenLoop(linear, angular, time, time - timestamp_);
+  }
+
+  void Odometry::updateOpenLoop(double linear, double angular, const ros::Time &time, const ros::Duration &period)
+  {
+    /// Save last linear and angular velocity:
+    linear_ = linear;
+    angular_ = angular;
+
+    /// Integrate odometry:
+    const double dt = period.toSec();
+    timestamp_ = time;
+    wheel_heading_ += angular * dt;
+    integrate(linear * dt, angular * dt);
+  }
+
+  void Odometry::wheelDisplacements(double left_pos, double right_pos, double& linear, double& angular)
   {
     /// Get current wheel joint positions:
     const double left_wheel_cur_pos  = left_pos  * left_wheel_radius_;
@@ -88,12 +177,12 @@ namespace diff_drive_controller
     right_wheel_old_pos_ = right_wheel_cur_pos;
 
     /// Compute linear and angular diff:
-    const double linear  = (right_wheel_est_vel + left_wheel_est_vel) * 0.5 ;
-    const double angular = (right_wheel_est_vel - left_wheel_est_vel) / wheel_separation_;
-
-    /// Integrate odometry:
-    integrate_fun_(linear, angular);
+    linear  = (right_wheel_est_vel + left_wheel_est_vel) * 0.5 ;
+    angular = (right_wheel_est_vel - left_wheel_est_vel) / wheel_separation_;
+  }
 
+  bool Odometry::updateVelocity(double linear, double angular, const ros::Time &time)
+  {
     /// We cannot estimate the speed with very small time intervals:
     const double dt = (time - timestamp_).toSec();
     if (dt < 0.0001)
@@ -102,27 +191,15 @@ namespace diff_drive_controller
     timestamp_ = time;
 
     /// Estimate speeds using a rolling mean to filter them out:
-    linear_acc_(linear/dt);
-    angular_acc_(angular/dt);
+    linear_acc_.push(linear/dt);
+    angular_acc_.push(angular/dt);
 
-    linear_ = bacc::rolling_mean(linear_acc_);
-    angular_ = bacc::rolling_mean(angular_acc_);
+    linear_ = linear_acc_.mean();
+    angular_ = angular_acc_.mean();
 
     return true;
   }
 
-  void Odometry::updateOpenLoop(double linear, double angular, const ros::Time &time)
-  {
-    /// Save last linear and angular velocity:
-    linear_ = linear;
-    angular_ = angular;
-
-    /// Integrate odometry:
-    const double dt = (time - timestamp_).toSec();
-    timestamp_ = time;
-    integrate_fun_(linear * dt, angular * dt);
-  }
-
   void Odometry::setWheelParams(double wheel_separation, double left_wheel_radius, double right_wheel_radius)
   {
     wheel_separation_   = wheel_separation;
@@ -134,16 +211,62 @@ namespace diff_drive_controller
   {
     velocity_rolling_window_size_ = velocity_rolling_window_size;
 
-    resetAccumulators();
+    // Preallocate the rolling windows, so that resetting them from the control loop does not allocate
+    linear_acc_.resize(velocity_rolling_window_size_);
+    angular_acc_.resize(velocity_rolling_window_size_);
+  }
+
+  void Odometry::setIntegrationMethod(IntegrationMethod integration_method)
+  {
+    integration_method_ = integration_method;
+  }
+
+  void Odometry::setCovarianceParams(double left_wheel_slip, double right_wheel_slip)
+  {
+    propagate_covariance_ = true;
+    left_wheel_slip_  = left_wheel_slip;
+    right_wheel_slip_ = right_wheel_slip;
+  }
+
+  void Odometry::setYawRateFusionTimeConstant(double time_constant)
+  {
+    yaw_rate_fusion_time_constant_ = time_constant;
+  }
+
+  void Odometry::integrate(double linear, double angular)
+  {
+    switch (integration_method_)
+    {
+      case RUNGE_KUTTA_2:
+        integrateRungeKutta2(linear, angular);
+        break;
+      case ZERO_ORDER_HOLD:
+        integrateZeroOrderHold(linear, angular);
+        break;
+      case EXACT:
+      default:
+        integrateExact(linear, angular);
+        break;
+    }
   }
 
   void Odometry::integrateRungeKutta2(double linear, double angular)
   {
     const double direction = heading_ + angular * 0.5;
+    const double cos_direction = cos(direction);
+    const double sin_direction = sin(direction);
+
+    if (propagate_covariance_)
+    {
+      const double jacobian_heading[2] = { -linear * sin_direction, linear * cos_direction };
+      const double jacobian_displacement[2][2] = { { cos_direction, -0.5 * linear * sin_direction },
+                                                   { sin_direction,  0.5 * linear * cos_direction } };
+      propagateCovariance(linear, angular, jacobian_heading, jacobian_displacement);
+    }
 
     /// Runge-Kutta 2nd order integration:
-    x_       += linear * cos(direction);
-    y_       += linear * sin(direction);
+    x_       += linear * cos_direction;
+    y_       += linear * sin_direction;
     heading_ += angular;
   }
 
@@ -162,15 +285,99 @@ namespace diff_drive_controller
       const double heading_old = heading_;
       const double r = linear/angular;
       heading_ += angular;
-      x_       +=  r * (sin(heading_) - sin(heading_old));
-      y_       += -r * (cos(heading_) - cos(heading_old));
+      const double sin_heading = sin(heading_);
+      const double cos_heading = cos(heading_);
+      const double sin_diff = sin_heading - sin(heading_old);
+      const double cos_diff = cos_heading - cos(heading_old);
+
+      if (propagate_covariance_)
+      {
+        const double jacobian_heading[2] = { r * cos_diff, r * sin_diff };
+        const double jacobian_displacement[2][2] = { {  sin_diff / angular, r * (cos_heading - sin_diff / angular) },
+                                                     { -cos_diff / angular, r * (sin_heading + cos_diff / angular) } };
+        propagateCovariance(linear, angular, jacobian_heading, jacobian_displacement);
+      }
+
+      x_       +=  r * sin_diff;
+      y_       += -r * cos_diff;
+    }
+  }
+
+  void Odometry::integrateZeroOrderHold(double linear, double angular)
+  {
+    const double half_angular = 0.5 * angular;
+    const double direction = heading_ + half_angular;
+    const double cos_direction = cos(direction);
+    const double sin_direction = sin(direction);
+    const double chord_ratio = sinc(half_angular);
+    const double chord = linear * chord_ratio;
+
+    if (propagate_covariance_)
+    {
+      // Derivative of the chord wrt the angular displacement, through the chord ratio
+      const double linear_derivative = 0.5 * linear * sincDerivative(half_angular);
+      const double jacobian_heading[2] = { -chord * sin_direction, chord * cos_direction };
+      const double jacobian_displacement[2][2] =
+          { { chord_ratio * cos_direction, linear_derivative * cos_direction - 0.5 * chord * sin_direction },
+            { chord_ratio * sin_direction, linear_derivative * sin_direction + 0.5 * chord * cos_direction } };
+      propagateCovariance(linear, angular, jacobian_heading, jacobian_displacement);
+    }
+
+    /// Zero-order hold integration, i.e. exact for constant velocities over the interval:
+    x_       += chord * cos_direction;
+    y_       += chord * sin_direction;
+    heading_ += angular;
+  }
+
+  void Odometry::propagateCovariance(double linear, double angular,
+                                     const double (&jacobian_heading)[2], const double (&jacobian_displacement)[2][2])
+  {
+    double (&p)[3][3] = pose_covariance_;
+
+    /// Previous pose uncertainty, P = F P F^T, with F the identity but for x and y wrt the heading:
+    for (int j = 0; j < 3; ++j)
+    {
+      p[0][j] += jacobian_heading[0] * p[2][j];
+      p[1][j] += jacobian_heading[1] * p[2][j];
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      p[i][0] += p[i][2] * jacobian_heading[0];
+      p[i][1] += p[i][2] * jacobian_heading[1];
+    }
+
+    /// Wheel displacement variances, proportional to the distance each wheel travelled:
+    const double half_separation = 0.5 * wheel_separation_;
+    const double left_variance  = left_wheel_slip_  * fabs(linear - angular * half_separation);
+    const double right_variance = right_wheel_slip_ * fabs(linear + angular * half_separation);
+
+    /// Jacobians wrt each wheel displacement, from linear = (left + right) / 2 and angular = (right - left) / separation:
+    const double inverse_separation = 1.0 / wheel_separation_;
+    double jacobian_left[3];
+    double jacobian_right[3];
+    for (int i = 0; i < 2; ++i)
+    {
+      jacobian_left[i]  = 0.5 * jacobian_displacement[i][0] - inverse_separation * jacobian_displacement[i][1];
+      jacobian_right[i] = 0.5 * jacobian_displacement[i][0] + inverse_separation * jacobian_displacement[i][1];
+    }
+    jacobian_left[2]  = -inverse_separation;
+    jacobian_right[2] =  inverse_separation;
+
+    /// Wheel displacement uncertainty, P += G Q G^T, with Q diagonal:
+    for (int i = 0; i < 3; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        p[i][j] += left_variance  * jacobian_left[i]  * jacobian_left[j] +
+                   right_variance * jacobian_right[i] * jacobian_right[j];
+      }
     }
   }
 
   void Odometry::resetAccumulators()
   {
-    linear_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
-    angular_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
+    linear_acc_.reset();
+    angular_acc_.reset();
   }
 
 } // namespace diff_drive_controller
@@ -0,0 +1,226 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+
+#include <diff_drive_controller/odometry_publisher.h>
+
+namespace diff_drive_controller
+{
+  namespace
+  {
+    /// Linear interpolation of two odometry samples at time \p stamp, with start.stamp < stamp <= end.stamp:
+    OdometrySample interpolateSample(const OdometrySample& start, const OdometrySample& end, const ros::Time& stamp)
+    {
+      const double alpha = (stamp - start.stamp).toSec() / (end.stamp - start.stamp).toSec();
+
+      OdometrySample sample;
+      sample.stamp   = stamp;
+      sample.x       = start.x       + alpha * (end.x       - start.x);
+      sample.y       = start.y       + alpha * (end.y       - start.y);
+      sample.heading = start.heading + alpha * (end.heading - start.heading); // Heading is not wrapped
+      sample.linear  = start.linear  + alpha * (end.linear  - start.linear);
+      sample.linear_y = start.linear_y + alpha * (end.linear_y - start.linear_y);
+      sample.angular = start.angular + alpha * (end.angular - start.angular);
+      sample.has_pose_covariance = end.has_pose_covariance;
+      for (int i = 0; i < 9; ++i)
+      {
+        sample.pose_covariance[i] = start.pose_covariance[i] + alpha * (end.pose_covariance[i] - start.pose_covariance[i]);
+      }
+      return sample;
+    }
+  }
+
+  void setPoseCovariance(const OdometrySample& sample, nav_msgs::Odometry& odom)
+  {
+    if (!sample.has_pose_covariance)
+    {
+      return;
+    }
+
+    // Indices of x, y and yaw in the 6x6 pose covariance:
+    static const int pose_index[3] = { 0, 1, 5 };
+    for (int i = 0; i < 3; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        odom.pose.covariance[6 * pose_index[i] + pose_index[j]] = sample.pose_covariance[3 * i + j];
+      }
+    }
+  }
+
+  void setOdometry(const OdometrySample& sample, const geometry_msgs::Quaternion& orientation,
+                   nav_msgs::Odometry& odom)
+  {
+    odom.header.stamp = sample.stamp;
+    odom.pose.pose.position.x = sample.x;
+    odom.pose.pose.position.y = sample.y;
+    odom.pose.pose.orientation = orientation;
+    odom.twist.twist.linear.x  = sample.linear;
+    odom.twist.twist.linear.y  = sample.linear_y;
+    odom.twist.twist.angular.z = sample.angular;
+    setPoseCovariance(sample, odom);
+  }
+
+  void setOdometryTransform(const OdometrySample& sample, const geometry_msgs::Quaternion& orientation,
+                            geometry_msgs::Transform& transform)
+  {
+    transform.translation.x = sample.x;
+    transform.translation.y = sample.y;
+    transform.rotation = orientation;
+  }
+
+  OdometryPublisher::OdometryPublisher()
+  : dropped_samples_(0)
+  , publish_period_(0.0)
+  , publish_tf_(true)
+  , interpolate_(false)
+  , has_last_sample_(false)
+  , keep_running_(false)
+  {
+  }
+
+  OdometryPublisher::~OdometryPublisher()
+  {
+    stop();
+  }
+
+  void OdometryPublisher::start(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh,
+                                const nav_msgs::Odometry& odom, const geometry_msgs::TransformStamped& odom_frame,
+                                const ros::Duration& publish_period, bool interpolate, std::size_t queue_size)
+  {
+    stop();
+
+    odom_pub_ = controller_nh.advertise<nav_msgs::Odometry>("odom", 100);
+    tf_pub_   = root_nh.advertise<tf2_msgs::TFMessage>("/tf", 100);
+    odom_ = odom;
+    tf_odom_.transforms.assign(1, odom_frame);
+
+    queue_.reset(queue_size);
+    dropped_samples_.store(0);
+    setPublishPeriod(publish_period);
+    interpolate_ = interpolate;
+    has_last_sample_ = false;
+
+    keep_running_.store(true);
+    thread_ = std::thread(&OdometryPublisher::run, this);
+  }
+
+  void OdometryPublisher::stop()
+  {
+    keep_running_.store(false);
+    if (thread_.joinable())
+    {
+      thread_.join();
+    }
+  }
+
+  bool OdometryPublisher::push(const OdometrySample& sample)
+  {
+    if (queue_.push(sample))
+    {
+      return true;
+    }
+    dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  void OdometryPublisher::run()
+  {
+    std::size_t reported_dropped_samples = 0;
+    while (keep_running_.load())
+    {
+      const double publish_period = publish_period_.load(std::memory_order_relaxed);
+
+      OdometrySample sample;
+      while (queue_.pop(sample))
+      {
+        if (!interpolate_)
+        {
+          publish(sample);
+          continue;
+        }
+
+        if (!has_last_sample_ || sample.stamp < last_sample_.stamp ||
+            (sample.stamp - last_sample_.stamp).toSec() > publish_period)
+        {
+          // (Re)start the publish schedule at this sample
+          publish(sample);
+          next_publish_time_ = sample.stamp + ros::Duration(publish_period);
+        }
+        else
+        {
+          // Publish at every publish time up to this sample, interpolating from the previous one
+          while (next_publish_time_ <= sample.stamp)
+          {
+            publish(interpolateSample(last_sample_, sample, next_publish_time_));
+            next_publish_time_ += ros::Duration(publish_period);
+          }
+        }
+        last_sample_ = sample;
+        has_last_sample_ = true;
+      }
+
+      const std::size_t dropped_samples = dropped_samples_.load(std::memory_order_relaxed);
+      if (dropped_samples != reported_dropped_samples)
+      {
+        ROS_WARN_STREAM_THROTTLE(1.0, "Odometry queue full: " << dropped_samples - reported_dropped_samples
+                                 << " samples dropped.");
+        reported_dropped_samples = dropped_samples;
+      }
+
+      // Poll several times per publish period, so that publication latency stays a fraction of it
+      const double poll_period = std::min(std::max(0.25 * publish_period, 0.001), 0.01);
+      std::this_thread::sleep_for(std::chrono::duration<double>(poll_period));
+    }
+  }
+
+  void OdometryPublisher::publish(const OdometrySample& sample)
+  {
+    const geometry_msgs::Quaternion orientation(quaternionFromYaw(sample.heading));
+
+    setOdometry(sample, orientation, odom_);
+    odom_pub_.publish(odom_);
+
+    if (publish_tf_.load(std::memory_order_relaxed))
+    {
+      geometry_msgs::TransformStamped& odom_frame = tf_odom_.transforms[0];
+      odom_frame.header.stamp = sample.stamp;
+      setOdometryTransform(sample, orientation, odom_frame.transform);
+      tf_pub_.publish(tf_odom_);
+    }
+  }
+
+} // namespace diff_drive_controller
@@ -37,6 +37,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 
 #include <diff_drive_controller/speed_limiter.h>
 
@@ -48,6 +49,31 @@ T clamp(T x, T min, T max)
 
 namespace diff_drive_controller
 {
+  namespace
+  {
+    const double INF = std::numeric_limits<double>::infinity();
+
+    /**
+     * \brief Closed-form jerk, acceleration and velocity limits of one axis: each limit is a clamp of the velocity, with
+     * infinite bounds selected for disabled limits instead of branching around the clamp.
+     */
+    inline double limitAxis(const SpeedLimiter& limiter, double v, double v0, double v1, double dt)
+    {
+      // Jerk: v0 + dv0 + clamp(v - v0 - dv0, da_min, da_max)
+      const double v_jerk = 2.0 * v0 - v1;
+      const double dt2 = 2. * dt * dt;
+      v = clamp(v, limiter.has_jerk_limits ? v_jerk + limiter.min_jerk * dt2 : -INF,
+                   limiter.has_jerk_limits ? v_jerk + limiter.max_jerk * dt2 :  INF);
+
+      // Acceleration: v0 + clamp(v - v0, dv_min, dv_max)
+      v = clamp(v, limiter.has_acceleration_limits ? v0 + limiter.min_acceleration * dt : -INF,
+                   limiter.has_acceleration_limits ? v0 + limiter.max_acceleration * dt :  INF);
+
+      // Velocity
+      return clamp(v, limiter.has_velocity_limits ? limiter.min_velocity : -INF,
+                      limiter.has_velocity_limits ? limiter.max_velocity :  INF);
+    }
+  }
 
   SpeedLimiter::SpeedLimiter(
     bool has_velocity_limits,
@@ -76,9 +102,7 @@ namespace diff_drive_controller
   {
     const double tmp = v;
 
-    limit_jerk(v, v0, v1, dt);
-    limit_acceleration(v, v0, dt);
-    limit_velocity(v);
+    v = limitAxis(*this, v, v0, v1, dt);
 
     return tmp != 0.0 ? v / tmp : 1.0;
   }
@@ -134,4 +158,38 @@ namespace diff_drive_controller
     return tmp != 0.0 ? v / tmp : 1.0;
   }
 
+  TwistLimiter::TwistLimiter()
+  {
+    for (int i = 0; i < AXES; ++i)
+    {
+      setAxisLimits(static_cast<Axis>(i), SpeedLimiter());
+    }
+  }
+
+  void TwistLimiter::setAxisLimits(Axis axis, const SpeedLimiter& limits)
+  {
+    min_velocity_[axis]     = limits.has_velocity_limits     ? limits.min_velocity     : -INF;
+    max_velocity_[axis]     = limits.has_velocity_limits     ? limits.max_velocity     :  INF;
+    min_acceleration_[axis] = limits.has_acceleration_limits ? limits.min_acceleration : -INF;
+    max_acceleration_[axis] = limits.has_acceleration_limits ? limits.max_acceleration :  INF;
+    min_jerk_[axis]         = limits.has_jerk_limits         ? limits.min_jerk         : -INF;
+    max_jerk_[axis]         = limits.has_jerk_limits         ? limits.max_jerk         :  INF;
+  }
+
+  void TwistLimiter::limit(Twist& v, const Twist& v0, const Twist& v1, double dt) const
+  {
+    // Infinite limits must not be multiplied by a zero time step. With the smallest positive time step instead, finite
+    // limits still leave no room for velocity changes, as with a zero time step.
+    const double dt_limits = std::max(dt, std::numeric_limits<double>::min());
+    const double dt2 = std::max(2. * dt * dt, std::numeric_limits<double>::min());
+    for (int i = 0; i < AXES; ++i)
+    {
+      // Same closed form as limitAxis()
+      const double v_jerk = 2.0 * v0[i] - v1[i];
+      double vi = clamp(v[i], v_jerk + min_jerk_[i] * dt2, v_jerk + max_jerk_[i] * dt2);
+      vi = clamp(vi, v0[i] + min_acceleration_[i] * dt_limits, v0[i] + max_acceleration_[i] * dt_limits);
+      v[i] = clamp(vi, min_velocity_[i], max_velocity_[i]);
+    }
+  }
+
 } // namespace diff_drive_controller
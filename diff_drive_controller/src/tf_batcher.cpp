@@ -0,0 +1,159 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <controller_instrumentation/tracepoints.h>
+#include <diff_drive_controller/tf_batcher.h>
+
+namespace diff_drive_controller
+{
+
+  std::shared_ptr<TfBatcher> TfBatcher::get(ros::NodeHandle& root_nh)
+  {
+    static std::mutex instance_mutex;
+    static std::weak_ptr<TfBatcher> instance;
+
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    std::shared_ptr<TfBatcher> batcher = instance.lock();
+    if (!batcher)
+    {
+      batcher = std::make_shared<TfBatcher>(root_nh);
+      instance = batcher;
+    }
+    return batcher;
+  }
+
+  TfBatcher::TfBatcher(ros::NodeHandle& root_nh)
+  : active_count_(0)
+  , fresh_count_(0)
+  , tf_pub_(root_nh, "/tf", 100)
+  {
+  }
+
+  std::size_t TfBatcher::addFrame(const geometry_msgs::TransformStamped& frame)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frames_.push_back(Frame());
+    frames_.back().transform = frame;
+    frames_.back().active = false;
+    frames_.back().fresh = false;
+
+    // Preallocate the message, so that publishing from the control loop does not allocate
+    tf_pub_.lock();
+    tf_pub_.msg_.transforms.reserve(frames_.size());
+    tf_pub_.unlock();
+
+    return frames_.size() - 1;
+  }
+
+  void TfBatcher::activateFrame(std::size_t index)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Frame& frame = frames_[index];
+    if (frame.active)
+    {
+      return;
+    }
+    frame.active = true;
+    ++active_count_;
+  }
+
+  void TfBatcher::deactivateFrame(std::size_t index)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Frame& frame = frames_[index];
+    if (!frame.active)
+    {
+      return;
+    }
+    frame.active = false;
+    --active_count_;
+    if (frame.fresh)
+    {
+      frame.fresh = false;
+      --fresh_count_;
+    }
+  }
+
+  bool TfBatcher::setTransform(std::size_t index, const ros::Time& stamp, const geometry_msgs::Transform& transform)
+  {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+      return false;
+    }
+
+    // A second transform before the other frames got theirs: publish without waiting for them anymore
+    Frame& frame = frames_[index];
+    if (frame.fresh)
+    {
+      publish();
+    }
+
+    frame.transform.header.stamp = stamp;
+    frame.transform.transform = transform;
+    frame.fresh = true;
+    ++fresh_count_;
+
+    if (fresh_count_ == active_count_)
+    {
+      publish();
+    }
+    return true;
+  }
+
+  void TfBatcher::publish()
+  {
+    if (controller_instrumentation::tracedTrylock(tf_pub_, "/tf"))
+    {
+      // Within the reserved capacity; frame ids are usually short enough not to allocate either
+      tf_pub_.msg_.transforms.resize(fresh_count_);
+      std::size_t i = 0;
+      for (const Frame& frame : frames_)
+      {
+        if (frame.fresh)
+        {
+          tf_pub_.msg_.transforms[i++] = frame.transform;
+        }
+      }
+      tf_pub_.unlockAndPublish();
+    }
+
+    for (Frame& frame : frames_)
+    {
+      frame.fresh = false;
+    }
+    fresh_count_ = 0;
+  }
+
+} // namespace diff_drive_controller
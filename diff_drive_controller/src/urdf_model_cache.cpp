@@ -0,0 +1,116 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include <diff_drive_controller/urdf_model_cache.h>
+#include <urdf_parser/urdf_parser.h>
+
+namespace diff_drive_controller
+{
+
+  namespace
+  {
+    struct CacheEntry
+    {
+      size_t hash;
+      std::string robot_description;
+      urdf::ModelInterfaceConstSharedPtr model;
+    };
+
+    /// Cached models, most recently used first:
+    std::mutex cache_mutex;
+    std::list<CacheEntry> cache;
+
+    /// Find a cached model and mark it as most recently used. Must be called with cache_mutex held:
+    urdf::ModelInterfaceConstSharedPtr findCached(size_t hash, const std::string& robot_description)
+    {
+      for (std::list<CacheEntry>::iterator it = cache.begin(); it != cache.end(); ++it)
+      {
+        if (it->hash == hash && it->robot_description == robot_description)
+        {
+          cache.splice(cache.begin(), cache, it);
+          return it->model;
+        }
+      }
+      return urdf::ModelInterfaceConstSharedPtr();
+    }
+  }
+
+  const size_t UrdfModelCache::CAPACITY;
+
+  urdf::ModelInterfaceConstSharedPtr UrdfModelCache::get(const std::string& robot_description)
+  {
+    const size_t hash = std::hash<std::string>()(robot_description);
+
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex);
+      const urdf::ModelInterfaceConstSharedPtr cached = findCached(hash, robot_description);
+      if (cached)
+      {
+        return cached;
+      }
+    }
+
+    // Parse without holding the lock, so that other controllers looking up a cached model don't wait:
+    urdf::ModelInterfaceConstSharedPtr model(urdf::parseURDF(robot_description));
+    if (!model)
+    {
+      return model;
+    }
+
+    // Another thread may have cached the same description meanwhile:
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    const urdf::ModelInterfaceConstSharedPtr cached = findCached(hash, robot_description);
+    if (cached)
+    {
+      return cached;
+    }
+    cache.push_front(CacheEntry{hash, robot_description, model});
+    if (cache.size() > CAPACITY)
+    {
+      cache.pop_back();
+    }
+    return model;
+  }
+
+  void UrdfModelCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.clear();
+  }
+
+} // namespace diff_drive_controller
@@ -0,0 +1,161 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <diff_drive_controller/wheel_group.h>
+
+namespace diff_drive_controller
+{
+  namespace
+  {
+    /// Whether the pointers in \p pointers refer to consecutive elements of one array:
+    template <class T>
+    bool isContiguous(const std::vector<T*>& pointers)
+    {
+      for (size_t i = 1; i < pointers.size(); ++i)
+      {
+        if (pointers[i] != pointers[0] + i)
+          return false;
+      }
+      return !pointers.empty();
+    }
+  }
+
+  WheelGroup::WheelGroup()
+  : contiguous_positions_(false)
+  , contiguous_commands_(false)
+  , position_(0.0)
+  , has_position_(false)
+  , faulty_count_(0)
+  {
+  }
+
+  bool WheelGroup::init(std::vector<hardware_interface::JointHandle>& wheel_joints, const std::vector<double>& weights)
+  {
+    if (!weights.empty() && weights.size() != wheel_joints.size())
+      return false;
+
+    weights_ = weights.empty() ? std::vector<double>(wheel_joints.size(), 1.0) : weights;
+    double weight_sum = 0.0;
+    for (size_t i = 0; i < weights_.size(); ++i)
+    {
+      if (!(weights_[i] >= 0.0))
+        return false;
+      weight_sum += weights_[i];
+    }
+    if (!(weight_sum > 0.0))
+      return false;
+
+    positions_.resize(wheel_joints.size());
+    commands_.resize(wheel_joints.size());
+    for (size_t i = 0; i < wheel_joints.size(); ++i)
+    {
+      positions_[i] = wheel_joints[i].getPositionPtr();
+      commands_[i]  = wheel_joints[i].getCommandPtr();
+    }
+    contiguous_positions_ = isContiguous(positions_);
+    contiguous_commands_  = isContiguous(commands_);
+
+    current_positions_.resize(wheel_joints.size());
+    previous_positions_.resize(wheel_joints.size());
+    has_position_ = false;
+    faulty_count_ = 0;
+    return true;
+  }
+
+  bool WheelGroup::readPosition(double& position, bool drop_faulty)
+  {
+    if (contiguous_positions_)
+    {
+      std::copy(positions_.front(), positions_.front() + positions_.size(), current_positions_.begin());
+    }
+    else
+    {
+      for (size_t i = 0; i < positions_.size(); ++i)
+        current_positions_[i] = *positions_[i];
+    }
+
+    // Weighted average of the valid positions, or of the valid increments since the previous reading
+    double sum = 0.0;
+    double weight_sum = 0.0;
+    faulty_count_ = 0;
+    for (size_t i = 0; i < current_positions_.size(); ++i)
+    {
+      const double current = current_positions_[i];
+      if (std::isnan(current))
+      {
+        ++faulty_count_;
+        continue;
+      }
+      if (!has_position_)
+      {
+        sum += weights_[i] * current;
+        weight_sum += weights_[i];
+      }
+      else if (!std::isnan(previous_positions_[i]))
+      {
+        sum += weights_[i] * (current - previous_positions_[i]);
+        weight_sum += weights_[i];
+      }
+    }
+
+    if (faulty_count_ > 0 && !drop_faulty)
+      return false;
+
+    previous_positions_.swap(current_positions_);
+    if (!(weight_sum > 0.0))
+      return false;
+
+    position_ = has_position_ ? position_ + sum / weight_sum : sum / weight_sum;
+    has_position_ = true;
+    position = position_;
+    return true;
+  }
+
+  void WheelGroup::setCommand(double command)
+  {
+    if (contiguous_commands_)
+    {
+      std::fill(commands_.front(), commands_.front() + commands_.size(), command);
+    }
+    else
+    {
+      for (size_t i = 0; i < commands_.size(); ++i)
+        *commands_[i] = command;
+    }
+  }
+
+} // namespace diff_drive_controller
@@ -0,0 +1,163 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <chrono>
+#include <limits>
+#include <utility>
+
+#include <diff_drive_controller/wheel_state_publisher.h>
+
+namespace diff_drive_controller
+{
+  namespace
+  {
+    void resizeState(std::size_t size, trajectory_msgs::JointTrajectoryPoint& state)
+    {
+      state.positions.resize(size);
+      state.velocities.resize(size);
+      state.accelerations.resize(size);
+      state.effort.resize(size);
+    }
+  }
+
+  void fillWheelState(const WheelStateSample* previous, const WheelStateSample& sample,
+                      control_msgs::JointTrajectoryControllerState& msg)
+  {
+    const double dt = previous ? (sample.stamp - previous->stamp).toSec() : 0.0;
+    const bool has_acceleration = dt > 0.0;
+
+    msg.header.stamp = sample.stamp;
+    for (std::size_t i = 0; i < sample.position.size(); ++i)
+    {
+      // Actual
+      msg.actual.positions[i]     = sample.position[i];
+      msg.actual.velocities[i]    = sample.velocity[i];
+      msg.actual.accelerations[i] = has_acceleration ? (sample.velocity[i] - previous->velocity[i]) / dt : 0.0;
+      msg.actual.effort[i]        = sample.effort[i];
+
+      // Desired
+      msg.desired.positions[i]     = sample.desired_position[i];
+      msg.desired.velocities[i]    = sample.desired_velocity[i];
+      msg.desired.accelerations[i] = has_acceleration ?
+                                     (sample.desired_velocity[i] - previous->desired_velocity[i]) / dt : 0.0;
+      msg.desired.effort[i]        = std::numeric_limits<double>::quiet_NaN();
+
+      // Error
+      msg.error.positions[i]     = msg.desired.positions[i]     - msg.actual.positions[i];
+      msg.error.velocities[i]    = msg.desired.velocities[i]    - msg.actual.velocities[i];
+      msg.error.accelerations[i] = msg.desired.accelerations[i] - msg.actual.accelerations[i];
+      msg.error.effort[i]        = msg.desired.effort[i]        - msg.actual.effort[i];
+    }
+  }
+
+  WheelStatePublisher::WheelStatePublisher()
+  : dropped_samples_(0)
+  , has_last_sample_(false)
+  , keep_running_(false)
+  {
+  }
+
+  WheelStatePublisher::~WheelStatePublisher()
+  {
+    stop();
+  }
+
+  void WheelStatePublisher::start(ros::NodeHandle& controller_nh, const std::vector<std::string>& joint_names,
+                                  std::size_t queue_size)
+  {
+    stop();
+
+    pub_ = controller_nh.advertise<control_msgs::JointTrajectoryControllerState>("wheel_joint_controller_state", 100);
+    msg_.joint_names = joint_names;
+    resizeState(joint_names.size(), msg_.desired);
+    resizeState(joint_names.size(), msg_.actual);
+    resizeState(joint_names.size(), msg_.error);
+
+    queue_.reset(queue_size, WheelStateSample(joint_names.size()));
+    dropped_samples_.store(0);
+    last_sample_ = WheelStateSample(joint_names.size());
+    has_last_sample_ = false;
+
+    keep_running_.store(true);
+    thread_ = std::thread(&WheelStatePublisher::run, this);
+  }
+
+  void WheelStatePublisher::stop()
+  {
+    keep_running_.store(false);
+    if (thread_.joinable())
+    {
+      thread_.join();
+    }
+  }
+
+  WheelStateSample* WheelStatePublisher::beginPush()
+  {
+    WheelStateSample* const sample = queue_.beginPush();
+    if (!sample)
+    {
+      dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return sample;
+  }
+
+  void WheelStatePublisher::run()
+  {
+    std::size_t reported_dropped_samples = 0;
+    WheelStateSample sample(msg_.joint_names.size());
+    while (keep_running_.load())
+    {
+      while (queue_.pop(sample))
+      {
+        const bool continued = has_last_sample_ && !sample.restart && last_sample_.stamp < sample.stamp;
+        fillWheelState(continued ? &last_sample_ : nullptr, sample, msg_);
+        pub_.publish(msg_);
+
+        std::swap(last_sample_, sample);
+        has_last_sample_ = true;
+      }
+
+      const std::size_t dropped_samples = dropped_samples_.load(std::memory_order_relaxed);
+      if (dropped_samples != reported_dropped_samples)
+      {
+        ROS_WARN_STREAM_THROTTLE(1.0, "Wheel state queue full: " << dropped_samples - reported_dropped_samples
+                                 << " samples dropped.");
+        reported_dropped_samples = dropped_samples;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+} // namespace diff_drive_controller
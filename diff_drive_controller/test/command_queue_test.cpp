@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/command_queue.h>
+
+using diff_drive_controller::CommandQueue;
+using diff_drive_controller::TimedCommand;
+
+TEST(CommandQueueTest, Empty)
+{
+  CommandQueue queue;
+  TimedCommand command;
+  EXPECT_FALSE(queue.sample(ros::Time(1.0), command));
+}
+
+TEST(CommandQueueTest, AppliedAtStamp)
+{
+  CommandQueue queue;
+  queue.push(TimedCommand(1.0, 0.5, ros::Time(10.0)), ros::Time(9.0));
+  queue.push(TimedCommand(2.0, 1.0, ros::Time(11.0)), ros::Time(9.0));
+
+  TimedCommand command;
+  EXPECT_FALSE(queue.sample(ros::Time(9.5), command));
+
+  ASSERT_TRUE(queue.sample(ros::Time(10.5), command));
+  EXPECT_DOUBLE_EQ(1.0, command.lin);
+  EXPECT_DOUBLE_EQ(0.5, command.ang);
+  EXPECT_EQ(ros::Time(10.0), command.stamp);
+
+  ASSERT_TRUE(queue.sample(ros::Time(12.0), command));
+  EXPECT_DOUBLE_EQ(2.0, command.lin);
+  EXPECT_EQ(ros::Time(11.0), command.stamp);
+}
+
+TEST(CommandQueueTest, OutOfOrder)
+{
+  CommandQueue queue;
+  queue.push(TimedCommand(2.0, 0.0, ros::Time(11.0)), ros::Time(10.0));
+  queue.push(TimedCommand(1.0, 0.0, ros::Time(10.0)), ros::Time(10.0));
+
+  TimedCommand command;
+  ASSERT_TRUE(queue.sample(ros::Time(10.5), command));
+  EXPECT_DOUBLE_EQ(1.0, command.lin);
+  ASSERT_TRUE(queue.sample(ros::Time(11.5), command));
+  EXPECT_DOUBLE_EQ(2.0, command.lin);
+}
+
+TEST(CommandQueueTest, DropsSupersededCommands)
+{
+  CommandQueue queue;
+  queue.setCapacity(3);
+  for (int i = 0; i < 10; ++i)
+  {
+    queue.push(TimedCommand(i, 0.0, ros::Time(10.0 + i)), ros::Time(10.0 + i));
+  }
+  // The command in effect and the newest one:
+  EXPECT_EQ(2u, queue.size());
+
+  // Future commands fill the queue up to its capacity, dropping the oldest ones:
+  for (int i = 10; i < 20; ++i)
+  {
+    queue.push(TimedCommand(i, 0.0, ros::Time(10.0 + i)), ros::Time(19.0));
+  }
+  EXPECT_EQ(3u, queue.size());
+  TimedCommand command;
+  ASSERT_TRUE(queue.sample(ros::Time(100.0), command));
+  EXPECT_DOUBLE_EQ(19.0, command.lin);
+}
+
+TEST(CommandQueueTest, Extrapolation)
+{
+  CommandQueue queue;
+  queue.setExtrapolationTime(0.2);
+  queue.push(TimedCommand(1.0, -1.0, ros::Time(10.0)), ros::Time(10.0));
+  queue.push(TimedCommand(1.1, -0.9, ros::Time(10.1)), ros::Time(10.1));
+
+  TimedCommand command;
+  ASSERT_TRUE(queue.sample(ros::Time(10.2), command));
+  EXPECT_NEAR(1.2, command.lin, 1e-9);
+  EXPECT_NEAR(-0.8, command.ang, 1e-9);
+  EXPECT_EQ(ros::Time(10.1), command.stamp);
+
+  // Held past the extrapolation time:
+  ASSERT_TRUE(queue.sample(ros::Time(11.0), command));
+  EXPECT_NEAR(1.3, command.lin, 1e-9);
+
+  // Never across zero:
+  queue.setExtrapolationTime(10.0);
+  ASSERT_TRUE(queue.sample(ros::Time(12.0), command));
+  EXPECT_NEAR(3.0, command.lin, 1e-9);
+  EXPECT_DOUBLE_EQ(0.0, command.ang);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
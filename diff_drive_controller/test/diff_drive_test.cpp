@@ -29,6 +29,7 @@
 
 #include "test_common.h"
 #include <tf/transform_listener.h>
+#include <controller_instrumentation/realtime_audit_listener.h>
 
 // TEST CASES
 TEST_F(DiffDriveControllerTest, testForward)
@@ -139,6 +140,31 @@ TEST_F(DiffDriveControllerTest, testOdomFrame)
   EXPECT_TRUE(listener.frameExists("odom"));
 }
 
+#ifdef CONTROLLER_INSTRUMENTATION_RT_AUDIT
+TEST_F(DiffDriveControllerTest, testRealtimeAudit)
+{
+  controller_instrumentation::RealtimeAuditListener audit(nh, "diffbot_controller");
+
+  // wait for ROS
+  waitForController();
+
+  // drive for a while
+  geometry_msgs::Twist cmd_vel;
+  cmd_vel.linear.x = 0.1;
+  cmd_vel.angular.z = 0.1;
+  publish(cmd_vel);
+  ros::Duration(2.0 * controller_instrumentation::RealtimeAudit::PUBLISH_PERIOD).sleep();
+
+  // check that update() performed no realtime-unsafe operations
+  ASSERT_TRUE(audit.received());
+  EXPECT_GT(audit.cycles(), 0u);
+  const controller_instrumentation::RealtimeAuditCounts totals = audit.totals();
+  EXPECT_EQ(0u, totals.allocations);
+  EXPECT_EQ(0u, totals.deallocations);
+  EXPECT_EQ(0u, totals.mutex_locks);
+}
+#endif
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/odometry.h>
+
+using diff_drive_controller::Odometry;
+
+namespace
+{
+
+const double SEPARATION = 0.5;
+const double RADIUS = 0.1;
+const double SLIP = 0.02;
+
+/** Wheel displacements of one update [m]. */
+struct Step
+{
+  double left;
+  double right;
+};
+
+/** Odometry with the pose covariance enabled, after the updates with the wheel displacements of \p steps. */
+void integrate(Odometry& odom, Odometry::IntegrationMethod method, const std::vector<Step>& steps)
+{
+  odom.setWheelParams(SEPARATION, RADIUS, RADIUS);
+  odom.setIntegrationMethod(method);
+  odom.setCovarianceParams(SLIP, SLIP);
+  odom.init(ros::Time(0.0));
+
+  double left = 0.0, right = 0.0;
+  for (size_t i = 0; i < steps.size(); ++i)
+  {
+    left  += steps[i].left  / RADIUS;
+    right += steps[i].right / RADIUS;
+    odom.update(left, right, ros::Time(0.01 * (i + 1)));
+  }
+}
+
+/** Pose (x, y, heading) after the updates with the wheel displacements of \p steps. */
+std::vector<double> pose(Odometry::IntegrationMethod method, const std::vector<Step>& steps)
+{
+  Odometry odom;
+  integrate(odom, method, steps);
+  return {odom.getX(), odom.getY(), odom.getHeading()};
+}
+
+/**
+ * Pose covariance from the finite difference Jacobians of the final pose wrt every wheel displacement, each with a
+ * variance of SLIP times its magnitude, as the linearized propagation should give.
+ */
+void expectNumericCovariance(Odometry::IntegrationMethod method, const std::vector<Step>& steps)
+{
+  Odometry odom;
+  integrate(odom, method, steps);
+
+  const double epsilon = 1e-7;
+  const std::vector<double> nominal = pose(method, steps);
+  double expected[3][3] = {};
+  for (size_t k = 0; k < steps.size(); ++k)
+  {
+    for (int wheel = 0; wheel < 2; ++wheel)
+    {
+      std::vector<Step> perturbed = steps;
+      double& displacement = wheel == 0 ? perturbed[k].left : perturbed[k].right;
+      const double variance = SLIP * std::fabs(displacement);
+      displacement += epsilon;
+
+      const std::vector<double> moved = pose(method, perturbed);
+      for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+          expected[i][j] += variance * (moved[i] - nominal[i]) * (moved[j] - nominal[j]) / (epsilon * epsilon);
+    }
+  }
+
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(expected[i][j], odom.getPoseCovariance(i, j), 1e-6) << "at (" << i << ", " << j << ")";
+}
+
+} // namespace
+
+TEST(OdometryCovarianceTest, DisabledByDefault)
+{
+  Odometry odom;
+  odom.setWheelParams(SEPARATION, RADIUS, RADIUS);
+  odom.init(ros::Time(0.0));
+  odom.update(1.0, 2.0, ros::Time(0.01));
+
+  EXPECT_FALSE(odom.hasPoseCovariance());
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_EQ(0.0, odom.getPoseCovariance(i, j));
+}
+
+TEST(OdometryCovarianceTest, RotationInPlace)
+{
+  // Each wheel travels a quarter turn of the base, in opposite directions
+  const double angle = M_PI_2;
+  const double wheel_distance = 0.5 * SEPARATION * angle;
+  const std::vector<Step> steps(10, Step{-0.1 * wheel_distance, 0.1 * wheel_distance});
+
+  // Runge-Kutta maps a linear displacement error to a chord of the same length, which the exact arc would shorten
+  Odometry odom;
+  integrate(odom, Odometry::RUNGE_KUTTA_2, steps);
+  EXPECT_NEAR(angle, odom.getHeading(), 1e-12);
+
+  // Heading variance is the sum of both wheel variances over the separation squared, and the position variance only
+  // comes from the linear displacement errors, a quarter of that sum, since the heading errors do not move the base
+  EXPECT_NEAR(2.0 * SLIP * wheel_distance / (SEPARATION * SEPARATION), odom.getPoseCovariance(2, 2), 1e-12);
+  EXPECT_NEAR(0.5 * SLIP * wheel_distance, odom.getPoseCovariance(0, 0) + odom.getPoseCovariance(1, 1), 1e-12);
+}
+
+TEST(OdometryCovarianceTest, StraightLine)
+{
+  const double distance = 2.0;
+  const std::vector<Step> steps(100, Step{0.01 * distance, 0.01 * distance});
+
+  Odometry exact, runge_kutta;
+  integrate(exact, Odometry::EXACT, steps);
+  integrate(runge_kutta, Odometry::RUNGE_KUTTA_2, steps);
+
+  // Along track variance is the mean of the wheel variances, halved; cross track grows with the heading variance
+  EXPECT_NEAR(0.5 * SLIP * distance, exact.getPoseCovariance(0, 0), 1e-12);
+  EXPECT_NEAR(2.0 * SLIP * distance / (SEPARATION * SEPARATION), exact.getPoseCovariance(2, 2), 1e-12);
+  EXPECT_GT(exact.getPoseCovariance(1, 1), 0.0);
+  EXPECT_GT(exact.getPoseCovariance(1, 2), 0.0);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      EXPECT_EQ(exact.getPoseCovariance(i, j), exact.getPoseCovariance(j, i));
+      EXPECT_NEAR(runge_kutta.getPoseCovariance(i, j), exact.getPoseCovariance(i, j), 1e-12);
+    }
+  }
+}
+
+TEST(OdometryCovarianceTest, MatchesNumericJacobians)
+{
+  // Turning, reversing and straight steps, so that both the exact and its Runge-Kutta fallback are exercised, and
+  // both the zero-order hold series expansion and closed form
+  const std::vector<Step> steps = {{0.10, 0.20}, {0.15, 0.05}, {-0.10, -0.12}, {0.08, 0.08}, {0.02, -0.03}};
+
+  expectNumericCovariance(Odometry::EXACT, steps);
+  expectNumericCovariance(Odometry::RUNGE_KUTTA_2, steps);
+  expectNumericCovariance(Odometry::ZERO_ORDER_HOLD, steps);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
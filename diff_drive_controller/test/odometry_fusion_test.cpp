@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/odometry.h>
+
+using diff_drive_controller::Odometry;
+
+namespace
+{
+
+const double SEPARATION = 0.5;
+const double RADIUS = 0.1;
+const double PERIOD = 0.001;
+const double TIME_CONSTANT = 0.5;
+
+void initOdometry(Odometry& odom)
+{
+  odom.setWheelParams(SEPARATION, RADIUS, RADIUS);
+  odom.setYawRateFusionTimeConstant(TIME_CONSTANT);
+  odom.init(ros::Time(0.0));
+}
+
+} // namespace
+
+TEST(OdometryFusionTest, ConsistentYawRate)
+{
+  Odometry wheels, fused;
+  initOdometry(wheels);
+  initOdometry(fused);
+
+  // Turning at 0.4 rad/s, with a gyro agreeing with the wheels
+  const double left_speed = 0.9, right_speed = 1.1;
+  const double yaw_rate = (right_speed - left_speed) * RADIUS / SEPARATION;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    const ros::Time time(PERIOD * i);
+    wheels.update(left_speed * PERIOD * i, right_speed * PERIOD * i, time);
+    fused.updateFused(left_speed * PERIOD * i, right_speed * PERIOD * i, yaw_rate, time);
+  }
+
+  EXPECT_NEAR(wheels.getHeading(), fused.getHeading(), 1e-9);
+  EXPECT_NEAR(wheels.getX(), fused.getX(), 1e-9);
+  EXPECT_NEAR(wheels.getY(), fused.getY(), 1e-9);
+  EXPECT_NEAR(yaw_rate, fused.getAngular(), 1e-6);
+}
+
+TEST(OdometryFusionTest, WheelSlip)
+{
+  Odometry odom;
+  initOdometry(odom);
+
+  // Right wheel spinning in place during 50 ms, while the gyro measures no rotation
+  const int cycles = 50;
+  for (int i = 1; i <= cycles; ++i)
+  {
+    odom.updateFused(0.0, 10.0 * PERIOD * i, 0.0, ros::Time(PERIOD * i));
+  }
+  const double wheel_heading = 10.0 * PERIOD * cycles * RADIUS / SEPARATION;
+
+  // The heading only follows the wheels by the fraction of the time constant elapsed
+  EXPECT_GT(odom.getHeading(), 0.0);
+  EXPECT_LT(odom.getHeading(), 0.1 * wheel_heading);
+
+  // Then converges to the wheel heading when the slip is over
+  for (int i = cycles + 1; i <= cycles + 10000; ++i)
+  {
+    odom.updateFused(0.0, 10.0 * PERIOD * cycles, 0.0, ros::Time(PERIOD * i));
+  }
+  EXPECT_NEAR(wheel_heading, odom.getHeading(), 1e-6);
+}
+
+TEST(OdometryFusionTest, GyroBias)
+{
+  Odometry odom;
+  initOdometry(odom);
+
+  // Standing still, with a biased gyro: the heading error settles at the bias integrated over the time constant
+  const double bias = 0.01;
+  for (int i = 1; i <= 20000; ++i)
+  {
+    odom.updateFused(0.0, 0.0, bias, ros::Time(PERIOD * i));
+  }
+  EXPECT_NEAR(bias * TIME_CONSTANT, odom.getHeading(), 1e-5);
+}
+
+TEST(OdometryFusionTest, RestartKeepsHeading)
+{
+  Odometry odom;
+  initOdometry(odom);
+
+  // Heading from the gyro only, during slip
+  for (int i = 1; i <= 100; ++i)
+  {
+    odom.updateFused(0.0, 0.0, 1.0, ros::Time(PERIOD * i));
+  }
+  const double heading = odom.getHeading();
+
+  // Restarting resets the wheel heading to the fused one, so that the fused heading does not move afterwards
+  odom.init(ros::Time(1.0));
+  for (int i = 1; i <= 1000; ++i)
+  {
+    odom.updateFused(0.0, 0.0, 0.0, ros::Time(1.0 + PERIOD * i));
+  }
+  EXPECT_NEAR(heading, odom.getHeading(), 1e-12);
+}
+
+TEST(OdometryFusionTest, NoElapsedTime)
+{
+  Odometry odom;
+  initOdometry(odom);
+  odom.updateFused(0.0, 0.0, 0.0, ros::Time(PERIOD));
+
+  // Wheel motion reported twice in the same cycle only follows the wheels, with no gyro rotation to integrate
+  odom.updateFused(0.0, 10.0 * PERIOD, 1.0, ros::Time(PERIOD));
+  EXPECT_TRUE(std::isfinite(odom.getHeading()));
+  EXPECT_NEAR(10.0 * PERIOD * RADIUS / SEPARATION, odom.getHeading(), 1e-12);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/odometry.h>
+
+using diff_drive_controller::Odometry;
+
+namespace
+{
+
+const double SEPARATION = 0.5;
+const double RADIUS = 0.1;
+
+void initOdometry(Odometry& odom, Odometry::IntegrationMethod method)
+{
+  odom.setWheelParams(SEPARATION, RADIUS, RADIUS);
+  odom.setIntegrationMethod(method);
+  odom.init(ros::Time(0.0));
+}
+
+/** Pose after one open loop step from the origin, along an arc of \p linear length turning by \p angular. */
+void integrateStep(Odometry& odom, double linear, double angular)
+{
+  odom.updateOpenLoop(linear, angular, ros::Time(1.0), ros::Duration(1.0));
+}
+
+/** Relative errors of the pose after integrateStep, wrt the arc in closed form at extended precision. */
+void expectArc(const Odometry& odom, double linear, double angular, double x_tolerance, double y_tolerance)
+{
+  const long double x = linear * std::sin(static_cast<long double>(angular)) / angular;
+  const long double y = linear * 2.0L * std::pow(std::sin(0.5L * angular), 2) / angular;
+  EXPECT_NEAR(1.0, odom.getX() / x, x_tolerance) << "angular: " << angular;
+  EXPECT_NEAR(1.0, odom.getY() / y, y_tolerance) << "angular: " << angular;
+}
+
+} // namespace
+
+TEST(OdometryIntegrationTest, MatchesExactWhenTurning)
+{
+  for (const double angular : {0.01, 0.2, 1.0, 3.0, -2.0})
+  {
+    Odometry exact, zero_order_hold;
+    initOdometry(exact, Odometry::EXACT);
+    initOdometry(zero_order_hold, Odometry::ZERO_ORDER_HOLD);
+    integrateStep(exact, 0.7, angular);
+    integrateStep(zero_order_hold, 0.7, angular);
+
+    EXPECT_NEAR(exact.getX(), zero_order_hold.getX(), 1e-12);
+    EXPECT_NEAR(exact.getY(), zero_order_hold.getY(), 1e-12);
+    EXPECT_NEAR(exact.getHeading(), zero_order_hold.getHeading(), 1e-12);
+  }
+}
+
+TEST(OdometryIntegrationTest, SmallAngles)
+{
+  // From a straight line to well past the series expansion range, relative error of the arc in closed form
+  const double linear = 1.0;
+  for (double angular = 1e-12; angular < 1.0; angular *= 3.0)
+  {
+    Odometry odom;
+    initOdometry(odom, Odometry::ZERO_ORDER_HOLD);
+    integrateStep(odom, linear, angular);
+    expectArc(odom, linear, angular, 1e-14, 1e-13);
+  }
+
+  Odometry straight;
+  initOdometry(straight, Odometry::ZERO_ORDER_HOLD);
+  integrateStep(straight, linear, 0.0);
+  EXPECT_EQ(linear, straight.getX());
+  EXPECT_EQ(0.0, straight.getY());
+}
+
+TEST(OdometryIntegrationTest, ContinuousAtSeriesThreshold)
+{
+  // The series expansion is used for a half angular displacement below 0.1 rad: no jump a few ulps around it
+  double angular = 0.2;
+  for (int i = 0; i < 8; ++i)
+    angular = std::nextafter(angular, 0.0);
+
+  for (int i = 0; i < 16; ++i, angular = std::nextafter(angular, 1.0))
+  {
+    Odometry odom;
+    initOdometry(odom, Odometry::ZERO_ORDER_HOLD);
+    integrateStep(odom, 1.0, angular);
+    expectArc(odom, 1.0, angular, 1e-15, 1e-15);
+  }
+}
+
+TEST(OdometryIntegrationTest, OpenLoopPeriodIgnoresJitter)
+{
+  Odometry odom;
+  initOdometry(odom, Odometry::ZERO_ORDER_HOLD);
+
+  // Half a turn at constant velocities, with update times jittering around a nominal 10 ms period
+  const double linear = 0.5, angular = 0.5;
+  const double period = 0.01;
+  const int steps = 628;
+  for (int i = 1; i <= steps; ++i)
+  {
+    const double jitter = (i % 3 - 1) * 0.002;
+    odom.updateOpenLoop(linear, angular, ros::Time(period * i + jitter), ros::Duration(period));
+  }
+
+  // Exact circle of radius linear / angular
+  const double heading = angular * period * steps;
+  const double radius = linear / angular;
+  EXPECT_NEAR(heading, odom.getHeading(), 1e-12);
+  EXPECT_NEAR(radius * std::sin(heading), odom.getX(), 1e-12);
+  EXPECT_NEAR(radius * (1.0 - std::cos(heading)), odom.getY(), 1e-12);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
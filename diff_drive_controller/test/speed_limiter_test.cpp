@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/speed_limiter.h>
+
+using diff_drive_controller::SpeedLimiter;
+using diff_drive_controller::TwistLimiter;
+
+namespace
+{
+
+/** Reference implementation: the three clamp stages applied in sequence. */
+void limitInStages(SpeedLimiter& limiter, double& v, double v0, double v1, double dt)
+{
+  limiter.limit_jerk(v, v0, v1, dt);
+  limiter.limit_acceleration(v, v0, dt);
+  limiter.limit_velocity(v);
+}
+
+} // namespace
+
+TEST(SpeedLimiterTest, MatchesStagedLimits)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-3.0, 3.0);
+  for (int i = 0; i < 10000; ++i)
+  {
+    SpeedLimiter limiter(gen() & 1, gen() & 1, gen() & 1,
+                         -std::abs(dist(gen)), std::abs(dist(gen)),
+                         -std::abs(dist(gen)), std::abs(dist(gen)),
+                         -std::abs(dist(gen)), std::abs(dist(gen)));
+    const double v0 = dist(gen), v1 = dist(gen), dt = 0.01 * (1 + gen() % 3);
+    double expected = dist(gen);
+    double v = expected;
+    limitInStages(limiter, expected, v0, v1, dt);
+    limiter.limit(v, v0, v1, dt);
+    EXPECT_NEAR(expected, v, 1e-12);
+  }
+}
+
+TEST(TwistLimiterTest, AxesMatchSpeedLimiter)
+{
+  SpeedLimiter lin(true, true, true, -1.0, 1.0, -0.5, 0.5, -2.0, 2.0);
+  SpeedLimiter ang(true, true, false, -2.0, 2.0, -3.0, 3.0, 0.0, 0.0);
+
+  TwistLimiter limiter;
+  limiter.setAxisLimits(TwistLimiter::LINEAR_X, lin);
+  limiter.setAxisLimits(TwistLimiter::ANGULAR_Z, ang);
+
+  TwistLimiter::Twist v = {{2.0, 5.0, -4.0}};
+  const TwistLimiter::Twist v0 = {{0.1, 0.0, -1.0}};
+  const TwistLimiter::Twist v1 = {{0.0, 0.0, -0.9}};
+  limiter.limit(v, v0, v1, 0.1);
+
+  double vx = 2.0, wz = -4.0;
+  lin.limit(vx, v0[0], v1[0], 0.1);
+  ang.limit(wz, v0[2], v1[2], 0.1);
+  EXPECT_DOUBLE_EQ(vx, v[TwistLimiter::LINEAR_X]);
+  EXPECT_DOUBLE_EQ(5.0, v[TwistLimiter::LINEAR_Y]);
+  EXPECT_DOUBLE_EQ(wz, v[TwistLimiter::ANGULAR_Z]);
+}
+
+TEST(TwistLimiterTest, ZeroTimeStep)
+{
+  SpeedLimiter lin(true, true, true, -1.0, 1.0, -0.5, 0.5, -2.0, 2.0);
+  TwistLimiter limiter;
+  limiter.setAxisLimits(TwistLimiter::LINEAR_X, lin);
+
+  const TwistLimiter::Twist v0 = {{0.3, 0.0, 0.0}};
+  TwistLimiter::Twist v = {{1.0, 0.0, 0.0}};
+  limiter.limit(v, v0, v0, 0.0);
+  EXPECT_TRUE(std::isfinite(v[TwistLimiter::LINEAR_X]));
+  EXPECT_NEAR(0.3, v[TwistLimiter::LINEAR_X], 1e-9);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/urdf_model_cache.h>
+
+using diff_drive_controller::UrdfModelCache;
+
+namespace
+{
+
+std::string robotDescription(const std::string& name)
+{
+  return "<robot name=\"" + name + "\"><link name=\"base_link\"/></robot>";
+}
+
+} // namespace
+
+TEST(UrdfModelCacheTest, ReusesParsedModels)
+{
+  UrdfModelCache::clear();
+  const urdf::ModelInterfaceConstSharedPtr model = UrdfModelCache::get(robotDescription("a"));
+  ASSERT_TRUE(model.get());
+  EXPECT_EQ(model, UrdfModelCache::get(robotDescription("a")));
+
+  // A different description is parsed again
+  const urdf::ModelInterfaceConstSharedPtr other = UrdfModelCache::get(robotDescription("b"));
+  ASSERT_TRUE(other.get());
+  EXPECT_NE(model, other);
+  EXPECT_EQ(model, UrdfModelCache::get(robotDescription("a")));
+}
+
+TEST(UrdfModelCacheTest, EvictsLeastRecentlyUsed)
+{
+  UrdfModelCache::clear();
+  const urdf::ModelInterfaceConstSharedPtr first = UrdfModelCache::get(robotDescription("0"));
+  for (size_t i = 1; i <= UrdfModelCache::CAPACITY; ++i)
+  {
+    UrdfModelCache::get(robotDescription(std::to_string(i)));
+  }
+  EXPECT_NE(first, UrdfModelCache::get(robotDescription("0")));
+
+  const urdf::ModelInterfaceConstSharedPtr last = UrdfModelCache::get(robotDescription("0"));
+  EXPECT_EQ(last, UrdfModelCache::get(robotDescription("0")));
+}
+
+TEST(UrdfModelCacheTest, Clear)
+{
+  const urdf::ModelInterfaceConstSharedPtr model = UrdfModelCache::get(robotDescription("a"));
+  UrdfModelCache::clear();
+  EXPECT_NE(model, UrdfModelCache::get(robotDescription("a")));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
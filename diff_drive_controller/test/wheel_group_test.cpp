@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/wheel_group.h>
+
+using diff_drive_controller::WheelGroup;
+
+namespace
+{
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/** Wheels whose positions and commands are stored in contiguous arrays, like most hardware interfaces do. */
+struct Wheels
+{
+  explicit Wheels(size_t size)
+    : pos(size, 0.0), vel(size, 0.0), eff(size, 0.0), cmd(size, 0.0)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      hardware_interface::JointStateHandle state_handle("wheel_" + std::to_string(i), &pos[i], &vel[i], &eff[i]);
+      handles.push_back(hardware_interface::JointHandle(state_handle, &cmd[i]));
+    }
+  }
+
+  std::vector<double> pos, vel, eff, cmd;
+  std::vector<hardware_interface::JointHandle> handles;
+};
+
+} // namespace
+
+TEST(WheelGroupTest, InvalidWeights)
+{
+  Wheels wheels(2);
+  WheelGroup group;
+  EXPECT_FALSE(group.init(wheels.handles, std::vector<double>(3, 1.0)));
+  EXPECT_FALSE(group.init(wheels.handles, std::vector<double>{1.0, -1.0}));
+  EXPECT_FALSE(group.init(wheels.handles, std::vector<double>{0.0, 0.0}));
+  EXPECT_TRUE(group.init(wheels.handles, std::vector<double>{0.0, 1.0}));
+  EXPECT_TRUE(group.init(wheels.handles, std::vector<double>()));
+  EXPECT_EQ(2u, group.size());
+}
+
+TEST(WheelGroupTest, WeightedAverage)
+{
+  Wheels wheels(3);
+  WheelGroup group;
+  ASSERT_TRUE(group.init(wheels.handles, std::vector<double>{1.0, 1.0, 2.0}));
+
+  wheels.pos = {1.0, 2.0, 3.0};
+  double position = 0.0;
+  ASSERT_TRUE(group.readPosition(position, false));
+  EXPECT_DOUBLE_EQ(2.25, position); // (1 + 2 + 2 * 3) / 4
+
+  wheels.pos = {2.0, 4.0, 3.0};
+  ASSERT_TRUE(group.readPosition(position, false));
+  EXPECT_DOUBLE_EQ(3.0, position);
+}
+
+TEST(WheelGroupTest, FaultyWheelSkipsReading)
+{
+  Wheels wheels(2);
+  WheelGroup group;
+  ASSERT_TRUE(group.init(wheels.handles, std::vector<double>()));
+
+  wheels.pos = {1.0, 3.0};
+  double position = 0.0;
+  ASSERT_TRUE(group.readPosition(position, false));
+  EXPECT_DOUBLE_EQ(2.0, position);
+
+  wheels.pos = {NaN, 4.0};
+  position = -1.0;
+  EXPECT_FALSE(group.readPosition(position, false));
+  EXPECT_EQ(-1.0, position);
+  EXPECT_EQ(1u, group.getFaultyCount());
+
+  // Readings resume from the last valid one
+  wheels.pos = {2.0, 4.0};
+  ASSERT_TRUE(group.readPosition(position, false));
+  EXPECT_DOUBLE_EQ(3.0, position);
+  EXPECT_EQ(0u, group.getFaultyCount());
+}
+
+TEST(WheelGroupTest, DropFaultyWheel)
+{
+  Wheels wheels(2);
+  WheelGroup group;
+  ASSERT_TRUE(group.init(wheels.handles, std::vector<double>()));
+
+  wheels.pos = {1.0, 3.0};
+  double position = 0.0;
+  ASSERT_TRUE(group.readPosition(position, true));
+  EXPECT_DOUBLE_EQ(2.0, position);
+
+  // The faulty wheel is left out, and the group advances by the increment of the valid one instead of jumping to it
+  wheels.pos = {NaN, 3.5};
+  ASSERT_TRUE(group.readPosition(position, true));
+  EXPECT_DOUBLE_EQ(2.5, position);
+  EXPECT_EQ(1u, group.getFaultyCount());
+
+  // A recovered wheel is used again from the next reading on
+  wheels.pos = {10.0, 4.0};
+  ASSERT_TRUE(group.readPosition(position, true));
+  EXPECT_DOUBLE_EQ(3.0, position);
+
+  wheels.pos = {11.0, 4.0};
+  ASSERT_TRUE(group.readPosition(position, true));
+  EXPECT_DOUBLE_EQ(3.5, position);
+
+  // No valid wheel
+  wheels.pos = {NaN, NaN};
+  EXPECT_FALSE(group.readPosition(position, true));
+  EXPECT_EQ(2u, group.getFaultyCount());
+}
+
+TEST(WheelGroupTest, SetCommand)
+{
+  Wheels wheels(4);
+  WheelGroup group;
+  ASSERT_TRUE(group.init(wheels.handles, std::vector<double>()));
+  group.setCommand(1.5);
+  for (double cmd : wheels.cmd) {EXPECT_EQ(1.5, cmd);}
+
+  // Handles not backed by contiguous commands
+  std::vector<hardware_interface::JointHandle> handles = {
+    hardware_interface::JointHandle(wheels.handles[0], &wheels.cmd[2]),
+    hardware_interface::JointHandle(wheels.handles[1], &wheels.cmd[0])};
+  ASSERT_TRUE(group.init(handles, std::vector<double>()));
+  group.setCommand(-2.0);
+  EXPECT_EQ(-2.0, wheels.cmd[0]);
+  EXPECT_EQ( 1.5, wheels.cmd[1]);
+  EXPECT_EQ(-2.0, wheels.cmd[2]);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
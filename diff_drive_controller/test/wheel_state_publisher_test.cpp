@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <diff_drive_controller/wheel_state_publisher.h>
+
+using diff_drive_controller::WheelStateSample;
+using diff_drive_controller::fillWheelState;
+
+namespace
+{
+
+control_msgs::JointTrajectoryControllerState makeMessage(std::size_t size)
+{
+  control_msgs::JointTrajectoryControllerState msg;
+  for (trajectory_msgs::JointTrajectoryPoint* state : {&msg.desired, &msg.actual, &msg.error})
+  {
+    state->positions.resize(size);
+    state->velocities.resize(size);
+    state->accelerations.resize(size);
+    state->effort.resize(size);
+  }
+  return msg;
+}
+
+WheelStateSample makeSample(double stamp, double velocity, double desired_velocity)
+{
+  WheelStateSample sample(2);
+  sample.stamp = ros::Time(stamp);
+  sample.position         = {1.0, 2.0};
+  sample.velocity         = {velocity, -velocity};
+  sample.effort           = {0.5, -0.5};
+  sample.desired_position = {1.5, 1.5};
+  sample.desired_velocity = {desired_velocity, desired_velocity};
+  return sample;
+}
+
+} // namespace
+
+TEST(WheelStateTest, FirstSample)
+{
+  control_msgs::JointTrajectoryControllerState msg = makeMessage(2);
+  fillWheelState(nullptr, makeSample(10.0, 1.0, 2.0), msg);
+
+  EXPECT_EQ(ros::Time(10.0), msg.header.stamp);
+  EXPECT_DOUBLE_EQ(1.0, msg.actual.positions[0]);
+  EXPECT_DOUBLE_EQ(-1.0, msg.actual.velocities[1]);
+  EXPECT_DOUBLE_EQ(-0.5, msg.actual.effort[1]);
+  EXPECT_DOUBLE_EQ(1.5, msg.desired.positions[1]);
+  EXPECT_DOUBLE_EQ(2.0, msg.desired.velocities[0]);
+  EXPECT_TRUE(std::isnan(msg.desired.effort[0]));
+
+  // No acceleration without a previous sample
+  EXPECT_DOUBLE_EQ(0.0, msg.actual.accelerations[0]);
+  EXPECT_DOUBLE_EQ(0.0, msg.desired.accelerations[0]);
+
+  // Errors
+  EXPECT_DOUBLE_EQ(0.5, msg.error.positions[0]);
+  EXPECT_DOUBLE_EQ(-0.5, msg.error.positions[1]);
+  EXPECT_DOUBLE_EQ(1.0, msg.error.velocities[0]);
+  EXPECT_DOUBLE_EQ(3.0, msg.error.velocities[1]);
+  EXPECT_TRUE(std::isnan(msg.error.effort[0]));
+}
+
+TEST(WheelStateTest, AccelerationsOverSampleInterval)
+{
+  control_msgs::JointTrajectoryControllerState msg = makeMessage(2);
+  const WheelStateSample previous = makeSample(10.0, 1.0, 2.0);
+  fillWheelState(&previous, makeSample(10.5, 2.0, 1.0), msg);
+
+  EXPECT_DOUBLE_EQ(2.0, msg.actual.accelerations[0]);
+  EXPECT_DOUBLE_EQ(-2.0, msg.actual.accelerations[1]);
+  EXPECT_DOUBLE_EQ(-2.0, msg.desired.accelerations[0]);
+  EXPECT_DOUBLE_EQ(-4.0, msg.error.accelerations[0]);
+  EXPECT_DOUBLE_EQ(0.0, msg.error.accelerations[1]);
+
+  // Samples out of order leave accelerations undefined, i.e. zero
+  fillWheelState(&previous, makeSample(10.0, 2.0, 1.0), msg);
+  EXPECT_DOUBLE_EQ(0.0, msg.actual.accelerations[0]);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
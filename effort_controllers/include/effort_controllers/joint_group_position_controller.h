@@ -40,7 +40,11 @@
 
 #include <control_msgs/JointControllerState.h>
 #include <control_toolbox/pid.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
 #include <controller_interface/controller.h>
+#include <forward_command_controller/joint_position_errors.h>
+#include <forward_command_controller/pid_group.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <realtime_tools/realtime_buffer.h>
 #include <realtime_tools/realtime_publisher.h>
@@ -81,12 +85,21 @@ public:
 private:
   ros::Subscriber sub_command_;
 
-  std::vector<control_toolbox::Pid> pid_controllers_;       /**< Internal PID controllers. */
+  controller_instrumentation::RealtimeAudit rt_audit_; /**< Audit of realtime-unsafe operations in update(). */
 
-  std::vector<urdf::JointConstSharedPtr> joint_urdfs_;
+  std::vector<control_toolbox::Pid> pid_controllers_;               /**< Internal PID controllers, holding the gains. */
+  forward_command_controller::PidGroup pid_group_;                  /**< PID state of all joints. */
+
+  /** Joint types and limits, flattened from the URDF in init() so that update() does not dereference it. */
+  forward_command_controller::JointPositionErrors<> position_errors_;
+
+  // Per joint scratch arrays of update(), allocated in init()
+  std::vector<double> positions_;
+  std::vector<double> command_positions_;
+  std::vector<double> errors_;
+  std::vector<double> efforts_;
 
   void commandCB(const std_msgs::Float64MultiArrayConstPtr& msg);
-  void enforceJointLimits(double &command, unsigned int index);
 }; // class
 
 } // namespace
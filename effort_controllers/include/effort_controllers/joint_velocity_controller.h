@@ -47,6 +47,7 @@
    @param type Must be "effort_controllers::JointVelocityController"
    @param joint Name of the joint to control.
    @param pid Contains the gains for the PID loop around velocity.  See: control_toolbox::Pid
+   @param state_publish_decimation Number of control cycles per published state, 10 by default.  See: forward_command_controller::PidStatePublisher
 
    Subscribes to:
 
@@ -61,10 +62,11 @@
 
 #include <control_msgs/JointControllerState.h>
 #include <control_toolbox/pid.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
 #include <controller_interface/controller.h>
+#include <forward_command_controller/pid_state_publisher.h>
 #include <hardware_interface/joint_command_interface.h>
-#include <memory>
-#include <realtime_tools/realtime_publisher.h>
 #include <ros/node_handle.h>
 #include <std_msgs/Float64.h>
 
@@ -148,15 +150,14 @@ public:
   double command_;                                /**< Last commanded velocity. */
 
 private:
-  int loop_count_;
   control_toolbox::Pid pid_controller_;           /**< Internal PID controller. */
 
-  std::unique_ptr<
-    realtime_tools::RealtimePublisher<
-      control_msgs::JointControllerState> > controller_state_publisher_ ;
+  forward_command_controller::PidStatePublisher state_publisher_; /**< Declared after the PID controller whose gains it reads. */
 
   ros::Subscriber sub_command_;
 
+  controller_instrumentation::RealtimeAudit rt_audit_; /**< Audit of realtime-unsafe operations in update(). */
+
   /**
    * \brief Callback from /command subscriber for setpoint
    */
@@ -41,7 +41,8 @@ template <class T>
 void forward_command_controller::ForwardCommandController<T>::starting(const ros::Time& time)
 {
   // Start controller with 0.0 effort
-  command_buffer_.writeFromNonRT(0.0);
+  command_buffer_.initRT(forward_command_controller::StampedCommand<double>(0.0, time));
+  command_timeout_.reset(time);
 }
 
 
@@ -37,7 +37,7 @@
 
 #include <effort_controllers/joint_group_position_controller.h>
 #include <pluginlib/class_list_macros.hpp>
-#include <angles/angles.h>
+#include <algorithm>
 
 namespace effort_controllers
 {
@@ -60,6 +60,10 @@ namespace effort_controllers
 
   bool JointGroupPositionController::init(hardware_interface::EffortJointInterface* hw, ros::NodeHandle &n)
   {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(n);
+    if (!thread_placement_scope) {return false;}
+
     // List of controlled joints
     std::string param_name = "joints";
     if(!n.getParam(param_name, joint_names_))
@@ -83,6 +87,11 @@ namespace effort_controllers
     }
 
     pid_controllers_.resize(n_joints_);
+    pid_group_.resize(n_joints_);
+    positions_.assign(n_joints_, 0.0);
+    command_positions_.assign(n_joints_, 0.0);
+    errors_.assign(n_joints_, 0.0);
+    efforts_.assign(n_joints_, 0.0);
 
     for(unsigned int i=0; i<n_joints_; i++)
     {
@@ -98,14 +107,6 @@ namespace effort_controllers
         return false;
       }
 
-      urdf::JointConstSharedPtr joint_urdf = urdf.getJoint(joint_name);
-      if (!joint_urdf)
-      {
-        ROS_ERROR("Could not find joint '%s' in urdf", joint_name.c_str());
-        return false;
-      }
-      joint_urdfs_.push_back(joint_urdf);
-
       // Load PID Controller using gains set on parameter server
       if (!pid_controllers_[i].init(ros::NodeHandle(n, joint_name + "/pid")))
       {
@@ -114,51 +115,43 @@ namespace effort_controllers
       }
     }
 
+    if (!position_errors_.init(urdf, joint_names_))
+    {
+      return false;
+    }
+
     commands_buffer_.writeFromNonRT(std::vector<double>(n_joints_, 0.0));
 
     sub_command_ = n.subscribe<std_msgs::Float64MultiArray>("command", 1, &JointGroupPositionController::commandCB, this);
+    rt_audit_.init(n);
     return true;
   }
 
   void JointGroupPositionController::update(const ros::Time& time, const ros::Duration& period)
   {
-    std::vector<double> & commands = *commands_buffer_.readFromRT();
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+    const std::vector<double> & commands = *commands_buffer_.readFromRT();
+
+    // Make sure joints are within limits if applicable, and compute the position error of all joints at once
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      positions_[i] = joints_[i].getPosition();
+      command_positions_[i] = commands[i];
+    }
+    position_errors_.compute(positions_.data(), command_positions_.data(), errors_.data());
+
+    // Set the PID error and compute the PID command with nonuniform
+    // time step size.
     for(unsigned int i=0; i<n_joints_; i++)
     {
-        double command_position = commands[i];
-
-        double error; //, vel_error;
-        double commanded_effort;
-
-        double current_position = joints_[i].getPosition();
-
-        // Make sure joint is within limits if applicable
-        enforceJointLimits(command_position, i);
-
-        // Compute position error
-        if (joint_urdfs_[i]->type == urdf::Joint::REVOLUTE)
-        {
-         angles::shortest_angular_distance_with_limits(
-            current_position,
-            command_position,
-            joint_urdfs_[i]->limits->lower,
-            joint_urdfs_[i]->limits->upper,
-            error);
-        }
-        else if (joint_urdfs_[i]->type == urdf::Joint::CONTINUOUS)
-        {
-          error = angles::shortest_angular_distance(current_position, command_position);
-        }
-        else //prismatic
-        {
-          error = command_position - current_position;
-        }
-
-        // Set the PID error and compute the PID command with nonuniform
-        // time step size.
-        commanded_effort = pid_controllers_[i].computeCommand(error, period);
-
-        joints_[i].setCommand(commanded_effort);
+      pid_group_.setGains(i, pid_controllers_[i].getGains());
+    }
+    pid_group_.computeCommands(errors_.data(), period.toSec(), efforts_.data());
+
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      joints_[i].setCommand(efforts_[i]);
     }
   }
 
@@ -172,22 +165,6 @@ namespace effort_controllers
     commands_buffer_.writeFromNonRT(msg->data);
   }
 
-  void JointGroupPositionController::enforceJointLimits(double &command, unsigned int index)
-  {
-    // Check that this joint has applicable limits
-    if (joint_urdfs_[index]->type == urdf::Joint::REVOLUTE || joint_urdfs_[index]->type == urdf::Joint::PRISMATIC)
-    {
-      if( command > joint_urdfs_[index]->limits->upper ) // above upper limnit
-      {
-        command = joint_urdfs_[index]->limits->upper;
-      }
-      else if( command < joint_urdfs_[index]->limits->lower ) // below lower limit
-      {
-        command = joint_urdfs_[index]->limits->lower;
-      }
-    }
-  }
-
 } // namespace
 
 PLUGINLIB_EXPORT_CLASS( effort_controllers::JointGroupPositionController, controller_interface::ControllerBase)
@@ -0,0 +1,186 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2008, Willow Garage, Inc.
+ *  Copyright (c) 2012, hiDOF, Inc.
+ *  Copyright (c) 2013, PAL Robotics, S.L.
+ *  Copyright (c) 2014, Fraunhofer IPA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <effort_controllers/joint_group_velocity_controller.h>
+#include <pluginlib/class_list_macros.hpp>
+#include <controller_instrumentation/tracepoints.h>
+#include <algorithm>
+
+namespace effort_controllers
+{
+
+  JointGroupVelocityController::JointGroupVelocityController() : n_joints_(0), loop_count_(0) {}
+  JointGroupVelocityController::~JointGroupVelocityController() {sub_command_.shutdown();}
+
+  bool JointGroupVelocityController::init(hardware_interface::EffortJointInterface* hw, ros::NodeHandle &n)
+  {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(n);
+    if (!thread_placement_scope) {return false;}
+
+    // List of controlled joints
+    std::string param_name = "joints";
+    if(!n.getParam(param_name, joint_names_))
+    {
+      ROS_ERROR_STREAM("Failed to getParam '" << param_name << "' (namespace: " << n.getNamespace() << ").");
+      return false;
+    }
+    n_joints_ = joint_names_.size();
+
+    if(n_joints_ == 0){
+      ROS_ERROR_STREAM("List of joint names is empty.");
+      return false;
+    }
+
+    pid_controllers_.resize(n_joints_);
+    pid_group_.resize(n_joints_);
+    errors_.assign(n_joints_, 0.0);
+    efforts_.assign(n_joints_, 0.0);
+
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      const auto& joint_name = joint_names_[i];
+
+      try
+      {
+        joints_.push_back(hw->getHandle(joint_name));
+      }
+      catch (const hardware_interface::HardwareInterfaceException& e)
+      {
+        ROS_ERROR_STREAM("Exception thrown: " << e.what());
+        return false;
+      }
+
+      // Load PID Controller using gains set on parameter server
+      if (!pid_controllers_[i].init(ros::NodeHandle(n, joint_name + "/pid")))
+      {
+        ROS_ERROR_STREAM("Failed to load PID parameters from " << joint_name + "/pid");
+        return false;
+      }
+    }
+
+    commands_buffer_.writeFromNonRT(std::vector<double>(n_joints_, 0.0));
+
+    // Start realtime state publisher, with all arrays allocated once
+    controller_state_publisher_.reset(new StatePublisher(n, "state", 1));
+    controller_state_publisher_->lock();
+    controller_state_publisher_->msg_.joint_names = joint_names_;
+    controller_state_publisher_->msg_.desired.velocities.resize(n_joints_);
+    controller_state_publisher_->msg_.desired.effort.resize(n_joints_);
+    controller_state_publisher_->msg_.actual.velocities.resize(n_joints_);
+    controller_state_publisher_->msg_.error.velocities.resize(n_joints_);
+    controller_state_publisher_->unlock();
+
+    sub_command_ = n.subscribe<std_msgs::Float64MultiArray>("command", 1, &JointGroupVelocityController::commandCB, this);
+    rt_audit_.init(n);
+    return true;
+  }
+
+  void JointGroupVelocityController::starting(const ros::Time& /*time*/)
+  {
+    // Start at rest, as effort_controllers::JointVelocityController does
+    std::fill(errors_.begin(), errors_.end(), 0.0);
+    commands_buffer_.initRT(errors_);
+
+    pid_group_.reset();
+  }
+
+  void JointGroupVelocityController::update(const ros::Time& time, const ros::Duration& period)
+  {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+    const std::vector<double> & commands = *commands_buffer_.readFromRT();
+
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      errors_[i] = commands[i] - joints_[i].getVelocity();
+    }
+
+    // Set the PID error and compute the PID command with nonuniform time
+    // step size. The derivative error is computed from the change in the error
+    // and the timestep dt.
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      pid_group_.setGains(i, pid_controllers_[i].getGains());
+    }
+    pid_group_.computeCommands(errors_.data(), period.toSec(), efforts_.data());
+
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      joints_[i].setCommand(efforts_[i]);
+    }
+
+    // publish state
+    if (loop_count_ % 10 == 0)
+    {
+      publishState(time, commands);
+    }
+    loop_count_++;
+  }
+
+  void JointGroupVelocityController::publishState(const ros::Time& time, const std::vector<double>& commands)
+  {
+    if(!controller_instrumentation::tracedTrylock(*controller_state_publisher_, "state"))
+    {
+      return;
+    }
+
+    control_msgs::JointTrajectoryControllerState& msg = controller_state_publisher_->msg_;
+    msg.header.stamp = time;
+    for(unsigned int i=0; i<n_joints_; i++)
+    {
+      msg.desired.velocities[i] = commands[i];
+      msg.desired.effort[i]     = efforts_[i];
+      msg.actual.velocities[i]  = joints_[i].getVelocity();
+      msg.error.velocities[i]   = errors_[i];
+    }
+    controller_state_publisher_->unlockAndPublish();
+  }
+
+  void JointGroupVelocityController::commandCB(const std_msgs::Float64MultiArrayConstPtr& msg)
+  {
+    if(msg->data.size()!=n_joints_)
+    {
+      ROS_ERROR_STREAM("Dimension of command (" << msg->data.size() << ") does not match number of joints (" << n_joints_ << ")! Not executing!");
+      return;
+    }
+    commands_buffer_.writeFromNonRT(msg->data);
+  }
+
+} // namespace
+
+PLUGINLIB_EXPORT_CLASS( effort_controllers::JointGroupVelocityController, controller_interface::ControllerBase)
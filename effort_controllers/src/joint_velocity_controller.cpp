@@ -40,7 +40,7 @@
 namespace effort_controllers {
 
 JointVelocityController::JointVelocityController()
-: command_(0), loop_count_(0)
+: command_(0)
 {}
 
 JointVelocityController::~JointVelocityController()
@@ -61,6 +61,10 @@ bool JointVelocityController::init(hardware_interface::EffortJointInterface *rob
 
 bool JointVelocityController::init(hardware_interface::EffortJointInterface *robot, ros::NodeHandle &n)
 {
+  // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+  const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(n);
+  if (!thread_placement_scope) {return false;}
+
   // Get joint name from parameter server
   std::string joint_name;
   if (!n.getParam("joint", joint_name)) {
@@ -76,13 +80,14 @@ bool JointVelocityController::init(hardware_interface::EffortJointInterface *rob
     return false;
 
   // Start realtime state publisher
-  controller_state_publisher_.reset(
-    new realtime_tools::RealtimePublisher<control_msgs::JointControllerState>
-    (n, "state", 1));
+  if (!state_publisher_.init(n, pid_controller_))
+    return false;
 
   // Start command subscriber
   sub_command_ = n.subscribe<std_msgs::Float64>("command", 1, &JointVelocityController::setCommandCB, this);
 
+  rt_audit_.init(n);
+
   return true;
 }
 
@@ -132,6 +137,8 @@ void JointVelocityController::starting(const ros::Time& time)
 
 void JointVelocityController::update(const ros::Time& time, const ros::Duration& period)
 {
+  controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
   double error = command_ - joint_.getVelocity();
 
   // Set the PID error and compute the PID command with nonuniform time
@@ -141,30 +148,15 @@ void JointVelocityController::update(const ros::Time& time, const ros::Duration&
 
   joint_.setCommand(commanded_effort);
 
-  if(loop_count_ % 10 == 0)
-  {
-    if(controller_state_publisher_ && controller_state_publisher_->trylock())
-    {
-      controller_state_publisher_->msg_.header.stamp = time;
-      controller_state_publisher_->msg_.set_point = command_;
-      controller_state_publisher_->msg_.process_value = joint_.getVelocity();
-      controller_state_publisher_->msg_.error = error;
-      controller_state_publisher_->msg_.time_step = period.toSec();
-      controller_state_publisher_->msg_.command = commanded_effort;
-
-      double dummy;
-      bool antiwindup;
-      getGains(controller_state_publisher_->msg_.p,
-        controller_state_publisher_->msg_.i,
-        controller_state_publisher_->msg_.d,
-        controller_state_publisher_->msg_.i_clamp,
-        dummy,
-        antiwindup);
-      controller_state_publisher_->msg_.antiwindup = static_cast<char>(antiwindup);
-      controller_state_publisher_->unlockAndPublish();
-    }
-  }
-  loop_count_++;
+  // publish state
+  forward_command_controller::PidStatePublisher::State state;
+  state.stamp = time;
+  state.set_point = command_;
+  state.process_value = joint_.getVelocity();
+  state.error = error;
+  state.time_step = period.toSec();
+  state.command = commanded_effort;
+  state_publisher_.update(state);
 }
 
 void JointVelocityController::setCommandCB(const std_msgs::Float64ConstPtr& msg)
@@ -31,23 +31,37 @@
 #ifndef FORCE_TORQUE_SENSOR_CONTROLLER_FORCE_TORQUE_SENSOR_CONTROLLER_H
 #define FORCE_TORQUE_SENSOR_CONTROLLER_FORCE_TORQUE_SENSOR_CONTROLLER_H
 
-#include <controller_interface/controller.h>
+#include <atomic>
+#include <controller_instrumentation/publish_schedule.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_instrumentation/tracepoints.h>
+#include <controller_interface/multi_interface_controller.h>
+#include <force_torque_sensor_controller/wrench_filter.h>
 #include <geometry_msgs/WrenchStamped.h>
 #include <hardware_interface/force_torque_sensor_interface.h>
+#include <hardware_interface/imu_sensor_interface.h>
 #include <memory>
 #include <pluginlib/class_list_macros.hpp>
 #include <realtime_tools/realtime_publisher.h>
+#include <std_srvs/Trigger.h>
 
 namespace force_torque_sensor_controller
 {
 
-// this controller gets access to the ForceTorqueSensorInterface
-class ForceTorqueSensorController: public controller_interface::Controller<hardware_interface::ForceTorqueSensorInterface>
+// this controller gets access to the ForceTorqueSensorInterface, and optionally to the ImuSensorInterface for the
+// gravity compensation
+class ForceTorqueSensorController
+  : public controller_interface::MultiInterfaceController<hardware_interface::ForceTorqueSensorInterface,
+                                                          hardware_interface::ImuSensorInterface>
 {
 public:
-  ForceTorqueSensorController(){}
+  ForceTorqueSensorController()
+    : controller_interface::MultiInterfaceController<hardware_interface::ForceTorqueSensorInterface,
+                                                     hardware_interface::ImuSensorInterface>(true),
+      publish_rate_(0.0), stagger_publish_(false), tare_requested_(false), clear_bias_requested_(false) {}
 
-  virtual bool init(hardware_interface::ForceTorqueSensorInterface* hw, ros::NodeHandle &root_nh, ros::NodeHandle& controller_nh);
+  virtual bool init(hardware_interface::RobotHW* robot_hw, ros::NodeHandle &root_nh, ros::NodeHandle& controller_nh);
   virtual void starting(const ros::Time& time);
   virtual void update(const ros::Time& time, const ros::Duration& /*period*/);
   virtual void stopping(const ros::Time& /*time*/);
@@ -56,8 +70,45 @@ private:
   std::vector<hardware_interface::ForceTorqueSensorHandle> sensors_;
   typedef std::shared_ptr<realtime_tools::RealtimePublisher<geometry_msgs::WrenchStamped> > RtPublisherPtr;
   std::vector<RtPublisherPtr> realtime_pubs_;
-  std::vector<ros::Time> last_publish_times_;
+  std::vector<controller_instrumentation::PublishSchedule> publish_schedules_;
   double publish_rate_;
+  bool stagger_publish_;           ///< Whether to spread publish cycles, see controller_instrumentation::PublishSchedule
+
+  /// Topic with the filtered and bias compensated wrench of every sensor, published at its own rate.
+  struct FilteredOutput
+  {
+    std::string name;                     ///< Topic of sensor i is <sensor name>/<name>
+    std::vector<RtPublisherPtr> realtime_pubs;
+    std::vector<controller_instrumentation::PublishSchedule> publish_schedules;
+  };
+  std::vector<FilteredOutput> filtered_outputs_;
+  std::vector<WrenchFilter> filters_;   ///< One per sensor, only updated when there are filtered outputs
+
+  /// Compensation of the weight of the tool mounted on a sensor, in its filtered outputs.
+  struct ToolCompensation
+  {
+    unsigned sensor;                            ///< Index of the compensated sensor
+    GravityCompensation gravity;
+    bool use_imu;                               ///< Whether gravity follows the IMU orientation, or is fixed
+    hardware_interface::ImuSensorHandle imu;
+  };
+  std::vector<ToolCompensation> tool_compensations_;
+
+  // Tare requests from the service callbacks, applied in update()
+  std::atomic<bool> tare_requested_;
+  std::atomic<bool> clear_bias_requested_;
+  ros::ServiceServer tare_srv_;
+  ros::ServiceServer clear_bias_srv_;
+
+  bool initFilteredOutputs(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh);
+  bool initToolCompensations(hardware_interface::RobotHW* robot_hw, ros::NodeHandle& controller_nh);
+
+  static void fillMessage(const hardware_interface::ForceTorqueSensorHandle& sensor, geometry_msgs::WrenchStamped& msg);
+  static void fillMessage(const WrenchFilter& filter, geometry_msgs::WrenchStamped& msg);
+
+  bool tareCb(std_srvs::Trigger::Request& req, std_srvs::Trigger::Response& resp);
+  bool clearBiasCb(std_srvs::Trigger::Request& req, std_srvs::Trigger::Response& resp);
+  controller_instrumentation::RealtimeAudit rt_audit_; ///< Audit of realtime-unsafe operations in update()
 };
 
 }
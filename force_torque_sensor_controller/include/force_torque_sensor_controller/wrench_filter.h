@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef FORCE_TORQUE_SENSOR_CONTROLLER_WRENCH_FILTER_H
+#define FORCE_TORQUE_SENSOR_CONTROLLER_WRENCH_FILTER_H
+
+#include <array>
+#include <cmath>
+
+namespace force_torque_sensor_controller
+{
+
+/**
+ * \brief Second order IIR filter section, in transposed direct form II.
+ *
+ * The state is two doubles, so filtering is allocation-free and constant time.
+ * A default constructed section passes its input through unchanged.
+ */
+class Biquad
+{
+public:
+  Biquad() : b0_(1.0), b1_(0.0), b2_(0.0), a1_(0.0), a2_(0.0), z1_(0.0), z2_(0.0) {}
+
+  /**
+   * \brief Configure as a Butterworth low-pass filter
+   * \param cutoff      Cutoff frequency [Hz], must be below half the sample rate
+   * \param sample_rate Rate at which filter() is called [Hz]
+   */
+  void lowPass(double cutoff, double sample_rate)
+  {
+    const double w0    = 2.0 * M_PI * cutoff / sample_rate;
+    const double alpha = std::sin(w0) / std::sqrt(2.0); // sin(w0) / (2 Q), with Q = 1/sqrt(2)
+    const double cw0   = std::cos(w0);
+    const double a0    = 1.0 + alpha;
+
+    b0_ = 0.5 * (1.0 - cw0) / a0;
+    b1_ = (1.0 - cw0) / a0;
+    b2_ = b0_;
+    a1_ = -2.0 * cw0 / a0;
+    a2_ = (1.0 - alpha) / a0;
+  }
+
+  /// Set the state as if \p value had been the input forever, so that the output starts at \p value.
+  void reset(double value)
+  {
+    z2_ = (b2_ - a2_) * value;
+    z1_ = (b1_ - a1_) * value + z2_;
+  }
+
+  double filter(double x)
+  {
+    const double y = b0_ * x + z1_;
+    z1_ = b1_ * x - a1_ * y + z2_;
+    z2_ = b2_ * x - a2_ * y;
+    return y;
+  }
+
+private:
+  double b0_, b1_, b2_; ///< Numerator coefficients
+  double a1_, a2_;      ///< Denominator coefficients, normalized so that a0 = 1
+  double z1_, z2_;      ///< Filter state
+};
+
+/**
+ * \brief Low-pass filter and bias compensation of the six components of a wrench.
+ *
+ * Components are ordered as force x, y, z followed by torque x, y, z.
+ */
+class WrenchFilter
+{
+public:
+  WrenchFilter()
+  {
+    filtered_.fill(0.0);
+    load_.fill(0.0);
+    bias_.fill(0.0);
+  }
+
+  /// \copydoc Biquad::lowPass
+  void lowPass(double cutoff, double sample_rate)
+  {
+    for (Biquad& section : sections_)
+      section.lowPass(cutoff, sample_rate);
+  }
+
+  /// Restart filtering from the given reading.
+  void reset(const double* force, const double* torque)
+  {
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      filtered_[i]     = force[i];
+      filtered_[i + 3] = torque[i];
+    }
+    for (unsigned i = 0; i < 6; ++i)
+      sections_[i].reset(filtered_[i]);
+  }
+
+  /// Filter a new reading.
+  void update(const double* force, const double* torque)
+  {
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      filtered_[i]     = sections_[i].filter(force[i]);
+      filtered_[i + 3] = sections_[i + 3].filter(torque[i]);
+    }
+  }
+
+  /// Set the wrench of a known load, e.g. the weight of a tool, subtracted from the filter output along with the bias.
+  void setLoad(const std::array<double, 6>& load) { load_ = load; }
+
+  /// Take the current filtered wrench, minus the load, as the bias, so that it reads zero from now on.
+  void tare()
+  {
+    for (unsigned i = 0; i < 6; ++i)
+      bias_[i] = filtered_[i] - load_[i];
+  }
+
+  void clearBias() { bias_.fill(0.0); }
+
+  /// Filtered, load and bias compensated component \p i.
+  double operator[](unsigned i) const { return filtered_[i] - load_[i] - bias_[i]; }
+
+private:
+  std::array<Biquad, 6> sections_;
+  std::array<double, 6> filtered_; ///< Last filter output
+  std::array<double, 6> load_;     ///< Known load, subtracted from the filter output
+  std::array<double, 6> bias_;     ///< Subtracted from the filter output
+};
+
+/**
+ * \brief Wrench applied on a sensor by the weight of the tool mounted on it, in the sensor frame.
+ *
+ * The direction of gravity in the sensor frame is either fixed, or follows the orientation of an IMU rigidly attached
+ * to the sensor. The rotation from the IMU frame to the sensor frame is computed once by setImuRotation(), so
+ * updating from an IMU orientation is a handful of multiply-adds.
+ *
+ * Quaternions are ordered x, y, z, w like in hardware_interface::ImuSensorHandle.
+ */
+class GravityCompensation
+{
+public:
+  /// Standard gravity [m/s^2]
+  static constexpr double GRAVITY = 9.80665;
+
+  GravityCompensation() : mass_(0.0)
+  {
+    center_of_mass_.fill(0.0);
+    setImuRotation(0.0, 0.0, 0.0, 1.0);
+    setGravity(0.0, 0.0, -GRAVITY);
+  }
+
+  /**
+   * \brief Set the tool inertial parameters
+   * \param mass           Tool mass [kg]
+   * \param center_of_mass Tool center of mass in the sensor frame [m]
+   */
+  void setTool(double mass, const std::array<double, 3>& center_of_mass)
+  {
+    mass_ = mass;
+    center_of_mass_ = center_of_mass;
+    updateLoad();
+  }
+
+  /**
+   * \brief Set the orientation of the IMU frame in the sensor frame
+   * \return false, leaving the rotation unchanged, if the quaternion has zero norm
+   */
+  bool setImuRotation(double x, double y, double z, double w)
+  {
+    const double norm = std::sqrt(x * x + y * y + z * z + w * w);
+    if (!(norm > 0.0))
+      return false;
+    x /= norm; y /= norm; z /= norm; w /= norm;
+
+    imu_rotation_ = {{1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - z * w),       2.0 * (x * z + y * w),
+                      2.0 * (x * y + z * w),       1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - x * w),
+                      2.0 * (x * z - y * w),       2.0 * (y * z + x * w),       1.0 - 2.0 * (x * x + y * y)}};
+    return true;
+  }
+
+  /// Set the gravity acceleration in the sensor frame [m/s^2], for sensors with a fixed orientation.
+  void setGravity(double x, double y, double z)
+  {
+    gravity_ = {{x, y, z}};
+    updateLoad();
+  }
+
+  /// Update the direction of gravity from the orientation of the IMU, whose reference frame has its z axis up.
+  void updateImuOrientation(const double* orientation)
+  {
+    const double x = orientation[0], y = orientation[1], z = orientation[2], w = orientation[3];
+
+    // Gravity in the IMU frame, i.e. -GRAVITY times the last row of the IMU rotation matrix
+    const double imu_gravity[3] = {-GRAVITY * 2.0 * (x * z - y * w),
+                                   -GRAVITY * 2.0 * (y * z + x * w),
+                                   -GRAVITY * (1.0 - 2.0 * (x * x + y * y))};
+    for (unsigned i = 0; i < 3; ++i)
+      gravity_[i] = imu_rotation_[3 * i] * imu_gravity[0] + imu_rotation_[3 * i + 1] * imu_gravity[1]
+                  + imu_rotation_[3 * i + 2] * imu_gravity[2];
+    updateLoad();
+  }
+
+  /// Weight of the tool, force followed by torque about the sensor origin, in the sensor frame.
+  const std::array<double, 6>& load() const { return load_; }
+
+private:
+  void updateLoad()
+  {
+    const std::array<double, 3>& c = center_of_mass_;
+    const double f[3] = {mass_ * gravity_[0], mass_ * gravity_[1], mass_ * gravity_[2]};
+    load_ = {{f[0], f[1], f[2], c[1] * f[2] - c[2] * f[1], c[2] * f[0] - c[0] * f[2], c[0] * f[1] - c[1] * f[0]}};
+  }
+
+  double mass_;
+  std::array<double, 3> center_of_mass_;
+  std::array<double, 9> imu_rotation_; ///< Rotation from the IMU frame to the sensor frame, row-major
+  std::array<double, 3> gravity_;      ///< Gravity acceleration in the sensor frame
+  std::array<double, 6> load_;
+};
+
+}
+
+#endif
@@ -36,10 +36,21 @@
 namespace force_torque_sensor_controller
 {
 
-  bool ForceTorqueSensorController::init(hardware_interface::ForceTorqueSensorInterface* hw, ros::NodeHandle &root_nh, ros::NodeHandle& controller_nh)
+  bool ForceTorqueSensorController::init(hardware_interface::RobotHW* robot_hw, ros::NodeHandle &root_nh, ros::NodeHandle& controller_nh)
   {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh);
+    if (!thread_placement_scope) {return false;}
+
+    // the IMU interface is optional, not this one
+    hardware_interface::ForceTorqueSensorInterface* hw = robot_hw->get<hardware_interface::ForceTorqueSensorInterface>();
+    if (!hw){
+      ROS_ERROR("Robot hardware has no force-torque sensor interface");
+      return false;
+    }
+
     // get all joint states from the hardware interface
-    const std::vector<std::string>& sensor_names = hw->getNames();
+    const std::vector<std::string> sensor_names = hw->getNames();
     for (unsigned i=0; i<sensor_names.size(); i++)
       ROS_DEBUG("Got sensor %s", sensor_names[i].c_str());
 
@@ -49,58 +60,290 @@ namespace force_torque_sensor_controller
       return false;
     }
 
+    // spread publish cycles across sensors and controllers
+    controller_nh.param("stagger_publish", stagger_publish_, stagger_publish_);
+
     for (unsigned i=0; i<sensor_names.size(); i++){
       // sensor handle
       sensors_.push_back(hw->getHandle(sensor_names[i]));
 
       // realtime publisher
       RtPublisherPtr rt_pub(new realtime_tools::RealtimePublisher<geometry_msgs::WrenchStamped>(root_nh, sensor_names[i], 4));
+      rt_pub->msg_.header.frame_id = sensors_.back().getFrameId();
       realtime_pubs_.push_back(rt_pub);
+      publish_schedules_.push_back(controller_instrumentation::PublishSchedule());
+      publish_schedules_.back().init(publish_rate_, stagger_publish_);
+    }
+
+    if (!initFilteredOutputs(root_nh, controller_nh))
+      return false;
+
+    if (!initToolCompensations(robot_hw, controller_nh))
+      return false;
+
+    rt_audit_.init(controller_nh);
+    return true;
+  }
+
+  bool ForceTorqueSensorController::initFilteredOutputs(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh)
+  {
+    XmlRpc::XmlRpcValue list;
+    if (!controller_nh.getParam("filtered_outputs", list))
+      return true;
+
+    if (list.getType() != XmlRpc::XmlRpcValue::TypeArray){
+      ROS_ERROR("Filtered outputs specification is not an array");
+      return false;
+    }
+
+    for (int i = 0; i < list.size(); ++i){
+      XmlRpc::XmlRpcValue& elem = list[i];
+      if (elem.getType() != XmlRpc::XmlRpcValue::TypeStruct || !elem.hasMember("name") ||
+          elem["name"].getType() != XmlRpc::XmlRpcValue::TypeString){
+        ROS_ERROR("Filtered output specification is not a struct with a name");
+        return false;
+      }
+
+      FilteredOutput output;
+      output.name = static_cast<std::string>(elem["name"]);
+
+      double publish_rate = 0.0;
+      const XmlRpc::XmlRpcValue::Type rate_type = elem.hasMember("publish_rate") ? elem["publish_rate"].getType()
+                                                                                  : XmlRpc::XmlRpcValue::TypeInvalid;
+      if (rate_type == XmlRpc::XmlRpcValue::TypeDouble)
+        publish_rate = static_cast<double>(elem["publish_rate"]);
+      else if (rate_type == XmlRpc::XmlRpcValue::TypeInt)
+        publish_rate = static_cast<int>(elem["publish_rate"]);
+      if (!(publish_rate > 0.0)){
+        ROS_ERROR_STREAM("Filtered output '" << output.name << "' needs a positive 'publish_rate'");
+        return false;
+      }
+
+      for (unsigned j=0; j<sensors_.size(); j++){
+        RtPublisherPtr rt_pub(new realtime_tools::RealtimePublisher<geometry_msgs::WrenchStamped>(
+                                root_nh, sensors_[j].getName() + "/" + output.name, 4));
+        rt_pub->msg_.header.frame_id = sensors_[j].getFrameId();
+        output.realtime_pubs.push_back(rt_pub);
+        output.publish_schedules.push_back(controller_instrumentation::PublishSchedule());
+        output.publish_schedules.back().init(publish_rate, stagger_publish_);
+      }
+      filtered_outputs_.push_back(output);
     }
 
-    // Last published times
-    last_publish_times_.resize(sensor_names.size());
+    // low-pass filter, pass-through if no cutoff frequency is given
+    filters_.resize(sensors_.size());
+    double cutoff_frequency = 0.0;
+    controller_nh.param("filter/cutoff_frequency", cutoff_frequency, cutoff_frequency);
+    if (cutoff_frequency > 0.0){
+      double sample_rate = 0.0;
+      if (!controller_nh.getParam("filter/sample_rate", sample_rate) || !(sample_rate > 0.0)){
+        ROS_ERROR("Parameter 'filter/sample_rate' must be set to the positive update rate of the controller");
+        return false;
+      }
+      if (cutoff_frequency >= 0.5 * sample_rate){
+        ROS_ERROR_STREAM("Parameter 'filter/cutoff_frequency' (" << cutoff_frequency
+                         << " Hz) must be lower than half the sample rate (" << sample_rate << " Hz)");
+        return false;
+      }
+      for (WrenchFilter& filter : filters_)
+        filter.lowPass(cutoff_frequency, sample_rate);
+    }
+    else if (cutoff_frequency < 0.0){
+      ROS_ERROR("Parameter 'filter/cutoff_frequency' must not be negative");
+      return false;
+    }
+
+    // bias compensation
+    tare_srv_ = controller_nh.advertiseService("tare", &ForceTorqueSensorController::tareCb, this);
+    clear_bias_srv_ = controller_nh.advertiseService("clear_bias", &ForceTorqueSensorController::clearBiasCb, this);
+
+    return true;
+  }
+
+  bool ForceTorqueSensorController::initToolCompensations(hardware_interface::RobotHW* robot_hw,
+                                                          ros::NodeHandle& controller_nh)
+  {
+    for (unsigned i=0; i<sensors_.size(); i++){
+      ros::NodeHandle nh(controller_nh, sensors_[i].getName() + "/gravity_compensation");
+      double mass = 0.0;
+      if (!nh.getParam("mass", mass))
+        continue;
+      if (filtered_outputs_.empty()){
+        ROS_ERROR_STREAM("Gravity compensation of " << sensors_[i].getName() << " is only applied to filtered outputs, "
+                         "but there are none");
+        return false;
+      }
+
+      ToolCompensation compensation;
+      compensation.sensor = i;
+      compensation.use_imu = false;
+
+      // center of mass in the sensor frame [m]
+      std::vector<double> center_of_mass(3, 0.0);
+      nh.param("center_of_mass", center_of_mass, center_of_mass);
+      if (center_of_mass.size() != 3){
+        ROS_ERROR_STREAM("Parameter '" << nh.getNamespace() << "/center_of_mass' must have 3 elements");
+        return false;
+      }
+      compensation.gravity.setTool(mass, {{center_of_mass[0], center_of_mass[1], center_of_mass[2]}});
+
+      // gravity direction from an IMU rigidly attached to the sensor, in the same controller manager
+      std::string imu_sensor;
+      if (nh.getParam("imu_sensor", imu_sensor)){
+        hardware_interface::ImuSensorInterface* imu_hw = robot_hw->get<hardware_interface::ImuSensorInterface>();
+        if (!imu_hw){
+          ROS_ERROR_STREAM("Robot hardware has no IMU sensor interface for " << imu_sensor);
+          return false;
+        }
+        compensation.imu = imu_hw->getHandle(imu_sensor); // throws on failure
+        if (!compensation.imu.getOrientation()){
+          ROS_ERROR_STREAM("IMU " << imu_sensor << " has no orientation to compensate gravity with");
+          return false;
+        }
+        compensation.use_imu = true;
+
+        // orientation of the IMU frame in the sensor frame, as a quaternion [x, y, z, w]
+        std::vector<double> imu_rotation;
+        if (nh.getParam("imu_rotation", imu_rotation) &&
+            (imu_rotation.size() != 4 ||
+             !compensation.gravity.setImuRotation(imu_rotation[0], imu_rotation[1], imu_rotation[2], imu_rotation[3]))){
+          ROS_ERROR_STREAM("Parameter '" << nh.getNamespace() << "/imu_rotation' must be a non-zero quaternion [x, y, z, w]");
+          return false;
+        }
+      }
+      // otherwise fixed gravity acceleration in the sensor frame [m/s^2]
+      else{
+        std::vector<double> gravity;
+        if (nh.getParam("gravity", gravity)){
+          if (gravity.size() != 3){
+            ROS_ERROR_STREAM("Parameter '" << nh.getNamespace() << "/gravity' must have 3 elements");
+            return false;
+          }
+          compensation.gravity.setGravity(gravity[0], gravity[1], gravity[2]);
+        }
+      }
+
+      filters_[i].setLoad(compensation.gravity.load());
+      tool_compensations_.push_back(compensation);
+    }
     return true;
   }
 
   void ForceTorqueSensorController::starting(const ros::Time& time)
   {
     // initialize time
-    for (unsigned i=0; i<last_publish_times_.size(); i++){
-      last_publish_times_[i] = time;
+    for (controller_instrumentation::PublishSchedule& schedule : publish_schedules_){
+      schedule.reset(time);
+    }
+    for (FilteredOutput& output : filtered_outputs_){
+      for (controller_instrumentation::PublishSchedule& schedule : output.publish_schedules){
+        schedule.reset(time);
+      }
+    }
+
+    // restart filtering from the current reading, the bias is kept
+    for (unsigned i=0; i<filters_.size(); i++){
+      filters_[i].reset(sensors_[i].getForce(), sensors_[i].getTorque());
     }
   }
 
   void ForceTorqueSensorController::update(const ros::Time& time, const ros::Duration& /*period*/)
   {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
     // limit rate of publishing
     for (unsigned i=0; i<realtime_pubs_.size(); i++){
-      if (publish_rate_ > 0.0 && last_publish_times_[i] + ros::Duration(1.0/publish_rate_) < time){
+      if (publish_schedules_[i].due(time)){
         // try to publish
-        if (realtime_pubs_[i]->trylock()){
+        if (controller_instrumentation::tracedTrylock(*realtime_pubs_[i], "wrench")){
           // we're actually publishing, so increment time
-          last_publish_times_[i] = last_publish_times_[i] + ros::Duration(1.0/publish_rate_);
+          publish_schedules_[i].advance();
 
           // populate message
           realtime_pubs_[i]->msg_.header.stamp = time;
-          realtime_pubs_[i]->msg_.header.frame_id = sensors_[i].getFrameId();
-
-          realtime_pubs_[i]->msg_.wrench.force.x  = sensors_[i].getForce()[0];
-          realtime_pubs_[i]->msg_.wrench.force.y  = sensors_[i].getForce()[1];
-          realtime_pubs_[i]->msg_.wrench.force.z  = sensors_[i].getForce()[2];
-          realtime_pubs_[i]->msg_.wrench.torque.x = sensors_[i].getTorque()[0];
-          realtime_pubs_[i]->msg_.wrench.torque.y = sensors_[i].getTorque()[1];
-          realtime_pubs_[i]->msg_.wrench.torque.z = sensors_[i].getTorque()[2];
+          fillMessage(sensors_[i], realtime_pubs_[i]->msg_);
 
           realtime_pubs_[i]->unlockAndPublish();
         }
       }
     }
+
+    if (filtered_outputs_.empty())
+      return;
+
+    // filter every cycle, whichever outputs are published
+    for (unsigned i=0; i<filters_.size(); i++){
+      filters_[i].update(sensors_[i].getForce(), sensors_[i].getTorque());
+    }
+    for (ToolCompensation& compensation : tool_compensations_){
+      if (compensation.use_imu){
+        compensation.gravity.updateImuOrientation(compensation.imu.getOrientation());
+        filters_[compensation.sensor].setLoad(compensation.gravity.load());
+      }
+    }
+    if (tare_requested_.exchange(false)){
+      for (WrenchFilter& filter : filters_)
+        filter.tare();
+    }
+    if (clear_bias_requested_.exchange(false)){
+      for (WrenchFilter& filter : filters_)
+        filter.clearBias();
+    }
+
+    for (FilteredOutput& output : filtered_outputs_){
+      for (unsigned i=0; i<output.realtime_pubs.size(); i++){
+        if (output.publish_schedules[i].due(time) && controller_instrumentation::tracedTrylock(*output.realtime_pubs[i], output.name.c_str())){
+          output.publish_schedules[i].advance();
+
+          output.realtime_pubs[i]->msg_.header.stamp = time;
+          fillMessage(filters_[i], output.realtime_pubs[i]->msg_);
+
+          output.realtime_pubs[i]->unlockAndPublish();
+        }
+      }
+    }
   }
 
   void ForceTorqueSensorController::stopping(const ros::Time& /*time*/)
   {}
 
+  void ForceTorqueSensorController::fillMessage(const hardware_interface::ForceTorqueSensorHandle& sensor,
+                                                geometry_msgs::WrenchStamped& msg)
+  {
+    msg.wrench.force.x  = sensor.getForce()[0];
+    msg.wrench.force.y  = sensor.getForce()[1];
+    msg.wrench.force.z  = sensor.getForce()[2];
+    msg.wrench.torque.x = sensor.getTorque()[0];
+    msg.wrench.torque.y = sensor.getTorque()[1];
+    msg.wrench.torque.z = sensor.getTorque()[2];
+  }
+
+  void ForceTorqueSensorController::fillMessage(const WrenchFilter& filter, geometry_msgs::WrenchStamped& msg)
+  {
+    msg.wrench.force.x  = filter[0];
+    msg.wrench.force.y  = filter[1];
+    msg.wrench.force.z  = filter[2];
+    msg.wrench.torque.x = filter[3];
+    msg.wrench.torque.y = filter[4];
+    msg.wrench.torque.z = filter[5];
+  }
+
+  bool ForceTorqueSensorController::tareCb(std_srvs::Trigger::Request& /*req*/, std_srvs::Trigger::Response& resp)
+  {
+    tare_requested_.store(true);
+    resp.success = true;
+    resp.message = "Filtered wrenches will be tared in the next update";
+    return true;
+  }
+
+  bool ForceTorqueSensorController::clearBiasCb(std_srvs::Trigger::Request& /*req*/, std_srvs::Trigger::Response& resp)
+  {
+    clear_bias_requested_.store(true);
+    resp.success = true;
+    resp.message = "Bias of the filtered wrenches will be cleared in the next update";
+    return true;
+  }
+
 }
 
 PLUGINLIB_EXPORT_CLASS(force_torque_sensor_controller::ForceTorqueSensorController, controller_interface::ControllerBase)
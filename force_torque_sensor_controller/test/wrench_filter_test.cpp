@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <force_torque_sensor_controller/wrench_filter.h>
+
+using force_torque_sensor_controller::Biquad;
+using force_torque_sensor_controller::GravityCompensation;
+using force_torque_sensor_controller::WrenchFilter;
+
+namespace
+{
+const double EPS = 1e-9;
+const double SAMPLE_RATE = 1000.0;
+}
+
+TEST(BiquadTest, DefaultPassesThrough)
+{
+  Biquad biquad;
+  EXPECT_DOUBLE_EQ(1.5, biquad.filter(1.5));
+  EXPECT_DOUBLE_EQ(-3.0, biquad.filter(-3.0));
+}
+
+TEST(BiquadTest, ResetIsSteadyState)
+{
+  Biquad biquad;
+  biquad.lowPass(50.0, SAMPLE_RATE);
+  biquad.reset(2.0);
+  for (unsigned i = 0; i < 100; ++i)
+    EXPECT_NEAR(2.0, biquad.filter(2.0), EPS);
+}
+
+TEST(BiquadTest, ConvergesToStep)
+{
+  Biquad biquad;
+  biquad.lowPass(50.0, SAMPLE_RATE);
+  double y = 0.0;
+  for (unsigned i = 0; i < 1000; ++i)
+    y = biquad.filter(1.0);
+  EXPECT_NEAR(1.0, y, EPS);
+}
+
+TEST(BiquadTest, AttenuatesAboveCutoff)
+{
+  // Amplitude of the steady state response to a sine, with -3 dB at the cutoff
+  const double cutoff = 50.0;
+  const double frequencies[] = {5.0, cutoff, 250.0};
+  double gains[3];
+  for (unsigned k = 0; k < 3; ++k)
+  {
+    Biquad biquad;
+    biquad.lowPass(cutoff, SAMPLE_RATE);
+    double amplitude = 0.0;
+    for (unsigned i = 0; i < 4000; ++i)
+    {
+      const double y = biquad.filter(std::sin(2.0 * M_PI * frequencies[k] * i / SAMPLE_RATE));
+      if (i >= 2000)
+        amplitude = std::max(amplitude, std::abs(y));
+    }
+    gains[k] = amplitude;
+  }
+  EXPECT_NEAR(1.0, gains[0], 1e-2);
+  EXPECT_NEAR(1.0 / std::sqrt(2.0), gains[1], 1e-2);
+  EXPECT_LT(gains[2], 0.05);
+}
+
+TEST(WrenchFilterTest, TareAndClearBias)
+{
+  const double force[3]  = {1.0, 2.0, 3.0};
+  const double torque[3] = {-0.1, -0.2, -0.3};
+
+  WrenchFilter filter;
+  filter.lowPass(50.0, SAMPLE_RATE);
+  filter.reset(force, torque);
+  filter.update(force, torque);
+  for (unsigned i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(force[i], filter[i], EPS);
+    EXPECT_NEAR(torque[i], filter[i + 3], EPS);
+  }
+
+  filter.tare();
+  filter.update(force, torque);
+  for (unsigned i = 0; i < 6; ++i)
+    EXPECT_NEAR(0.0, filter[i], EPS);
+
+  filter.clearBias();
+  for (unsigned i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(force[i], filter[i], EPS);
+    EXPECT_NEAR(torque[i], filter[i + 3], EPS);
+  }
+}
+
+TEST(WrenchFilterTest, TareKeepsLoad)
+{
+  const double force[3]  = {1.0, 2.0, 3.0};
+  const double torque[3] = {-0.1, -0.2, -0.3};
+  const std::array<double, 6> load = {{0.5, 0.0, 1.0, 0.0, 0.1, 0.0}};
+
+  WrenchFilter filter;
+  filter.reset(force, torque);
+  filter.setLoad(load);
+  filter.update(force, torque);
+  for (unsigned i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(force[i] - load[i], filter[i], EPS);
+    EXPECT_NEAR(torque[i] - load[i + 3], filter[i + 3], EPS);
+  }
+
+  // The bias excludes the load, which is still compensated when it changes
+  filter.tare();
+  for (unsigned i = 0; i < 6; ++i)
+    EXPECT_NEAR(0.0, filter[i], EPS);
+  filter.setLoad(std::array<double, 6>());
+  for (unsigned i = 0; i < 6; ++i)
+    EXPECT_NEAR(load[i], filter[i], EPS);
+}
+
+TEST(GravityCompensationTest, FixedGravity)
+{
+  const double g = 9.80665;
+  GravityCompensation compensation;
+  compensation.setTool(2.0, {{0.0, 0.0, 0.1}});
+
+  // Sensor z axis up, the center of mass on it: no torque
+  for (unsigned i = 0; i < 6; ++i)
+    EXPECT_NEAR(i == 2 ? -2.0 * g : 0.0, compensation.load()[i], EPS);
+
+  // Sensor x axis up: torque about y
+  compensation.setGravity(-g, 0.0, 0.0);
+  const std::array<double, 6>& load = compensation.load();
+  EXPECT_NEAR(-2.0 * g, load[0], EPS);
+  EXPECT_NEAR(0.0, load[1], EPS);
+  EXPECT_NEAR(0.0, load[2], EPS);
+  EXPECT_NEAR(0.0, load[3], EPS);
+  EXPECT_NEAR(0.1 * -2.0 * g, load[4], EPS);
+  EXPECT_NEAR(0.0, load[5], EPS);
+}
+
+TEST(GravityCompensationTest, FollowsImuOrientation)
+{
+  const double g = 9.80665;
+  const double s = std::sin(M_PI / 4.0), c = std::cos(M_PI / 4.0);
+  GravityCompensation compensation;
+  compensation.setTool(1.0, {{0.0, 0.0, 0.0}});
+
+  // IMU frame aligned with the sensor, pitched by 90 degrees: the sensor x axis points down
+  const double pitched[4] = {0.0, s, 0.0, c};
+  compensation.updateImuOrientation(pitched);
+  EXPECT_NEAR(g, compensation.load()[0], EPS);
+  EXPECT_NEAR(0.0, compensation.load()[1], EPS);
+  EXPECT_NEAR(0.0, compensation.load()[2], EPS);
+
+  // IMU mounted yawed by 90 degrees on the sensor: IMU x is sensor y
+  ASSERT_TRUE(compensation.setImuRotation(0.0, 0.0, s, c));
+  compensation.updateImuOrientation(pitched);
+  EXPECT_NEAR(0.0, compensation.load()[0], EPS);
+  EXPECT_NEAR(g, compensation.load()[1], EPS);
+  EXPECT_NEAR(0.0, compensation.load()[2], EPS);
+
+  // Only the direction of gravity matters, not the heading of the IMU
+  const double level_yawed[4] = {0.0, 0.0, s, c};
+  compensation.updateImuOrientation(level_yawed);
+  EXPECT_NEAR(0.0, compensation.load()[0], EPS);
+  EXPECT_NEAR(0.0, compensation.load()[1], EPS);
+  EXPECT_NEAR(-g, compensation.load()[2], EPS);
+
+  EXPECT_FALSE(compensation.setImuRotation(0.0, 0.0, 0.0, 0.0));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Compares the position errors of a group of revolute, continuous and prismatic joints computed joint by joint, with
+// the branching on the URDF joint type the position controllers used to do, against JointPositionErrors.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <angles/angles.h>
+#include <forward_command_controller/joint_position_errors.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using forward_command_controller::JointPositionErrors;
+
+namespace
+{
+
+/** Robot with \p size joints, cycling through the revolute, continuous and prismatic types. */
+bool makeUrdf(unsigned int size, urdf::Model& urdf, std::vector<std::string>& joint_names)
+{
+  static const char* const TYPES[] = {"revolute", "continuous", "prismatic"};
+
+  std::ostringstream xml;
+  xml << "<robot name=\"bench\"><link name=\"link0\"/>";
+  joint_names.clear();
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    joint_names.push_back("joint" + std::to_string(i));
+    xml << "<link name=\"link" << i + 1 << "\"/>"
+        << "<joint name=\"" << joint_names.back() << "\" type=\"" << TYPES[i % 3] << "\">"
+        << "<parent link=\"link" << i << "\"/><child link=\"link" << i + 1 << "\"/>"
+        << "<axis xyz=\"0 0 1\"/><limit lower=\"-2.5\" upper=\"2.5\" effort=\"1\" velocity=\"1\"/></joint>";
+  }
+  xml << "</robot>";
+  return urdf.initString(xml.str());
+}
+
+/** Joint positions within the limits, and commands partly beyond them. */
+void makeState(unsigned int size, std::vector<double>& positions, std::vector<double>& commands)
+{
+  positions.resize(size);
+  commands.resize(size);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    positions[i] = 2.0 * std::sin(0.7 * i);
+    commands[i]  = 3.0 * std::cos(1.3 * i);
+  }
+}
+
+} // namespace
+
+static void BM_PerJointUrdfType(benchmark::State& state)
+{
+  const unsigned int size = state.range(0);
+  urdf::Model urdf;
+  std::vector<std::string> joint_names;
+  if (!makeUrdf(size, urdf, joint_names)) {state.SkipWithError("Invalid URDF"); return;}
+  std::vector<urdf::JointConstSharedPtr> joints;
+  for (const std::string& name : joint_names) {joints.push_back(urdf.getJoint(name));}
+
+  std::vector<double> positions, commands, command_positions(size), errors(size);
+  makeState(size, positions, commands);
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      const urdf::Joint& joint = *joints[i];
+      double command = commands[i];
+      if (joint.type == urdf::Joint::REVOLUTE || joint.type == urdf::Joint::PRISMATIC)
+      {
+        command = std::min(std::max(command, joint.limits->lower), joint.limits->upper);
+      }
+      if (joint.type == urdf::Joint::REVOLUTE)
+      {
+        angles::shortest_angular_distance_with_limits(positions[i], command, joint.limits->lower,
+                                                      joint.limits->upper, errors[i]);
+      }
+      else if (joint.type == urdf::Joint::CONTINUOUS)
+      {
+        errors[i] = angles::shortest_angular_distance(positions[i], command);
+      }
+      else
+      {
+        errors[i] = command - positions[i];
+      }
+      command_positions[i] = command;
+    }
+    benchmark::DoNotOptimize(errors.data());
+    benchmark::DoNotOptimize(command_positions.data());
+  }
+  allocations.report(state);
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_PerJointUrdfType)->Arg(6)->Arg(60);
+
+static void BM_JointPositionErrors(benchmark::State& state)
+{
+  const unsigned int size = state.range(0);
+  urdf::Model urdf;
+  std::vector<std::string> joint_names;
+  JointPositionErrors<> position_errors;
+  if (!makeUrdf(size, urdf, joint_names) || !position_errors.init(urdf, joint_names))
+  {
+    state.SkipWithError("Invalid URDF");
+    return;
+  }
+
+  std::vector<double> positions, commands, command_positions(size), errors(size);
+  makeState(size, positions, commands);
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    std::copy(commands.begin(), commands.end(), command_positions.begin());
+    position_errors.compute(positions.data(), command_positions.data(), errors.data());
+    benchmark::DoNotOptimize(errors.data());
+    benchmark::DoNotOptimize(command_positions.data());
+  }
+  allocations.report(state);
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_JointPositionErrors)->Arg(6)->Arg(60);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,217 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef FORWARD_COMMAND_CONTROLLER_COMMAND_INTERPOLATOR_H
+#define FORWARD_COMMAND_CONTROLLER_COMMAND_INTERPOLATOR_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <ros/node_handle.h>
+#include <ros/time.h>
+
+namespace forward_command_controller
+{
+
+/**
+ * \brief Interpolation of a command array received at a lower rate than the controller update rate.
+ *
+ * Each new command starts a segment from the current output to the new command, lasting the time elapsed since the
+ * previous command, so that a steady command stream is followed with one command period of delay. A linear segment
+ * keeps the output continuous. A cubic (Hermite) segment also keeps its rate of change continuous, and ends with the
+ * rate of change of the last two commands.
+ *
+ * \section ROS interface
+ *
+ * \param command_interpolation \c "none" (default), \c "linear" or \c "cubic".
+ * \param command_interpolation_max_duration Maximum duration of a segment [s], bounding the delay after a pause of
+ * the command stream. Defaults to 0.1.
+ */
+class CommandInterpolator
+{
+public:
+  enum Mode
+  {
+    NONE,
+    LINEAR,
+    CUBIC
+  };
+
+  CommandInterpolator() : mode_(NONE), max_duration_(0.1), duration_(0.0) {}
+
+  /**
+   * \brief Configure the interpolation from the ROS parameters of \p nh, and allocate the state of \p size commands.
+   * \return False if the parameters are invalid.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh, unsigned int size)
+  {
+    std::string mode = "none";
+    nh.getParam("command_interpolation", mode);
+    if      (mode == "none")   {mode_ = NONE;}
+    else if (mode == "linear") {mode_ = LINEAR;}
+    else if (mode == "cubic")  {mode_ = CUBIC;}
+    else
+    {
+      ROS_ERROR_STREAM("Unknown command interpolation '" << mode << "', expected 'none', 'linear' or 'cubic'.");
+      return false;
+    }
+
+    nh.getParam("command_interpolation_max_duration", max_duration_);
+    if (!(max_duration_ > 0.0))
+    {
+      ROS_ERROR_STREAM("Command interpolation max duration must be positive, got " << max_duration_ << ".");
+      return false;
+    }
+
+    start_.assign(size, 0.0);
+    start_rate_.assign(size, 0.0);
+    end_.assign(size, 0.0);
+    end_rate_.assign(size, 0.0);
+    output_.assign(size, 0.0);
+    return true;
+  }
+
+  /** \return True if commands are interpolated. */
+  bool enabled() const {return mode_ != NONE;}
+
+  /**
+   * \brief Hold \p command from \p time on, e.g. when starting the controller.
+   * \note This method is realtime-safe.
+   */
+  void reset(const std::vector<double>& command, const ros::Time& time)
+  {
+    std::copy(command.begin(), command.end(), end_.begin());
+    std::fill(end_rate_.begin(), end_rate_.end(), 0.0);
+    start_time_   = time;
+    command_time_ = time;
+    duration_     = 0.0;
+  }
+
+  /**
+   * \brief Start a segment to the new \p command, received at \p time.
+   * \note This method is realtime-safe.
+   */
+  void setCommand(const std::vector<double>& command, const ros::Time& time)
+  {
+    const double duration = std::min((time - command_time_).toSec(), max_duration_);
+    const double s = phase(time);
+    // The command stream paused if the segment ended well before this command, so the output is at rest
+    const bool paused = (time - start_time_).toSec() > 2.0 * duration_;
+    for (unsigned int i = 0; i < end_.size(); ++i)
+    {
+      double rate;
+      start_[i]      = evaluate(i, s, rate);
+      start_rate_[i] = paused ? 0.0 : rate;
+      end_rate_[i]   = duration > 0.0 ? (command[i] - end_[i]) / duration : 0.0;
+      end_[i]        = command[i];
+    }
+    start_time_   = time;
+    command_time_ = time;
+    duration_     = duration;
+  }
+
+  /**
+   * \return Interpolated command at \p time.
+   * \note This method is realtime-safe.
+   */
+  const std::vector<double>& sample(const ros::Time& time)
+  {
+    const double s = phase(time);
+    double rate;
+    for (unsigned int i = 0; i < output_.size(); ++i) {output_[i] = evaluate(i, s, rate);}
+    return output_;
+  }
+
+private:
+  Mode   mode_;
+  double max_duration_; ///< [s]
+
+  // Current segment, from start_ to end_
+  std::vector<double> start_;
+  std::vector<double> start_rate_; ///< Rate of change at the segment start [1/s].
+  std::vector<double> end_;        ///< Last command.
+  std::vector<double> end_rate_;   ///< Rate of change of the last two commands [1/s].
+  ros::Time           start_time_;
+  ros::Time           command_time_; ///< Time the last command was received.
+  double              duration_;     ///< [s]
+
+  std::vector<double> output_;
+
+  /** \return Progress along the current segment at \p time, in [0, 1]. */
+  double phase(const ros::Time& time) const
+  {
+    if (!(duration_ > 0.0)) {return 1.0;}
+    return std::min(std::max((time - start_time_).toSec() / duration_, 0.0), 1.0);
+  }
+
+  /** \return Value of command \p i at phase \p s of the current segment, and its rate of change in \p rate. */
+  double evaluate(unsigned int i, double s, double& rate) const
+  {
+    if (!(duration_ > 0.0))
+    {
+      rate = end_rate_[i];
+      return end_[i];
+    }
+
+    if (mode_ == LINEAR)
+    {
+      rate = (end_[i] - start_[i]) / duration_;
+      return start_[i] + (end_[i] - start_[i]) * s;
+    }
+
+    // Cubic Hermite basis functions and their derivatives
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = s3 - 2.0 * s2 + s;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = s3 - s2;
+    const double dh00 = 6.0 * s2 - 6.0 * s;
+    const double dh10 = 3.0 * s2 - 4.0 * s + 1.0;
+    const double dh01 = -6.0 * s2 + 6.0 * s;
+    const double dh11 = 3.0 * s2 - 2.0 * s;
+
+    const double t0 = duration_ * start_rate_[i];
+    const double t1 = duration_ * end_rate_[i];
+    rate = (dh00 * start_[i] + dh10 * t0 + dh01 * end_[i] + dh11 * t1) / duration_;
+    return h00 * start_[i] + h10 * t0 + h01 * end_[i] + h11 * t1;
+  }
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,160 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef FORWARD_COMMAND_CONTROLLER_COMMAND_LIMITER_H
+#define FORWARD_COMMAND_CONTROLLER_COMMAND_LIMITER_H
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <ros/node_handle.h>
+
+namespace forward_command_controller
+{
+
+/**
+ * \brief Per-joint limits on the rate of change of a command array, e.g. the acceleration and jerk of velocity
+ * commands.
+ *
+ * The jerk limit bounds the change of the command rate from one update to the next, and the acceleration limit bounds
+ * the command rate itself, so that command steps are turned into smooth ramps. Joints without limits are forwarded
+ * unchanged.
+ *
+ * The limits are clamped as by diff_drive_controller::SpeedLimiter, except for the jerk step: the second difference of
+ * the command is bounded by \c max_jerk * dt^2, where SpeedLimiter uses 2 * jerk * dt^2. A \c max_jerk limit is thus
+ * the same as a SpeedLimiter jerk limit of \c max_jerk / 2.
+ *
+ * \section ROS interface
+ *
+ * \param command_limits/<joint>/max_acceleration Maximum rate of change of the command of \c <joint> [unit/s].
+ * Unlimited by default.
+ * \param command_limits/<joint>/max_jerk Maximum second derivative of the command of \c <joint> [unit/s^2].
+ * Unlimited by default.
+ */
+class CommandLimiter
+{
+public:
+  CommandLimiter() : enabled_(false) {}
+
+  /**
+   * \brief Read the limits of \p joint_names from the ROS parameters of \p nh, and allocate their state.
+   * \return False if the parameters are invalid.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh, const std::vector<std::string>& joint_names)
+  {
+    const double inf = std::numeric_limits<double>::infinity();
+    max_acceleration_.assign(joint_names.size(), inf);
+    max_jerk_.assign(joint_names.size(), inf);
+    v0_.assign(joint_names.size(), 0.0);
+    v1_.assign(joint_names.size(), 0.0);
+    enabled_ = false;
+
+    for (unsigned int i = 0; i < joint_names.size(); ++i)
+    {
+      const std::string ns = "command_limits/" + joint_names[i] + "/";
+      if (!readLimit(nh, ns + "max_acceleration", max_acceleration_[i]) ||
+          !readLimit(nh, ns + "max_jerk", max_jerk_[i]))
+      {
+        return false;
+      }
+      enabled_ = enabled_ || max_acceleration_[i] < inf || max_jerk_[i] < inf;
+    }
+    return true;
+  }
+
+  /** \return True if the command of at least one joint is limited. */
+  bool enabled() const {return enabled_;}
+
+  /**
+   * \brief Hold \p command at rest, e.g. when starting the controller.
+   * \note This method is realtime-safe.
+   */
+  void reset(const std::vector<double>& command)
+  {
+    std::copy(command.begin(), command.end(), v0_.begin());
+    std::copy(command.begin(), command.end(), v1_.begin());
+  }
+
+  /**
+   * \return \p command of joint \p i, limited with respect to the commands of the two previous updates, \p dt seconds
+   * apart. The previous command is held if \p dt is not positive.
+   * \note This method is realtime-safe.
+   */
+  double limit(unsigned int i, double command, double dt)
+  {
+    if (!(dt > 0.0)) {return v0_[i];}
+
+    // Jerk first, so that the acceleration limit is enforced on the final rate
+    const double predicted = 2.0 * v0_[i] - v1_[i];
+    const double dv_jerk = max_jerk_[i] * dt * dt;
+    double v = clamp(command, predicted - dv_jerk, predicted + dv_jerk);
+
+    const double dv_acc = max_acceleration_[i] * dt;
+    v = clamp(v, v0_[i] - dv_acc, v0_[i] + dv_acc);
+
+    v1_[i] = v0_[i];
+    v0_[i] = v;
+    return v;
+  }
+
+private:
+  bool enabled_;
+  std::vector<double> max_acceleration_; ///< [unit/s]
+  std::vector<double> max_jerk_;         ///< [unit/s^2]
+
+  std::vector<double> v0_; ///< Command of the previous update.
+  std::vector<double> v1_; ///< Command of the update before.
+
+  static double clamp(double x, double min, double max) {return std::min(std::max(x, min), max);}
+
+  static bool readLimit(const ros::NodeHandle& nh, const std::string& name, double& limit)
+  {
+    if (!nh.getParam(name, limit)) {return true;}
+    if (!(limit > 0.0))
+    {
+      ROS_ERROR_STREAM("Command limit '" << name << "' must be positive, got " << limit << ".");
+      return false;
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,229 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef FORWARD_COMMAND_CONTROLLER_COMMAND_TIMEOUT_H
+#define FORWARD_COMMAND_CONTROLLER_COMMAND_TIMEOUT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <ros/node_handle.h>
+#include <ros/time.h>
+#include <ros/timer.h>
+
+namespace forward_command_controller
+{
+
+/**
+ * \brief Command published by a non-realtime callback together with the time it was received at, so that the realtime
+ * thread reads both at once and never pairs a command with the stamp of another.
+ * \tparam T Command data type.
+ */
+template <class T>
+struct StampedCommand
+{
+  StampedCommand() : data(), stamp() {}
+  StampedCommand(const T& data, const ros::Time& stamp) : data(data), stamp(stamp) {}
+
+  T         data;
+  ros::Time stamp; ///< Time the command was received at.
+};
+
+/**
+ * \brief Timeout of the commands of a controller.
+ *
+ * Non-realtime command callbacks publish each command with its receive time as a \ref StampedCommand. The realtime
+ * thread passes the stamp of the command it read to commandReceived(), then compares the time of the update cycle with
+ * the latest stamp in expired(). Once the last command is older than the timeout, fallback() gives the value to apply
+ * instead of it.
+ * Expiries are counted, and reported by a non-realtime timer.
+ *
+ * \section ROS interface
+ *
+ * \param command_timeout Maximum age of the applied command [s]. Zero (default) disables the timeout.
+ * \param command_timeout_action What to apply when the command times out: \c "hold" (default) the last command,
+ * \c "zero", or \c "ramp" the last command linearly down to zero. Zeroing is meant for velocity and effort commands.
+ * \param command_timeout_ramp_duration Duration of the ramp to zero [s]. Defaults to 1.0.
+ */
+class CommandTimeout
+{
+public:
+  enum Action
+  {
+    HOLD,
+    ZERO,
+    RAMP
+  };
+
+  CommandTimeout()
+    : timeout_(std::numeric_limits<std::int64_t>::max()), action_(HOLD), ramp_duration_(1.0), last_stamp_(0),
+      expired_(false), expiry_count_(0), reported_expiry_count_(0) {}
+
+  /**
+   * \brief Configure the timeout from the ROS parameters of \p nh.
+   * \return False if the parameters are invalid.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const ros::NodeHandle& nh)
+  {
+    double timeout = 0.0;
+    nh.getParam("command_timeout", timeout);
+    if (timeout < 0.0)
+    {
+      ROS_ERROR_STREAM("Command timeout must be non-negative, got " << timeout << ".");
+      return false;
+    }
+    timeout_ = timeout > 0.0 ? ros::Duration(timeout).toNSec() : std::numeric_limits<std::int64_t>::max();
+
+    std::string action = "hold";
+    nh.getParam("command_timeout_action", action);
+    if      (action == "hold") {action_ = HOLD;}
+    else if (action == "zero") {action_ = ZERO;}
+    else if (action == "ramp") {action_ = RAMP;}
+    else
+    {
+      ROS_ERROR_STREAM("Unknown command timeout action '" << action << "', expected 'hold', 'zero' or 'ramp'.");
+      return false;
+    }
+
+    nh.getParam("command_timeout_ramp_duration", ramp_duration_);
+    if (!(ramp_duration_ > 0.0))
+    {
+      ROS_ERROR_STREAM("Command timeout ramp duration must be positive, got " << ramp_duration_ << ".");
+      return false;
+    }
+
+    expiry_count_.store(0, std::memory_order_relaxed);
+    reported_expiry_count_ = 0;
+    expiry_timer_.stop();
+    if (timeout > 0.0)
+    {
+      expiry_timer_ = nh.createTimer(ros::Duration(EXPIRY_REPORT_PERIOD), &CommandTimeout::reportExpiryCB, this);
+    }
+    return true;
+  }
+
+  /**
+   * \brief Consider the current command as received at \p time, e.g. when starting the controller.
+   * \note This method is realtime-safe.
+   */
+  void reset(const ros::Time& time)
+  {
+    last_stamp_ = time.toNSec();
+    expired_ = false;
+  }
+
+  /**
+   * \brief Consider the command read in the current update cycle as received at \p stamp. Stamps older than the latest
+   * one, e.g. of a command read again or written before reset(), are ignored.
+   * \note This method is realtime-safe, and must only be called from the realtime thread.
+   */
+  void commandReceived(const ros::Time& stamp)
+  {
+    last_stamp_ = std::max(last_stamp_, static_cast<std::int64_t>(stamp.toNSec()));
+  }
+
+  /**
+   * \return True if the last command is older than the timeout at \p time. Always false if the timeout is disabled.
+   * \note This method is realtime-safe, and must only be called from the realtime thread.
+   */
+  bool expired(const ros::Time& time)
+  {
+    const std::int64_t age = static_cast<std::int64_t>(time.toNSec()) - last_stamp_;
+    if (age <= timeout_)
+    {
+      expired_ = false;
+      return false;
+    }
+
+    if (!expired_)
+    {
+      expiry_count_.store(expiry_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      expired_ = true;
+    }
+    return true;
+  }
+
+  /** \return Number of times the command expired since init(). */
+  std::uint64_t expiryCount() const {return expiry_count_.load(std::memory_order_relaxed);}
+
+  /**
+   * \return Value to apply instead of the \p command that expired() at \p time.
+   * \note This method is realtime-safe.
+   */
+  double fallback(double command, const ros::Time& time) const
+  {
+    switch (action_)
+    {
+      case ZERO:
+        return 0.0;
+      case RAMP:
+      {
+        const std::int64_t since_expiry = static_cast<std::int64_t>(time.toNSec()) - last_stamp_ - timeout_;
+        return command * std::max(0.0, 1.0 - since_expiry * 1e-9 / ramp_duration_);
+      }
+      default:
+        return command;
+    }
+  }
+
+private:
+  static constexpr double EXPIRY_REPORT_PERIOD = 1.0; ///< Period at which expiries are reported [s].
+
+  std::int64_t               timeout_;       ///< Timeout [ns], the largest value when disabled.
+  Action                     action_;
+  double                     ramp_duration_; ///< [s]
+  std::int64_t               last_stamp_;    ///< Time of the last command [ns].
+  bool                       expired_;       ///< Whether the last call to expired() returned true.
+  std::atomic<std::uint64_t> expiry_count_;
+  std::uint64_t              reported_expiry_count_;
+  ros::Timer                 expiry_timer_;
+
+  void reportExpiryCB(const ros::TimerEvent&)
+  {
+    const std::uint64_t expiry_count = expiryCount();
+    if (expiry_count == reported_expiry_count_) {return;}
+    ROS_WARN("Command timed out %lu time(s) after %.3fs, the last command is no longer applied as is.",
+             static_cast<unsigned long>(expiry_count - reported_expiry_count_), timeout_ * 1e-9);
+    reported_expiry_count_ = expiry_count;
+  }
+};
+
+} // namespace
+
+#endif
@@ -43,6 +43,10 @@
 #include <controller_interface/controller.h>
 #include <std_msgs/Float64.h>
 #include <realtime_tools/realtime_buffer.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/shared_command.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <forward_command_controller/command_timeout.h>
 
 
 namespace forward_command_controller
@@ -61,6 +65,9 @@ namespace forward_command_controller
  *
  * \param type hardware interface type.
  * \param joint Name of the joint to control.
+ * \param shared_command_name Optional shared memory command, see \ref controller_instrumentation::SharedCommandSource.
+ * The latest command of either the topic or the shared memory is applied.
+ * \param command_timeout Optional timeout of the command, see \ref CommandTimeout.
  *
  * Subscribes to:
  * - \b command (std_msgs::Float64) : The joint command to apply.
@@ -74,6 +81,10 @@ public:
 
   bool init(T* hw, ros::NodeHandle &n)
   {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(n);
+    if (!thread_placement_scope) {return false;}
+
     std::string joint_name;
     if (!n.getParam("joint", joint_name))
     {
@@ -81,19 +92,38 @@ public:
       return false;
     }
     joint_ = hw->getHandle(joint_name);
+    if (!shared_command_.init(n, 1) || !command_timeout_.init(n)) {return false;}
     sub_command_ = n.subscribe<std_msgs::Float64>("command", 1, &ForwardCommandController::commandCB, this);
+    rt_audit_.init(n);
     return true;
   }
 
   void starting(const ros::Time& time);
-  void update(const ros::Time& /*time*/, const ros::Duration& /*period*/) {joint_.setCommand(*command_buffer_.readFromRT());}
+  void update(const ros::Time& time, const ros::Duration& /*period*/)
+  {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+    StampedCommand<double>& command = *command_buffer_.readFromRT();
+    command_timeout_.commandReceived(command.stamp);
+    // A new shared command replaces the one read from the topic, until a newer command arrives on either
+    if (shared_command_.read(&command.data) == controller_instrumentation::SharedCommandSource::UPDATED)
+    {
+      command_timeout_.commandReceived(time);
+    }
+    joint_.setCommand(command_timeout_.expired(time) ? command_timeout_.fallback(command.data, time) : command.data);
+  }
 
   hardware_interface::JointHandle joint_;
-  realtime_tools::RealtimeBuffer<double> command_buffer_;
+  realtime_tools::RealtimeBuffer<StampedCommand<double> > command_buffer_;
 
 private:
   ros::Subscriber sub_command_;
-  void commandCB(const std_msgs::Float64ConstPtr& msg) {command_buffer_.writeFromNonRT(msg->data);}
+  controller_instrumentation::RealtimeAudit rt_audit_;
+  controller_instrumentation::SharedCommandSource shared_command_;
+  CommandTimeout command_timeout_;
+  void commandCB(const std_msgs::Float64ConstPtr& msg)
+  {
+    command_buffer_.writeFromNonRT(StampedCommand<double>(msg->data, ros::Time::now()));
+  }
 };
 
 }
@@ -39,6 +39,7 @@
 #ifndef FORWARD_COMMAND_CONTROLLER_FORWARD_JOINT_GROUP_COMMAND_CONTROLLER_H
 #define FORWARD_COMMAND_CONTROLLER_FORWARD_JOINT_GROUP_COMMAND_CONTROLLER_H
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -46,7 +47,13 @@
 #include <hardware_interface/joint_command_interface.h>
 #include <controller_interface/controller.h>
 #include <std_msgs/Float64MultiArray.h>
-#include <realtime_tools/realtime_buffer.h>
+#include <controller_instrumentation/command_channel.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/shared_command.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <forward_command_controller/command_interpolator.h>
+#include <forward_command_controller/command_limiter.h>
+#include <forward_command_controller/command_timeout.h>
 
 
 namespace forward_command_controller
@@ -65,6 +72,18 @@ namespace forward_command_controller
  *
  * \param type hardware interface type.
  * \param joints Names of the joints to control.
+ * \param command_offset Index of the command of the first joint in the command array, after the \c data_offset of its
+ * layout. When set, the command array may hold more elements, so that several controllers can share a single command
+ * topic, each reading its own slice of the message. Unset by default, in which case the array must only hold the
+ * commands of the controlled joints.
+ * \param shared_command_name Optional shared memory command of all joints, see
+ * \ref controller_instrumentation::SharedCommandSource. The latest command of either the topic or the shared memory is
+ * applied.
+ * \param command_timeout Optional timeout of the commands, see \ref CommandTimeout.
+ * \param command_interpolation Optional interpolation of commands received at a lower rate, see
+ * \ref CommandInterpolator.
+ * \param command_limits Optional per-joint limits on the rate of change of the applied commands, e.g. acceleration
+ * and jerk limits of velocity commands, see \ref CommandLimiter.
  *
  * Subscribes to:
  * - \b command (std_msgs::Float64MultiArray) : The joint commands to apply.
@@ -73,11 +92,15 @@ template <class T>
 class ForwardJointGroupCommandController: public controller_interface::Controller<T>
 {
 public:
-  ForwardJointGroupCommandController() {}
+  ForwardJointGroupCommandController() : n_joints_(0), command_offset_(0), sliced_command_(false) {}
   ~ForwardJointGroupCommandController() {sub_command_.shutdown();}
 
   bool init(T* hw, ros::NodeHandle &n)
   {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(n);
+    if (!thread_placement_scope) {return false;}
+
     // List of controlled joints
     std::string param_name = "joints";
     if(!n.getParam(param_name, joint_names_))
@@ -104,35 +127,98 @@ public:
       }
     }
 
-    commands_buffer_.writeFromNonRT(std::vector<double>(n_joints_, 0.0));
+    int command_offset = 0;
+    sliced_command_ = n.getParam("command_offset", command_offset);
+    if(command_offset < 0)
+    {
+      ROS_ERROR_STREAM("Command offset must be non-negative, got " << command_offset << ".");
+      return false;
+    }
+    command_offset_ = command_offset;
+
+    // All copies of the command are allocated once, and only overwritten afterwards
+    commands_buffer_.initRT(StampedCommand<std::vector<double> >(std::vector<double>(n_joints_, 0.0), ros::Time()));
+    if (!shared_command_.init(n, n_joints_) || !command_timeout_.init(n) || !interpolator_.init(n, n_joints_) ||
+        !limiter_.init(n, joint_names_))
+    {
+      return false;
+    }
 
     sub_command_ = n.subscribe<std_msgs::Float64MultiArray>("command", 1, &ForwardJointGroupCommandController::commandCB, this);
+    rt_audit_.init(n);
     return true;
   }
 
   void starting(const ros::Time& time);
-  void update(const ros::Time& /*time*/, const ros::Duration& /*period*/)
+  void update(const ros::Time& time, const ros::Duration& period)
   {
-    std::vector<double> & commands = *commands_buffer_.readFromRT();
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+    bool new_command;
+    StampedCommand<std::vector<double> > & stamped = *commands_buffer_.readFromRT(new_command);
+    std::vector<double> & received = stamped.data;
+    command_timeout_.commandReceived(stamped.stamp);
+    // A new shared command replaces the one read from the topic, until a newer command arrives on either
+    if (shared_command_.read(received.data()) == controller_instrumentation::SharedCommandSource::UPDATED)
+    {
+      command_timeout_.commandReceived(time);
+      new_command = true;
+    }
+
+    if (interpolator_.enabled() && new_command) {interpolator_.setCommand(received, time);}
+    const std::vector<double> & commands = interpolator_.enabled() ? interpolator_.sample(time) : received;
+
+    const bool expired = command_timeout_.expired(time);
+    const double dt = period.toSec();
     for(unsigned int i=0; i<n_joints_; i++)
-    {  joints_[i].setCommand(commands[i]);  }
+    {
+      const double command = expired ? command_timeout_.fallback(commands[i], time) : commands[i];
+      joints_[i].setCommand(limiter_.enabled() ? limiter_.limit(i, command, dt) : command);
+    }
   }
 
   std::vector< std::string > joint_names_;
   std::vector< hardware_interface::JointHandle > joints_;
-  realtime_tools::RealtimeBuffer<std::vector<double> > commands_buffer_;
+  controller_instrumentation::CommandChannel<StampedCommand<std::vector<double> > > commands_buffer_;
   unsigned int n_joints_;
 
 private:
   ros::Subscriber sub_command_;
-  void commandCB(const std_msgs::Float64MultiArrayConstPtr& msg) 
+  controller_instrumentation::RealtimeAudit rt_audit_;
+  unsigned int command_offset_; ///< Index of the command of the first joint, after the layout data offset.
+  bool sliced_command_;         ///< Whether the command array may hold commands of other controllers.
+  controller_instrumentation::SharedCommandSource shared_command_;
+  CommandTimeout command_timeout_;
+  CommandInterpolator interpolator_;
+  CommandLimiter limiter_;
+
+  /**
+   * \brief Reset the command timeout, interpolation and limits, after starting() set the initial command.
+   * \note This method is realtime-safe.
+   */
+  void resetCommands(const ros::Time& time)
+  {
+    command_timeout_.reset(time);
+    if (interpolator_.enabled()) {interpolator_.reset(commands_buffer_.readFromRT()->data, time);}
+    if (limiter_.enabled()) {limiter_.reset(commands_buffer_.readFromRT()->data);}
+  }
+
+  void commandCB(const std_msgs::Float64MultiArrayConstPtr& msg)
   {
-    if(msg->data.size()!=n_joints_)
-    { 
-      ROS_ERROR_STREAM("Dimension of command (" << msg->data.size() << ") does not match number of joints (" << n_joints_ << ")! Not executing!");
-      return; 
+    const std::size_t begin = static_cast<std::size_t>(msg->layout.data_offset) + command_offset_;
+    if(sliced_command_ ? msg->data.size() < begin + n_joints_ : msg->data.size() != begin + n_joints_)
+    {
+      ROS_ERROR_STREAM("Dimension of command (" << msg->data.size() << ") does not match number of joints (" << n_joints_ << ") at offset " << begin << "! Not executing!");
+      return;
     }
-    commands_buffer_.writeFromNonRT(msg->data);
+
+    // Copy the commands of the controlled joints straight into the preallocated channel
+    const auto commands = msg->data.begin() + begin;
+    const ros::Time stamp = ros::Time::now();
+    commands_buffer_.fillFromNonRT([&commands, &stamp, this](StampedCommand<std::vector<double> >& command)
+    {
+      std::copy(commands, commands + n_joints_, command.data.begin());
+      command.stamp = stamp;
+    });
   }
 };
 
@@ -0,0 +1,172 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef FORWARD_COMMAND_CONTROLLER_JOINT_POSITION_ERRORS_H
+#define FORWARD_COMMAND_CONTROLLER_JOINT_POSITION_ERRORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <angles/angles.h>
+#include <ros/console.h>
+#include <urdf/model.h>
+
+namespace forward_command_controller
+{
+
+/**
+ * \brief Position limits and position errors of a group of joints, flattened from the URDF.
+ *
+ * Commands of revolute and prismatic joints are clamped to their limits. The error from the position of a joint to its
+ * command is the shortest angle for continuous joints, the shortest angle within the limits for revolute joints, and
+ * the difference for other joints, as computed by the \c angles package.
+ *
+ * compute() processes all joints in a single branch-free loop over contiguous arrays, selecting the wrapped or plain
+ * difference with per-joint flags set in init(). Within limits spanning at most one turn, the shortest angle of a
+ * revolute joint is the plain difference, so only revolute joints outside their limits, or with wider limits, fall
+ * back to \c angles::shortest_angular_distance_with_limits.
+ *
+ * \tparam Scalar Type of positions and errors.
+ */
+template <class Scalar = double>
+class JointPositionErrors
+{
+public:
+  /**
+   * \brief Flatten the types and limits of the joints \p joint_names of \p urdf.
+   * \return False if a joint is not in \p urdf, or is a revolute or prismatic joint without limits.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(const urdf::Model& urdf, const std::vector<std::string>& joint_names)
+  {
+    const std::size_t size = joint_names.size();
+    lower_.assign(size, -std::numeric_limits<Scalar>::infinity());
+    upper_.assign(size, std::numeric_limits<Scalar>::infinity());
+    wrapped_.assign(size, 0);
+    within_turn_.assign(size, 0);
+    revolute_ids_.clear();
+
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      const std::string& joint_name = joint_names[i];
+      urdf::JointConstSharedPtr joint_urdf = urdf.getJoint(joint_name);
+      if (!joint_urdf)
+      {
+        ROS_ERROR("Could not find joint '%s' in urdf", joint_name.c_str());
+        return false;
+      }
+
+      // Only revolute and prismatic joints are limited, continuous joints have their error wrapped
+      if (joint_urdf->type == urdf::Joint::REVOLUTE || joint_urdf->type == urdf::Joint::PRISMATIC)
+      {
+        if (!joint_urdf->limits)
+        {
+          ROS_ERROR("Joint '%s' has no limits in urdf", joint_name.c_str());
+          return false;
+        }
+        lower_[i] = joint_urdf->limits->lower;
+        upper_[i] = joint_urdf->limits->upper;
+      }
+      if (joint_urdf->type == urdf::Joint::REVOLUTE)
+      {
+        within_turn_[i] = upper_[i] - lower_[i] <= 2.0 * M_PI;
+        revolute_ids_.push_back(i);
+      }
+      else if (joint_urdf->type == urdf::Joint::CONTINUOUS)
+      {
+        wrapped_[i] = 1;
+      }
+    }
+    return true;
+  }
+
+  /** \return Number of joints. */
+  unsigned int size() const {return lower_.size();}
+
+  /**
+   * \return \p command of joint \p i, clamped to its limits if applicable. A NaN command stays NaN.
+   * \note This method is realtime-safe.
+   */
+  Scalar clamp(unsigned int i, Scalar command) const
+  {
+    // Joints without limits have infinite ones. The command comes first so that a NaN command stays NaN
+    return std::min(std::max(command, lower_[i]), upper_[i]);
+  }
+
+  /**
+   * \brief Clamp the commands of all joints to their limits, and compute the errors from their positions.
+   * \param positions Position of each joint.
+   * \param[in,out] commands Position command of each joint, clamped on return.
+   * \param[out] errors Position error of each joint.
+   * \note This method is realtime-safe.
+   */
+  void compute(const Scalar* positions, Scalar* commands, Scalar* errors) const
+  {
+    const Scalar pi     = M_PI;
+    const Scalar two_pi = 2.0 * M_PI;
+    const unsigned int n = size();
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      const Scalar command = clamp(i, commands[i]);
+      const Scalar delta   = command - positions[i];
+      const Scalar angle   = delta - two_pi * std::ceil((delta - pi) / two_pi); // In (-pi, pi]
+      commands[i] = command;
+      errors[i]   = wrapped_[i] ? angle : delta;
+    }
+
+    for (const unsigned int i : revolute_ids_)
+    {
+      if (within_turn_[i] && positions[i] >= lower_[i] && positions[i] <= upper_[i]) {continue;}
+      double error = errors[i];
+      angles::shortest_angular_distance_with_limits(positions[i], commands[i], lower_[i], upper_[i], error);
+      errors[i] = error;
+    }
+  }
+
+private:
+  std::vector<Scalar>       lower_;        ///< Lower position limits, -inf for joints without limits.
+  std::vector<Scalar>       upper_;        ///< Upper position limits, +inf for joints without limits.
+  std::vector<char>         wrapped_;      ///< Whether the error of each joint is the shortest angle.
+  std::vector<char>         within_turn_;  ///< Whether the limits of each revolute joint span at most one turn.
+  std::vector<unsigned int> revolute_ids_; ///< Joints whose error is the shortest angle within their limits.
+};
+
+} // namespace
+
+#endif
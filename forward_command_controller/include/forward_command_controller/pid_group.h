@@ -0,0 +1,166 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef FORWARD_COMMAND_CONTROLLER_PID_GROUP_H
+#define FORWARD_COMMAND_CONTROLLER_PID_GROUP_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <control_toolbox/pid.h>
+
+namespace forward_command_controller
+{
+
+/**
+ * \brief State of the PID controllers of a group of joints, stored as one array per quantity.
+ *
+ * computeCommands() computes the commands of all joints in a single loop over contiguous arrays, following the
+ * equations of \c control_toolbox::Pid::computeCommand(error, dt) for each joint. Gains are kept in
+ * \c control_toolbox::Pid instances, which handle the parameter server and dynamic reconfigure, and are copied with
+ * setGains() before computing.
+ */
+class PidGroup
+{
+public:
+  /**
+   * \brief Resize the group to \p size joints, and reset their state.
+   * \note This method is \b not real-time safe.
+   */
+  void resize(unsigned int size)
+  {
+    p_gain_.assign(size, 0.0);
+    i_gain_.assign(size, 0.0);
+    d_gain_.assign(size, 0.0);
+    i_max_.assign(size, 0.0);
+    i_min_.assign(size, 0.0);
+    antiwindup_.assign(size, 0);
+    p_error_last_.assign(size, 0.0);
+    i_error_.assign(size, 0.0);
+    d_error_.assign(size, 0.0);
+  }
+
+  /// Reset the integral and derivative state of all joints.
+  void reset()
+  {
+    std::fill(p_error_last_.begin(), p_error_last_.end(), 0.0);
+    std::fill(i_error_.begin(), i_error_.end(), 0.0);
+    std::fill(d_error_.begin(), d_error_.end(), 0.0);
+  }
+
+  void setGains(unsigned int index, const control_toolbox::Pid::Gains& gains)
+  {
+    p_gain_[index]     = gains.p_gain_;
+    i_gain_[index]     = gains.i_gain_;
+    d_gain_[index]     = gains.d_gain_;
+    i_max_[index]      = gains.i_max_;
+    i_min_[index]      = gains.i_min_;
+    antiwindup_[index] = gains.antiwindup_;
+  }
+
+  /**
+   * \brief Compute the commands of all joints.
+   * \param error Error of each joint.
+   * \param dt Time step [s].
+   * \param command Output command of each joint.
+   *
+   * As with \c control_toolbox::Pid, the command is zero for a zero time step or a non-finite error, in which case
+   * the joint state is left untouched, and a negative time step reuses the previous error derivative.
+   */
+  void computeCommands(const double* error, double dt, double* command)
+  {
+    const unsigned int size = p_gain_.size();
+    if (dt == 0.0)
+    {
+      std::fill(command, command + size, 0.0);
+      return;
+    }
+
+    const bool derivate = dt > 0.0;
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      const double e = error[i];
+      if (!std::isfinite(e))
+      {
+        command[i] = 0.0;
+        continue;
+      }
+
+      const double e_dot = derivate ? (e - p_error_last_[i]) / dt : d_error_[i];
+      if (derivate) {p_error_last_[i] = e;}
+      d_error_[i] = e_dot;
+      if (!std::isfinite(e_dot))
+      {
+        command[i] = 0.0;
+        continue;
+      }
+
+      // integral term, bounded either through the integrated error (antiwindup) or the term itself
+      double i_error = i_error_[i] + dt * e;
+      if (antiwindup_[i] && i_gain_[i] != 0.0)
+      {
+        const double bound_a = i_min_[i] / i_gain_[i];
+        const double bound_b = i_max_[i] / i_gain_[i];
+        i_error = std::min(std::max(i_error, std::min(bound_a, bound_b)), std::max(bound_a, bound_b));
+      }
+      i_error_[i] = i_error;
+      double i_term = i_gain_[i] * i_error;
+      if (!antiwindup_[i])
+      {
+        i_term = std::min(std::max(i_term, i_min_[i]), i_max_[i]);
+      }
+
+      command[i] = p_gain_[i] * e + i_term + d_gain_[i] * e_dot;
+    }
+  }
+
+private:
+  // Gains
+  std::vector<double> p_gain_;
+  std::vector<double> i_gain_;
+  std::vector<double> d_gain_;
+  std::vector<double> i_max_;
+  std::vector<double> i_min_;
+  std::vector<unsigned char> antiwindup_;
+
+  // State
+  std::vector<double> p_error_last_; ///< Error of the previous step, for the derivative term
+  std::vector<double> i_error_;      ///< Integrated error
+  std::vector<double> d_error_;      ///< Last error derivative
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,185 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef FORWARD_COMMAND_CONTROLLER_PID_STATE_PUBLISHER_H
+#define FORWARD_COMMAND_CONTROLLER_PID_STATE_PUBLISHER_H
+
+#include <memory>
+#include <string>
+
+#include <control_msgs/JointControllerState.h>
+#include <control_toolbox/pid.h>
+#include <controller_instrumentation/publisher_pool.h>
+#include <controller_instrumentation/spsc_queue.h>
+#include <ros/node_handle.h>
+#include <ros/publisher.h>
+
+namespace forward_command_controller
+{
+
+/**
+ * \brief Publisher of the state of a single joint PID controller.
+ *
+ * The control loop only pushes the numeric state of the controller to a lock-free queue, every
+ * \c state_publish_decimation cycles. The thread of the process \ref controller_instrumentation::PublisherPool fills
+ * and publishes the \c control_msgs::JointControllerState messages, and reads the gains of the PID controller there,
+ * as its dynamic reconfigure server does, only copying them to the message when they change.
+ *
+ * \section ROS interface
+ *
+ * \param state_publish_decimation Number of control cycles per published state. Defaults to 10, zero disables
+ * publishing.
+ *
+ * Publishes:
+ * - \b state (control_msgs::JointControllerState) : State of the controller.
+ */
+class PidStatePublisher : public controller_instrumentation::PublisherPool::Topic
+{
+public:
+  /// Numeric state of the controller in a control cycle.
+  struct State
+  {
+    State() : set_point(0.0), process_value(0.0), process_value_dot(0.0), error(0.0), time_step(0.0), command(0.0) {}
+
+    ros::Time stamp;
+    double    set_point;
+    double    process_value;
+    double    process_value_dot;
+    double    error;
+    double    time_step;
+    double    command;
+  };
+
+  PidStatePublisher() : pid_(nullptr), decimation_(0), cycle_(0), gains_set_(false) {}
+  ~PidStatePublisher()
+  {
+    if (pool_) {pool_->remove(this);}
+  }
+
+  PidStatePublisher(const PidStatePublisher&) = delete;
+  PidStatePublisher& operator=(const PidStatePublisher&) = delete;
+
+  /**
+   * \brief Advertise the state topic, as configured by the ROS parameters of \p nh.
+   * \param nh Controller node handle.
+   * \param pid PID controller whose gains are published. Must outlive this publisher.
+   * \return False if the parameters are invalid.
+   * \note This method is \b not real-time safe.
+   */
+  bool init(ros::NodeHandle& nh, control_toolbox::Pid& pid)
+  {
+    int decimation = 10;
+    nh.getParam("state_publish_decimation", decimation);
+    if (decimation < 0)
+    {
+      ROS_ERROR_STREAM("State publish decimation must be non-negative, got " << decimation << ".");
+      return false;
+    }
+    decimation_ = decimation;
+    cycle_      = 0;
+    if (decimation_ == 0) {return true;}
+
+    pid_ = &pid;
+    queue_.reset(QUEUE_SIZE);
+    publisher_ = nh.advertise<control_msgs::JointControllerState>("state", 1);
+    pool_ = controller_instrumentation::PublisherPool::get();
+    pool_->add(this, 0.0);
+    return true;
+  }
+
+  /**
+   * \brief Hand over the \p state of a control cycle, published if the cycle is due.
+   * \note This method is realtime-safe.
+   */
+  void update(const State& state)
+  {
+    if (decimation_ == 0) {return;}
+    if (cycle_++ % decimation_ == 0) {queue_.push(state);} // Dropped if the pool thread is late
+  }
+
+  void publishPending() override
+  {
+    State state;
+    while (queue_.pop(state))
+    {
+      refreshGains();
+      msg_.header.stamp      = state.stamp;
+      msg_.set_point         = state.set_point;
+      msg_.process_value     = state.process_value;
+      msg_.process_value_dot = state.process_value_dot;
+      msg_.error             = state.error;
+      msg_.time_step         = state.time_step;
+      msg_.command           = state.command;
+      publisher_.publish(msg_);
+    }
+  }
+
+private:
+  static const std::size_t QUEUE_SIZE = 16;
+
+  control_toolbox::Pid*                         pid_;
+  unsigned int                                  decimation_;
+  unsigned int                                  cycle_;      ///< Control cycles so far.
+  controller_instrumentation::SpscQueue<State>  queue_;      ///< States due for publishing.
+
+  // Only accessed by the pool thread
+  control_toolbox::Pid::Gains                   gains_;      ///< Gains in msg_.
+  bool                                          gains_set_;  ///< Whether gains_ were read at least once.
+  control_msgs::JointControllerState            msg_;
+  ros::Publisher                                publisher_;
+
+  std::shared_ptr<controller_instrumentation::PublisherPool> pool_;
+
+  void refreshGains()
+  {
+    const control_toolbox::Pid::Gains gains = pid_->getGains();
+    if (gains_set_ && gains.p_gain_ == gains_.p_gain_ && gains.i_gain_ == gains_.i_gain_ &&
+        gains.d_gain_ == gains_.d_gain_ && gains.i_max_ == gains_.i_max_ && gains.antiwindup_ == gains_.antiwindup_)
+    {
+      return;
+    }
+    gains_     = gains;
+    gains_set_ = true;
+    msg_.p          = gains.p_gain_;
+    msg_.i          = gains.i_gain_;
+    msg_.d          = gains.d_gain_;
+    msg_.i_clamp    = gains.i_max_;
+    msg_.antiwindup = static_cast<char>(gains.antiwindup_);
+  }
+};
+
+} // namespace
+
+#endif
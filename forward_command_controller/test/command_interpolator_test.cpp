@@ -0,0 +1,214 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <forward_command_controller/command_interpolator.h>
+
+using forward_command_controller::CommandInterpolator;
+
+namespace
+{
+
+const double PERIOD = 0.01;       // Command period
+const double MAX_DURATION = 0.1;  // Default command_interpolation_max_duration
+const double EPS = 1e-9;
+
+// Commands of a ramp at 1/s, received every PERIOD from the start on.
+// Once the stream is steady, the interpolated commands follow the ramp with a delay of one period
+std::vector<double> rampCommand(unsigned int k) {return std::vector<double>(2, PERIOD * k);}
+
+void sendRamp(CommandInterpolator& interpolator, const ros::Time& start, unsigned int n)
+{
+  interpolator.reset(rampCommand(0), start);
+  for (unsigned int k = 1; k <= n; ++k) {interpolator.setCommand(rampCommand(k), start + ros::Duration(PERIOD * k));}
+}
+
+double slope(CommandInterpolator& interpolator, const ros::Time& time)
+{
+  const double dt = 1e-6;
+  const double value = interpolator.sample(time)[0];
+  return (interpolator.sample(time + ros::Duration(dt))[0] - value) / dt;
+}
+
+} // namespace
+
+TEST(CommandInterpolatorTest, Params)
+{
+  CommandInterpolator interpolator;
+  ASSERT_TRUE(interpolator.init(ros::NodeHandle("interp_none"), 2));
+  EXPECT_FALSE(interpolator.enabled());
+  ASSERT_TRUE(interpolator.init(ros::NodeHandle("interp_linear"), 2));
+  EXPECT_TRUE(interpolator.enabled());
+  ASSERT_TRUE(interpolator.init(ros::NodeHandle("interp_cubic"), 2));
+  EXPECT_TRUE(interpolator.enabled());
+
+  EXPECT_FALSE(interpolator.init(ros::NodeHandle("interp_ko_mode"), 2));
+  EXPECT_FALSE(interpolator.init(ros::NodeHandle("interp_ko_max_duration"), 2));
+}
+
+TEST(CommandInterpolatorTest, HoldOnReset)
+{
+  CommandInterpolator interpolator;
+  ASSERT_TRUE(interpolator.init(ros::NodeHandle("interp_cubic"), 2));
+
+  const std::vector<double> command = {1.0, -2.0};
+  interpolator.reset(command, ros::Time(1.0));
+  EXPECT_EQ(command, interpolator.sample(ros::Time(1.0)));
+  EXPECT_EQ(command, interpolator.sample(ros::Time(5.0)));
+}
+
+TEST(CommandInterpolatorTest, LinearSegmentEnds)
+{
+  CommandInterpolator interpolator;
+  ASSERT_TRUE(interpolator.init(ros::NodeHandle("interp_linear"), 2));
+  const ros::Time start(1.0);
+  sendRamp(interpolator, start, 1);
+
+  // The segment spans the command period, from the previous command to the new one
+  const ros::Time command_time = start + ros::Duration(PERIOD);
+  EXPECT_NEAR(0.0, interpolator.sample(command_time)[0], EPS);
+  EXPECT_NEAR(0.5 * PERIOD, interpolator.sample(command_time + ros::Duration(0.5 * PERIOD))[1], EPS);
+  EXPECT_NEAR(PERIOD, interpolator.sample(command_time + ros::Duration(PERIOD))[0], EPS);
+
+  // Beyond its ends, the segment is held at the start and end values
+  EXPECT_NEAR(0.0, interpolator.sample(command_time - ros::Duration(0.5 * PERIOD))[0], EPS);
+  EXPECT_NEAR(PERIOD, interpolator.sample(command_time + ros::Duration(10.0 * PERIOD))[0], EPS);
+}
+
+TEST(CommandInterpolatorTest, SteadyStream)
+{
+  for (const char* ns : {"interp_linear", "interp_cubic"})
+  {
+    SCOPED_TRACE(ns);
+    CommandInterpolator interpolator;
+    ASSERT_TRUE(interpolator.init(ros::NodeHandle(ns), 2));
+    const ros::Time start(1.0);
+    interpolator.reset(rampCommand(0), start);
+
+    // After the first segment, the ramp is followed exactly with one command period of delay
+    for (unsigned int k = 1; k <= 10; ++k)
+    {
+      const ros::Time command_time = start + ros::Duration(PERIOD * k);
+      interpolator.setCommand(rampCommand(k), command_time);
+      if (k < 2) {continue;}
+      for (double offset : {0.0, 0.25 * PERIOD, 0.5 * PERIOD, 0.75 * PERIOD})
+      {
+        const std::vector<double>& output = interpolator.sample(command_time + ros::Duration(offset));
+        EXPECT_NEAR(PERIOD * (k - 1) + offset, output[0], EPS);
+        EXPECT_NEAR(PERIOD * (k - 1) + offset, output[1], EPS);
+      }
+    }
+  }
+}
+
+TEST(CommandInterpolatorTest, EarlyCommand)
+{
+  for (const char* ns : {"interp_linear", "interp_cubic"})
+  {
+    SCOPED_TRACE(ns);
+    CommandInterpolator interpolator;
+    ASSERT_TRUE(interpolator.init(ros::NodeHandle(ns), 2));
+    const ros::Time start(1.0);
+    sendRamp(interpolator, start, 5);
+
+    // A command arriving before the current segment ends starts the next one from the current output
+    const ros::Time early = start + ros::Duration(5.5 * PERIOD);
+    const double output = interpolator.sample(early)[0];
+    interpolator.setCommand(std::vector<double>(2, 1.0), early);
+    EXPECT_NEAR(output, interpolator.sample(early)[0], EPS);
+    EXPECT_NEAR(1.0, interpolator.sample(early + ros::Duration(0.5 * PERIOD))[0], EPS);
+  }
+}
+
+TEST(CommandInterpolatorTest, StreamGap)
+{
+  for (const char* ns : {"interp_linear", "interp_cubic"})
+  {
+    SCOPED_TRACE(ns);
+    CommandInterpolator interpolator;
+    ASSERT_TRUE(interpolator.init(ros::NodeHandle(ns), 2));
+    const ros::Time start(1.0);
+    sendRamp(interpolator, start, 8);
+
+    // The last command is held while the stream pauses
+    const ros::Time last_command_time = start + ros::Duration(8.0 * PERIOD);
+    const double last_command = rampCommand(8)[0];
+    EXPECT_NEAR(last_command, interpolator.sample(last_command_time + ros::Duration(0.3))[0], EPS);
+
+    // The segment after the gap is bounded by the max duration, instead of lasting the whole gap
+    const ros::Time resume = last_command_time + ros::Duration(0.5);
+    const double command = last_command + 0.2;
+    interpolator.setCommand(std::vector<double>(2, command), resume);
+    EXPECT_NEAR(last_command, interpolator.sample(resume)[0], EPS);
+    EXPECT_LT(interpolator.sample(resume + ros::Duration(0.5 * MAX_DURATION))[0], command);
+    EXPECT_NEAR(command, interpolator.sample(resume + ros::Duration(MAX_DURATION))[0], EPS);
+    EXPECT_NEAR(command, interpolator.sample(resume + ros::Duration(2.0 * MAX_DURATION))[1], EPS);
+  }
+}
+
+TEST(CommandInterpolatorTest, CubicStartsAtRestAfterGap)
+{
+  CommandInterpolator interpolator;
+  ASSERT_TRUE(interpolator.init(ros::NodeHandle("interp_cubic"), 2));
+  const ros::Time start(1.0);
+  sendRamp(interpolator, start, 8);
+
+  // Without a gap, the rate of change is continuous when a command arrives
+  const ros::Time last_command_time = start + ros::Duration(8.0 * PERIOD);
+  EXPECT_NEAR(1.0, slope(interpolator, last_command_time), 1e-3);
+
+  // After a gap, the output was at rest: the next segment starts with a zero rate of change, and ends with the rate of
+  // change of the last two commands
+  const ros::Time resume = last_command_time + ros::Duration(0.5);
+  const double command = rampCommand(8)[0] + 0.2;
+  interpolator.setCommand(std::vector<double>(2, command), resume);
+  EXPECT_NEAR(0.0, slope(interpolator, resume), 1e-3);
+  EXPECT_NEAR(0.2 / MAX_DURATION, slope(interpolator, resume + ros::Duration(MAX_DURATION - 1e-5)), 1e-2);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "command_interpolator_test");
+
+  int ret = RUN_ALL_TESTS();
+  ros::shutdown();
+  return ret;
+}
@@ -0,0 +1,170 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <diff_drive_controller/speed_limiter.h>
+#include <forward_command_controller/command_limiter.h>
+#include <forward_command_controller/command_timeout.h>
+
+using diff_drive_controller::SpeedLimiter;
+using forward_command_controller::CommandLimiter;
+using forward_command_controller::CommandTimeout;
+
+namespace
+{
+
+const double MAX_ACCELERATION = 2.0; // Limits of the command_limiter.test joints
+const double MAX_JERK = 40.0;
+const double EPS = 1e-12;
+
+const std::vector<std::string> JOINTS = {"acceleration_jerk", "acceleration", "jerk", "unlimited"};
+
+// SpeedLimiter with the limits of one joint. CommandLimiter bounds the second difference of the command by
+// max_jerk * dt^2, where SpeedLimiter uses 2 * jerk * dt^2: the same limit is half the jerk of SpeedLimiter
+SpeedLimiter speedLimiter(bool has_acceleration, bool has_jerk)
+{
+  return SpeedLimiter(false, has_acceleration, has_jerk, 0.0, 0.0, -MAX_ACCELERATION, MAX_ACCELERATION,
+                      -0.5 * MAX_JERK, 0.5 * MAX_JERK);
+}
+
+} // namespace
+
+TEST(CommandLimiterTest, Params)
+{
+  CommandLimiter limiter;
+  ASSERT_TRUE(limiter.init(ros::NodeHandle("limits"), JOINTS));
+  EXPECT_TRUE(limiter.enabled());
+  ASSERT_TRUE(limiter.init(ros::NodeHandle("limits"), {"unlimited"}));
+  EXPECT_FALSE(limiter.enabled());
+
+  EXPECT_FALSE(limiter.init(ros::NodeHandle("limits_ko_acceleration"), {"joint"}));
+  EXPECT_FALSE(limiter.init(ros::NodeHandle("limits_ko_jerk"), {"joint"}));
+}
+
+TEST(CommandLimiterTest, HoldWithoutElapsedTime)
+{
+  CommandLimiter limiter;
+  ASSERT_TRUE(limiter.init(ros::NodeHandle("limits"), JOINTS));
+  limiter.reset(std::vector<double>(JOINTS.size(), 0.5));
+  for (unsigned int i = 0; i < JOINTS.size(); ++i)
+  {
+    EXPECT_EQ(0.5, limiter.limit(i, 1.0, 0.0));
+    EXPECT_EQ(0.5, limiter.limit(i, 1.0, -0.01));
+  }
+}
+
+TEST(CommandLimiterTest, MatchesSpeedLimiter)
+{
+  CommandLimiter limiter;
+  ASSERT_TRUE(limiter.init(ros::NodeHandle("limits"), JOINTS));
+  std::vector<SpeedLimiter> references = {speedLimiter(true, true), speedLimiter(true, false),
+                                          speedLimiter(false, true), speedLimiter(false, false)};
+
+  const std::vector<double> start(JOINTS.size(), 0.1);
+  limiter.reset(start);
+  std::vector<double> v0 = start;
+  std::vector<double> v1 = start;
+
+  // Random steps, small enough for the jerk limit to be left at times, with random update periods
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> command_distribution(-0.5, 0.5);
+  std::uniform_real_distribution<double> dt_distribution(0.001, 0.02);
+  for (unsigned int k = 0; k < 10000; ++k)
+  {
+    const double command = command_distribution(generator);
+    const double dt = dt_distribution(generator);
+    for (unsigned int i = 0; i < JOINTS.size(); ++i)
+    {
+      // From the same previous commands: rounding differences would otherwise add up without an acceleration limit
+      double expected = command;
+      references[i].limit(expected, v0[i], v1[i], dt);
+      const double output = limiter.limit(i, command, dt);
+      ASSERT_NEAR(expected, output, EPS) << JOINTS[i] << ", update " << k;
+      v1[i] = v0[i];
+      v0[i] = output;
+    }
+  }
+}
+
+TEST(CommandLimiterTest, RampDownToTimeoutFallback)
+{
+  CommandTimeout timeout;
+  CommandLimiter limiter;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("limits_timeout")));
+  ASSERT_TRUE(limiter.init(ros::NodeHandle("limits_timeout"), {"joint"}));
+
+  // Steady command, applied as is until it times out, as in the update of the joint group controllers
+  const double command = 1.0;
+  const double dt = 0.01;
+  ros::Time time(1.0);
+  timeout.reset(time);
+  limiter.reset({command});
+  for (unsigned int k = 0; k <= 10; ++k, time = time + ros::Duration(dt))
+  {
+    ASSERT_FALSE(timeout.expired(time));
+    ASSERT_NEAR(command, limiter.limit(0, command, dt), EPS);
+  }
+
+  // The zero fallback is reached at the maximum acceleration, instead of as a step
+  double previous = command;
+  unsigned int steps = 0;
+  for (; previous > 0.0 && steps < 1000; ++steps, time = time + ros::Duration(dt))
+  {
+    ASSERT_TRUE(timeout.expired(time));
+    const double output = limiter.limit(0, timeout.fallback(command, time), dt);
+    EXPECT_NEAR(std::max(0.0, previous - MAX_ACCELERATION * dt), output, 1e-9);
+    previous = output;
+  }
+  EXPECT_EQ(0.0, previous);
+  EXPECT_EQ(static_cast<unsigned int>(std::ceil(command / (MAX_ACCELERATION * dt) - 1e-9)), steps);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "command_limiter_test");
+
+  int ret = RUN_ALL_TESTS();
+  ros::shutdown();
+  return ret;
+}
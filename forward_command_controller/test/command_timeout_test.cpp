@@ -0,0 +1,171 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <forward_command_controller/command_timeout.h>
+
+using forward_command_controller::CommandTimeout;
+
+namespace
+{
+
+const double TIMEOUT = 0.1;
+const double RAMP_DURATION = 0.5;
+
+} // namespace
+
+TEST(CommandTimeoutTest, InvalidParams)
+{
+  CommandTimeout timeout;
+  EXPECT_FALSE(timeout.init(ros::NodeHandle("timeout_ko_negative")));
+  EXPECT_FALSE(timeout.init(ros::NodeHandle("timeout_ko_action")));
+  EXPECT_FALSE(timeout.init(ros::NodeHandle("timeout_ko_ramp_duration")));
+}
+
+TEST(CommandTimeoutTest, Disabled)
+{
+  CommandTimeout timeout;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("timeout_disabled")));
+  timeout.reset(ros::Time(1.0));
+  EXPECT_FALSE(timeout.expired(ros::Time(1.0)));
+  EXPECT_FALSE(timeout.expired(ros::Time(1000.0)));
+}
+
+TEST(CommandTimeoutTest, Expiry)
+{
+  CommandTimeout timeout;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("timeout_hold")));
+
+  // Starting counts as a command
+  const ros::Time start(1.0);
+  timeout.reset(start);
+  EXPECT_FALSE(timeout.expired(start));
+  EXPECT_FALSE(timeout.expired(start + ros::Duration(TIMEOUT)));
+  EXPECT_TRUE(timeout.expired(start + ros::Duration(TIMEOUT + 0.001)));
+
+  // Until a new command arrives, then from that command on
+  const ros::Time command_time = start + ros::Duration(0.5);
+  timeout.commandReceived(command_time);
+  EXPECT_FALSE(timeout.expired(command_time));
+  EXPECT_FALSE(timeout.expired(command_time + ros::Duration(TIMEOUT)));
+  EXPECT_TRUE(timeout.expired(command_time + ros::Duration(TIMEOUT + 0.001)));
+
+  // Restarting clears an expired command
+  const ros::Time restart(10.0);
+  timeout.reset(restart);
+  EXPECT_FALSE(timeout.expired(restart));
+
+  // Each expiry is counted once, however many cycles it lasts
+  EXPECT_EQ(2u, timeout.expiryCount());
+}
+
+TEST(CommandTimeoutTest, StaleStampIgnored)
+{
+  CommandTimeout timeout;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("timeout_hold")));
+
+  // The command read again, or written before restarting, keeps its older stamp, which must not rewind the timeout
+  const ros::Time start(1.0);
+  timeout.reset(start);
+  timeout.commandReceived(ros::Time(0.5));
+  EXPECT_FALSE(timeout.expired(start + ros::Duration(TIMEOUT)));
+
+  const ros::Time command_time = start + ros::Duration(0.5);
+  timeout.commandReceived(command_time);
+  timeout.commandReceived(start);
+  EXPECT_FALSE(timeout.expired(command_time + ros::Duration(TIMEOUT)));
+  EXPECT_TRUE(timeout.expired(command_time + ros::Duration(TIMEOUT + 0.001)));
+}
+
+TEST(CommandTimeoutTest, HoldFallback)
+{
+  CommandTimeout timeout;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("timeout_hold")));
+  timeout.reset(ros::Time(1.0));
+
+  const ros::Time time(2.0);
+  ASSERT_TRUE(timeout.expired(time));
+  EXPECT_EQ(0.5, timeout.fallback(0.5, time));
+  EXPECT_EQ(-2.0, timeout.fallback(-2.0, time + ros::Duration(100.0)));
+}
+
+TEST(CommandTimeoutTest, ZeroFallback)
+{
+  CommandTimeout timeout;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("timeout_zero")));
+  timeout.reset(ros::Time(1.0));
+
+  const ros::Time time(1.0 + TIMEOUT + 0.001);
+  ASSERT_TRUE(timeout.expired(time));
+  EXPECT_EQ(0.0, timeout.fallback(0.5, time));
+  EXPECT_EQ(0.0, timeout.fallback(-2.0, time));
+}
+
+TEST(CommandTimeoutTest, RampFallback)
+{
+  CommandTimeout timeout;
+  ASSERT_TRUE(timeout.init(ros::NodeHandle("timeout_ramp")));
+  const ros::Time command_time(1.0);
+  timeout.reset(command_time);
+
+  // The ramp starts from the last command when it expires, and ends at zero after the ramp duration
+  const ros::Time expiry = command_time + ros::Duration(TIMEOUT);
+  const double command = 2.0;
+  EXPECT_NEAR(command, timeout.fallback(command, expiry), 1e-9);
+  EXPECT_NEAR(0.75 * command, timeout.fallback(command, expiry + ros::Duration(0.25 * RAMP_DURATION)), 1e-9);
+  EXPECT_NEAR(-0.5 * command, timeout.fallback(-command, expiry + ros::Duration(0.5 * RAMP_DURATION)), 1e-9);
+  EXPECT_EQ(0.0, timeout.fallback(command, expiry + ros::Duration(RAMP_DURATION)));
+  EXPECT_EQ(0.0, timeout.fallback(command, expiry + ros::Duration(10.0 * RAMP_DURATION)));
+
+  // A new command restarts the ramp from the new command time
+  const ros::Time new_command_time = expiry + ros::Duration(RAMP_DURATION);
+  timeout.commandReceived(new_command_time);
+  EXPECT_FALSE(timeout.expired(new_command_time));
+  const ros::Time new_expiry = new_command_time + ros::Duration(TIMEOUT);
+  EXPECT_NEAR(0.5 * command, timeout.fallback(command, new_expiry + ros::Duration(0.5 * RAMP_DURATION)), 1e-9);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "command_timeout_test");
+
+  int ret = RUN_ALL_TESTS();
+  ros::shutdown();
+  return ret;
+}
@@ -0,0 +1,166 @@
+
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <angles/angles.h>
+#include <forward_command_controller/joint_position_errors.h>
+
+using forward_command_controller::JointPositionErrors;
+
+namespace
+{
+
+const double EPS = 2e-15;
+
+// Revolute joints with limits narrower than, within and wider than a turn, asymmetric around zero, and continuous and
+// prismatic joints
+const char* const URDF =
+  "<robot name=\"test\"><link name=\"base\"/>"
+  "<link name=\"l0\"/><link name=\"l1\"/><link name=\"l2\"/><link name=\"l3\"/><link name=\"l4\"/><link name=\"l5\"/>"
+  "<joint name=\"narrow\" type=\"revolute\"><parent link=\"base\"/><child link=\"l0\"/><axis xyz=\"0 0 1\"/>"
+  "<limit lower=\"-1.0\" upper=\"1.0\" effort=\"1\" velocity=\"1\"/></joint>"
+  "<joint name=\"within_turn\" type=\"revolute\"><parent link=\"l0\"/><child link=\"l1\"/><axis xyz=\"0 0 1\"/>"
+  "<limit lower=\"-2.5\" upper=\"2.5\" effort=\"1\" velocity=\"1\"/></joint>"
+  "<joint name=\"asymmetric\" type=\"revolute\"><parent link=\"l1\"/><child link=\"l2\"/><axis xyz=\"0 0 1\"/>"
+  "<limit lower=\"0.5\" upper=\"3.0\" effort=\"1\" velocity=\"1\"/></joint>"
+  "<joint name=\"wide\" type=\"revolute\"><parent link=\"l2\"/><child link=\"l3\"/><axis xyz=\"0 0 1\"/>"
+  "<limit lower=\"-4.0\" upper=\"4.0\" effort=\"1\" velocity=\"1\"/></joint>"
+  "<joint name=\"continuous\" type=\"continuous\"><parent link=\"l3\"/><child link=\"l4\"/><axis xyz=\"0 0 1\"/>"
+  "</joint>"
+  "<joint name=\"prismatic\" type=\"prismatic\"><parent link=\"l4\"/><child link=\"l5\"/><axis xyz=\"0 0 1\"/>"
+  "<limit lower=\"-0.5\" upper=\"0.5\" effort=\"1\" velocity=\"1\"/></joint>"
+  "</robot>";
+
+const std::vector<std::string> JOINTS = {"narrow", "within_turn", "asymmetric", "wide", "continuous", "prismatic"};
+
+/** Reference implementation: joint by joint, with the angles package, as the position controllers used to do. */
+void referenceErrors(const urdf::Model& urdf, const std::vector<double>& positions, std::vector<double>& commands,
+                     std::vector<double>& errors)
+{
+  for (unsigned int i = 0; i < JOINTS.size(); ++i)
+  {
+    const urdf::Joint& joint = *urdf.getJoint(JOINTS[i]);
+    if (joint.type == urdf::Joint::REVOLUTE || joint.type == urdf::Joint::PRISMATIC)
+    {
+      commands[i] = std::min(std::max(commands[i], joint.limits->lower), joint.limits->upper);
+    }
+    if (joint.type == urdf::Joint::REVOLUTE)
+    {
+      angles::shortest_angular_distance_with_limits(positions[i], commands[i], joint.limits->lower,
+                                                    joint.limits->upper, errors[i]);
+    }
+    else if (joint.type == urdf::Joint::CONTINUOUS)
+    {
+      errors[i] = angles::shortest_angular_distance(positions[i], commands[i]);
+    }
+    else
+    {
+      errors[i] = commands[i] - positions[i];
+    }
+  }
+}
+
+} // namespace
+
+TEST(JointPositionErrorsTest, UnknownJoint)
+{
+  urdf::Model urdf;
+  ASSERT_TRUE(urdf.initString(URDF));
+  JointPositionErrors<> position_errors;
+  EXPECT_FALSE(position_errors.init(urdf, {"narrow", "missing"}));
+}
+
+TEST(JointPositionErrorsTest, MatchesAngles)
+{
+  urdf::Model urdf;
+  ASSERT_TRUE(urdf.initString(URDF));
+  JointPositionErrors<> position_errors;
+  ASSERT_TRUE(position_errors.init(urdf, JOINTS));
+  ASSERT_EQ(JOINTS.size(), position_errors.size());
+
+  // Positions mostly within the limits of the revolute joints, and beyond them at times, as after a limit overshoot.
+  // Commands well beyond the limits, and several turns away for the continuous joint
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> position_distribution(-4.5, 4.5);
+  std::uniform_real_distribution<double> command_distribution(-10.0, 10.0);
+
+  const unsigned int n = JOINTS.size();
+  std::vector<double> positions(n), commands(n), errors(n), expected_commands(n), expected_errors(n);
+  for (unsigned int k = 0; k < 100000; ++k)
+  {
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      positions[i] = position_distribution(generator);
+      commands[i]  = command_distribution(generator);
+    }
+    expected_commands = commands;
+    referenceErrors(urdf, positions, expected_commands, expected_errors);
+
+    position_errors.compute(positions.data(), commands.data(), errors.data());
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      ASSERT_EQ(expected_commands[i], commands[i]) << JOINTS[i] << ", sample " << k;
+      ASSERT_NEAR(expected_errors[i], errors[i], EPS) << JOINTS[i] << ", sample " << k << ", position " << positions[i]
+                                                      << ", command " << commands[i];
+    }
+  }
+}
+
+TEST(JointPositionErrorsTest, NaNCommand)
+{
+  urdf::Model urdf;
+  ASSERT_TRUE(urdf.initString(URDF));
+  JointPositionErrors<> position_errors;
+  ASSERT_TRUE(position_errors.init(urdf, JOINTS));
+
+  for (unsigned int i = 0; i < JOINTS.size(); ++i)
+  {
+    EXPECT_TRUE(std::isnan(position_errors.clamp(i, std::numeric_limits<double>::quiet_NaN()))) << JOINTS[i];
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,201 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Compares the per-wheel scalar kinematics FourWheelSteeringController used to compute against FourWheelKinematics,
+// for twist and four wheel steering commands and for the odometry steering angles.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+
+#include <four_wheel_steering_controller/four_wheel_kinematics_reference.h>
+
+using four_wheel_steering_controller::FourWheelKinematics;
+using four_wheel_steering_controller::WheelValues;
+
+namespace
+{
+
+const ReferenceKinematics GEOMETRY = {1.2, 0.1, 0.28, 1.3};
+
+/** Commands sweeping straight, turning and saturated cases. */
+double linearCommand(unsigned int i)   {return 1.5 * std::sin(0.01 * i);}
+double angularCommand(unsigned int i)  {return 2.0 * std::cos(0.013 * i);}
+double steeringCommand(unsigned int i) {return 0.6 * std::sin(0.017 * i);}
+
+FourWheelKinematics makeKinematics()
+{
+  FourWheelKinematics kinematics;
+  kinematics.setGeometry(GEOMETRY.track, GEOMETRY.wheel_steering_y_offset, GEOMETRY.wheel_radius, GEOMETRY.wheel_base);
+  return kinematics;
+}
+
+// Precomputed inputs, so that generating them is not measured
+const unsigned int INPUTS = 1024;
+
+struct Inputs
+{
+  Inputs()
+  {
+    for (unsigned int i = 0; i < INPUTS; ++i)
+    {
+      lin[i] = linearCommand(i);
+      ang[i] = angularCommand(i);
+      front[i] = steeringCommand(i);
+      rear[i] = -0.5 * steeringCommand(i + 100);
+    }
+  }
+
+  double lin[INPUTS], ang[INPUTS], front[INPUTS], rear[INPUTS];
+};
+
+const Inputs inputs;
+
+} // namespace
+
+static void BM_ReferenceTwist(benchmark::State& state)
+{
+  WheelValues vel, steering;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    i = (i + 1) % INPUTS;
+    GEOMETRY.twistToWheels(inputs.lin[i], inputs.ang[i], vel, steering);
+    benchmark::DoNotOptimize(vel);
+    benchmark::DoNotOptimize(steering);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_ReferenceTwist);
+
+static void BM_KinematicsTwist(benchmark::State& state)
+{
+  const FourWheelKinematics kinematics = makeKinematics();
+  WheelValues vel, steering;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    i = (i + 1) % INPUTS;
+    kinematics.twistToWheels(inputs.lin[i], inputs.ang[i], vel, steering);
+    benchmark::DoNotOptimize(vel);
+    benchmark::DoNotOptimize(steering);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_KinematicsTwist);
+
+static void BM_ReferenceFourWheelSteering(benchmark::State& state)
+{
+  WheelValues vel, steering;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    i = (i + 1) % INPUTS;
+    GEOMETRY.fourWheelSteeringToWheels(inputs.lin[i], inputs.front[i], inputs.rear[i], vel, steering);
+    benchmark::DoNotOptimize(vel);
+    benchmark::DoNotOptimize(steering);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_ReferenceFourWheelSteering);
+
+static void BM_KinematicsFourWheelSteering(benchmark::State& state)
+{
+  const FourWheelKinematics kinematics = makeKinematics();
+  WheelValues vel, steering;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    i = (i + 1) % INPUTS;
+    kinematics.fourWheelSteeringToWheels(inputs.lin[i], inputs.front[i], inputs.rear[i], vel, steering);
+    benchmark::DoNotOptimize(vel);
+    benchmark::DoNotOptimize(steering);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_KinematicsFourWheelSteering);
+
+static void BM_ReferenceOdometrySteering(benchmark::State& state)
+{
+  const FourWheelKinematics kinematics = makeKinematics();
+  WheelValues steering[INPUTS];
+  for (unsigned int i = 0; i < INPUTS; ++i)
+  {
+    WheelValues vel;
+    kinematics.fourWheelSteeringToWheels(inputs.lin[i], inputs.front[i], inputs.rear[i], vel, steering[i]);
+  }
+
+  double front, rear;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    i = (i + 1) % INPUTS;
+    ReferenceKinematics::wheelsToSteering(steering[i], front, rear);
+    benchmark::DoNotOptimize(front);
+    benchmark::DoNotOptimize(rear);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_ReferenceOdometrySteering);
+
+static void BM_KinematicsOdometrySteering(benchmark::State& state)
+{
+  const FourWheelKinematics kinematics = makeKinematics();
+  WheelValues steering[INPUTS];
+  for (unsigned int i = 0; i < INPUTS; ++i)
+  {
+    WheelValues vel;
+    kinematics.fourWheelSteeringToWheels(inputs.lin[i], inputs.front[i], inputs.rear[i], vel, steering[i]);
+  }
+
+  double front, rear;
+  unsigned int i = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    i = (i + 1) % INPUTS;
+    FourWheelKinematics::wheelsToSteering(steering[i], front, rear);
+    benchmark::DoNotOptimize(front);
+    benchmark::DoNotOptimize(rear);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_KinematicsOdometrySteering);
+
+BENCHMARK_MAIN();
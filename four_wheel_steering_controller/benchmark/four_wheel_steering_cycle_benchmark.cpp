@@ -0,0 +1,279 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Replays the control cycle of a FourWheelSteeringController on a simulated four wheel steering robot, with synthetic
+// velocity commands and a simulated clock, so that it runs headless with no ROS master. Odometry, limiter and
+// publishing stages are measured separately, then together as a full cycle.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <diff_drive_controller/odometry_publisher.h>
+#include <four_wheel_steering_controller/four_wheel_kinematics.h>
+#include <four_wheel_steering_controller/odometry.h>
+#include <four_wheel_steering_controller/speed_limiter.h>
+#include <four_wheel_steering_msgs/FourWheelSteeringStamped.h>
+#include <nav_msgs/Odometry.h>
+#include <tf2_msgs/TFMessage.h>
+
+using diff_drive_controller::OdometrySample;
+using four_wheel_steering_controller::FourWheelKinematics;
+using four_wheel_steering_controller::Odometry;
+using four_wheel_steering_controller::SpeedLimiter;
+using four_wheel_steering_controller::WheelValues;
+
+namespace
+{
+
+const double PERIOD = 0.01;
+const ros::Duration PUBLISH_PERIOD(0.02);
+
+/// Geometry of the four wheel steering test robot:
+const double TRACK                   = 1.1;
+const double WHEEL_STEERING_Y_OFFSET = 0.05;
+const double WHEEL_RADIUS            = 0.28;
+const double WHEEL_BASE              = 1.9;
+
+/** Synthetic cmd_vel: square waves saturating the limits, switching every 0.64 s and 0.32 s. */
+double linearCommand(unsigned int i)  {return (i & 64) ? 2.0 : -2.0;}
+double angularCommand(unsigned int i) {return (i & 32) ? 1.0 : -1.0;}
+
+/** Four wheel steering robot with wheels and steering joints tracking their commands exactly. */
+struct SimulatedFourWheelSteeringBot
+{
+  SimulatedFourWheelSteeringBot() : velocities(), steering() {}
+
+  WheelValues velocities;
+  WheelValues steering;
+};
+
+/** Control cycle of FourWheelSteeringController::update(), split in stages, with publishers replaced by messages. */
+class FourWheelSteeringCycle
+{
+public:
+  FourWheelSteeringCycle()
+    : time_(0.0),
+      last_publish_time_(0.0),
+      cycle_(0),
+      published_(0),
+      front_steering_(0.0),
+      rear_steering_(0.0),
+      limiter_lin_(true, true, false, -1.0, 1.0, -0.5, 0.5),
+      limiter_ang_(true, true, false, -1.0, 1.0, -1.0, 1.0),
+      last0_lin_(0.0),
+      last1_lin_(0.0),
+      last0_ang_(0.0),
+      last1_ang_(0.0)
+  {
+    odometry_.setWheelParams(TRACK - 2.0 * WHEEL_STEERING_Y_OFFSET, WHEEL_STEERING_Y_OFFSET, WHEEL_RADIUS, WHEEL_BASE);
+    odometry_.init(time_);
+    kinematics_.setGeometry(TRACK, WHEEL_STEERING_Y_OFFSET, WHEEL_RADIUS, WHEEL_BASE);
+
+    odom_.header.frame_id = "odom";
+    odom_.child_frame_id  = "base_link";
+    tf_odom_.transforms.resize(1);
+    tf_odom_.transforms[0].header.frame_id = "odom";
+    tf_odom_.transforms[0].child_frame_id  = "base_link";
+  }
+
+  /** Move the robot along a slalom, for stages measured without the command stage. */
+  void driveWheels()
+  {
+    kinematics_.twistToWheels(1.0, (cycle_ & 64) ? 0.5 : -0.5, robot_.velocities, robot_.steering);
+  }
+
+  void updateOdometry()
+  {
+    FourWheelKinematics::wheelsToSteering(robot_.steering, front_steering_, rear_steering_);
+    odometry_.update(robot_.velocities[WheelValues::FRONT_LEFT], robot_.velocities[WheelValues::FRONT_RIGHT],
+                     robot_.velocities[WheelValues::REAR_LEFT],  robot_.velocities[WheelValues::REAR_RIGHT],
+                     front_steering_, rear_steering_, time_);
+
+    sample_.stamp    = time_;
+    sample_.x        = odometry_.getX();
+    sample_.y        = odometry_.getY();
+    sample_.heading  = odometry_.getHeading();
+    sample_.linear   = odometry_.getLinearX();
+    sample_.linear_y = odometry_.getLinearY();
+    sample_.angular  = odometry_.getAngular();
+  }
+
+  /** Publish schedule and messages of the realtime publishers path, including the four wheel steering odometry. */
+  void publish()
+  {
+    if (!(last_publish_time_ + PUBLISH_PERIOD < sample_.stamp))
+    {
+      return;
+    }
+    last_publish_time_ += PUBLISH_PERIOD;
+
+    const geometry_msgs::Quaternion orientation(diff_drive_controller::quaternionFromYaw(sample_.heading));
+    diff_drive_controller::setOdometry(sample_, orientation, odom_);
+    tf_odom_.transforms[0].header.stamp = sample_.stamp;
+    diff_drive_controller::setOdometryTransform(sample_, orientation, tf_odom_.transforms[0].transform);
+
+    odom_4ws_.header.stamp = sample_.stamp;
+    odom_4ws_.data.speed = odometry_.getLinear();
+    odom_4ws_.data.acceleration = odometry_.getLinearAcceleration();
+    odom_4ws_.data.jerk = odometry_.getLinearJerk();
+    odom_4ws_.data.front_steering_angle = front_steering_;
+    odom_4ws_.data.front_steering_angle_velocity = odometry_.getFrontSteerVel();
+    odom_4ws_.data.rear_steering_angle = rear_steering_;
+    odom_4ws_.data.rear_steering_angle_velocity = odometry_.getRearSteerVel();
+    ++published_;
+  }
+
+  void updateCommand()
+  {
+    double lin = linearCommand(cycle_);
+    double ang = angularCommand(cycle_);
+    limiter_lin_.limit(lin, last0_lin_, last1_lin_, PERIOD);
+    limiter_ang_.limit(ang, last0_ang_, last1_ang_, PERIOD);
+    last1_lin_ = last0_lin_;
+    last0_lin_ = lin;
+    last1_ang_ = last0_ang_;
+    last0_ang_ = ang;
+
+    kinematics_.twistToWheels(lin, ang, robot_.velocities, robot_.steering);
+  }
+
+  /** Advance the simulated clock by one period. */
+  void step()
+  {
+    time_ += ros::Duration(PERIOD);
+    ++cycle_;
+  }
+
+  void cycle()
+  {
+    updateOdometry();
+    publish();
+    updateCommand();
+    step();
+  }
+
+  const OdometrySample& sample() const {return sample_;}
+  const nav_msgs::Odometry& odom() const {return odom_;}
+  const WheelValues& wheelVelocities() const {return robot_.velocities;}
+  unsigned int published() const {return published_;}
+
+private:
+  ros::Time time_;
+  ros::Time last_publish_time_;
+  unsigned int cycle_;
+  unsigned int published_;
+
+  SimulatedFourWheelSteeringBot robot_;
+  double front_steering_;
+  double rear_steering_;
+  Odometry odometry_;
+  FourWheelKinematics kinematics_;
+  SpeedLimiter limiter_lin_;
+  SpeedLimiter limiter_ang_;
+  double last0_lin_;
+  double last1_lin_;
+  double last0_ang_;
+  double last1_ang_;
+
+  OdometrySample sample_;
+  nav_msgs::Odometry odom_;
+  tf2_msgs::TFMessage tf_odom_;
+  four_wheel_steering_msgs::FourWheelSteeringStamped odom_4ws_;
+};
+
+} // namespace
+
+static void BM_FourWheelSteeringOdometry(benchmark::State& state)
+{
+  FourWheelSteeringCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.driveWheels();
+    cycle.updateOdometry();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.sample());
+}
+BENCHMARK(BM_FourWheelSteeringOdometry);
+
+// Includes the kinematics, which turn the limited commands into wheel commands
+static void BM_FourWheelSteeringLimiter(benchmark::State& state)
+{
+  FourWheelSteeringCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.updateCommand();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.wheelVelocities());
+}
+BENCHMARK(BM_FourWheelSteeringLimiter);
+
+// Includes the odometry stage, which provides the published samples
+static void BM_FourWheelSteeringPublish(benchmark::State& state)
+{
+  FourWheelSteeringCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.driveWheels();
+    cycle.updateOdometry();
+    cycle.publish();
+    cycle.step();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.odom());
+  state.counters["published"] = benchmark::Counter(cycle.published(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FourWheelSteeringPublish);
+
+static void BM_FourWheelSteeringCycle(benchmark::State& state)
+{
+  FourWheelSteeringCycle cycle;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    cycle.cycle();
+  }
+  allocations.report(state);
+  benchmark::DoNotOptimize(cycle.odom());
+  benchmark::DoNotOptimize(cycle.wheelVelocities());
+}
+BENCHMARK(BM_FourWheelSteeringCycle);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Cost of the SwerveKinematics commands and odometry fit per control cycle, with the number of modules as argument.
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+
+#include <cmath>
+#include <vector>
+
+#include <four_wheel_steering_controller/swerve_kinematics.h>
+
+using four_wheel_steering_controller::SwerveKinematics;
+
+namespace
+{
+
+// Modules evenly spread on a circle:
+SwerveKinematics makeKinematics(int modules)
+{
+  std::vector<double> x(modules), y(modules);
+  for (int i = 0; i < modules; ++i)
+  {
+    x[i] = 0.5*std::cos(2.0*M_PI*i/modules);
+    y[i] = 0.5*std::sin(2.0*M_PI*i/modules);
+  }
+  SwerveKinematics kinematics;
+  kinematics.setModules(x, y, 0.1);
+  return kinematics;
+}
+
+}
+
+static void BM_SwerveTwistToModules(benchmark::State& state)
+{
+  const SwerveKinematics kinematics = makeKinematics(state.range(0));
+  std::vector<double> velocities(kinematics.size()), steering(kinematics.size());
+
+  double ang = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    ang = ang > 1.0 ? -1.0 : ang + 0.01;
+    kinematics.twistToModules(0.8, 0.2, ang, velocities.data(), steering.data());
+    benchmark::DoNotOptimize(velocities.data());
+    benchmark::DoNotOptimize(steering.data());
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_SwerveTwistToModules)->Arg(4)->Arg(6)->Arg(8)->Arg(16);
+
+static void BM_SwerveModulesToTwist(benchmark::State& state)
+{
+  const SwerveKinematics kinematics = makeKinematics(state.range(0));
+  std::vector<double> velocities(kinematics.size()), steering(kinematics.size());
+  kinematics.twistToModules(0.8, 0.2, 0.5, velocities.data(), steering.data());
+
+  double lin_x, lin_y, ang;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(velocities.data());
+    kinematics.modulesToTwist(velocities.data(), steering.data(), lin_x, lin_y, ang);
+    benchmark::DoNotOptimize(lin_x);
+    benchmark::DoNotOptimize(lin_y);
+    benchmark::DoNotOptimize(ang);
+  }
+  allocations.report(state);
+}
+BENCHMARK(BM_SwerveModulesToTwist)->Arg(4)->Arg(6)->Arg(8)->Arg(16);
+
+BENCHMARK_MAIN();
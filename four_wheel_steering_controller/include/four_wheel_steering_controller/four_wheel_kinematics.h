@@ -0,0 +1,134 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef FOUR_WHEEL_KINEMATICS_H_
+#define FOUR_WHEEL_KINEMATICS_H_
+
+#include <cstddef>
+
+namespace four_wheel_steering_controller
+{
+
+  /**
+   * \brief Value of each of the four wheels, packed so that the four lanes can be computed at once
+   */
+  struct alignas(32) WheelValues
+  {
+    enum Wheel
+    {
+      FRONT_LEFT = 0,
+      FRONT_RIGHT,
+      REAR_LEFT,
+      REAR_RIGHT,
+      WHEELS
+    };
+
+    double& operator[](size_t wheel) { return values[wheel]; }
+    double operator[](size_t wheel) const { return values[wheel]; }
+
+    double values[WHEELS];
+  };
+
+  /**
+   * \brief Four wheel steering kinematics: wheel velocities and steering angles from a command, and virtual front and
+   * rear steering angles from the wheel steering angles
+   *
+   * The algebraic part runs on all four wheels at once in fixed size loops over WheelValues, which compilers turn into
+   * packed SIMD instructions. Special cases are handled by selects instead of branches, and tangents are computed once
+   * and reused instead of being recovered from the steering angles.
+   *
+   * \note All methods are realtime-safe
+   */
+  class FourWheelKinematics
+  {
+  public:
+    FourWheelKinematics();
+
+    /**
+     * \brief Set the robot geometry
+     * \param track                   Distance between left and right wheels [m]
+     * \param wheel_steering_y_offset Distance between a wheel and its steering axis [m]
+     * \param wheel_radius            Wheel radius [m]
+     * \param wheel_base              Distance between front and rear wheels [m]
+     */
+    void setGeometry(double track, double wheel_steering_y_offset, double wheel_radius, double wheel_base);
+
+    /**
+     * \brief Wheel velocities and steering angles following a twist
+     * \param [in]  lin        Linear velocity [m/s]
+     * \param [in]  ang        Angular velocity [rad/s]
+     * \param [out] velocities Wheel velocities [rad/s]
+     * \param [out] steering   Wheel steering angles [rad]
+     */
+    void twistToWheels(double lin, double ang, WheelValues& velocities, WheelValues& steering) const;
+
+    /**
+     * \brief Wheel velocities and steering angles following a four wheel steering command
+     * \param [in]  lin            Linear velocity [m/s]
+     * \param [in]  front_steering Virtual front steering angle [rad], within [-pi/2, pi/2]
+     * \param [in]  rear_steering  Virtual rear steering angle [rad], within [-pi/2, pi/2]
+     * \param [out] velocities     Wheel velocities [rad/s]
+     * \param [out] steering       Wheel steering angles [rad]
+     */
+    void fourWheelSteeringToWheels(double lin, double front_steering, double rear_steering,
+                                   WheelValues& velocities, WheelValues& steering) const;
+
+    /**
+     * \brief Virtual front and rear steering angles from the wheel steering angles
+     * \param [in]  steering       Wheel steering angles [rad]
+     * \param [out] front_steering Virtual front steering angle [rad]
+     * \param [out] rear_steering  Virtual rear steering angle [rad]
+     */
+    static void wheelsToSteering(const WheelValues& steering, double& front_steering, double& rear_steering);
+
+  private:
+    /**
+     * \brief Wheel velocities from the velocity of each steering axis
+     * \param [in]  sign                Sign of the linear velocity
+     * \param [in]  vel_steering_offset Wheel velocity induced by the steering offset [rad/s]
+     * \param [in]  vel_x               Steering axis velocity along the robot x axis [m/s]
+     * \param [in]  vel_y               Steering axis velocity along the robot y axis [m/s]
+     * \param [out] velocities          Wheel velocities [rad/s]
+     */
+    void wheelVelocities(double sign, double vel_steering_offset,
+                         const WheelValues& vel_x, const WheelValues& vel_y, WheelValues& velocities) const;
+
+    double steering_track_;
+    double wheel_steering_y_offset_;
+    double wheel_radius_;
+    double wheel_base_;
+  };
+}
+
+#endif /* FOUR_WHEEL_KINEMATICS_H_ */
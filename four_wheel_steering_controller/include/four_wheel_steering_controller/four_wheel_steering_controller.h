@@ -33,17 +33,22 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  *********************************************************************/
 
+#include <mutex>
+
+#include <controller_instrumentation/command_channel_monitor.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
 #include <controller_interface/multi_interface_controller.h>
+#include <diff_drive_controller/base_odometry_publisher.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <pluginlib/class_list_macros.hpp>
 
-#include <nav_msgs/Odometry.h>
 #include <four_wheel_steering_msgs/FourWheelSteeringStamped.h>
-#include <tf/tfMessage.h>
+#include <std_msgs/Float64MultiArray.h>
 
-#include <realtime_tools/realtime_buffer.h>
 #include <realtime_tools/realtime_publisher.h>
 
+#include <four_wheel_steering_controller/four_wheel_kinematics.h>
 #include <four_wheel_steering_controller/odometry.h>
 #include <four_wheel_steering_controller/speed_limiter.h>
 
@@ -97,9 +102,14 @@ namespace four_wheel_steering_controller{
   private:
     std::string name_;
 
+    /// Audit of realtime-unsafe operations in update():
+    controller_instrumentation::RealtimeAudit rt_audit_;
+
+    /// Write statistics of the velocity command channels:
+    controller_instrumentation::CommandChannelMonitor command_monitor_;
+
     /// Odometry related:
     ros::Duration publish_period_;
-    ros::Time last_state_publish_time_;
     bool open_loop_;
 
     /// Hardware handles:
@@ -109,13 +119,7 @@ namespace four_wheel_steering_controller{
     std::vector<hardware_interface::JointHandle> rear_steering_joints_;
 
     /// Velocity command related:
-    struct Command
-    {
-      ros::Time stamp;
-
-      Command() : stamp(0.0) {}
-    };
-    struct CommandTwist : Command
+    struct CommandTwist
     {
       double lin_x;
       double lin_y;
@@ -123,7 +127,7 @@ namespace four_wheel_steering_controller{
 
       CommandTwist() : lin_x(0.0), lin_y(0.0), ang(0.0) {}
     };
-    struct Command4ws : Command
+    struct Command4ws
     {
       double lin;
       double front_steering;
@@ -131,20 +135,44 @@ namespace four_wheel_steering_controller{
 
       Command4ws() : lin(0.0), front_steering(0.0), rear_steering(0.0) {}
     };
-    realtime_tools::RealtimeBuffer<CommandTwist> command_twist_;
-    CommandTwist command_struct_twist_;
-    ros::Subscriber sub_command_;
+    /// Latest command of either topic, tagged with its mode so that update() reads a single channel:
+    struct Command
+    {
+      enum Mode
+      {
+        TWIST,
+        FOUR_WHEEL_STEERING
+      };
+
+      Mode mode;
+      ros::Time stamp;
+      CommandTwist twist;                ///< Only meaningful in TWIST mode.
+      Command4ws four_wheel_steering;    ///< Only meaningful in FOUR_WHEEL_STEERING mode.
 
-    /// FourWheelSteering command related:
-    realtime_tools::RealtimeBuffer<Command4ws> command_four_wheel_steering_;
-    Command4ws command_struct_four_wheel_steering_;
+      Command() : mode(FOUR_WHEEL_STEERING), stamp(0.0) {}
+    };
+    controller_instrumentation::CommandChannel<Command> command_;
+    /// Last accepted command, guarded by command_mutex_ as both subscription callbacks may write it:
+    Command command_struct_;
+    std::mutex command_mutex_;
+    ros::Subscriber sub_command_;
     ros::Subscriber sub_command_four_wheel_steering_;
 
+    /// Time without commands of the active mode before a command of the other mode takes over, 0 to apply the latest
+    /// command of either topic:
+    double command_mode_hold_;
+
     /// Odometry related:
-    std::shared_ptr<realtime_tools::RealtimePublisher<nav_msgs::Odometry> > odom_pub_;
     std::shared_ptr<realtime_tools::RealtimePublisher<four_wheel_steering_msgs::FourWheelSteeringStamped> > odom_4ws_pub_;
-    std::shared_ptr<realtime_tools::RealtimePublisher<tf::tfMessage> > tf_odom_pub_;
+    std::shared_ptr<realtime_tools::RealtimePublisher<std_msgs::Float64MultiArray> > odom_slip_pub_;
     Odometry odometry_;
+    diff_drive_controller::BaseOdometryPublisher odom_publisher_;
+
+    /// Whether the odometry fuses the four wheels in a least-squares fit, publishing their slip residuals:
+    bool fused_odometry_;
+
+    /// Wheel commands and odometry steering angles:
+    FourWheelKinematics kinematics_;
 
     /// Wheel separation (or track), distance between left and right wheels (from the midpoint of the wheel width):
     double track_;
@@ -207,6 +235,15 @@ namespace four_wheel_steering_controller{
      */
     void cmdFourWheelSteeringCallback(const four_wheel_steering_msgs::FourWheelSteering &command);
 
+    /**
+     * \brief Apply the mode-switch policy to a command received on the topic of \p mode
+     * \param mode  Mode of the received command
+     * \param stamp Reception time of the command
+     * \return true if the command replaces the last accepted one; false if the other mode holds the controller
+     * \note command_mutex_ must be held
+     */
+    bool acceptCommandMode(Command::Mode mode, const ros::Time& stamp) const;
+
     /**
      * \brief Get the wheel names from a wheel param
      * \param [in]  controller_nh Controller node handler
@@ -218,14 +255,6 @@ namespace four_wheel_steering_controller{
     bool getWheelNames(ros::NodeHandle& controller_nh,
                        const std::string& wheel_param,
                        std::vector<std::string>& wheel_names);
-
-    /**
-     * \brief Sets the odometry publishing fields
-     * \param root_nh Root node handle
-     * \param controller_nh Node handle inside the controller namespace
-     */
-    void setOdomPubFields(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh);
-
   };
 
   PLUGINLIB_EXPORT_CLASS(four_wheel_steering_controller::FourWheelSteeringController, controller_interface::ControllerBase);
@@ -36,15 +36,12 @@
 #define ODOMETRY_H_
 
 #include <ros/time.h>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/rolling_mean.hpp>
 #include <boost/function.hpp>
+#include <controller_instrumentation/kinematic_filter.h>
+#include <four_wheel_steering_controller/four_wheel_kinematics.h>
 
 namespace four_wheel_steering_controller
 {
-  namespace bacc = boost::accumulators;
-
   /**
    * \brief The Odometry class handles odometry readings
    * (2D pose and velocity with related timestamp)
@@ -60,7 +57,7 @@ namespace four_wheel_steering_controller
      * \brief Constructor
      * Timestamp will get the current time value
      * Value will be set to zero
-     * \param velocity_rolling_window_size Rolling window size used to compute the velocity mean
+     * \param velocity_rolling_window_size Rolling window size with the same smoothing as the derivative filters
      */
     Odometry(size_t velocity_rolling_window_size = 10);
 
@@ -84,6 +81,32 @@ namespace four_wheel_steering_controller
     bool update(const double& fl_speed, const double& fr_speed, const double& rl_speed, const double& rr_speed,
                 double front_steering, double rear_steering, const ros::Time &time);
 
+    /**
+     * \brief Updates the odometry class with latest wheels speeds and steering positions, fusing all the wheels
+     *
+     * Instead of averaging the wheels into a front and a rear axle, solves the rigid body velocity that best fits the
+     * velocity of the four steering axes in the least-squares sense, with the pseudo-inverse factored by
+     * setWheelParams(). What the fit can't explain is left in the per wheel slip residuals.
+     * \param velocities     Wheel velocities [rad/s]
+     * \param steering       Wheel steering positions [rad]
+     * \param front_steering Front steering position [rad], only used for the steering velocity
+     * \param rear_steering  Rear steering position [rad], only used for the steering velocity
+     * \param time           Current time
+     * \return true if the odometry is actually updated
+     */
+    bool updateFused(const WheelValues& velocities, const WheelValues& steering,
+                     double front_steering, double rear_steering, const ros::Time &time);
+
+    /**
+     * \brief Updates the odometry class with a velocity estimated elsewhere, e.g. from N steering modules
+     * \param linear_x Linear velocity along x of the robot frame [m/s]
+     * \param linear_y Linear velocity along y of the robot frame [m/s]
+     * \param angular  Angular velocity [rad/s]
+     * \param time     Current time
+     * \return true if the odometry is actually updated
+     */
+    bool updateVelocity(double linear_x, double linear_y, double angular, const ros::Time &time);
+
     /**
      * \brief heading getter
      * \return heading [rad]
@@ -154,7 +177,7 @@ namespace four_wheel_steering_controller
      */
     double getLinearAcceleration() const
     {
-      return bacc::rolling_mean(linear_accel_acc_);
+      return linear_filter_.firstDerivative();
     }
 
     /**
@@ -163,25 +186,34 @@ namespace four_wheel_steering_controller
      */
     double getLinearJerk() const
     {
-      return bacc::rolling_mean(linear_jerk_acc_);
+      return linear_filter_.secondDerivative();
     }
 
     /**
      * \brief front steering velocity getter
-     * \return front_steer_vel [m/s³]
+     * \return front_steer_vel [rad/s]
      */
     double getFrontSteerVel() const
     {
-      return bacc::rolling_mean(front_steer_vel_acc_);
+      return front_steering_filter_.firstDerivative();
     }
 
     /**
      * \brief rear steering velocity getter
-     * \return rear_steer_vel [m/s³]
+     * \return rear_steer_vel [rad/s]
      */
     double getRearSteerVel() const
     {
-      return bacc::rolling_mean(rear_steer_vel_acc_);
+      return rear_steering_filter_.firstDerivative();
+    }
+
+    /**
+     * \brief Slip residuals getter, only updated by updateFused()
+     * \return Norm of the velocity of each steering axis not explained by the rigid body velocity [m/s]
+     */
+    const WheelValues& getSlipResiduals() const
+    {
+      return slip_residuals_;
     }
 
     /**
@@ -201,9 +233,25 @@ namespace four_wheel_steering_controller
 
   private:
 
-    /// Rolling mean accumulator and window:
-    typedef bacc::accumulator_set<double, bacc::stats<bacc::tag::rolling_mean> > RollingMeanAcc;
-    typedef bacc::tag::rolling_window RollingWindow;
+    /// Filter estimating a signal and its first two derivatives:
+    typedef controller_instrumentation::KinematicFilter<double> KinematicFilter;
+
+    /**
+     * \brief Integrates the current velocity over the time since the last update, and updates the linear acceleration
+     * and jerk estimates
+     * \param [in]  time Current time
+     * \param [out] dt   Time since the last update [s]
+     * \return true if the interval is large enough to integrate with
+     */
+    bool integrateVelocity(const ros::Time &time, double &dt);
+
+    /**
+     * \brief Updates the steering velocity estimates
+     * \param front_steering Front steering position [rad]
+     * \param rear_steering  Rear steering position [rad]
+     * \param dt             Time since the last update [s]
+     */
+    void updateSteeringVelocity(double front_steering, double rear_steering, double dt);
 
     /**
      * \brief Integrates the velocities (linear on x and y and angular)
@@ -228,7 +276,7 @@ namespace four_wheel_steering_controller
     void integrateExact(double linear, double angular);
 
     /**
-     *  \brief Reset linear and angular accumulators
+     *  \brief Reset the derivative filters
      */
     void resetAccumulators();
 
@@ -250,17 +298,27 @@ namespace four_wheel_steering_controller
     double wheel_radius_;
     double wheel_base_;
 
+    /// Steering axes positions in the base frame, and inverse of the normal matrix of the fused fit, which is diagonal
+    /// as the axes are symmetric:
+    WheelValues steering_x_;
+    WheelValues steering_y_;
+    double fused_inverse_moment_;
+
+    /// Sign of each wheel steering offset along the base y axis:
+    WheelValues steering_offset_side_;
+
+    /// Slip residuals of the last fused update [m/s]:
+    WheelValues slip_residuals_;
+
     /// Previous wheel position/state [rad]:
     double wheel_old_pos_;
 
-    /// Rolling mean accumulators for the linar and angular velocities:
+    /// Filters of the linear velocity, giving the linear acceleration and jerk, and of the steering positions, giving
+    /// the steering velocities:
     size_t velocity_rolling_window_size_;
-    RollingMeanAcc linear_accel_acc_;
-    RollingMeanAcc linear_jerk_acc_;
-    RollingMeanAcc front_steer_vel_acc_;
-    RollingMeanAcc rear_steer_vel_acc_;
-    double linear_vel_prev_, linear_accel_prev_;
-    double front_steer_vel_prev_, rear_steer_vel_prev_;
+    KinematicFilter linear_filter_;
+    KinematicFilter front_steering_filter_;
+    KinematicFilter rear_steering_filter_;
   };
 }
 
@@ -0,0 +1,114 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef SWERVE_KINEMATICS_H_
+#define SWERVE_KINEMATICS_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace four_wheel_steering_controller
+{
+
+  /**
+   * \brief Kinematics of N independently steered wheel modules: wheel velocities and steering angles from a twist, and
+   * the twist that best fits the measured module velocities in the least-squares sense
+   *
+   * Each module is a driven wheel whose contact point lies under its steering axis, at (x, y) in the base frame.
+   * Module values are stored as contiguous arrays, one per quantity, indexed like the modules. The normal matrix of the
+   * odometry fit only depends on the module positions, so its inverse is computed once by setModules() and the fit is a
+   * single pass over the modules.
+   *
+   * \note twistToModules() and modulesToTwist() are realtime-safe, setModules() is \b not
+   */
+  class SwerveKinematics
+  {
+  public:
+    SwerveKinematics();
+
+    /**
+     * \brief Set the module geometry
+     * \param x            Position of each steering axis along the base x axis [m]
+     * \param y            Position of each steering axis along the base y axis [m]
+     * \param wheel_radius Wheel radius [m], the same for all modules
+     * \return true if the twist is observable from the modules, i.e. there are at least two modules and they are not
+     *         all at the same position; false otherwise
+     */
+    bool setModules(const std::vector<double>& x, const std::vector<double>& y, double wheel_radius);
+
+    /**
+     * \return Number of modules
+     */
+    size_t size() const
+    {
+      return x_.size();
+    }
+
+    /**
+     * \brief Wheel velocities and steering angles following a twist
+     *
+     * Steering angles are kept within [-pi/2, pi/2] by reversing the wheel instead. A module that should not move
+     * keeps its steering angle.
+     * \param [in]      lin_x      Linear velocity along x [m/s]
+     * \param [in]      lin_y      Linear velocity along y [m/s]
+     * \param [in]      ang        Angular velocity [rad/s]
+     * \param [out]     velocities Wheel velocities [rad/s], size() values
+     * \param [in, out] steering   Steering angles [rad], size() values: previous on input, new on output
+     */
+    void twistToModules(double lin_x, double lin_y, double ang, double* velocities, double* steering) const;
+
+    /**
+     * \brief Twist that best fits the wheel velocities and steering angles, in the least-squares sense
+     * \param [in]  velocities Wheel velocities [rad/s], size() values
+     * \param [in]  steering   Steering angles [rad], size() values
+     * \param [out] lin_x      Linear velocity along x [m/s]
+     * \param [out] lin_y      Linear velocity along y [m/s]
+     * \param [out] ang        Angular velocity [rad/s]
+     */
+    void modulesToTwist(const double* velocities, const double* steering,
+                        double& lin_x, double& lin_y, double& ang) const;
+
+  private:
+    /// Module positions [m]:
+    std::vector<double> x_;
+    std::vector<double> y_;
+
+    double wheel_radius_;
+
+    /// Inverse of the normal matrix of the odometry fit, row major:
+    double normal_inverse_[3][3];
+  };
+}
+
+#endif /* SWERVE_KINEMATICS_H_ */
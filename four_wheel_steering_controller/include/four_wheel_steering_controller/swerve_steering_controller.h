@@ -0,0 +1,225 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Irstea
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Irstea nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef SWERVE_STEERING_CONTROLLER_H_
+#define SWERVE_STEERING_CONTROLLER_H_
+
+#include <controller_instrumentation/command_channel_monitor.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_interface/multi_interface_controller.h>
+#include <diff_drive_controller/base_odometry_publisher.h>
+#include <hardware_interface/joint_command_interface.h>
+#include <pluginlib/class_list_macros.hpp>
+
+#include <geometry_msgs/Twist.h>
+
+#include <urdf_geometry_parser/urdf_geometry_parser.h>
+
+#include <four_wheel_steering_controller/odometry.h>
+#include <four_wheel_steering_controller/speed_limiter.h>
+#include <four_wheel_steering_controller/swerve_kinematics.h>
+
+namespace four_wheel_steering_controller{
+
+  /**
+   * Controller for a base with any number of independently steered wheel modules (swerve drive), e.g. a six wheel
+   * steering robot. Each module pairs a velocity controlled wheel with a position controlled steering joint, and the
+   * modules are configured as an array:
+   * \code
+   * modules:
+   *   - {wheel: front_left_wheel, steering: front_left_steering_joint, x: 0.6, y: 0.4}
+   *   - ...
+   * \endcode
+   * where x and y, the position of the steering axis in the base frame, are looked up in the URDF when omitted.
+   *
+   * This class makes some assumptions on the model of the robot:
+   *  - the wheel contact point lies under the steering axis
+   *  - the wheels are identical in radius
+   *  - the steering joints range at least within [-pi/2, pi/2]
+   */
+  class SwerveSteeringController
+      : public controller_interface::MultiInterfaceController<hardware_interface::VelocityJointInterface,
+                                                              hardware_interface::PositionJointInterface>
+  {
+  public:
+    SwerveSteeringController();
+
+    /**
+     * \brief Initialize controller
+     * \param robot_hw      Velocity and position joint interface for the modules
+     * \param root_nh       Node handle at root namespace
+     * \param controller_nh Node handle inside the controller namespace
+     */
+    bool init(hardware_interface::RobotHW* robot_hw,
+               ros::NodeHandle& root_nh,
+               ros::NodeHandle &controller_nh);
+
+    /**
+     * \brief Updates controller, i.e. computes the odometry and sets the new module commands
+     * \param time   Current time
+     * \param period Time since the last called to update
+     */
+    void update(const ros::Time& time, const ros::Duration& period);
+
+    /**
+     * \brief Starts controller
+     * \param time Current time
+     */
+    void starting(const ros::Time& time);
+
+    /**
+     * \brief Stops controller
+     * \param time Current time
+     */
+    void stopping(const ros::Time& /*time*/);
+
+  private:
+    std::string name_;
+
+    /// Audit of realtime-unsafe operations in update():
+    controller_instrumentation::RealtimeAudit rt_audit_;
+
+    /// Write statistics of the velocity command channel:
+    controller_instrumentation::CommandChannelMonitor command_monitor_;
+
+    /// Odometry related:
+    ros::Duration publish_period_;
+    bool open_loop_;
+
+    /// Hardware handles, one per module:
+    std::vector<hardware_interface::JointHandle> wheel_joints_;
+    std::vector<hardware_interface::JointHandle> steering_joints_;
+
+    /// Module states and commands, preallocated for the realtime loop:
+    std::vector<double> wheel_velocities_;
+    std::vector<double> steering_positions_;
+    std::vector<double> wheel_commands_;
+    std::vector<double> steering_commands_;
+
+    /// Velocity command related:
+    struct Command
+    {
+      double lin_x;
+      double lin_y;
+      double ang;
+      ros::Time stamp;
+
+      Command() : lin_x(0.0), lin_y(0.0), ang(0.0), stamp(0.0) {}
+    };
+    controller_instrumentation::CommandChannel<Command> command_;
+    Command command_struct_;
+    ros::Subscriber sub_command_;
+
+    /// Odometry related:
+    Odometry odometry_;
+    diff_drive_controller::BaseOdometryPublisher odom_publisher_;
+
+    /// Module commands and odometry fit:
+    SwerveKinematics kinematics_;
+
+    /// Wheel radius (assuming it's the same for every module):
+    double wheel_radius_;
+
+    /// Timeout to consider cmd_vel commands old:
+    double cmd_vel_timeout_;
+
+    /// Frame to use for the robot base:
+    std::string base_frame_id_;
+
+    /// Whether to publish odometry to tf or not:
+    bool enable_odom_tf_;
+
+    /// Speed limiters:
+    Command last1_cmd_;
+    Command last0_cmd_;
+    diff_drive_controller::TwistLimiter limiter_;
+
+  private:
+
+    /**
+     * \brief Update and publish odometry
+     * \param time   Current time
+     */
+    void updateOdometry(const ros::Time &time);
+
+    /**
+     * \brief Compute and publish command
+     * \param time   Current time
+     * \param period Time since the last called to update
+     */
+    void updateCommand(const ros::Time& time, const ros::Duration& period);
+
+    /**
+     * \brief Brakes the wheels, i.e. sets the velocity to 0, and keeps the steering angles
+     */
+    void brake();
+
+    /**
+     * \brief Velocity command callback
+     * \param command Velocity command message (twist)
+     */
+    void cmdVelCallback(const geometry_msgs::Twist& command);
+
+    /**
+     * \brief Get the module joint names and positions from the modules param
+     * \param [in]  controller_nh   Controller node handler
+     * \param [in]  uvk             URDF parser, used for the positions missing from the param
+     * \param [out] wheel_names     Wheel joint names
+     * \param [out] steering_names  Steering joint names
+     * \param [out] x               Position of each steering axis along the base x axis [m]
+     * \param [out] y               Position of each steering axis along the base y axis [m]
+     * \return true if the modules param is a list of modules with the wheel and steering names and a position
+     *         available; false otherwise
+     */
+    bool getModules(ros::NodeHandle& controller_nh,
+                    urdf_geometry_parser::UrdfGeometryParser& uvk,
+                    std::vector<std::string>& wheel_names,
+                    std::vector<std::string>& steering_names,
+                    std::vector<double>& x,
+                    std::vector<double>& y);
+
+    /**
+     * \brief Get the velocity, acceleration and jerk limits of one axis
+     * \param controller_nh Node handle inside the controller namespace
+     * \param axis_ns       Namespace of the axis params, e.g. "linear/x"
+     * \return Limits of the axis
+     */
+    diff_drive_controller::SpeedLimiter getAxisLimits(ros::NodeHandle& controller_nh, const std::string& axis_ns);
+  };
+
+  PLUGINLIB_EXPORT_CLASS(four_wheel_steering_controller::SwerveSteeringController, controller_interface::ControllerBase);
+} // namespace four_wheel_steering_controller
+
+#endif /* SWERVE_STEERING_CONTROLLER_H_ */
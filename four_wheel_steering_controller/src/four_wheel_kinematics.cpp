@@ -0,0 +1,172 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <cmath>
+
+#include <four_wheel_steering_controller/four_wheel_kinematics.h>
+
+namespace four_wheel_steering_controller
+{
+  namespace
+  {
+    const size_t WHEELS = WheelValues::WHEELS;
+
+    /// Side of each wheel: -1 on the left, 1 on the right:
+    const WheelValues SIDE = {{-1.0, 1.0, -1.0, 1.0}};
+  }
+
+  FourWheelKinematics::FourWheelKinematics()
+  : steering_track_(0.0)
+  , wheel_steering_y_offset_(0.0)
+  , wheel_radius_(0.0)
+  , wheel_base_(0.0)
+  {
+  }
+
+  void FourWheelKinematics::setGeometry(double track, double wheel_steering_y_offset,
+                                        double wheel_radius, double wheel_base)
+  {
+    steering_track_ = track - 2 * wheel_steering_y_offset;
+    wheel_steering_y_offset_ = wheel_steering_y_offset;
+    wheel_radius_ = wheel_radius;
+    wheel_base_ = wheel_base;
+  }
+
+  void FourWheelKinematics::twistToWheels(double lin, double ang, WheelValues& velocities, WheelValues& steering) const
+  {
+    // Compute wheels velocities:
+    WheelValues vel_x, vel_y;
+    for (size_t i = 0; i < WHEELS; ++i)
+    {
+      vel_x[i] = lin + SIDE[i] * ang * steering_track_ / 2.0;
+      vel_y[i] = wheel_base_ * ang / 2.0;
+    }
+    const bool moving = std::fabs(lin) > 0.001;
+    wheelVelocities(moving ? std::copysign(1.0, lin) : 0.0, ang * wheel_steering_y_offset_ / wheel_radius_,
+                    vel_x, vel_y, velocities);
+
+    // Compute steering angles, the rear ones being opposite to the front ones:
+    const bool turning = std::fabs(2.0 * lin) > std::fabs(ang * steering_track_);
+    const double saturated = moving ? std::copysign(M_PI_2, ang) : 0.0;
+    const double steering_left = turning ? std::atan(ang * wheel_base_ / (2.0 * vel_x[WheelValues::FRONT_LEFT]))
+                                         : saturated;
+    const double steering_right = turning ? std::atan(ang * wheel_base_ / (2.0 * vel_x[WheelValues::FRONT_RIGHT]))
+                                          : saturated;
+    steering[WheelValues::FRONT_LEFT]  =  steering_left;
+    steering[WheelValues::FRONT_RIGHT] =  steering_right;
+    steering[WheelValues::REAR_LEFT]   = -steering_left;
+    steering[WheelValues::REAR_RIGHT]  = -steering_right;
+  }
+
+  void FourWheelKinematics::fourWheelSteeringToWheels(double lin, double front_steering, double rear_steering,
+                                                      WheelValues& velocities, WheelValues& steering) const
+  {
+    const double tan_front_steering = std::tan(front_steering);
+    const double tan_rear_steering  = std::tan(rear_steering);
+
+    // Compute the tangent of each steering angle, or zero if the center of rotation is on a wheel axis:
+    const double steering_diff = steering_track_ * (tan_front_steering - tan_rear_steering) / 2.0;
+    const bool valid = std::fabs(wheel_base_ - std::fabs(steering_diff)) > 0.001;
+    const WheelValues tan_steering_axle = {{tan_front_steering, tan_front_steering,
+                                            tan_rear_steering, tan_rear_steering}};
+    WheelValues tan_steering;
+    for (size_t i = 0; i < WHEELS; ++i)
+    {
+      tan_steering[i] = valid ? wheel_base_ * tan_steering_axle[i] / (wheel_base_ + SIDE[i] * steering_diff) : 0.0;
+    }
+    for (size_t i = 0; i < WHEELS; ++i)
+    {
+      steering[i] = std::atan(tan_steering[i]);
+    }
+
+    // Virtual front and rear wheelbases, i.e. the distances between the projection of the center of rotation on the
+    // wheelbase and the front and rear axles:
+    const double tan_front_diff = tan_steering[WheelValues::FRONT_LEFT] - tan_steering[WheelValues::FRONT_RIGHT];
+    const double tan_rear_diff  = tan_steering[WheelValues::REAR_LEFT]  - tan_steering[WheelValues::REAR_RIGHT];
+    const double l_front = std::fabs(tan_front_diff) > 0.01
+        ? tan_steering[WheelValues::FRONT_RIGHT] * tan_steering[WheelValues::FRONT_LEFT] * steering_track_ / tan_front_diff
+        : 0.0;
+    const double l_rear = std::fabs(tan_rear_diff) > 0.01
+        ? tan_steering[WheelValues::REAR_RIGHT] * tan_steering[WheelValues::REAR_LEFT] * steering_track_ / tan_rear_diff
+        : 0.0;
+
+    // Compute wheels velocities:
+    const double ang = lin * (tan_front_steering - tan_rear_steering) / wheel_base_;
+    const WheelValues l_axle = {{l_front, l_front, l_rear, l_rear}};
+    WheelValues vel_x, vel_y;
+    for (size_t i = 0; i < WHEELS; ++i)
+    {
+      vel_x[i] = lin + SIDE[i] * ang * steering_track_ / 2.0;
+      vel_y[i] = l_axle[i] * ang;
+    }
+    const bool moving = std::fabs(lin) > 0.001;
+    wheelVelocities(moving ? std::copysign(1.0, lin) : 0.0, ang * wheel_steering_y_offset_ / wheel_radius_,
+                    vel_x, vel_y, velocities);
+  }
+
+  void FourWheelKinematics::wheelsToSteering(const WheelValues& steering,
+                                             double& front_steering, double& rear_steering)
+  {
+    WheelValues tan_steering;
+    for (size_t i = 0; i < WHEELS; ++i)
+    {
+      tan_steering[i] = std::tan(steering[i]);
+    }
+
+    // The virtual steering angle is the one of a wheel in the middle of the axle:
+    const bool front_steered = std::fabs(steering[WheelValues::FRONT_LEFT])  > 0.001 ||
+                               std::fabs(steering[WheelValues::FRONT_RIGHT]) > 0.001;
+    const bool rear_steered  = std::fabs(steering[WheelValues::REAR_LEFT])  > 0.001 ||
+                               std::fabs(steering[WheelValues::REAR_RIGHT]) > 0.001;
+    const double front = 2 * tan_steering[WheelValues::FRONT_LEFT] * tan_steering[WheelValues::FRONT_RIGHT] /
+                         (tan_steering[WheelValues::FRONT_LEFT] + tan_steering[WheelValues::FRONT_RIGHT]);
+    const double rear  = 2 * tan_steering[WheelValues::REAR_LEFT] * tan_steering[WheelValues::REAR_RIGHT] /
+                         (tan_steering[WheelValues::REAR_LEFT] + tan_steering[WheelValues::REAR_RIGHT]);
+    front_steering = front_steered ? std::atan(front) : 0.0;
+    rear_steering  = rear_steered  ? std::atan(rear)  : 0.0;
+  }
+
+  void FourWheelKinematics::wheelVelocities(double sign, double vel_steering_offset,
+                                            const WheelValues& vel_x, const WheelValues& vel_y,
+                                            WheelValues& velocities) const
+  {
+    // A zero sign stops the wheels:
+    const double offset = sign != 0.0 ? vel_steering_offset : 0.0;
+    for (size_t i = 0; i < WHEELS; ++i)
+    {
+      velocities[i] = sign * std::sqrt(vel_x[i] * vel_x[i] + vel_y[i] * vel_y[i]) / wheel_radius_ + SIDE[i] * offset;
+    }
+  }
+
+} // namespace four_wheel_steering_controller
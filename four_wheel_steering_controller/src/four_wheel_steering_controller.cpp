@@ -35,14 +35,15 @@
 
 #include <cmath>
 #include <four_wheel_steering_controller/four_wheel_steering_controller.h>
-#include <tf/transform_datatypes.h>
+#include <controller_instrumentation/tracepoints.h>
 #include <urdf_geometry_parser/urdf_geometry_parser.h>
 
 namespace four_wheel_steering_controller{
 
   FourWheelSteeringController::FourWheelSteeringController()
-    : command_struct_twist_()
-    , command_struct_four_wheel_steering_()
+    : command_struct_()
+    , command_mode_hold_(0.0)
+    , fused_odometry_(false)
     , track_(0.0)
     , wheel_steering_y_offset_(0.0)
     , wheel_radius_(0.0)
@@ -62,6 +63,11 @@ namespace four_wheel_steering_controller{
     std::size_t id = complete_ns.find_last_of("/");
     name_ = complete_ns.substr(id + 1);
 
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope =
+      controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh, name_);
+    if (!thread_placement_scope) {return false;}
+
     // Get joint names from the parameter server
     std::vector<std::string> front_wheel_names, rear_wheel_names;
     if (!getWheelNames(controller_nh, "front_wheel", front_wheel_names) ||
@@ -132,11 +138,23 @@ namespace four_wheel_steering_controller{
 
     odometry_.setVelocityRollingWindowSize(velocity_rolling_window_size);
 
+    controller_nh.param("fused_odometry", fused_odometry_, fused_odometry_);
+    ROS_INFO_STREAM_NAMED(name_, "Odometry " << (fused_odometry_?"fuses all the wheels":"averages each axle"));
+
     // Twist command related:
     controller_nh.param("cmd_vel_timeout", cmd_vel_timeout_, cmd_vel_timeout_);
     ROS_INFO_STREAM_NAMED(name_, "Velocity commands will be considered old if they are older than "
                           << cmd_vel_timeout_ << "s.");
 
+    controller_nh.param("command_mode_hold", command_mode_hold_, command_mode_hold_);
+    if (command_mode_hold_ < 0.0)
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Command mode hold must be non-negative, got " << command_mode_hold_ << "s.");
+      return false;
+    }
+    ROS_INFO_STREAM_NAMED(name_, "Commands of the other mode will take over after "
+                          << command_mode_hold_ << "s without commands of the active mode.");
+
     controller_nh.param("base_frame_id", base_frame_id_, base_frame_id_);
     ROS_INFO_STREAM_NAMED(name_, "Base frame_id set to " << base_frame_id_);
 
@@ -190,13 +208,24 @@ namespace four_wheel_steering_controller{
     // Regardless of how we got the separation and radius, use them
     // to set the odometry parameters
     odometry_.setWheelParams(track_-2*wheel_steering_y_offset_, wheel_steering_y_offset_, wheel_radius_, wheel_base_);
+    kinematics_.setGeometry(track_, wheel_steering_y_offset_, wheel_radius_, wheel_base_);
     ROS_INFO_STREAM_NAMED(name_,
                           "Odometry params : track " << track_
                           << ", wheel radius " << wheel_radius_
                           << ", wheel base " << wheel_base_
                           << ", wheel steering offset " << wheel_steering_y_offset_);
 
-    setOdomPubFields(root_nh, controller_nh);
+    odom_publisher_.init(name_, root_nh, controller_nh, "odom", base_frame_id_, publish_period_, enable_odom_tf_);
+
+    odom_4ws_pub_.reset(new realtime_tools::RealtimePublisher<four_wheel_steering_msgs::FourWheelSteeringStamped>(controller_nh, "odom_steer", 100));
+    odom_4ws_pub_->msg_.header.frame_id = "odom";
+
+    if (fused_odometry_)
+    {
+      // Slip residuals of the front left, front right, rear left and rear right wheels [m/s]:
+      odom_slip_pub_.reset(new realtime_tools::RealtimePublisher<std_msgs::Float64MultiArray>(controller_nh, "odom_slip", 100));
+      odom_slip_pub_->msg_.data.resize(WheelValues::WHEELS, 0.0);
+    }
 
 
     hardware_interface::VelocityJointInterface *const vel_joint_hw = robot_hw->get<hardware_interface::VelocityJointInterface>();
@@ -225,11 +254,16 @@ namespace four_wheel_steering_controller{
     sub_command_ = controller_nh.subscribe("cmd_vel", 1, &FourWheelSteeringController::cmdVelCallback, this);
     sub_command_four_wheel_steering_ = controller_nh.subscribe("cmd_four_wheel_steering", 1, &FourWheelSteeringController::cmdFourWheelSteeringCallback, this);
 
+    rt_audit_.init(controller_nh, name_);
+    command_monitor_.add("command", command_.stats());
+    command_monitor_.init(controller_nh, name_);
+
     return true;
   }
 
   void FourWheelSteeringController::update(const ros::Time& time, const ros::Duration& period)
   {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
     updateOdometry(time);
     updateCommand(time, period);
   }
@@ -239,7 +273,7 @@ namespace four_wheel_steering_controller{
     brake();
 
     // Register starting time used to keep fixed rate
-    last_state_publish_time_ = time;
+    odom_publisher_.starting(time);
 
     odometry_.init(time);
   }
@@ -247,6 +281,7 @@ namespace four_wheel_steering_controller{
   void FourWheelSteeringController::stopping(const ros::Time& /*time*/)
   {
     brake();
+    odom_publisher_.stopping();
   }
 
   void FourWheelSteeringController::updateOdometry(const ros::Time& time)
@@ -260,52 +295,43 @@ namespace four_wheel_steering_controller{
         || std::isnan(rl_speed) || std::isnan(rr_speed))
       return;
 
-    const double fl_steering = front_steering_joints_[0].getPosition();
-    const double fr_steering = front_steering_joints_[1].getPosition();
-    const double rl_steering = rear_steering_joints_[0].getPosition();
-    const double rr_steering = rear_steering_joints_[1].getPosition();
-    if (std::isnan(fl_steering) || std::isnan(fr_steering)
-        || std::isnan(rl_steering) || std::isnan(rr_steering))
+    WheelValues steering;
+    steering[WheelValues::FRONT_LEFT]  = front_steering_joints_[0].getPosition();
+    steering[WheelValues::FRONT_RIGHT] = front_steering_joints_[1].getPosition();
+    steering[WheelValues::REAR_LEFT]   = rear_steering_joints_[0].getPosition();
+    steering[WheelValues::REAR_RIGHT]  = rear_steering_joints_[1].getPosition();
+    if (std::isnan(steering[WheelValues::FRONT_LEFT]) || std::isnan(steering[WheelValues::FRONT_RIGHT])
+        || std::isnan(steering[WheelValues::REAR_LEFT]) || std::isnan(steering[WheelValues::REAR_RIGHT]))
       return;
     double front_steering_pos = 0.0;
-    if(fabs(fl_steering) > 0.001 || fabs(fr_steering) > 0.001)
+    double rear_steering_pos = 0.0;
+    FourWheelKinematics::wheelsToSteering(steering, front_steering_pos, rear_steering_pos);
+
+    ROS_DEBUG_STREAM_THROTTLE(1, "rl_steering "<<steering[WheelValues::REAR_LEFT]<<" rr_steering "<<steering[WheelValues::REAR_RIGHT]<<" rear_steering_pos "<<rear_steering_pos);
+    // Estimate linear and angular velocity using joint information
+    if (fused_odometry_)
     {
-      front_steering_pos = atan(2*tan(fl_steering)*tan(fr_steering)/
-                                      (tan(fl_steering) + tan(fr_steering)));
+      const WheelValues velocities = {{fl_speed, fr_speed, rl_speed, rr_speed}};
+      odometry_.updateFused(velocities, steering, front_steering_pos, rear_steering_pos, time);
     }
-    double rear_steering_pos = 0.0;
-    if(fabs(rl_steering) > 0.001 || fabs(rr_steering) > 0.001)
+    else
     {
-      rear_steering_pos = atan(2*tan(rl_steering)*tan(rr_steering)/
-                                     (tan(rl_steering) + tan(rr_steering)));
+      odometry_.update(fl_speed, fr_speed, rl_speed, rr_speed,
+                       front_steering_pos, rear_steering_pos, time);
     }
 
-    ROS_DEBUG_STREAM_THROTTLE(1, "rl_steering "<<rl_steering<<" rr_steering "<<rr_steering<<" rear_steering_pos "<<rear_steering_pos);
-    // Estimate linear and angular velocity using joint information
-    odometry_.update(fl_speed, fr_speed, rl_speed, rr_speed,
-                     front_steering_pos, rear_steering_pos, time);
-
     // Publish odometry message
-    if (last_state_publish_time_ + publish_period_ < time)
+    diff_drive_controller::OdometrySample sample;
+    sample.stamp    = time;
+    sample.x        = odometry_.getX();
+    sample.y        = odometry_.getY();
+    sample.heading  = odometry_.getHeading();
+    sample.linear   = odometry_.getLinearX();
+    sample.linear_y = odometry_.getLinearY();
+    sample.angular  = odometry_.getAngular();
+    if (odom_publisher_.update(sample))
     {
-      last_state_publish_time_ += publish_period_;
-      // Compute and store orientation info
-      const geometry_msgs::Quaternion orientation(
-            tf::createQuaternionMsgFromYaw(odometry_.getHeading()));
-
-      // Populate odom message and publish
-      if (odom_pub_->trylock())
-      {
-        odom_pub_->msg_.header.stamp = time;
-        odom_pub_->msg_.pose.pose.position.x = odometry_.getX();
-        odom_pub_->msg_.pose.pose.position.y = odometry_.getY();
-        odom_pub_->msg_.pose.pose.orientation = orientation;
-        odom_pub_->msg_.twist.twist.linear.x  = odometry_.getLinearX();
-        odom_pub_->msg_.twist.twist.linear.y  = odometry_.getLinearY();
-        odom_pub_->msg_.twist.twist.angular.z = odometry_.getAngular();
-        odom_pub_->unlockAndPublish();
-      }
-      if (odom_4ws_pub_->trylock())
+      if (controller_instrumentation::tracedTrylock(*odom_4ws_pub_, "odom_steer"))
       {
         odom_4ws_pub_->msg_.header.stamp = time;
         odom_4ws_pub_->msg_.data.speed = odometry_.getLinear();
@@ -318,59 +344,36 @@ namespace four_wheel_steering_controller{
         odom_4ws_pub_->unlockAndPublish();
       }
 
-      // Publish tf /odom frame
-      if (enable_odom_tf_ && tf_odom_pub_->trylock())
+      if (fused_odometry_ && controller_instrumentation::tracedTrylock(*odom_slip_pub_, "odom_slip"))
       {
-        geometry_msgs::TransformStamped& odom_frame = tf_odom_pub_->msg_.transforms[0];
-        odom_frame.header.stamp = time;
-        odom_frame.transform.translation.x = odometry_.getX();
-        odom_frame.transform.translation.y = odometry_.getY();
-        odom_frame.transform.rotation = orientation;
-        tf_odom_pub_->unlockAndPublish();
+        const WheelValues& slip_residuals = odometry_.getSlipResiduals();
+        for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+          odom_slip_pub_->msg_.data[i] = slip_residuals[i];
+        odom_slip_pub_->unlockAndPublish();
       }
     }
   }
 
   void FourWheelSteeringController::updateCommand(const ros::Time& time, const ros::Duration& period)
   {
-    // Retreive current velocity command and time step:
-    Command* cmd;
-    CommandTwist curr_cmd_twist = *(command_twist_.readFromRT());
-    Command4ws curr_cmd_4ws = *(command_four_wheel_steering_.readFromRT());
-
-    if(curr_cmd_4ws.stamp >= curr_cmd_twist.stamp)
-    {
-      cmd = &curr_cmd_4ws;
-      enable_twist_cmd_ = false;
-    }
-    else
-    {
-      cmd = &curr_cmd_twist;
-      enable_twist_cmd_ = true;
-    }
+    // Retreive current velocity command of either mode and time step:
+    Command curr_cmd = *(command_.readFromRT());
+    CommandTwist& curr_cmd_twist = curr_cmd.twist;
+    Command4ws& curr_cmd_4ws = curr_cmd.four_wheel_steering;
+    enable_twist_cmd_ = curr_cmd.mode == Command::TWIST;
 
-    const double dt = (time - cmd->stamp).toSec();
+    const double dt = (time - curr_cmd.stamp).toSec();
     // Brake if cmd_vel has timeout:
     if (dt > cmd_vel_timeout_)
     {
-      curr_cmd_twist.lin_x = 0.0;
-      curr_cmd_twist.lin_y = 0.0;
-      curr_cmd_twist.ang = 0.0;
-      curr_cmd_4ws.lin = 0.0;
-      curr_cmd_4ws.front_steering = 0.0;
-      curr_cmd_4ws.rear_steering = 0.0;
+      curr_cmd_twist = CommandTwist();
+      curr_cmd_4ws = Command4ws();
     }
 
     const double cmd_dt(period.toSec());
 
-    const double angular_speed = odometry_.getAngular();
-    const double steering_track = track_-2*wheel_steering_y_offset_;
-
-    ROS_DEBUG_STREAM("angular_speed "<<angular_speed<< " wheel_radius_ "<<wheel_radius_);
-    double vel_left_front = 0, vel_right_front = 0;
-    double vel_left_rear = 0, vel_right_rear = 0;
-    double front_left_steering = 0, front_right_steering = 0;
-    double rear_left_steering = 0, rear_right_steering = 0;
+    WheelValues velocities;
+    WheelValues steering;
 
     if(enable_twist_cmd_ == true)
     {
@@ -380,40 +383,8 @@ namespace four_wheel_steering_controller{
       last1_cmd_ = last0_cmd_;
       last0_cmd_ = curr_cmd_twist;
 
-      // Compute wheels velocities:
-      if(fabs(curr_cmd_twist.lin_x) > 0.001)
-      {
-        const double vel_steering_offset = (curr_cmd_twist.ang*wheel_steering_y_offset_)/wheel_radius_;
-        const double sign = copysign(1.0, curr_cmd_twist.lin_x);
-        vel_left_front  = sign * std::hypot((curr_cmd_twist.lin_x - curr_cmd_twist.ang*steering_track/2),
-                                            (wheel_base_*curr_cmd_twist.ang/2.0)) / wheel_radius_
-                          - vel_steering_offset;
-        vel_right_front = sign * std::hypot((curr_cmd_twist.lin_x + curr_cmd_twist.ang*steering_track/2),
-                                            (wheel_base_*curr_cmd_twist.ang/2.0)) / wheel_radius_
-                          + vel_steering_offset;
-        vel_left_rear = sign * std::hypot((curr_cmd_twist.lin_x - curr_cmd_twist.ang*steering_track/2),
-                                          (wheel_base_*curr_cmd_twist.ang/2.0)) / wheel_radius_
-                        - vel_steering_offset;
-        vel_right_rear = sign * std::hypot((curr_cmd_twist.lin_x + curr_cmd_twist.ang*steering_track/2),
-                                           (wheel_base_*curr_cmd_twist.ang/2.0)) / wheel_radius_
-                         + vel_steering_offset;
-      }
-
-      // Compute steering angles
-      if(fabs(2.0*curr_cmd_twist.lin_x) > fabs(curr_cmd_twist.ang*steering_track))
-      {
-        front_left_steering = atan(curr_cmd_twist.ang*wheel_base_ /
-                                    (2.0*curr_cmd_twist.lin_x - curr_cmd_twist.ang*steering_track));
-        front_right_steering = atan(curr_cmd_twist.ang*wheel_base_ /
-                                     (2.0*curr_cmd_twist.lin_x + curr_cmd_twist.ang*steering_track));
-      }
-      else if(fabs(curr_cmd_twist.lin_x) > 0.001)
-      {
-        front_left_steering = copysign(M_PI_2, curr_cmd_twist.ang);
-        front_right_steering = copysign(M_PI_2, curr_cmd_twist.ang);
-      }
-      rear_left_steering = -front_left_steering;
-      rear_right_steering = -front_right_steering;
+      // Compute wheels velocities and steering angles:
+      kinematics_.twistToWheels(curr_cmd_twist.lin_x, curr_cmd_twist.ang, velocities, steering);
     }
     else
     {
@@ -424,74 +395,28 @@ namespace four_wheel_steering_controller{
       curr_cmd_4ws.front_steering = clamp(curr_cmd_4ws.front_steering, -M_PI_2, M_PI_2);
       curr_cmd_4ws.rear_steering = clamp(curr_cmd_4ws.rear_steering, -M_PI_2, M_PI_2);
 
-      // Compute steering angles
-      const double tan_front_steering = tan(curr_cmd_4ws.front_steering);
-      const double tan_rear_steering  = tan(curr_cmd_4ws.rear_steering);
-
-      const double steering_diff =  steering_track*(tan_front_steering - tan_rear_steering)/2.0;
-      if(fabs(wheel_base_ - fabs(steering_diff)) > 0.001)
-      {
-        front_left_steering = atan(wheel_base_*tan_front_steering/(wheel_base_-steering_diff));
-        front_right_steering = atan(wheel_base_*tan_front_steering/(wheel_base_+steering_diff));
-        rear_left_steering = atan(wheel_base_*tan_rear_steering/(wheel_base_-steering_diff));
-        rear_right_steering = atan(wheel_base_*tan_rear_steering/(wheel_base_+steering_diff));
-      }
-
-      // Compute wheels velocities:
-      if(fabs(curr_cmd_4ws.lin) > 0.001)
-      {
-        //Virutal front and rear wheelbase
-        // distance between the projection of the CIR on the wheelbase and the front axle
-        double l_front = 0;
-        if(fabs(tan(front_left_steering) - tan(front_right_steering)) > 0.01)
-        {
-          l_front = tan(front_right_steering) * tan(front_left_steering) * steering_track
-              / (tan(front_left_steering) - tan(front_right_steering));
-        }
-        // distance between the projection of the CIR on the wheelbase and the rear axle
-        double l_rear = 0;
-        if(fabs(tan(rear_left_steering) - tan(rear_right_steering)) > 0.01)
-        {
-          l_rear = tan(rear_right_steering) * tan(rear_left_steering) * steering_track
-              / (tan(rear_left_steering) - tan(rear_right_steering));
-        }
-
-        const double angular_speed_cmd = curr_cmd_4ws.lin * (tan_front_steering-tan_rear_steering)/wheel_base_;
-        const double vel_steering_offset = (angular_speed_cmd*wheel_steering_y_offset_)/wheel_radius_;
-        const double sign = copysign(1.0, curr_cmd_4ws.lin);
-
-        vel_left_front  = sign * std::hypot((curr_cmd_4ws.lin - angular_speed_cmd*steering_track/2),
-                                            (l_front*angular_speed_cmd))/wheel_radius_
-                          - vel_steering_offset;
-        vel_right_front = sign * std::hypot((curr_cmd_4ws.lin + angular_speed_cmd*steering_track/2),
-                                            (l_front*angular_speed_cmd))/wheel_radius_
-                          + vel_steering_offset;
-        vel_left_rear = sign * std::hypot((curr_cmd_4ws.lin - angular_speed_cmd*steering_track/2),
-                                          (l_rear*angular_speed_cmd))/wheel_radius_
-                        - vel_steering_offset;
-        vel_right_rear = sign * std::hypot((curr_cmd_4ws.lin + angular_speed_cmd*steering_track/2),
-                                           (l_rear*angular_speed_cmd))/wheel_radius_
-                         + vel_steering_offset;
-      }
+      // Compute wheels velocities and steering angles:
+      kinematics_.fourWheelSteeringToWheels(curr_cmd_4ws.lin, curr_cmd_4ws.front_steering, curr_cmd_4ws.rear_steering,
+                                            velocities, steering);
     }
 
-    ROS_DEBUG_STREAM_THROTTLE(1, "vel_left_rear "<<vel_left_rear<<" front_right_steering "<<front_right_steering);
+    ROS_DEBUG_STREAM_THROTTLE(1, "vel_left_rear "<<velocities[WheelValues::REAR_LEFT]<<" front_right_steering "<<steering[WheelValues::FRONT_RIGHT]);
     // Set wheels velocities:
     if(front_wheel_joints_.size() == 2 && rear_wheel_joints_.size() == 2)
     {
-      front_wheel_joints_[0].setCommand(vel_left_front);
-      front_wheel_joints_[1].setCommand(vel_right_front);
-      rear_wheel_joints_[0].setCommand(vel_left_rear);
-      rear_wheel_joints_[1].setCommand(vel_right_rear);
+      front_wheel_joints_[0].setCommand(velocities[WheelValues::FRONT_LEFT]);
+      front_wheel_joints_[1].setCommand(velocities[WheelValues::FRONT_RIGHT]);
+      rear_wheel_joints_[0].setCommand(velocities[WheelValues::REAR_LEFT]);
+      rear_wheel_joints_[1].setCommand(velocities[WheelValues::REAR_RIGHT]);
     }
 
     /// TODO check limits to not apply the same steering on right and left when saturated !
     if(front_steering_joints_.size() == 2 && rear_steering_joints_.size() == 2)
     {
-      front_steering_joints_[0].setCommand(front_left_steering);
-      front_steering_joints_[1].setCommand(front_right_steering);
-      rear_steering_joints_[0].setCommand(rear_left_steering);
-      rear_steering_joints_[1].setCommand(rear_right_steering);
+      front_steering_joints_[0].setCommand(steering[WheelValues::FRONT_LEFT]);
+      front_steering_joints_[1].setCommand(steering[WheelValues::FRONT_RIGHT]);
+      rear_steering_joints_[0].setCommand(steering[WheelValues::REAR_LEFT]);
+      rear_steering_joints_[1].setCommand(steering[WheelValues::REAR_RIGHT]);
     }
   }
 
@@ -521,17 +446,25 @@ namespace four_wheel_steering_controller{
         ROS_WARN("Received NaN in geometry_msgs::Twist. Ignoring command.");
         return;
       }
-      command_struct_twist_.ang   = command.angular.z;
-      command_struct_twist_.lin_x   = command.linear.x;
-      command_struct_twist_.lin_y   = command.linear.y;
-      command_struct_twist_.stamp = ros::Time::now();
-      command_twist_.writeFromNonRT (command_struct_twist_);
+      std::lock_guard<std::mutex> lock(command_mutex_);
+      const ros::Time stamp = ros::Time::now();
+      if (!acceptCommandMode(Command::TWIST, stamp))
+      {
+        ROS_WARN_STREAM_THROTTLE_NAMED(1.0, name_, "Ignoring twist command, four wheel steering commands are active.");
+        return;
+      }
+      command_struct_.mode = Command::TWIST;
+      command_struct_.twist.ang   = command.angular.z;
+      command_struct_.twist.lin_x = command.linear.x;
+      command_struct_.twist.lin_y = command.linear.y;
+      command_struct_.stamp = stamp;
+      command_.writeFromNonRT (command_struct_);
       ROS_DEBUG_STREAM_NAMED(name_,
                              "Added values to command. "
-                             << "Ang: "   << command_struct_twist_.ang << ", "
-                             << "Lin x: " << command_struct_twist_.lin_x << ", "
-                             << "Lin y: " << command_struct_twist_.lin_y << ", "
-                             << "Stamp: " << command_struct_twist_.stamp);
+                             << "Ang: "   << command_struct_.twist.ang << ", "
+                             << "Lin x: " << command_struct_.twist.lin_x << ", "
+                             << "Lin y: " << command_struct_.twist.lin_y << ", "
+                             << "Stamp: " << command_struct_.stamp);
     }
     else
     {
@@ -549,17 +482,25 @@ namespace four_wheel_steering_controller{
         ROS_WARN("Received NaN in four_wheel_steering_msgs::FourWheelSteering. Ignoring command.");
         return;
       }
-      command_struct_four_wheel_steering_.front_steering   = command.front_steering_angle;
-      command_struct_four_wheel_steering_.rear_steering   = command.rear_steering_angle;
-      command_struct_four_wheel_steering_.lin   = command.speed;
-      command_struct_four_wheel_steering_.stamp = ros::Time::now();
-      command_four_wheel_steering_.writeFromNonRT (command_struct_four_wheel_steering_);
+      std::lock_guard<std::mutex> lock(command_mutex_);
+      const ros::Time stamp = ros::Time::now();
+      if (!acceptCommandMode(Command::FOUR_WHEEL_STEERING, stamp))
+      {
+        ROS_WARN_STREAM_THROTTLE_NAMED(1.0, name_, "Ignoring four wheel steering command, twist commands are active.");
+        return;
+      }
+      command_struct_.mode = Command::FOUR_WHEEL_STEERING;
+      command_struct_.four_wheel_steering.front_steering = command.front_steering_angle;
+      command_struct_.four_wheel_steering.rear_steering  = command.rear_steering_angle;
+      command_struct_.four_wheel_steering.lin            = command.speed;
+      command_struct_.stamp = stamp;
+      command_.writeFromNonRT (command_struct_);
       ROS_DEBUG_STREAM_NAMED(name_,
                              "Added values to command. "
-                             << "Steering front : "   << command_struct_four_wheel_steering_.front_steering << ", "
-                             << "Steering rear : "   << command_struct_four_wheel_steering_.rear_steering << ", "
-                             << "Lin: "   << command_struct_four_wheel_steering_.lin << ", "
-                             << "Stamp: " << command_struct_four_wheel_steering_.stamp);
+                             << "Steering front : "   << command_struct_.four_wheel_steering.front_steering << ", "
+                             << "Steering rear : "   << command_struct_.four_wheel_steering.rear_steering << ", "
+                             << "Lin: "   << command_struct_.four_wheel_steering.lin << ", "
+                             << "Stamp: " << command_struct_.stamp);
     }
     else
     {
@@ -567,6 +508,15 @@ namespace four_wheel_steering_controller{
     }
   }
 
+  bool FourWheelSteeringController::acceptCommandMode(Command::Mode mode, const ros::Time& stamp) const
+  {
+    // The first command, or one of the active mode, always goes through. A command of the other mode only takes over
+    // once the active mode has been silent for the hold time, so interleaved topics don't flip-flop the mode.
+    if (mode == command_struct_.mode || command_struct_.stamp.isZero())
+      return true;
+    return (stamp - command_struct_.stamp).toSec() >= command_mode_hold_;
+  }
+
   bool FourWheelSteeringController::getWheelNames(ros::NodeHandle& controller_nh,
                               const std::string& wheel_param,
                               std::vector<std::string>& wheel_names)
@@ -620,54 +570,4 @@ namespace four_wheel_steering_controller{
       return true;
   }
 
-  void FourWheelSteeringController::setOdomPubFields(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh)
-  {
-    // Get and check params for covariances
-    XmlRpc::XmlRpcValue pose_cov_list;
-    controller_nh.getParam("pose_covariance_diagonal", pose_cov_list);
-    ROS_ASSERT(pose_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-    ROS_ASSERT(pose_cov_list.size() == 6);
-    for (int i = 0; i < pose_cov_list.size(); ++i)
-      ROS_ASSERT(pose_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-
-    XmlRpc::XmlRpcValue twist_cov_list;
-    controller_nh.getParam("twist_covariance_diagonal", twist_cov_list);
-    ROS_ASSERT(twist_cov_list.getType() == XmlRpc::XmlRpcValue::TypeArray);
-    ROS_ASSERT(twist_cov_list.size() == 6);
-    for (int i = 0; i < twist_cov_list.size(); ++i)
-      ROS_ASSERT(twist_cov_list[i].getType() == XmlRpc::XmlRpcValue::TypeDouble);
-
-    // Setup odometry realtime publisher + odom message constant fields
-    odom_pub_.reset(new realtime_tools::RealtimePublisher<nav_msgs::Odometry>(controller_nh, "odom", 100));
-    odom_pub_->msg_.header.frame_id = "odom";
-    odom_pub_->msg_.child_frame_id = base_frame_id_;
-    odom_pub_->msg_.pose.pose.position.z = 0;
-    odom_pub_->msg_.pose.covariance = {
-        static_cast<double>(pose_cov_list[0]), 0., 0., 0., 0., 0.,
-        0., static_cast<double>(pose_cov_list[1]), 0., 0., 0., 0.,
-        0., 0., static_cast<double>(pose_cov_list[2]), 0., 0., 0.,
-        0., 0., 0., static_cast<double>(pose_cov_list[3]), 0., 0.,
-        0., 0., 0., 0., static_cast<double>(pose_cov_list[4]), 0.,
-        0., 0., 0., 0., 0., static_cast<double>(pose_cov_list[5]) };
-    odom_pub_->msg_.twist.twist.linear.y  = 0;
-    odom_pub_->msg_.twist.twist.linear.z  = 0;
-    odom_pub_->msg_.twist.twist.angular.x = 0;
-    odom_pub_->msg_.twist.twist.angular.y = 0;
-    odom_pub_->msg_.twist.covariance = {
-        static_cast<double>(twist_cov_list[0]), 0., 0., 0., 0., 0.,
-        0., static_cast<double>(twist_cov_list[1]), 0., 0., 0., 0.,
-        0., 0., static_cast<double>(twist_cov_list[2]), 0., 0., 0.,
-        0., 0., 0., static_cast<double>(twist_cov_list[3]), 0., 0.,
-        0., 0., 0., 0., static_cast<double>(twist_cov_list[4]), 0.,
-        0., 0., 0., 0., 0., static_cast<double>(twist_cov_list[5]) };
-    odom_4ws_pub_.reset(new realtime_tools::RealtimePublisher<four_wheel_steering_msgs::FourWheelSteeringStamped>(controller_nh, "odom_steer", 100));
-    odom_4ws_pub_->msg_.header.frame_id = "odom";
-
-    tf_odom_pub_.reset(new realtime_tools::RealtimePublisher<tf::tfMessage>(root_nh, "/tf", 100));
-    tf_odom_pub_->msg_.transforms.resize(1);
-    tf_odom_pub_->msg_.transforms[0].transform.translation.z = 0.0;
-    tf_odom_pub_->msg_.transforms[0].child_frame_id = base_frame_id_;
-    tf_odom_pub_->msg_.transforms[0].header.frame_id = "odom";
-  }
-
 } // namespace four_wheel_steering_controller
@@ -38,8 +38,6 @@
 
 namespace four_wheel_steering_controller
 {
-  namespace bacc = boost::accumulators;
-
   Odometry::Odometry(size_t velocity_rolling_window_size)
   : last_update_timestamp_(0.0)
   , x_(0.0)
@@ -53,18 +51,22 @@ namespace four_wheel_steering_controller
   , wheel_steering_y_offset_(0.0)
   , wheel_radius_(0.0)
   , wheel_base_(0.0)
+  , steering_x_()
+  , steering_y_()
+  , fused_inverse_moment_(0.0)
+  , steering_offset_side_()
+  , slip_residuals_()
   , wheel_old_pos_(0.0)
   , velocity_rolling_window_size_(velocity_rolling_window_size)
-  , linear_accel_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , linear_jerk_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , front_steer_vel_acc_(RollingWindow::window_size = velocity_rolling_window_size)
-  , rear_steer_vel_acc_(RollingWindow::window_size = velocity_rolling_window_size)
+  , linear_filter_(velocity_rolling_window_size)
+  , front_steering_filter_(velocity_rolling_window_size)
+  , rear_steering_filter_(velocity_rolling_window_size)
   {
   }
 
   void Odometry::init(const ros::Time& time)
   {
-    // Reset accumulators and timestamp:
+    // Reset filters and timestamp:
     resetAccumulators();
     last_update_timestamp_ = time;
   }
@@ -100,39 +102,122 @@ namespace four_wheel_steering_controller
                 + rear_linear_speed*sin(rear_steering) + wheel_base_*angular_/2.0)/2.0;
     linear_ =  copysign(1.0, rear_linear_speed)*sqrt(pow(linear_x_,2)+pow(linear_y_,2));
 
-    /// Compute x, y and heading using velocity
-    const double dt = (time - last_update_timestamp_).toSec();
-    if (dt < 0.0001)
-      return false; // Interval too small to integrate with
+    double dt;
+    if (!integrateVelocity(time, dt))
+      return false;
 
-    last_update_timestamp_ = time;
-    /// Integrate odometry:
-    integrateXY(linear_x_*dt, linear_y_*dt, angular_*dt);
+    updateSteeringVelocity(front_steering, rear_steering, dt);
+    return true;
+  }
+
+  bool Odometry::updateFused(const WheelValues& velocities, const WheelValues& steering,
+                             double front_steering, double rear_steering, const ros::Time &time)
+  {
+    // The wheel contact point is offset from its steering axis, so the axis velocity is the wheel velocity plus the
+    // offset times the base angular velocity, along the steering direction. Its moment about the base center is then
+    // affine in the angular velocity:
+    WheelValues speed, offset, cos_steering, sin_steering;
+    double moment_wheels = 0.0, moment_offsets = 0.0;
+    for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+    {
+      speed[i]  = wheel_radius_*velocities[i];
+      offset[i] = steering_offset_side_[i]*wheel_steering_y_offset_;
+      cos_steering[i] = cos(steering[i]);
+      sin_steering[i] = sin(steering[i]);
+      const double lever = steering_x_[i]*sin_steering[i] - steering_y_[i]*cos_steering[i];
+      moment_wheels  += speed[i]*lever;
+      moment_offsets += offset[i]*lever;
+    }
+
+    // Least-squares rigid body velocity, i.e. the pseudo-inverse applied to the axes velocities, solved for the
+    // angular velocity first. The offsets being shorter than the distances to the center, the denominator is positive:
+    angular_ = moment_wheels*fused_inverse_moment_/(1.0 - moment_offsets*fused_inverse_moment_);
+
+    WheelValues vel_x, vel_y;
+    double sum_vel_x = 0.0, sum_vel_y = 0.0;
+    for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+    {
+      const double axis_speed = speed[i] + offset[i]*angular_;
+      vel_x[i] = axis_speed*cos_steering[i];
+      vel_y[i] = axis_speed*sin_steering[i];
+      sum_vel_x += vel_x[i];
+      sum_vel_y += vel_y[i];
+    }
+    linear_x_ = sum_vel_x/WheelValues::WHEELS;
+    linear_y_ = sum_vel_y/WheelValues::WHEELS;
+    linear_   = copysign(1.0, linear_x_)*sqrt(pow(linear_x_,2)+pow(linear_y_,2));
+
+    for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+    {
+      slip_residuals_[i] = hypot(vel_x[i] - (linear_x_ - angular_*steering_y_[i]),
+                                 vel_y[i] - (linear_y_ + angular_*steering_x_[i]));
+    }
+
+    double dt;
+    if (!integrateVelocity(time, dt))
+      return false;
 
-    linear_accel_acc_((linear_vel_prev_ - linear_)/dt);
-    linear_vel_prev_ = linear_;
-    linear_jerk_acc_((linear_accel_prev_ - bacc::rolling_mean(linear_accel_acc_))/dt);
-    linear_accel_prev_ = bacc::rolling_mean(linear_accel_acc_);
-    front_steer_vel_acc_((front_steer_vel_prev_ - front_steering)/dt);
-    front_steer_vel_prev_ = front_steering;
-    rear_steer_vel_acc_((rear_steer_vel_prev_ - rear_steering)/dt);
-    rear_steer_vel_prev_ = rear_steering;
+    updateSteeringVelocity(front_steering, rear_steering, dt);
     return true;
   }
 
+  bool Odometry::updateVelocity(double linear_x, double linear_y, double angular, const ros::Time &time)
+  {
+    linear_x_ = linear_x;
+    linear_y_ = linear_y;
+    angular_  = angular;
+    linear_   = copysign(1.0, linear_x_)*sqrt(pow(linear_x_,2)+pow(linear_y_,2));
+
+    double dt;
+    return integrateVelocity(time, dt);
+  }
+
   void Odometry::setWheelParams(double steering_track, double wheel_steering_y_offset, double wheel_radius, double wheel_base)
   {
     steering_track_   = steering_track;
     wheel_steering_y_offset_ = wheel_steering_y_offset;
     wheel_radius_     = wheel_radius;
     wheel_base_       = wheel_base;
+
+    // Steering axes of the fused fit, ordered like WheelValues. The axes being symmetric about the base center, the
+    // normal matrix is diag(4, 4, sum of the squared distances to the center):
+    const double half_base  = wheel_base_/2.0;
+    const double half_track = steering_track_/2.0;
+    steering_x_ = {{ half_base,   half_base, -half_base, -half_base}};
+    steering_y_ = {{ half_track, -half_track, half_track, -half_track}};
+    steering_offset_side_ = {{1.0, -1.0, 1.0, -1.0}};
+    const double moment = WheelValues::WHEELS*(half_base*half_base + half_track*half_track);
+    fused_inverse_moment_ = moment > 0.0 ? 1.0/moment : 0.0;
   }
 
   void Odometry::setVelocityRollingWindowSize(size_t velocity_rolling_window_size)
   {
     velocity_rolling_window_size_ = velocity_rolling_window_size;
 
-    resetAccumulators();
+    linear_filter_.setWindowSize(velocity_rolling_window_size_);
+    front_steering_filter_.setWindowSize(velocity_rolling_window_size_);
+    rear_steering_filter_.setWindowSize(velocity_rolling_window_size_);
+  }
+
+  bool Odometry::integrateVelocity(const ros::Time &time, double &dt)
+  {
+    /// Compute x, y and heading using velocity
+    dt = (time - last_update_timestamp_).toSec();
+    if (dt < 0.0001)
+      return false; // Interval too small to integrate with
+
+    last_update_timestamp_ = time;
+    /// Integrate odometry:
+    integrateXY(linear_x_*dt, linear_y_*dt, angular_*dt);
+
+    linear_filter_.update(linear_, dt);
+    return true;
+  }
+
+  void Odometry::updateSteeringVelocity(double front_steering, double rear_steering, double dt)
+  {
+    front_steering_filter_.update(front_steering, dt);
+    rear_steering_filter_.update(rear_steering, dt);
   }
 
   void Odometry::integrateXY(double linear_x, double linear_y, double angular)
@@ -172,10 +257,9 @@ namespace four_wheel_steering_controller
 
   void Odometry::resetAccumulators()
   {
-    linear_accel_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
-    linear_jerk_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
-    front_steer_vel_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
-    rear_steer_vel_acc_ = RollingMeanAcc(RollingWindow::window_size = velocity_rolling_window_size_);
+    linear_filter_.reset();
+    front_steering_filter_.reset();
+    rear_steering_filter_.reset();
   }
 
 } // namespace four_wheel_steering_controller
@@ -0,0 +1,128 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the ros_controllers contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <four_wheel_steering_controller/swerve_kinematics.h>
+
+#include <cmath>
+
+namespace four_wheel_steering_controller
+{
+  SwerveKinematics::SwerveKinematics()
+  : wheel_radius_(0.0)
+  , normal_inverse_{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}
+  {
+  }
+
+  bool SwerveKinematics::setModules(const std::vector<double>& x, const std::vector<double>& y, double wheel_radius)
+  {
+    if (x.size() != y.size() || x.size() < 2 || wheel_radius <= 0.0)
+      return false;
+
+    // Each module measures the velocity of its steering axis, (lin_x - ang*y, lin_y + ang*x). Summing the module
+    // equations gives the normal matrix [[n, 0, -sum_y], [0, n, sum_x], [-sum_y, sum_x, sum_r2]]:
+    const double n = static_cast<double>(x.size());
+    double sum_x = 0.0, sum_y = 0.0, sum_r2 = 0.0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+      sum_x  += x[i];
+      sum_y  += y[i];
+      sum_r2 += x[i]*x[i] + y[i]*y[i];
+    }
+
+    // The determinant is n times the spread of the modules around their centroid, zero when they all coincide:
+    const double det = n*(n*sum_r2 - sum_x*sum_x - sum_y*sum_y);
+    if (!(det > 1e-9*n*n*sum_r2))
+      return false;
+
+    // The normal matrix is symmetric, so is its inverse, the cofactor matrix over the determinant:
+    normal_inverse_[0][0] = (n*sum_r2 - sum_x*sum_x)/det;
+    normal_inverse_[0][1] = -sum_x*sum_y/det;
+    normal_inverse_[0][2] = n*sum_y/det;
+    normal_inverse_[1][1] = (n*sum_r2 - sum_y*sum_y)/det;
+    normal_inverse_[1][2] = -n*sum_x/det;
+    normal_inverse_[2][2] = n*n/det;
+    normal_inverse_[1][0] = normal_inverse_[0][1];
+    normal_inverse_[2][0] = normal_inverse_[0][2];
+    normal_inverse_[2][1] = normal_inverse_[1][2];
+
+    x_ = x;
+    y_ = y;
+    wheel_radius_ = wheel_radius;
+    return true;
+  }
+
+  void SwerveKinematics::twistToModules(double lin_x, double lin_y, double ang,
+                                        double* velocities, double* steering) const
+  {
+    const size_t n = x_.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double vel_x = lin_x - ang*y_[i];
+      const double vel_y = lin_y + ang*x_[i];
+      const double speed = std::hypot(vel_x, vel_y);
+      if (speed < 1e-9)
+      {
+        velocities[i] = 0.0;
+        continue;
+      }
+
+      // Reversing the wheel is equivalent to steering by pi, so fold the angle into [-pi/2, pi/2]:
+      const double sign = std::signbit(vel_x) ? -1.0 : 1.0;
+      steering[i]   = std::atan(vel_y/vel_x);
+      velocities[i] = sign*speed/wheel_radius_;
+    }
+  }
+
+  void SwerveKinematics::modulesToTwist(const double* velocities, const double* steering,
+                                        double& lin_x, double& lin_y, double& ang) const
+  {
+    // Right hand side of the normal equations:
+    double sum_vel_x = 0.0, sum_vel_y = 0.0, sum_moment = 0.0;
+    const size_t n = x_.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double speed = velocities[i]*wheel_radius_;
+      const double vel_x = speed*std::cos(steering[i]);
+      const double vel_y = speed*std::sin(steering[i]);
+      sum_vel_x  += vel_x;
+      sum_vel_y  += vel_y;
+      sum_moment += x_[i]*vel_y - y_[i]*vel_x;
+    }
+
+    lin_x = normal_inverse_[0][0]*sum_vel_x + normal_inverse_[0][1]*sum_vel_y + normal_inverse_[0][2]*sum_moment;
+    lin_y = normal_inverse_[1][0]*sum_vel_x + normal_inverse_[1][1]*sum_vel_y + normal_inverse_[1][2]*sum_moment;
+    ang   = normal_inverse_[2][0]*sum_vel_x + normal_inverse_[2][1]*sum_vel_y + normal_inverse_[2][2]*sum_moment;
+  }
+
+} // namespace four_wheel_steering_controller
@@ -0,0 +1,374 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Irstea
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Irstea nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <cmath>
+#include <four_wheel_steering_controller/swerve_steering_controller.h>
+
+namespace four_wheel_steering_controller{
+
+  SwerveSteeringController::SwerveSteeringController()
+    : open_loop_(false)
+    , command_struct_()
+    , wheel_radius_(0.0)
+    , cmd_vel_timeout_(0.5)
+    , base_frame_id_("base_link")
+    , enable_odom_tf_(true)
+  {
+  }
+
+  bool SwerveSteeringController::init(hardware_interface::RobotHW *robot_hw,
+                                      ros::NodeHandle& root_nh,
+                                      ros::NodeHandle &controller_nh)
+  {
+    const std::string complete_ns = controller_nh.getNamespace();
+    std::size_t id = complete_ns.find_last_of("/");
+    name_ = complete_ns.substr(id + 1);
+
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope =
+      controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh, name_);
+    if (!thread_placement_scope) {return false;}
+
+    controller_nh.param("base_frame_id", base_frame_id_, base_frame_id_);
+    ROS_INFO_STREAM_NAMED(name_, "Base frame_id set to " << base_frame_id_);
+
+    // Get the modules from the parameter server, and their positions from the URDF if needed
+    urdf_geometry_parser::UrdfGeometryParser uvk(root_nh, base_frame_id_);
+    std::vector<std::string> wheel_names, steering_names;
+    std::vector<double> x, y;
+    if (!getModules(controller_nh, uvk, wheel_names, steering_names, x, y))
+    {
+      return false;
+    }
+
+    if (!controller_nh.getParam("wheel_radius", wheel_radius_))
+    {
+      if (!uvk.getJointRadius(wheel_names[0], wheel_radius_))
+        return false;
+      else
+        controller_nh.setParam("wheel_radius", wheel_radius_);
+    }
+
+    if (!kinematics_.setModules(x, y, wheel_radius_))
+    {
+      ROS_ERROR_STREAM_NAMED(name_,
+          "At least two modules at different positions and a positive wheel radius are needed; now : "
+          << x.size() << " modules, wheel radius " << wheel_radius_ << ".");
+      return false;
+    }
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+      ROS_INFO_STREAM_NAMED(name_,
+                            "Module " << i << " : wheel " << wheel_names[i]
+                            << ", steering " << steering_names[i]
+                            << ", position (" << x[i] << ", " << y[i] << ")");
+    }
+
+    // Odometry related:
+    double publish_rate;
+    controller_nh.param("publish_rate", publish_rate, 50.0);
+    ROS_INFO_STREAM_NAMED(name_, "Controller state will be published at "
+                          << publish_rate << "Hz.");
+    publish_period_ = ros::Duration(1.0 / publish_rate);
+
+    controller_nh.param("open_loop", open_loop_, open_loop_);
+
+    int velocity_rolling_window_size = 10;
+    controller_nh.param("velocity_rolling_window_size", velocity_rolling_window_size, velocity_rolling_window_size);
+    ROS_INFO_STREAM_NAMED(name_, "Velocity rolling window size of "
+                          << velocity_rolling_window_size << ".");
+
+    odometry_.setVelocityRollingWindowSize(velocity_rolling_window_size);
+
+    // Twist command related:
+    controller_nh.param("cmd_vel_timeout", cmd_vel_timeout_, cmd_vel_timeout_);
+    ROS_INFO_STREAM_NAMED(name_, "Velocity commands will be considered old if they are older than "
+                          << cmd_vel_timeout_ << "s.");
+
+    controller_nh.param("enable_odom_tf", enable_odom_tf_, enable_odom_tf_);
+    ROS_INFO_STREAM_NAMED(name_, "Publishing to tf is " << (enable_odom_tf_?"enabled":"disabled"));
+
+    // Velocity, acceleration and jerk limits:
+    limiter_.setAxisLimits(diff_drive_controller::TwistLimiter::LINEAR_X, getAxisLimits(controller_nh, "linear/x"));
+    limiter_.setAxisLimits(diff_drive_controller::TwistLimiter::LINEAR_Y, getAxisLimits(controller_nh, "linear/y"));
+    limiter_.setAxisLimits(diff_drive_controller::TwistLimiter::ANGULAR_Z, getAxisLimits(controller_nh, "angular/z"));
+
+    odom_publisher_.init(name_, root_nh, controller_nh, "odom", base_frame_id_, publish_period_, enable_odom_tf_);
+
+    hardware_interface::VelocityJointInterface *const vel_joint_hw = robot_hw->get<hardware_interface::VelocityJointInterface>();
+    hardware_interface::PositionJointInterface *const pos_joint_hw = robot_hw->get<hardware_interface::PositionJointInterface>();
+
+    // Get the joint objects to use in the realtime loop, and preallocate the module values
+    wheel_joints_.resize(wheel_names.size());
+    steering_joints_.resize(steering_names.size());
+    for (size_t i = 0; i < wheel_joints_.size(); ++i)
+    {
+      wheel_joints_[i] = vel_joint_hw->getHandle(wheel_names[i]);  // throws on failure
+      steering_joints_[i] = pos_joint_hw->getHandle(steering_names[i]);  // throws on failure
+    }
+    wheel_velocities_.assign(wheel_joints_.size(), 0.0);
+    steering_positions_.assign(wheel_joints_.size(), 0.0);
+    wheel_commands_.assign(wheel_joints_.size(), 0.0);
+    steering_commands_.assign(wheel_joints_.size(), 0.0);
+
+    sub_command_ = controller_nh.subscribe("cmd_vel", 1, &SwerveSteeringController::cmdVelCallback, this);
+
+    rt_audit_.init(controller_nh, name_);
+    command_monitor_.add("cmd_vel", command_.stats());
+    command_monitor_.init(controller_nh, name_);
+
+    return true;
+  }
+
+  void SwerveSteeringController::update(const ros::Time& time, const ros::Duration& period)
+  {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+    updateOdometry(time);
+    updateCommand(time, period);
+  }
+
+  void SwerveSteeringController::starting(const ros::Time& time)
+  {
+    // Start from the current steering angles, so that modules at rest do not move
+    for (size_t i = 0; i < steering_joints_.size(); ++i)
+      steering_commands_[i] = steering_joints_[i].getPosition();
+    brake();
+
+    // Register starting time used to keep fixed rate
+    odom_publisher_.starting(time);
+
+    odometry_.init(time);
+  }
+
+  void SwerveSteeringController::stopping(const ros::Time& /*time*/)
+  {
+    brake();
+    odom_publisher_.stopping();
+  }
+
+  void SwerveSteeringController::updateOdometry(const ros::Time& time)
+  {
+    // COMPUTE AND PUBLISH ODOMETRY
+    double lin_x, lin_y, ang;
+    if (open_loop_)
+    {
+      lin_x = last0_cmd_.lin_x;
+      lin_y = last0_cmd_.lin_y;
+      ang   = last0_cmd_.ang;
+    }
+    else
+    {
+      for (size_t i = 0; i < wheel_joints_.size(); ++i)
+      {
+        wheel_velocities_[i] = wheel_joints_[i].getVelocity();
+        steering_positions_[i] = steering_joints_[i].getPosition();
+        if (std::isnan(wheel_velocities_[i]) || std::isnan(steering_positions_[i]))
+          return;
+      }
+
+      // Fit the base twist to all the modules at once:
+      kinematics_.modulesToTwist(wheel_velocities_.data(), steering_positions_.data(), lin_x, lin_y, ang);
+    }
+    odometry_.updateVelocity(lin_x, lin_y, ang, time);
+
+    // Publish odometry message
+    diff_drive_controller::OdometrySample sample;
+    sample.stamp    = time;
+    sample.x        = odometry_.getX();
+    sample.y        = odometry_.getY();
+    sample.heading  = odometry_.getHeading();
+    sample.linear   = odometry_.getLinearX();
+    sample.linear_y = odometry_.getLinearY();
+    sample.angular  = odometry_.getAngular();
+    odom_publisher_.update(sample);
+  }
+
+  void SwerveSteeringController::updateCommand(const ros::Time& time, const ros::Duration& period)
+  {
+    // Retreive current velocity command and time step:
+    Command curr_cmd = *(command_.readFromRT());
+    const double dt = (time - curr_cmd.stamp).toSec();
+
+    // Brake if cmd_vel has timeout:
+    if (dt > cmd_vel_timeout_)
+    {
+      curr_cmd.lin_x = 0.0;
+      curr_cmd.lin_y = 0.0;
+      curr_cmd.ang = 0.0;
+    }
+
+    // Limit velocities, accelerations and jerks:
+    const double cmd_dt(period.toSec());
+
+    diff_drive_controller::TwistLimiter::Twist cmd_twist = {{curr_cmd.lin_x, curr_cmd.lin_y, curr_cmd.ang}};
+    limiter_.limit(cmd_twist,
+                   {{last0_cmd_.lin_x, last0_cmd_.lin_y, last0_cmd_.ang}},
+                   {{last1_cmd_.lin_x, last1_cmd_.lin_y, last1_cmd_.ang}},
+                   cmd_dt);
+    curr_cmd.lin_x = cmd_twist[diff_drive_controller::TwistLimiter::LINEAR_X];
+    curr_cmd.lin_y = cmd_twist[diff_drive_controller::TwistLimiter::LINEAR_Y];
+    curr_cmd.ang   = cmd_twist[diff_drive_controller::TwistLimiter::ANGULAR_Z];
+
+    last1_cmd_ = last0_cmd_;
+    last0_cmd_ = curr_cmd;
+
+    // Compute the commands of all the modules at once, then set them:
+    kinematics_.twistToModules(curr_cmd.lin_x, curr_cmd.lin_y, curr_cmd.ang,
+                               wheel_commands_.data(), steering_commands_.data());
+
+    for (size_t i = 0; i < wheel_joints_.size(); ++i)
+    {
+      wheel_joints_[i].setCommand(wheel_commands_[i]);
+      steering_joints_[i].setCommand(steering_commands_[i]);
+    }
+  }
+
+  void SwerveSteeringController::brake()
+  {
+    const double vel = 0.0;
+    for (size_t i = 0; i < wheel_joints_.size(); ++i)
+    {
+      wheel_commands_[i] = vel;
+      wheel_joints_[i].setCommand(vel);
+      steering_joints_[i].setCommand(steering_commands_[i]);
+    }
+  }
+
+  void SwerveSteeringController::cmdVelCallback(const geometry_msgs::Twist& command)
+  {
+    if (isRunning())
+    {
+      if(std::isnan(command.angular.z) || std::isnan(command.linear.x) || std::isnan(command.linear.y))
+      {
+        ROS_WARN("Received NaN in geometry_msgs::Twist. Ignoring command.");
+        return;
+      }
+      command_struct_.ang   = command.angular.z;
+      command_struct_.lin_x = command.linear.x;
+      command_struct_.lin_y = command.linear.y;
+      command_struct_.stamp = ros::Time::now();
+      command_.writeFromNonRT (command_struct_);
+      ROS_DEBUG_STREAM_NAMED(name_,
+                             "Added values to command. "
+                             << "Ang: "   << command_struct_.ang << ", "
+                             << "Lin x: " << command_struct_.lin_x << ", "
+                             << "Lin y: " << command_struct_.lin_y << ", "
+                             << "Stamp: " << command_struct_.stamp);
+    }
+    else
+    {
+      ROS_ERROR_NAMED(name_, "Can't accept new commands. Controller is not running.");
+    }
+  }
+
+  bool SwerveSteeringController::getModules(ros::NodeHandle& controller_nh,
+                                            urdf_geometry_parser::UrdfGeometryParser& uvk,
+                                            std::vector<std::string>& wheel_names,
+                                            std::vector<std::string>& steering_names,
+                                            std::vector<double>& x,
+                                            std::vector<double>& y)
+  {
+    XmlRpc::XmlRpcValue module_list;
+    if (!controller_nh.getParam("modules", module_list))
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Couldn't retrieve modules param 'modules'.");
+      return false;
+    }
+
+    if (module_list.getType() != XmlRpc::XmlRpcValue::TypeArray || module_list.size() == 0)
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Modules param 'modules' isn't a non empty list.");
+      return false;
+    }
+
+    for (int i = 0; i < module_list.size(); ++i)
+    {
+      XmlRpc::XmlRpcValue& module = module_list[i];
+      if (module.getType() != XmlRpc::XmlRpcValue::TypeStruct ||
+          !module.hasMember("wheel") || module["wheel"].getType() != XmlRpc::XmlRpcValue::TypeString ||
+          !module.hasMember("steering") || module["steering"].getType() != XmlRpc::XmlRpcValue::TypeString)
+      {
+        ROS_ERROR_STREAM_NAMED(name_,
+            "Module #" << i << " doesn't have the 'wheel' and 'steering' joint names.");
+        return false;
+      }
+      wheel_names.push_back(static_cast<std::string>(module["wheel"]));
+      steering_names.push_back(static_cast<std::string>(module["steering"]));
+
+      if (module.hasMember("x") && module.hasMember("y"))
+      {
+        // Accept integers as well as doubles:
+        XmlRpc::XmlRpcValue& module_x = module["x"];
+        XmlRpc::XmlRpcValue& module_y = module["y"];
+        if ((module_x.getType() != XmlRpc::XmlRpcValue::TypeDouble && module_x.getType() != XmlRpc::XmlRpcValue::TypeInt) ||
+            (module_y.getType() != XmlRpc::XmlRpcValue::TypeDouble && module_y.getType() != XmlRpc::XmlRpcValue::TypeInt))
+        {
+          ROS_ERROR_STREAM_NAMED(name_, "Module #" << i << " position isn't numeric.");
+          return false;
+        }
+        x.push_back(module_x.getType() == XmlRpc::XmlRpcValue::TypeInt ?
+                    static_cast<int>(module_x) : static_cast<double>(module_x));
+        y.push_back(module_y.getType() == XmlRpc::XmlRpcValue::TypeInt ?
+                    static_cast<int>(module_y) : static_cast<double>(module_y));
+      }
+      else
+      {
+        urdf::Vector3 position;
+        if (!uvk.getTransformVector(steering_names.back(), base_frame_id_, position))
+          return false;
+        x.push_back(position.x);
+        y.push_back(position.y);
+      }
+    }
+    return true;
+  }
+
+  diff_drive_controller::SpeedLimiter SwerveSteeringController::getAxisLimits(ros::NodeHandle& controller_nh,
+                                                                               const std::string& axis_ns)
+  {
+    diff_drive_controller::SpeedLimiter limiter;
+    controller_nh.param(axis_ns + "/has_velocity_limits"    , limiter.has_velocity_limits    , limiter.has_velocity_limits    );
+    controller_nh.param(axis_ns + "/has_acceleration_limits", limiter.has_acceleration_limits, limiter.has_acceleration_limits);
+    controller_nh.param(axis_ns + "/has_jerk_limits"        , limiter.has_jerk_limits        , limiter.has_jerk_limits        );
+    controller_nh.param(axis_ns + "/max_velocity"           , limiter.max_velocity           ,  limiter.max_velocity          );
+    controller_nh.param(axis_ns + "/min_velocity"           , limiter.min_velocity           , -limiter.max_velocity          );
+    controller_nh.param(axis_ns + "/max_acceleration"       , limiter.max_acceleration       ,  limiter.max_acceleration      );
+    controller_nh.param(axis_ns + "/min_acceleration"       , limiter.min_acceleration       , -limiter.max_acceleration      );
+    controller_nh.param(axis_ns + "/max_jerk"               , limiter.max_jerk               ,  limiter.max_jerk              );
+    controller_nh.param(axis_ns + "/min_jerk"               , limiter.min_jerk               , -limiter.max_jerk              );
+    return limiter;
+  }
+
+} // namespace four_wheel_steering_controller
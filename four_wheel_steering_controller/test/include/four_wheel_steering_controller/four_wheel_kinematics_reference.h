@@ -0,0 +1,122 @@
+#ifndef FOUR_WHEEL_STEERING_CONTROLLER_FOUR_WHEEL_KINEMATICS_REFERENCE_H
+#define FOUR_WHEEL_STEERING_CONTROLLER_FOUR_WHEEL_KINEMATICS_REFERENCE_H
+
+#include <cmath>
+
+#include <four_wheel_steering_controller/four_wheel_kinematics.h>
+
+// Per-wheel scalar kinematics, as computed by FourWheelSteeringController before FourWheelKinematics
+struct ReferenceKinematics
+{
+  typedef four_wheel_steering_controller::WheelValues WheelValues;
+
+  double track, wheel_steering_y_offset, wheel_radius, wheel_base;
+
+  void twistToWheels(double lin_x, double ang, WheelValues& vel, WheelValues& steering) const
+  {
+    const double steering_track = track-2*wheel_steering_y_offset;
+    vel = WheelValues();
+    steering = WheelValues();
+    double& vel_left_front = vel[WheelValues::FRONT_LEFT];
+    double& vel_right_front = vel[WheelValues::FRONT_RIGHT];
+    double& vel_left_rear = vel[WheelValues::REAR_LEFT];
+    double& vel_right_rear = vel[WheelValues::REAR_RIGHT];
+    double& front_left_steering = steering[WheelValues::FRONT_LEFT];
+    double& front_right_steering = steering[WheelValues::FRONT_RIGHT];
+    if(fabs(lin_x) > 0.001)
+    {
+      const double vel_steering_offset = (ang*wheel_steering_y_offset)/wheel_radius;
+      const double sign = copysign(1.0, lin_x);
+      vel_left_front  = sign * std::hypot((lin_x - ang*steering_track/2), (wheel_base*ang/2.0)) / wheel_radius
+                        - vel_steering_offset;
+      vel_right_front = sign * std::hypot((lin_x + ang*steering_track/2), (wheel_base*ang/2.0)) / wheel_radius
+                        + vel_steering_offset;
+      vel_left_rear = sign * std::hypot((lin_x - ang*steering_track/2), (wheel_base*ang/2.0)) / wheel_radius
+                      - vel_steering_offset;
+      vel_right_rear = sign * std::hypot((lin_x + ang*steering_track/2), (wheel_base*ang/2.0)) / wheel_radius
+                       + vel_steering_offset;
+    }
+    if(fabs(2.0*lin_x) > fabs(ang*steering_track))
+    {
+      front_left_steering = atan(ang*wheel_base / (2.0*lin_x - ang*steering_track));
+      front_right_steering = atan(ang*wheel_base / (2.0*lin_x + ang*steering_track));
+    }
+    else if(fabs(lin_x) > 0.001)
+    {
+      front_left_steering = copysign(M_PI_2, ang);
+      front_right_steering = copysign(M_PI_2, ang);
+    }
+    steering[WheelValues::REAR_LEFT] = -front_left_steering;
+    steering[WheelValues::REAR_RIGHT] = -front_right_steering;
+  }
+
+  void fourWheelSteeringToWheels(double lin, double front_steering, double rear_steering,
+                                 WheelValues& vel, WheelValues& steering) const
+  {
+    const double steering_track = track-2*wheel_steering_y_offset;
+    vel = WheelValues();
+    steering = WheelValues();
+    double& front_left_steering = steering[WheelValues::FRONT_LEFT];
+    double& front_right_steering = steering[WheelValues::FRONT_RIGHT];
+    double& rear_left_steering = steering[WheelValues::REAR_LEFT];
+    double& rear_right_steering = steering[WheelValues::REAR_RIGHT];
+    const double tan_front_steering = tan(front_steering);
+    const double tan_rear_steering  = tan(rear_steering);
+    const double steering_diff =  steering_track*(tan_front_steering - tan_rear_steering)/2.0;
+    if(fabs(wheel_base - fabs(steering_diff)) > 0.001)
+    {
+      front_left_steering = atan(wheel_base*tan_front_steering/(wheel_base-steering_diff));
+      front_right_steering = atan(wheel_base*tan_front_steering/(wheel_base+steering_diff));
+      rear_left_steering = atan(wheel_base*tan_rear_steering/(wheel_base-steering_diff));
+      rear_right_steering = atan(wheel_base*tan_rear_steering/(wheel_base+steering_diff));
+    }
+    if(fabs(lin) > 0.001)
+    {
+      double l_front = 0;
+      if(fabs(tan(front_left_steering) - tan(front_right_steering)) > 0.01)
+      {
+        l_front = tan(front_right_steering) * tan(front_left_steering) * steering_track
+            / (tan(front_left_steering) - tan(front_right_steering));
+      }
+      double l_rear = 0;
+      if(fabs(tan(rear_left_steering) - tan(rear_right_steering)) > 0.01)
+      {
+        l_rear = tan(rear_right_steering) * tan(rear_left_steering) * steering_track
+            / (tan(rear_left_steering) - tan(rear_right_steering));
+      }
+      const double angular_speed_cmd = lin * (tan_front_steering-tan_rear_steering)/wheel_base;
+      const double vel_steering_offset = (angular_speed_cmd*wheel_steering_y_offset)/wheel_radius;
+      const double sign = copysign(1.0, lin);
+      vel[WheelValues::FRONT_LEFT] = sign * std::hypot((lin - angular_speed_cmd*steering_track/2),
+                                                       (l_front*angular_speed_cmd))/wheel_radius - vel_steering_offset;
+      vel[WheelValues::FRONT_RIGHT] = sign * std::hypot((lin + angular_speed_cmd*steering_track/2),
+                                                        (l_front*angular_speed_cmd))/wheel_radius + vel_steering_offset;
+      vel[WheelValues::REAR_LEFT] = sign * std::hypot((lin - angular_speed_cmd*steering_track/2),
+                                                      (l_rear*angular_speed_cmd))/wheel_radius - vel_steering_offset;
+      vel[WheelValues::REAR_RIGHT] = sign * std::hypot((lin + angular_speed_cmd*steering_track/2),
+                                                       (l_rear*angular_speed_cmd))/wheel_radius + vel_steering_offset;
+    }
+  }
+
+  static void wheelsToSteering(const WheelValues& steering, double& front_steering_pos, double& rear_steering_pos)
+  {
+    const double fl_steering = steering[WheelValues::FRONT_LEFT];
+    const double fr_steering = steering[WheelValues::FRONT_RIGHT];
+    const double rl_steering = steering[WheelValues::REAR_LEFT];
+    const double rr_steering = steering[WheelValues::REAR_RIGHT];
+    front_steering_pos = 0.0;
+    if(fabs(fl_steering) > 0.001 || fabs(fr_steering) > 0.001)
+    {
+      front_steering_pos = atan(2*tan(fl_steering)*tan(fr_steering)/
+                                      (tan(fl_steering) + tan(fr_steering)));
+    }
+    rear_steering_pos = 0.0;
+    if(fabs(rl_steering) > 0.001 || fabs(rr_steering) > 0.001)
+    {
+      rear_steering_pos = atan(2*tan(rl_steering)*tan(rr_steering)/
+                                     (tan(rl_steering) + tan(rr_steering)));
+    }
+  }
+};
+
+#endif /* FOUR_WHEEL_STEERING_CONTROLLER_FOUR_WHEEL_KINEMATICS_REFERENCE_H */
@@ -0,0 +1,95 @@
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <four_wheel_steering_controller/four_wheel_kinematics_reference.h>
+
+using four_wheel_steering_controller::FourWheelKinematics;
+using four_wheel_steering_controller::WheelValues;
+
+namespace
+{
+
+const double TOLERANCE = 1e-9;
+
+class FourWheelKinematicsTest : public ::testing::Test
+{
+public:
+  FourWheelKinematicsTest()
+    : reference{1.2, 0.1, 0.28, 1.3}
+  {
+    kinematics.setGeometry(reference.track, reference.wheel_steering_y_offset,
+                           reference.wheel_radius, reference.wheel_base);
+  }
+
+  void expectNear(const WheelValues& expected, const WheelValues& actual)
+  {
+    for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+    {
+      EXPECT_NEAR(expected[i], actual[i], TOLERANCE) << "wheel " << i;
+    }
+  }
+
+  ReferenceKinematics reference;
+  FourWheelKinematics kinematics;
+  std::mt19937 gen;
+};
+
+} // namespace
+
+TEST_F(FourWheelKinematicsTest, twistMatchesReference)
+{
+  std::uniform_real_distribution<double> dist(-2.0, 2.0);
+  const double special[] = {0.0, 0.0005, -0.0005, 1.0};
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double lin = i < 16 ? special[i % 4] : dist(gen);
+    const double ang = i < 16 ? special[i / 4] : dist(gen);
+    WheelValues expected_vel, expected_steering, vel, steering;
+    reference.twistToWheels(lin, ang, expected_vel, expected_steering);
+    kinematics.twistToWheels(lin, ang, vel, steering);
+    expectNear(expected_vel, vel);
+    expectNear(expected_steering, steering);
+  }
+}
+
+TEST_F(FourWheelKinematicsTest, fourWheelSteeringMatchesReference)
+{
+  std::uniform_real_distribution<double> lin_dist(-2.0, 2.0);
+  std::uniform_real_distribution<double> steering_dist(-1.2, 1.2);
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double lin = i % 10 == 0 ? 0.0 : lin_dist(gen);
+    const double front = i % 7 == 0 ? 0.0 : steering_dist(gen);
+    const double rear = i % 5 == 0 ? 0.0 : (i % 11 == 0 ? front : steering_dist(gen));
+    WheelValues expected_vel, expected_steering, vel, steering;
+    reference.fourWheelSteeringToWheels(lin, front, rear, expected_vel, expected_steering);
+    kinematics.fourWheelSteeringToWheels(lin, front, rear, vel, steering);
+    expectNear(expected_vel, vel);
+    expectNear(expected_steering, steering);
+  }
+}
+
+TEST_F(FourWheelKinematicsTest, wheelsToSteeringMatchesReference)
+{
+  std::uniform_real_distribution<double> lin_dist(-2.0, 2.0);
+  std::uniform_real_distribution<double> steering_dist(-1.2, 1.2);
+  for (int i = 0; i < 10000; ++i)
+  {
+    WheelValues vel, steering;
+    kinematics.fourWheelSteeringToWheels(lin_dist(gen), i % 3 == 0 ? 0.0 : steering_dist(gen),
+                                         i % 4 == 0 ? 0.0 : steering_dist(gen), vel, steering);
+    double expected_front, expected_rear, front, rear;
+    ReferenceKinematics::wheelsToSteering(steering, expected_front, expected_rear);
+    FourWheelKinematics::wheelsToSteering(steering, front, rear);
+    EXPECT_NEAR(expected_front, front, TOLERANCE);
+    EXPECT_NEAR(expected_rear, rear, TOLERANCE);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
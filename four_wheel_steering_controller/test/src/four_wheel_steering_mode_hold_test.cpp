@@ -0,0 +1,104 @@
+#include "test_common.h"
+
+// Both topics are published at 10Hz, the command mode hold is 1s
+const double PUBLISH_PERIOD = 0.1;
+const double COMMAND_MODE_HOLD = 1.0;
+
+// Publish a twist and a four wheel steering command per period for duration, or only the 4ws command without twist
+void publishInterleaved(FourWheelSteeringControllerTest& test, const geometry_msgs::Twist* twist,
+                        const four_wheel_steering_msgs::FourWheelSteering& cmd_4ws, double duration)
+{
+  for (double t = 0.0; t < duration && ros::ok(); t += PUBLISH_PERIOD)
+  {
+    if (twist)
+      test.publish(*twist);
+    test.publish_4ws(cmd_4ws);
+    ros::Duration(PUBLISH_PERIOD).sleep();
+  }
+}
+
+TEST_F(FourWheelSteeringControllerTest, testInterleavedCommandsHoldMode)
+{
+  // wait for ROS
+  waitForController();
+
+  // zero everything before test
+  geometry_msgs::Twist twist;
+  twist.linear.x = 0.0;
+  twist.linear.y = 0.0;
+  twist.angular.z = 0.0;
+  publish(twist);
+  ros::Duration(0.1).sleep();
+
+  four_wheel_steering_msgs::FourWheelSteering cmd_4ws;
+  cmd_4ws.speed = 0.2;
+  cmd_4ws.front_steering_angle = 0.0;
+  cmd_4ws.rear_steering_angle = 0.0;
+
+  // Twist came first: interleaved 4ws commands are ignored as long as twists keep coming
+  twist.linear.x = 0.5;
+  publishInterleaved(*this, &twist, cmd_4ws, 3.0 * COMMAND_MODE_HOLD);
+  nav_msgs::Odometry odom = getLastOdom();
+  EXPECT_NEAR(odom.twist.twist.linear.x, twist.linear.x, EPS);
+
+  // Once twists stop, 4ws commands take over after the hold
+  publishInterleaved(*this, nullptr, cmd_4ws, 3.0 * COMMAND_MODE_HOLD);
+  odom = getLastOdom();
+  EXPECT_NEAR(odom.twist.twist.linear.x, cmd_4ws.speed, EPS);
+
+  // The other way around: 4ws is now the active mode, interleaved twists are ignored
+  publishInterleaved(*this, &twist, cmd_4ws, 3.0 * COMMAND_MODE_HOLD);
+  odom = getLastOdom();
+  EXPECT_NEAR(odom.twist.twist.linear.x, cmd_4ws.speed, EPS);
+
+  // stop the robot
+  cmd_4ws.speed = 0.0;
+  publish_4ws(cmd_4ws);
+}
+
+TEST_F(FourWheelSteeringControllerTest, testOtherModeWithinHoldIsIgnored)
+{
+  // wait for ROS
+  waitForController();
+
+  // make 4ws the active mode
+  four_wheel_steering_msgs::FourWheelSteering cmd_4ws;
+  cmd_4ws.speed = 0.3;
+  cmd_4ws.front_steering_angle = 0.0;
+  cmd_4ws.rear_steering_angle = 0.0;
+  publishInterleaved(*this, nullptr, cmd_4ws, 2.0 * COMMAND_MODE_HOLD);
+
+  // A single twist right after the last 4ws command is within the hold, and doesn't change the motion
+  geometry_msgs::Twist twist;
+  twist.linear.x = 0.6;
+  twist.linear.y = 0.0;
+  twist.angular.z = 0.0;
+  publish(twist);
+  ros::Duration(0.5 * COMMAND_MODE_HOLD).sleep();
+  nav_msgs::Odometry odom = getLastOdom();
+  EXPECT_NEAR(odom.twist.twist.linear.x, cmd_4ws.speed, EPS);
+
+  // A twist after the 4ws commands have been silent for the hold takes over
+  ros::Duration(COMMAND_MODE_HOLD).sleep();
+  publish(twist);
+  ros::Duration(2.0).sleep();
+  odom = getLastOdom();
+  EXPECT_NEAR(odom.twist.twist.linear.x, twist.linear.x, EPS);
+
+  // stop the robot
+  twist.linear.x = 0.0;
+  publish(twist);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "four_wheel_steering_mode_hold_test");
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+  int ret = RUN_ALL_TESTS();
+  spinner.stop();
+  ros::shutdown();
+  return ret;
+}
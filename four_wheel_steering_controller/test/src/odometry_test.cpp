@@ -0,0 +1,142 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <four_wheel_steering_controller/odometry.h>
+
+using four_wheel_steering_controller::FourWheelKinematics;
+using four_wheel_steering_controller::Odometry;
+using four_wheel_steering_controller::WheelValues;
+
+namespace
+{
+
+const double TOLERANCE = 1e-9;
+const double TRACK = 1.2;
+const double WHEEL_STEERING_Y_OFFSET = 0.1;
+const double WHEEL_RADIUS = 0.28;
+const double WHEEL_BASE = 1.3;
+
+class OdometryFusionTest : public ::testing::Test
+{
+public:
+  OdometryFusionTest()
+  {
+    kinematics.setGeometry(TRACK, WHEEL_STEERING_Y_OFFSET, WHEEL_RADIUS, WHEEL_BASE);
+    odometry.setWheelParams(TRACK - 2*WHEEL_STEERING_Y_OFFSET, WHEEL_STEERING_Y_OFFSET, WHEEL_RADIUS, WHEEL_BASE);
+    odometry.init(ros::Time(1.0));
+  }
+
+  bool updateFused(const WheelValues& velocities, const WheelValues& steering, const ros::Time& time)
+  {
+    double front_steering, rear_steering;
+    FourWheelKinematics::wheelsToSteering(steering, front_steering, rear_steering);
+    return odometry.updateFused(velocities, steering, front_steering, rear_steering, time);
+  }
+
+  FourWheelKinematics kinematics;
+  Odometry odometry;
+};
+
+}
+
+TEST_F(OdometryFusionTest, recoversTwist)
+{
+  const double twists[][2] = {{1.0, 0.0}, {1.0, 0.5}, {-0.8, 0.3}, {0.5, -0.7}, {0.0, 0.0}};
+  double time = 1.0;
+  for (const auto& twist : twists)
+  {
+    WheelValues velocities, steering;
+    kinematics.twistToWheels(twist[0], twist[1], velocities, steering);
+
+    time += 0.01;
+    EXPECT_TRUE(updateFused(velocities, steering, ros::Time(time)));
+    EXPECT_NEAR(odometry.getLinearX(), twist[0], TOLERANCE);
+    EXPECT_NEAR(odometry.getLinearY(), 0.0, TOLERANCE);
+    EXPECT_NEAR(odometry.getAngular(), twist[1], TOLERANCE);
+    for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+    {
+      EXPECT_NEAR(odometry.getSlipResiduals()[i], 0.0, TOLERANCE);
+    }
+  }
+}
+
+TEST_F(OdometryFusionTest, recoversFourWheelSteering)
+{
+  WheelValues velocities, steering;
+  kinematics.fourWheelSteeringToWheels(1.0, 0.3, 0.1, velocities, steering);
+
+  EXPECT_TRUE(updateFused(velocities, steering, ros::Time(1.01)));
+  for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+  {
+    EXPECT_NEAR(odometry.getSlipResiduals()[i], 0.0, TOLERANCE);
+  }
+
+  // Crab motion, both axles steering the same way:
+  kinematics.fourWheelSteeringToWheels(1.0, 0.3, 0.3, velocities, steering);
+  EXPECT_TRUE(updateFused(velocities, steering, ros::Time(1.02)));
+  EXPECT_NEAR(odometry.getLinearX(), std::cos(0.3), TOLERANCE);
+  EXPECT_NEAR(odometry.getLinearY(), std::sin(0.3), TOLERANCE);
+  EXPECT_NEAR(odometry.getAngular(), 0.0, TOLERANCE);
+}
+
+TEST_F(OdometryFusionTest, isolatesSlippingWheel)
+{
+  WheelValues velocities, steering;
+  kinematics.twistToWheels(1.0, 0.2, velocities, steering);
+  velocities[WheelValues::REAR_LEFT] *= 1.5;
+
+  EXPECT_TRUE(updateFused(velocities, steering, ros::Time(1.01)));
+  const WheelValues& slip_residuals = odometry.getSlipResiduals();
+  for (size_t i = 0; i < WheelValues::WHEELS; ++i)
+  {
+    if (i != WheelValues::REAR_LEFT)
+    {
+      EXPECT_LT(slip_residuals[i], slip_residuals[WheelValues::REAR_LEFT]);
+    }
+  }
+  EXPECT_GT(slip_residuals[WheelValues::REAR_LEFT], 0.1);
+}
+
+TEST_F(OdometryFusionTest, integratesPose)
+{
+  WheelValues velocities, steering;
+  kinematics.twistToWheels(1.0, 0.0, velocities, steering);
+
+  for (int i = 1; i <= 100; ++i)
+  {
+    updateFused(velocities, steering, ros::Time(1.0 + 0.01*i));
+  }
+  EXPECT_NEAR(odometry.getX(), 1.0, 1e-6);
+  EXPECT_NEAR(odometry.getY(), 0.0, 1e-6);
+  EXPECT_NEAR(odometry.getHeading(), 0.0, 1e-6);
+}
+
+TEST_F(OdometryFusionTest, estimatesDerivatives)
+{
+  // Constant acceleration and steering velocities, the filters converging on the exact derivatives:
+  double time = 1.0;
+  for (int i = 1; i <= 500; ++i)
+  {
+    time += 0.01;
+    odometry.updateVelocity(0.5 + 2.0*(time - 1.0), 0.0, 0.0, ros::Time(time));
+  }
+  EXPECT_NEAR(odometry.getLinearAcceleration(), 2.0, 1e-6);
+  EXPECT_NEAR(odometry.getLinearJerk(), 0.0, 1e-6);
+
+  const double start = time;
+  const WheelValues stopped = WheelValues();
+  for (int i = 1; i <= 500; ++i)
+  {
+    time += 0.01;
+    odometry.updateFused(stopped, stopped, 0.2*(time - start), -0.1*(time - start), ros::Time(time));
+  }
+  EXPECT_NEAR(odometry.getFrontSteerVel(), 0.2, 1e-6);
+  EXPECT_NEAR(odometry.getRearSteerVel(), -0.1, 1e-6);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <four_wheel_steering_controller/four_wheel_kinematics.h>
+#include <four_wheel_steering_controller/swerve_kinematics.h>
+
+using four_wheel_steering_controller::FourWheelKinematics;
+using four_wheel_steering_controller::SwerveKinematics;
+using four_wheel_steering_controller::WheelValues;
+
+namespace
+{
+
+const double TOLERANCE = 1e-9;
+const double WHEEL_RADIUS = 0.1;
+
+// Six modules, e.g. a three axle robot
+const std::vector<double> X = {0.8, 0.8, 0.0, 0.0, -0.8, -0.8};
+const std::vector<double> Y = {0.4, -0.4, 0.45, -0.45, 0.4, -0.4};
+
+class SwerveKinematicsTest : public ::testing::Test
+{
+public:
+  SwerveKinematicsTest()
+    : velocities(X.size(), 0.0)
+    , steering(X.size(), 0.0)
+  {
+    EXPECT_TRUE(kinematics.setModules(X, Y, WHEEL_RADIUS));
+  }
+
+  SwerveKinematics kinematics;
+  std::vector<double> velocities;
+  std::vector<double> steering;
+};
+
+}
+
+TEST(SwerveKinematicsSetupTest, rejectsUnobservableModules)
+{
+  SwerveKinematics kinematics;
+  EXPECT_FALSE(kinematics.setModules({0.5}, {0.2}, WHEEL_RADIUS));
+  EXPECT_FALSE(kinematics.setModules({0.5, 0.5}, {0.2, 0.2}, WHEEL_RADIUS));
+  EXPECT_FALSE(kinematics.setModules({0.5, -0.5}, {0.2}, WHEEL_RADIUS));
+  EXPECT_FALSE(kinematics.setModules({0.5, -0.5}, {0.2, -0.2}, 0.0));
+  EXPECT_TRUE(kinematics.setModules({0.5, -0.5}, {0.2, -0.2}, WHEEL_RADIUS));
+  EXPECT_EQ(kinematics.size(), 2u);
+}
+
+TEST_F(SwerveKinematicsTest, twistRoundTrip)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> vel(-2.0, 2.0);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double lin_x = vel(gen), lin_y = vel(gen), ang = vel(gen);
+    kinematics.twistToModules(lin_x, lin_y, ang, velocities.data(), steering.data());
+    for (size_t m = 0; m < X.size(); ++m)
+    {
+      EXPECT_LE(std::abs(steering[m]), M_PI_2 + TOLERANCE);
+    }
+
+    double fit_lin_x, fit_lin_y, fit_ang;
+    kinematics.modulesToTwist(velocities.data(), steering.data(), fit_lin_x, fit_lin_y, fit_ang);
+    EXPECT_NEAR(fit_lin_x, lin_x, TOLERANCE);
+    EXPECT_NEAR(fit_lin_y, lin_y, TOLERANCE);
+    EXPECT_NEAR(fit_ang, ang, TOLERANCE);
+  }
+}
+
+TEST_F(SwerveKinematicsTest, reversesInsteadOfSteeringBeyondQuarterTurn)
+{
+  kinematics.twistToModules(-1.0, 0.0, 0.0, velocities.data(), steering.data());
+  for (size_t m = 0; m < X.size(); ++m)
+  {
+    EXPECT_NEAR(steering[m], 0.0, TOLERANCE);
+    EXPECT_NEAR(velocities[m], -1.0/WHEEL_RADIUS, TOLERANCE);
+  }
+
+  // Pure lateral motion, whatever the sign of zero:
+  kinematics.twistToModules(-0.0, 1.0, 0.0, velocities.data(), steering.data());
+  for (size_t m = 0; m < X.size(); ++m)
+  {
+    EXPECT_NEAR(velocities[m]*WHEEL_RADIUS*std::cos(steering[m]), 0.0, TOLERANCE);
+    EXPECT_NEAR(velocities[m]*WHEEL_RADIUS*std::sin(steering[m]), 1.0, TOLERANCE);
+  }
+}
+
+TEST_F(SwerveKinematicsTest, keepsSteeringAtRest)
+{
+  kinematics.twistToModules(0.3, 0.3, 0.0, velocities.data(), steering.data());
+  const std::vector<double> previous = steering;
+
+  kinematics.twistToModules(0.0, 0.0, 0.0, velocities.data(), steering.data());
+  for (size_t m = 0; m < X.size(); ++m)
+  {
+    EXPECT_EQ(velocities[m], 0.0);
+    EXPECT_EQ(steering[m], previous[m]);
+  }
+}
+
+TEST_F(SwerveKinematicsTest, fitMatchesLeastSquares)
+{
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> noise(-0.5, 0.5);
+  for (int i = 0; i < 100; ++i)
+  {
+    for (size_t m = 0; m < X.size(); ++m)
+    {
+      velocities[m] = 10.0*noise(gen);
+      steering[m] = 3.0*noise(gen);
+    }
+
+    double lin_x, lin_y, ang;
+    kinematics.modulesToTwist(velocities.data(), steering.data(), lin_x, lin_y, ang);
+
+    // The gradient of the squared residuals vanishes at the least-squares solution:
+    double gradient[3] = {0.0, 0.0, 0.0};
+    for (size_t m = 0; m < X.size(); ++m)
+    {
+      const double residual_x = lin_x - ang*Y[m] - velocities[m]*WHEEL_RADIUS*std::cos(steering[m]);
+      const double residual_y = lin_y + ang*X[m] - velocities[m]*WHEEL_RADIUS*std::sin(steering[m]);
+      gradient[0] += residual_x;
+      gradient[1] += residual_y;
+      gradient[2] += X[m]*residual_y - Y[m]*residual_x;
+    }
+    EXPECT_NEAR(gradient[0], 0.0, TOLERANCE);
+    EXPECT_NEAR(gradient[1], 0.0, TOLERANCE);
+    EXPECT_NEAR(gradient[2], 0.0, TOLERANCE);
+  }
+}
+
+TEST(SwerveKinematicsFourWheelTest, matchesFourWheelKinematics)
+{
+  // Four modules laid out like FourWheelKinematics::WheelValues, without steering offset
+  const double track = 1.2, wheel_base = 1.3;
+  SwerveKinematics kinematics;
+  ASSERT_TRUE(kinematics.setModules({wheel_base/2, wheel_base/2, -wheel_base/2, -wheel_base/2},
+                                    {track/2, -track/2, track/2, -track/2}, WHEEL_RADIUS));
+  FourWheelKinematics four_wheel;
+  four_wheel.setGeometry(track, 0.0, WHEEL_RADIUS, wheel_base);
+
+  // FourWheelKinematics saturates the steering when the center of rotation lies between the wheels, so only compare
+  // turns of radius larger than half the track
+  const double twists[][2] = {{1.0, 0.0}, {1.0, 0.5}, {-0.8, 0.3}, {0.5, -0.7}};
+  for (const auto& twist : twists)
+  {
+    double velocities[WheelValues::WHEELS];
+    double steering[WheelValues::WHEELS] = {0.0, 0.0, 0.0, 0.0};
+    kinematics.twistToModules(twist[0], 0.0, twist[1], velocities, steering);
+
+    WheelValues expected_velocities, expected_steering;
+    four_wheel.twistToWheels(twist[0], twist[1], expected_velocities, expected_steering);
+    for (size_t m = 0; m < WheelValues::WHEELS; ++m)
+    {
+      EXPECT_NEAR(velocities[m], expected_velocities[m], TOLERANCE);
+      EXPECT_NEAR(steering[m], expected_steering[m], TOLERANCE);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
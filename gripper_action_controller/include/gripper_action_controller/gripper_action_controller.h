@@ -31,6 +31,7 @@
 #define GRIPPER_ACTION_CONTROLLER_GRIPPER_ACTION_CONTROLLER_H
 
 // C++ standard
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <string>
@@ -53,10 +54,17 @@
 #include <controller_interface/controller.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <hardware_interface/internal/demangle_symbol.h>
-#include <realtime_tools/realtime_buffer.h>
+
+// controller_instrumentation
+#include <controller_instrumentation/command_channel.h>
+#include <controller_instrumentation/metrics.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_instrumentation/tracepoints.h>
 
 // Project
 #include <gripper_action_controller/hardware_interface_adapter.h>
+#include <gripper_action_controller/stall_detector.h>
 
 namespace gripper_action_controller
 {
@@ -64,8 +72,9 @@ namespace gripper_action_controller
 /**
  * \brief Controller for executing a gripper command action for simple single-dof grippers.
  *
- * \tparam HardwareInterface Controller hardware interface. Currently \p hardware_interface::PositionJointInterface and
- * \p hardware_interface::EffortJointInterface are supported out-of-the-box.
+ * \tparam HardwareInterface Controller hardware interface. Currently \p hardware_interface::PositionJointInterface,
+ * \p hardware_interface::EffortJointInterface and \p gripper_action_controller::PosVelEffJointInterface are supported
+ * out-of-the-box.
  */
 template <class HardwareInterface>
 class GripperActionController : public controller_interface::Controller<HardwareInterface>
@@ -99,8 +108,7 @@ public:
   void update(const ros::Time& time, const ros::Duration& period);
   /*\}*/
 
-  realtime_tools::RealtimeBuffer<Commands> command_;
-  Commands command_struct_, command_struct_rt_; // pre-allocated memory that is re-used to set the realtime buffer
+  Commands command_struct_, command_struct_rt_; // pre-allocated memory that is re-used to set the goal mailbox
 
 private:
 
@@ -112,20 +120,38 @@ private:
 
   typedef HardwareInterfaceAdapter<HardwareInterface> HwIfaceAdapter;
 
+  /**
+   * \brief Goal handle and command, handed over together to the realtime thread.
+   *
+   * A null goal with a hold command is posted when the active goal is canceled.
+   */
+  struct GoalCommand
+  {
+    RealtimeGoalHandlePtr goal;
+    Commands              command;
+  };
+
   bool                                          update_hold_position_; 
   
   bool                                         verbose_;            ///< Hard coded verbose flag to help in debugging
   std::string                                  name_;               ///< Controller name.
-  hardware_interface::JointHandle joint_;                          ///< Handles to controlled joints.
+  typename HardwareInterface::ResourceHandleType joint_;           ///< Handles to controlled joints.
   std::string                     joint_name_;                      ///< Controlled joint names.
 
   HwIfaceAdapter                               hw_iface_adapter_;   ///< Adapts desired goal state to HW interface.
 
-  RealtimeGoalHandlePtr                        rt_active_goal_;     ///< Currently active action goal, if any.
+  controller_instrumentation::CommandChannel<GoalCommand> goal_mailbox_; ///< Goals and commands for the realtime thread.
+  RealtimeGoalHandlePtr                        rt_active_goal_;     ///< Goal of the realtime thread. Only accessed by it.
+  RealtimeGoalHandlePtr                        active_goal_;        ///< Latest goal posted. Only accessed by the action callbacks.
   control_msgs::GripperCommandResultPtr        pre_alloc_result_;
+  control_msgs::GripperCommandFeedbackPtr      pre_alloc_feedback_;
 
   ros::Duration action_monitor_period_;
 
+  controller_instrumentation::RealtimeAudit    rt_audit_;           ///< Audit of realtime-unsafe operations in \p update().
+  controller_instrumentation::MetricsEndpoint  metrics_endpoint_;
+  controller_instrumentation::Counter          stalls_metric_;      ///< Goals aborted because the gripper stalled.
+
   // ROS API
   ros::NodeHandle    controller_nh_;
   ActionServerPtr    action_server_;
@@ -136,11 +162,14 @@ private:
   void cancelCB(GoalHandle gh);
   void preemptActiveGoal();
   void setHoldPosition(const ros::Time& time);
+  void postGoal(const RealtimeGoalHandlePtr& goal);
+  /** \brief Read the goal mailbox from the realtime thread, taking over the goal posted since the previous read, if any. */
+  GoalCommand& readGoalMailbox(bool& new_goal);
 
-  ros::Time last_movement_time_;                                    ///< Store stall time
+  ros::Time last_feedback_time_;                                    ///< Last time the feedback was filled
+  StallDetector stall_detector_;                                    ///< Stall detection
   double computed_command_;                                         ///< Computed command
 
-  double stall_timeout_, stall_velocity_threshold_;                 ///< Stall related parameters
   double default_max_effort_;                                       ///< Max allowed effort
   double goal_tolerance_;
   /**
@@ -90,36 +90,69 @@ template <class HardwareInterface>
 inline void GripperActionController<HardwareInterface>::
 starting(const ros::Time& time)
 {  
-  command_struct_rt_.position_ = joint_.getPosition();
-  command_struct_rt_.max_effort_ = default_max_effort_;
-  command_.initRT(command_struct_rt_);
+  // The hold command stays in the mailbox until the next goal is posted
+  bool new_goal;
+  GoalCommand& mailbox = readGoalMailbox(new_goal);
+  mailbox.command.position_ = joint_.getPosition();
+  mailbox.command.max_effort_ = default_max_effort_;
+  command_struct_rt_ = mailbox.command;
 
   // Hardware interface adapter
   hw_iface_adapter_.starting(ros::Time(0.0));
-  last_movement_time_ = time;
+  stall_detector_.reset(time);
 }
  
 template <class HardwareInterface>
 inline void GripperActionController<HardwareInterface>::
 stopping(const ros::Time& time)
 {
-  preemptActiveGoal();
+  // A goal posted after the last update is canceled as well
+  bool new_goal;
+  readGoalMailbox(new_goal);
+
+  // Canceled by the goal handle timer, as the actionlib goal handle publishes from the realtime thread
+  if (rt_active_goal_)
+  {
+    rt_active_goal_->setCanceled();
+  }
 }
 
 template <class HardwareInterface>
 inline void GripperActionController<HardwareInterface>::
 preemptActiveGoal()
 {
-  RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
-   
-  // Cancels the currently active goal
-  if (current_active_goal)
+  // Cancels the currently active goal. The realtime thread drops it when it picks up the next post
+  if (active_goal_)
+  {
+    if(active_goal_->gh_.getGoalStatus().status == actionlib_msgs::GoalStatus::ACTIVE)
+      active_goal_->gh_.setCanceled();
+    active_goal_.reset();
+  }
+}
+
+template <class HardwareInterface>
+inline void GripperActionController<HardwareInterface>::
+postGoal(const RealtimeGoalHandlePtr& goal)
+{
+  // The goal handle the mailbox slot held is released here, not in the realtime thread
+  goal_mailbox_.fillFromNonRT([this, &goal](GoalCommand& mailbox)
   {
-    // Marks the current goal as canceled
-    rt_active_goal_.reset();
-    if(current_active_goal->gh_.getGoalStatus().status == actionlib_msgs::GoalStatus::ACTIVE)
-      current_active_goal->gh_.setCanceled();
+    mailbox.goal = goal;
+    mailbox.command = command_struct_;
+  });
+}
+
+template <class HardwareInterface>
+inline typename GripperActionController<HardwareInterface>::GoalCommand& GripperActionController<HardwareInterface>::
+readGoalMailbox(bool& new_goal)
+{
+  GoalCommand& mailbox = *goal_mailbox_.readFromRT(new_goal);
+  if (new_goal)
+  {
+    // Swapping leaves the previous goal handle in the mailbox, so that it is never released by the realtime thread
+    rt_active_goal_.swap(mailbox.goal);
   }
+  return mailbox;
 }
 
 template <class HardwareInterface>
@@ -140,6 +173,11 @@ bool GripperActionController<HardwareInterface>::init(HardwareInterface* hw,
   
   // Controller name
   name_ = getLeafNamespace(controller_nh_);
+
+  // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+  const auto thread_placement_scope =
+    controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh_, name_);
+  if (!thread_placement_scope) {return false;}
   
   // Action status checking update rate
   double action_monitor_rate = 20.0;
@@ -193,9 +231,11 @@ bool GripperActionController<HardwareInterface>::init(HardwareInterface* hw,
   // Max allowable effort 
   controller_nh_.param<double>("max_effort", default_max_effort_, 0.0);
   default_max_effort_ = fabs(default_max_effort_);
-  // Stall - stall velocity threshold, stall timeout
-  controller_nh_.param<double>("stall_velocity_threshold", stall_velocity_threshold_, 0.001);
-  controller_nh_.param<double>("stall_timeout", stall_timeout_, 1.0);
+  // Stall detection
+  if (!stall_detector_.init(controller_nh_, name_))
+  {
+    return false;
+  }
   
   // Hardware interface adapter
   hw_iface_adapter_.init(joint_, controller_nh_);
@@ -203,6 +243,7 @@ bool GripperActionController<HardwareInterface>::init(HardwareInterface* hw,
   // Command - non RT version
   command_struct_.position_ = joint_.getPosition();
   command_struct_.max_effort_ = default_max_effort_;
+  goal_mailbox_.initRT(GoalCommand{RealtimeGoalHandlePtr(), command_struct_});
 
   // Result
   pre_alloc_result_.reset(new control_msgs::GripperCommandResult());
@@ -210,12 +251,23 @@ bool GripperActionController<HardwareInterface>::init(HardwareInterface* hw,
   pre_alloc_result_->reached_goal = false;
   pre_alloc_result_->stalled = false;
 
+  // Feedback, filled at most once per action monitor period, the rate it is published at
+  pre_alloc_feedback_.reset(new control_msgs::GripperCommandFeedback());
+
   // ROS API: Action interface
   action_server_.reset(new ActionServer(controller_nh_, "gripper_cmd",
 					boost::bind(&GripperActionController::goalCB,   this, _1),
 					boost::bind(&GripperActionController::cancelCB, this, _1),
 					false));
   action_server_->start();    
+
+  // Realtime audit (only active in audit builds)
+  rt_audit_.init(controller_nh_, name_);
+
+  // Metrics
+  if (!metrics_endpoint_.init(controller_nh_)) {return false;}
+  stalls_metric_.init("ros_controllers_gripper_stalls_total", "Gripper goals aborted because the gripper stalled.",
+                      name_);
   return true;
 }
 
@@ -223,10 +275,19 @@ template <class HardwareInterface>
 void GripperActionController<HardwareInterface>::
 update(const ros::Time& time, const ros::Duration& period)
 {
-  command_struct_rt_ = *(command_.readFromRT());
+  controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+  bool new_goal;
+  command_struct_rt_ = readGoalMailbox(new_goal).command;
+  if (new_goal)
+  {
+    stall_detector_.restartTimers(time);
+    last_feedback_time_ = ros::Time();
+  }
 
   double current_position = joint_.getPosition();
   double current_velocity = joint_.getVelocity();
+  stall_detector_.sample(current_velocity);
 
   double error_position = command_struct_rt_.position_ - current_position;
   double error_velocity = - current_velocity;
@@ -261,43 +322,35 @@ goalCB(GoalHandle gh)
   preemptActiveGoal();
   gh.setAccepted();
 
-  // This is the non-realtime command_struct
-  // We use command_ for sharing
+  // This is the non-realtime command_struct, posted with its goal
   command_struct_.position_ = gh.getGoal()->command.position;
   command_struct_.max_effort_ = gh.getGoal()->command.max_effort;
-  command_.writeFromNonRT(command_struct_);
+  postGoal(rt_goal);
 
-  pre_alloc_result_->reached_goal = false;
-  pre_alloc_result_->stalled = false;
-
-  last_movement_time_ = ros::Time::now();
-    
   // Setup goal status checking timer
   goal_handle_timer_ = controller_nh_.createTimer(action_monitor_period_,
                                                   &RealtimeGoalHandle::runNonRealtime,
                                                   rt_goal);
   goal_handle_timer_.start();
-  rt_active_goal_ = rt_goal;
+  active_goal_ = rt_goal;
 }
 
 template <class HardwareInterface>
 void GripperActionController<HardwareInterface>::
 cancelCB(GoalHandle gh)
 {
-  RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
-  
   // Check that cancel request refers to currently active goal (if any)
-  if (current_active_goal && current_active_goal->gh_ == gh)
+  if (active_goal_ && active_goal_->gh_ == gh)
   {
     // Reset current goal
-    rt_active_goal_.reset();
+    active_goal_.reset();
     
-    // Enter hold current position mode
+    // Enter hold current position mode, without goal
     setHoldPosition(ros::Time(0.0));
     ROS_DEBUG_NAMED(name_, "Canceling active action goal because cancel callback recieved from actionlib.");
     
     // Mark the current goal as canceled
-    current_active_goal->gh_.setCanceled();
+    gh.setCanceled();
   }
 }
 
@@ -307,14 +360,14 @@ setHoldPosition(const ros::Time& time)
 {
   command_struct_.position_ = joint_.getPosition();
   command_struct_.max_effort_ = default_max_effort_;
-  command_.writeFromNonRT(command_struct_);
+  postGoal(RealtimeGoalHandlePtr());
 }
 
 template <class HardwareInterface>
 void GripperActionController<HardwareInterface>::
 checkForSuccess(const ros::Time& time, double error_position, double current_position, double current_velocity)
 {
-  RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
+  const RealtimeGoalHandlePtr& current_active_goal = rt_active_goal_;
 
   if(!current_active_goal)
     return;
@@ -329,21 +382,30 @@ checkForSuccess(const ros::Time& time, double error_position, double current_pos
     pre_alloc_result_->reached_goal = true;
     pre_alloc_result_->stalled = false;
     current_active_goal->setSucceeded(pre_alloc_result_);
+    return;
   }
-  else
+
+  if(stall_detector_.stalled(time, joint_.getEffort()))
   {
-    if(fabs(current_velocity) > stall_velocity_threshold_)
-    {
-      last_movement_time_ = time;
-    }
-    else if( (time - last_movement_time_).toSec() > stall_timeout_)
-    {
-      pre_alloc_result_->effort = computed_command_;
-      pre_alloc_result_->position = current_position;
-      pre_alloc_result_->reached_goal = false;
-      pre_alloc_result_->stalled = true;
-      current_active_goal->setAborted(pre_alloc_result_);
-    }
+    CONTROLLER_TRACEPOINT2(stall_detected, name_.c_str(), joint_name_.c_str());
+    pre_alloc_result_->effort = computed_command_;
+    pre_alloc_result_->position = current_position;
+    pre_alloc_result_->reached_goal = false;
+    pre_alloc_result_->stalled = true;
+    current_active_goal->setAborted(pre_alloc_result_);
+    stalls_metric_.increment();
+    return;
+  }
+
+  // Feedback is published by the goal handle timer, so there is no point in filling it more often
+  if((time - last_feedback_time_) >= action_monitor_period_)
+  {
+    pre_alloc_feedback_->effort = computed_command_;
+    pre_alloc_feedback_->position = current_position;
+    pre_alloc_feedback_->reached_goal = false;
+    pre_alloc_feedback_->stalled = false;
+    current_active_goal->setFeedback(pre_alloc_feedback_);
+    last_feedback_time_ = time;
   }
 }
 
@@ -42,18 +42,20 @@
 #include <control_toolbox/pid.h>
 #include <hardware_interface/joint_command_interface.h>
 
+#include <gripper_action_controller/pos_vel_eff_command_interface.h>
+
 /**
  * \brief Helper class to simplify integrating the GripperActionController with different hardware interfaces.
  *
  * The GripperActionController outputs position while
- * it is supposed to work with either position or effort commands.
+ * it is supposed to work with either position, effort or position-velocity-effort commands.
  *
  */
 template <class HardwareInterface>
 class HardwareInterfaceAdapter
 {
 public:
-  bool init(hardware_interface::JointHandle& joint_handle, ros::NodeHandle& controller_nh)
+  bool init(typename HardwareInterface::ResourceHandleType& joint_handle, ros::NodeHandle& controller_nh)
   {
     return false;
   }
@@ -186,4 +188,50 @@ private:
   hardware_interface::JointHandle* joint_handle_ptr_;
 };
 
+/**
+ * \brief Adapter for a position-velocity-effort hardware interface, whose drive closes a force-limited position loop.
+ * Forwards the desired position and velocity, and the maximum allowed effort, as one command.
+ *
+ * Unlike the effort adapter, no PID loop runs in the controller: the drive limits the effort it applies on its own,
+ * e.g. in current-limited position mode, so that grips close without waiting for a PID to settle. The maximum effort
+ * is forwarded as its absolute value, and its interpretation of 0 is up to the drive.
+ */
+template<>
+class HardwareInterfaceAdapter<gripper_action_controller::PosVelEffJointInterface>
+{
+public:
+  HardwareInterfaceAdapter() : joint_handle_ptr_(0) {}
+
+  bool init(gripper_action_controller::PosVelEffJointHandle& joint_handle, ros::NodeHandle& controller_nh)
+  {
+    // Store pointer to joint handles
+    joint_handle_ptr_ = &joint_handle;
+
+    return true;
+  }
+
+  void starting(const ros::Time& time) {}
+  void stopping(const ros::Time& time) {}
+
+  double updateCommand(const ros::Time&     /*time*/,
+		       const ros::Duration& period,
+		       double desired_position,
+		       double desired_velocity,
+		       double error_position,
+		       double error_velocity,
+		       double max_allowed_effort)
+  {
+    // Preconditions
+    if (!joint_handle_ptr_) {return 0.0;}
+
+    // Forward desired position, velocity and effort limit to the drive
+    const double max_effort = fabs(max_allowed_effort);
+    (*joint_handle_ptr_).setCommand(desired_position, desired_velocity, max_effort);
+    return max_effort;
+  }
+
+private:
+  gripper_action_controller::PosVelEffJointHandle* joint_handle_ptr_;
+};
+
 #endif // header guard
@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRIPPER_ACTION_CONTROLLER_MULTI_GRIPPER_ACTION_CONTROLLER_H
+#define GRIPPER_ACTION_CONTROLLER_MULTI_GRIPPER_ACTION_CONTROLLER_H
+
+// C++ standard
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ROS
+#include <ros/node_handle.h>
+
+// ROS messages
+#include <control_msgs/GripperCommandAction.h>
+#include <gripper_action_controller/MultiGripperCommandAction.h>
+
+// actionlib
+#include <actionlib/server/action_server.h>
+
+// ros_controls
+#include <realtime_tools/realtime_server_goal_handle.h>
+#include <controller_interface/controller.h>
+#include <hardware_interface/joint_command_interface.h>
+
+// controller_instrumentation
+#include <controller_instrumentation/command_channel.h>
+#include <controller_instrumentation/metrics.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_instrumentation/tracepoints.h>
+
+// Project
+#include <gripper_action_controller/gripper_action_controller.h>
+#include <gripper_action_controller/hardware_interface_adapter.h>
+#include <gripper_action_controller/stall_detector.h>
+
+namespace gripper_action_controller
+{
+
+/**
+ * \brief Controller for executing gripper command actions on several simple single-dof grippers.
+ *
+ * Behaves like one \ref GripperActionController per gripper, but all grippers share a single controller instance and
+ * realtime update. The grippers are listed in the \p grippers parameter, and each one is configured in the
+ * sub-namespace of its name with the parameters of \ref GripperActionController (\p joint, \p goal_tolerance,
+ * \p max_effort, the stall parameters and the hardware interface adapter gains):
+ *
+ * \code
+ * grippers: [left, right]
+ * left:
+ *   joint: left_finger_joint
+ *   max_effort: 10.0
+ * right:
+ *   joint: right_finger_joint
+ *   max_effort: 10.0
+ * \endcode
+ *
+ * Each gripper serves its own \p control_msgs::GripperCommandAction on \p <name>/gripper_cmd. Coordinated grasps are
+ * commanded through the \p MultiGripperCommandAction served on \p gripper_cmd, whose goal commands several grippers
+ * in the same control cycle and completes once all of them reached their goal, or as soon as one of them stalls.
+ * A new goal preempts the active goals that command any of its grippers.
+ *
+ * \tparam HardwareInterface Controller hardware interface. Currently \p hardware_interface::PositionJointInterface,
+ * \p hardware_interface::EffortJointInterface and \p gripper_action_controller::PosVelEffJointInterface are supported
+ * out-of-the-box.
+ */
+template <class HardwareInterface>
+class MultiGripperActionController : public controller_interface::Controller<HardwareInterface>
+{
+public:
+
+  /**
+   * \brief Store position and max effort in struct to allow easier goal mailbox usage
+   */
+  struct Commands
+  {
+    double position_; // Last commanded position
+    double max_effort_; // Max allowed effort
+  };
+
+  MultiGripperActionController() = default;
+
+  /** \name Non Real-Time Safe Functions
+   *\{*/
+  bool init(HardwareInterface* hw, ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh);
+  /*\}*/
+
+  /** \name Real-Time Safe Functions
+   *\{*/
+  /** \brief Holds the current position of all grippers. */
+  void starting(const ros::Time& time);
+
+  /** \brief Cancels the active action goals, if any. */
+  void stopping(const ros::Time& time);
+
+  void update(const ros::Time& time, const ros::Duration& period);
+  /*\}*/
+
+private:
+
+  typedef actionlib::ActionServer<control_msgs::GripperCommandAction>                         ActionServer;
+  typedef std::shared_ptr<ActionServer>                                                       ActionServerPtr;
+  typedef ActionServer::GoalHandle                                                            GoalHandle;
+  typedef realtime_tools::RealtimeServerGoalHandle<control_msgs::GripperCommandAction>        RealtimeGoalHandle;
+  typedef boost::shared_ptr<RealtimeGoalHandle>                                               RealtimeGoalHandlePtr;
+
+  typedef actionlib::ActionServer<MultiGripperCommandAction>                                  MultiActionServer;
+  typedef std::shared_ptr<MultiActionServer>                                                  MultiActionServerPtr;
+  typedef MultiActionServer::GoalHandle                                                       MultiGoalHandle;
+  typedef realtime_tools::RealtimeServerGoalHandle<MultiGripperCommandAction>                 RealtimeMultiGoalHandle;
+  typedef boost::shared_ptr<RealtimeMultiGoalHandle>                                          RealtimeMultiGoalHandlePtr;
+
+  typedef HardwareInterfaceAdapter<HardwareInterface> HwIfaceAdapter;
+
+  /**
+   * \brief State of one gripper. Members written by the realtime thread are only read from it.
+   */
+  struct Gripper
+  {
+    std::string                            name;               ///< Gripper name, also its parameter namespace.
+    typename HardwareInterface::ResourceHandleType joint;      ///< Handle to the controlled joint.
+    HwIfaceAdapter                         hw_iface_adapter;   ///< Adapts desired goal state to HW interface.
+
+    double goal_tolerance;
+    double default_max_effort;                                 ///< Max allowed effort
+    StallDetector stall_detector;
+
+    // Realtime state, only accessed by the realtime thread
+    Commands command_rt;                                       ///< Command applied by the realtime thread
+    std::uint64_t command_id_rt;                               ///< Id of \p command_rt, see GoalCommands
+    RealtimeGoalHandlePtr rt_active_goal;                      ///< Goal of the realtime thread, if any.
+    ros::Time last_feedback_time;                              ///< Last time the feedback was filled
+    double computed_command;                                   ///< Computed command
+    double current_position;                                   ///< Position of the current cycle
+    double error_position;                                     ///< Position error of the current cycle
+    bool   stalled;                                            ///< Stall state of the current cycle
+
+    // ROS API
+    ros::NodeHandle                        nh;
+    ActionServerPtr                        action_server;
+    control_msgs::GripperCommandResultPtr  pre_alloc_result;
+    control_msgs::GripperCommandFeedbackPtr pre_alloc_feedback;
+    ros::Timer                             goal_handle_timer;
+  };
+
+  /**
+   * \brief Coordinated goal, with the grippers it commands and its pre-allocated result and feedback.
+   */
+  struct CoordinatedGoal
+  {
+    RealtimeMultiGoalHandlePtr     rt_goal;
+    std::vector<std::size_t>       grippers;                   ///< Indices of the commanded grippers, in goal order.
+    MultiGripperCommandResultPtr   result;
+    MultiGripperCommandFeedbackPtr feedback;
+    ros::Time                      last_feedback_time;         ///< Last time the feedback was filled
+  };
+  typedef std::shared_ptr<CoordinatedGoal> CoordinatedGoalPtr;
+
+  /**
+   * \brief Commands and goals of all grippers, handed over together to the realtime thread, so that the commands of a
+   * coordinated goal are picked up in the same cycle, along with the goal.
+   *
+   * Each post carries the state of every gripper. The realtime thread only takes over the command of a gripper whose
+   * id changed since it last did, so that commands posted before the controller was restarted are not applied again.
+   */
+  struct GoalCommands
+  {
+    std::vector<Commands>              commands;            ///< Command of each gripper.
+    std::vector<std::uint64_t>         command_ids;         ///< Incremented with each new command of a gripper.
+    std::vector<RealtimeGoalHandlePtr> goals;               ///< Goal of each gripper, null if none.
+    CoordinatedGoalPtr                 coordinated_goal;    ///< Coordinated goal, if any.
+  };
+
+  std::string                                  name_;               ///< Controller name.
+  std::vector<std::unique_ptr<Gripper>>        grippers_;
+
+  controller_instrumentation::CommandChannel<GoalCommands> goal_mailbox_; ///< Goals and commands, to the RT thread.
+  std::mutex                                   goal_mutex_;         ///< Serializes the action callbacks.
+  GoalCommands                                 goal_commands_;      ///< Latest post, guarded by \p goal_mutex_.
+  CoordinatedGoalPtr                           rt_coordinated_goal_; ///< Coordinated goal of the realtime thread.
+
+  ros::Duration action_monitor_period_;
+
+  controller_instrumentation::RealtimeAudit    rt_audit_;           ///< Audit of realtime-unsafe operations in \p update().
+  controller_instrumentation::MetricsEndpoint  metrics_endpoint_;
+  controller_instrumentation::Counter          stalls_metric_;      ///< Goals aborted because the gripper stalled.
+
+  // ROS API
+  ros::NodeHandle      controller_nh_;
+  MultiActionServerPtr coordinated_action_server_;
+  ros::Timer           coordinated_goal_timer_;
+
+  bool initGripper(HardwareInterface* hw, const urdf::Model& urdf, Gripper& gripper);
+
+  void goalCB(GoalHandle gh, std::size_t gripper_index);
+  void cancelCB(GoalHandle gh, std::size_t gripper_index);
+  void coordinatedGoalCB(MultiGoalHandle gh);
+  void coordinatedCancelCB(MultiGoalHandle gh);
+
+  /** \name Action callback helpers, called with \p goal_mutex_ held
+   *\{*/
+  void preemptActiveGoal(std::size_t gripper_index);
+  /** \brief Cancels the active coordinated goal if it commands the gripper \p gripper_index, or any gripper if negative. */
+  void preemptCoordinatedGoal(int gripper_index = -1);
+  /** \brief Set the command of gripper \p gripper_index, to be posted with the next goals. */
+  void setCommand(std::size_t gripper_index, double position, double max_effort);
+  void setHoldPosition(std::size_t gripper_index);
+  /** \brief Post the goals and commands of all grippers to the realtime thread at once. */
+  void postGoals();
+  /*\}*/
+
+  /** \brief Read the goal mailbox from the realtime thread, taking over the goals posted since the previous read. */
+  GoalCommands& readGoalMailbox();
+
+  /**
+   * \brief Check for success and publish appropriate result and feedback of the single gripper goal.
+   **/
+  void checkForSuccess(const ros::Time& time, Gripper& gripper);
+
+  /**
+   * \brief Check for success and publish appropriate result and feedback of the coordinated goal.
+   **/
+  void checkForCoordinatedSuccess(const ros::Time& time);
+};
+
+} // namespace
+
+#include <gripper_action_controller/multi_gripper_action_controller_impl.h>
+
+#endif // header guard
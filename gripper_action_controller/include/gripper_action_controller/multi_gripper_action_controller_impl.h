@@ -0,0 +1,663 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRIPPER_ACTION_CONTROLLER_MULTI_GRIPPER_ACTION_CONTROLLER_IMPL_H
+#define GRIPPER_ACTION_CONTROLLER_MULTI_GRIPPER_ACTION_CONTROLLER_IMPL_H
+
+#include <algorithm>
+
+namespace gripper_action_controller
+{
+
+template <class HardwareInterface>
+inline void MultiGripperActionController<HardwareInterface>::
+starting(const ros::Time& time)
+{
+  // Hold the current positions. Commands posted before, e.g. while the controller was stopped, are not applied
+  const GoalCommands& mailbox = readGoalMailbox();
+  for (std::size_t i = 0; i < grippers_.size(); ++i)
+  {
+    Gripper& gripper = *grippers_[i];
+    gripper.command_rt.position_ = gripper.joint.getPosition();
+    gripper.command_rt.max_effort_ = gripper.default_max_effort;
+    gripper.command_id_rt = mailbox.command_ids[i];
+
+    // Hardware interface adapter
+    gripper.hw_iface_adapter.starting(ros::Time(0.0));
+    gripper.stall_detector.reset(time);
+  }
+}
+
+template <class HardwareInterface>
+inline void MultiGripperActionController<HardwareInterface>::
+stopping(const ros::Time& time)
+{
+  // Goals posted after the last update are canceled as well
+  readGoalMailbox();
+
+  // Canceled by their goal handle timers, as the actionlib goal handles publish from the realtime thread
+  if (rt_coordinated_goal_)
+  {
+    rt_coordinated_goal_->rt_goal->setCanceled();
+  }
+  for (auto& gripper : grippers_)
+  {
+    if (gripper->rt_active_goal)
+    {
+      gripper->rt_active_goal->setCanceled();
+    }
+  }
+}
+
+template <class HardwareInterface>
+inline void MultiGripperActionController<HardwareInterface>::
+preemptActiveGoal(std::size_t gripper_index)
+{
+  // Cancels the currently active goal. The realtime thread drops it when it picks up the next post
+  RealtimeGoalHandlePtr& active_goal = goal_commands_.goals[gripper_index];
+  if (active_goal)
+  {
+    if(active_goal->gh_.getGoalStatus().status == actionlib_msgs::GoalStatus::ACTIVE)
+      active_goal->gh_.setCanceled();
+    active_goal.reset();
+  }
+}
+
+template <class HardwareInterface>
+inline void MultiGripperActionController<HardwareInterface>::
+preemptCoordinatedGoal(int gripper_index)
+{
+  CoordinatedGoalPtr& current_goal = goal_commands_.coordinated_goal;
+  if (!current_goal)
+  {
+    return;
+  }
+
+  // Goals commanding other grippers can continue
+  if (gripper_index >= 0 &&
+      std::find(current_goal->grippers.begin(), current_goal->grippers.end(),
+                static_cast<std::size_t>(gripper_index)) == current_goal->grippers.end())
+  {
+    return;
+  }
+
+  // Marks the current goal as canceled. The realtime thread drops it when it picks up the next post
+  if(current_goal->rt_goal->gh_.getGoalStatus().status == actionlib_msgs::GoalStatus::ACTIVE)
+    current_goal->rt_goal->gh_.setCanceled();
+  current_goal.reset();
+}
+
+template <class HardwareInterface>
+inline void MultiGripperActionController<HardwareInterface>::
+setCommand(std::size_t gripper_index, double position, double max_effort)
+{
+  goal_commands_.commands[gripper_index].position_ = position;
+  goal_commands_.commands[gripper_index].max_effort_ = max_effort;
+  ++goal_commands_.command_ids[gripper_index];
+}
+
+template <class HardwareInterface>
+inline void MultiGripperActionController<HardwareInterface>::
+postGoals()
+{
+  // The vectors keep their size, so filling the slot does not allocate. The goal handles the slot held are released
+  // here, not in the realtime thread
+  goal_mailbox_.fillFromNonRT([this](GoalCommands& mailbox)
+  {
+    mailbox.commands = goal_commands_.commands;
+    mailbox.command_ids = goal_commands_.command_ids;
+    mailbox.goals = goal_commands_.goals;
+    mailbox.coordinated_goal = goal_commands_.coordinated_goal;
+  });
+}
+
+template <class HardwareInterface>
+inline typename MultiGripperActionController<HardwareInterface>::GoalCommands&
+MultiGripperActionController<HardwareInterface>::readGoalMailbox()
+{
+  bool new_goal;
+  GoalCommands& mailbox = *goal_mailbox_.readFromRT(new_goal);
+  if (new_goal)
+  {
+    // Swapping leaves the previous goal handles in the mailbox, so that they are never released by the realtime thread
+    for (std::size_t i = 0; i < grippers_.size(); ++i)
+    {
+      grippers_[i]->rt_active_goal.swap(mailbox.goals[i]);
+    }
+    rt_coordinated_goal_.swap(mailbox.coordinated_goal);
+  }
+  return mailbox;
+}
+
+template <class HardwareInterface>
+bool MultiGripperActionController<HardwareInterface>::init(HardwareInterface* hw,
+                                                           ros::NodeHandle&   root_nh,
+                                                           ros::NodeHandle&   controller_nh)
+{
+  using namespace internal;
+
+  // Cache controller node handle
+  controller_nh_ = controller_nh;
+
+  // Controller name
+  name_ = getLeafNamespace(controller_nh_);
+
+  // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+  const auto thread_placement_scope =
+    controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh_, name_);
+  if (!thread_placement_scope) {return false;}
+
+  // Action status checking update rate
+  double action_monitor_rate = 20.0;
+  controller_nh_.getParam("action_monitor_rate", action_monitor_rate);
+  action_monitor_period_ = ros::Duration(1.0 / action_monitor_rate);
+  ROS_DEBUG_STREAM_NAMED(name_, "Action status changes will be monitored at " << action_monitor_rate << "Hz.");
+
+  // Grippers
+  std::vector<std::string> gripper_names;
+  if (!controller_nh_.getParam("grippers", gripper_names) || gripper_names.empty())
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Could not find gripper names on param server (namespace: " <<
+                           controller_nh_.getNamespace() << ").");
+    return false;
+  }
+
+  // URDF joints
+  urdf::ModelSharedPtr urdf = getUrdf(root_nh, "robot_description");
+  if (!urdf)
+  {
+    return false;
+  }
+
+  grippers_.clear();
+  for (const auto& gripper_name : gripper_names)
+  {
+    for (const auto& other : grippers_)
+    {
+      if (other->name == gripper_name)
+      {
+        ROS_ERROR_STREAM_NAMED(name_, "Gripper '" << gripper_name << "' is listed more than once.");
+        return false;
+      }
+    }
+
+    std::unique_ptr<Gripper> gripper(new Gripper);
+    gripper->name = gripper_name;
+    gripper->nh = ros::NodeHandle(controller_nh_, gripper_name);
+    if (!initGripper(hw, *urdf, *gripper))
+    {
+      return false;
+    }
+
+    for (const auto& other : grippers_)
+    {
+      if (other->joint.getName() == gripper->joint.getName())
+      {
+        ROS_ERROR_STREAM_NAMED(name_, "Grippers '" << other->name << "' and '" << gripper_name <<
+                               "' control the same joint '" << gripper->joint.getName() << "'.");
+        return false;
+      }
+    }
+    grippers_.push_back(std::move(gripper));
+  }
+
+  // Goal mailbox, holding the initial positions until the first goal
+  goal_commands_ = GoalCommands();
+  for (const auto& gripper : grippers_)
+  {
+    goal_commands_.commands.push_back(gripper->command_rt);
+    goal_commands_.command_ids.push_back(gripper->command_id_rt);
+    goal_commands_.goals.push_back(RealtimeGoalHandlePtr());
+  }
+  goal_mailbox_.initRT(goal_commands_);
+  rt_coordinated_goal_.reset();
+
+  ROS_DEBUG_STREAM_NAMED(name_, "Initialized controller '" << name_ << "' with:" <<
+                         "\n- Number of grippers: " << grippers_.size() <<
+                         "\n- Hardware interface type: '" << this->getHardwareInterfaceType() << "'" <<
+                         "\n");
+
+  // ROS API: Action interfaces, one per gripper and one for coordinated goals
+  for (std::size_t i = 0; i < grippers_.size(); ++i)
+  {
+    Gripper& gripper = *grippers_[i];
+    gripper.action_server.reset(new ActionServer(gripper.nh, "gripper_cmd",
+                                                 boost::bind(&MultiGripperActionController::goalCB,   this, _1, i),
+                                                 boost::bind(&MultiGripperActionController::cancelCB, this, _1, i),
+                                                 false));
+    gripper.action_server->start();
+  }
+
+  coordinated_action_server_.reset(new MultiActionServer(controller_nh_, "gripper_cmd",
+                                   boost::bind(&MultiGripperActionController::coordinatedGoalCB,   this, _1),
+                                   boost::bind(&MultiGripperActionController::coordinatedCancelCB, this, _1),
+                                   false));
+  coordinated_action_server_->start();
+
+  // Realtime audit (only active in audit builds)
+  rt_audit_.init(controller_nh_, name_);
+
+  // Metrics
+  if (!metrics_endpoint_.init(controller_nh_)) {return false;}
+  stalls_metric_.init("ros_controllers_gripper_stalls_total", "Gripper goals aborted because the gripper stalled.",
+                      name_);
+  return true;
+}
+
+template <class HardwareInterface>
+bool MultiGripperActionController<HardwareInterface>::
+initGripper(HardwareInterface* hw, const urdf::Model& urdf, Gripper& gripper)
+{
+  using namespace internal;
+
+  const ros::NodeHandle& gripper_nh = gripper.nh;
+
+  // Controlled joint
+  std::string joint_name;
+  gripper_nh.getParam("joint", joint_name);
+  if (joint_name.empty())
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Could not find joint name of gripper '" << gripper.name << "' on param server");
+    return false;
+  }
+
+  std::vector<std::string> joint_names;
+  joint_names.push_back(joint_name);
+  if (getUrdfJoints(urdf, joint_names).empty())
+  {
+    return false;
+  }
+
+  // Joint handle
+  try
+  {
+    gripper.joint = hw->getHandle(joint_name);
+  }
+  catch (...)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Could not find joint '" << joint_name << "' in '" <<
+                           this->getHardwareInterfaceType() << "'.");
+    return false;
+  }
+
+  // Default tolerances
+  gripper_nh.param<double>("goal_tolerance", gripper.goal_tolerance, 0.01);
+  gripper.goal_tolerance = fabs(gripper.goal_tolerance);
+  // Max allowable effort
+  gripper_nh.param<double>("max_effort", gripper.default_max_effort, 0.0);
+  gripper.default_max_effort = fabs(gripper.default_max_effort);
+  // Stall detection
+  if (!gripper.stall_detector.init(gripper_nh, name_))
+  {
+    return false;
+  }
+
+  // Hardware interface adapter
+  gripper.hw_iface_adapter.init(gripper.joint, gripper.nh);
+
+  // Command
+  gripper.command_rt.position_ = gripper.joint.getPosition();
+  gripper.command_rt.max_effort_ = gripper.default_max_effort;
+  gripper.command_id_rt = 0;
+  gripper.computed_command = 0.0;
+  gripper.current_position = gripper.command_rt.position_;
+  gripper.error_position = 0.0;
+  gripper.stalled = false;
+
+  // Result
+  gripper.pre_alloc_result.reset(new control_msgs::GripperCommandResult());
+  gripper.pre_alloc_result->position = gripper.command_rt.position_;
+  gripper.pre_alloc_result->reached_goal = false;
+  gripper.pre_alloc_result->stalled = false;
+
+  // Feedback, filled at most once per action monitor period, the rate it is published at
+  gripper.pre_alloc_feedback.reset(new control_msgs::GripperCommandFeedback());
+  return true;
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+update(const ros::Time& time, const ros::Duration& period)
+{
+  controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+  // The commands of all grippers are taken over in the same cycle as the goals they belong to
+  const GoalCommands& mailbox = readGoalMailbox();
+  for (std::size_t i = 0; i < grippers_.size(); ++i)
+  {
+    Gripper& gripper = *grippers_[i];
+
+    gripper.current_position = gripper.joint.getPosition();
+    const double current_velocity = gripper.joint.getVelocity();
+    gripper.stall_detector.sample(current_velocity);
+
+    if (gripper.command_id_rt != mailbox.command_ids[i])
+    {
+      gripper.command_rt = mailbox.commands[i];
+      gripper.command_id_rt = mailbox.command_ids[i];
+      gripper.stall_detector.restartTimers(time);
+      gripper.last_feedback_time = ros::Time();
+    }
+
+    gripper.error_position = gripper.command_rt.position_ - gripper.current_position;
+    gripper.stalled = gripper.stall_detector.stalled(time, gripper.joint.getEffort());
+
+    checkForSuccess(time, gripper);
+
+    // Hardware interface adapter: Generate and send commands
+    gripper.computed_command = gripper.hw_iface_adapter.updateCommand(time, period,
+                                                                      gripper.command_rt.position_, 0.0,
+                                                                      gripper.error_position, -current_velocity,
+                                                                      gripper.command_rt.max_effort_);
+  }
+
+  checkForCoordinatedSuccess(time);
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+goalCB(GoalHandle gh, std::size_t gripper_index)
+{
+  Gripper& gripper = *grippers_[gripper_index];
+  ROS_DEBUG_STREAM_NAMED(name_, "Recieved new action goal for gripper '" << gripper.name << "'");
+
+  // Precondition: Running controller
+  if (!this->isRunning())
+  {
+    ROS_ERROR_NAMED(name_, "Can't accept new action goals. Controller is not running.");
+    control_msgs::GripperCommandResult result;
+    gh.setRejected(result);
+    return;
+  }
+
+  // Try to update goal
+  RealtimeGoalHandlePtr rt_goal(new RealtimeGoalHandle(gh));
+
+  std::lock_guard<std::mutex> lock(goal_mutex_);
+
+  // Accept new goal, the coordinated goal commanding this gripper is preempted as well
+  preemptActiveGoal(gripper_index);
+  preemptCoordinatedGoal(static_cast<int>(gripper_index));
+  gh.setAccepted();
+
+  // Posted with its goal, the stall timers restart in the realtime thread
+  setCommand(gripper_index, gh.getGoal()->command.position, gh.getGoal()->command.max_effort);
+  goal_commands_.goals[gripper_index] = rt_goal;
+  postGoals();
+
+  // Setup goal status checking timer
+  gripper.goal_handle_timer = gripper.nh.createTimer(action_monitor_period_,
+                                                     &RealtimeGoalHandle::runNonRealtime,
+                                                     rt_goal);
+  gripper.goal_handle_timer.start();
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+cancelCB(GoalHandle gh, std::size_t gripper_index)
+{
+  std::lock_guard<std::mutex> lock(goal_mutex_);
+  RealtimeGoalHandlePtr& active_goal = goal_commands_.goals[gripper_index];
+
+  // Check that cancel request refers to currently active goal (if any)
+  if (active_goal && active_goal->gh_ == gh)
+  {
+    // Reset current goal
+    active_goal.reset();
+
+    // Enter hold current position mode, without goal
+    setHoldPosition(gripper_index);
+    postGoals();
+    ROS_DEBUG_STREAM_NAMED(name_, "Canceling active action goal of gripper '" << grippers_[gripper_index]->name <<
+                           "' because cancel callback recieved from actionlib.");
+
+    // Mark the current goal as canceled
+    gh.setCanceled();
+  }
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+coordinatedGoalCB(MultiGoalHandle gh)
+{
+  ROS_DEBUG_STREAM_NAMED(name_, "Recieved new coordinated action goal");
+
+  MultiGripperCommandResult result;
+
+  // Precondition: Running controller
+  if (!this->isRunning())
+  {
+    ROS_ERROR_NAMED(name_, "Can't accept new action goals. Controller is not running.");
+    gh.setRejected(result);
+    return;
+  }
+
+  // Precondition: One command per known gripper, each gripper commanded at most once
+  const MultiGripperCommandGoal& goal = *gh.getGoal();
+  if (goal.grippers.empty() || goal.grippers.size() != goal.commands.size())
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Coordinated goal must have one command per gripper, got " <<
+                           goal.grippers.size() << " grippers and " << goal.commands.size() << " commands.");
+    gh.setRejected(result, "Number of grippers and commands mismatch");
+    return;
+  }
+
+  CoordinatedGoalPtr coordinated_goal(new CoordinatedGoal);
+  for (const auto& gripper_name : goal.grippers)
+  {
+    const auto it = std::find_if(grippers_.begin(), grippers_.end(),
+                                 [&gripper_name](const std::unique_ptr<Gripper>& gripper)
+                                 {return gripper->name == gripper_name;});
+    if (it == grippers_.end())
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Coordinated goal commands unknown gripper '" << gripper_name << "'.");
+      gh.setRejected(result, "Unknown gripper '" + gripper_name + "'");
+      return;
+    }
+
+    const std::size_t gripper_index = it - grippers_.begin();
+    if (std::find(coordinated_goal->grippers.begin(), coordinated_goal->grippers.end(), gripper_index) !=
+        coordinated_goal->grippers.end())
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Coordinated goal commands gripper '" << gripper_name << "' more than once.");
+      gh.setRejected(result, "Gripper '" + gripper_name + "' commanded more than once");
+      return;
+    }
+    coordinated_goal->grippers.push_back(gripper_index);
+  }
+
+  // Pre-allocated result and feedback, filled by the realtime thread
+  coordinated_goal->result.reset(new MultiGripperCommandResult());
+  coordinated_goal->result->results.resize(goal.grippers.size());
+  coordinated_goal->feedback.reset(new MultiGripperCommandFeedback());
+  coordinated_goal->feedback->feedback.resize(goal.grippers.size());
+  coordinated_goal->rt_goal.reset(new RealtimeMultiGoalHandle(gh));
+
+  std::lock_guard<std::mutex> lock(goal_mutex_);
+
+  // Accept new goal, preempting the goals of the commanded grippers
+  preemptCoordinatedGoal();
+  for (const auto gripper_index : coordinated_goal->grippers)
+  {
+    preemptActiveGoal(gripper_index);
+  }
+  gh.setAccepted();
+
+  // The commands of all grippers are posted at once with the goal, the stall timers restart in the realtime thread
+  for (std::size_t i = 0; i < coordinated_goal->grippers.size(); ++i)
+  {
+    setCommand(coordinated_goal->grippers[i], goal.commands[i].position, goal.commands[i].max_effort);
+  }
+  goal_commands_.coordinated_goal = coordinated_goal;
+  postGoals();
+
+  // Setup goal status checking timer
+  coordinated_goal_timer_ = controller_nh_.createTimer(action_monitor_period_,
+                                                       &RealtimeMultiGoalHandle::runNonRealtime,
+                                                       coordinated_goal->rt_goal);
+  coordinated_goal_timer_.start();
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+coordinatedCancelCB(MultiGoalHandle gh)
+{
+  std::lock_guard<std::mutex> lock(goal_mutex_);
+  CoordinatedGoalPtr& current_goal = goal_commands_.coordinated_goal;
+
+  // Check that cancel request refers to currently active goal (if any)
+  if (current_goal && current_goal->rt_goal->gh_ == gh)
+  {
+    // Enter hold current position mode, without goal
+    for (const auto gripper_index : current_goal->grippers)
+    {
+      setHoldPosition(gripper_index);
+    }
+
+    // Reset current goal
+    current_goal.reset();
+    postGoals();
+    ROS_DEBUG_NAMED(name_, "Canceling coordinated action goal because cancel callback recieved from actionlib.");
+
+    // Mark the current goal as canceled
+    gh.setCanceled();
+  }
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+setHoldPosition(std::size_t gripper_index)
+{
+  const Gripper& gripper = *grippers_[gripper_index];
+  setCommand(gripper_index, gripper.joint.getPosition(), gripper.default_max_effort);
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+checkForSuccess(const ros::Time& time, Gripper& gripper)
+{
+  const RealtimeGoalHandlePtr& current_active_goal = gripper.rt_active_goal;
+
+  if(!current_active_goal)
+    return;
+
+  if(current_active_goal->gh_.getGoalStatus().status != actionlib_msgs::GoalStatus::ACTIVE)
+    return;
+
+  if(fabs(gripper.error_position) < gripper.goal_tolerance)
+  {
+    gripper.pre_alloc_result->effort = gripper.computed_command;
+    gripper.pre_alloc_result->position = gripper.current_position;
+    gripper.pre_alloc_result->reached_goal = true;
+    gripper.pre_alloc_result->stalled = false;
+    current_active_goal->setSucceeded(gripper.pre_alloc_result);
+    return;
+  }
+
+  if(gripper.stalled)
+  {
+    CONTROLLER_TRACEPOINT2(stall_detected, name_.c_str(), gripper.name.c_str());
+    gripper.pre_alloc_result->effort = gripper.computed_command;
+    gripper.pre_alloc_result->position = gripper.current_position;
+    gripper.pre_alloc_result->reached_goal = false;
+    gripper.pre_alloc_result->stalled = true;
+    current_active_goal->setAborted(gripper.pre_alloc_result);
+    stalls_metric_.increment();
+    return;
+  }
+
+  // Feedback is published by the goal handle timer, so there is no point in filling it more often
+  if((time - gripper.last_feedback_time) >= action_monitor_period_)
+  {
+    gripper.pre_alloc_feedback->effort = gripper.computed_command;
+    gripper.pre_alloc_feedback->position = gripper.current_position;
+    gripper.pre_alloc_feedback->reached_goal = false;
+    gripper.pre_alloc_feedback->stalled = false;
+    current_active_goal->setFeedback(gripper.pre_alloc_feedback);
+    gripper.last_feedback_time = time;
+  }
+}
+
+template <class HardwareInterface>
+void MultiGripperActionController<HardwareInterface>::
+checkForCoordinatedSuccess(const ros::Time& time)
+{
+  const CoordinatedGoalPtr& current_goal = rt_coordinated_goal_;
+
+  if(!current_goal)
+    return;
+
+  if(current_goal->rt_goal->gh_.getGoalStatus().status != actionlib_msgs::GoalStatus::ACTIVE)
+    return;
+
+  // The goal succeeds once all grippers reached their goal, and aborts as soon as one of them stalls
+  bool all_reached = true;
+  bool any_stalled = false;
+  for (std::size_t i = 0; i < current_goal->grippers.size(); ++i)
+  {
+    const Gripper& gripper = *grippers_[current_goal->grippers[i]];
+    control_msgs::GripperCommandResult& result = current_goal->result->results[i];
+    result.effort = gripper.computed_command;
+    result.position = gripper.current_position;
+    result.reached_goal = fabs(gripper.error_position) < gripper.goal_tolerance;
+    result.stalled = !result.reached_goal && gripper.stalled;
+    all_reached = all_reached && result.reached_goal;
+    any_stalled = any_stalled || result.stalled;
+  }
+
+  if(all_reached)
+  {
+    current_goal->rt_goal->setSucceeded(current_goal->result);
+    return;
+  }
+
+  if(any_stalled)
+  {
+    current_goal->rt_goal->setAborted(current_goal->result);
+    return;
+  }
+
+  // Feedback is published by the goal handle timer, so there is no point in filling it more often
+  if((time - current_goal->last_feedback_time) >= action_monitor_period_)
+  {
+    for (std::size_t i = 0; i < current_goal->grippers.size(); ++i)
+    {
+      const control_msgs::GripperCommandResult& result = current_goal->result->results[i];
+      control_msgs::GripperCommandFeedback& feedback = current_goal->feedback->feedback[i];
+      feedback.effort = result.effort;
+      feedback.position = result.position;
+      feedback.reached_goal = result.reached_goal;
+      feedback.stalled = false;
+    }
+    current_goal->rt_goal->setFeedback(current_goal->feedback);
+    current_goal->last_feedback_time = time;
+  }
+}
+
+} // namespace
+
+#endif // header guard
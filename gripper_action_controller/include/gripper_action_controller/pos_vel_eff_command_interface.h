@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRIPPER_ACTION_CONTROLLER_POS_VEL_EFF_COMMAND_INTERFACE_H
+#define GRIPPER_ACTION_CONTROLLER_POS_VEL_EFF_COMMAND_INTERFACE_H
+
+// C++ standard
+#include <cassert>
+#include <string>
+
+// ros_control
+#include <hardware_interface/internal/hardware_resource_manager.h>
+#include <hardware_interface/joint_state_interface.h>
+
+namespace gripper_action_controller
+{
+
+/**
+ * \brief Handle used to read and command a drive that closes its own force-limited position loop.
+ *
+ * Alongside the joint state, the handle carries a position target, a velocity at the target, and the maximum effort
+ * the drive may apply to reach it, e.g. the current limit of a gripper drive in current-limited position mode. All
+ * three are set by a single setCommand() call, so that the drive never sees a new target with a stale limit.
+ */
+class PosVelEffJointHandle : public hardware_interface::JointStateHandle
+{
+public:
+  PosVelEffJointHandle() : hardware_interface::JointStateHandle(), cmd_pos_(0), cmd_vel_(0), cmd_eff_(0) {}
+
+  /**
+   * \param js      This joint's state handle
+   * \param cmd_pos A pointer to the storage for this joint's position command
+   * \param cmd_vel A pointer to the storage for this joint's velocity command
+   * \param cmd_eff A pointer to the storage for this joint's maximum effort
+   */
+  PosVelEffJointHandle(const hardware_interface::JointStateHandle& js, double* cmd_pos, double* cmd_vel,
+                       double* cmd_eff)
+    : hardware_interface::JointStateHandle(js), cmd_pos_(cmd_pos), cmd_vel_(cmd_vel), cmd_eff_(cmd_eff)
+  {
+    if (!cmd_pos_) {throwNullCommand(js.getName(), "position");}
+    if (!cmd_vel_) {throwNullCommand(js.getName(), "velocity");}
+    if (!cmd_eff_) {throwNullCommand(js.getName(), "effort");}
+  }
+
+  void setCommand(double cmd_pos, double cmd_vel, double cmd_eff)
+  {
+    setCommandPosition(cmd_pos);
+    setCommandVelocity(cmd_vel);
+    setCommandEffort(cmd_eff);
+  }
+
+  void setCommandPosition(double cmd_pos) {assert(cmd_pos_); *cmd_pos_ = cmd_pos;}
+  void setCommandVelocity(double cmd_vel) {assert(cmd_vel_); *cmd_vel_ = cmd_vel;}
+  void setCommandEffort(double cmd_eff)   {assert(cmd_eff_); *cmd_eff_ = cmd_eff;}
+
+  double getCommandPosition() const {assert(cmd_pos_); return *cmd_pos_;}
+  double getCommandVelocity() const {assert(cmd_vel_); return *cmd_vel_;}
+  double getCommandEffort()   const {assert(cmd_eff_); return *cmd_eff_;}
+
+private:
+  double* cmd_pos_;
+  double* cmd_vel_;
+  double* cmd_eff_;
+
+  static void throwNullCommand(const std::string& name, const std::string& command)
+  {
+    throw hardware_interface::HardwareInterfaceException("Cannot create handle '" + name + "'. Command " + command +
+                                                         " data pointer is null.");
+  }
+};
+
+/**
+ * \brief Hardware interface to support commanding a position target, velocity and maximum effort to an array of
+ * joints, as one command.
+ *
+ * This \ref HardwareInterface supports commanding joints whose drive limits the effort of its own position loop. The
+ * commands are forwarded as is, see \ref PosVelEffJointHandle.
+ */
+class PosVelEffJointInterface
+  : public hardware_interface::HardwareResourceManager<PosVelEffJointHandle, hardware_interface::ClaimResources>
+{
+};
+
+} // namespace
+
+#endif // header guard
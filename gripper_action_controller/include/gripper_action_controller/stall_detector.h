@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRIPPER_ACTION_CONTROLLER_STALL_DETECTOR_H
+#define GRIPPER_ACTION_CONTROLLER_STALL_DETECTOR_H
+
+// C++ standard
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// ROS
+#include <ros/node_handle.h>
+
+// controller_instrumentation
+#include <controller_instrumentation/rolling_mean.h>
+
+namespace gripper_action_controller
+{
+
+/**
+ * \brief Tells when a gripper stopped moving before reaching its goal.
+ *
+ * The gripper is stalled when its filtered velocity stayed below \p stall_velocity_threshold for \p stall_timeout.
+ * When \p stall_effort_threshold is positive, it is also stalled when it stayed still while pushing with at least that
+ * effort for the (shorter) \p stall_effort_timeout, i.e. when it holds an object.
+ *
+ * Parameters, read from the node handle passed to \ref init:
+ * - \p stall_velocity_threshold (default 0.001)
+ * - \p stall_timeout (default 1.0 s)
+ * - \p stall_velocity_window, number of velocity samples averaged (default 1)
+ * - \p stall_effort_threshold, 0 disables the effort criterion (default 0.0)
+ * - \p stall_effort_timeout (default 0.1 s)
+ */
+class StallDetector
+{
+public:
+  StallDetector()
+    : stall_velocity_threshold_(0.001),
+      stall_timeout_(1.0),
+      stall_effort_threshold_(0.0),
+      stall_effort_timeout_(0.1)
+  {
+    velocity_filter_.resize(1);
+  }
+
+  /** \brief Read the stall parameters. \p name only prefixes the error messages. Not realtime safe. */
+  bool init(const ros::NodeHandle& nh, const std::string& name)
+  {
+    nh.param<double>("stall_velocity_threshold", stall_velocity_threshold_, 0.001);
+    nh.param<double>("stall_timeout", stall_timeout_, 1.0);
+
+    int stall_velocity_window = 1;
+    nh.getParam("stall_velocity_window", stall_velocity_window);
+    if (stall_velocity_window < 1)
+    {
+      ROS_ERROR_STREAM_NAMED(name, "Stall velocity window must be at least one sample, got " << stall_velocity_window << ".");
+      return false;
+    }
+    velocity_filter_.resize(stall_velocity_window);
+
+    nh.param<double>("stall_effort_threshold", stall_effort_threshold_, 0.0);
+    stall_effort_threshold_ = std::fabs(stall_effort_threshold_);
+    nh.param<double>("stall_effort_timeout", stall_effort_timeout_, 0.1);
+    return true;
+  }
+
+  /** \brief Forget the velocity history and restart the stall timers. */
+  void reset(const ros::Time& time)
+  {
+    velocity_filter_.reset();
+    restartTimers(time);
+  }
+
+  /** \brief Restart the stall timers, e.g. when a new goal is accepted. The velocity history is kept. */
+  void restartTimers(const ros::Time& time)
+  {
+    last_movement_time_ = time;
+    last_unloaded_time_ = time;
+  }
+
+  /** \brief Add a velocity sample to the filter. To be called once per control cycle. */
+  void sample(double velocity)
+  {
+    velocity_filter_.push(velocity);
+  }
+
+  /** \brief Updates the stall timers with the current \p effort and tells whether the gripper is stalled. */
+  bool stalled(const ros::Time& time, double effort)
+  {
+    if (std::fabs(velocity_filter_.mean()) > stall_velocity_threshold_)
+    {
+      last_movement_time_ = time;
+    }
+    if (stall_effort_threshold_ <= 0.0 || std::fabs(effort) < stall_effort_threshold_)
+    {
+      last_unloaded_time_ = time;
+    }
+
+    const double still_duration = (time - last_movement_time_).toSec();
+    const bool effort_stall = std::min(still_duration, (time - last_unloaded_time_).toSec()) > stall_effort_timeout_;
+    return still_duration > stall_timeout_ || effort_stall;
+  }
+
+private:
+  controller_instrumentation::RollingMean<double> velocity_filter_; ///< Velocity averaged for stall detection
+  ros::Time last_movement_time_;                                    ///< Last time the filtered velocity was above threshold
+  ros::Time last_unloaded_time_;                                    ///< Last time the effort was below the stall effort
+
+  double stall_velocity_threshold_, stall_timeout_;
+  double stall_effort_threshold_, stall_effort_timeout_;
+};
+
+} // namespace
+
+#endif // header guard
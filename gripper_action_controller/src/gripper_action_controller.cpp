@@ -32,6 +32,7 @@
 
 // Project
 #include <gripper_action_controller/gripper_action_controller.h>
+#include <gripper_action_controller/multi_gripper_action_controller.h>
 
 namespace position_controllers
 {
@@ -41,6 +42,13 @@ namespace position_controllers
    */
   typedef gripper_action_controller::GripperActionController<hardware_interface::PositionJointInterface>
           GripperActionController;
+
+  /**
+   * \brief Multi-gripper action controller that sends
+   * commands to a \b position interface.
+   */
+  typedef gripper_action_controller::MultiGripperActionController<hardware_interface::PositionJointInterface>
+          MultiGripperActionController;
 }
 
 namespace effort_controllers
@@ -51,7 +59,35 @@ namespace effort_controllers
    */
   typedef gripper_action_controller::GripperActionController<hardware_interface::EffortJointInterface>
           GripperActionController;
+
+  /**
+   * \brief Multi-gripper action controller that sends
+   * commands to a \b effort interface.
+   */
+  typedef gripper_action_controller::MultiGripperActionController<hardware_interface::EffortJointInterface>
+          MultiGripperActionController;
+}
+
+namespace pos_vel_eff_controllers
+{
+  /**
+   * \brief Gripper action controller that sends
+   * commands to a \b pos_vel_eff interface, whose drive limits the effort on its own.
+   */
+  typedef gripper_action_controller::GripperActionController<gripper_action_controller::PosVelEffJointInterface>
+          GripperActionController;
+
+  /**
+   * \brief Multi-gripper action controller that sends
+   * commands to a \b pos_vel_eff interface, whose drive limits the effort on its own.
+   */
+  typedef gripper_action_controller::MultiGripperActionController<gripper_action_controller::PosVelEffJointInterface>
+          MultiGripperActionController;
 }
 
 PLUGINLIB_EXPORT_CLASS(position_controllers::GripperActionController, controller_interface::ControllerBase)
 PLUGINLIB_EXPORT_CLASS(effort_controllers::GripperActionController,   controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(position_controllers::MultiGripperActionController, controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(effort_controllers::MultiGripperActionController,   controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(pos_vel_eff_controllers::GripperActionController, controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(pos_vel_eff_controllers::MultiGripperActionController, controller_interface::ControllerBase)
@@ -0,0 +1,353 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <actionlib/client/simple_action_client.h>
+#include <hardware_interface/robot_hw.h>
+
+#include <gripper_action_controller/multi_gripper_action_controller.h>
+
+using actionlib::SimpleClientGoalState;
+using gripper_action_controller::MultiGripperCommandAction;
+using gripper_action_controller::MultiGripperCommandGoal;
+
+namespace
+{
+
+typedef gripper_action_controller::MultiGripperActionController<hardware_interface::PositionJointInterface>
+        PositionMultiGripperActionController;
+
+/** \brief Controller with the lifecycle requests normally issued by the controller manager. */
+class TestController : public PositionMultiGripperActionController
+{
+public:
+  using PositionMultiGripperActionController::initRequest;
+};
+
+/** \brief State and command storage of a joint. */
+struct Joint
+{
+  double pos = 0.0;
+  double vel = 0.0;
+  double eff = 0.0;
+  double cmd = 0.0;
+};
+
+MultiGripperCommandGoal coordinatedGoal(const std::string& gripper, double position)
+{
+  MultiGripperCommandGoal goal;
+  goal.grippers.push_back(gripper);
+  goal.commands.resize(1);
+  goal.commands[0].position = position;
+  goal.commands[0].max_effort = 5.0;
+  return goal;
+}
+
+MultiGripperCommandGoal coordinatedGoal(double left_position, double right_position)
+{
+  MultiGripperCommandGoal goal = coordinatedGoal("left", left_position);
+  goal.grippers.push_back("right");
+  goal.commands.push_back(goal.commands[0]);
+  goal.commands[1].position = right_position;
+  return goal;
+}
+
+control_msgs::GripperCommandGoal gripperGoal(double position)
+{
+  control_msgs::GripperCommandGoal goal;
+  goal.command.position = position;
+  goal.command.max_effort = 5.0;
+  return goal;
+}
+
+} // namespace
+
+class MultiGripperActionControllerTest : public ::testing::Test
+{
+public:
+  MultiGripperActionControllerTest()
+    : controller_nh_("multi_gripper_controller"),
+      left_client_("multi_gripper_controller/left/gripper_cmd", true),
+      right_client_("multi_gripper_controller/right/gripper_cmd", true),
+      coordinated_client_("multi_gripper_controller/gripper_cmd", true),
+      time_(1.0),
+      period_(0.01),
+      follow_commands_(true)
+  {
+    interface_.registerHandle(hardware_interface::JointHandle(
+      hardware_interface::JointStateHandle("left_finger_joint", &left_.pos, &left_.vel, &left_.eff), &left_.cmd));
+    interface_.registerHandle(hardware_interface::JointHandle(
+      hardware_interface::JointStateHandle("right_finger_joint", &right_.pos, &right_.vel, &right_.eff), &right_.cmd));
+    robot_hw_.registerInterface(&interface_);
+  }
+
+  void SetUp() override
+  {
+    TestController::ClaimedResources claimed_resources;
+    ASSERT_TRUE(controller_.initRequest(&robot_hw_, root_nh_, controller_nh_, claimed_resources));
+    ASSERT_TRUE(controller_.startRequest(time_));
+
+    const ros::Duration timeout(5.0);
+    ASSERT_TRUE(left_client_.waitForServer(timeout));
+    ASSERT_TRUE(right_client_.waitForServer(timeout));
+    ASSERT_TRUE(coordinated_client_.waitForServer(timeout));
+  }
+
+protected:
+  /** \brief Run one control cycle. The joints reach their position command within the cycle if following them. */
+  void update()
+  {
+    controller_.update(time_, period_);
+    time_ += period_;
+    if (follow_commands_)
+    {
+      left_.pos = left_.cmd;
+      right_.pos = right_.cmd;
+    }
+  }
+
+  /** \brief Run control cycles until \p done, leaving time to the action callbacks in between. */
+  bool updateUntil(const std::function<bool()>& done, const ros::Duration& timeout = ros::Duration(5.0))
+  {
+    const ros::Time end = ros::Time::now() + timeout;
+    while (ros::ok() && ros::Time::now() < end)
+    {
+      update();
+      if (done()) {return true;}
+      ros::Duration(0.002).sleep();
+    }
+    return false;
+  }
+
+  template <class Client>
+  bool updateUntilDone(const Client& client)
+  {
+    return updateUntil([&client] {return client.getState().isDone();});
+  }
+
+  ros::NodeHandle root_nh_;
+  ros::NodeHandle controller_nh_;
+
+  Joint left_;
+  Joint right_;
+  hardware_interface::PositionJointInterface interface_;
+  hardware_interface::RobotHW robot_hw_;
+  TestController controller_;
+
+  actionlib::SimpleActionClient<control_msgs::GripperCommandAction> left_client_;
+  actionlib::SimpleActionClient<control_msgs::GripperCommandAction> right_client_;
+  actionlib::SimpleActionClient<MultiGripperCommandAction> coordinated_client_;
+
+  ros::Time time_;
+  ros::Duration period_;
+  bool follow_commands_;
+};
+
+TEST_F(MultiGripperActionControllerTest, CoordinatedGoalCommandsAllGrippersInOneCycle)
+{
+  coordinated_client_.sendGoal(coordinatedGoal(0.04, 0.06));
+
+  // Both grippers hold their position until the goal is picked up, then both are commanded in the same cycle
+  ASSERT_TRUE(updateUntil([this]
+  {
+    const bool left_commanded = left_.cmd == 0.04;
+    const bool right_commanded = right_.cmd == 0.06;
+    EXPECT_EQ(left_commanded, right_commanded);
+    if (!left_commanded) {EXPECT_EQ(0.0, left_.cmd);}
+    if (!right_commanded) {EXPECT_EQ(0.0, right_.cmd);}
+    return left_commanded || right_commanded;
+  }));
+
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::SUCCEEDED, coordinated_client_.getState().state_);
+
+  // One result per gripper, in goal order
+  const auto result = coordinated_client_.getResult();
+  ASSERT_EQ(2u, result->results.size());
+  EXPECT_TRUE(result->results[0].reached_goal);
+  EXPECT_TRUE(result->results[1].reached_goal);
+  EXPECT_EQ(0.04, result->results[0].position);
+  EXPECT_EQ(0.06, result->results[1].position);
+}
+
+TEST_F(MultiGripperActionControllerTest, CoordinatedGoalSucceedsOnceAllGrippersReachedTheirGoal)
+{
+  follow_commands_ = false;
+  coordinated_client_.sendGoal(coordinatedGoal(0.04, 0.06));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.04;}));
+
+  // Only the left gripper reaches its goal
+  left_.pos = 0.04;
+  for (int i = 0; i < 20; ++i)
+  {
+    update();
+    ros::Duration(0.002).sleep();
+  }
+  EXPECT_FALSE(coordinated_client_.getState().isDone());
+
+  right_.pos = 0.06;
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::SUCCEEDED, coordinated_client_.getState().state_);
+}
+
+TEST_F(MultiGripperActionControllerTest, GripperGoalPreemptsCoordinatedGoal)
+{
+  follow_commands_ = false;
+  coordinated_client_.sendGoal(coordinatedGoal(0.04, 0.06));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.04;}));
+
+  // The coordinated goal is preempted, the other gripper keeps its command
+  left_client_.sendGoal(gripperGoal(0.02));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.02;}));
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::PREEMPTED, coordinated_client_.getState().state_);
+  EXPECT_EQ(0.06, right_.cmd);
+
+  follow_commands_ = true;
+  ASSERT_TRUE(updateUntilDone(left_client_));
+  EXPECT_EQ(SimpleClientGoalState::SUCCEEDED, left_client_.getState().state_);
+  EXPECT_EQ(0.02, left_client_.getResult()->position);
+}
+
+TEST_F(MultiGripperActionControllerTest, GripperGoalPreemptsGripperGoal)
+{
+  follow_commands_ = false;
+  left_client_.sendGoal(gripperGoal(0.04));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.04;}));
+
+  // Goal of another client
+  actionlib::SimpleActionClient<control_msgs::GripperCommandAction> other_client(
+    "multi_gripper_controller/left/gripper_cmd", true);
+  ASSERT_TRUE(other_client.waitForServer(ros::Duration(5.0)));
+  other_client.sendGoal(gripperGoal(0.02));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.02;}));
+  ASSERT_TRUE(updateUntilDone(left_client_));
+  EXPECT_EQ(SimpleClientGoalState::PREEMPTED, left_client_.getState().state_);
+
+  follow_commands_ = true;
+  ASSERT_TRUE(updateUntilDone(other_client));
+  EXPECT_EQ(SimpleClientGoalState::SUCCEEDED, other_client.getState().state_);
+}
+
+TEST_F(MultiGripperActionControllerTest, GoalsOfOtherGrippersContinue)
+{
+  follow_commands_ = false;
+  coordinated_client_.sendGoal(coordinatedGoal("right", 0.06));
+  ASSERT_TRUE(updateUntil([this] {return right_.cmd == 0.06;}));
+
+  left_client_.sendGoal(gripperGoal(0.02));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.02;}));
+  EXPECT_FALSE(coordinated_client_.getState().isDone());
+
+  follow_commands_ = true;
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::SUCCEEDED, coordinated_client_.getState().state_);
+  ASSERT_TRUE(updateUntilDone(left_client_));
+  EXPECT_EQ(SimpleClientGoalState::SUCCEEDED, left_client_.getState().state_);
+}
+
+TEST_F(MultiGripperActionControllerTest, CancelCoordinatedGoalHoldsAllGrippers)
+{
+  follow_commands_ = false;
+  coordinated_client_.sendGoal(coordinatedGoal(0.04, 0.06));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.04;}));
+
+  // Both grippers hold the position they were canceled at, from the same cycle on
+  left_.pos = 0.01;
+  right_.pos = 0.03;
+  coordinated_client_.cancelGoal();
+  ASSERT_TRUE(updateUntil([this]
+  {
+    EXPECT_EQ(left_.cmd == 0.01, right_.cmd == 0.03);
+    return left_.cmd == 0.01;
+  }));
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::PREEMPTED, coordinated_client_.getState().state_);
+}
+
+TEST_F(MultiGripperActionControllerTest, RestartHoldsPosition)
+{
+  follow_commands_ = false;
+  coordinated_client_.sendGoal(coordinatedGoal(0.04, 0.06));
+  ASSERT_TRUE(updateUntil([this] {return left_.cmd == 0.04;}));
+
+  // Stopping the controller cancels the goal, its commands are not applied again once restarted
+  ASSERT_TRUE(controller_.stopRequest(time_));
+  ASSERT_TRUE(coordinated_client_.waitForResult(ros::Duration(5.0)));
+  EXPECT_EQ(SimpleClientGoalState::PREEMPTED, coordinated_client_.getState().state_);
+
+  left_.pos = 0.01;
+  right_.pos = 0.03;
+  ASSERT_TRUE(controller_.startRequest(time_));
+  for (int i = 0; i < 10; ++i)
+  {
+    update();
+  }
+  EXPECT_EQ(0.01, left_.cmd);
+  EXPECT_EQ(0.03, right_.cmd);
+}
+
+TEST_F(MultiGripperActionControllerTest, RejectInvalidCoordinatedGoals)
+{
+  MultiGripperCommandGoal mismatch = coordinatedGoal(0.04, 0.06);
+  mismatch.commands.pop_back();
+  coordinated_client_.sendGoal(mismatch);
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::REJECTED, coordinated_client_.getState().state_);
+
+  coordinated_client_.sendGoal(coordinatedGoal("middle", 0.04));
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::REJECTED, coordinated_client_.getState().state_);
+
+  MultiGripperCommandGoal twice = coordinatedGoal(0.04, 0.06);
+  twice.grippers[1] = "left";
+  coordinated_client_.sendGoal(twice);
+  ASSERT_TRUE(updateUntilDone(coordinated_client_));
+  EXPECT_EQ(SimpleClientGoalState::REJECTED, coordinated_client_.getState().state_);
+
+  EXPECT_EQ(0.0, left_.cmd);
+  EXPECT_EQ(0.0, right_.cmd);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "multi_gripper_action_controller_test");
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+  int ret = RUN_ALL_TESTS();
+  spinner.stop();
+  ros::shutdown();
+  return ret;
+}
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <gripper_action_controller/hardware_interface_adapter.h>
+#include <gripper_action_controller/pos_vel_eff_command_interface.h>
+
+using gripper_action_controller::PosVelEffJointHandle;
+using gripper_action_controller::PosVelEffJointInterface;
+
+namespace
+{
+
+/** Joint of a PosVelEffJointInterface, with the storage of its state and commands. */
+struct PosVelEffJoint
+{
+  PosVelEffJoint() : pos(0.0), vel(0.0), eff(0.0), cmd_pos(0.0), cmd_vel(0.0), cmd_eff(0.0)
+  {
+    interface.registerHandle(PosVelEffJointHandle(hardware_interface::JointStateHandle("finger", &pos, &vel, &eff),
+                                                  &cmd_pos, &cmd_vel, &cmd_eff));
+    handle = interface.getHandle("finger");
+  }
+
+  double pos, vel, eff;
+  double cmd_pos, cmd_vel, cmd_eff;
+  PosVelEffJointInterface interface;
+  PosVelEffJointHandle handle;
+};
+
+} // namespace
+
+TEST(PosVelEffAdapterTest, NullCommand)
+{
+  double pos = 0.0, vel = 0.0, eff = 0.0, cmd = 0.0;
+  const hardware_interface::JointStateHandle state("finger", &pos, &vel, &eff);
+  EXPECT_THROW(PosVelEffJointHandle(state, nullptr, &cmd, &cmd), hardware_interface::HardwareInterfaceException);
+  EXPECT_THROW(PosVelEffJointHandle(state, &cmd, nullptr, &cmd), hardware_interface::HardwareInterfaceException);
+  EXPECT_THROW(PosVelEffJointHandle(state, &cmd, &cmd, nullptr), hardware_interface::HardwareInterfaceException);
+}
+
+TEST(PosVelEffAdapterTest, HandleSetCommand)
+{
+  PosVelEffJoint joint;
+  joint.handle.setCommand(0.04, 0.1, 5.0);
+  EXPECT_EQ(0.04, joint.cmd_pos);
+  EXPECT_EQ(0.1,  joint.cmd_vel);
+  EXPECT_EQ(5.0,  joint.cmd_eff);
+  EXPECT_EQ(0.04, joint.handle.getCommandPosition());
+  EXPECT_EQ(0.1,  joint.handle.getCommandVelocity());
+  EXPECT_EQ(5.0,  joint.handle.getCommandEffort());
+}
+
+TEST(PosVelEffAdapterTest, UpdateCommand)
+{
+  PosVelEffJoint joint;
+  ros::NodeHandle nh("gripper_controller");
+  HardwareInterfaceAdapter<PosVelEffJointInterface> adapter;
+  ASSERT_TRUE(adapter.init(joint.handle, nh));
+  adapter.starting(ros::Time(1.0));
+
+  // Position, velocity and maximum effort are written by the same update, whatever the errors
+  const ros::Duration period(0.01);
+  EXPECT_EQ(20.0, adapter.updateCommand(ros::Time(1.0), period, 0.05, 0.1, 0.03, -0.2, 20.0));
+  EXPECT_EQ(0.05, joint.cmd_pos);
+  EXPECT_EQ(0.1,  joint.cmd_vel);
+  EXPECT_EQ(20.0, joint.cmd_eff);
+
+  // The maximum effort is an absolute value
+  EXPECT_EQ(15.0, adapter.updateCommand(ros::Time(1.01), period, -0.02, -0.3, 0.0, 0.0, -15.0));
+  EXPECT_EQ(-0.02, joint.cmd_pos);
+  EXPECT_EQ(-0.3,  joint.cmd_vel);
+  EXPECT_EQ(15.0,  joint.cmd_eff);
+}
+
+TEST(PosVelEffAdapterTest, UpdateWithoutInit)
+{
+  PosVelEffJoint joint;
+  joint.handle.setCommand(0.04, 0.1, 5.0);
+
+  HardwareInterfaceAdapter<PosVelEffJointInterface> adapter;
+  EXPECT_EQ(0.0, adapter.updateCommand(ros::Time(1.0), ros::Duration(0.01), 0.05, 0.1, 0.0, 0.0, 20.0));
+  EXPECT_EQ(0.04, joint.cmd_pos);
+  EXPECT_EQ(0.1,  joint.cmd_vel);
+  EXPECT_EQ(5.0,  joint.cmd_eff);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "pos_vel_eff_adapter_test");
+
+  int ret = RUN_ALL_TESTS();
+  ros::shutdown();
+  return ret;
+}
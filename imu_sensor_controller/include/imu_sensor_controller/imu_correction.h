@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef IMU_SENSOR_CONTROLLER_IMU_CORRECTION_H
+#define IMU_SENSOR_CONTROLLER_IMU_CORRECTION_H
+
+#include <array>
+#include <cmath>
+
+namespace imu_sensor_controller
+{
+
+/**
+ * \brief Fixed mount rotation and gyro bias correction of IMU readings.
+ *
+ * Readings are re-expressed from the sensor frame into a mount frame, in which the sensor frame has orientation
+ * \p q given to setMountRotation(). The rotation matrix and the inverse quaternion are computed once, so correcting a
+ * reading is a handful of multiply-adds. Orientations keep their reference frame: only the rotated frame changes.
+ *
+ * Quaternions are ordered x, y, z, w like in hardware_interface::ImuSensorHandle.
+ * A default constructed correction passes readings through unchanged.
+ */
+class ImuCorrection
+{
+public:
+  ImuCorrection() : rotated_(false)
+  {
+    setMountRotation(0.0, 0.0, 0.0, 1.0);
+    gyro_bias_.fill(0.0);
+  }
+
+  /**
+   * \brief Set the orientation of the sensor frame in the mount frame
+   * \return false, leaving the correction unchanged, if the quaternion has zero norm
+   */
+  bool setMountRotation(double x, double y, double z, double w)
+  {
+    const double norm = std::sqrt(x * x + y * y + z * z + w * w);
+    if (!(norm > 0.0))
+      return false;
+    x /= norm; y /= norm; z /= norm; w /= norm;
+
+    // Rotation matrix, and inverse (conjugate) quaternion applied on the right of orientations
+    rotation_ = {{1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - z * w),       2.0 * (x * z + y * w),
+                  2.0 * (x * y + z * w),       1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - x * w),
+                  2.0 * (x * z - y * w),       2.0 * (y * z + x * w),       1.0 - 2.0 * (x * x + y * y)}};
+    inverse_mount_ = {{-x, -y, -z, w}};
+    rotated_ = !(x == 0.0 && y == 0.0 && z == 0.0);
+    return true;
+  }
+
+  /// Set the angular velocity read by the gyro at rest, in the sensor frame [rad/s].
+  void setGyroBias(double x, double y, double z) { gyro_bias_ = {{x, y, z}}; }
+
+  /// Whether readings are rotated, i.e. the mount rotation is not the identity.
+  bool rotated() const { return rotated_; }
+
+  /// Re-express an orientation of the sensor frame as the orientation of the mount frame.
+  void correctOrientation(const double* in, double* out) const
+  {
+    if (!rotated_)
+    {
+      for (unsigned i = 0; i < 4; ++i) out[i] = in[i];
+      return;
+    }
+
+    // out = in * inverse_mount
+    const std::array<double, 4>& q = inverse_mount_;
+    out[0] = in[3] * q[0] + in[0] * q[3] + in[1] * q[2] - in[2] * q[1];
+    out[1] = in[3] * q[1] - in[0] * q[2] + in[1] * q[3] + in[2] * q[0];
+    out[2] = in[3] * q[2] + in[0] * q[1] - in[1] * q[0] + in[2] * q[3];
+    out[3] = in[3] * q[3] - in[0] * q[0] - in[1] * q[1] - in[2] * q[2];
+  }
+
+  /// Remove the gyro bias from an angular velocity, and rotate it into the mount frame.
+  void correctAngularVelocity(const double* in, double* out) const
+  {
+    const double unbiased[3] = {in[0] - gyro_bias_[0], in[1] - gyro_bias_[1], in[2] - gyro_bias_[2]};
+    rotate(unbiased, out);
+  }
+
+  /// Rotate a linear acceleration into the mount frame.
+  void correctLinearAcceleration(const double* in, double* out) const { rotate(in, out); }
+
+  /// Rotate a row-major 3x3 covariance into the mount frame: out = R in R^T.
+  void correctCovariance(const double* in, double* out) const
+  {
+    if (!rotated_)
+    {
+      for (unsigned i = 0; i < 9; ++i) out[i] = in[i];
+      return;
+    }
+
+    double tmp[9]; // R in
+    for (unsigned i = 0; i < 3; ++i)
+      for (unsigned j = 0; j < 3; ++j)
+        tmp[3 * i + j] = rotation_[3 * i] * in[j] + rotation_[3 * i + 1] * in[3 + j] + rotation_[3 * i + 2] * in[6 + j];
+    for (unsigned i = 0; i < 3; ++i)
+      for (unsigned j = 0; j < 3; ++j)
+        out[3 * i + j] = tmp[3 * i] * rotation_[3 * j] + tmp[3 * i + 1] * rotation_[3 * j + 1]
+                       + tmp[3 * i + 2] * rotation_[3 * j + 2];
+  }
+
+private:
+  void rotate(const double* in, double* out) const
+  {
+    if (!rotated_)
+    {
+      for (unsigned i = 0; i < 3; ++i) out[i] = in[i];
+      return;
+    }
+    for (unsigned i = 0; i < 3; ++i)
+      out[i] = rotation_[3 * i] * in[0] + rotation_[3 * i + 1] * in[1] + rotation_[3 * i + 2] * in[2];
+  }
+
+  bool rotated_;
+  std::array<double, 9> rotation_;      ///< Mount rotation matrix, row-major
+  std::array<double, 4> inverse_mount_; ///< Inverse of the mount rotation
+  std::array<double, 3> gyro_bias_;     ///< Subtracted from the angular velocity before rotating it
+};
+
+}
+
+#endif
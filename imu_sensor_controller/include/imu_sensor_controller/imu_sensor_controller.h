@@ -31,8 +31,13 @@
 #ifndef IMU_SENSOR_CONTROLLER_IMU_SENSOR_CONTROLLER_H
 #define IMU_SENSOR_CONTROLLER_IMU_SENSOR_CONTROLLER_H
 
+#include <controller_instrumentation/publish_schedule.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
 #include <controller_interface/controller.h>
 #include <hardware_interface/imu_sensor_interface.h>
+#include <imu_sensor_controller/ImuArray.h>
+#include <imu_sensor_controller/imu_correction.h>
 #include <pluginlib/class_list_macros.hpp>
 #include <sensor_msgs/Imu.h>
 #include <realtime_tools/realtime_publisher.h>
@@ -44,7 +49,8 @@ namespace imu_sensor_controller
 class ImuSensorController: public controller_interface::Controller<hardware_interface::ImuSensorInterface>
 {
 public:
-  ImuSensorController(){}
+  ImuSensorController()
+    : publish_rate_(0.0), batched_(false), buffer_size_(0), buffer_head_(0), buffer_count_(0), dropped_samples_(0) {}
 
   virtual bool init(hardware_interface::ImuSensorInterface* hw, ros::NodeHandle &root_nh, ros::NodeHandle& controller_nh);
   virtual void starting(const ros::Time& time);
@@ -53,10 +59,44 @@ public:
 
 private:
   std::vector<hardware_interface::ImuSensorHandle> sensors_;
+  std::vector<ImuCorrection> corrections_;  ///< Mount rotation and gyro bias of each sensor
+  std::vector<std::string> frame_ids_;      ///< Frame of the corrected readings of each sensor
   typedef std::shared_ptr<realtime_tools::RealtimePublisher<sensor_msgs::Imu> > RtPublisherPtr;
+  typedef std::shared_ptr<realtime_tools::RealtimePublisher<ImuArray> > RtBatchPublisherPtr;
   std::vector<RtPublisherPtr> realtime_pubs_;
-  std::vector<ros::Time> last_publish_times_;
+  std::vector<controller_instrumentation::PublishSchedule> publish_schedules_;
+  RtBatchPublisherPtr batch_pub_;    ///< Publisher of all sensors in one message, only set in batched mode
+  controller_instrumentation::PublishSchedule batch_schedule_;
   double publish_rate_;
+  bool batched_;
+
+  // Sample buffering, only used in batched mode
+  std::vector<sensor_msgs::Imu> sample_buffer_; ///< Ring of buffer_size_ cycles, each holding one reading per sensor
+  std::vector<sensor_msgs::Imu> spare_imus_;    ///< Initialized readings of the batched message beyond its size
+  unsigned buffer_size_;                        ///< Capacity of the ring in cycles, zero disables buffering
+  unsigned buffer_head_;                        ///< Oldest buffered cycle
+  unsigned buffer_count_;                       ///< Number of buffered cycles
+  unsigned long dropped_samples_;               ///< Cycles overwritten before they could be published
+
+  /// Store the current reading of all sensors in the sample ring, overwriting the oldest cycle when full.
+  void bufferSamples(const ros::Time& time);
+
+  /// Move all buffered readings to the batched message. The publisher must be locked.
+  void flushSamples();
+
+  /// Resize the batched message to \p size readings, by moving initialized readings from or to spare_imus_.
+  void resizeBatch(unsigned size);
+
+  /// Read the mount rotation, gyro bias and frame id of sensor \p i from the \p controller_nh/<sensor name> namespace.
+  bool initCorrection(ros::NodeHandle& controller_nh, unsigned i);
+
+  /// Fill the fields of \p msg that do not change between cycles: frame id and covariances.
+  void initMessage(unsigned i, sensor_msgs::Imu& msg) const;
+
+  /// Copy the current corrected orientation, angular velocity and linear acceleration of sensor \p i into \p msg.
+  void updateMessage(unsigned i, sensor_msgs::Imu& msg) const;
+
+  controller_instrumentation::RealtimeAudit rt_audit_; ///< Audit of realtime-unsafe operations in update()
 };
 
 }
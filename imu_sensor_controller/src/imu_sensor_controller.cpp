@@ -29,15 +29,50 @@
 /// \author: Adolfo Rodriguez Tsouroukdissian
 
 
+#include <utility>
+
 #include "imu_sensor_controller/imu_sensor_controller.h"
 
+#include <controller_instrumentation/tracepoints.h>
+
 
 
 namespace imu_sensor_controller
 {
 
+  namespace
+  {
+    // Fill the covariance matrix of one measurement following the sensor_msgs/Imu conventions:
+    // zero if the measurement is available but its covariance is unknown, -1 in the first
+    // element if the measurement is not available at all.
+    // The covariance is rotated into the mount frame of the correction.
+    template <class Covariance>
+    void initCovariance(const double* data, const double* covariance, const ImuCorrection& correction,
+                        Covariance& msg_covariance)
+    {
+      if (covariance)
+      {
+        correction.correctCovariance(covariance, msg_covariance.data());
+      }
+      else
+      {
+        for (unsigned j=0; j<msg_covariance.size(); ++j){
+          msg_covariance[j] = 0.0;
+        }
+        if (!data)
+        {
+          msg_covariance[0] = -1.0;
+        }
+      }
+    }
+  }
+
   bool ImuSensorController::init(hardware_interface::ImuSensorInterface* hw, ros::NodeHandle &root_nh, ros::NodeHandle& controller_nh)
   {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh);
+    if (!thread_placement_scope) {return false;}
+
     // get all joint states from the hardware interface
     const std::vector<std::string>& sensor_names = hw->getNames();
     for (unsigned i=0; i<sensor_names.size(); i++)
@@ -49,146 +84,284 @@ namespace imu_sensor_controller
       return false;
     }
 
+    // spread publish cycles across sensors and controllers
+    bool stagger_publish = false;
+    controller_nh.param("stagger_publish", stagger_publish, stagger_publish);
+
+    // publish all sensors in a single message
+    controller_nh.param("batched", batched_, false);
+
+    // keep every reading between publishes
+    int buffer_size = 0;
+    controller_nh.param("buffer_size", buffer_size, 0);
+    if (buffer_size < 0){
+      ROS_ERROR("Parameter 'buffer_size' must not be negative");
+      return false;
+    }
+    if (buffer_size > 0 && !batched_){
+      ROS_ERROR("Parameter 'buffer_size' requires 'batched' to be enabled");
+      return false;
+    }
+    buffer_size_ = buffer_size;
+
     for (unsigned i=0; i<sensor_names.size(); i++){
       // sensor handle
       sensors_.push_back(hw->getHandle(sensor_names[i]));
 
+      // mount rotation and gyro bias
+      if (!initCorrection(controller_nh, i)){
+        return false;
+      }
+
       // realtime publisher
-      RtPublisherPtr rt_pub(new realtime_tools::RealtimePublisher<sensor_msgs::Imu>(root_nh, sensor_names[i], 4));
-      realtime_pubs_.push_back(rt_pub);
+      if (!batched_){
+        RtPublisherPtr rt_pub(new realtime_tools::RealtimePublisher<sensor_msgs::Imu>(root_nh, sensor_names[i], 4));
+        rt_pub->lock();
+        initMessage(i, rt_pub->msg_);
+        rt_pub->unlock();
+        realtime_pubs_.push_back(rt_pub);
+        publish_schedules_.push_back(controller_instrumentation::PublishSchedule());
+        publish_schedules_.back().init(publish_rate_, stagger_publish);
+      }
     }
 
-    // Last published times
-    last_publish_times_.resize(sensor_names.size());
+    if (batched_){
+      batch_pub_.reset(new realtime_tools::RealtimePublisher<ImuArray>(root_nh, "imu_states", 4));
+      batch_pub_->lock();
+      if (buffer_size_ > 0){
+        // Readings are copied from the ring at publish time. The readings of a full ring are initialized here, with
+        // the frame ids of their sensors, and set aside until needed, so that publishing never allocates
+        const unsigned ring_size = buffer_size_ * sensors_.size();
+        sample_buffer_.resize(ring_size);
+        batch_pub_->msg_.imus.resize(ring_size);
+        for (unsigned i=0; i<ring_size; i++){
+          initMessage(i % sensors_.size(), sample_buffer_[i]);
+          initMessage(i % sensors_.size(), batch_pub_->msg_.imus[i]);
+        }
+        spare_imus_.reserve(ring_size);
+        resizeBatch(0);
+      }
+      else{
+        batch_pub_->msg_.imus.resize(sensors_.size());
+        for (unsigned i=0; i<sensors_.size(); i++){
+          initMessage(i, batch_pub_->msg_.imus[i]);
+        }
+      }
+      batch_pub_->unlock();
+      batch_schedule_.init(publish_rate_, stagger_publish);
+    }
+
+    rt_audit_.init(controller_nh);
     return true;
   }
 
   void ImuSensorController::starting(const ros::Time& time)
   {
     // initialize time
-    for (unsigned i=0; i<last_publish_times_.size(); i++){
-      last_publish_times_[i] = time;
+    for (controller_instrumentation::PublishSchedule& schedule : publish_schedules_){
+      schedule.reset(time);
     }
+    batch_schedule_.reset(time);
+
+    // discard readings of a previous run
+    buffer_head_ = 0;
+    buffer_count_ = 0;
   }
 
   void ImuSensorController::update(const ros::Time& time, const ros::Duration& /*period*/)
   {
-    using namespace hardware_interface;
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+    if (publish_rate_ <= 0.0){
+      return;
+    }
+
+    if (batched_){
+      if (buffer_size_ > 0){
+        bufferSamples(time);
+      }
+
+      // limit rate of publishing. With buffering, readings stay in the ring when the publisher is busy
+      if (batch_schedule_.due(time) && controller_instrumentation::tracedTrylock(*batch_pub_, "imu_states")){
+        // we're actually publishing, so increment time
+        batch_schedule_.advance();
+
+        // populate message
+        batch_pub_->msg_.header.stamp = time;
+        if (buffer_size_ > 0){
+          flushSamples();
+        }
+        else{
+          for (unsigned i=0; i<sensors_.size(); i++){
+            batch_pub_->msg_.imus[i].header.stamp = time;
+            updateMessage(i, batch_pub_->msg_.imus[i]);
+          }
+        }
+        batch_pub_->unlockAndPublish();
+      }
+      return;
+    }
 
     // limit rate of publishing
     for (unsigned i=0; i<realtime_pubs_.size(); i++){
-      if (publish_rate_ > 0.0 && last_publish_times_[i] + ros::Duration(1.0/publish_rate_) < time){
+      if (publish_schedules_[i].due(time)){
         // try to publish
-        if (realtime_pubs_[i]->trylock()){
+        if (controller_instrumentation::tracedTrylock(*realtime_pubs_[i], "imu")){
           // we're actually publishing, so increment time
-          last_publish_times_[i] = last_publish_times_[i] + ros::Duration(1.0/publish_rate_);
+          publish_schedules_[i].advance();
 
           // populate message
           realtime_pubs_[i]->msg_.header.stamp = time;
-          realtime_pubs_[i]->msg_.header.frame_id = sensors_[i].getFrameId();
-
-          // Orientation
-          if (sensors_[i].getOrientation())
-          {
-            realtime_pubs_[i]->msg_.orientation.x = sensors_[i].getOrientation()[0];
-            realtime_pubs_[i]->msg_.orientation.y = sensors_[i].getOrientation()[1];
-            realtime_pubs_[i]->msg_.orientation.z = sensors_[i].getOrientation()[2];
-            realtime_pubs_[i]->msg_.orientation.w = sensors_[i].getOrientation()[3];
-          }
+          updateMessage(i, realtime_pubs_[i]->msg_);
+          realtime_pubs_[i]->unlockAndPublish();
+        }
+      }
+    }
+  }
 
-          // Orientation covariance
-          if (sensors_[i].getOrientationCovariance())
-          {
-            for (unsigned j=0; j<realtime_pubs_[i]->msg_.orientation_covariance.size(); ++j){
-              realtime_pubs_[i]->msg_.orientation_covariance[j] = sensors_[i].getOrientationCovariance()[j];
-            }
-          }
-          else
-          {
-            if (sensors_[i].getOrientation())
-            {
-              // Orientation available
-              for (unsigned j=0; j<realtime_pubs_[i]->msg_.orientation_covariance.size(); ++j){
-                realtime_pubs_[i]->msg_.orientation_covariance[j] = 0.0;
-              }
-            }
-            else
-            {
-              // No orientation available
-              realtime_pubs_[i]->msg_.orientation_covariance[0] = -1.0;
-            }
-          }
+  void ImuSensorController::stopping(const ros::Time& /*time*/)
+  {}
 
-          // Angular velocity
-          if (sensors_[i].getAngularVelocity())
-          {
-            realtime_pubs_[i]->msg_.angular_velocity.x = sensors_[i].getAngularVelocity()[0];
-            realtime_pubs_[i]->msg_.angular_velocity.y = sensors_[i].getAngularVelocity()[1];
-            realtime_pubs_[i]->msg_.angular_velocity.z = sensors_[i].getAngularVelocity()[2];
-          }
+  void ImuSensorController::bufferSamples(const ros::Time& time)
+  {
+    if (buffer_count_ == buffer_size_){
+      // ring full, drop the oldest cycle
+      buffer_head_ = (buffer_head_ + 1) % buffer_size_;
+      --buffer_count_;
+      ++dropped_samples_;
+      ROS_WARN_THROTTLE(1.0, "IMU sample buffer full, %lu cycles dropped so far. "
+                        "Increase 'buffer_size' or 'publish_rate'", dropped_samples_);
+    }
 
-          // Angular velocity covariance
-          if (sensors_[i].getAngularVelocityCovariance())
-          {
-            for (unsigned j=0; j<realtime_pubs_[i]->msg_.angular_velocity_covariance.size(); ++j){
-              realtime_pubs_[i]->msg_.angular_velocity_covariance[j] = sensors_[i].getAngularVelocityCovariance()[j];
-            }
-          }
-          else
-          {
-            if (sensors_[i].getAngularVelocity())
-            {
-              // Angular velocity available
-              for (unsigned j=0; j<realtime_pubs_[i]->msg_.angular_velocity_covariance.size(); ++j){
-                realtime_pubs_[i]->msg_.angular_velocity_covariance[j] = 0.0;
-              }
-            }
-            else
-            {
-              // No angular velocity available
-              realtime_pubs_[i]->msg_.angular_velocity_covariance[0] = -1.0;
-            }
-          }
+    const unsigned cycle = (buffer_head_ + buffer_count_) % buffer_size_;
+    for (unsigned i=0; i<sensors_.size(); i++){
+      sensor_msgs::Imu& sample = sample_buffer_[cycle * sensors_.size() + i];
+      sample.header.stamp = time;
+      updateMessage(i, sample);
+    }
+    ++buffer_count_;
+  }
 
-          // Linear acceleration
-          if (sensors_[i].getLinearAcceleration())
-          {
-            realtime_pubs_[i]->msg_.linear_acceleration.x = sensors_[i].getLinearAcceleration()[0];
-            realtime_pubs_[i]->msg_.linear_acceleration.y = sensors_[i].getLinearAcceleration()[1];
-            realtime_pubs_[i]->msg_.linear_acceleration.z = sensors_[i].getLinearAcceleration()[2];
-          }
+  void ImuSensorController::flushSamples()
+  {
+    // Oldest cycle first, one reading per sensor in each cycle. Frame ids and covariances were set at init()
+    resizeBatch(buffer_count_ * sensors_.size());
+    std::vector<sensor_msgs::Imu>& imus = batch_pub_->msg_.imus;
+    for (unsigned c=0; c<buffer_count_; c++){
+      const unsigned cycle = (buffer_head_ + c) % buffer_size_;
+      for (unsigned i=0; i<sensors_.size(); i++){
+        const sensor_msgs::Imu& sample = sample_buffer_[cycle * sensors_.size() + i];
+        sensor_msgs::Imu& imu = imus[c * sensors_.size() + i];
+        imu.header.stamp = sample.header.stamp;
+        imu.orientation = sample.orientation;
+        imu.angular_velocity = sample.angular_velocity;
+        imu.linear_acceleration = sample.linear_acceleration;
+      }
+    }
+    buffer_head_ = 0;
+    buffer_count_ = 0;
+  }
 
-          // Linear acceleration covariance
-          if (sensors_[i].getLinearAccelerationCovariance())
-          {
-            for (unsigned j=0; j<realtime_pubs_[i]->msg_.linear_acceleration_covariance.size(); ++j){
-              realtime_pubs_[i]->msg_.linear_acceleration_covariance[j] = sensors_[i].getLinearAccelerationCovariance()[j];
-            }
-          }
-          else
-          {
-            if (sensors_[i].getLinearAcceleration())
-            {
-              // Linear acceleration available
-              for (unsigned j=0; j<realtime_pubs_[i]->msg_.linear_acceleration_covariance.size(); ++j){
-                realtime_pubs_[i]->msg_.linear_acceleration_covariance[j] = 0.0;
-              }
-            }
-            else
-            {
-              // No linear acceleration available
-              realtime_pubs_[i]->msg_.linear_acceleration_covariance[0] = -1.0;
-            }
-          }
-          
-          realtime_pubs_[i]->unlockAndPublish();
-        }
+  void ImuSensorController::resizeBatch(unsigned size)
+  {
+    // Readings are moved as a stack, so reading k of the message always belongs to sensor k % sensors_.size().
+    // Moving them neither allocates nor frees their frame ids, and both vectors have the capacity of a full ring
+    std::vector<sensor_msgs::Imu>& imus = batch_pub_->msg_.imus;
+    while (imus.size() > size){
+      spare_imus_.push_back(std::move(imus.back()));
+      imus.pop_back();
+    }
+    while (imus.size() < size && !spare_imus_.empty()){
+      imus.push_back(std::move(spare_imus_.back()));
+      spare_imus_.pop_back();
+    }
+  }
+
+  bool ImuSensorController::initCorrection(ros::NodeHandle& controller_nh, unsigned i)
+  {
+    const hardware_interface::ImuSensorHandle& sensor = sensors_[i];
+    ros::NodeHandle sensor_nh(controller_nh, sensor.getName());
+    corrections_.push_back(ImuCorrection());
+    ImuCorrection& correction = corrections_.back();
+
+    // orientation of the sensor frame in the published frame, as a quaternion [x, y, z, w]
+    std::vector<double> mount_rotation;
+    if (sensor_nh.getParam("mount_rotation", mount_rotation)){
+      if (mount_rotation.size() != 4 ||
+          !correction.setMountRotation(mount_rotation[0], mount_rotation[1], mount_rotation[2], mount_rotation[3])){
+        ROS_ERROR_STREAM("Parameter '" << sensor_nh.getNamespace()
+                         << "/mount_rotation' must be a non-zero quaternion [x, y, z, w]");
+        return false;
+      }
+    }
+
+    // static gyro bias in the sensor frame [rad/s]
+    std::vector<double> gyro_bias;
+    if (sensor_nh.getParam("gyro_bias", gyro_bias)){
+      if (gyro_bias.size() != 3){
+        ROS_ERROR_STREAM("Parameter '" << sensor_nh.getNamespace() << "/gyro_bias' must have 3 elements");
+        return false;
       }
+      correction.setGyroBias(gyro_bias[0], gyro_bias[1], gyro_bias[2]);
+    }
+
+    // readings re-expressed in another frame can't be published in the sensor frame
+    std::string frame_id = sensor.getFrameId();
+    if (!sensor_nh.getParam("frame_id", frame_id) && correction.rotated()){
+      ROS_ERROR_STREAM("Parameter '" << sensor_nh.getNamespace() << "/frame_id' must be set with a mount rotation");
+      return false;
     }
+    frame_ids_.push_back(frame_id);
+    return true;
   }
 
-  void ImuSensorController::stopping(const ros::Time& /*time*/)
-  {}
+  void ImuSensorController::initMessage(unsigned i, sensor_msgs::Imu& msg) const
+  {
+    const hardware_interface::ImuSensorHandle& sensor = sensors_[i];
+    const ImuCorrection& correction = corrections_[i];
+    msg.header.frame_id = frame_ids_[i];
+
+    initCovariance(sensor.getOrientation(), sensor.getOrientationCovariance(), correction, msg.orientation_covariance);
+    initCovariance(sensor.getAngularVelocity(), sensor.getAngularVelocityCovariance(), correction,
+                   msg.angular_velocity_covariance);
+    initCovariance(sensor.getLinearAcceleration(), sensor.getLinearAccelerationCovariance(), correction,
+                   msg.linear_acceleration_covariance);
+  }
+
+  void ImuSensorController::updateMessage(unsigned i, sensor_msgs::Imu& msg) const
+  {
+    const hardware_interface::ImuSensorHandle& sensor = sensors_[i];
+    const ImuCorrection& correction = corrections_[i];
+    double corrected[4];
+
+    // Orientation
+    if (sensor.getOrientation())
+    {
+      correction.correctOrientation(sensor.getOrientation(), corrected);
+      msg.orientation.x = corrected[0];
+      msg.orientation.y = corrected[1];
+      msg.orientation.z = corrected[2];
+      msg.orientation.w = corrected[3];
+    }
+
+    // Angular velocity
+    if (sensor.getAngularVelocity())
+    {
+      correction.correctAngularVelocity(sensor.getAngularVelocity(), corrected);
+      msg.angular_velocity.x = corrected[0];
+      msg.angular_velocity.y = corrected[1];
+      msg.angular_velocity.z = corrected[2];
+    }
+
+    // Linear acceleration
+    if (sensor.getLinearAcceleration())
+    {
+      correction.correctLinearAcceleration(sensor.getLinearAcceleration(), corrected);
+      msg.linear_acceleration.x = corrected[0];
+      msg.linear_acceleration.y = corrected[1];
+      msg.linear_acceleration.z = corrected[2];
+    }
+  }
 
 }
 
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <imu_sensor_controller/imu_correction.h>
+
+using imu_sensor_controller::ImuCorrection;
+
+namespace
+{
+const double EPS = 1e-9;
+
+// Sensor mounted rotated by 90 degrees about z: its x axis is the y axis of the mount frame
+void setYaw90(ImuCorrection& correction)
+{
+  ASSERT_TRUE(correction.setMountRotation(0.0, 0.0, std::sin(M_PI / 4.0), std::cos(M_PI / 4.0)));
+}
+}
+
+TEST(ImuCorrectionTest, DefaultPassesThrough)
+{
+  const ImuCorrection correction;
+  EXPECT_FALSE(correction.rotated());
+
+  const double orientation[4] = {0.1, 0.2, 0.3, 0.9};
+  double out[4];
+  correction.correctOrientation(orientation, out);
+  for (unsigned i = 0; i < 4; ++i)
+    EXPECT_EQ(orientation[i], out[i]);
+
+  const double vector[3] = {1.0, -2.0, 3.0};
+  correction.correctAngularVelocity(vector, out);
+  for (unsigned i = 0; i < 3; ++i)
+    EXPECT_EQ(vector[i], out[i]);
+}
+
+TEST(ImuCorrectionTest, RotatesVectors)
+{
+  ImuCorrection correction;
+  setYaw90(correction);
+  EXPECT_TRUE(correction.rotated());
+
+  const double acceleration[3] = {1.0, 0.0, 9.81};
+  double out[3];
+  correction.correctLinearAcceleration(acceleration, out);
+  EXPECT_NEAR(0.0,  out[0], EPS);
+  EXPECT_NEAR(1.0,  out[1], EPS);
+  EXPECT_NEAR(9.81, out[2], EPS);
+}
+
+TEST(ImuCorrectionTest, RemovesGyroBiasBeforeRotating)
+{
+  ImuCorrection correction;
+  setYaw90(correction);
+  correction.setGyroBias(0.01, 0.02, 0.03);
+
+  const double angular_velocity[3] = {0.51, 0.02, -0.97};
+  double out[3];
+  correction.correctAngularVelocity(angular_velocity, out);
+  EXPECT_NEAR(0.0,  out[0], EPS);
+  EXPECT_NEAR(0.5,  out[1], EPS);
+  EXPECT_NEAR(-1.0, out[2], EPS);
+}
+
+TEST(ImuCorrectionTest, ReexpressesOrientation)
+{
+  ImuCorrection correction;
+  setYaw90(correction);
+
+  // A sensor reading its mount orientation means the mount frame is aligned with the reference frame
+  const double s = std::sin(M_PI / 4.0), c = std::cos(M_PI / 4.0);
+  const double orientation[4] = {0.0, 0.0, s, c};
+  double out[4];
+  correction.correctOrientation(orientation, out);
+  EXPECT_NEAR(0.0, out[0], EPS);
+  EXPECT_NEAR(0.0, out[1], EPS);
+  EXPECT_NEAR(0.0, out[2], EPS);
+  EXPECT_NEAR(1.0, std::fabs(out[3]), EPS);
+
+  // Sensor rolled by 90 degrees about its own x axis, i.e. about the y axis of the mount frame
+  const double rolled[4] = {c * s, s * s, s * c, c * c}; // yaw(90) * roll(90)
+  correction.correctOrientation(rolled, out);
+  EXPECT_NEAR(0.0, out[0], EPS);
+  EXPECT_NEAR(s,   out[1], EPS);
+  EXPECT_NEAR(0.0, out[2], EPS);
+  EXPECT_NEAR(c,   out[3], EPS);
+}
+
+TEST(ImuCorrectionTest, RotatesCovariance)
+{
+  ImuCorrection correction;
+  setYaw90(correction);
+
+  const double covariance[9] = {1.0, 0.0, 0.0,
+                                0.0, 2.0, 0.0,
+                                0.0, 0.0, 3.0};
+  double out[9];
+  correction.correctCovariance(covariance, out);
+  const double expected[9] = {2.0, 0.0, 0.0,
+                              0.0, 1.0, 0.0,
+                              0.0, 0.0, 3.0};
+  for (unsigned i = 0; i < 9; ++i)
+    EXPECT_NEAR(expected[i], out[i], EPS);
+}
+
+TEST(ImuCorrectionTest, RejectsZeroQuaternion)
+{
+  ImuCorrection correction;
+  setYaw90(correction);
+  EXPECT_FALSE(correction.setMountRotation(0.0, 0.0, 0.0, 0.0));
+  EXPECT_TRUE(correction.rotated());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_STATE_CONTROLLER_COMPACT_JOINT_STATE_H
+#define JOINT_STATE_CONTROLLER_COMPACT_JOINT_STATE_H
+
+#include <algorithm>
+
+#include <joint_state_controller/CompactJointState.h>
+#include <sensor_msgs/JointState.h>
+
+namespace joint_state_controller
+{
+
+/**
+ * \brief Copy the stamp and joint states of \p msg into \p compact, without the names.
+ * \note This function is realtime-safe if the arrays of \p compact already have the sizes of those of \p msg.
+ */
+inline void compactJointState(const sensor_msgs::JointState& msg, CompactJointState& compact)
+{
+  compact.header.stamp = msg.header.stamp;
+  compact.position.resize(msg.position.size());
+  compact.velocity.resize(msg.velocity.size());
+  compact.effort.resize(msg.effort.size());
+  std::copy(msg.position.begin(), msg.position.end(), compact.position.begin());
+  std::copy(msg.velocity.begin(), msg.velocity.end(), compact.velocity.begin());
+  std::copy(msg.effort.begin(),   msg.effort.end(),   compact.effort.begin());
+}
+
+/**
+ * \brief Rebuild the \c sensor_msgs/JointState of a compact message.
+ * \param names   Name table latched along the compact messages.
+ * \param compact Compact message.
+ * \param msg     Joint state message, with the frame id of \p names.
+ * \return false, leaving \p msg unchanged, if the arrays of \p compact don't have one element per name. Arrays may
+ * still be empty, like in \c sensor_msgs/JointState.
+ */
+inline bool expandJointState(const sensor_msgs::JointState& names, const CompactJointState& compact,
+                             sensor_msgs::JointState& msg)
+{
+  const auto matches = [&names](const std::vector<double>& values)
+  {
+    return values.empty() || values.size() == names.name.size();
+  };
+  if (!matches(compact.position) || !matches(compact.velocity) || !matches(compact.effort))
+    return false;
+
+  msg.header.seq      = compact.header.seq;
+  msg.header.stamp    = compact.header.stamp;
+  msg.header.frame_id = names.header.frame_id;
+  msg.name     = names.name;
+  msg.position = compact.position;
+  msg.velocity = compact.velocity;
+  msg.effort   = compact.effort;
+  return true;
+}
+
+} // namespace
+
+#endif
@@ -32,12 +32,24 @@
 #ifndef JOINT_STATE_CONTROLLER_JOINT_STATE_CONTROLLER_H
 #define JOINT_STATE_CONTROLLER_JOINT_STATE_CONTROLLER_H
 
+#include <atomic>
+#include <controller_instrumentation/publish_schedule.h>
+#include <controller_instrumentation/kinematic_filter.h>
+#include <controller_instrumentation/publisher_pool.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/spsc_queue.h>
+#include <controller_instrumentation/telemetry_ring.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_instrumentation/tracepoints.h>
 #include <controller_interface/controller.h>
 #include <hardware_interface/joint_state_interface.h>
+#include <joint_state_controller/compact_joint_state.h>
+#include <joint_state_controller/preserialized_joint_state.h>
 #include <memory>
 #include <pluginlib/class_list_macros.hpp>
 #include <realtime_tools/realtime_publisher.h>
 #include <sensor_msgs/JointState.h>
+#include <thread>
 
 namespace joint_state_controller
 {
@@ -75,25 +87,186 @@ namespace joint_state_controller
  * \endcode
  *
  * An unspecified position, velocity or acceleration defaults to zero.
+ *
+ * Joints needing different rates can also be published as groups, each on the \c joint_states/<name> topic at its own
+ * rate, in addition to the \c joint_states topic, which can be disabled with a non-positive \c publish_rate. The
+ * following is an example configuration of a fast arm group and a slow wheels one.
+ *
+ * \code
+ * joint_state_controller:
+ *   type: joint_state_controller/JointStateController
+ *   publish_rate: 0
+ *   joint_groups:
+ *     - name:         'arm'
+ *       publish_rate: 500
+ *       joints:       ['shoulder', 'elbow', 'wrist']
+ *
+ *     - name:         'wheels'
+ *       publish_rate: 10
+ *       joints:       ['left_wheel', 'right_wheel']
+ * \endcode
+ *
+ * To save bandwidth when most joints are static, the joint states can be published only when they change. Once a
+ * \c change_threshold is specified, a publish cycle is skipped unless a joint position, velocity or effort moved past
+ * its threshold since the last published message, quantities without a threshold being ignored. A message is still
+ * published at \c keep_alive_rate (1 Hz by default, zero to disable), so that subscribers can tell the controller is
+ * running. The following is an example configuration of change-driven publishing.
+ *
+ * \code
+ * joint_state_controller:
+ *   type: joint_state_controller/JointStateController
+ *   publish_rate: 50
+ *   change_threshold:
+ *     position: 0.001
+ *     velocity: 0.01
+ *   keep_alive_rate: 1
+ * \endcode
+ *
+ * With the \c publish_thread parameter set, the control loop no longer builds nor publishes the messages: it writes
+ * a snapshot of the joint states, packed by joint, into a preallocated lock-free queue on the publish cycles, and a
+ * dedicated thread publishes them. No joint state is then dropped because a publisher is busy.
+ *
+ * Each realtime publisher otherwise owns a thread. With many controllers loaded, setting \c publisher_pool has the
+ * messages published instead by the single thread of the \c controller_instrumentation::PublisherPool of the process.
+ *
+ * When several controllers or joint groups publish at the same rate, setting \c stagger_publish spreads their publish
+ * cycles over the publish period (see \c controller_instrumentation::PublishSchedule), instead of having them all
+ * publish in the same update cycle.
+ *
+ * For joints whose hardware reports no velocity, the published velocity can instead be estimated from the positions
+ * read at every update cycle, with a \c controller_instrumentation::KinematicFilter whose smoothing is that of a rolling
+ * mean over \c window_size cycles. Subscribers at a reduced rate then still get a well filtered velocity. The
+ * following is an example configuration estimating the velocity of two joints.
+ *
+ * \code
+ * joint_state_controller:
+ *   type: joint_state_controller/JointStateController
+ *   publish_rate: 50
+ *   velocity_estimation:
+ *     joints:      ['wrist1', 'wrist2']
+ *     window_size: 5
+ * \endcode
+ *
+ * Most of the bytes of a \c sensor_msgs/JointState of many joints are their names. Setting \c compact_output also
+ * publishes every message as a \c joint_state_controller/CompactJointState, which only holds the stamp and the joint
+ * states, on the \c joint_states_compact topic, and \c joint_states_compact/<name> for the joint groups. The names are
+ * published once on the latched \c names subtopic of each compact topic, from which subscribers can rebuild the
+ * \c sensor_msgs/JointState losslessly with \c expandJointState().
+ *
+ * The position, velocity and effort of the joints in the \c hardware_interface::JointStateInterface can additionally be
+ * recorded at every update cycle to a shared memory telemetry ring (see \c controller_instrumentation::TelemetryRingWriter)
+ * by setting the \c telemetry_ring_name parameter.
  */
 class JointStateController: public controller_interface::Controller<hardware_interface::JointStateInterface>
 {
 public:
-  JointStateController() : publish_rate_(0.0) {}
+  JointStateController() : change_driven_(false), compact_output_(false), publish_thread_(false), publisher_pool_(false),
+                            restart_pending_(false), dropped_snapshots_(0), keep_running_(false) {}
+  ~JointStateController();
 
   virtual bool init(hardware_interface::JointStateInterface* hw,
                     ros::NodeHandle&                         root_nh,
                     ros::NodeHandle&                         controller_nh);
   virtual void starting(const ros::Time& time);
-  virtual void update(const ros::Time& time, const ros::Duration& /*period*/);
+  virtual void update(const ros::Time& time, const ros::Duration& period);
   virtual void stopping(const ros::Time& /*time*/);
 
 private:
+  /// Joints published on a topic at their own rate:
+  struct JointGroup
+  {
+    JointGroup() : publish_rate(0.0), publish_cycle(false), state_published(false) {}
+
+    std::vector<unsigned int> joint_ids; ///< Indices in joint_state_ of the joints, in message order
+    std::shared_ptr<realtime_tools::RealtimePublisher<PreserializedJointState> > realtime_pub;
+    /// Used instead of realtime_pub with \c publisher_pool
+    std::shared_ptr<controller_instrumentation::PooledPublisher<PreserializedJointState> > pooled_pub;
+    ros::Publisher pub; ///< Used by the publisher thread instead of realtime_pub, along with msg
+    PreserializedJointState msg;
+    double publish_rate;
+    controller_instrumentation::PublishSchedule publish_schedule;
+    bool publish_cycle; ///< Whether the current cycle is to be published, in the snapshot of the publisher thread
+    ros::Time last_state_publish_time; ///< Time a message was last actually published
+    bool state_published; ///< Whether a message was published since starting
+
+    /// Compact output, published along msg with \c compact_output, by the same publisher kind
+    std::shared_ptr<realtime_tools::RealtimePublisher<CompactJointState> > compact_realtime_pub;
+    std::shared_ptr<controller_instrumentation::PooledPublisher<CompactJointState> > compact_pooled_pub;
+    ros::Publisher compact_pub;
+    CompactJointState compact_msg;
+    ros::Publisher names_pub; ///< Latched joint names of the compact output
+  };
+
   std::vector<hardware_interface::JointStateHandle> joint_state_;
-  std::shared_ptr<realtime_tools::RealtimePublisher<sensor_msgs::JointState> > realtime_pub_;
-  ros::Time last_publish_time_;
-  double publish_rate_;
+  std::vector<JointGroup> groups_; ///< All joints, extra joints included, on \c joint_states, then the joint groups
   unsigned int num_hw_joints_; ///< Number of joints present in the JointStateInterface, excluding extra joints
+  bool change_driven_; ///< Whether to only publish the joint states when they change, see \c change_threshold
+  double position_threshold_, velocity_threshold_, effort_threshold_; ///< Change thresholds, infinite if unset
+  ros::Duration keep_alive_period_; ///< Longest interval without a published message in change-driven mode, if not zero
+  bool compact_output_; ///< Whether to also publish the compact joint states, see \c compact_output
+
+  /// Velocity estimation from the positions, see \c velocity_estimation:
+  struct VelocityEstimator
+  {
+    unsigned int joint_id; ///< Index in joint_state_ of the joint
+    controller_instrumentation::KinematicFilter<double> filter;
+  };
+  std::vector<VelocityEstimator> velocity_estimators_;
+  std::vector<double> velocities_; ///< Published velocity of each joint, estimated or read, refreshed every update
+  controller_instrumentation::RealtimeAudit rt_audit_; ///< Audit of realtime-unsafe operations in update()
+  controller_instrumentation::TelemetryRingWriter telemetry_ring_; ///< Joint states of every update cycle, if enabled
+
+  /// Joint states of a publish cycle, queued for the publisher thread:
+  struct Snapshot
+  {
+    ros::Time stamp;
+    bool restart; ///< Whether the controller was restarted since the previous snapshot
+    std::vector<unsigned char> publish; ///< Whether each group is to be published
+    std::vector<double> states; ///< Position, velocity and effort of each joint, interleaved
+  };
+
+  bool publish_thread_; ///< Whether to publish from the publisher thread, see \c publish_thread
+  bool publisher_pool_; ///< Whether to publish from the publisher pool of the process, see \c publisher_pool
+  controller_instrumentation::SpscQueue<Snapshot> snapshots_;
+  bool restart_pending_;
+  std::atomic<std::size_t> dropped_snapshots_;
+  std::atomic<bool> keep_running_;
+  std::thread publisher_thread_;
+
+  template <class Publisher>
+  void publish(JointGroup& group, Publisher& publisher, const ros::Time& time);
+
+  /// Publish the joint states of \p msg on the compact output, if enabled, unless the publisher is busy:
+  template <class Publisher>
+  static void publishCompact(const std::shared_ptr<Publisher>& publisher, const sensor_msgs::JointState& msg);
+
+  void pushSnapshot(const ros::Time& time);
+
+  /// Publisher thread main loop:
+  void run();
+
+  /// Fill the group message from \p states, unless skipped in change-driven mode, and return whether to publish it:
+  template <class States>
+  bool updateMessage(JointGroup& group, sensor_msgs::JointState& msg, const ros::Time& time, const States& states);
+
+  void initPublisher(ros::NodeHandle& nh, const std::string& topic, const sensor_msgs::JointState& msg,
+                     JointGroup& group);
+
+  void writeTelemetry(const ros::Time& time);
+
+  bool initChangeDetection(const ros::NodeHandle& nh);
+
+  bool initVelocityEstimation(const ros::NodeHandle& nh, const std::vector<std::string>& joint_names);
+
+  /// Refresh velocities_ from the hardware handles and the velocity estimators:
+  void updateVelocities(const ros::Duration& period);
+
+  bool initJointGroups(ros::NodeHandle& root_nh, const ros::NodeHandle& nh,
+                       const std::vector<std::string>& joint_names);
+
+  /// Whether a joint of the group moved past a change threshold since its last published message \p msg:
+  template <class States>
+  bool jointStatesChanged(const JointGroup& group, const sensor_msgs::JointState& msg, const States& states) const;
 
   void addExtraJoints(const ros::NodeHandle& nh, sensor_msgs::JointState& msg);
 };
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_STATE_CONTROLLER_PRESERIALIZED_JOINT_STATE_H
+#define JOINT_STATE_CONTROLLER_PRESERIALIZED_JOINT_STATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <ros/message_traits.h>
+#include <ros/serialization.h>
+#include <sensor_msgs/JointState.h>
+
+namespace joint_state_controller
+{
+
+/**
+ * \brief \c sensor_msgs/JointState message whose joint names are serialized once, instead of on every publication.
+ *
+ * It is published as a \c sensor_msgs/JointState, with the same wire format, but its serialization copies the
+ * preserialized name array as a single block, and only serializes the header and the numeric arrays, which are plain
+ * blocks of doubles. Names are serialized as usual until preserialize() is called, and again if their number changes
+ * afterwards.
+ */
+class PreserializedJointState : public sensor_msgs::JointState
+{
+public:
+  PreserializedJointState() : serialized_name_count_(0) {}
+
+  /**
+   * \brief Serialize the current joint names, to be called after they change.
+   * \note This method is \b not real-time safe.
+   */
+  void preserialize()
+  {
+    serialized_names_.resize(ros::serialization::serializationLength(name));
+    ros::serialization::OStream stream(serialized_names_.data(), serialized_names_.size());
+    ros::serialization::serialize(stream, name);
+    serialized_name_count_ = name.size();
+  }
+
+  /** \return Whether the serialized names are those of the message, as far as their number tells. */
+  bool hasSerializedNames() const
+  {
+    return !serialized_names_.empty() && serialized_name_count_ == name.size();
+  }
+
+  /** \return Serialized name array, length included. */
+  const std::vector<uint8_t>& serializedNames() const {return serialized_names_;}
+
+private:
+  std::vector<uint8_t> serialized_names_;
+  std::size_t serialized_name_count_;
+};
+
+} // namespace
+
+namespace ros
+{
+namespace message_traits
+{
+
+template <> struct IsMessage<joint_state_controller::PreserializedJointState> : TrueType {};
+template <> struct HasHeader<joint_state_controller::PreserializedJointState> : TrueType {};
+
+template <> struct MD5Sum<joint_state_controller::PreserializedJointState>
+{
+  static const char* value() {return MD5Sum<sensor_msgs::JointState>::value();}
+  static const char* value(const joint_state_controller::PreserializedJointState&) {return value();}
+};
+
+template <> struct DataType<joint_state_controller::PreserializedJointState>
+{
+  static const char* value() {return DataType<sensor_msgs::JointState>::value();}
+  static const char* value(const joint_state_controller::PreserializedJointState&) {return value();}
+};
+
+template <> struct Definition<joint_state_controller::PreserializedJointState>
+{
+  static const char* value() {return Definition<sensor_msgs::JointState>::value();}
+  static const char* value(const joint_state_controller::PreserializedJointState&) {return value();}
+};
+
+} // namespace message_traits
+
+namespace serialization
+{
+
+template <> struct Serializer<joint_state_controller::PreserializedJointState>
+{
+  template <typename Stream>
+  inline static void write(Stream& stream, const joint_state_controller::PreserializedJointState& m)
+  {
+    stream.next(m.header);
+    if (m.hasSerializedNames())
+    {
+      const std::vector<uint8_t>& names = m.serializedNames();
+      std::memcpy(stream.advance(names.size()), names.data(), names.size());
+    }
+    else
+    {
+      stream.next(m.name);
+    }
+    stream.next(m.position);
+    stream.next(m.velocity);
+    stream.next(m.effort);
+  }
+
+  template <typename Stream>
+  inline static void read(Stream& stream, joint_state_controller::PreserializedJointState& m)
+  {
+    stream.next(static_cast<sensor_msgs::JointState&>(m));
+    m.preserialize();
+  }
+
+  inline static uint32_t serializedLength(const joint_state_controller::PreserializedJointState& m)
+  {
+    const uint32_t names_length = m.hasSerializedNames() ? m.serializedNames().size() : serializationLength(m.name);
+    return serializationLength(m.header) + names_length + serializationLength(m.position) +
+           serializationLength(m.velocity) + serializationLength(m.effort);
+  }
+};
+
+} // namespace serialization
+} // namespace ros
+
+#endif
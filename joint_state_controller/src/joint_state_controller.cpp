@@ -30,73 +30,537 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 
 #include "joint_state_controller/joint_state_controller.h"
 
 namespace joint_state_controller
 {
 
+  namespace
+  {
+    /// Joint states read from the hardware handles, with the velocities refreshed in the update:
+    struct HandleStates
+    {
+      const std::vector<hardware_interface::JointStateHandle>& handles;
+      const std::vector<double>& velocities;
+
+      double position(unsigned id) const { return handles[id].getPosition(); }
+      double velocity(unsigned id) const { return velocities[id]; }
+      double effort(unsigned id)   const { return handles[id].getEffort(); }
+    };
+
+    /// Joint states read from a snapshot, interleaved by joint:
+    struct SnapshotStates
+    {
+      const double* states;
+
+      double position(unsigned id) const { return states[3*id]; }
+      double velocity(unsigned id) const { return states[3*id + 1]; }
+      double effort(unsigned id)   const { return states[3*id + 2]; }
+    };
+
+    /// Capacity of the snapshot queue, in publish cycles:
+    const std::size_t SNAPSHOT_QUEUE_SIZE = 64;
+  }
+
+  JointStateController::~JointStateController()
+  {
+    keep_running_.store(false);
+    if (publisher_thread_.joinable())
+      publisher_thread_.join();
+  }
+
   bool JointStateController::init(hardware_interface::JointStateInterface* hw,
                                   ros::NodeHandle&                         root_nh,
                                   ros::NodeHandle&                         controller_nh)
   {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh);
+    if (!thread_placement_scope) {return false;}
+
     // get all joint names from the hardware interface
     const std::vector<std::string>& joint_names = hw->getNames();
     num_hw_joints_ = joint_names.size();
     for (unsigned i=0; i<num_hw_joints_; i++)
       ROS_DEBUG("Got joint %s", joint_names[i].c_str());
 
-    // get publishing period
-    if (!controller_nh.getParam("publish_rate", publish_rate_)){
+    // get publishing period of all joints
+    groups_.resize(1);
+    JointGroup& all_joints = groups_[0];
+    if (!controller_nh.getParam("publish_rate", all_joints.publish_rate)){
       ROS_ERROR("Parameter 'publish_rate' not set");
       return false;
     }
 
-    // realtime publisher
-    realtime_pub_.reset(new realtime_tools::RealtimePublisher<sensor_msgs::JointState>(root_nh, "joint_states", 4));
+    // change-driven publishing
+    if (!initChangeDetection(controller_nh))
+      return false;
+
+    // publishing from a dedicated thread, instead of realtime publishers
+    controller_nh.param("publish_thread", publish_thread_, publish_thread_);
+
+    // publishing from the publisher pool of the process, instead of a thread per realtime publisher
+    controller_nh.param("publisher_pool", publisher_pool_, publisher_pool_);
+
+    // also publishing without the joint names
+    controller_nh.param("compact_output", compact_output_, compact_output_);
 
     // get joints and allocate message
+    sensor_msgs::JointState msg;
     for (unsigned i=0; i<num_hw_joints_; i++){
       joint_state_.push_back(hw->getHandle(joint_names[i]));
-      realtime_pub_->msg_.name.push_back(joint_names[i]);
-      realtime_pub_->msg_.position.push_back(0.0);
-      realtime_pub_->msg_.velocity.push_back(0.0);
-      realtime_pub_->msg_.effort.push_back(0.0);
+      all_joints.joint_ids.push_back(i);
+      msg.name.push_back(joint_names[i]);
+      msg.position.push_back(0.0);
+      msg.velocity.push_back(0.0);
+      msg.effort.push_back(0.0);
+    }
+    addExtraJoints(controller_nh, msg);
+    initPublisher(root_nh, "joint_states", msg, all_joints);
+
+    // joint groups, on their own topics and at their own rates
+    if (!initJointGroups(root_nh, controller_nh, joint_names))
+      return false;
+
+    // velocities estimated from the positions
+    velocities_.assign(num_hw_joints_, 0.0);
+    if (!initVelocityEstimation(controller_nh, joint_names))
+      return false;
+
+    // publish cycles, optionally spread across groups and controllers
+    bool stagger_publish = false;
+    controller_nh.param("stagger_publish", stagger_publish, stagger_publish);
+    for (JointGroup& group : groups_)
+      group.publish_schedule.init(group.publish_rate, stagger_publish);
+
+    rt_audit_.init(controller_nh);
+
+    // telemetry ring, with the state of the joints present in the JointStateInterface
+    std::vector<std::string> telemetry_labels;
+    const char* const telemetry_quantities[] = {"position", "velocity", "effort"};
+    for (const char* quantity : telemetry_quantities)
+      for (unsigned i=0; i<num_hw_joints_; i++)
+        telemetry_labels.push_back(joint_names[i] + "/" + quantity);
+    if (!telemetry_ring_.init(controller_nh, telemetry_labels))
+      return false;
+
+    // snapshot queue, preallocated for all joints, and publisher thread
+    if (publish_thread_){
+      Snapshot prototype;
+      prototype.restart = false;
+      prototype.publish.assign(groups_.size(), false);
+      prototype.states.assign(3 * num_hw_joints_, 0.0);
+      snapshots_.reset(SNAPSHOT_QUEUE_SIZE, prototype);
+      keep_running_.store(true);
+      publisher_thread_ = std::thread(&JointStateController::run, this);
     }
-    addExtraJoints(controller_nh, realtime_pub_->msg_);
 
     return true;
   }
 
+  void JointStateController::initPublisher(ros::NodeHandle& nh, const std::string& topic,
+                                           const sensor_msgs::JointState& msg, JointGroup& group)
+  {
+    if (compact_output_){
+      // topic of the compact output, joint_states_compact[/<group name>]
+      const std::string compact_topic = "joint_states_compact" + topic.substr(std::string("joint_states").size());
+      CompactJointState compact_msg;
+      compactJointState(msg, compact_msg);
+
+      if (publish_thread_){
+        group.compact_pub = nh.advertise<CompactJointState>(compact_topic, 4);
+        group.compact_msg = compact_msg;
+      }
+      else if (publisher_pool_){
+        group.compact_pooled_pub.reset(new controller_instrumentation::PooledPublisher<CompactJointState>(
+                                         nh, compact_topic, 4, group.publish_rate));
+        group.compact_pooled_pub->lock();
+        group.compact_pooled_pub->msg_ = compact_msg;
+        group.compact_pooled_pub->unlock();
+      }
+      else{
+        group.compact_realtime_pub.reset(new realtime_tools::RealtimePublisher<CompactJointState>(nh, compact_topic, 4));
+        group.compact_realtime_pub->msg_ = compact_msg;
+      }
+
+      // the names, latched once with empty arrays
+      sensor_msgs::JointState names;
+      names.name = msg.name;
+      group.names_pub = nh.advertise<sensor_msgs::JointState>(compact_topic + "/names", 1, true);
+      group.names_pub.publish(names);
+    }
+
+    // the joint names are constant, so only serialize them once
+    if (publish_thread_){
+      group.pub = nh.advertise<PreserializedJointState>(topic, 4);
+      static_cast<sensor_msgs::JointState&>(group.msg) = msg;
+      group.msg.preserialize();
+    }
+    else if (publisher_pool_){
+      group.pooled_pub.reset(new controller_instrumentation::PooledPublisher<PreserializedJointState>(
+                               nh, topic, 4, group.publish_rate));
+      group.pooled_pub->lock();
+      static_cast<sensor_msgs::JointState&>(group.pooled_pub->msg_) = msg;
+      group.pooled_pub->msg_.preserialize();
+      group.pooled_pub->unlock();
+    }
+    else{
+      group.realtime_pub.reset(new realtime_tools::RealtimePublisher<PreserializedJointState>(nh, topic, 4));
+      static_cast<sensor_msgs::JointState&>(group.realtime_pub->msg_) = msg;
+      group.realtime_pub->msg_.preserialize();
+    }
+  }
+
   void JointStateController::starting(const ros::Time& time)
   {
-    // initialize time
-    last_publish_time_ = time;
+    for (JointGroup& group : groups_){
+      // initialize time
+      group.publish_schedule.reset(time);
+
+      // publish the first cycle, whether the joints moved or not
+      if (!publish_thread_)
+        group.state_published = false;
+    }
+
+    // the publisher thread owns the publish state of the groups
+    restart_pending_ = true;
+
+    // estimate velocities from the positions of this run only
+    for (VelocityEstimator& estimator : velocity_estimators_)
+      estimator.filter.reset();
   }
 
-  void JointStateController::update(const ros::Time& time, const ros::Duration& /*period*/)
+  void JointStateController::update(const ros::Time& time, const ros::Duration& period)
+  {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+    updateVelocities(period);
+
+    if (publish_thread_)
+      pushSnapshot(time);
+    else
+      for (JointGroup& group : groups_)
+        if (publisher_pool_)
+          publish(group, *group.pooled_pub, time);
+        else
+          publish(group, *group.realtime_pub, time);
+
+    writeTelemetry(time);
+  }
+
+  template <class Publisher>
+  void JointStateController::publish(JointGroup& group, Publisher& publisher, const ros::Time& time)
   {
     // limit rate of publishing
-    if (publish_rate_ > 0.0 && last_publish_time_ + ros::Duration(1.0/publish_rate_) < time){
+    if (group.publish_schedule.due(time)){
 
       // try to publish
-      if (realtime_pub_->trylock()){
+      if (controller_instrumentation::tracedTrylock(publisher, "joint_states")){
         // we're actually publishing, so increment time
-        last_publish_time_ = last_publish_time_ + ros::Duration(1.0/publish_rate_);
-
-        // populate joint state message:
-        // - fill only joints that are present in the JointStateInterface, i.e. indices [0, num_hw_joints_)
-        // - leave unchanged extra joints, which have static values, i.e. indices from num_hw_joints_ onwards
-        realtime_pub_->msg_.header.stamp = time;
-        for (unsigned i=0; i<num_hw_joints_; i++){
-          realtime_pub_->msg_.position[i] = joint_state_[i].getPosition();
-          realtime_pub_->msg_.velocity[i] = joint_state_[i].getVelocity();
-          realtime_pub_->msg_.effort[i] = joint_state_[i].getEffort();
+        group.publish_schedule.advance();
+
+        if (updateMessage(group, publisher.msg_, time, HandleStates{joint_state_, velocities_})){
+          if (publisher_pool_)
+            publishCompact(group.compact_pooled_pub, publisher.msg_);
+          else
+            publishCompact(group.compact_realtime_pub, publisher.msg_);
+          publisher.unlockAndPublish();
+        }
+        else
+          publisher.unlock();
+      }
+    }
+  }
+
+  template <class Publisher>
+  void JointStateController::publishCompact(const std::shared_ptr<Publisher>& publisher,
+                                            const sensor_msgs::JointState& msg)
+  {
+    if (publisher && controller_instrumentation::tracedTrylock(*publisher, "joint_states_compact")){
+      compactJointState(msg, publisher->msg_);
+      publisher->unlockAndPublish();
+    }
+  }
+
+  void JointStateController::pushSnapshot(const ros::Time& time)
+  {
+    // limit rate of publishing: the cycle is published, or lost if the queue is full, so increment time
+    bool publish = false;
+    for (JointGroup& group : groups_){
+      group.publish_cycle = group.publish_schedule.due(time);
+      if (group.publish_cycle){
+        group.publish_schedule.advance();
+        publish = true;
+      }
+    }
+    if (!publish)
+      return;
+
+    Snapshot* snapshot = snapshots_.beginPush();
+    if (!snapshot){
+      dropped_snapshots_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    for (unsigned g=0; g<groups_.size(); g++)
+      snapshot->publish[g] = groups_[g].publish_cycle;
+
+    // pack the joint states
+    snapshot->stamp = time;
+    snapshot->restart = restart_pending_;
+    restart_pending_ = false;
+    double* states = snapshot->states.data();
+    for (unsigned i=0; i<num_hw_joints_; i++){
+      states[3*i]     = joint_state_[i].getPosition();
+      states[3*i + 1] = velocities_[i];
+      states[3*i + 2] = joint_state_[i].getEffort();
+    }
+    snapshots_.commitPush();
+  }
+
+  void JointStateController::run()
+  {
+    // poll several times per publish period, so that publication latency stays a fraction of it
+    double max_publish_rate = 0.0;
+    for (const JointGroup& group : groups_)
+      max_publish_rate = std::max(max_publish_rate, group.publish_rate);
+    const double poll_period = max_publish_rate > 0.0 ? std::min(std::max(0.25/max_publish_rate, 0.001), 0.01) : 0.01;
+
+    std::size_t reported_dropped_snapshots = 0;
+    Snapshot snapshot = Snapshot();
+    snapshot.publish.assign(groups_.size(), false);
+    snapshot.states.assign(3 * num_hw_joints_, 0.0);
+    while (keep_running_.load()){
+      while (snapshots_.pop(snapshot)){
+        const SnapshotStates states{snapshot.states.data()};
+        for (unsigned g=0; g<groups_.size(); g++){
+          JointGroup& group = groups_[g];
+          if (snapshot.restart)
+            group.state_published = false;
+          if (snapshot.publish[g] && updateMessage(group, group.msg, snapshot.stamp, states)){
+            group.pub.publish(group.msg);
+            if (group.compact_pub){
+              compactJointState(group.msg, group.compact_msg);
+              group.compact_pub.publish(group.compact_msg);
+            }
+          }
         }
-        realtime_pub_->unlockAndPublish();
       }
+
+      const std::size_t dropped_snapshots = dropped_snapshots_.load(std::memory_order_relaxed);
+      if (dropped_snapshots != reported_dropped_snapshots){
+        ROS_WARN_STREAM_THROTTLE(1.0, "Joint state queue full: " << dropped_snapshots - reported_dropped_snapshots
+                                 << " publish cycles dropped.");
+        reported_dropped_snapshots = dropped_snapshots;
+      }
+
+      std::this_thread::sleep_for(std::chrono::duration<double>(poll_period));
+    }
+  }
+
+  template <class States>
+  bool JointStateController::updateMessage(JointGroup& group, sensor_msgs::JointState& msg, const ros::Time& time,
+                                           const States& states)
+  {
+    // in change-driven mode, skip the cycle if no joint moved, unless the keep-alive message is due
+    const bool keep_alive = !group.state_published ||
+      (!keep_alive_period_.isZero() && group.last_state_publish_time + keep_alive_period_ <= time);
+    if (change_driven_ && !keep_alive && !jointStatesChanged(group, msg, states))
+      return false;
+
+    group.last_state_publish_time = time;
+    group.state_published = true;
+
+    // populate joint state message:
+    // - fill only joints that are present in the JointStateInterface, i.e. indices [0, joint_ids.size())
+    // - leave unchanged extra joints, which have static values, i.e. indices from joint_ids.size() onwards
+    msg.header.stamp = time;
+    for (unsigned i=0; i<group.joint_ids.size(); i++){
+      const unsigned id = group.joint_ids[i];
+      msg.position[i] = states.position(id);
+      msg.velocity[i] = states.velocity(id);
+      msg.effort[i] = states.effort(id);
+    }
+    return true;
+  }
+
+  bool JointStateController::initChangeDetection(const ros::NodeHandle& nh)
+  {
+    const double no_threshold = std::numeric_limits<double>::infinity();
+    position_threshold_ = velocity_threshold_ = effort_threshold_ = no_threshold;
+
+    // enabled by any threshold, all of them being read
+    ros::NodeHandle threshold_nh(nh, "change_threshold");
+    change_driven_ = threshold_nh.getParam("position", position_threshold_) |
+                     threshold_nh.getParam("velocity", velocity_threshold_) |
+                     threshold_nh.getParam("effort",   effort_threshold_);
+    if (!change_driven_)
+      return true;
+
+    if (!(position_threshold_ >= 0.0 && velocity_threshold_ >= 0.0 && effort_threshold_ >= 0.0)){
+      ROS_ERROR("Change thresholds must be non-negative");
+      return false;
+    }
+
+    double keep_alive_rate = 1.0;
+    nh.param("keep_alive_rate", keep_alive_rate, keep_alive_rate);
+    if (keep_alive_rate < 0.0){
+      ROS_ERROR("Parameter 'keep_alive_rate' must be non-negative");
+      return false;
+    }
+    keep_alive_period_ = keep_alive_rate > 0.0 ? ros::Duration(1.0/keep_alive_rate) : ros::Duration(0.0);
+
+    ROS_DEBUG("Joint states will only be published on change, and at least at %f Hz", keep_alive_rate);
+    return true;
+  }
+
+  bool JointStateController::initVelocityEstimation(const ros::NodeHandle& nh,
+                                                    const std::vector<std::string>& joint_names)
+  {
+    ros::NodeHandle estimation_nh(nh, "velocity_estimation");
+    std::vector<std::string> joints;
+    if (!estimation_nh.getParam("joints", joints))
+      return true;
+
+    int window_size = 1;
+    estimation_nh.param("window_size", window_size, window_size);
+    if (window_size < 1){
+      ROS_ERROR("Parameter 'velocity_estimation/window_size' must be positive");
+      return false;
+    }
+
+    for (const std::string& joint : joints){
+      const std::vector<std::string>::const_iterator it = std::find(joint_names.begin(), joint_names.end(), joint);
+      if (it == joint_names.end()){
+        ROS_ERROR_STREAM("Velocity estimation joint '" << joint << "' is not in the joint state interface");
+        return false;
+      }
+      VelocityEstimator estimator;
+      estimator.joint_id = std::distance(joint_names.begin(), it);
+      estimator.filter.setWindowSize(window_size);
+      velocity_estimators_.push_back(estimator);
+    }
+
+    ROS_DEBUG("Velocity of %zu joints will be estimated over a window of %d cycles", joints.size(), window_size);
+    return true;
+  }
+
+  void JointStateController::updateVelocities(const ros::Duration& period)
+  {
+    for (unsigned i=0; i<num_hw_joints_; i++)
+      velocities_[i] = joint_state_[i].getVelocity();
+
+    // a cycle without elapsed time keeps the previous estimate
+    const double dt = period.toSec();
+    for (VelocityEstimator& estimator : velocity_estimators_){
+      if (dt > 0.0)
+        estimator.filter.update(joint_state_[estimator.joint_id].getPosition(), dt);
+      velocities_[estimator.joint_id] = estimator.filter.firstDerivative();
+    }
+  }
+
+  bool JointStateController::initJointGroups(ros::NodeHandle& root_nh, const ros::NodeHandle& nh,
+                                             const std::vector<std::string>& joint_names)
+  {
+    XmlRpc::XmlRpcValue list;
+    if (!nh.getParam("joint_groups", list))
+      return true;
+
+    if (list.getType() != XmlRpc::XmlRpcValue::TypeArray){
+      ROS_ERROR("Joint groups specification is not an array");
+      return false;
+    }
+
+    for (int i = 0; i < list.size(); ++i){
+      XmlRpc::XmlRpcValue& elem = list[i];
+      if (elem.getType() != XmlRpc::XmlRpcValue::TypeStruct || !elem.hasMember("name") ||
+          elem["name"].getType() != XmlRpc::XmlRpcValue::TypeString){
+        ROS_ERROR("Joint group specification is not a struct with a name");
+        return false;
+      }
+      const std::string name = elem["name"];
+      if (compact_output_ && name == "names"){
+        ROS_ERROR("Joint group 'names' would have the topic of the compact joint names");
+        return false;
+      }
+
+      JointGroup group;
+      const XmlRpc::XmlRpcValue::Type rate_type = elem.hasMember("publish_rate") ? elem["publish_rate"].getType()
+                                                                                  : XmlRpc::XmlRpcValue::TypeInvalid;
+      if (rate_type == XmlRpc::XmlRpcValue::TypeDouble)
+        group.publish_rate = static_cast<double>(elem["publish_rate"]);
+      else if (rate_type == XmlRpc::XmlRpcValue::TypeInt)
+        group.publish_rate = static_cast<int>(elem["publish_rate"]);
+      if (!(group.publish_rate > 0.0)){
+        ROS_ERROR_STREAM("Joint group '" << name << "' does not specify a positive publish rate");
+        return false;
+      }
+
+      if (!elem.hasMember("joints") || elem["joints"].getType() != XmlRpc::XmlRpcValue::TypeArray ||
+          elem["joints"].size() == 0){
+        ROS_ERROR_STREAM("Joint group '" << name << "' does not specify a list of joints");
+        return false;
+      }
+
+      // precompute the handle indices of the group joints, so that publishing does not look them up
+      sensor_msgs::JointState msg;
+      XmlRpc::XmlRpcValue& joints = elem["joints"];
+      for (int j = 0; j < joints.size(); ++j){
+        const std::vector<std::string>::const_iterator it =
+            joints[j].getType() == XmlRpc::XmlRpcValue::TypeString ?
+            std::find(joint_names.begin(), joint_names.end(), static_cast<std::string>(joints[j])) : joint_names.end();
+        if (it == joint_names.end()){
+          ROS_ERROR_STREAM("Joint group '" << name << "' has a joint not in the joint state interface");
+          return false;
+        }
+        group.joint_ids.push_back(std::distance(joint_names.begin(), it));
+        msg.name.push_back(*it);
+        msg.position.push_back(0.0);
+        msg.velocity.push_back(0.0);
+        msg.effort.push_back(0.0);
+      }
+      initPublisher(root_nh, "joint_states/" + name, msg, group);
+
+      ROS_DEBUG("Joint group %s will be published at %f Hz", name.c_str(), group.publish_rate);
+      groups_.push_back(group);
+    }
+    return true;
+  }
+
+  template <class States>
+  bool JointStateController::jointStatesChanged(const JointGroup& group, const sensor_msgs::JointState& msg,
+                                                const States& states) const
+  {
+    // the message holds the last published values; a NaN appearing or going away counts as a change
+    const auto changed = [](double value, double published, double threshold)
+    {
+      return std::abs(value - published) > threshold || std::isnan(value) != std::isnan(published);
+    };
+    for (unsigned i=0; i<group.joint_ids.size(); i++){
+      const unsigned id = group.joint_ids[i];
+      if (changed(states.position(id), msg.position[i], position_threshold_) ||
+          changed(states.velocity(id), msg.velocity[i], velocity_threshold_) ||
+          changed(states.effort(id),   msg.effort[i],   effort_threshold_))
+        return true;
+    }
+    return false;
+  }
+
+  void JointStateController::writeTelemetry(const ros::Time& time)
+  {
+    double* data = telemetry_ring_.beginWrite(time.toSec());
+    if (!data)
+      return;
+
+    for (unsigned i=0; i<num_hw_joints_; i++){
+      data[i]                      = joint_state_[i].getPosition();
+      data[i + num_hw_joints_]     = velocities_[i];
+      data[i + 2 * num_hw_joints_] = joint_state_[i].getEffort();
     }
+    telemetry_ring_.commit();
   }
 
   void JointStateController::stopping(const ros::Time& /*time*/)
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ros/serialization.h>
+#include <joint_state_controller/compact_joint_state.h>
+
+using joint_state_controller::CompactJointState;
+using joint_state_controller::compactJointState;
+using joint_state_controller::expandJointState;
+
+namespace
+{
+
+void initMessage(sensor_msgs::JointState& msg)
+{
+  msg.header.seq = 3;
+  msg.header.stamp = ros::Time(12, 34);
+  msg.header.frame_id = "base";
+  msg.name = {"joint1", "joint2", "extra1"};
+  msg.position = {1.0, -1.0, 10.0};
+  msg.velocity = {2.0, -2.0, 20.0};
+  msg.effort = {3.0, -3.0, 30.0};
+}
+
+} // namespace
+
+TEST(CompactJointStateTest, RoundTrip)
+{
+  sensor_msgs::JointState msg;
+  initMessage(msg);
+
+  // Name table as latched by the controller
+  sensor_msgs::JointState names;
+  names.header.frame_id = msg.header.frame_id;
+  names.name = msg.name;
+
+  CompactJointState compact;
+  compactJointState(msg, compact);
+  compact.header.seq = msg.header.seq;
+  EXPECT_EQ(msg.header.stamp, compact.header.stamp);
+  EXPECT_LT(ros::serialization::serializationLength(compact), ros::serialization::serializationLength(msg));
+
+  sensor_msgs::JointState expanded;
+  ASSERT_TRUE(expandJointState(names, compact, expanded));
+  EXPECT_EQ(msg.header.seq, expanded.header.seq);
+  EXPECT_EQ(msg.header.stamp, expanded.header.stamp);
+  EXPECT_EQ(msg.header.frame_id, expanded.header.frame_id);
+  EXPECT_EQ(msg.name, expanded.name);
+  EXPECT_EQ(msg.position, expanded.position);
+  EXPECT_EQ(msg.velocity, expanded.velocity);
+  EXPECT_EQ(msg.effort, expanded.effort);
+}
+
+TEST(CompactJointStateTest, ReusesArrays)
+{
+  sensor_msgs::JointState msg;
+  initMessage(msg);
+
+  CompactJointState compact;
+  compactJointState(msg, compact);
+  const double* const position = compact.position.data();
+
+  msg.position[1] = 5.0;
+  msg.header.stamp = ros::Time(13, 0);
+  compactJointState(msg, compact);
+  EXPECT_EQ(position, compact.position.data());
+  EXPECT_EQ(5.0, compact.position[1]);
+  EXPECT_EQ(ros::Time(13, 0), compact.header.stamp);
+}
+
+TEST(CompactJointStateTest, RejectsMismatchedNames)
+{
+  sensor_msgs::JointState msg;
+  initMessage(msg);
+  CompactJointState compact;
+  compactJointState(msg, compact);
+
+  sensor_msgs::JointState names;
+  names.name = {"joint1", "joint2"};
+  sensor_msgs::JointState expanded;
+  EXPECT_FALSE(expandJointState(names, compact, expanded));
+  EXPECT_TRUE(expanded.name.empty());
+
+  // Empty arrays are allowed, like in sensor_msgs/JointState
+  names.name = msg.name;
+  compact.effort.clear();
+  ASSERT_TRUE(expandJointState(names, compact, expanded));
+  EXPECT_EQ(msg.name, expanded.name);
+  EXPECT_TRUE(expanded.effort.empty());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -26,6 +26,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -64,12 +65,17 @@ public:
                                                        1,
                                                        &JointStateControllerTest::jointStateCb,
                                                        this);
+    group_sub_ = root_nh_.subscribe<sensor_msgs::JointState>("joint_states/first",
+                                                             1,
+                                                             &JointStateControllerTest::groupJointStateCb,
+                                                             this);
   }
 
 protected:
   ros::NodeHandle root_nh_;
   ros::NodeHandle controller_nh_;
   ros::Subscriber sub_;
+  ros::Subscriber group_sub_;
   hardware_interface::JointStateInterface js_iface_;
 
   // Raw joint state data
@@ -84,11 +90,21 @@ protected:
   // Last received joint state message
   sensor_msgs::JointState last_msg_;
 
+  // Received and last joint group messages
+  int rec_group_msgs_;
+  sensor_msgs::JointState last_group_msg_;
+
   void jointStateCb(const sensor_msgs::JointStateConstPtr& msg)
   {
     last_msg_ = *msg;
     ++rec_msgs_;
   }
+
+  void groupJointStateCb(const sensor_msgs::JointStateConstPtr& msg)
+  {
+    last_group_msg_ = *msg;
+    ++rec_group_msgs_;
+  }
 };
 
 TEST_F(JointStateControllerTest, initOk)
@@ -317,6 +333,267 @@ TEST_F(JointStateControllerTest, extraJointsKo)
   jsc.stopping(ros::Time::now());
 }
 
+TEST_F(JointStateControllerTest, changeDrivenOk)
+{
+  JointStateController jsc;
+  ros::NodeHandle change_driven_nh("test_change_driven_ok/joint_state_controller");
+  EXPECT_TRUE(jsc.init(&js_iface_, root_nh_, change_driven_nh));
+
+  // Update at the given offset from the start time, well past the publish period, and wait for the message, if any
+  rec_msgs_ = 0;
+  const ros::Time start_time = ros::Time::now();
+  const ros::Duration wait(0.1);
+  auto update = [&](double offset)
+  {
+    jsc.update(start_time + ros::Duration(offset), ros::Duration());
+    wait.sleep(); ros::spinOnce(); // To trigger callback
+  };
+  jsc.starting(start_time);
+
+  // The first cycle is always published
+  update(0.1);
+  EXPECT_EQ(1, rec_msgs_);
+
+  // Position below its threshold, and velocity without a threshold: no message
+  pos_[0] = 0.005;
+  update(0.2);
+  vel_[0] = 1.0;
+  update(0.3);
+  EXPECT_EQ(1, rec_msgs_);
+
+  // Position past its threshold
+  pos_[1] = 0.02;
+  update(0.4);
+  ASSERT_EQ(2, rec_msgs_);
+  EXPECT_EQ(0.005, last_msg_.position[0]);
+  EXPECT_EQ(0.02,  last_msg_.position[1]);
+  EXPECT_EQ(1.0,   last_msg_.velocity[0]);
+
+  // Static joints: no message until the keep-alive one, half a second after the last message
+  update(0.5);
+  update(0.8);
+  EXPECT_EQ(2, rec_msgs_);
+  update(0.95);
+  EXPECT_EQ(3, rec_msgs_);
+
+  // Invalid effort
+  eff_[0] = std::numeric_limits<double>::quiet_NaN();
+  update(1.0);
+  EXPECT_EQ(4, rec_msgs_);
+
+  jsc.stopping(ros::Time::now());
+}
+
+TEST_F(JointStateControllerTest, changeDrivenKo)
+{
+  JointStateController jsc;
+  ros::NodeHandle negative_threshold_nh("test_change_driven_ko/joint_state_controller");
+  EXPECT_FALSE(jsc.init(&js_iface_, root_nh_, negative_threshold_nh));
+}
+
+TEST_F(JointStateControllerTest, jointGroupsOk)
+{
+  JointStateController jsc;
+  ros::NodeHandle joint_groups_nh("test_joint_groups_ok/joint_state_controller");
+  EXPECT_TRUE(jsc.init(&js_iface_, root_nh_, joint_groups_nh));
+
+  rec_msgs_ = 0;
+  rec_group_msgs_ = 0;
+  ros::Duration period(0.1);
+  jsc.starting(ros::Time::now());
+
+  pos_[0] = 1.0; pos_[1] = -1.0;
+  vel_[0] = 2.0; vel_[1] = -2.0;
+  eff_[0] = 3.0; eff_[1] = -3.0;
+
+  period.sleep();
+  jsc.update(ros::Time::now(), ros::Duration());
+  period.sleep(); ros::spinOnce(); // To trigger callback
+
+  // Only the group joints, and nothing on the disabled all joints topic
+  EXPECT_EQ(0, rec_msgs_);
+  ASSERT_EQ(1, rec_group_msgs_);
+  ASSERT_EQ(1u, last_group_msg_.name.size());
+  ASSERT_EQ(1u, last_group_msg_.position.size());
+  ASSERT_EQ(1u, last_group_msg_.velocity.size());
+  ASSERT_EQ(1u, last_group_msg_.effort.size());
+  EXPECT_EQ(names_[1], last_group_msg_.name[0]);
+  EXPECT_EQ(pos_[1], last_group_msg_.position[0]);
+  EXPECT_EQ(vel_[1], last_group_msg_.velocity[0]);
+  EXPECT_EQ(eff_[1], last_group_msg_.effort[0]);
+
+  jsc.stopping(ros::Time::now());
+}
+
+TEST_F(JointStateControllerTest, jointGroupsKo)
+{
+  JointStateController jsc;
+  ros::NodeHandle unknown_joint_nh("test_joint_groups_ko/joint_state_controller");
+  EXPECT_FALSE(jsc.init(&js_iface_, root_nh_, unknown_joint_nh));
+}
+
+TEST_F(JointStateControllerTest, publishThreadOk)
+{
+  JointStateController jsc;
+  ros::NodeHandle publish_thread_nh("test_publish_thread_ok/joint_state_controller");
+  EXPECT_TRUE(jsc.init(&js_iface_, root_nh_, publish_thread_nh));
+
+  rec_msgs_ = 0;
+  rec_group_msgs_ = 0;
+  int pub_rate;
+  ASSERT_TRUE(publish_thread_nh.getParam("publish_rate", pub_rate));
+  ros::Duration period(1.0 / pub_rate);
+  jsc.starting(ros::Time::now());
+
+  pos_[0] = 1.0; pos_[1] = -1.0;
+  vel_[0] = 2.0; vel_[1] = -2.0;
+  eff_[0] = 3.0; eff_[1] = -3.0;
+
+  period.sleep();
+  jsc.update(ros::Time::now(), ros::Duration());
+
+  // The joint states are those of the update, even if they change before the publisher thread runs
+  pos_[0] = 10.0; pos_[1] = -10.0;
+  period.sleep(); ros::spinOnce(); // To trigger callback
+
+  ASSERT_EQ(1, rec_msgs_);
+  ASSERT_EQ(names_.size(), last_msg_.name.size());
+  for (std::size_t i = 0; i < names_.size(); ++i)
+  {
+    EXPECT_EQ(names_[i], last_msg_.name[i]);
+    EXPECT_EQ(i == 0 ? 1.0 : -1.0, last_msg_.position[i]);
+    EXPECT_EQ(vel_[i], last_msg_.velocity[i]);
+    EXPECT_EQ(eff_[i], last_msg_.effort[i]);
+  }
+
+  ASSERT_EQ(1, rec_group_msgs_);
+  ASSERT_EQ(1u, last_group_msg_.name.size());
+  EXPECT_EQ(names_[1], last_group_msg_.name[0]);
+  EXPECT_EQ(-1.0, last_group_msg_.position[0]);
+
+  jsc.stopping(ros::Time::now());
+}
+
+TEST_F(JointStateControllerTest, publisherPoolOk)
+{
+  JointStateController jsc;
+  ros::NodeHandle publisher_pool_nh("test_publisher_pool_ok/joint_state_controller");
+  EXPECT_TRUE(jsc.init(&js_iface_, root_nh_, publisher_pool_nh));
+
+  rec_msgs_ = 0;
+  rec_group_msgs_ = 0;
+  int pub_rate;
+  ASSERT_TRUE(publisher_pool_nh.getParam("publish_rate", pub_rate));
+  ros::Duration period(1.0 / pub_rate);
+  jsc.starting(ros::Time::now());
+
+  pos_[0] = 1.0; pos_[1] = -1.0;
+  vel_[0] = 2.0; vel_[1] = -2.0;
+  eff_[0] = 3.0; eff_[1] = -3.0;
+
+  period.sleep();
+  jsc.update(ros::Time::now(), ros::Duration());
+  period.sleep(); ros::spinOnce(); // To trigger callback
+
+  // Both topics are published by the pool thread
+  ASSERT_EQ(1, rec_msgs_);
+  ASSERT_EQ(names_.size(), last_msg_.name.size());
+  for (std::size_t i = 0; i < names_.size(); ++i)
+  {
+    EXPECT_EQ(names_[i], last_msg_.name[i]);
+    EXPECT_EQ(pos_[i], last_msg_.position[i]);
+    EXPECT_EQ(vel_[i], last_msg_.velocity[i]);
+    EXPECT_EQ(eff_[i], last_msg_.effort[i]);
+  }
+
+  ASSERT_EQ(1, rec_group_msgs_);
+  ASSERT_EQ(1u, last_group_msg_.name.size());
+  EXPECT_EQ(names_[1], last_group_msg_.name[0]);
+  EXPECT_EQ(pos_[1], last_group_msg_.position[0]);
+
+  jsc.stopping(ros::Time::now());
+}
+
+TEST_F(JointStateControllerTest, compactOutputOk)
+{
+  JointStateController jsc;
+  ros::NodeHandle compact_output_nh("test_compact_output_ok/joint_state_controller");
+  EXPECT_TRUE(jsc.init(&js_iface_, root_nh_, compact_output_nh));
+
+  // The names are latched, so they are received even when subscribing after the controller is initialized
+  std::vector<CompactJointState> compact_msgs;
+  std::vector<sensor_msgs::JointState> names_msgs;
+  ros::Subscriber compact_sub = root_nh_.subscribe<CompactJointState>(
+      "joint_states_compact", 1, [&compact_msgs](const CompactJointStateConstPtr& msg) {compact_msgs.push_back(*msg);});
+  ros::Subscriber names_sub = root_nh_.subscribe<sensor_msgs::JointState>(
+      "joint_states_compact/names", 1,
+      [&names_msgs](const sensor_msgs::JointStateConstPtr& msg) {names_msgs.push_back(*msg);});
+
+  rec_msgs_ = 0;
+  ros::Duration period(0.1);
+  jsc.starting(ros::Time::now());
+
+  pos_[0] = 1.0; pos_[1] = -1.0;
+  vel_[0] = 2.0; vel_[1] = -2.0;
+  eff_[0] = 3.0; eff_[1] = -3.0;
+
+  period.sleep();
+  jsc.update(ros::Time::now(), ros::Duration());
+  period.sleep(); ros::spinOnce(); // To trigger callback
+
+  // The full and rebuilt messages are the same
+  ASSERT_EQ(1, rec_msgs_);
+  ASSERT_EQ(1u, names_msgs.size());
+  ASSERT_EQ(1u, compact_msgs.size());
+  EXPECT_TRUE(names_msgs[0].position.empty());
+  sensor_msgs::JointState expanded;
+  ASSERT_TRUE(expandJointState(names_msgs[0], compact_msgs[0], expanded));
+  EXPECT_EQ(last_msg_.header.stamp, expanded.header.stamp);
+  EXPECT_EQ(last_msg_.name, expanded.name);
+  EXPECT_EQ(last_msg_.position, expanded.position);
+  EXPECT_EQ(last_msg_.velocity, expanded.velocity);
+  EXPECT_EQ(last_msg_.effort, expanded.effort);
+
+  jsc.stopping(ros::Time::now());
+}
+
+TEST_F(JointStateControllerTest, velocityEstimationOk)
+{
+  JointStateController jsc;
+  ros::NodeHandle velocity_estimation_nh("test_velocity_estimation_ok/joint_state_controller");
+  EXPECT_TRUE(jsc.init(&js_iface_, root_nh_, velocity_estimation_nh));
+
+  rec_msgs_ = 0;
+  const ros::Time start = ros::Time::now();
+  const ros::Duration period(0.01);
+  jsc.starting(start);
+
+  // joint1 reports no velocity, and moves at constant speed. joint2 reports its velocity
+  vel_[0] = 0.0; vel_[1] = -2.0;
+  ros::Time time = start;
+  for (int i = 0; i <= 20; ++i)
+  {
+    pos_[0] = 0.5 * (time - start).toSec();
+    jsc.update(time, i == 0 ? ros::Duration() : period);
+    time += period;
+  }
+  ros::Duration(0.1).sleep(); ros::spinOnce(); // To trigger callback
+
+  ASSERT_LE(1, rec_msgs_);
+  ASSERT_EQ(names_.size(), last_msg_.velocity.size());
+  EXPECT_NEAR(0.5, last_msg_.velocity[0], 1e-6);
+  EXPECT_EQ(-2.0, last_msg_.velocity[1]);
+
+  jsc.stopping(ros::Time::now());
+}
+
+TEST_F(JointStateControllerTest, velocityEstimationKo)
+{
+  JointStateController jsc;
+  ros::NodeHandle unknown_joint_nh("test_velocity_estimation_ko/joint_state_controller");
+  EXPECT_FALSE(jsc.init(&js_iface_, root_nh_, unknown_joint_nh));
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
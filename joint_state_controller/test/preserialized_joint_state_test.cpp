@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <joint_state_controller/preserialized_joint_state.h>
+
+using joint_state_controller::PreserializedJointState;
+
+namespace
+{
+
+template <class M>
+std::vector<uint8_t> serialize(const M& msg)
+{
+  std::vector<uint8_t> buffer(ros::serialization::serializationLength(msg));
+  ros::serialization::OStream stream(buffer.data(), buffer.size());
+  ros::serialization::serialize(stream, msg);
+  return buffer;
+}
+
+void initMessage(sensor_msgs::JointState& msg)
+{
+  msg.header.seq = 3;
+  msg.header.stamp = ros::Time(12, 34);
+  msg.name = {"joint1", "joint2", "extra1"};
+  msg.position = {1.0, -1.0, 10.0};
+  msg.velocity = {2.0, -2.0, 20.0};
+  msg.effort = {3.0, -3.0, 30.0};
+}
+
+} // namespace
+
+TEST(PreserializedJointStateTest, SameWireFormat)
+{
+  sensor_msgs::JointState msg;
+  initMessage(msg);
+
+  PreserializedJointState preserialized;
+  initMessage(preserialized);
+  EXPECT_FALSE(preserialized.hasSerializedNames());
+  EXPECT_EQ(serialize(msg), serialize(preserialized));
+
+  // Preserialized names, with numeric values changing afterwards
+  preserialized.preserialize();
+  EXPECT_TRUE(preserialized.hasSerializedNames());
+  msg.header.seq = preserialized.header.seq = 4;
+  msg.position[0] = preserialized.position[0] = 5.0;
+  msg.effort.clear(); preserialized.effort.clear();
+  EXPECT_EQ(serialize(msg), serialize(preserialized));
+}
+
+TEST(PreserializedJointStateTest, NamesChanged)
+{
+  sensor_msgs::JointState msg;
+  initMessage(msg);
+
+  PreserializedJointState preserialized;
+  initMessage(preserialized);
+  preserialized.preserialize();
+
+  // A different number of names is serialized as usual, until preserialized again
+  msg.name.push_back("extra2");
+  preserialized.name.push_back("extra2");
+  EXPECT_FALSE(preserialized.hasSerializedNames());
+  EXPECT_EQ(serialize(msg), serialize(preserialized));
+
+  preserialized.preserialize();
+  EXPECT_TRUE(preserialized.hasSerializedNames());
+  EXPECT_EQ(serialize(msg), serialize(preserialized));
+}
+
+TEST(PreserializedJointStateTest, Deserialize)
+{
+  sensor_msgs::JointState msg;
+  initMessage(msg);
+  std::vector<uint8_t> buffer = serialize(msg);
+
+  PreserializedJointState preserialized;
+  ros::serialization::IStream stream(buffer.data(), buffer.size());
+  ros::serialization::deserialize(stream, preserialized);
+  EXPECT_EQ(msg.name, preserialized.name);
+  EXPECT_EQ(msg.position, preserialized.position);
+  EXPECT_TRUE(preserialized.hasSerializedNames());
+  EXPECT_EQ(buffer, serialize(preserialized));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
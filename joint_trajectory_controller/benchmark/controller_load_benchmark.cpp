@@ -0,0 +1,366 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+// Load benchmark: Runs M JointTrajectoryController instances of N joints each in a single controller manager, on
+// simulated hardware updated at a fixed rate, while every controller receives a stream of action goals. Reports the
+// per-cycle CPU time of the control loop, goal acceptance latencies and deadline misses.
+//
+// Only needs a ROS master:
+//   rosrun joint_trajectory_controller controller_load_benchmark _controllers:=4 _joints:=6 _rate:=1000
+//
+// Parameters (private namespace):
+//   controllers     Number of controllers (default: 1)
+//   joints          Joints per controller (default: 6)
+//   rate            Control loop rate in Hz (default: 1000)
+//   duration        Benchmark duration in seconds (default: 10)
+//   goal_period     Time between goals sent to each controller, in seconds (default: 0.5)
+//   goal_points     Points per goal (default: 10)
+//   controller_type Controller type (default: position_controllers/JointTrajectoryController)
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ros/ros.h>
+#include <actionlib/client/simple_action_client.h>
+#include <control_msgs/FollowJointTrajectoryAction.h>
+#include <controller_manager/controller_manager.h>
+#include <controller_manager_msgs/SwitchController.h>
+#include <hardware_interface/joint_command_interface.h>
+#include <hardware_interface/joint_state_interface.h>
+#include <hardware_interface/robot_hw.h>
+
+namespace
+{
+
+typedef actionlib::SimpleActionClient<control_msgs::FollowJointTrajectoryAction> ActionClient;
+
+/** Robot with any number of joints that track their position commands exactly, generalizing the RRbot test robot. */
+class SimulatedRobot : public hardware_interface::RobotHW
+{
+public:
+  explicit SimulatedRobot(const std::vector<std::string>& joint_names)
+    : pos_(joint_names.size(), 0.0),
+      vel_(joint_names.size(), 0.0),
+      eff_(joint_names.size(), 0.0),
+      pos_cmd_(joint_names.size(), 0.0)
+  {
+    for (unsigned int i = 0; i < joint_names.size(); ++i)
+    {
+      hardware_interface::JointStateHandle state_handle(joint_names[i], &pos_[i], &vel_[i], &eff_[i]);
+      jnt_state_interface_.registerHandle(state_handle);
+      jnt_pos_interface_.registerHandle(hardware_interface::JointHandle(state_handle, &pos_cmd_[i]));
+    }
+    registerInterface(&jnt_state_interface_);
+    registerInterface(&jnt_pos_interface_);
+  }
+
+  void read() {}
+
+  void write(const ros::Duration& period)
+  {
+    for (unsigned int i = 0; i < pos_.size(); ++i)
+    {
+      vel_[i] = (pos_cmd_[i] - pos_[i]) / period.toSec();
+      pos_[i] = pos_cmd_[i];
+    }
+  }
+
+private:
+  hardware_interface::JointStateInterface    jnt_state_interface_;
+  hardware_interface::PositionJointInterface jnt_pos_interface_;
+  std::vector<double> pos_;
+  std::vector<double> vel_;
+  std::vector<double> eff_;
+  std::vector<double> pos_cmd_;
+};
+
+/** Serial chain of revolute joints, as required by the controllers to look up joint types. */
+std::string makeUrdf(const std::vector<std::string>& joint_names)
+{
+  std::ostringstream urdf;
+  urdf << "<robot name=\"load_benchmark\">\n  <link name=\"link0\"/>\n";
+  for (unsigned int i = 0; i < joint_names.size(); ++i)
+  {
+    urdf << "  <link name=\"link" << i + 1 << "\"/>\n"
+         << "  <joint name=\"" << joint_names[i] << "\" type=\"revolute\">\n"
+         << "    <parent link=\"link" << i << "\"/>\n"
+         << "    <child link=\"link" << i + 1 << "\"/>\n"
+         << "    <axis xyz=\"0 0 1\"/>\n"
+         << "    <limit lower=\"-3.14\" upper=\"3.14\" effort=\"100.0\" velocity=\"10.0\"/>\n"
+         << "  </joint>\n";
+  }
+  urdf << "</robot>\n";
+  return urdf.str();
+}
+
+/** Goal moving \p joint_names along a sine wave, whose phase varies across goals. */
+control_msgs::FollowJointTrajectoryGoal makeGoal(const std::vector<std::string>& joint_names,
+                                                 unsigned int               n_points,
+                                                 double                     duration,
+                                                 double                     phase)
+{
+  control_msgs::FollowJointTrajectoryGoal goal;
+  trajectory_msgs::JointTrajectory& traj = goal.trajectory;
+  traj.joint_names = joint_names;
+  traj.points.resize(n_points);
+  for (unsigned int k = 0; k < n_points; ++k)
+  {
+    const double time = duration * (k + 1) / n_points;
+    trajectory_msgs::JointTrajectoryPoint& point = traj.points[k];
+    for (unsigned int j = 0; j < joint_names.size(); ++j)
+    {
+      point.positions.push_back(0.5 * std::sin(phase + time + j));
+      point.velocities.push_back(0.5 * std::cos(phase + time + j));
+    }
+    point.time_from_start = ros::Duration(time);
+  }
+  return goal;
+}
+
+double toSec(const timespec& time) {return time.tv_sec + 1e-9 * time.tv_nsec;}
+
+void addNsec(timespec& time, std::int64_t nsec)
+{
+  time.tv_nsec += nsec;
+  while (time.tv_nsec >= 1000000000) {time.tv_nsec -= 1000000000; ++time.tv_sec;}
+}
+
+/** Statistics of the control loop, preallocated so that recording them does not allocate. */
+struct LoopStats
+{
+  explicit LoopStats(std::size_t capacity) : cycles(0), deadline_misses(0)
+  {
+    cpu_times.reserve(capacity);
+    wakeup_latencies.reserve(capacity);
+  }
+
+  std::vector<double>      cpu_times;        ///< CPU time of each cycle, up to the reserved capacity.
+  std::vector<double>      wakeup_latencies; ///< Delay between the scheduled and the actual start of each cycle.
+  std::atomic<std::size_t> cycles;
+  std::atomic<std::size_t> deadline_misses; ///< Cycles that did not finish before the next one was due.
+};
+
+void controlLoop(SimulatedRobot& robot, controller_manager::ControllerManager& cm, double rate,
+                 const std::atomic<bool>& running, LoopStats& stats)
+{
+  // Best effort: Without the required privileges the loop runs with default scheduling
+  sched_param param;
+  param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+  if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+  {
+    ROS_WARN("Could not set realtime scheduling for the control loop. Results will include scheduling jitter.");
+  }
+
+  const std::int64_t period_nsec = static_cast<std::int64_t>(1e9 / rate);
+  const ros::Duration period(0, period_nsec);
+  timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  while (running)
+  {
+    addNsec(next, period_nsec);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+
+    timespec wakeup, cpu_start, cpu_end, end;
+    clock_gettime(CLOCK_MONOTONIC, &wakeup);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+
+    robot.read();
+    cm.update(ros::Time::now(), period);
+    robot.write(period);
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    ++stats.cycles;
+    if (toSec(end) > toSec(next) + period.toSec()) {++stats.deadline_misses;}
+    if (stats.cpu_times.size() < stats.cpu_times.capacity())
+    {
+      stats.cpu_times.push_back(toSec(cpu_end) - toSec(cpu_start));
+      stats.wakeup_latencies.push_back(toSec(wakeup) - toSec(next));
+    }
+  }
+}
+
+/** Print the mean, median, 99th percentile and maximum of \p values, given in seconds, in microseconds. */
+void printStats(const std::string& name, std::vector<double> values)
+{
+  if (values.empty())
+  {
+    std::printf("  %-24s no samples\n", name.c_str());
+    return;
+  }
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (double value : values) {sum += value;}
+  const auto percentile = [&values](double p) {return values[static_cast<std::size_t>(p * (values.size() - 1))];};
+  std::printf("  %-24s mean %9.1f  p50 %9.1f  p99 %9.1f  max %9.1f  (us, %zu samples)\n", name.c_str(),
+              1e6 * sum / values.size(), 1e6 * percentile(0.5), 1e6 * percentile(0.99), 1e6 * values.back(),
+              values.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "controller_load_benchmark");
+  ros::NodeHandle nh;
+  ros::NodeHandle pnh("~");
+
+  int n_controllers = 1, n_joints = 6, goal_points = 10;
+  double rate = 1000.0, duration = 10.0, goal_period = 0.5;
+  std::string controller_type;
+  pnh.param("controllers", n_controllers, n_controllers);
+  pnh.param("joints", n_joints, n_joints);
+  pnh.param("rate", rate, rate);
+  pnh.param("duration", duration, duration);
+  pnh.param("goal_period", goal_period, goal_period);
+  pnh.param("goal_points", goal_points, goal_points);
+  pnh.param("controller_type", controller_type, std::string("position_controllers/JointTrajectoryController"));
+  if (n_controllers < 1 || n_joints < 1 || goal_points < 1 || rate <= 0.0 || duration <= 0.0 || goal_period <= 0.0)
+  {
+    ROS_ERROR("Invalid benchmark parameters.");
+    return 1;
+  }
+
+  // Robot description and controller configurations, covering all joints
+  std::vector<std::string> controller_names;
+  std::vector<std::vector<std::string> > controller_joints(n_controllers);
+  std::vector<std::string> joint_names;
+  for (int c = 0; c < n_controllers; ++c)
+  {
+    const std::string name = "load_benchmark_controller_" + std::to_string(c);
+    controller_names.push_back(name);
+    for (int j = 0; j < n_joints; ++j)
+    {
+      controller_joints[c].push_back(name + "_joint" + std::to_string(j));
+      joint_names.push_back(controller_joints[c].back());
+    }
+    nh.setParam(name + "/type", controller_type);
+    nh.setParam(name + "/joints", controller_joints[c]);
+    nh.setParam(name + "/state_publish_rate", 50.0);
+    nh.setParam(name + "/stop_trajectory_duration", 0.0);
+  }
+  nh.setParam("robot_description", makeUrdf(joint_names));
+
+  ros::AsyncSpinner spinner(2);
+  spinner.start();
+
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+  {
+    ROS_WARN("Could not lock memory. Results may include page faults.");
+  }
+
+  // Control loop, which must be running to switch controllers
+  SimulatedRobot robot(joint_names);
+  controller_manager::ControllerManager cm(&robot, nh);
+  std::atomic<bool> running(true);
+  LoopStats stats(static_cast<std::size_t>(std::ceil(rate * (duration + 60.0))));
+  std::thread loop_thread(controlLoop, std::ref(robot), std::ref(cm), rate, std::cref(running), std::ref(stats));
+
+  bool ready = true;
+  for (const std::string& name : controller_names) {ready = ready && cm.loadController(name);}
+  ready = ready && cm.switchController(controller_names, std::vector<std::string>(),
+                                       controller_manager_msgs::SwitchController::Request::STRICT);
+
+  std::vector<std::unique_ptr<ActionClient> > clients;
+  for (const std::string& name : controller_names)
+  {
+    clients.emplace_back(new ActionClient(name + "/follow_joint_trajectory", false));
+    ready = ready && clients.back()->waitForServer(ros::Duration(10.0));
+  }
+  if (!ready)
+  {
+    ROS_ERROR("Could not start the benchmark controllers.");
+    running = false;
+    loop_thread.join();
+    return 1;
+  }
+
+  // Goal streams. Goals are sent to the controllers in turn, spread over the goal period
+  std::mutex latency_mutex;
+  std::vector<double> latencies;
+  std::size_t sent_goals = 0;
+  const std::size_t cycles_before = stats.cycles;
+  const std::size_t misses_before = stats.deadline_misses;
+  const std::size_t samples_before = std::min(cycles_before, stats.cpu_times.capacity());
+  ROS_INFO_STREAM("Running " << n_controllers << " controller(s) of " << n_joints << " joint(s) at " << rate <<
+                  " Hz for " << duration << " s.");
+
+  const ros::WallTime start_time = ros::WallTime::now();
+  ros::WallTime next_goal_time = start_time;
+  const ros::WallDuration goal_stagger(goal_period / n_controllers);
+  while (ros::ok() && ros::WallTime::now() - start_time < ros::WallDuration(duration))
+  {
+    ros::WallTime::sleepUntil(next_goal_time);
+    const unsigned int c = sent_goals % n_controllers;
+    const ros::WallTime send_time = ros::WallTime::now();
+    const auto active_cb = [send_time, &latency_mutex, &latencies]()
+    {
+      std::lock_guard<std::mutex> lock(latency_mutex);
+      latencies.push_back((ros::WallTime::now() - send_time).toSec());
+    };
+    clients[c]->sendGoal(makeGoal(controller_joints[c], goal_points, 2.0 * goal_period, sent_goals),
+                         ActionClient::SimpleDoneCallback(), active_cb);
+    ++sent_goals;
+    next_goal_time += goal_stagger;
+  }
+
+  // Stop sampling before reporting
+  const std::size_t cycles = stats.cycles - cycles_before;
+  const std::size_t misses = stats.deadline_misses - misses_before;
+  for (const std::unique_ptr<ActionClient>& client : clients) {client->cancelAllGoals();}
+  running = false;
+  loop_thread.join();
+
+  const std::vector<double> cpu_times(stats.cpu_times.begin() + samples_before, stats.cpu_times.end());
+  const std::vector<double> wakeup_latencies(stats.wakeup_latencies.begin() + samples_before,
+                                             stats.wakeup_latencies.end());
+  std::lock_guard<std::mutex> lock(latency_mutex);
+  std::printf("Load benchmark: %d controller(s) x %d joint(s) at %.0f Hz\n", n_controllers, n_joints, rate);
+  printStats("Cycle CPU time", cpu_times);
+  printStats("Cycle wakeup latency", wakeup_latencies);
+  printStats("Goal acceptance latency", latencies);
+  std::printf("  %-24s %zu of %zu cycles (%.3f%%)\n", "Deadline misses", misses, cycles,
+              cycles ? 100.0 * misses / cycles : 0.0);
+  std::printf("  %-24s %zu sent, %zu accepted\n", "Goals", sent_goals, latencies.size());
+
+  spinner.stop();
+  return 0;
+}
@@ -0,0 +1,405 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks trajectory construction, lookup, sampling and tolerance checking, parameterized by number of joints and
+// number of trajectory points.
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <angles/angles.h>
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <trajectory_interface/packed_quintic_spline_trajectory.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+#include <trajectory_interface/trajectory_interface.h>
+#include <joint_trajectory_controller/init_joint_trajectory.h>
+#include <joint_trajectory_controller/tolerances.h>
+
+using namespace joint_trajectory_controller;
+using namespace trajectory_interface;
+
+typedef QuinticSplineSegment<double>            SplineSegment;
+typedef SplineSegment::State                    State;
+typedef std::vector<SplineSegment>              SplineTrajectory;
+typedef JointTrajectorySegment<SplineSegment>   Segment;
+typedef std::vector<Segment>                    TrajectoryPerJoint;
+typedef std::vector<TrajectoryPerJoint>         Trajectory;
+
+namespace
+{
+
+const double POINT_PERIOD = 0.01;
+
+std::vector<std::string> makeJointNames(unsigned int n_joints)
+{
+  std::vector<std::string> joint_names;
+  for (unsigned int j = 0; j < n_joints; ++j) {joint_names.push_back("joint" + std::to_string(j));}
+  return joint_names;
+}
+
+/** State of dimension \p dim whose values vary with \p time. */
+State makeState(unsigned int dim, double time)
+{
+  State state(dim);
+  for (unsigned int j = 0; j < dim; ++j)
+  {
+    state.position[j]     = std::sin(time + j);
+    state.velocity[j]     = std::cos(time + j);
+    state.acceleration[j] = -std::sin(time + j);
+  }
+  return state;
+}
+
+/** Message with \p n_points points for joints \p joint_names, evenly spaced by POINT_PERIOD. */
+trajectory_msgs::JointTrajectory makeMessage(const std::vector<std::string>& joint_names, unsigned int n_points)
+{
+  trajectory_msgs::JointTrajectory msg;
+  msg.header.stamp = ros::Time(1.0);
+  msg.joint_names  = joint_names;
+  msg.points.resize(n_points);
+  for (unsigned int i = 0; i < n_points; ++i)
+  {
+    const double time = (i + 1) * POINT_PERIOD;
+    const State state = makeState(joint_names.size(), time);
+    msg.points[i].positions       = state.position;
+    msg.points[i].velocities      = state.velocity;
+    msg.points[i].accelerations   = state.acceleration;
+    msg.points[i].time_from_start = ros::Duration(time);
+  }
+  return msg;
+}
+
+/** Controller trajectory holding each of \p n_joints joints at its current position. */
+Trajectory makeHoldTrajectory(unsigned int n_joints)
+{
+  Trajectory trajectory(n_joints);
+  for (unsigned int j = 0; j < n_joints; ++j)
+  {
+    Segment::State state(1);
+    static_cast<State&>(state) = makeState(1, j);
+    trajectory[j].push_back(Segment(0.0, state, 0.0, state));
+  }
+  return trajectory;
+}
+
+/** One-dimensional trajectory with \p n_segments segments of duration POINT_PERIOD. */
+SplineTrajectory makeSplineTrajectory(unsigned int n_segments)
+{
+  SplineTrajectory trajectory;
+  trajectory.reserve(n_segments);
+  for (unsigned int i = 0; i < n_segments; ++i)
+  {
+    const double start_time = i * POINT_PERIOD;
+    const double end_time   = start_time + POINT_PERIOD;
+    trajectory.push_back(SplineSegment(start_time, makeState(1, start_time), end_time, makeState(1, end_time)));
+  }
+  return trajectory;
+}
+
+} // namespace
+
+// QuinticSplineSegment ////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void BM_SegmentInit(benchmark::State& bm_state)
+{
+  const unsigned int dim = bm_state.range(0);
+  const State start_state = makeState(dim, 0.0);
+  const State end_state   = makeState(dim, 1.0);
+  SplineSegment segment(0.0, start_state, 1.0, end_state);
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    segment.init(0.0, start_state, 1.0, end_state);
+    benchmark::ClobberMemory();
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * dim);
+}
+
+static void BM_SegmentSample(benchmark::State& bm_state)
+{
+  const unsigned int dim = bm_state.range(0);
+  const SplineSegment segment(0.0, makeState(dim, 0.0), 1.0, makeState(dim, 1.0));
+  State state(dim);
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    segment.sample(time, state);
+    benchmark::DoNotOptimize(state.position.data());
+    time = (time > 1.0) ? 0.0 : time + 0.001;
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * dim);
+}
+
+// findSegment /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Lookup at monotonically increasing times, as done by the realtime loop. */
+static void BM_FindSegment(benchmark::State& bm_state)
+{
+  const SplineTrajectory trajectory = makeSplineTrajectory(bm_state.range(0));
+  const double duration = trajectory.back().endTime();
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    benchmark::DoNotOptimize(findSegment(trajectory, time));
+    time = (time > duration) ? 0.0 : time + 0.1 * POINT_PERIOD;
+  }
+  allocations.report(bm_state);
+}
+
+/** Hinted lookup at monotonically increasing times, as done by the realtime loop. */
+static void BM_FindSegmentHinted(benchmark::State& bm_state)
+{
+  const SplineTrajectory trajectory = makeSplineTrajectory(bm_state.range(0));
+  const double duration = trajectory.back().endTime();
+  SplineTrajectory::const_iterator hint = trajectory.begin();
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    hint = findSegment(trajectory.begin(), trajectory.end(), time, hint);
+    benchmark::DoNotOptimize(hint);
+    time = (time > duration) ? 0.0 : time + 0.1 * POINT_PERIOD;
+  }
+  allocations.report(bm_state);
+}
+
+// initJointTrajectory /////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum InitMode
+{
+  INIT_BASIC,      ///< Message contains all joints in controller order, no current trajectory.
+  INIT_MAPPING,    ///< Message contains all joints in reverse order.
+  INIT_PARTIAL,    ///< Message contains every other joint.
+  INIT_WRAPAROUND, ///< All joints wrap around, offsets computed from the current trajectory.
+  INIT_REUSE,      ///< As INIT_MAPPING, but building into the storage of the previous iteration's result.
+  INIT_WRAPPING    ///< As INIT_WRAPAROUND, but building into reused storage, as the controller does.
+};
+
+template <InitMode Mode>
+static void BM_InitJointTrajectory(benchmark::State& bm_state)
+{
+  const unsigned int n_joints = bm_state.range(0);
+  const unsigned int n_points = bm_state.range(1);
+
+  std::vector<std::string> joint_names = makeJointNames(n_joints);
+  std::vector<std::string> msg_joint_names = joint_names;
+  if (Mode == INIT_MAPPING) {std::reverse(msg_joint_names.begin(), msg_joint_names.end());}
+  if (Mode == INIT_PARTIAL)
+  {
+    msg_joint_names.clear();
+    for (unsigned int j = 0; j < n_joints; j += 2) {msg_joint_names.push_back(joint_names[j]);}
+  }
+  const trajectory_msgs::JointTrajectory msg = makeMessage(msg_joint_names, n_points);
+
+  Trajectory current_trajectory = makeHoldTrajectory(n_joints);
+  std::vector<char> angle_wraparound(n_joints, true);
+
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.joint_names = &joint_names;
+  if (Mode != INIT_BASIC) {options.current_trajectory = &current_trajectory;}
+  if (Mode == INIT_PARTIAL) {options.allow_partial_joints_goal = true;}
+  if (Mode == INIT_WRAPAROUND || Mode == INIT_WRAPPING) {options.angle_wraparound = &angle_wraparound;}
+
+  const ros::Time time(0.5);
+  Trajectory trajectory; // Only reused with INIT_REUSE
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    if (Mode == INIT_REUSE || Mode == INIT_WRAPPING) {initJointTrajectory<Trajectory>(msg, time, options, trajectory);}
+    else                                             {trajectory = initJointTrajectory<Trajectory>(msg, time, options);}
+    benchmark::DoNotOptimize(trajectory.data());
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * msg_joint_names.size() * n_points);
+  bm_state.counters[controller_instrumentation::benchmark_counters::TIME_PER_1K_POINTS] =
+      controller_instrumentation::benchmark_counters::timePer1kPoints(n_points);
+}
+
+// checkStateTolerancePerJoint /////////////////////////////////////////////////////////////////////////////////////////
+
+/** Path tolerance check of all joints, as done once per cycle by the realtime loop. */
+static void BM_CheckStateTolerancePerJoint(benchmark::State& bm_state)
+{
+  const unsigned int n_joints = bm_state.range(0);
+  std::vector<State> state_errors(n_joints, State(1));
+  for (unsigned int j = 0; j < n_joints; ++j) {state_errors[j] = makeState(1, j);}
+  const StateTolerances<double> tolerances(2.0, 2.0, 2.0);
+
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    bool valid = true;
+    for (const State& state_error : state_errors)
+    {
+      valid = checkStateTolerancePerJoint(state_error, tolerances) && valid;
+    }
+    benchmark::DoNotOptimize(valid);
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * n_joints);
+}
+
+/**
+ * Per-cycle path tolerance work of the realtime loop (gathering the tolerances of all joints and checking them), done
+ * once every \p stride cycles as with the tolerance_check_stride parameter.
+ */
+static void BM_PathToleranceCheckStrided(benchmark::State& bm_state)
+{
+  const unsigned int n_joints = bm_state.range(0);
+  const unsigned int stride   = bm_state.range(1);
+  const State state_error = makeState(n_joints, 0.5);
+  const StateTolerances<double> joint_tolerances(2.0, 2.0, 2.0);
+  StateTolerancesArray<double> tolerances;
+  tolerances.resize(n_joints);
+  ToleranceViolationMask violations(toleranceViolationMaskSize(n_joints));
+
+  unsigned int countdown = 0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    const bool check = countdown == 0;
+    countdown = check ? stride - 1 : countdown - 1;
+    if (!check) {continue;}
+
+    for (unsigned int j = 0; j < n_joints; ++j) {tolerances.set(j, joint_tolerances);}
+    benchmark::DoNotOptimize(checkStateTolerances(state_error, tolerances, violations));
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * n_joints);
+}
+
+// Desired state update ////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum StateUpdateMode
+{
+  UPDATE_PER_JOINT, // Sample per-joint trajectories
+  UPDATE_PACKED     // Sample the packed trajectory
+};
+
+/**
+ * Per-cycle desired state and state error computation of the realtime loop, for a trajectory of 100 points. Sampling
+ * writes into the full-state vectors that are handed to the hardware interface adapter.
+ */
+template <StateUpdateMode Mode>
+static void BM_DesiredStateUpdate(benchmark::State& bm_state)
+{
+  typedef PackedQuinticSplineTrajectory<double> PackedTrajectory;
+
+  const unsigned int n_joints = bm_state.range(0);
+  const Trajectory trajectory = initJointTrajectory<Trajectory>(makeMessage(makeJointNames(n_joints), 100),
+                                                                ros::Time(1.0));
+  PackedTrajectory packed;
+  packed.init(trajectory);
+
+  const State current_state = makeState(n_joints, 0.0);
+  State desired_state(n_joints);
+  State state_error(n_joints);
+  Segment::State desired_joint_state(1);
+  std::vector<TrajectoryPerJoint::size_type> cursors(n_joints, 0);
+  PackedTrajectory::size_type packed_cursor = 0;
+
+  const double start_time = trajectory.front().front().startTime();
+  const double duration   = trajectory.front().back().endTime() - start_time;
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    time = time + 0.001 < duration ? time + 0.001 : 0.0;
+    if (Mode == UPDATE_PACKED) {packed.sample(start_time + time, desired_state, packed_cursor);}
+
+    for (unsigned int j = 0; j < n_joints; ++j)
+    {
+      double position, velocity, acceleration;
+      if (Mode == UPDATE_PER_JOINT)
+      {
+        sample(trajectory[j], start_time + time, desired_joint_state, cursors[j]);
+        position     = desired_joint_state.position[0];
+        velocity     = desired_joint_state.velocity[0];
+        acceleration = desired_joint_state.acceleration[0];
+      }
+      else
+      {
+        position     = desired_state.position[j];
+        velocity     = desired_state.velocity[j];
+        acceleration = desired_state.acceleration[j];
+      }
+      desired_state.position[j]     = position;
+      desired_state.velocity[j]     = velocity;
+      desired_state.acceleration[j] = acceleration;
+      state_error.position[j] = angles::shortest_angular_distance(current_state.position[j], position);
+      state_error.velocity[j] = velocity - current_state.velocity[j];
+    }
+    benchmark::DoNotOptimize(state_error.position.data());
+    benchmark::ClobberMemory();
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * n_joints);
+}
+
+BENCHMARK(BM_SegmentInit)->Arg(1)->Arg(7)->Arg(20);
+BENCHMARK(BM_SegmentSample)->Arg(1)->Arg(7)->Arg(20);
+
+BENCHMARK(BM_FindSegment)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_FindSegmentHinted)->RangeMultiplier(10)->Range(10, 100000);
+
+/** Joint count and point count combinations of initJointTrajectory benchmarks. */
+static void initJointTrajectoryArgs(benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({"joints", "points"})->Unit(benchmark::kMicrosecond);
+  for (int n_joints : {1, 7, 20})
+  {
+    for (int n_points : {10, 1000, 10000}) {bm->Args({n_joints, n_points});}
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_InitJointTrajectory, INIT_BASIC)->Apply(initJointTrajectoryArgs);
+BENCHMARK_TEMPLATE(BM_InitJointTrajectory, INIT_MAPPING)->Apply(initJointTrajectoryArgs);
+BENCHMARK_TEMPLATE(BM_InitJointTrajectory, INIT_PARTIAL)->Apply(initJointTrajectoryArgs);
+BENCHMARK_TEMPLATE(BM_InitJointTrajectory, INIT_WRAPAROUND)->Apply(initJointTrajectoryArgs);
+BENCHMARK_TEMPLATE(BM_InitJointTrajectory, INIT_REUSE)->Apply(initJointTrajectoryArgs);
+
+// Goals of the two continuous joints of the rrbot_wrapping test setup
+BENCHMARK_TEMPLATE(BM_InitJointTrajectory, INIT_WRAPPING)->ArgNames({"joints", "points"})
+                                                         ->Unit(benchmark::kMicrosecond)
+                                                         ->Args({2, 10})->Args({2, 1000});
+
+BENCHMARK(BM_CheckStateTolerancePerJoint)->Arg(1)->Arg(7)->Arg(20)->Arg(64);
+BENCHMARK(BM_PathToleranceCheckStrided)->ArgNames({"joints", "stride"})
+                                       ->Args({7, 1})->Args({7, 4})
+                                       ->Args({64, 1})->Args({64, 4})->Args({64, 16});
+
+BENCHMARK_TEMPLATE(BM_DesiredStateUpdate, UPDATE_PER_JOINT)->Arg(7)->Arg(20)->Arg(64);
+BENCHMARK_TEMPLATE(BM_DesiredStateUpdate, UPDATE_PACKED)->Arg(7)->Arg(20)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+// Compares per-joint quintic spline sampling (runtime and fixed dimension) against batch evaluation across joints.
+// Build with JOINT_TRAJECTORY_CONTROLLER_NATIVE_ARCH=ON to benchmark the vectorized code path.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <controller_instrumentation/benchmark_counters.h>
+#include <trajectory_interface/packed_quintic_spline_trajectory.h>
+#include <trajectory_interface/quintic_spline_batch.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+
+using namespace trajectory_interface;
+
+typedef QuinticSplineSegment<double>          Segment;
+typedef Segment::State                        State;
+typedef std::vector<std::vector<Segment> >    Trajectory;
+typedef PackedQuinticSplineTrajectory<double> PackedTrajectory;
+typedef QuinticSplineSegment<double, 1>       FixedSegment;
+
+namespace
+{
+
+const double DURATION = 2.0;
+
+/** One-dimensional state of \p SegmentType, with zero position, velocity and acceleration. */
+template <class SegmentType>
+typename SegmentType::State makeState() {return typename SegmentType::State(1);}
+
+template <>
+FixedSegment::State makeState<FixedSegment>() {return FixedSegment::State();}
+
+/** Single-segment trajectory with \p n_joints joints. */
+template <class SegmentType = Segment>
+std::vector<std::vector<SegmentType> > makeTrajectory(unsigned int n_joints)
+{
+  std::vector<std::vector<SegmentType> > trajectory(n_joints);
+  for (unsigned int j = 0; j < n_joints; ++j)
+  {
+    typename SegmentType::State start_state = makeState<SegmentType>();
+    start_state.position[0] = 0.1 * j;
+    typename SegmentType::State end_state = makeState<SegmentType>();
+    end_state.position[0]     = 1.0 - 0.2 * j;
+    end_state.velocity[0]     = 0.05 * j;
+    end_state.acceleration[0] = -0.01 * j;
+    trajectory[j].push_back(SegmentType(0.0, start_state, DURATION, end_state));
+  }
+  return trajectory;
+}
+
+/** Coefficient rows of the first segment of each joint in \p trajectory. */
+void makeRows(const Trajectory& trajectory, std::vector<double> (&rows)[6], QuinticSplineBatch<double>& batch)
+{
+  for (unsigned int order = 0; order < 6; ++order)
+  {
+    for (const std::vector<Segment>& joint_traj : trajectory)
+    {
+      rows[order].push_back(joint_traj.front().coefficients(0)[order]);
+    }
+    batch.coefs[order] = rows[order].data();
+  }
+  batch.size = trajectory.size();
+}
+
+/** Advance sampling time, wrapping around at the end of the segment. */
+inline double nextTime(double time)
+{
+  time += 0.001;
+  return (time > DURATION) ? 0.0 : time;
+}
+
+} // namespace
+
+static void BM_SegmentSamplePerJoint(benchmark::State& bm_state)
+{
+  const Trajectory trajectory = makeTrajectory(bm_state.range(0));
+  State joint_state(1);
+  State state(trajectory.size());
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    for (unsigned int j = 0; j < trajectory.size(); ++j)
+    {
+      trajectory[j].front().sample(time, joint_state);
+      state.position[j]     = joint_state.position[0];
+      state.velocity[j]     = joint_state.velocity[0];
+      state.acceleration[j] = joint_state.acceleration[0];
+    }
+    benchmark::DoNotOptimize(state.position.data());
+    time = nextTime(time);
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * trajectory.size());
+}
+
+static void BM_FixedSegmentSamplePerJoint(benchmark::State& bm_state)
+{
+  const std::vector<std::vector<FixedSegment> > trajectory = makeTrajectory<FixedSegment>(bm_state.range(0));
+  FixedSegment::State joint_state;
+  State state(trajectory.size());
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    for (unsigned int j = 0; j < trajectory.size(); ++j)
+    {
+      trajectory[j].front().sample(time, joint_state);
+      state.position[j]     = joint_state.position[0];
+      state.velocity[j]     = joint_state.velocity[0];
+      state.acceleration[j] = joint_state.acceleration[0];
+    }
+    benchmark::DoNotOptimize(state.position.data());
+    time = nextTime(time);
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * trajectory.size());
+}
+
+static void BM_BatchSampleScalar(benchmark::State& bm_state)
+{
+  const Trajectory trajectory = makeTrajectory(bm_state.range(0));
+  std::vector<double> rows[6];
+  QuinticSplineBatch<double> batch;
+  makeRows(trajectory, rows, batch);
+  State state(trajectory.size());
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    internal::sampleQuinticSplineBatchScalar(batch, 0, time,
+                                             state.position.data(), state.velocity.data(), state.acceleration.data());
+    benchmark::DoNotOptimize(state.position.data());
+    time = nextTime(time);
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * trajectory.size());
+}
+
+static void BM_BatchSample(benchmark::State& bm_state)
+{
+  const Trajectory trajectory = makeTrajectory(bm_state.range(0));
+  std::vector<double> rows[6];
+  QuinticSplineBatch<double> batch;
+  makeRows(trajectory, rows, batch);
+  State state(trajectory.size());
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    sampleQuinticSplineBatch(batch, time, state.position.data(), state.velocity.data(), state.acceleration.data());
+    benchmark::DoNotOptimize(state.position.data());
+    time = nextTime(time);
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * trajectory.size());
+  bm_state.SetLabel(isQuinticSplineBatchVectorized() ? "vectorized" : "scalar");
+}
+
+static void BM_PackedTrajectorySample(benchmark::State& bm_state)
+{
+  PackedTrajectory packed;
+  packed.init(makeTrajectory(bm_state.range(0)));
+  State state(packed.dimension());
+  PackedTrajectory::size_type cursor = 0;
+  double time = 0.0;
+  controller_instrumentation::BenchmarkAllocations allocations;
+  for (auto _ : bm_state)
+  {
+    benchmark::DoNotOptimize(packed.sample(time, state, cursor));
+    time = nextTime(time);
+  }
+  allocations.report(bm_state);
+  bm_state.SetItemsProcessed(bm_state.iterations() * packed.dimension());
+}
+
+BENCHMARK(BM_SegmentSamplePerJoint)->Arg(1)->Arg(7)->Arg(8)->Arg(20)->Arg(64);
+BENCHMARK(BM_FixedSegmentSamplePerJoint)->Arg(1)->Arg(7)->Arg(8)->Arg(20)->Arg(64);
+BENCHMARK(BM_BatchSampleScalar)->Arg(1)->Arg(7)->Arg(8)->Arg(20)->Arg(64);
+BENCHMARK(BM_BatchSample)->Arg(1)->Arg(7)->Arg(8)->Arg(20)->Arg(64);
+BENCHMARK(BM_PackedTrajectorySample)->Arg(1)->Arg(7)->Arg(8)->Arg(20)->Arg(64);
+
+BENCHMARK_MAIN();
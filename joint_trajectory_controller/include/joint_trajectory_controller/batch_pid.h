@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_BATCH_PID_H
+#define JOINT_TRAJECTORY_CONTROLLER_BATCH_PID_H
+
+// C++ standard
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Project
+#include <joint_trajectory_controller/realtime_triple_buffer.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief PID controllers of a group of joints, computed in a single pass.
+ *
+ * The gains, integrators and limits of all joints are kept in contiguous arrays, so that the commands of all joints
+ * are computed by one loop over plain data. Commands follow the conventions of
+ * \p control_toolbox::Pid::computeCommand(error, error_dot, dt):
+ * - The command of a joint is zero when its error or error derivative is not finite, in which case its integrator is
+ * left unchanged. All commands are zero when \p dt is not positive.
+ * - Without antiwindup, the integral term is clamped to <tt>[i_min, i_max]</tt>. With antiwindup, the integrator
+ * itself is clamped, so that the integral term stays within these bounds.
+ *
+ * Gains are handed over to the realtime thread through a wait-free buffer, so updating them never blocks
+ * \ref computeCommands.
+ */
+class BatchPid
+{
+public:
+  /** \brief Gains of all joints, one array element per joint. */
+  struct Gains
+  {
+    void resize(std::size_t size)
+    {
+      p.resize(size, 0.0);
+      i.resize(size, 0.0);
+      d.resize(size, 0.0);
+      i_max.resize(size, 0.0);
+      i_min.resize(size, 0.0);
+      antiwindup.resize(size, 0);
+    }
+
+    bool operator==(const Gains& other) const
+    {
+      return p == other.p && i == other.i && d == other.d && i_max == other.i_max && i_min == other.i_min &&
+             antiwindup == other.antiwindup;
+    }
+    bool operator!=(const Gains& other) const {return !(*this == other);}
+
+    std::vector<double> p;
+    std::vector<double> i;
+    std::vector<double> d;
+    std::vector<double> i_max;      ///< Upper bound of the integral term.
+    std::vector<double> i_min;      ///< Lower bound of the integral term.
+    std::vector<char>   antiwindup; ///< Nonzero to clamp the integrator instead of the integral term.
+  };
+
+  /**
+   * \brief Resize the controllers to \p size joints, with zero gains and integrators.
+   * \note This method is \b not real-time safe.
+   */
+  void init(std::size_t size)
+  {
+    Gains gains;
+    gains.resize(size);
+    gains_buffer_.write(gains);
+    i_error_.assign(size, 0.0);
+  }
+
+  /**
+   * \brief Set the gains used from the next call to \ref computeCommands on.
+   * \pre \p gains has \ref size elements per array.
+   * \note This method is wait-free, but copies \p gains, and must always be called from the same (non real-time)
+   * thread.
+   */
+  void setGains(const Gains& gains)
+  {
+    assert(gains.p.size() == size());
+    gains_buffer_.write(gains);
+  }
+
+  /**
+   * \brief Zero the integrators of all joints.
+   * \note This method is realtime-safe.
+   */
+  void reset() {std::fill(i_error_.begin(), i_error_.end(), 0.0);}
+
+  /**
+   * \brief Compute the commands of all joints.
+   * \param error Error of each joint.
+   * \param error_dot Error derivative of each joint.
+   * \param dt Time elapsed since the last call.
+   * \param[out] command Command of each joint. Must be preallocated to \ref size elements.
+   * \note This method is realtime-safe.
+   */
+  void computeCommands(const std::vector<double>& error,
+                       const std::vector<double>& error_dot,
+                       double                     dt,
+                       std::vector<double>&       command)
+  {
+    const Gains& gains = gains_buffer_.read();
+    const std::size_t n = i_error_.size();
+    assert(error.size() >= n && error_dot.size() >= n && command.size() >= n);
+
+    if (!(dt > 0.0))
+    {
+      std::fill(command.begin(), command.begin() + n, 0.0);
+      return;
+    }
+
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      const bool valid = std::isfinite(error[j]) && std::isfinite(error_dot[j]);
+
+      double i_error = valid ? i_error_[j] + dt * error[j] : i_error_[j];
+      const double i_gain_abs = std::abs(gains.i[j]);
+      const bool clamp_integrator = gains.antiwindup[j] && i_gain_abs > 0.0;
+      if (clamp_integrator)
+      {
+        i_error = std::min(std::max(i_error, gains.i_min[j] / i_gain_abs), gains.i_max[j] / i_gain_abs);
+      }
+      i_error_[j] = i_error;
+
+      double i_term = gains.i[j] * i_error;
+      if (!gains.antiwindup[j]) {i_term = std::min(std::max(i_term, gains.i_min[j]), gains.i_max[j]);}
+
+      const double value = gains.p[j] * error[j] + i_term + gains.d[j] * error_dot[j];
+      command[j] = valid ? value : 0.0;
+    }
+  }
+
+  /** \return Number of joints. */
+  std::size_t size() const {return i_error_.size();}
+
+private:
+  RealtimeTripleBuffer<Gains> gains_buffer_;
+  std::vector<double>         i_error_; ///< Integrated error of each joint. Only used by the realtime thread.
+};
+
+} // namespace
+
+#endif // header guard
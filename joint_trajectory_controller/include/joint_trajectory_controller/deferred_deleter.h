@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_DEFERRED_DELETER_H
+#define JOINT_TRAJECTORY_CONTROLLER_DEFERRED_DELETER_H
+
+// C++ standard
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Releases shared pointers from a background thread.
+ *
+ * Dropping the last reference to a large object (e.g. a trajectory with thousands of segments) can take a significant
+ * amount of time. Objects handed over with \ref retire are released by a dedicated thread instead, so that the calling
+ * thread only pays for a queue insertion. The worker thread is started on the first call to \ref retire.
+ *
+ * Upon destruction, the worker thread is stopped and still-pending objects are released by the destroying thread.
+ *
+ * \tparam T Pointed-to data type.
+ */
+template <class T>
+class DeferredDeleter
+{
+public:
+  typedef std::shared_ptr<T> Ptr;
+
+  DeferredDeleter()
+    : stop_(false),
+      pending_(0)
+  {}
+
+  DeferredDeleter(const DeferredDeleter&) = delete;
+  DeferredDeleter& operator=(const DeferredDeleter&) = delete;
+
+  ~DeferredDeleter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_one();
+    if (worker_.joinable()) {worker_.join();}
+  }
+
+  /**
+   * \brief Queue \p ptr for release by the worker thread.
+   * \note This method is \b not real-time safe.
+   */
+  void retire(Ptr ptr)
+  {
+    if (!ptr) {return;}
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!worker_.joinable()) {worker_ = std::thread(&DeferredDeleter::run, this);}
+      queue_.push_back(std::move(ptr));
+      ++pending_;
+    }
+    cond_.notify_one();
+  }
+
+  /**
+   * \return Number of retired objects that have not been released yet.
+   * \note This method is realtime-safe.
+   */
+  std::size_t pending() const {return pending_.load();}
+
+private:
+  std::mutex               mutex_;
+  std::condition_variable  cond_;
+  std::vector<Ptr>         queue_;   ///< Retired objects waiting to be released.
+  bool                     stop_;    ///< Request worker thread termination.
+  std::atomic<std::size_t> pending_;
+  std::thread              worker_;
+
+  void run()
+  {
+    std::vector<Ptr> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+      cond_.wait(lock, [this] {return stop_ || !queue_.empty();});
+      if (queue_.empty()) {break;} // Only exit once the queue has been drained
+
+      // Release outside the lock so producers are not blocked by object destruction
+      batch.swap(queue_);
+      lock.unlock();
+      const std::size_t size = batch.size();
+      batch.clear();
+      pending_ -= size;
+      lock.lock();
+    }
+  }
+};
+
+} // namespace
+
+#endif // header guard
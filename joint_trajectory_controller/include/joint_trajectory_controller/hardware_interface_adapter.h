@@ -31,6 +31,8 @@
 #define JOINT_TRAJECTORY_CONTROLLER_HARDWARE_INTERFACE_ADAPTER_H
 
 #include <cassert>
+#include <cmath>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -38,11 +40,14 @@
 #include <ros/node_handle.h>
 #include <ros/time.h>
 
-#include <control_toolbox/pid.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <hardware_interface/posvel_command_interface.h>
 #include <hardware_interface/posvelacc_command_interface.h>
 
+#include <joint_trajectory_controller/batch_pid.h>
+#include <joint_trajectory_controller/joint_command_writer.h>
+#include <joint_trajectory_controller/parameter_server.h>
+
 /**
  * \brief Helper class to simplify integrating the JointTrajectoryController with different hardware interfaces.
  *
@@ -100,6 +105,7 @@ public:
   {
     // Store pointer to joint handles
     joint_handles_ptr_ = &joint_handles;
+    command_writer_.init(joint_handles);
 
     return true;
   }
@@ -123,19 +129,29 @@ public:
                      const State&         /*state_error*/)
   {
     // Forward desired position to command
-    const unsigned int n_joints = joint_handles_ptr_->size();
-    for (unsigned int i = 0; i < n_joints; ++i) {(*joint_handles_ptr_)[i].setCommand(desired_state.position[i]);}
+    command_writer_.write(desired_state.position);
   }
 
 private:
   std::vector<hardware_interface::JointHandle>* joint_handles_ptr_;
+  joint_trajectory_controller::JointCommandWriter command_writer_;
 };
 
 /**
  * \brief Helper base class template for closed loop HardwareInterfaceAdapter implementations.
  *
- * Adapters leveraging (specializing) this class will generate a command given the desired state and state error using a
- * velocity feedforward term plus a corrective PID term.
+ * Adapters leveraging (specializing) this class will generate a command given the desired state and state error using
+ * velocity and acceleration feedforward terms plus a corrective PID term. With an effort-controlled joint, the
+ * acceleration feedforward gain is the inertia seen by the joint, and lets the PID only correct the tracking error left
+ * by the dynamics that are not modelled.
+ *
+ * The PID terms of all joints are computed in a single pass by a joint_trajectory_controller::BatchPid. Gains are
+ * loaded from the \p gains/<joint> namespaces with the parameters of \p control_toolbox::Pid: \p p (required), \p i,
+ * \p d, \p i_clamp, \p i_clamp_min, \p i_clamp_max and \p antiwindup. The gains of all joints are reconfigured
+ * through the single \ref ParameterServer of the controller, as its \p <joint>_p, \p <joint>_i, \p <joint>_d,
+ * \p <joint>_i_clamp_min, \p <joint>_i_clamp_max and \p <joint>_antiwindup parameters, and handed over to the
+ * realtime thread as one snapshot, without locking.
+ * Commands are staged in a contiguous array and written to the joint handles in one pass.
  *
  * Use one of the available template specializations of this class (or create your own) to adapt the
  * JointTrajectoryController to a specific hardware interface.
@@ -151,27 +167,37 @@ public:
     // Store pointer to joint handles
     joint_handles_ptr_ = &joint_handles;
 
-    // Initialize PIDs
-    pids_.resize(joint_handles.size());
-    for (unsigned int i = 0; i < pids_.size(); ++i)
+    // Initialize PIDs from ROS parameter server
+    const unsigned int n_joints = joint_handles.size();
+    BatchPid::Gains gains;
+    gains.resize(n_joints);
+    std::vector<ParameterDescription> parameters;
+    for (unsigned int i = 0; i < n_joints; ++i)
     {
-      // Node handle to PID gains
-      ros::NodeHandle joint_nh(controller_nh, std::string("gains/") + joint_handles[i].getName());
-
-      // Init PID gains from ROS parameter server
-      pids_[i].reset(new control_toolbox::Pid());
-      if (!pids_[i]->init(joint_nh))
+      const std::string& joint_name = joint_handles[i].getName();
+      if (!loadGains(ros::NodeHandle(controller_nh, "gains/" + joint_name), i, gains))
       {
         ROS_WARN_STREAM("Failed to initialize PID gains from ROS parameter server.");
         return false;
       }
+      addGainParameters(joint_name, parameters);
     }
+    batch_pid_.init(n_joints);
+    batch_pid_.setGains(gains);
+    commands_.resize(n_joints, 0.0);
+    command_writer_.init(joint_handles);
 
-    // Load velocity feedforward gains from parameter server
+    // Reconfigure all gains at once. The server serializes updates, so batch_pid_ always has a single writer
+    gains_group_.init(controller_nh, "gains", parameters, toValues(gains),
+                      std::bind(&ClosedLoopHardwareInterfaceAdapter::gainsCB, this, std::placeholders::_1));
+
+    // Load velocity and acceleration feedforward gains from parameter server
     velocity_ff_.resize(joint_handles.size());
+    acceleration_ff_.resize(joint_handles.size());
     for (unsigned int i = 0; i < velocity_ff_.size(); ++i)
     {
       controller_nh.param(std::string("velocity_ff/") + joint_handles[i].getName(), velocity_ff_[i], 0.0);
+      controller_nh.param(std::string("acceleration_ff/") + joint_handles[i].getName(), acceleration_ff_[i], 0.0);
     }
 
     return true;
@@ -182,9 +208,9 @@ public:
     if (!joint_handles_ptr_) {return;}
 
     // Reset PIDs, zero commands
-    for (unsigned int i = 0; i < pids_.size(); ++i)
+    batch_pid_.reset();
+    for (unsigned int i = 0; i < joint_handles_ptr_->size(); ++i)
     {
-      pids_[i]->reset();
       (*joint_handles_ptr_)[i].setCommand(0.0);
     }
   }
@@ -196,29 +222,108 @@ public:
                      const State&         desired_state,
                      const State&         state_error)
   {
-    const unsigned int n_joints = joint_handles_ptr_->size();
-
     // Preconditions
     if (!joint_handles_ptr_)
       return;
+    const unsigned int n_joints = joint_handles_ptr_->size();
     assert(n_joints == state_error.position.size());
     assert(n_joints == state_error.velocity.size());
+    assert(n_joints == desired_state.acceleration.size());
 
-    // Update PIDs
+    // Update PIDs, add feedforward terms and commit all commands
+    batch_pid_.computeCommands(state_error.position, state_error.velocity, period.toSec(), commands_);
     for (unsigned int i = 0; i < n_joints; ++i)
     {
-      const double command = (desired_state.velocity[i] * velocity_ff_[i]) + pids_[i]->computeCommand(state_error.position[i], state_error.velocity[i], period);
-      (*joint_handles_ptr_)[i].setCommand(command);
+      commands_[i] += desired_state.velocity[i] * velocity_ff_[i] + desired_state.acceleration[i] * acceleration_ff_[i];
     }
+    command_writer_.write(commands_);
   }
 
 private:
-  typedef std::shared_ptr<control_toolbox::Pid> PidPtr;
-  std::vector<PidPtr> pids_;
+  typedef joint_trajectory_controller::BatchPid BatchPid;
+  typedef joint_trajectory_controller::ParameterDescription ParameterDescription;
+
+  static constexpr unsigned int GAINS_PER_JOINT = 6; ///< p, i, d, i_clamp_min, i_clamp_max and antiwindup.
+
+  /** \brief Load the gains of joint \p i from \p nh, like \p control_toolbox::Pid::init(). */
+  static bool loadGains(const ros::NodeHandle& nh, unsigned int i, BatchPid::Gains& gains)
+  {
+    if (!nh.getParam("p", gains.p[i]))
+    {
+      ROS_ERROR_STREAM("No p gain specified for pid. Namespace: " << nh.getNamespace());
+      return false;
+    }
+    nh.param("i", gains.i[i], 0.0);
+    nh.param("d", gains.d[i], 0.0);
+
+    double i_clamp = 0.0;
+    nh.param("i_clamp", i_clamp, 0.0);
+    nh.param("i_clamp_max", gains.i_max[i],  std::abs(i_clamp));
+    nh.param("i_clamp_min", gains.i_min[i], -std::abs(i_clamp));
+
+    bool antiwindup = false;
+    nh.param("antiwindup", antiwindup, false);
+    gains.antiwindup[i] = antiwindup;
+    return true;
+  }
+
+  static void addGainParameters(const std::string& joint_name, std::vector<ParameterDescription>& parameters)
+  {
+    const std::string param = "gains/" + joint_name + "/";
+    parameters.push_back({joint_name + "_p", param + "p", "Proportional gain of " + joint_name + ".",
+                          -100000.0, 100000.0, false});
+    parameters.push_back({joint_name + "_i", param + "i", "Integral gain of " + joint_name + ".",
+                          -100000.0, 100000.0, false});
+    parameters.push_back({joint_name + "_d", param + "d", "Derivative gain of " + joint_name + ".",
+                          -100000.0, 100000.0, false});
+    parameters.push_back({joint_name + "_i_clamp_min", param + "i_clamp_min",
+                          "Lower bound of the integral term of " + joint_name + ".", -100000.0, 0.0, false});
+    parameters.push_back({joint_name + "_i_clamp_max", param + "i_clamp_max",
+                          "Upper bound of the integral term of " + joint_name + ".", 0.0, 100000.0, false});
+    parameters.push_back({joint_name + "_antiwindup", param + "antiwindup",
+                          "Clamp the integrator of " + joint_name + " instead of its integral term.", 0.0, 1.0, true});
+  }
+
+  /** \return Gains of all joints, in the order of the parameters of addGainParameters(). */
+  static std::vector<double> toValues(const BatchPid::Gains& gains)
+  {
+    std::vector<double> values;
+    values.reserve(gains.p.size() * GAINS_PER_JOINT);
+    for (unsigned int i = 0; i < gains.p.size(); ++i)
+    {
+      values.insert(values.end(), {gains.p[i], gains.i[i], gains.d[i], gains.i_min[i], gains.i_max[i],
+                                   gains.antiwindup[i] ? 1.0 : 0.0});
+    }
+    return values;
+  }
+
+  void gainsCB(const std::vector<double>& values)
+  {
+    BatchPid::Gains gains;
+    gains.resize(batch_pid_.size());
+    for (unsigned int i = 0; i < batch_pid_.size(); ++i)
+    {
+      const double* joint_values = &values[i * GAINS_PER_JOINT];
+      gains.p[i]          = joint_values[0];
+      gains.i[i]          = joint_values[1];
+      gains.d[i]          = joint_values[2];
+      gains.i_min[i]      = joint_values[3];
+      gains.i_max[i]      = joint_values[4];
+      gains.antiwindup[i] = joint_values[5] != 0.0;
+    }
+    batch_pid_.setGains(gains);
+  }
+
+  joint_trajectory_controller::BatchPid           batch_pid_;
+  std::vector<double>                             commands_;   ///< Preallocated staging array of joint commands.
+  joint_trajectory_controller::JointCommandWriter command_writer_;
 
   std::vector<double> velocity_ff_;
+  std::vector<double> acceleration_ff_;   ///< Zero unless specified.
 
   std::vector<hardware_interface::JointHandle>* joint_handles_ptr_;
+
+  joint_trajectory_controller::ParameterGroup gains_group_; ///< Declared last, so that it is unregistered first.
 };
 
 /**
@@ -256,8 +361,8 @@ class HardwareInterfaceAdapter<hardware_interface::VelocityJointInterface, State
  * \brief Adapter for an effort-controlled hardware interface. Maps position and velocity errors to effort commands
  * through a position PID loop.
  *
- * The following is an example configuration of a controller that uses this adapter. Notice the \p gains and \p velocity_ff
- * entries:
+ * The following is an example configuration of a controller that uses this adapter. Notice the \p gains, \p velocity_ff
+ * and optional \p acceleration_ff entries, the latter being the inertia seen by each joint:
  * \code
  * head_controller:
  *   type: "effort_controllers/JointTrajectoryController"
@@ -270,6 +375,9 @@ class HardwareInterfaceAdapter<hardware_interface::VelocityJointInterface, State
  *   velocity_ff:
  *     head_1_joint: 1.0
  *     head_2_joint: 1.0
+ *   acceleration_ff:
+ *     head_1_joint: 0.05
+ *     head_2_joint: 0.02
  *   constraints:
  *     goal_time: 0.6
  *     stopped_velocity_tolerance: 0.02
@@ -32,9 +32,13 @@
 
 // C++ standard
 #include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 // Boost
@@ -50,19 +54,44 @@
 // Project
 #include <joint_trajectory_controller/joint_trajectory_msg_utils.h>
 #include <joint_trajectory_controller/joint_trajectory_segment.h>
+#include <joint_trajectory_controller/worker_pool.h>
 
 namespace joint_trajectory_controller
 {
 
+/** \brief Map from joint names to their index in a joint name sequence. */
+typedef std::unordered_map<std::string, unsigned int> JointNameIndex;
+
+/**
+ * \return Index of the elements of \p joint_names, for use in \ref internal::mapping "mapping" computations.
+ * If \p joint_names contains duplicates, the first occurrence is indexed.
+ */
+template <class T>
+inline JointNameIndex makeJointNameIndex(const T& joint_names)
+{
+  JointNameIndex index(joint_names.size());
+  for (typename T::const_iterator it = joint_names.begin(); it != joint_names.end(); ++it)
+  {
+    index.emplace(*it, std::distance(joint_names.begin(), it));
+  }
+  return index;
+}
+
 namespace internal
 {
 /**
  * \return The map between \p t1 indices (implicitly encoded in return vector indices) to \t2 indices.
  * If \p t1 is <tt>"{C, B}"</tt> and \p t2 is <tt>"{A, B, C, D}"</tt>, the associated mapping vector is
  * <tt>"{2, 1}"</tt>.
+ *
+ * The leading elements of \p t1 that match those of \p t2 are mapped without any lookups, so the common case of
+ * \p t1 and \p t2 listing the same elements in the same order costs a single element-wise comparison.
+ * The remaining elements are looked up in \p t2_index if specified, or searched linearly in \p t2 otherwise.
+ *
+ * \param t2_index Optional index of \p t2, as built by \ref makeJointNameIndex. It must be consistent with \p t2.
  */
 template <class T>
-inline std::vector<unsigned int> mapping(const T& t1, const T& t2)
+inline std::vector<unsigned int> mapping(const T& t1, const T& t2, const JointNameIndex* t2_index = nullptr)
 {
   typedef unsigned int SizeType;
 
@@ -70,20 +99,153 @@ inline std::vector<unsigned int> mapping(const T& t1, const T& t2)
   if (t1.size() > t2.size()) {return std::vector<SizeType>();}
 
   std::vector<SizeType> mapping_vector(t1.size()); // Return value
-  for (typename T::const_iterator t1_it = t1.begin(); t1_it != t1.end(); ++t1_it)
+
+  // Fast path: Leading elements in the same order
+  typename T::const_iterator t1_it = std::mismatch(t1.begin(), t1.end(), t2.begin()).first;
+  const SizeType n_ordered = std::distance(t1.begin(), t1_it);
+  for (SizeType i = 0; i < n_ordered; ++i) {mapping_vector[i] = i;}
+
+  for (; t1_it != t1.end(); ++t1_it)
   {
-    typename T::const_iterator t2_it = std::find(t2.begin(), t2.end(), *t1_it);
-    if (t2.end() == t2_it) {return std::vector<SizeType>();}
+    const SizeType t1_dist = std::distance(t1.begin(), t1_it);
+    if (t2_index)
+    {
+      const JointNameIndex::const_iterator index_it = t2_index->find(*t1_it);
+      if (t2_index->end() == index_it) {return std::vector<SizeType>();}
+      mapping_vector[t1_dist] = index_it->second;
+    }
     else
     {
-      const SizeType t1_dist = std::distance(t1.begin(), t1_it);
-      const SizeType t2_dist = std::distance(t2.begin(), t2_it);
-      mapping_vector[t1_dist] = t2_dist;
+      typename T::const_iterator t2_it = std::find(t2.begin(), t2.end(), *t1_it);
+      if (t2.end() == t2_it) {return std::vector<SizeType>();}
+      mapping_vector[t1_dist] = std::distance(t2.begin(), t2_it);
     }
   }
   return mapping_vector;
 }
 
+/**
+ * \brief Extract the state of a single joint from a trajectory point, reusing the storage of \p state.
+ *
+ * \param point Multi-joint trajectory point.
+ * \param index Index of the joint in \p point.
+ * \param position_offset Offset to add to the joint position.
+ * \param state Single-joint state. Fields absent from \p point are left empty.
+ */
+template <class State>
+inline void jointState(const trajectory_msgs::JointTrajectoryPoint& point,
+                       const unsigned int                           index,
+                       const typename State::Scalar&                position_offset,
+                       State&                                       state)
+{
+  state.position.resize(point.positions.empty() ? 0 : 1);
+  state.velocity.resize(point.velocities.empty() ? 0 : 1);
+  state.acceleration.resize(point.accelerations.empty() ? 0 : 1);
+  if (!point.positions.empty())     {state.position[0]     = point.positions[index] + position_offset;}
+  if (!point.velocities.empty())    {state.velocity[0]     = point.velocities[index];}
+  if (!point.accelerations.empty()) {state.acceleration[0] = point.accelerations[index];}
+}
+
+/**
+ * \brief Find the end of the range of trajectory points to fit.
+ *
+ * \param first First point to fit.
+ * \param last End of the point sequence.
+ * \param start_time Time the \p time_from_start of the points is relative to.
+ * \param end_time If not null, points up to the first one reached at or after this time are fitted.
+ * \return One past the last point to fit. Unless the sequence is exhausted, the range contains at least two points, so
+ * that it yields at least one segment.
+ */
+inline std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator
+fittingEnd(std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator first,
+           std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator last,
+           const ros::Time&                                                   start_time,
+           const ros::Time*                                                   end_time)
+{
+  if (!end_time || std::distance(first, last) <= 2) {return last;}
+
+  typedef std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator PointIter;
+  PointIter it = std::lower_bound(first, last, *end_time,
+                                  [&start_time](const trajectory_msgs::JointTrajectoryPoint& point, const ros::Time& time)
+                                  {return start_time + point.time_from_start < time;});
+  if (it == last) {return last;}
+  return std::max(it, first + 1) + 1;
+}
+
+/**
+ * \brief Select the points of a dense trajectory that are kept as segment boundaries (knots).
+ *
+ * Knots are selected greedily from \p first on: the next knot is the farthest point such that, for all the joints of
+ * the points, the segment between the two knots passes within \p tolerance of the positions of the points it skips.
+ * Candidate spans are doubled until one fails, and the longest passing span is then found by bisection, so selecting
+ * the knots of \e n points with spans of \e k points takes <em>O(n log k)</em> segment samples per joint.
+ *
+ * \param first First point, which is always a knot.
+ * \param last End of the point sequence. The last point is always a knot.
+ * \param n_joints Number of joints of the points.
+ * \param tolerance Maximum position deviation at the skipped points.
+ * \param[out] knots Offsets of the knots from \p first, in increasing order.
+ *
+ * \tparam Segment Segment type the knots are fitted with.
+ */
+template <class Segment>
+void reduceKnots(std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator first,
+                 std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator last,
+                 const unsigned int                                                 n_joints,
+                 const typename Segment::Scalar&                                    tolerance,
+                 std::vector<std::size_t>&                                          knots)
+{
+  const std::size_t n_points = std::distance(first, last);
+  knots.assign(1, 0);
+  if (n_points < 2) {return;}
+
+  // Segment and states reused across candidate spans. Positions are compared without offset, as segments are fitted
+  // from and compared to the same positions
+  typename Segment::State start_state, end_state, state;
+  jointState(first[0], 0, 0.0, start_state);
+  jointState(first[1], 0, 0.0, end_state);
+  Segment segment(0.0, start_state, 1.0, end_state);
+
+  auto within_tolerance = [&](std::size_t begin, std::size_t end)
+  {
+    const typename Segment::Time start_time = first[begin].time_from_start.toSec();
+    const typename Segment::Time end_time   = first[end].time_from_start.toSec();
+    for (unsigned int joint = 0; joint < n_joints; ++joint)
+    {
+      jointState(first[begin], joint, 0.0, start_state);
+      jointState(first[end],   joint, 0.0, end_state);
+      segment.init(start_time, start_state, end_time, end_state);
+      for (std::size_t k = begin + 1; k < end; ++k)
+      {
+        segment.sample(first[k].time_from_start.toSec(), state);
+        if (!(std::abs(state.position[0] - first[k].positions[joint]) <= tolerance)) {return false;}
+      }
+    }
+    return true;
+  };
+
+  for (std::size_t begin = 0; begin + 1 < n_points;)
+  {
+    // Longest span known to pass, and shortest span known to fail or past the last point
+    std::size_t pass = 1;
+    std::size_t fail = 2;
+    while (begin + fail < n_points && within_tolerance(begin, begin + fail))
+    {
+      pass = fail;
+      fail *= 2;
+    }
+    fail = std::min(fail, n_points - begin);
+    while (fail - pass > 1)
+    {
+      const std::size_t span = pass + (fail - pass) / 2;
+      if (within_tolerance(begin, begin + span)) {pass = span;}
+      else                                       {fail = span;}
+    }
+    begin += pass;
+    knots.push_back(begin);
+  }
+}
+
 } // namespace
 
 /**
@@ -102,22 +264,36 @@ struct InitJointTrajectoryOptions
   InitJointTrajectoryOptions()
     : current_trajectory(0),
       joint_names(0),
+      joint_name_index(0),
       angle_wraparound(0),
       rt_goal_handle(),
       default_tolerances(0),
       other_time_base(0),
       allow_partial_joints_goal(false),
-      error_string(0)
+      error_string(0),
+      fitting_pool(0),
+      parallel_fitting_threshold(0),
+      fitting_end_time(0),
+      end_point(0),
+      start_time(0),
+      knot_tolerance(0.0)
   {}
 
-  Trajectory*                current_trajectory;
+  const Trajectory*          current_trajectory;
   std::vector<std::string>*  joint_names;
-  std::vector<bool>*         angle_wraparound;
+  const JointNameIndex*      joint_name_index;
+  const std::vector<char>*   angle_wraparound;
   RealtimeGoalHandlePtr      rt_goal_handle;
   SegmentTolerances<Scalar>* default_tolerances;
   ros::Time*                 other_time_base;
   bool                       allow_partial_joints_goal;
   std::string*               error_string;
+  WorkerPool*                fitting_pool;
+  std::size_t                parallel_fitting_threshold;
+  const ros::Time*           fitting_end_time;
+  std::size_t*               end_point;
+  const ros::Time*           start_time;
+  Scalar                     knot_tolerance;
 
   void setErrorString(const std::string &msg) const
   {
@@ -129,11 +305,47 @@ struct InitJointTrajectoryOptions
 };
 
 template <class Trajectory>
-bool isNotEmpty(typename Trajectory::value_type trajPerJoint)
+bool isNotEmpty(const typename Trajectory::value_type& trajPerJoint)
 {
   return !trajPerJoint.empty();
 };
 
+/**
+ * \name Per-joint trajectory sharing
+ * Trajectories that are sequences of per-joint segment containers copy segments between them. Trajectory types that
+ * can share per-joint segments, like \ref MultiJointTrajectory, overload these helpers.
+ * \{
+ */
+
+/** \brief Make joint \p joint_id of \p result follow the segments of the same joint of \p source. */
+template <class Trajectory>
+void shareJointTrajectory(const Trajectory& source, unsigned int joint_id, Trajectory& result)
+{
+  result[joint_id] = source[joint_id];
+}
+
+/** \brief Associate the segments of joint \p joint_id from index \p first_segment on to an action goal. */
+template <class Trajectory>
+void setJointGoalHandle(Trajectory&                                                                  trajectory,
+                        unsigned int                                                                 joint_id,
+                        std::size_t                                                                  first_segment,
+                        const typename Trajectory::value_type::value_type::RealtimeGoalHandlePtr& rt_goal_handle)
+{
+  typename Trajectory::value_type& joint_traj = trajectory[joint_id];
+  for (std::size_t k = first_segment; k < joint_traj.size(); ++k) {joint_traj[k].setGoalHandle(rt_goal_handle);}
+}
+
+/** \return Action goal that segment \p segment_it of joint \p joint_id is associated to. */
+template <class Trajectory>
+typename Trajectory::value_type::value_type::RealtimeGoalHandlePtr
+jointGoalHandle(const Trajectory&                                  /*trajectory*/,
+                unsigned int                                       /*joint_id*/,
+                typename Trajectory::value_type::const_iterator    segment_it)
+{
+  return segment_it->getGoalHandle();
+}
+/** \} */
+
 /**
  * \brief Initialize a joint trajectory from ROS message data.
  *
@@ -158,7 +370,12 @@ bool isNotEmpty(typename Trajectory::value_type trajPerJoint)
  * (and not \p msg). If unspecified (empty), no checks will be performed against expected joints, and the resulting
  * trajectory will preserve the joint ordering of \p msg.
  *
- * - \b angle_wraparound Vector of booleans where true values correspond to joints that wrap around (ie. are continuous).
+ * - \b joint_name_index Index of \p joint_names, as built by \ref makeJointNameIndex. If specified, message joints
+ * that are not in the same order as \p joint_names are looked up in it, instead of searched linearly. It is ignored if
+ * \p joint_names is unspecified.
+ *
+ * - \b angle_wraparound Per-joint flags where nonzero values correspond to joints that wrap around (ie. are
+ * continuous). Flags are stored as bytes rather than in a \p std::vector<bool>, so reading them needs no bit extraction.
  * If specified, combining \p current_trajectory with \p msg will not result in joints performing multiple turns at the
  * transition. This parameter \b requires \p current_trajectory to also be specified, otherwise it is ignored.
  *
@@ -179,21 +396,45 @@ bool isNotEmpty(typename Trajectory::value_type trajPerJoint)
  * - \b error_string Error message. If specified, an error message will be written to this string in case of failure to
  * initialize the output trajectory from \p msg.
  *
- * \return Trajectory container.
+ * - \b fitting_pool Worker pool used to fit the segments of different joints in parallel. If unspecified, joints are
+ * fitted one after another by the calling thread. The result does not depend on whether joints are fitted in parallel.
+ *
+ * - \b parallel_fitting_threshold Minimum number of new segments (joints times points of \p msg) for joints to be
+ * fitted in parallel. Smaller messages are fitted by the calling thread, as the parallelization overhead would
+ * outweigh its benefit. Only used when \p fitting_pool is also specified.
+ *
+ * - \b fitting_end_time If specified, only the points of \p msg up to the first one reached at or after this time are
+ * fitted, so the cost of fitting a long message is bounded. The remaining points can be fitted later on with
+ * \ref extendJointTrajectory. Expressed in the time base of \p time.
+ *
+ * - \b end_point If specified, the index of the last point of \p msg that was fitted is written to it on success.
+ *
+ * - \b start_time If specified, the start time of \p msg, which takes precedence over its header stamp. Expressed in
+ * the time base of \p time.
+ *
+ * - \b knot_tolerance If positive, dense messages are fitted with fewer segments: points that the segments between
+ * the remaining points pass within this position tolerance of are dropped, see \ref internal::reduceKnots. Knots are
+ * shared by all joints, so the result can still be packed. Zero by default, in which case every point is kept.
+ *
+ * \param result_traj Output trajectory container. Its storage is reused, so initializing into a previously used
+ * trajectory of similar size performs few or no memory allocations. It is emptied on failure, and must not refer to the
+ * same object as \p options.current_trajectory.
  *
  * \tparam Trajectory Trajectory type. Should be a \e sequence container \e sorted by segment start time.
  * Additionally, the contained segment type must implement a constructor with the following signature:
  * \code
- * Segment(const ros::Time&                             traj_start_time,
- *         const trajectory_msgs::JointTrajectoryPoint& start_point,
- *         const trajectory_msgs::JointTrajectoryPoint& end_point,
- *         const std::vector<Scalar>&                   position_offset)
+ * Segment(const Time&  start_time,
+ *         const State& start_state,
+ *         const Time&  end_time,
+ *         const State& end_state)
  * \endcode
+ * Segments are built straight from the point data of \p msg, which is copied into single-joint states that are
+ * reused for all segments. No per-point copies of the message data are made.
  * The following function must also be defined to properly handle continuous joints:
  * \code
- * std::vector<Scalar> wraparoundOffset(const typename Segment::State&  prev_state,
- *                                      const typename Segment::State&  next_state,
- *                                      const std::vector<bool>&        angle_wraparound)
+ * Scalar wraparoundJointOffset(const Scalar& prev_position,
+ *                              const Scalar& next_position,
+ *                              const bool&   angle_wraparound)
  * \endcode
  *
  * \note This function does not throw any exceptions by itself, but the segment constructor might.
@@ -201,10 +442,10 @@ bool isNotEmpty(typename Trajectory::value_type trajPerJoint)
  */
 // TODO: Return useful bits of current trajectory if input msg is useless?
 template <class Trajectory>
-Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg,
-                               const ros::Time&                              time,
-                               const InitJointTrajectoryOptions<Trajectory>& options =
-                               InitJointTrajectoryOptions<Trajectory>())
+void initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg,
+                         const ros::Time&                              time,
+                         const InitJointTrajectoryOptions<Trajectory>& options,
+                         Trajectory&                                   result_traj)
 {
   typedef typename Trajectory::value_type TrajectoryPerJoint;
   typedef typename TrajectoryPerJoint::value_type Segment;
@@ -213,7 +454,8 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
 
   const unsigned int n_joints = msg.joint_names.size();
 
-  const ros::Time msg_start_time = internal::startTime(msg, time); // Message start time
+  const ros::Time msg_start_time = options.start_time ? *options.start_time
+                                                      : internal::startTime(msg, time); // Message start time
 
   ROS_DEBUG_STREAM("Figuring out new trajectory starting at time "
                    << std::fixed << std::setprecision(3) << msg_start_time.toSec());
@@ -226,16 +468,25 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
     error_string = "Trajectory message contains empty trajectory. Nothing to convert.";
     ROS_DEBUG_STREAM(error_string);
     options.setErrorString(error_string);
-    return Trajectory();
+    result_traj.clear();
+    return;
   }
 
+  // Check point times and dimensions, and find the first point occurring after current time, in a single pass
+  // (NOTE: Using time, not o_time)
+  const PointsScan scan = scanPoints(msg, time, [n_joints](const trajectory_msgs::JointTrajectoryPoint& point)
+  {
+    return isValid(point, point.positions.size()) && point.positions.size() >= n_joints;
+  });
+
   // Non strictly-monotonic waypoints
-  if (!isTimeStrictlyIncreasing(msg))
+  if (!scan.time_increasing)
   {
     error_string = "Trajectory message contains waypoints that are not strictly increasing in time.";
     ROS_ERROR_STREAM(error_string);
     options.setErrorString(error_string);
-    return Trajectory();
+    result_traj.clear();
+    return;
   }
 
   // Validate options
@@ -269,7 +520,8 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
     o_msg_start_time = msg_start_time;
   }
 
-  const std::vector<std::string> joint_names = has_joint_names ? *(options.joint_names) : msg.joint_names;
+  const std::vector<std::string>& joint_names = has_joint_names ? *(options.joint_names) : msg.joint_names;
+  const JointNameIndex* joint_name_index = has_joint_names ? options.joint_name_index : nullptr;
 
   if (has_angle_wraparound)
   {
@@ -278,10 +530,11 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
     if (n_angle_wraparound != joint_names.size())
     {
       error_string = "Cannot create trajectory from message. "
-                "Vector specifying whether joints wrap around has an invalid size.";
+                     "Vector specifying whether joints wrap around has an invalid size.";
       ROS_ERROR_STREAM(error_string);
       options.setErrorString(error_string);
-      return Trajectory();
+      result_traj.clear();
+      return;
     }
   }
 
@@ -293,20 +546,22 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
       error_string = "Cannot create trajectory from message. It does not contain the expected joints.";
       ROS_ERROR_STREAM(error_string);
       options.setErrorString(error_string);
-      return Trajectory();
+      result_traj.clear();
+    return;
     }
   }
 
   // Mapping vector contains the map between the message joint order and the expected joint order
   // If unspecified, a trivial map is computed
-  std::vector<unsigned int> mapping_vector = internal::mapping(msg.joint_names,joint_names);
+  std::vector<unsigned int> mapping_vector = internal::mapping(msg.joint_names, joint_names, joint_name_index);
 
   if (mapping_vector.empty())
   {
     error_string = "Cannot create trajectory from message. It does not contain the expected joints.";
     ROS_ERROR_STREAM(error_string);
     options.setErrorString(error_string);
-    return Trajectory();
+    result_traj.clear();
+    return;
   }
 
   // Tolerances to be used in all new segments
@@ -318,18 +573,15 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
     updateSegmentTolerances<Scalar>(*(options.rt_goal_handle->gh_.getGoal()), joint_names, tolerances);
   }
 
-  // Find first point of new trajectory occurring after current time
-  // This point is used later on in this function, but is computed here, in advance because if the trajectory message
+  // Per-joint tolerances shared by all new segments, which only refer to their entry
+  boost::shared_ptr<const SegmentTolerancesTable<Scalar> > tolerances_table;
+  if (has_rt_goal_handle) {tolerances_table = makeSegmentTolerancesTable(tolerances);}
+
+  // First point of new trajectory occurring after current time, found by the point scan. If the trajectory message
   // contains a trajectory in the past, we can quickly return without spending additional computational resources
-  std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator
-  msg_it = findPoint(msg, time); // Points to last point occurring before current time (NOTE: Using time, not o_time)
-  if (msg_it == msg.points.end())
+  std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator msg_it = msg.points.begin() + scan.first_ahead;
+  if (scan.first_ahead > 0)
   {
-    msg_it = msg.points.begin();  // Entire trajectory is after current time
-  }
-  else
-  {
-    ++msg_it;                     // Points to first point after current time OR sequence end
     if (msg_it == msg.points.end())
     {
       ros::Duration last_point_dur = time - (msg_start_time + (--msg_it)->time_from_start);
@@ -339,7 +591,8 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
       error_string += "s in the past.";
       ROS_WARN_STREAM(error_string);
       options.setErrorString(error_string);
-      return Trajectory();
+      result_traj.clear();
+    return;
     }
     else if ( // If the first point is at time zero and no start time is set in the header, skip it silently
               msg.points.begin()->time_from_start.isZero() &&
@@ -362,51 +615,78 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
     }
   }
 
+  // Points to fit: [msg_it, msg_end)
+  const std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator
+  msg_end = internal::fittingEnd(msg_it, msg.points.end(), msg_start_time, options.fitting_end_time);
+
   // Initialize result trajectory: combination of:
   // - Useful segments of currently followed trajectory
   // - Useful segments of new trajectory (contained in ROS message)
-  Trajectory result_traj; // Currently empty
+  assert(&result_traj != options.current_trajectory);
 
-  // Set active goal to segments after current time
+  // Joints not in the message keep the segments of the current trajectory, which are shared instead of copied. Their
+  // segments after current time are associated to the new goal
+  result_traj.resize(joint_names.size());
   if (has_current_trajectory)
   {
-    result_traj = *(options.current_trajectory);
+    std::vector<char> in_msg(joint_names.size(), 0);
+    for (unsigned int joint_id : mapping_vector) {in_msg[joint_id] = 1;}
 
-    //Iterate to all segments after current time to set the new goal handler
-    for (unsigned int joint_id=0; joint_id < joint_names.size();joint_id++)
+    for (unsigned int joint_id = 0; joint_id < joint_names.size(); ++joint_id)
     {
-      const TrajectoryPerJoint& curr_joint_traj = result_traj[joint_id];
-      TrajIter active_seg = findSegment(curr_joint_traj, o_time.toSec());   // Currently active segment
+      if (in_msg[joint_id]) {continue;} // Rebuilt below
+      shareJointTrajectory(*(options.current_trajectory), joint_id, result_traj);
 
-      while (std::distance(active_seg, curr_joint_traj.end())>=1)
+      const TrajectoryPerJoint& curr_joint_traj = (*options.current_trajectory)[joint_id];
+      TrajIter active_seg = findSegment(curr_joint_traj, o_time.toSec());   // Currently active segment
+      if (active_seg != curr_joint_traj.end())
       {
-        (result_traj[joint_id])[std::distance(curr_joint_traj.begin(),active_seg)].setGoalHandle(options.rt_goal_handle);
-        ++active_seg;
+        setJointGoalHandle(result_traj, joint_id, std::distance(curr_joint_traj.begin(), active_seg),
+                           options.rt_goal_handle);
       }
     }
   }
   else
-    result_traj.resize(joint_names.size());
+  {
+    for (unsigned int joint_id = 0; joint_id < result_traj.size(); ++joint_id) {result_traj[joint_id].clear();}
+  }
 
-  //Iterate through the joints that are in the message, in the order of the mapping vector
-  //for (unsigned int joint_id=0; joint_id < joint_names.size();joint_id++)
-  for (unsigned int msg_joint_it=0; msg_joint_it < mapping_vector.size();msg_joint_it++)
+  // Point data to fit was validated by the point scan, as it is read for every joint below
+  if (scan.first_invalid_ahead < static_cast<std::size_t>(std::distance(msg.points.begin(), msg_end)))
+  {
+    throw(std::invalid_argument("Size mismatch in trajectory point position, velocity or acceleration data."));
+  }
+
+  // Knots of the new segments, as offsets from the first point to fit. Empty if all points are knots
+  std::vector<std::size_t> knots;
+  if (options.knot_tolerance > 0.0 && std::distance(msg_it, msg_end) > 2)
+  {
+    internal::reduceKnots<Segment>(msg_it, msg_end, n_joints, options.knot_tolerance, knots);
+    ROS_DEBUG_STREAM("Fitting " << knots.size() << " out of " << std::distance(msg_it, msg_end) <<
+                     " trajectory points within a position tolerance of " << options.knot_tolerance << ".");
+  }
+  const std::size_t n_knots = knots.empty() ? std::distance(msg_it, msg_end) : knots.size();
+
+  // Fit the segments of one joint of the message into its trajectory. The single-joint boundary states of the segment
+  // being built are reused across segments
+  auto fit_joint = [&](unsigned int msg_joint_it, typename Segment::State& start_state, typename Segment::State& end_state)
   {
     std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator it = msg_it;
-    if (!isValid(*it, it->positions.size()))
-      throw(std::invalid_argument("Size mismatch in trajectory point position, velocity or acceleration data."));
 
-    TrajectoryPerJoint result_traj_per_joint; // Currently empty
     unsigned int joint_id = mapping_vector[msg_joint_it];
 
-    // Initialize offsets due to wrapping joints to zero
-    std::vector<Scalar> position_offset(1, 0.0);
+    // Build the trajectory of this joint reusing the storage of its previous value. The message yields no segments
+    // only when there is no current trajectory, in which case the previous value was empty anyway
+    TrajectoryPerJoint& joint_traj = result_traj[joint_id];
+    joint_traj.clear();
 
-    //Initialize segment tolerance per joint
-    SegmentTolerancesPerJoint<Scalar> tolerances_per_joint;
-    tolerances_per_joint.state_tolerance = tolerances.state_tolerance[joint_id];
-    tolerances_per_joint.goal_state_tolerance = tolerances.goal_state_tolerance[joint_id];
-    tolerances_per_joint.goal_time_tolerance = tolerances.goal_time_tolerance;
+    // Initialize offset due to wrapping joints to zero
+    Scalar position_offset = 0.0;
+
+    // Segment tolerances of this joint, aliasing its entry in the shared tolerance table
+    typename Segment::TolerancesPtr tolerances_per_joint;
+    if (tolerances_table) {tolerances_per_joint = typename Segment::TolerancesPtr(tolerances_table,
+                                                                                  &(*tolerances_table)[joint_id]);}
 
     // Bridge current trajectory to new one
     if (has_current_trajectory)
@@ -415,29 +695,23 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
 
       // Get the last time and state that will be executed from the current trajectory
       const typename Segment::Time last_curr_time = std::max(o_msg_start_time.toSec(), o_time.toSec()); // Important!
-      typename Segment::State last_curr_state;
+      typename Segment::State& last_curr_state = start_state;
       sample(curr_joint_traj, last_curr_time, last_curr_state);
 
       // Get the first time and state that will be executed from the new trajectory
-      trajectory_msgs::JointTrajectoryPoint point_per_joint;
-      if (!it->positions.empty())     {point_per_joint.positions.resize(1, it->positions[msg_joint_it]);}
-      if (!it->velocities.empty())    {point_per_joint.velocities.resize(1, it->velocities[msg_joint_it]);}
-      if (!it->accelerations.empty()) {point_per_joint.accelerations.resize(1, it->accelerations[msg_joint_it]);}
-      point_per_joint.time_from_start = it->time_from_start;
-
       const typename Segment::Time first_new_time = o_msg_start_time.toSec() + (it->time_from_start).toSec();
-      typename Segment::State first_new_state(point_per_joint); // Here offsets are not yet applied
+      typename Segment::State& first_new_state = end_state;
 
       // Compute offsets due to wrapping joints
       if (has_angle_wraparound)
       {
-        position_offset[0] = wraparoundJointOffset(last_curr_state.position[0],
-                                                first_new_state.position[0],
-                                                (*options.angle_wraparound)[joint_id]);
+        position_offset = wraparoundJointOffset(last_curr_state.position[0],
+                                                it->positions[msg_joint_it],
+                                                (*options.angle_wraparound)[joint_id] != 0);
       }
 
       // Apply offset to first state that will be executed from the new trajectory
-      first_new_state = typename Segment::State(point_per_joint, position_offset); // Now offsets are applied
+      internal::jointState(*it, msg_joint_it, position_offset, first_new_state);
 
       // Add useful segments of current trajectory to result
       {
@@ -445,12 +719,15 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
         TrajIter last  = findSegment(curr_joint_traj, last_curr_time); // Segment active when new trajectory starts
         if (first == curr_joint_traj.end() || last == curr_joint_traj.end())
         {
-          error_string = "Unexpected error: Could not find segments in current trajectory. Please contact the package maintainer.";
-          ROS_ERROR_STREAM(error_string);
-          options.setErrorString(error_string);
-          return Trajectory();
+          return false;
+        }
+        ++last;
+        joint_traj.reserve(std::distance(first, last) + n_knots); // Incl. bridge segment
+        for (; first != last; ++first) // Range [first,last) will still be executed
+        {
+          joint_traj.push_back(*first);
+          joint_traj.back().setGoalHandle(jointGoalHandle(*(options.current_trajectory), joint_id, first));
         }
-        result_traj_per_joint.insert(result_traj_per_joint.begin(), first, ++last); // Range [first,last) will still be executed
       }
 
       // Add segment bridging current and new trajectories to result
@@ -458,46 +735,42 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
                          first_new_time, first_new_state);
       bridge_seg.setGoalHandle(options.rt_goal_handle);
       if (has_rt_goal_handle) {bridge_seg.setTolerances(tolerances_per_joint);}
-      result_traj_per_joint.push_back(bridge_seg);
+      joint_traj.push_back(bridge_seg);
     }
 
+    if (!has_current_trajectory) {joint_traj.reserve(n_knots - 1);}
+
     // Constants used in log statement at the end
-    const unsigned int num_old_segments = result_traj_per_joint.size() -1;
-    const unsigned int num_new_segments = std::distance(it, msg.points.end()) -1;
+    const unsigned int num_old_segments = joint_traj.size() -1;
+    const unsigned int num_new_segments = n_knots -1;
 
     // Add useful segments of new trajectory to result
+    // - Storage was already reserved when bridging with the current trajectory
     // - Construct all trajectory segments occurring after current time
     // - As long as there remain two trajectory points we can construct the next trajectory segment
-    while (std::distance(it, msg.points.end()) >= 2)
+    // - Boundary states are read straight from the message point data into preallocated single-joint states. The end
+    //   state of a segment is the start state of the next one
+    // - Segments span from one knot to the next, if knots were selected
+    internal::jointState(*it, msg_joint_it, position_offset, end_state);
+    const ros::Time& traj_start_time = o_msg_start_time;
+    for (std::size_t knot = 1; std::distance(it, msg_end) >= 2; ++knot)
     {
-      std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator next_it = it; ++next_it;
-
-      trajectory_msgs::JointTrajectoryPoint it_point_per_joint, next_it_point_per_joint;
-
-      if (!isValid(*it, it->positions.size()))
-            throw(std::invalid_argument("Size mismatch in trajectory point position, velocity or acceleration data."));
-      if (!it->positions.empty())     {it_point_per_joint.positions.resize(1, it->positions[msg_joint_it]);}
-      if (!it->velocities.empty())    {it_point_per_joint.velocities.resize(1, it->velocities[msg_joint_it]);}
-      if (!it->accelerations.empty()) {it_point_per_joint.accelerations.resize(1, it->accelerations[msg_joint_it]);}
-      it_point_per_joint.time_from_start = it->time_from_start;
-
-      if (!isValid(*next_it, next_it->positions.size()))
-            throw(std::invalid_argument("Size mismatch in trajectory point position, velocity or acceleration data."));
-      if (!next_it->positions.empty()) {next_it_point_per_joint.positions.resize(1, next_it->positions[msg_joint_it]);}
-      if (!next_it->velocities.empty()) {next_it_point_per_joint.velocities.resize(1, next_it->velocities[msg_joint_it]);}
-      if (!next_it->accelerations.empty()) {next_it_point_per_joint.accelerations.resize(1, next_it->accelerations[msg_joint_it]);}
-      next_it_point_per_joint.time_from_start = next_it->time_from_start;
-
-      Segment segment(o_msg_start_time, it_point_per_joint, next_it_point_per_joint, position_offset);
-      segment.setGoalHandle(options.rt_goal_handle);
-      if (has_rt_goal_handle) {segment.setTolerances(tolerances_per_joint);}
-      result_traj_per_joint.push_back(segment);
-      ++it;
+      std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator next_it = knots.empty() ? it + 1
+                                                                                                 : msg_it + knots[knot];
+
+      std::swap(start_state, end_state);
+      internal::jointState(*next_it, msg_joint_it, position_offset, end_state);
+
+      joint_traj.push_back(Segment((traj_start_time + it->time_from_start).toSec(),      start_state,
+                                   (traj_start_time + next_it->time_from_start).toSec(), end_state));
+      joint_traj.back().setGoalHandle(options.rt_goal_handle);
+      if (has_rt_goal_handle) {joint_traj.back().setTolerances(tolerances_per_joint);}
+      it = next_it;
     }
 
     // Useful debug info
     std::stringstream log_str;
-    log_str << "Trajectory of joint " << joint_names[joint_id] << "has " << result_traj_per_joint.size() << " segments";
+    log_str << "Trajectory of joint " << joint_names[joint_id] << "has " << joint_traj.size() << " segments";
     if (has_current_trajectory)
     {
       log_str << ":";
@@ -509,8 +782,40 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
     else {log_str << ".";}
     ROS_DEBUG_STREAM(log_str.str());
 
-    if (result_traj_per_joint.size() > 0)
-      result_traj[joint_id] = result_traj_per_joint;
+    return true;
+  };
+
+  // Joints are independent, so large messages are fitted in parallel, each joint into its own trajectory
+  const std::size_t n_new_segments = mapping_vector.size() * std::distance(msg_it, msg_end);
+  const bool fit_in_parallel = options.fitting_pool && mapping_vector.size() > 1 &&
+                               n_new_segments >= options.parallel_fitting_threshold;
+  bool fit_ok = true;
+  if (fit_in_parallel)
+  {
+    std::vector<char> joint_fit_ok(mapping_vector.size(), 0);
+    options.fitting_pool->parallelFor(mapping_vector.size(), [&](std::size_t msg_joint_it)
+    {
+      typename Segment::State start_state, end_state;
+      joint_fit_ok[msg_joint_it] = fit_joint(msg_joint_it, start_state, end_state);
+    });
+    fit_ok = std::find(joint_fit_ok.begin(), joint_fit_ok.end(), 0) == joint_fit_ok.end();
+  }
+  else
+  {
+    //Iterate through the joints that are in the message, in the order of the mapping vector
+    typename Segment::State start_state, end_state;
+    for (unsigned int msg_joint_it=0; fit_ok && msg_joint_it < mapping_vector.size();msg_joint_it++)
+    {
+      fit_ok = fit_joint(msg_joint_it, start_state, end_state);
+    }
+  }
+  if (!fit_ok)
+  {
+    error_string = "Unexpected error: Could not find segments in current trajectory. Please contact the package maintainer.";
+    ROS_ERROR_STREAM(error_string);
+    options.setErrorString(error_string);
+    result_traj.clear();
+    return;
   }
 
   // If the trajectory for all joints is empty, empty the trajectory vector
@@ -519,10 +824,415 @@ Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg
   {
     result_traj.clear();
   }
+  else if (options.end_point)
+  {
+    *options.end_point = std::distance(msg.points.begin(), msg_end) - 1;
+  }
+}
 
+/**
+ * \brief Initialize a joint trajectory from ROS message data.
+ *
+ * Convenience overload of \ref initJointTrajectory(const trajectory_msgs::JointTrajectory&, const ros::Time&, const InitJointTrajectoryOptions<Trajectory>&, Trajectory&)
+ * that returns a newly allocated trajectory.
+ *
+ * \return Trajectory container. Empty on failure.
+ */
+template <class Trajectory>
+Trajectory initJointTrajectory(const trajectory_msgs::JointTrajectory&       msg,
+                               const ros::Time&                              time,
+                               const InitJointTrajectoryOptions<Trajectory>& options =
+                               InitJointTrajectoryOptions<Trajectory>())
+{
+  Trajectory result_traj;
+  initJointTrajectory(msg, time, options, result_traj);
   return result_traj;
 }
 
+/**
+ * \brief Update a trajectory with ROS message data, reusing the storage of a previous result.
+ *
+ * This is the streaming counterpart of \ref initJointTrajectory, meant for high-rate streams of short commands that
+ * mostly overlap (e.g. teleoperation or model predictive control). The resulting trajectory is the same that
+ * \ref initJointTrajectory would build, but:
+ * - Only the segments of \p options.current_trajectory that are still to be executed between \p time and the start of
+ * \p msg are copied, and the new segments are created straight from the point data of \p msg. The cost of a call is
+ * thus proportional to the number of points in \p msg, not to the length of the current trajectory.
+ * - The output is written to \p result, a previously built trajectory whose segment containers and spline coefficients
+ * are reused. Once \p result has grown to the size of the streamed commands, updates perform no memory allocations.
+ * - \p msg must contain all the joints in \p options.joint_names. Partial-joint messages are rejected.
+ * - New segments are not associated to any action goal, so \p options.rt_goal_handle and
+ * \p options.default_tolerances are ignored. Segments kept from the current trajectory preserve their goal handle.
+ * - Streamed commands are short, so every point is kept and \p options.knot_tolerance is ignored.
+ *
+ * \param msg Trajectory message.
+ * \param time Time from which data is to be extracted, see \ref initJointTrajectory.
+ * \param options See \ref initJointTrajectory. \p current_trajectory must not refer to \p result.
+ * \param result Trajectory to overwrite with the updated trajectory.
+ *
+ * \return True if \p result holds a valid trajectory. On failure \p result is cleared, and the reason is written to
+ * \p options.error_string.
+ *
+ * \throw std::invalid_argument If \p msg contains points with inconsistent sizes.
+ */
+template <class Trajectory>
+bool appendJointTrajectory(const trajectory_msgs::JointTrajectory&       msg,
+                           const ros::Time&                              time,
+                           const InitJointTrajectoryOptions<Trajectory>& options,
+                           Trajectory&                                   result)
+{
+  typedef typename Trajectory::value_type TrajectoryPerJoint;
+  typedef typename TrajectoryPerJoint::value_type Segment;
+  typedef typename Segment::Scalar Scalar;
+  typedef typename TrajectoryPerJoint::const_iterator TrajIter;
+  typedef std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator PointIter;
+
+  assert(&result != options.current_trajectory);
+
+  std::string error_string;
+  const bool has_current_trajectory = options.current_trajectory && !options.current_trajectory->empty();
+  const bool has_joint_names        = options.joint_names        && !options.joint_names->empty();
+  const bool has_angle_wraparound   = options.angle_wraparound   && !options.angle_wraparound->empty();
+
+  const std::vector<std::string>& joint_names = has_joint_names ? *(options.joint_names) : msg.joint_names;
+  const JointNameIndex* joint_name_index = has_joint_names ? options.joint_name_index : nullptr;
+  const unsigned int n_joints = joint_names.size();
+
+  // Preconditions
+  if (msg.points.empty())
+  {
+    error_string = "Trajectory message contains empty trajectory. Nothing to convert.";
+    ROS_DEBUG_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  // Check point times and dimensions, and find the first point occurring after current time, in a single pass
+  const PointsScan scan = scanPoints(msg, time, [n_joints](const trajectory_msgs::JointTrajectoryPoint& point)
+  {
+    return point.positions.size() == n_joints && isValid(point, n_joints);
+  });
+
+  if (!scan.time_increasing)
+  {
+    error_string = "Trajectory message contains waypoints that are not strictly increasing in time.";
+    ROS_ERROR_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  const std::vector<unsigned int> mapping_vector = internal::mapping(msg.joint_names, joint_names, joint_name_index);
+  if (mapping_vector.size() != n_joints)
+  {
+    error_string = "Cannot create trajectory from message. It does not contain the expected joints.";
+    ROS_ERROR_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  if (has_angle_wraparound && options.angle_wraparound->size() != n_joints)
+  {
+    error_string = "Cannot create trajectory from message. "
+                   "Vector specifying whether joints wrap around has an invalid size.";
+    ROS_ERROR_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  if (has_current_trajectory && options.current_trajectory->size() != n_joints)
+  {
+    error_string = "Cannot update trajectory from message. Current trajectory has an invalid number of joints.";
+    ROS_ERROR_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  if (scan.first_invalid < msg.points.size())
+  {
+    result.clear();
+    throw(std::invalid_argument("Size mismatch in trajectory point position, velocity or acceleration data."));
+  }
+
+  // Message start time and data extraction time, expressed in the time base of the output trajectory
+  const ros::Time msg_start_time = internal::startTime(msg, time);
+  const ros::Time o_time = options.other_time_base ? *(options.other_time_base) : time;
+  const ros::Time o_msg_start_time = o_time + (msg_start_time - time);
+
+  // First point occurring after current time
+  const PointIter msg_it = msg.points.begin() + scan.first_ahead;
+  if (msg_it == msg.points.end())
+  {
+    error_string = "Dropping all " + std::to_string(msg.points.size());
+    error_string += " trajectory point(s), as they occur before the current time.";
+    ROS_WARN_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  result.resize(n_joints);
+
+  // Single-joint states, reused across segments
+  typename Segment::State start_state, end_state;
+
+  for (unsigned int msg_joint_id = 0; msg_joint_id < n_joints; ++msg_joint_id)
+  {
+    const unsigned int joint_id = mapping_vector[msg_joint_id];
+    TrajectoryPerJoint& result_traj = result[joint_id];
+    typename TrajectoryPerJoint::size_type n_segments = 0;
+
+    // Overwrite existing segments in place so that their storage is reused, and append the rest
+    auto add_segment = [&result_traj, &n_segments](const Segment& segment)
+    {
+      if (n_segments < result_traj.size()) {result_traj[n_segments] = segment;}
+      else                                 {result_traj.push_back(segment);}
+      ++n_segments;
+    };
+    auto init_segment = [&](const typename Segment::Time& start_time, const typename Segment::Time& end_time)
+    {
+      if (n_segments < result_traj.size())
+      {
+        Segment& segment = result_traj[n_segments];
+        segment.init(start_time, start_state, end_time, end_state);
+        segment.setGoalHandle(typename Segment::RealtimeGoalHandlePtr());
+        segment.setTolerances(typename Segment::TolerancesPtr());
+        ++n_segments;
+      }
+      else {add_segment(Segment(start_time, start_state, end_time, end_state));}
+    };
+
+    PointIter it = msg_it;
+    Scalar position_offset = 0.0;
+
+    // Bridge current trajectory to new one
+    if (has_current_trajectory)
+    {
+      const TrajectoryPerJoint& curr_joint_traj = (*options.current_trajectory)[joint_id];
+
+      // Last time and state that will be executed from the current trajectory
+      const typename Segment::Time last_curr_time = std::max(o_msg_start_time.toSec(), o_time.toSec());
+      TrajIter first = findSegment(curr_joint_traj, o_time.toSec());
+      TrajIter last  = findSegment(curr_joint_traj, last_curr_time);
+      if (first == curr_joint_traj.end() || last == curr_joint_traj.end())
+      {
+        error_string = "Unexpected error: Could not find segments in current trajectory. Please contact the package maintainer.";
+        ROS_ERROR_STREAM(error_string);
+        options.setErrorString(error_string);
+        result.clear();
+        return false;
+      }
+      last->sample(last_curr_time, start_state);
+
+      // Compute offsets due to wrapping joints
+      if (has_angle_wraparound)
+      {
+        position_offset = wraparoundJointOffset(start_state.position[0],
+                                                it->positions[msg_joint_id],
+                                                (*options.angle_wraparound)[joint_id] != 0);
+      }
+
+      // Segments of the current trajectory that will still be executed
+      for (++last; first != last; ++first)
+      {
+        add_segment(*first);
+        result_traj[n_segments - 1].setGoalHandle(jointGoalHandle(*(options.current_trajectory), joint_id, first));
+      }
+
+      // Segment bridging current and new trajectories
+      internal::jointState(*it, msg_joint_id, position_offset, end_state);
+      init_segment(last_curr_time, (o_msg_start_time + it->time_from_start).toSec());
+    }
+
+    // Segments of new trajectory
+    for (PointIter next_it = it + 1; next_it != msg.points.end(); it = next_it++)
+    {
+      internal::jointState(*it,      msg_joint_id, position_offset, start_state);
+      internal::jointState(*next_it, msg_joint_id, position_offset, end_state);
+      init_segment((o_msg_start_time + it->time_from_start).toSec(),
+                   (o_msg_start_time + next_it->time_from_start).toSec());
+    }
+
+    result_traj.erase(result_traj.begin() + n_segments, result_traj.end());
+  }
+
+  // A single-point message without current trajectory yields no segments
+  if (result.front().empty())
+  {
+    error_string = "Trajectory message does not contain enough points to build a trajectory.";
+    ROS_DEBUG_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * \brief Extend a trajectory fitted from the leading points of a message with the points that follow.
+ *
+ * Long messages can be fitted in windows: \ref initJointTrajectory fits the points up to its \p fitting_end_time
+ * option and reports the last point it fitted in its \p end_point option, and this function continues from that point.
+ * - The output is written to \p result, whose storage is reused (see \ref appendJointTrajectory). For the joints in
+ * \p msg, it contains the segments of \p options.current_trajectory active at or after \p time, followed by segments
+ * built from the points of \p msg following \p first_point. Other joints keep all their current segments, which are
+ * shared with the current trajectory if it supports it (see \ref shareJointTrajectory).
+ * - New segments continue the current trajectory of their joint: they share the time base, goal handle and tolerances
+ * of its last segment, and wrapping joints keep their position offset. \p options.other_time_base,
+ * \p options.rt_goal_handle and \p options.default_tolerances are ignored.
+ *
+ * \param msg Trajectory message the current trajectory was fitted from.
+ * \param time Time from which segments of the current trajectory are kept, expressed in its time base.
+ * \param first_point Index of the point of \p msg the current trajectory ends at.
+ * \param options See \ref initJointTrajectory. \p current_trajectory is required and must not refer to \p result.
+ * \p fitting_end_time is expressed in the time base of the current trajectory.
+ * \param result Trajectory to overwrite with the extended trajectory.
+ *
+ * \return True if \p result holds a valid trajectory. On failure \p result is cleared, and the reason is written to
+ * \p options.error_string.
+ *
+ * \throw std::invalid_argument If \p msg contains points with inconsistent sizes.
+ */
+template <class Trajectory>
+bool extendJointTrajectory(const trajectory_msgs::JointTrajectory&       msg,
+                           const ros::Time&                              time,
+                           const std::size_t                             first_point,
+                           const InitJointTrajectoryOptions<Trajectory>& options,
+                           Trajectory&                                   result)
+{
+  typedef typename Trajectory::value_type TrajectoryPerJoint;
+  typedef typename TrajectoryPerJoint::value_type Segment;
+  typedef typename Segment::Scalar Scalar;
+  typedef typename TrajectoryPerJoint::const_iterator TrajIter;
+  typedef std::vector<trajectory_msgs::JointTrajectoryPoint>::const_iterator PointIter;
+
+  assert(&result != options.current_trajectory);
+
+  std::string error_string;
+  const bool has_joint_names      = options.joint_names      && !options.joint_names->empty();
+  const bool has_angle_wraparound = options.angle_wraparound && !options.angle_wraparound->empty();
+
+  const std::vector<std::string>& joint_names = has_joint_names ? *(options.joint_names) : msg.joint_names;
+  const JointNameIndex* joint_name_index = has_joint_names ? options.joint_name_index : nullptr;
+  const unsigned int n_joints = joint_names.size();
+
+  // Preconditions
+  const std::vector<unsigned int> mapping_vector = internal::mapping(msg.joint_names, joint_names, joint_name_index);
+  if (!options.current_trajectory || options.current_trajectory->size() != n_joints || mapping_vector.empty() ||
+      first_point + 1 >= msg.points.size() || (has_angle_wraparound && options.angle_wraparound->size() != n_joints))
+  {
+    error_string = "Cannot extend trajectory. It was not fitted from the given message, or is already complete.";
+    ROS_ERROR_STREAM(error_string);
+    options.setErrorString(error_string);
+    result.clear();
+    return false;
+  }
+  const Trajectory& curr_traj = *(options.current_trajectory);
+
+  for (unsigned int msg_joint_id = 0; msg_joint_id < mapping_vector.size(); ++msg_joint_id)
+  {
+    if (curr_traj[mapping_vector[msg_joint_id]].empty())
+    {
+      error_string = "Cannot extend trajectory. Current trajectory has no segments.";
+      ROS_ERROR_STREAM(error_string);
+      options.setErrorString(error_string);
+      result.clear();
+      return false;
+    }
+  }
+
+  // Time base of the message, recovered from the end of the current trajectory
+  const PointIter first = msg.points.begin() + first_point;
+  const ros::Time o_msg_start_time = ros::Time(curr_traj[mapping_vector.front()].back().endTime()) -
+                                     first->time_from_start;
+  // Points to fit: [first, msg_end), bounded the same way as by initJointTrajectory
+  const PointIter msg_end = internal::fittingEnd(first, msg.points.end(), o_msg_start_time, options.fitting_end_time);
+  const std::size_t n_points = std::distance(first, msg_end);
+
+  for (std::size_t k = 0; k < n_points; ++k)
+  {
+    const trajectory_msgs::JointTrajectoryPoint& point = first[k];
+    if (point.positions.size() != msg.joint_names.size() || !isValid(point, msg.joint_names.size()))
+    {
+      result.clear();
+      throw(std::invalid_argument("Size mismatch in trajectory point position, velocity or acceleration data."));
+    }
+  }
+
+  // Segments of the current trajectory that will still be executed. Joints not in the message are not extended, and
+  // share their segments with the current trajectory
+  result.resize(n_joints);
+  std::vector<char> in_msg(n_joints, 0);
+  for (unsigned int joint_id : mapping_vector) {in_msg[joint_id] = 1;}
+  for (unsigned int joint_id = 0; joint_id < n_joints; ++joint_id)
+  {
+    if (!in_msg[joint_id])
+    {
+      shareJointTrajectory(curr_traj, joint_id, result);
+      continue;
+    }
+    const TrajectoryPerJoint& curr_joint_traj = curr_traj[joint_id];
+    TrajIter active = findSegment(curr_joint_traj, time.toSec());
+    if (active == curr_joint_traj.end()) {active = curr_joint_traj.begin();} // Time precedes the current trajectory
+    TrajectoryPerJoint& result_traj = result[joint_id];
+    result_traj.clear();
+    for (; active != curr_joint_traj.end(); ++active)
+    {
+      result_traj.push_back(*active);
+      result_traj.back().setGoalHandle(jointGoalHandle(curr_traj, joint_id, active));
+    }
+  }
+
+  // Knots of the new segments, as offsets from the first point. Empty if all points are knots
+  std::vector<std::size_t> knots;
+  if (options.knot_tolerance > 0.0 && n_points > 2)
+  {
+    internal::reduceKnots<Segment>(first, msg_end, msg.joint_names.size(), options.knot_tolerance, knots);
+  }
+
+  // Segments following the current trajectory. Single-joint states are reused across segments
+  typename Segment::State start_state, end_state;
+  for (unsigned int msg_joint_id = 0; msg_joint_id < mapping_vector.size(); ++msg_joint_id)
+  {
+    const unsigned int joint_id = mapping_vector[msg_joint_id];
+    TrajectoryPerJoint& result_traj = result[joint_id];
+    const Segment& last_segment = result_traj.back();
+    const typename Segment::RealtimeGoalHandlePtr rt_goal_handle = last_segment.getGoalHandle();
+    const typename Segment::TolerancesPtr tolerances = last_segment.getTolerancesPtr();
+
+    // Offset of wrapping joints, which maps the message positions to the positions they were fitted at
+    Scalar position_offset = 0.0;
+    if (has_angle_wraparound)
+    {
+      last_segment.sample(last_segment.endTime(), start_state);
+      position_offset = wraparoundJointOffset(start_state.position[0],
+                                              first->positions[msg_joint_id],
+                                              (*options.angle_wraparound)[joint_id] != 0);
+    }
+
+    PointIter it = first;
+    for (std::size_t knot = 1; std::distance(it, msg_end) >= 2; ++knot)
+    {
+      const PointIter next_it = knots.empty() ? it + 1 : first + knots[knot];
+      internal::jointState(*it,      msg_joint_id, position_offset, start_state);
+      internal::jointState(*next_it, msg_joint_id, position_offset, end_state);
+      result_traj.push_back(Segment((o_msg_start_time + it->time_from_start).toSec(),      start_state,
+                                    (o_msg_start_time + next_it->time_from_start).toSec(), end_state));
+      result_traj.back().setGoalHandle(rt_goal_handle);
+      result_traj.back().setTolerances(tolerances);
+      it = next_it;
+    }
+  }
+
+  if (options.end_point) {*options.end_point = std::distance(msg.points.begin(), msg_end) - 1;}
+  return true;
+}
+
 } // namespace
 
 #endif // header guard
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_JOINT_COMMAND_WRITER_H
+#define JOINT_TRAJECTORY_CONTROLLER_JOINT_COMMAND_WRITER_H
+
+// C++ standard
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// ros_controls
+#include <hardware_interface/joint_command_interface.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Write staged commands to a group of joint handles in one pass.
+ *
+ * The command pointers of the handles are cached at initialization. If they refer to consecutive elements of one
+ * array, as is the case for hardware interfaces that keep all joint commands in a contiguous buffer, commands are
+ * copied straight into that buffer. Otherwise they are written through the cached pointers.
+ */
+class JointCommandWriter
+{
+public:
+  JointCommandWriter() : contiguous_(false) {}
+
+  /**
+   * \brief Cache the command pointers of \p joint_handles.
+   * \note This method is \b not real-time safe.
+   */
+  void init(std::vector<hardware_interface::JointHandle>& joint_handles)
+  {
+    commands_.resize(joint_handles.size());
+    for (unsigned int i = 0; i < joint_handles.size(); ++i) {commands_[i] = joint_handles[i].getCommandPtr();}
+
+    contiguous_ = !commands_.empty();
+    for (unsigned int i = 1; contiguous_ && i < commands_.size(); ++i)
+    {
+      contiguous_ = commands_[i] == commands_[0] + i;
+    }
+  }
+
+  /**
+   * \brief Write \p values to the joint commands, in joint order.
+   * \pre \p values has at least \ref size elements.
+   * \note This method is realtime-safe.
+   */
+  void write(const std::vector<double>& values)
+  {
+    assert(values.size() >= commands_.size());
+    if (contiguous_)
+    {
+      std::copy(values.begin(), values.begin() + commands_.size(), commands_.front());
+    }
+    else
+    {
+      for (unsigned int i = 0; i < commands_.size(); ++i) {*commands_[i] = values[i];}
+    }
+  }
+
+  /** \return True if the joint commands are consecutive elements of one array. */
+  bool isContiguous() const {return contiguous_;}
+
+  /** \return Number of joints. */
+  std::size_t size() const {return commands_.size();}
+
+private:
+  std::vector<double*> commands_; ///< Command of each joint.
+  bool                 contiguous_;
+};
+
+} // namespace
+
+#endif // header guard
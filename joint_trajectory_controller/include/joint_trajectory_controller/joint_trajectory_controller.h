@@ -32,17 +32,27 @@
 #define JOINT_TRAJECTORY_CONTROLLER_JOINT_TRAJECTORY_CONTROLLER_H
 
 // C++ standard
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 // Boost
 #include <boost/shared_ptr.hpp>
 #include <boost/dynamic_bitset.hpp>
 
 // ROS
+#include <ros/callback_queue.h>
 #include <ros/node_handle.h>
+#include <ros/spinner.h>
 
 // URDF
 #include <urdf/model.h>
@@ -51,28 +61,55 @@
 #include <control_msgs/FollowJointTrajectoryAction.h>
 #include <control_msgs/JointTrajectoryControllerState.h>
 #include <control_msgs/QueryTrajectoryState.h>
+#include <std_msgs/Float64.h>
+#include <std_msgs/Float64MultiArray.h>
+#include <std_msgs/String.h>
+#include <std_srvs/Trigger.h>
 #include <trajectory_msgs/JointTrajectory.h>
 
 // actionlib
 #include <actionlib/server/action_server.h>
 
 // realtime_tools
-#include <realtime_tools/realtime_box.h>
-#include <realtime_tools/realtime_buffer.h>
 #include <realtime_tools/realtime_publisher.h>
 
+// Project services
+#include <joint_trajectory_controller/QueryTrajectoryStates.h>
+
 // ros_controls
 #include <realtime_tools/realtime_server_goal_handle.h>
 #include <controller_interface/controller.h>
 #include <hardware_interface/joint_command_interface.h>
 #include <hardware_interface/internal/demangle_symbol.h>
 
+// controller_instrumentation
+#include <controller_instrumentation/flight_recorder.h>
+#include <controller_instrumentation/metrics.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/telemetry_ring.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_instrumentation/tracepoints.h>
+#include <controller_instrumentation/update_latency_monitor.h>
+
 // Project
 #include <trajectory_interface/trajectory_interface.h>
 
 #include <joint_trajectory_controller/joint_trajectory_segment.h>
 #include <joint_trajectory_controller/init_joint_trajectory.h>
 #include <joint_trajectory_controller/hardware_interface_adapter.h>
+#include <joint_trajectory_controller/multi_joint_trajectory.h>
+#include <joint_trajectory_controller/parameter_server.h>
+#include <joint_trajectory_controller/realtime_shared_box.h>
+#include <joint_trajectory_controller/realtime_triple_buffer.h>
+#include <joint_trajectory_controller/speed_scaling.h>
+#include <joint_trajectory_controller/state_error_summary.h>
+#include <joint_trajectory_controller/stop_ramp.h>
+#include <joint_trajectory_controller/trajectory_file.h>
+#include <joint_trajectory_controller/trajectory_lookahead.h>
+#include <joint_trajectory_controller/trajectory_pool.h>
+#include <joint_trajectory_controller/trajectory_retiming.h>
+#include <joint_trajectory_controller/worker_pool.h>
+#include <joint_trajectory_controller/parallel_update.h>
 
 namespace joint_trajectory_controller
 {
@@ -82,6 +119,34 @@ namespace joint_trajectory_controller
  *
  * \note Non-developer documentation and usage instructions can be found in the package's ROS wiki page.
  *
+ * \par Performance parameters
+ * Besides the parameters documented in the wiki page, the following optional parameters trade features or latency
+ * for time spent per update or per command. Their defaults keep the behavior of the wiki page.
+ * - \b callback_threads (int, 0) Threads serving the callbacks of the controller. Zero uses the controller manager's.
+ * - \b state_summary_publish_rate (double, 0.0) Rate of the decimated state summary [Hz]. Zero disables it.
+ * - \b lookahead_samples, \b lookahead_spacing (int, 0; double, 0.01) Published samples of the desired trajectory
+ *   ahead of the current time, and their spacing [s]. Zero samples disable the lookahead.
+ * - \b speed_scaling_time_constant (double, 0.1) Time constant of speed scaling changes [s].
+ * - \b trajectory_fitting_threads (int, 0) Threads fitting commands. Zero fits them in the ROS callback. Otherwise,
+ *   topic commands and goals are accepted once fitted, after their callback returned.
+ * - \b parallel_fitting_threads, \b parallel_fitting_threshold (int, 0; int, 10000) Threads fitting the joints of
+ *   commands with at least the threshold number of segments in parallel.
+ * - \b knot_tolerance (double, 0.0) Points of dense commands that the fitted segments pass within this position
+ *   tolerance of are dropped. Zero keeps all points.
+ * - \b lazy_fitting_horizon (double, 0.0) Duration of commands fitted ahead of the current time [s]. Zero fits
+ *   commands up front.
+ * - \b stream_commands (bool, false) Append topic commands to the current trajectory.
+ * - \b blend_goals, \b queue_goals (bool, false) Blend goals that continue the executing goal into it, or queue them
+ *   behind it, see \ref getGoalBlend.
+ * - \b tolerance_check_stride (int, 1) Update cycles between path and goal tolerance checks. Tolerance violations and
+ *   goal completion are detected up to \p tolerance_check_stride - 1 cycles late, in exchange for less time spent
+ *   per update on the cycles in between.
+ * - \b max_trajectory_points (int, 0) Points the preallocated trajectories have room for. Zero allocates on demand.
+ * - \b query_state_snapshot (bool, false) Answer state queries for the current time from the last update cycle.
+ * - \b retime_goals (bool, false) Retime action goals to the velocity and acceleration limits of the joints.
+ * - \b parallel_update_groups, \b parallel_update_cpus, \b parallel_update_priority (int, 1; int list; int, 0) Joint
+ *   groups updated in parallel by busy-waiting helper threads, and the placement of the helpers.
+ *
  * \tparam SegmentImpl Trajectory segment representation to use. The type must comply with the following structure:
  * \code
  * class FooSegment
@@ -121,8 +186,12 @@ namespace joint_trajectory_controller
  * \tparam HardwareInterface Controller hardware interface. Currently \p hardware_interface::PositionJointInterface,
  * \p hardware_interface::VelocityJointInterface, and \p hardware_interface::EffortJointInterface are supported 
  * out-of-the-box.
+ *
+ * \tparam NumJoints Number of controlled joints, if known at compile time. A nonzero value makes \p init() reject
+ * configurations with a different number of joints, and lets the compiler unroll the per-joint loops of the realtime
+ * methods. The default value of zero accepts any number of joints.
  */
-template <class SegmentImpl, class HardwareInterface>
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints = 0>
 class JointTrajectoryController : public controller_interface::Controller<HardwareInterface>
 {
 public:
@@ -143,17 +212,32 @@ public:
   void stopping(const ros::Time& /*time*/);
 
   void update(const ros::Time& time, const ros::Duration& period);
+
+  /**
+   * \return Number of replaced trajectories that are waiting to be destroyed by the background reclamation thread.
+   */
+  std::size_t getPendingTrajectoryReleases() const;
+
+  /**
+   * \brief Set the speed scaling of the executed trajectory: zero pauses it, one executes it as commanded.
+   *
+   * The scale is reached smoothly, see \ref SpeedScaling. Also available on the \p speed_scaling topic.
+   * \return False if \p scale is not finite.
+   * \note This method is lock-free and can be called from any thread.
+   */
+  bool setSpeedScaling(double scale) {return speed_scaling_.setTarget(scale);}
   /*\}*/
 
 protected:
 
   struct TimeData
   {
-    TimeData() : time(0.0), period(0.0), uptime(0.0) {}
+    TimeData() : time(0.0), period(0.0), uptime(0.0), unscaled_uptime(0.0) {}
 
-    ros::Time     time;   ///< Time of last update cycle
-    ros::Duration period; ///< Period of last update cycle
-    ros::Time     uptime; ///< Controller uptime. Set to zero at every restart.
+    ros::Time     time;            ///< Time of last update cycle
+    ros::Duration period;          ///< Period of last update cycle
+    ros::Time     uptime;          ///< Trajectory time: controller uptime, progressing at the speed scaling rate.
+    ros::Time     unscaled_uptime; ///< Controller uptime. Both uptimes are set to zero at every restart.
   };
 
   typedef actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction>                  ActionServer;
@@ -164,24 +248,58 @@ protected:
   typedef trajectory_msgs::JointTrajectory::ConstPtr                                          JointTrajectoryConstPtr;
   typedef realtime_tools::RealtimePublisher<control_msgs::JointTrajectoryControllerState>     StatePublisher;
   typedef std::unique_ptr<StatePublisher>                                                     StatePublisherPtr;
+  typedef realtime_tools::RealtimePublisher<std_msgs::Float64MultiArray>                      SummaryPublisher;
+  typedef std::unique_ptr<SummaryPublisher>                                                   SummaryPublisherPtr;
+  typedef realtime_tools::RealtimePublisher<trajectory_msgs::JointTrajectory>                 LookaheadPublisher;
+  typedef std::unique_ptr<LookaheadPublisher>                                                 LookaheadPublisherPtr;
 
   typedef JointTrajectorySegment<SegmentImpl> Segment;
   typedef std::vector<Segment> TrajectoryPerJoint;
-  typedef std::vector<TrajectoryPerJoint> Trajectory;
+  typedef MultiJointTrajectory<SegmentImpl> Trajectory;
   typedef std::shared_ptr<Trajectory> TrajectoryPtr;
   typedef std::shared_ptr<TrajectoryPerJoint> TrajectoryPerJointPtr;
-  typedef realtime_tools::RealtimeBox<TrajectoryPtr> TrajectoryBox;
+  typedef RealtimeSharedBox<Trajectory> TrajectoryBox;
   typedef typename Segment::Scalar Scalar;
 
   typedef HardwareInterfaceAdapter<HardwareInterface, typename Segment::State> HwIfaceAdapter;
   typedef typename HardwareInterface::ResourceHandleType JointHandle;
 
+  /**
+   * \brief Trajectory command waiting to be fitted by \p fitting_pool_.
+   */
+  struct TrajectoryRequest
+  {
+    JointTrajectoryConstPtr msg;
+    RealtimeGoalHandlePtr   gh;       ///< Action goal the command belongs to. Null for topic commands.
+    std::uint64_t           sequence; ///< Arrival order of the command.
+    bool                    canceled; ///< Goal was canceled by actionlib before fitting finished.
+    bool                    deferred; ///< Goal waits for the goals that arrived before it to be fitted.
+  };
+  typedef std::shared_ptr<TrajectoryRequest> TrajectoryRequestPtr;
+
+  /**
+   * \return Number of controlled joints. A compile-time constant if \p NumJoints is nonzero.
+   * \note This method is realtime-safe.
+   */
+  unsigned int jointCount() const {return NumJoints > 0 ? NumJoints : joints_.size();}
+
   bool                      verbose_;            ///< Hard coded verbose flag to help in debugging
   std::string               name_;               ///< Controller name.
   std::vector<JointHandle>  joints_;             ///< Handles to controlled joints.
-  std::vector<bool>         angle_wraparound_;   ///< Whether controlled joints wrap around or not.
+  std::vector<char>         angle_wraparound_;   ///< Whether controlled joints wrap around or not.
   std::vector<std::string>  joint_names_;        ///< Controlled joint names.
-  SegmentTolerances<Scalar> default_tolerances_; ///< Default trajectory segment tolerances.
+  JointNameIndex            joint_name_index_;   ///< Index of \ref joint_names_, for mapping message joints.
+
+  typedef std::shared_ptr<const SegmentTolerances<Scalar> > SegmentTolerancesConstPtr;
+  SegmentTolerancesConstPtr default_tolerances_;       ///< Default trajectory segment tolerances. Guarded by \p default_tolerances_mutex_.
+  mutable std::mutex        default_tolerances_mutex_; ///< Only held to swap or copy \p default_tolerances_.
+
+  /**
+   * Queue of the callbacks of this controller, if it serves them on its own threads. Null if they are served by the
+   * queue of the controller manager. Declared before all ROS entities, which must be destroyed before it.
+   */
+  std::unique_ptr<ros::CallbackQueue> callback_queue_;
+
   HwIfaceAdapter            hw_iface_adapter_;   ///< Adapts desired trajectory state to HW interface.
 
   RealtimeGoalHandlePtr     rt_active_goal_;     ///< Currently active action goal, if any.
@@ -190,8 +308,11 @@ protected:
    * Thread-safe container with a smart pointer to trajectory currently being followed.
    * Can be either a hold trajectory or a trajectory received from a ROS message.
    *
+   * The realtime thread reads it without locking, and replaced trajectories are destroyed by a background thread.
+   *
    * We store the hold trajectory in a separate class member because the \p starting(time) method must be realtime-safe.
-   * The (single segment) hold trajectory is preallocated at initialization time and its size is kept unchanged.
+   * The (single segment) hold trajectory is preallocated at initialization time and its size is kept unchanged. It is
+   * the default value of \p curr_trajectory_box_.
    */
   TrajectoryBox curr_trajectory_box_;
   TrajectoryPtr hold_trajectory_ptr_; ///< Last hold trajectory values.
@@ -199,36 +320,359 @@ protected:
   typename Segment::State current_state_;         ///< Preallocated workspace variable.
   typename Segment::State desired_state_;         ///< Preallocated workspace variable.
   typename Segment::State state_error_;           ///< Preallocated workspace variable.
-  typename Segment::State desired_joint_state_;   ///< Preallocated workspace variable.
-  typename Segment::State state_joint_error_;     ///< Preallocated workspace variable.
+  std::vector<typename Segment::State> group_joint_states_; ///< Single-joint sample of per-joint trajectories, one per update group.
+  typename Segment::State state_joint_error_;     ///< Single-joint state error, only used to report tolerance violations.
+  typename Segment::State hold_start_state_;      ///< Preallocated workspace variable.
+  typename Segment::State hold_end_state_;        ///< Preallocated workspace variable.
+  std::vector<typename TrajectoryPerJoint::size_type> segment_cursors_; ///< Per-joint index of last sampled segment. Only used by the realtime thread.
+  typename Trajectory::Packed::size_type packed_cursor_; ///< Index of last sampled packed trajectory knot. Only used by the realtime thread.
+
+  TimeData                       rt_time_data_;    ///< Time data of last update cycle. Only used by the realtime thread.
+  RealtimeTripleBuffer<TimeData> time_data_;       ///< Time data of last update cycle, written by the realtime thread.
+  std::mutex                     time_data_mutex_; ///< Serializes non-realtime readers of \p time_data_.
 
-  realtime_tools::RealtimeBuffer<TimeData> time_data_;
+  /**
+   * \brief Desired state computed by an update cycle.
+   */
+  struct StateSnapshot
+  {
+    ros::Time               time;    ///< Time of the update cycle.
+    typename Segment::State desired;
+  };
+
+  // Query state service workspace. Requests are served one at a time, without contending with the realtime thread
+  bool                                                query_state_snapshot_;  ///< Answer queries for the current time from \p state_snapshot_.
+  RealtimeTripleBuffer<StateSnapshot>                 state_snapshot_;        ///< Desired state of the last update cycle, written by the realtime thread.
+  StateSnapshot                                       rt_state_snapshot_;     ///< Only used by the realtime thread.
+  std::mutex                                          query_mutex_;           ///< Serializes query state requests.
+  std::vector<typename TrajectoryPerJoint::size_type> query_cursors_;         ///< Per-joint index of last queried segment.
+  typename Trajectory::Packed::size_type              query_packed_cursor_;   ///< Index of last queried packed trajectory knot.
+  typename Segment::State                             query_state_;           ///< Preallocated workspace variable.
+  typename Segment::State                             query_joint_state_;     ///< Preallocated workspace variable.
+  std::vector<typename Segment::Time>                 query_times_;           ///< Sample times of a batch query, in uptime.
+  std::vector<typename Segment::State>                query_joint_states_;    ///< Per-time single-joint states of a batch query.
+
+  controller_instrumentation::RealtimeAudit        rt_audit_;        ///< Audit of realtime-unsafe operations in \p update().
+  controller_instrumentation::UpdateLatencyMonitor latency_monitor_; ///< Duration and jitter statistics of \p update().
+
+  ParameterGroup tolerances_group_; ///< Reconfigures \p default_tolerances_.
+
+  // Metrics. The fit duration histogram is guarded by \p command_mutex_, to have a single writer
+  controller_instrumentation::MetricsEndpoint  metrics_endpoint_;
+  controller_instrumentation::LatencyHistogram fit_duration_;            ///< Duration of trajectory command fits [ns].
+  controller_instrumentation::LatencySummary   fit_duration_summary_;
+  controller_instrumentation::Counter          goals_accepted_metric_;
+  controller_instrumentation::Counter          goals_rejected_metric_;
+  controller_instrumentation::Counter          goals_aborted_metric_;
+  controller_instrumentation::Counter          goals_succeeded_metric_;
 
   ros::Duration state_publisher_period_;
+  ros::Duration state_summary_publisher_period_; ///< Zero if the state summary is not published.
   ros::Duration action_monitor_period_;
+  ros::Duration action_feedback_period_; ///< Period at which the realtime thread refreshes action feedback.
 
   typename Segment::Time stop_trajectory_duration_;  ///< Duration for stop ramp. If zero, the controller stops at the actual position.
+  SpeedScaling           speed_scaling_;             ///< Speed override of the executed trajectory.
   boost::dynamic_bitset<> successful_joint_traj_;
+
+  // Tolerance checking workspace, preallocated
+  StateTolerancesArray<Scalar> path_tolerances_;      ///< Path tolerances of joints executing a goal segment.
+  StateTolerancesArray<Scalar> goal_tolerances_;      ///< Goal tolerances of joints that finished their last segment.
+  ToleranceViolationMask       tolerance_violations_;
+  boost::dynamic_bitset<>      path_check_joints_;    ///< Joints whose path tolerances are checked in this cycle.
+  boost::dynamic_bitset<>      goal_check_joints_;    ///< Joints whose goal tolerances are checked in this cycle.
+  boost::dynamic_bitset<>      goal_time_exceeded_;   ///< Joints that ran out of time to meet their goal tolerances.
+
+  /** Tolerance checks of a joint, gathered by the update groups and merged into the bitsets above. */
+  enum JointCheck
+  {
+    PATH_CHECK         = 1,
+    GOAL_CHECK         = 2,
+    GOAL_TIME_EXCEEDED = 4
+  };
+  std::vector<char> joint_checks_; ///< JointCheck flags of each joint in this cycle. Only used by the realtime thread.
+
+  /**
+   * Splits the per-joint sampling and state error computation of an update cycle into contiguous groups of joints,
+   * processed in parallel. Joint zero is always updated first by the realtime thread, as it activates blended goals.
+   */
+  ParallelUpdate    parallel_update_;
+  std::vector<char> group_sampled_; ///< Whether all joints of each group have a trajectory at the current time.
+  unsigned int                 tolerance_check_stride_;    ///< Update cycles between tolerance checks.
+  unsigned int                 tolerance_check_countdown_; ///< Update cycles until the next tolerance check.
   bool allow_partial_joints_goal_;
+  bool retime_goals_;                         ///< Retime action goals to \p retiming_limits_ before fitting them.
+  std::vector<RetimingLimits> retiming_limits_; ///< Velocity and acceleration limits of the controlled joints.
 
   // ROS API
   ros::NodeHandle    controller_nh_;
   ros::Subscriber    trajectory_command_sub_;
+  ros::Subscriber    trajectory_file_sub_;
+  ros::Subscriber    speed_scaling_sub_;
   ActionServerPtr    action_server_;
   ros::ServiceServer query_state_service_;
+  ros::ServiceServer query_states_service_;
+  ros::ServiceServer dump_flight_recorder_service_;
   StatePublisherPtr  state_publisher_;
 
   ros::Timer         goal_handle_timer_;
   ros::Time          last_state_publish_time_;
+  ros::Time          last_action_feedback_time_; ///< Only used by the realtime thread.
+
+  // Decimated and local state monitoring
+  SummaryPublisherPtr                          state_summary_publisher_;
+  ros::Time                                    last_state_summary_publish_time_;
+  StateErrorSummary<typename Segment::State>   state_error_summary_; ///< State error since the last summary.
+  controller_instrumentation::TelemetryRingWriter telemetry_ring_;   ///< Lossless state of every cycle, if enabled.
+  controller_instrumentation::FlightRecorder      flight_recorder_;  ///< State of the last cycles, dumped when goals abort.
+
+  // Trajectory lookahead: Desired states over a horizon ahead of the current time
+  LookaheadPublisherPtr           lookahead_publisher_; ///< Null if the lookahead is not published.
+  TrajectoryLookahead<Trajectory> lookahead_;           ///< Only used by the realtime thread.
+  std::atomic<bool>               lookahead_reset_;     ///< The hold trajectory was modified in place, see \ref setHoldPosition.
+
+  // Trajectory command pipeline
+  std::mutex                        command_mutex_;       ///< Serializes non-realtime trajectory and goal updates.
+  std::uint64_t                     command_sequence_;    ///< Sequence number of the newest command.
+  std::uint64_t                     committed_sequence_;  ///< Sequence number of the newest applied command.
+  std::vector<TrajectoryRequestPtr> pending_goals_;       ///< Action goals waiting to be fitted.
+  unsigned int                      max_fit_attempts_;    ///< Fits of a command before a late splice is accepted.
+  bool                              stream_commands_;     ///< Apply topic commands with \ref appendJointTrajectory.
+  TrajectoryPool<Trajectory>        trajectory_pool_;     ///< Recycled trajectories that new commands are built into.
+
+  /**
+   * \brief Where an action goal is blended into the current trajectory, see \ref getGoalBlend.
+   */
+  struct GoalBlend
+  {
+    ros::Time                          start_uptime; ///< Controller uptime at which the blended goal starts.
+    std::vector<RealtimeGoalHandlePtr> queued_goals; ///< Goals still queued in the current trajectory.
+  };
+
+  // Goal blending. Goals that continue the end of the trajectory are queued behind the executing goal, and become
+  // active in the realtime thread once their segments are reached, see \ref updateBlendedGoal
+  bool                               blend_goals_;            ///< Blend goals that continue the executing goal into it.
+  bool                               queue_goals_;            ///< Queue goals behind the executing goal, see \ref getGoalBlend.
+  StateTolerances<Scalar>            blend_tolerances_;       ///< Mismatch allowed between a blended goal and the trajectory end.
+  std::vector<RealtimeGoalHandlePtr> blended_goals_;          ///< Blended goals not known to have finished, in execution order. Guarded by \p command_mutex_.
+  std::uint64_t                      released_blended_goals_; ///< Handed over goals removed from \p blended_goals_. Guarded by \p command_mutex_.
+  std::atomic<std::uint64_t>         blended_goal_handovers_; ///< Blended goals made active by the realtime thread.
+  const RealtimeGoalHandle*          rt_blended_goal_;        ///< Last blended goal made active. Only used by the realtime thread.
+  ros::Timer                         blended_goals_timer_;
+
+  std::size_t                 parallel_fitting_threshold_; ///< Minimum segments of a command for parallel joint fitting.
+  double                      knot_tolerance_;             ///< Position tolerance of knot reduction. Zero if disabled.
+  std::unique_ptr<WorkerPool> joint_fitting_pool_;         ///< Fits the joints of large commands. Null if disabled.
+
+  /**
+   * \brief Trajectory command whose points are fitted in windows ahead of the current time.
+   */
+  struct LazyCommand
+  {
+    JointTrajectoryConstPtr msg;
+    std::size_t             end_point;  ///< Index of the last point of \p msg fitted so far.
+    double                  end_uptime; ///< Controller uptime at which the fitted points end.
+    TrajectoryPtr           trajectory; ///< Trajectory the next window extends. Extension stops once it is replaced.
+    TrajectoryFilePtr       file;       ///< File the points of \p msg are read from, if any.
+    std::size_t             file_point; ///< Index in \p file of the first point of \p msg.
+  };
+
+  ros::Duration                lazy_fitting_horizon_; ///< Fitted duration kept ahead of the current time. Zero if disabled.
+  std::unique_ptr<LazyCommand> lazy_command_;         ///< Command being fitted in windows. Guarded by \p command_mutex_.
+  ros::Timer                   lazy_fitting_timer_;
+
+  /**
+   * Fits trajectory commands off the callback thread. Null if commands are fitted synchronously.
+   * Declared last so that queued fits complete before the members they use are destroyed.
+   */
+  std::unique_ptr<WorkerPool> fitting_pool_;
+
+  /** Serves \p callback_queue_. Declared last so that callbacks stop before any other member is destroyed. */
+  std::unique_ptr<ros::AsyncSpinner> callback_spinner_;
 
   virtual bool updateTrajectoryCommand(const JointTrajectoryConstPtr& msg, RealtimeGoalHandlePtr gh, std::string* error_string = 0);
+  virtual bool updateStreamingCommand(const JointTrajectoryConstPtr& msg, std::string* error_string = 0);
   virtual void trajectoryCommandCB(const JointTrajectoryConstPtr& msg);
+  virtual void trajectoryFileCB(const std_msgs::StringConstPtr& msg);
+  virtual void speedScalingCB(const std_msgs::Float64ConstPtr& msg);
   virtual void goalCB(GoalHandle gh);
   virtual void cancelCB(GoalHandle gh);
   virtual void preemptActiveGoal();
   virtual bool queryStateService(control_msgs::QueryTrajectoryState::Request&  req,
                                  control_msgs::QueryTrajectoryState::Response& resp);
 
+  /**
+   * \brief Sample the current trajectory at all requested times in a single pass.
+   *
+   * Each joint trajectory is walked with a cursor that persists across requests, so sorted times cost a linear walk
+   * over the trajectory instead of one search per time.
+   */
+  virtual bool queryStatesService(QueryTrajectoryStates::Request&  req,
+                                  QueryTrajectoryStates::Response& resp);
+
+  /** \brief Dump the flight recorder to a file, whose path is returned in the response message. */
+  virtual bool dumpFlightRecorderService(std_srvs::Trigger::Request&  req,
+                                         std_srvs::Trigger::Response& resp);
+
+  /**
+   * \return Time data of the last update cycle.
+   * \note This method is \b not realtime-safe, and is meant to be called from non-realtime callbacks.
+   */
+  TimeData getTimeData();
+
+  /**
+   * \brief Build a trajectory from \p msg, spliced with \p current_trajectory.
+   *
+   * The splice takes place \p splice_delay after the next update cycle following \p time_data. If \p blend is not
+   * null, \p msg starts where it is blended instead of at its start time, and the result records the blended goals.
+   * \param[out] splice_uptime Controller uptime at which the result starts to differ from \p current_trajectory.
+   * \param[out] end_point Index of the last fitted point of \p msg. Only the points within twice
+   * \ref lazy_fitting_horizon_ of the splice are fitted if lazy fitting is enabled, the rest are left to
+   * \ref lazyFittingCB.
+   * \return The fitted trajectory, or a null pointer if \p msg is invalid (the reason is stored in \p error_string).
+   * \note This method is \b not realtime-safe. It can take a long time for large messages, and does not modify
+   * controller state, so it can run concurrently with callbacks.
+   */
+  TrajectoryPtr fitTrajectoryCommand(const trajectory_msgs::JointTrajectory& msg,
+                                     RealtimeGoalHandlePtr                   gh,
+                                     const TimeData&                         time_data,
+                                     const ros::Duration&                    splice_delay,
+                                     Trajectory*                             current_trajectory,
+                                     ros::Time&                              splice_uptime,
+                                     std::size_t&                            end_point,
+                                     std::string*                            error_string,
+                                     const GoalBlend*                        blend = 0);
+
+  /**
+   * \brief Queue \p msg for fitting on \p fitting_pool_.
+   *
+   * Action goals are accepted or rejected once fitting finishes. If goals are queued, they are fitted one at a time in
+   * arrival order, so that each one is queued behind the previous one.
+   */
+  void submitTrajectoryCommand(const JointTrajectoryConstPtr& msg, RealtimeGoalHandlePtr gh);
+
+  /**
+   * \brief Apply \p request, then submit the next deferred goal, if any.
+   * \note This method runs on \p fitting_pool_.
+   */
+  void processTrajectoryRequest(const TrajectoryRequestPtr& request);
+
+  /**
+   * \brief Fit \p request and apply the result, unless a newer command was applied in the meantime.
+   *
+   * If fitting took so long that the realtime loop is already past the splice point, the command is fitted again with
+   * the splice point pushed further into the future, for at most \ref max_fit_attempts_ attempts.
+   * \note This method runs on \p fitting_pool_.
+   */
+  void applyTrajectoryRequest(const TrajectoryRequestPtr& request);
+
+  /**
+   * \brief Find out whether \p msg, the trajectory of \p gh, can be blended into the current trajectory.
+   *
+   * A goal is blended if goal blending is enabled, the goal has no start time and contains all controller joints, and
+   * its first point matches the end state of \p current_trajectory within \ref blend_tolerances_. The current
+   * trajectory must be completely fitted, end with the last goal queued for execution, and end after the splice.
+   * Its first point is then reached at the end of the current trajectory, which the arm follows without stopping.
+   *
+   * If goal queueing is enabled, goals that do not match the end state are queued in the same way, provided that
+   * their first point leaves time for the transition to it (ie. it has a nonzero \p time_from_start).
+   * \param splice_uptime Controller uptime at which the blended trajectory would be spliced.
+   * \param[out] blend Where the goal is blended.
+   * \pre \p command_mutex_ is locked.
+   */
+  bool getGoalBlend(const trajectory_msgs::JointTrajectory& msg,
+                    const RealtimeGoalHandlePtr&            gh,
+                    const Trajectory&                       current_trajectory,
+                    const ros::Time&                        splice_uptime,
+                    GoalBlend&                              blend) const;
+
+  /**
+   * \return Number of leading entries of \p blended_goals_ that were made active by the realtime thread. The
+   * remaining ones are still queued.
+   * \pre \p command_mutex_ is locked.
+   */
+  std::size_t handedOverBlendedGoals() const;
+
+  /**
+   * \brief Accept \p rt_goal, queued behind the executing goal.
+   * \pre \p command_mutex_ is locked, and \p rt_goal is blended into the current trajectory.
+   */
+  void queueBlendedGoal(RealtimeGoalHandlePtr rt_goal);
+
+  /**
+   * \brief Cancel the blended goals that are still queued.
+   * \pre \p command_mutex_ is locked, and their segments are no longer part of the current trajectory.
+   */
+  void cancelBlendedGoals();
+
+  /**
+   * \brief Drop the queued blended goal \p gh, and the goals queued after it, from the current trajectory.
+   * \return False if \p gh is not queued.
+   * \pre \p command_mutex_ is locked.
+   */
+  bool cancelQueuedGoal(GoalHandle gh);
+
+  /**
+   * \brief Cancel all goals, queued or active.
+   * \pre \p command_mutex_ is locked.
+   */
+  void preemptGoals();
+
+  /**
+   * \brief Publish the status of blended goals, and release those that finished.
+   */
+  void blendedGoalsCB(const ros::TimerEvent& event);
+
+  /**
+   * \brief Make the goal of the segment being executed active, if it is blended into \p trajectory.
+   *
+   * The previously active goal then succeeds, as it blended into the next one along its path. So do queued goals
+   * that were too short to be sampled.
+   * \note This method is realtime-safe.
+   */
+  void updateBlendedGoal(const Trajectory&            trajectory,
+                         const RealtimeGoalHandlePtr& segment_goal,
+                         RealtimeGoalHandlePtr&       active_goal);
+
+  /**
+   * \brief Record \p msg for extension by \ref lazyFittingCB if points past \p end_point remain to be fitted.
+   * \param file If not null, \p msg is a window of the points of \p file starting at \p file_point, and extension
+   * continues with the remaining points of \p file.
+   * \pre \p command_mutex_ is locked, and \p trajectory, built from \p msg, is the current trajectory.
+   */
+  void setLazyCommand(const JointTrajectoryConstPtr& msg, std::size_t end_point, const TrajectoryPtr& trajectory,
+                      const TrajectoryFilePtr& file = TrajectoryFilePtr(), std::size_t file_point = 0);
+
+  /**
+   * \brief Fit the next window of the lazy command once less than \ref lazy_fitting_horizon_ of it remains ahead.
+   */
+  void lazyFittingCB(const ros::TimerEvent& event);
+
+  /** \return Default trajectory segment tolerances, which fits use as a consistent snapshot. */
+  SegmentTolerancesConstPtr defaultTolerances() const
+  {
+    std::lock_guard<std::mutex> lock(default_tolerances_mutex_);
+    return default_tolerances_;
+  }
+
+  /**
+   * \brief Apply reconfigured default tolerances, laid out as in \ref toleranceValues. They apply to the trajectory
+   * commands received from then on.
+   */
+  void tolerancesCB(const std::vector<double>& values);
+
+  /**
+   * \return Default \p tolerances as the values of the parameters served by \p tolerances_group_: the stopped velocity
+   * and goal time tolerances, followed by the trajectory and goal position tolerances of each joint.
+   */
+  std::vector<double> toleranceValues(const SegmentTolerances<Scalar>& tolerances) const;
+
+  /**
+   * \brief Make \p rt_goal the active goal, preempting the previous one.
+   * \pre \p command_mutex_ is locked, and the trajectory of \p rt_goal is the current trajectory.
+   */
+  void acceptGoal(RealtimeGoalHandlePtr rt_goal);
+
   /**
    * \brief Publish current controller state at a throttled frequency.
    * \note This method is realtime-safe and is meant to be called from \ref update, as it shares data with it without
@@ -236,16 +680,53 @@ protected:
    */
   void publishState(const ros::Time& time);
 
+  /**
+   * \brief Update the feedback of the active action goal at a throttled frequency.
+   *
+   * Feedback is only sent at the action monitor rate, so it is not refreshed on every update cycle.
+   * \note This method is realtime-safe and is meant to be called from \ref update.
+   */
+  void setActionFeedback(const RealtimeGoalHandlePtr& rt_goal, const TimeData& time_data);
+
+  /**
+   * \brief Accumulate the state error of the current cycle, and publish its summary at a throttled frequency.
+   * \note This method is realtime-safe and is meant to be called from \ref update, as it shares data with it without
+   * any locking.
+   */
+  void publishStateSummary(const ros::Time& time);
+
+  /**
+   * \brief Publish the desired states of \p curr_traj over the lookahead horizon, if enabled.
+   *
+   * Samples are taken at fixed spacing in trajectory time, and are kept across cycles, so that only those that enter
+   * the horizon are computed, see \ref TrajectoryLookahead.
+   * \note This method is realtime-safe and is meant to be called from \ref update.
+   */
+  void publishLookahead(const Trajectory& curr_traj, const TimeData& time_data);
+
+  /**
+   * \brief Write the desired, actual and error state of the current cycle to the telemetry ring and the flight
+   * recorder, if enabled.
+   * \note This method is realtime-safe.
+   */
+  void writeTelemetry(const ros::Time& time);
+
   /**
    * \brief Hold the current position.
    *
    * Substitutes the current trajectory with a single-segment one going from the current position and velocity to
-   * zero velocity.
-   * \see parameter stop_trajectory_duration
+   * zero velocity. The hold trajectory is preallocated, so this takes a fixed number of operations per joint.
+   * \see parameter stop_trajectory_duration, StopRampTraits
    * \note This method is realtime-safe.
    */
   void setHoldPosition(const ros::Time& time, RealtimeGoalHandlePtr gh=RealtimeGoalHandlePtr());
 
+  /**
+   * \brief Copy the state error of joint \p i to \p state_joint_error_, for error reporting.
+   * \note This method is realtime-safe.
+   */
+  void setJointError(std::size_t i);
+
 };
 
 } // namespace
@@ -129,18 +129,21 @@ std::string getLeafNamespace(const ros::NodeHandle& nh)
 
 } // namespace
 
-template <class SegmentImpl, class HardwareInterface>
-inline void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+inline void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 starting(const ros::Time& time)
 {
-  // Update time data
+  // Update time data. The controller starts at rest, so the speed scaling needs no transition
   TimeData time_data;
-  time_data.time   = time;
-  time_data.uptime = ros::Time(0.0);
-  time_data_.initRT(time_data);
+  time_data.time            = time;
+  time_data.uptime          = ros::Time(0.0);
+  time_data.unscaled_uptime = ros::Time(0.0);
+  rt_time_data_ = time_data;
+  time_data_.write(time_data);
+  speed_scaling_.reset();
 
   // Initialize the desired_state with the current state on startup
-  for (unsigned int i = 0; i < joints_.size(); ++i)
+  for (unsigned int i = 0; i < jointCount(); ++i)
   {
     desired_state_.position[i] = joints_[i].getPosition();
     desired_state_.velocity[i] = joints_[i].getVelocity();
@@ -148,31 +151,77 @@ starting(const ros::Time& time)
 
   // Hold current position
   setHoldPosition(time_data.uptime);
+  rt_blended_goal_ = nullptr;
 
   // Initialize last state update time
-  last_state_publish_time_ = time_data.uptime;
+  last_state_publish_time_         = time_data.unscaled_uptime;
+  last_state_summary_publish_time_ = time_data.unscaled_uptime;
+  last_action_feedback_time_       = time_data.unscaled_uptime;
+  state_error_summary_.reset();
+  lookahead_.reset();
+  tolerance_check_countdown_       = 0;
 
   // Hardware interface adapter
   hw_iface_adapter_.starting(time_data.uptime);
+
+  // Cycles are not periodic across restarts
+  latency_monitor_.restart();
+
+  // Parallel update helpers busy-wait for work again
+  parallel_update_.unpark();
 }
 
-template <class SegmentImpl, class HardwareInterface>
-inline void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+inline void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 stopping(const ros::Time& /*time*/)
 {
-  preemptActiveGoal();
+  // Canceling through the actionlib goal handle publishes from the realtime thread, so the cancellation is left to
+  // the goal handle timer instead
+  RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
+  if (current_active_goal)
+  {
+    rt_active_goal_.reset();
+    current_active_goal->setCanceled();
+  }
+
+  // No update is expected until restarted
+  parallel_update_.park();
 }
 
-template <class SegmentImpl, class HardwareInterface>
-inline void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+inline void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 trajectoryCommandCB(const JointTrajectoryConstPtr& msg)
 {
+  // Streamed commands are cheap to apply, and must not lag behind the stream
+  if (stream_commands_ && msg && !msg->points.empty())
+  {
+    std::lock_guard<std::mutex> lock(command_mutex_);
+    if (updateStreamingCommand(msg))
+    {
+      committed_sequence_ = ++command_sequence_;
+      preemptGoals();
+    }
+    return;
+  }
+
+  // Stop commands are cheap and latency-sensitive, so they are never queued behind pending fits
+  if (fitting_pool_ && msg && !msg->points.empty())
+  {
+    submitTrajectoryCommand(msg, RealtimeGoalHandlePtr());
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(command_mutex_);
   const bool update_ok = updateTrajectoryCommand(msg, RealtimeGoalHandlePtr());
-  if (update_ok) {preemptActiveGoal();}
+  if (update_ok)
+  {
+    committed_sequence_ = ++command_sequence_;
+    preemptGoals();
+  }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-inline void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+inline void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 preemptActiveGoal()
 {
   RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
@@ -186,11 +235,25 @@ preemptActiveGoal()
   }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 JointTrajectoryController()
   : verbose_(false), // Set to true during debugging
-    hold_trajectory_ptr_(new Trajectory)
+    hold_trajectory_ptr_(new Trajectory),
+    tolerance_check_stride_(1),
+    tolerance_check_countdown_(0),
+    lookahead_reset_(false),
+    command_sequence_(0),
+    committed_sequence_(0),
+    max_fit_attempts_(3),
+    stream_commands_(false),
+    blend_goals_(false),
+    queue_goals_(false),
+    released_blended_goals_(0),
+    blended_goal_handovers_(0),
+    rt_blended_goal_(nullptr),
+    parallel_fitting_threshold_(0),
+    knot_tolerance_(0.0)
 {
   // The verbose parameter is for advanced use as it breaks real-time safety
   // by enabling ROS logging services
@@ -203,10 +266,10 @@ JointTrajectoryController()
   }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInterface* hw,
-                                                                     ros::NodeHandle&   root_nh,
-                                                                     ros::NodeHandle&   controller_nh)
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::init(HardwareInterface* hw,
+                                                                                ros::NodeHandle&   root_nh,
+                                                                                ros::NodeHandle&   controller_nh)
 {
   using namespace internal;
 
@@ -216,16 +279,53 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
   // Controller name
   name_ = getLeafNamespace(controller_nh_);
 
+  // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+  const auto thread_placement_scope =
+    controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh_, name_);
+  if (!thread_placement_scope) {return false;}
+
+  // Callback threads. Zero serves callbacks on the queue of the controller manager, one after another with those of
+  // other controllers. Otherwise, all callbacks of this controller are served by its own threads, and must be
+  // registered on its queue before any ROS entity is created
+  int callback_threads = 0;
+  controller_nh_.getParam("callback_threads", callback_threads);
+  callback_spinner_.reset();
+  callback_queue_.reset();
+  if (callback_threads > 0)
+  {
+    callback_queue_.reset(new ros::CallbackQueue);
+    controller_nh_.setCallbackQueue(callback_queue_.get());
+    ROS_DEBUG_STREAM_NAMED(name_, "Callbacks will be served by " << callback_threads << " controller thread(s).");
+  }
+
   // State publish rate
   double state_publish_rate = 50.0;
   controller_nh_.getParam("state_publish_rate", state_publish_rate);
   ROS_DEBUG_STREAM_NAMED(name_, "Controller state will be published at " << state_publish_rate << "Hz.");
   state_publisher_period_ = ros::Duration(1.0 / state_publish_rate);
 
+  // Decimated state summary publish rate. Zero disables the summary
+  double state_summary_publish_rate = 0.0;
+  controller_nh_.getParam("state_summary_publish_rate", state_summary_publish_rate);
+  state_summary_publisher_period_ = state_summary_publish_rate > 0.0 ? ros::Duration(1.0 / state_summary_publish_rate)
+                                                                     : ros::Duration(0.0);
+
+  // Trajectory lookahead: Number and spacing of the published samples. Zero samples disables the lookahead
+  int lookahead_samples = 0;
+  double lookahead_spacing = 0.01;
+  controller_nh_.getParam("lookahead_samples", lookahead_samples);
+  controller_nh_.getParam("lookahead_spacing", lookahead_spacing);
+  if (lookahead_samples > 0 && !(lookahead_spacing > 0.0))
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Trajectory lookahead spacing must be positive, got " << lookahead_spacing << "s.");
+    return false;
+  }
+
   // Action status checking update rate
   double action_monitor_rate = 20.0;
   controller_nh_.getParam("action_monitor_rate", action_monitor_rate);
   action_monitor_period_ = ros::Duration(1.0 / action_monitor_rate);
+  action_feedback_period_ = action_monitor_period_ * 0.5;
   ROS_DEBUG_STREAM_NAMED(name_, "Action status changes will be monitored at " << action_monitor_rate << "Hz.");
 
   // Stop trajectory duration
@@ -233,6 +333,108 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
   controller_nh_.getParam("stop_trajectory_duration", stop_trajectory_duration_);
   ROS_DEBUG_STREAM_NAMED(name_, "Stop trajectory has a duration of " << stop_trajectory_duration_ << "s.");
 
+  // Speed scaling time constant. Zero applies speed scaling changes at once, with velocity steps
+  double speed_scaling_time_constant = 0.1;
+  controller_nh_.getParam("speed_scaling_time_constant", speed_scaling_time_constant);
+  speed_scaling_.setTimeConstant(speed_scaling_time_constant);
+
+  // Trajectory fitting threads. Zero (default) fits commands synchronously in the ROS callback
+  int trajectory_fitting_threads = 0;
+  controller_nh_.getParam("trajectory_fitting_threads", trajectory_fitting_threads);
+  if (trajectory_fitting_threads > 0)
+  {
+    fitting_pool_.reset(new WorkerPool(trajectory_fitting_threads));
+    ROS_DEBUG_STREAM_NAMED(name_, "Trajectory commands will be fitted by " << trajectory_fitting_threads << " worker thread(s).");
+  }
+  else
+  {
+    fitting_pool_.reset();
+    ROS_DEBUG_NAMED(name_, "Trajectory commands will be fitted synchronously.");
+  }
+
+  // Parallel fitting of the joints of large commands. Zero threads fit joints one after another
+  int parallel_fitting_threads = 0;
+  int parallel_fitting_threshold = 10000;
+  controller_nh_.getParam("parallel_fitting_threads", parallel_fitting_threads);
+  controller_nh_.getParam("parallel_fitting_threshold", parallel_fitting_threshold);
+  parallel_fitting_threshold_ = std::max(parallel_fitting_threshold, 0);
+  if (parallel_fitting_threads > 0)
+  {
+    joint_fitting_pool_.reset(new WorkerPool(parallel_fitting_threads));
+    ROS_DEBUG_STREAM_NAMED(name_, "Joints of commands with at least " << parallel_fitting_threshold_ <<
+                                  " segments will be fitted in parallel by " << parallel_fitting_threads <<
+                                  " additional thread(s).");
+  }
+  else
+  {
+    joint_fitting_pool_.reset();
+  }
+
+  // Dense commands are fitted with fewer segments, dropping the points they pass within tolerance of
+  controller_nh_.getParam("knot_tolerance", knot_tolerance_);
+  if (knot_tolerance_ < 0.0)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Knot tolerance must be non-negative, got " << knot_tolerance_ << ".");
+    return false;
+  }
+  if (knot_tolerance_ > 0.0)
+  {
+    ROS_DEBUG_STREAM_NAMED(name_, "Trajectory points will be dropped when the fitted segments pass within " <<
+                                  knot_tolerance_ << " of them.");
+  }
+
+  // Lazy fitting of long commands. Zero fits all points of a command up front
+  double lazy_fitting_horizon = 0.0;
+  controller_nh_.getParam("lazy_fitting_horizon", lazy_fitting_horizon);
+  lazy_fitting_horizon_ = ros::Duration(std::max(lazy_fitting_horizon, 0.0));
+  lazy_command_.reset();
+  if (!lazy_fitting_horizon_.isZero())
+  {
+    lazy_fitting_timer_ = controller_nh_.createTimer(lazy_fitting_horizon_ * 0.25,
+                                                     &JointTrajectoryController::lazyFittingCB,
+                                                     this);
+    ROS_DEBUG_STREAM_NAMED(name_, "Trajectory commands will be fitted " << lazy_fitting_horizon_.toSec() <<
+                                  "s ahead of the current time.");
+  }
+
+  // Streaming mode for topic commands
+  controller_nh_.param<bool>("stream_commands", stream_commands_, false);
+  if (stream_commands_)
+  {
+    ROS_DEBUG_NAMED(name_, "Topic commands will be appended to the current trajectory in streaming mode");
+  }
+
+  // Blending of goals that continue the executing goal into it, without stopping in between. Queued goals reuse the
+  // same mechanism, without the continuity requirement
+  controller_nh_.param<bool>("blend_goals", blend_goals_, false);
+  controller_nh_.param<bool>("queue_goals", queue_goals_, false);
+  blended_goals_.clear();
+  blended_goals_timer_ = ros::Timer();
+  if (blend_goals_ || queue_goals_)
+  {
+    double blend_position_tolerance, blend_velocity_tolerance, blend_acceleration_tolerance;
+    controller_nh_.param("blend_position_tolerance",     blend_position_tolerance,     1e-3);
+    controller_nh_.param("blend_velocity_tolerance",     blend_velocity_tolerance,     1e-2);
+    controller_nh_.param("blend_acceleration_tolerance", blend_acceleration_tolerance, 1e-1);
+    blend_tolerances_ = StateTolerances<Scalar>(blend_position_tolerance,
+                                                blend_velocity_tolerance,
+                                                blend_acceleration_tolerance);
+    blended_goals_timer_ = controller_nh_.createTimer(action_monitor_period_,
+                                                      &JointTrajectoryController::blendedGoalsCB,
+                                                      this);
+    ROS_DEBUG_NAMED(name_, "Goals that continue the end of the executing goal will be blended into it");
+    if (queue_goals_) {ROS_DEBUG_NAMED(name_, "Goals will be queued behind the executing goal");}
+  }
+
+  // Tolerance check stride. Tolerance violations and goal completion are detected at most this many cycles late
+  int tolerance_check_stride = 1;
+  controller_nh_.getParam("tolerance_check_stride", tolerance_check_stride);
+  tolerance_check_stride_ = std::max(tolerance_check_stride, 1);
+  if (tolerance_check_stride_ > 1)
+  {
+    ROS_DEBUG_STREAM_NAMED(name_, "Tolerances will be checked every " << tolerance_check_stride_ << " update cycles.");
+  }
+
   // Checking if partial trajectories are allowed
   controller_nh_.param<bool>("allow_partial_joints_goal", allow_partial_joints_goal_, false);
   if (allow_partial_joints_goal_)
@@ -244,6 +446,13 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
   joint_names_ = getStrings(controller_nh_, "joints");
   if (joint_names_.empty()) {return false;}
   const unsigned int n_joints = joint_names_.size();
+  if (NumJoints > 0 && n_joints != NumJoints)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Controller expects " << NumJoints << " joints, but " << n_joints <<
+                                  " were specified.");
+    return false;
+  }
+  joint_name_index_ = makeJointNameIndex(joint_names_);
 
   // URDF joints
   urdf::ModelSharedPtr urdf = getUrdf(root_nh, "robot_description");
@@ -276,23 +485,64 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
   }
 
   assert(joints_.size() == angle_wraparound_.size());
+
+  // Retiming of action goals to the joint limits
+  controller_nh_.param<bool>("retime_goals", retime_goals_, false);
+  if (retime_goals_)
+  {
+    ros::NodeHandle limits_nh(controller_nh_, "joint_limits");
+    retiming_limits_ = getRetimingLimits(limits_nh, joint_names_, urdf_joints);
+    ROS_DEBUG_NAMED(name_, "Action goals will be retimed to the joint velocity and acceleration limits");
+  }
   ROS_DEBUG_STREAM_NAMED(name_, "Initialized controller '" << name_ << "' with:" <<
                          "\n- Number of joints: " << joints_.size() <<
                          "\n- Hardware interface type: '" << this->getHardwareInterfaceType() << "'" <<
                          "\n- Trajectory segment type: '" << hardware_interface::internal::demangledTypeName<SegmentImpl>() << "'");
 
-  // Default tolerances
+  // Default tolerances, reconfigured along with the gains of the hardware interface adapter
   ros::NodeHandle tol_nh(controller_nh_, "constraints");
-  default_tolerances_ = getSegmentTolerances<Scalar>(tol_nh, joint_names_);
+  default_tolerances_ = std::make_shared<const SegmentTolerances<Scalar> >(getSegmentTolerances<Scalar>(tol_nh,
+                                                                                                        joint_names_));
+  std::vector<ParameterDescription> tolerance_parameters;
+  tolerance_parameters.push_back({"stopped_velocity_tolerance", "constraints/stopped_velocity_tolerance",
+                                  "Velocity tolerance of the goal state.", 0.0, 1000.0, false});
+  tolerance_parameters.push_back({"goal_time", "constraints/goal_time",
+                                  "Time allowed to reach the goal state tolerances after the trajectory end.",
+                                  0.0, 1000.0, false});
+  for (const std::string& joint_name : joint_names_)
+  {
+    tolerance_parameters.push_back({joint_name + "_trajectory", "constraints/" + joint_name + "/trajectory",
+                                    "Position tolerance of " + joint_name + " along the trajectory.",
+                                    0.0, 1000.0, false});
+    tolerance_parameters.push_back({joint_name + "_goal", "constraints/" + joint_name + "/goal",
+                                    "Position tolerance of " + joint_name + " at the goal state.", 0.0, 1000.0, false});
+  }
+  tolerances_group_.init(controller_nh_, "constraints", tolerance_parameters, toleranceValues(*default_tolerances_),
+                         std::bind(&JointTrajectoryController::tolerancesCB, this, std::placeholders::_1));
 
   // Hardware interface adapter
   hw_iface_adapter_.init(joints_, controller_nh_);
 
   // ROS API: Subscribed topics
   trajectory_command_sub_ = controller_nh_.subscribe("command", 1, &JointTrajectoryController::trajectoryCommandCB, this);
+  trajectory_file_sub_ = controller_nh_.subscribe("trajectory_file_command", 1,
+                                                  &JointTrajectoryController::trajectoryFileCB, this);
+  speed_scaling_sub_ = controller_nh_.subscribe("speed_scaling", 1, &JointTrajectoryController::speedScalingCB, this);
 
   // ROS API: Published topics
   state_publisher_.reset(new StatePublisher(controller_nh_, "state", 1));
+  if (!state_summary_publisher_period_.isZero())
+  {
+    state_summary_publisher_.reset(new SummaryPublisher(controller_nh_, "state_summary", 1));
+    ROS_DEBUG_STREAM_NAMED(name_, "Controller state summary will be published at " <<
+                                  1.0 / state_summary_publisher_period_.toSec() << "Hz.");
+  }
+  if (lookahead_samples > 0)
+  {
+    lookahead_publisher_.reset(new LookaheadPublisher(controller_nh_, "lookahead", 1));
+    ROS_DEBUG_STREAM_NAMED(name_, "Desired states will be published " << lookahead_samples << " samples of " <<
+                                  lookahead_spacing << "s ahead.");
+  }
 
   // ROS API: Action interface
   action_server_.reset(new ActionServer(controller_nh_, "follow_joint_trajectory",
@@ -305,16 +555,118 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
   query_state_service_ = controller_nh_.advertiseService("query_state",
                                                          &JointTrajectoryController::queryStateService,
                                                          this);
+  query_states_service_ = controller_nh_.advertiseService("query_states",
+                                                          &JointTrajectoryController::queryStatesService,
+                                                          this);
+
+  // Realtime audit (only active in audit builds)
+  rt_audit_.init(controller_nh_, name_);
+
+  // Update cycle statistics
+  latency_monitor_.init(controller_nh_, name_);
+
+  // Metrics
+  if (!metrics_endpoint_.init(controller_nh_)) {return false;}
+  fit_duration_summary_.init("ros_controllers_trajectory_fit_duration_seconds",
+                             "Duration of the fits of trajectory commands.", name_, fit_duration_, 1e-9);
+  goals_accepted_metric_.init("ros_controllers_trajectory_goals_accepted_total",
+                              "Trajectory action goals accepted.", name_);
+  goals_rejected_metric_.init("ros_controllers_trajectory_goals_rejected_total",
+                              "Trajectory action goals rejected.", name_);
+  goals_aborted_metric_.init("ros_controllers_trajectory_goals_aborted_total",
+                             "Trajectory action goals aborted for violating their tolerances.", name_);
+  goals_succeeded_metric_.init("ros_controllers_trajectory_goals_succeeded_total",
+                               "Trajectory action goals that succeeded.", name_);
+
+  // Trajectory pool: Enough trajectories for the current one, one still held by the realtime thread or awaiting
+  // release, and one being built by each thread that can build trajectories. Segment storage has some extra room for
+  // the segments spliced from the current trajectory
+  int max_trajectory_points = 0;
+  controller_nh_.getParam("max_trajectory_points", max_trajectory_points);
+  const std::size_t n_builders = 1 + (fitting_pool_ ? fitting_pool_->size() : 0);
+  trajectory_pool_.init(2 + n_builders, n_joints, max_trajectory_points > 0 ? max_trajectory_points + 2 : 0);
+  if (max_trajectory_points > 0)
+  {
+    ROS_DEBUG_STREAM_NAMED(name_, "Preallocated " << trajectory_pool_.size() << " trajectories of up to " <<
+                                  max_trajectory_points << " points.");
+  }
 
   // Preeallocate resources
   current_state_       = typename Segment::State(n_joints);
   desired_state_       = typename Segment::State(n_joints);
   state_error_         = typename Segment::State(n_joints);
-  desired_joint_state_ = typename Segment::State(1);
   state_joint_error_   = typename Segment::State(1);
+  hold_start_state_    = typename Segment::State(1);
+  hold_end_state_      = typename Segment::State(1);
+
+  segment_cursors_.resize(n_joints, 0);
+  packed_cursor_ = 0;
+
+  // Query state service: Queries for the current time can be answered from the state of the last update cycle
+  controller_nh_.param<bool>("query_state_snapshot", query_state_snapshot_, false);
+  StateSnapshot snapshot;
+  snapshot.desired = typename Segment::State(n_joints);
+  state_snapshot_.reset(snapshot);
+  rt_state_snapshot_   = snapshot;
+  query_cursors_.assign(n_joints, 0);
+  query_packed_cursor_ = 0;
+  query_state_         = typename Segment::State(n_joints);
+  query_joint_state_   = typename Segment::State(1);
 
   successful_joint_traj_ = boost::dynamic_bitset<>(joints_.size());
 
+  path_tolerances_.resize(n_joints);
+  goal_tolerances_.resize(n_joints);
+  tolerance_violations_.resize(toleranceViolationMaskSize(n_joints));
+  path_check_joints_  = boost::dynamic_bitset<>(n_joints);
+  goal_check_joints_  = boost::dynamic_bitset<>(n_joints);
+  goal_time_exceeded_ = boost::dynamic_bitset<>(n_joints);
+  joint_checks_.assign(n_joints, 0);
+
+  // Parallel update of joint groups. The first group is updated by the realtime thread, each other by a helper thread
+  // that busy-waits for work, pinned to an entry of parallel_update_cpus and scheduled with parallel_update_priority.
+  // While the controller runs, each helper keeps its core fully loaded, even when the cycle has nothing to update: only
+  // use more than one group if the update of the joints takes a significant part of the period. Helpers sleep while
+  // the controller is stopped
+  int parallel_update_groups = 1;
+  int parallel_update_priority = 0;
+  std::vector<int> parallel_update_cpus;
+  controller_nh_.getParam("parallel_update_groups", parallel_update_groups);
+  controller_nh_.getParam("parallel_update_priority", parallel_update_priority);
+  if (controller_nh_.hasParam("parallel_update_cpus") &&
+      !controller_nh_.getParam("parallel_update_cpus", parallel_update_cpus))
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Parameter 'parallel_update_cpus' must be a list of CPU indices.");
+    return false;
+  }
+  for (int cpu : parallel_update_cpus)
+  {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+      ROS_ERROR_STREAM_NAMED(name_, "Invalid CPU index " << cpu << " in parameter 'parallel_update_cpus'.");
+      return false;
+    }
+  }
+  if (parallel_update_priority < 0)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Parameter 'parallel_update_priority' must be non-negative.");
+    return false;
+  }
+  // Joint zero is updated before the groups, which only share the remaining joints
+  const std::size_t n_groups = std::min(static_cast<std::size_t>(std::max(parallel_update_groups, 1)),
+                                        std::max<std::size_t>(n_joints - 1, 1));
+  if (!parallel_update_.start(n_groups, parallel_update_cpus, parallel_update_priority))
+  {
+    ROS_WARN_STREAM_NAMED(name_, "Could not set the CPU affinity or priority of the parallel update threads.");
+  }
+  parallel_update_.park(); // Until started
+  if (n_groups > 1)
+  {
+    ROS_DEBUG_STREAM_NAMED(name_, "Joints will be updated in " << n_groups << " parallel groups.");
+  }
+  group_joint_states_.assign(n_groups, typename Segment::State(1));
+  group_sampled_.assign(n_groups, 1);
+
   // Initialize trajectory with all joints
   typename Segment::State current_joint_state_ = typename Segment::State(1);
   for (unsigned int i = 0; i < n_joints; ++i)
@@ -327,6 +679,8 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
 	  joint_segment.resize(1, hold_segment);
 	  hold_trajectory_ptr_->push_back(joint_segment);
   }
+  hold_trajectory_ptr_->setShareable(false); // Modified in place by the realtime thread, see setHoldPosition
+  curr_trajectory_box_.initDefault(hold_trajectory_ptr_);
 
   {
     state_publisher_->lock();
@@ -341,24 +695,92 @@ bool JointTrajectoryController<SegmentImpl, HardwareInterface>::init(HardwareInt
     state_publisher_->unlock();
   }
 
+  // State summary: Error statistics of each joint, in joint-major order
+  state_error_summary_.resize(n_joints);
+  if (state_summary_publisher_)
+  {
+    typedef StateErrorSummary<typename Segment::State> Summary;
+    state_summary_publisher_->lock();
+    std_msgs::Float64MultiArray& msg = state_summary_publisher_->msg_;
+    msg.layout.dim.resize(2);
+    msg.layout.dim[0].label  = "joints";
+    msg.layout.dim[0].size   = n_joints;
+    msg.layout.dim[0].stride = n_joints * Summary::STATISTICS_SIZE;
+    msg.layout.dim[1].label  = "position_error_min,position_error_max,position_error_mean,"
+                               "velocity_error_min,velocity_error_max,velocity_error_mean";
+    msg.layout.dim[1].size   = Summary::STATISTICS_SIZE;
+    msg.layout.dim[1].stride = Summary::STATISTICS_SIZE;
+    msg.data.resize(n_joints * Summary::STATISTICS_SIZE);
+    state_summary_publisher_->unlock();
+  }
+
+  // Trajectory lookahead: Full-size message, so that publishing it does not allocate
+  if (lookahead_publisher_)
+  {
+    lookahead_.init(lookahead_samples, lookahead_spacing, n_joints);
+    lookahead_publisher_->lock();
+    trajectory_msgs::JointTrajectory& msg = lookahead_publisher_->msg_;
+    msg.joint_names = joint_names_;
+    msg.points.resize(lookahead_samples);
+    for (trajectory_msgs::JointTrajectoryPoint& point : msg.points)
+    {
+      point.positions.resize(n_joints);
+      point.velocities.resize(n_joints);
+      point.accelerations.resize(n_joints);
+    }
+    lookahead_publisher_->unlock();
+  }
+
+  // Telemetry ring: Lossless state of every cycle in shared memory, for recorders on the same host
+  std::vector<std::string> telemetry_labels;
+  const char* const telemetry_quantities[] = {"desired/position", "desired/velocity", "desired/acceleration",
+                                              "actual/position",  "actual/velocity",
+                                              "error/position",   "error/velocity"};
+  for (const char* quantity : telemetry_quantities)
+  {
+    for (const std::string& joint_name : joint_names_) {telemetry_labels.push_back(joint_name + "/" + quantity);}
+  }
+  if (!telemetry_ring_.init(controller_nh_, telemetry_labels)) {return false;}
+
+  // Flight recorder: Same state as the telemetry ring, for the last cycles before a goal is aborted
+  if (!flight_recorder_.init(controller_nh_, telemetry_labels, name_)) {return false;}
+  if (flight_recorder_.isOpen())
+  {
+    dump_flight_recorder_service_ = controller_nh_.advertiseService("dump_flight_recorder",
+                                                                    &JointTrajectoryController::dumpFlightRecorderService,
+                                                                    this);
+  }
+
+  // Serve callbacks once initialization is complete
+  if (callback_queue_)
+  {
+    callback_spinner_.reset(new ros::AsyncSpinner(callback_threads, callback_queue_.get()));
+    callback_spinner_->start();
+  }
+
   return true;
 }
 
-template <class SegmentImpl, class HardwareInterface>
-void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 update(const ros::Time& time, const ros::Duration& period)
 {
+  controller_instrumentation::UpdateTraceScope   trace_scope(name_.c_str());
+  controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+  controller_instrumentation::UpdateLatencyScope latency_scope(latency_monitor_);
+
   // Get currently followed trajectory
-  TrajectoryPtr curr_traj_ptr;
-  curr_trajectory_box_.get(curr_traj_ptr);
-  Trajectory& curr_traj = *curr_traj_ptr;
+  const Trajectory& curr_traj = *curr_trajectory_box_.getFromRT();
 
-  // Update time data
+  // Update time data. Trajectory time progresses at the speed scaling rate
   TimeData time_data;
-  time_data.time   = time;                                     // Cache current time
-  time_data.period = period;                                   // Cache current control period
-  time_data.uptime = time_data_.readFromRT()->uptime + period; // Update controller uptime
-  time_data_.writeFromNonRT(time_data); // TODO: Grrr, we need a lock-free data structure here!
+  time_data.time            = time;   // Cache current time
+  time_data.period          = period; // Cache current control period
+  time_data.uptime          = rt_time_data_.uptime + ros::Duration(speed_scaling_.update(period.toSec()));
+  time_data.unscaled_uptime = rt_time_data_.unscaled_uptime + period;
+  rt_time_data_ = time_data;
+  time_data_.write(time_data);
+  const bool speed_scaled = speed_scaling_.active();
 
   // NOTE: It is very important to execute the two above code blocks in the specified sequence: first get current
   // trajectory, then update time data. Hopefully the following paragraph sheds a bit of light on the rationale.
@@ -368,100 +790,211 @@ update(const ros::Time& time, const ros::Duration& period)
   // fetch the currently followed trajectory, it has been updated by the non-rt thread with something that starts in the
   // next control cycle, leaving the current cycle without a valid trajectory.
 
-  // Update current state and state error
-  for (unsigned int i = 0; i < joints_.size(); ++i)
+  // Read the state of all joints at once, so that the scattered loads of hardware data are issued back to back, and
+  // the sampling and tolerance logic below only touches controller data
+  for (unsigned int i = 0; i < jointCount(); ++i)
   {
     current_state_.position[i] = joints_[i].getPosition();
     current_state_.velocity[i] = joints_[i].getVelocity();
     // There's no acceleration data available in a joint handle
+  }
 
-    typename TrajectoryPerJoint::const_iterator segment_it = sample(curr_traj[i], time_data.uptime.toSec(), desired_joint_state_);
-    if (curr_traj[i].end() == segment_it)
+  // When all joints share segment boundaries, sample them in a single pass over the packed trajectory
+  const bool packed = !curr_traj.packed().empty();
+  typename Trajectory::Packed::size_type packed_segment = 0;
+  if (packed)
+  {
+    packed_segment = curr_traj.packed().sample(time_data.uptime.toSec(), desired_state_, packed_cursor_);
+    if (packed_segment == curr_traj.packed().size())
     {
       // Non-realtime safe, but should never happen under normal operation
       ROS_ERROR_NAMED(name_,
                       "Unexpected error: No trajectory defined at current time. Please contact the package maintainer.");
       return;
     }
-    desired_state_.position[i] = desired_joint_state_.position[0];
-    desired_state_.velocity[i] = desired_joint_state_.velocity[0];
-    desired_state_.acceleration[i] = desired_joint_state_.acceleration[0]; ;
+  }
+
+  // Joints whose tolerances are to be checked in this cycle. Tolerances are only checked every
+  // tolerance_check_stride_ cycles
+  RealtimeGoalHandlePtr active_goal(rt_active_goal_);
+  path_check_joints_.reset();
+  goal_check_joints_.reset();
+  const bool check_tolerances = tolerance_check_countdown_ == 0;
+  tolerance_check_countdown_ = check_tolerances ? tolerance_check_stride_ - 1 : tolerance_check_countdown_ - 1;
+
+  // Update desired state and state error of joint i, and gather the tolerances to check. Only data of joint i and
+  // joint_state is written, besides the active goal for joint zero, so that groups of joints can be updated in parallel
+  const auto update_joint = [&](unsigned int i, typename Segment::State& joint_state) -> bool
+  {
+    // Desired state of the joint. The packed trajectory was sampled into desired_state_ for all joints, while segments
+    // sample single-joint states. Values are then processed in local variables and written to desired_state_ once
+    typename TrajectoryPerJoint::const_iterator segment_it;
+    Scalar desired_position, desired_velocity, desired_acceleration;
+    if (packed)
+    {
+      segment_it = curr_traj[i].begin() + packed_segment;
+      desired_position     = desired_state_.position[i];
+      desired_velocity     = desired_state_.velocity[i];
+      desired_acceleration = desired_state_.acceleration[i];
+    }
+    else
+    {
+      segment_it = sample(curr_traj[i], time_data.uptime.toSec(), joint_state, segment_cursors_[i]);
+      if (curr_traj[i].end() == segment_it) {return false;}
+      desired_position     = joint_state.position[0];
+      desired_velocity     = joint_state.velocity[0];
+      desired_acceleration = joint_state.acceleration[0];
+    }
+
+    // Blended goals become active once their segments are reached. They contain all joints, so checking one suffices
+    if (i == 0 && !curr_traj.blendedGoals().empty())
+    {
+      updateBlendedGoal(curr_traj, curr_traj.goalHandle(i, segment_it), active_goal);
+    }
 
-    state_joint_error_.position[0] = angles::shortest_angular_distance(current_state_.position[i],desired_joint_state_.position[0]);
-    state_joint_error_.velocity[0] = desired_joint_state_.velocity[0] - current_state_.velocity[i];
-    state_joint_error_.acceleration[0] = 0.0;
+    // Sampled states are expressed in trajectory time, commands in controller time
+    if (speed_scaled) {speed_scaling_.scaleState(desired_velocity, desired_acceleration);}
+    desired_state_.position[i]     = desired_position;
+    desired_state_.velocity[i]     = desired_velocity;
+    desired_state_.acceleration[i] = desired_acceleration;
 
-    state_error_.position[i] = angles::shortest_angular_distance(current_state_.position[i],desired_joint_state_.position[0]);
-    state_error_.velocity[i] = desired_joint_state_.velocity[0] - current_state_.velocity[i];
+    state_error_.position[i] = angles::shortest_angular_distance(current_state_.position[i], desired_position);
+    state_error_.velocity[i] = desired_velocity - current_state_.velocity[i];
     state_error_.acceleration[i] = 0.0;
 
-    //Check tolerances
-    const RealtimeGoalHandlePtr rt_segment_goal = segment_it->getGoalHandle();
-    if (rt_segment_goal && rt_segment_goal == rt_active_goal_)
+    // Gather the tolerances to check, which are checked for all joints at once below
+    if (!check_tolerances) {return true;}
+    path_tolerances_.reset(i);
+    joint_checks_[i] = 0;
+    const RealtimeGoalHandlePtr rt_segment_goal = curr_traj.goalHandle(i, segment_it);
+    if (rt_segment_goal && rt_segment_goal == active_goal)
     {
-      // Check tolerances
       if (time_data.uptime.toSec() < segment_it->endTime())
       {
         // Currently executing a segment: check path tolerances
-        const SegmentTolerancesPerJoint<Scalar>& joint_tolerances = segment_it->getTolerances();
-        if (!checkStateTolerancePerJoint(state_joint_error_, joint_tolerances.state_tolerance))
-        {
-          if (verbose_)
-          {
-            ROS_ERROR_STREAM_NAMED(name_,"Path tolerances failed for joint: " << joint_names_[i]);
-            checkStateTolerancePerJoint(state_joint_error_, joint_tolerances.state_tolerance, true);
-          }
-          rt_segment_goal->preallocated_result_->error_code =
-          control_msgs::FollowJointTrajectoryResult::PATH_TOLERANCE_VIOLATED;
-          rt_segment_goal->setAborted(rt_segment_goal->preallocated_result_);
-          rt_active_goal_.reset();
-          successful_joint_traj_.reset();
-        }
+        path_tolerances_.set(i, segment_it->getTolerances().state_tolerance);
+        joint_checks_[i] = PATH_CHECK;
       }
       else if (segment_it == --curr_traj[i].end())
       {
-        if (verbose_)
-          ROS_DEBUG_STREAM_THROTTLE_NAMED(1,name_,"Finished executing last segment, checking goal tolerances");
+        // Checks that we end inside the goal tolerances, while there is still time left to meet them
+        const SegmentTolerancesPerJoint<Scalar>& tolerances = segment_it->getTolerances();
+        goal_tolerances_.set(i, tolerances.goal_state_tolerance);
+        const bool time_exceeded = time_data.uptime.toSec() >= segment_it->endTime() + tolerances.goal_time_tolerance;
+        joint_checks_[i] = GOAL_CHECK | (time_exceeded ? GOAL_TIME_EXCEEDED : 0);
+      }
+    }
+    return true;
+  };
 
-        // Controller uptime
-        const ros::Time uptime = time_data_.readFromRT()->uptime;
+  // Joint zero goes first, as it may activate a blended goal, then each group updates its share of the other joints
+  bool sampled = update_joint(0, group_joint_states_[0]);
+  if (sampled && jointCount() > 1)
+  {
+    const std::size_t n_others = jointCount() - 1;
+    const auto update_group = [&](std::size_t group)
+    {
+      const std::size_t end = 1 + parallel_update_.begin(n_others, group + 1);
+      bool group_sampled = true;
+      for (std::size_t i = 1 + parallel_update_.begin(n_others, group); i < end && group_sampled; ++i)
+      {
+        group_sampled = update_joint(i, group_joint_states_[group]);
+      }
+      group_sampled_[group] = group_sampled;
+    };
+    parallel_update_.run(update_group);
+    for (std::size_t group = 0; group < group_sampled_.size(); ++group) {sampled = sampled && group_sampled_[group];}
+  }
+  if (!sampled)
+  {
+    // Non-realtime safe, but should never happen under normal operation
+    ROS_ERROR_NAMED(name_,
+                    "Unexpected error: No trajectory defined at current time. Please contact the package maintainer.");
+    return;
+  }
 
-        // Checks that we have ended inside the goal tolerances
-        const SegmentTolerancesPerJoint<Scalar>& tolerances = segment_it->getTolerances();
-        const bool inside_goal_tolerances = checkStateTolerancePerJoint(state_joint_error_, tolerances.goal_state_tolerance);
+  // Merge the tolerance checks of all joints
+  if (check_tolerances)
+  {
+    for (unsigned int i = 0; i < jointCount(); ++i)
+    {
+      const char checks = joint_checks_[i];
+      if (checks & PATH_CHECK) {path_check_joints_.set(i);}
+      if (checks & GOAL_CHECK)
+      {
+        goal_check_joints_.set(i);
+        goal_time_exceeded_[i] = (checks & GOAL_TIME_EXCEEDED) != 0;
+      }
+    }
+    if (verbose_ && goal_check_joints_.any())
+      ROS_DEBUG_STREAM_THROTTLE_NAMED(1,name_,"Finished executing last segment, checking goal tolerances");
+  }
 
-        if (inside_goal_tolerances)
-        {
-          successful_joint_traj_[i] = 1;
-        }
-        else if (uptime.toSec() < segment_it->endTime() + tolerances.goal_time_tolerance)
-        {
-          // Still have some time left to meet the goal state tolerances
-        }
-        else
+  // Check path tolerances
+  if (path_check_joints_.any() && !checkStateTolerances(state_error_, path_tolerances_, tolerance_violations_))
+  {
+    CONTROLLER_TRACEPOINT1(path_tolerance_violated, name_.c_str());
+    if (verbose_)
+    {
+      for (std::size_t i = 0; i < jointCount(); ++i)
+      {
+        if (!isToleranceViolated(tolerance_violations_, i)) {continue;}
+        ROS_ERROR_STREAM_NAMED(name_,"Path tolerances failed for joint: " << joint_names_[i]);
+        setJointError(i);
+        checkStateTolerancePerJoint(state_joint_error_, StateTolerances<Scalar>(path_tolerances_.position[i],
+                                                                                path_tolerances_.velocity[i],
+                                                                                path_tolerances_.acceleration[i]), true);
+      }
+    }
+    active_goal->preallocated_result_->error_code = control_msgs::FollowJointTrajectoryResult::PATH_TOLERANCE_VIOLATED;
+    active_goal->setAborted(active_goal->preallocated_result_);
+    goals_aborted_metric_.increment();
+    flight_recorder_.requestDump("path_tolerance_violated");
+    rt_active_goal_.reset();
+    successful_joint_traj_.reset();
+  }
+  // Check goal tolerances of joints that finished their last segment
+  else if (goal_check_joints_.any())
+  {
+    checkStateTolerances(state_error_, goal_tolerances_, tolerance_violations_);
+    for (std::size_t i = goal_check_joints_.find_first(); i != goal_check_joints_.npos; i = goal_check_joints_.find_next(i))
+    {
+      if (!isToleranceViolated(tolerance_violations_, i))
+      {
+        successful_joint_traj_[i] = 1;
+      }
+      else if (goal_time_exceeded_[i])
+      {
+        CONTROLLER_TRACEPOINT2(goal_tolerance_violated, name_.c_str(), i);
+        if (verbose_)
         {
-          if (verbose_)
-          {
-            ROS_ERROR_STREAM_NAMED(name_,"Goal tolerances failed for joint: "<< joint_names_[i]);
-            // Check the tolerances one more time to output the errors that occurs
-            checkStateTolerancePerJoint(state_joint_error_, tolerances.goal_state_tolerance, true);
-          }
-
-          rt_segment_goal->preallocated_result_->error_code = control_msgs::FollowJointTrajectoryResult::GOAL_TOLERANCE_VIOLATED;
-          rt_segment_goal->setAborted(rt_segment_goal->preallocated_result_);
-          rt_active_goal_.reset();
-          successful_joint_traj_.reset();
+          ROS_ERROR_STREAM_NAMED(name_,"Goal tolerances failed for joint: "<< joint_names_[i]);
+          // Check the tolerances one more time to output the errors that occurs
+          setJointError(i);
+          checkStateTolerancePerJoint(state_joint_error_, StateTolerances<Scalar>(goal_tolerances_.position[i],
+                                                                                  goal_tolerances_.velocity[i],
+                                                                                  goal_tolerances_.acceleration[i]), true);
         }
+
+        active_goal->preallocated_result_->error_code = control_msgs::FollowJointTrajectoryResult::GOAL_TOLERANCE_VIOLATED;
+        active_goal->setAborted(active_goal->preallocated_result_);
+        goals_aborted_metric_.increment();
+        flight_recorder_.requestDump("goal_tolerance_violated");
+        rt_active_goal_.reset();
+        successful_joint_traj_.reset();
+        break;
       }
+      // Otherwise, there is still some time left to meet the goal state tolerances
     }
   }
 
   //If there is an active goal and all segments finished successfully then set goal as succeeded
   RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
-  if (current_active_goal && successful_joint_traj_.count() == joints_.size())
+  if (current_active_goal && successful_joint_traj_.count() == jointCount())
   {
     current_active_goal->preallocated_result_->error_code = control_msgs::FollowJointTrajectoryResult::SUCCESSFUL;
     current_active_goal->setSucceeded(current_active_goal->preallocated_result_);
+    goals_succeeded_metric_.increment();
     current_active_goal.reset(); // do not publish feedback
     rt_active_goal_.reset();
     successful_joint_traj_.reset();
@@ -472,25 +1005,25 @@ update(const ros::Time& time, const ros::Duration& period)
                                   desired_state_, state_error_);
 
   // Set action feedback
-  if (current_active_goal)
+  if (current_active_goal) {setActionFeedback(current_active_goal, time_data);}
+
+  // Share the desired state of this cycle with the query state service
+  if (query_state_snapshot_)
   {
-    current_active_goal->preallocated_feedback_->header.stamp          = time_data_.readFromRT()->time;
-    current_active_goal->preallocated_feedback_->desired.positions     = desired_state_.position;
-    current_active_goal->preallocated_feedback_->desired.velocities    = desired_state_.velocity;
-    current_active_goal->preallocated_feedback_->desired.accelerations = desired_state_.acceleration;
-    current_active_goal->preallocated_feedback_->actual.positions      = current_state_.position;
-    current_active_goal->preallocated_feedback_->actual.velocities     = current_state_.velocity;
-    current_active_goal->preallocated_feedback_->error.positions       = state_error_.position;
-    current_active_goal->preallocated_feedback_->error.velocities      = state_error_.velocity;
-    current_active_goal->setFeedback( current_active_goal->preallocated_feedback_ );
+    rt_state_snapshot_.time    = time_data.time;
+    rt_state_snapshot_.desired = desired_state_;
+    state_snapshot_.write(rt_state_snapshot_);
   }
 
   // Publish state
-  publishState(time_data.uptime);
+  publishState(time_data.unscaled_uptime);
+  publishStateSummary(time_data.unscaled_uptime);
+  publishLookahead(curr_traj, time_data);
+  writeTelemetry(time_data.time);
 }
 
-template <class SegmentImpl, class HardwareInterface>
-bool JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 updateTrajectoryCommand(const JointTrajectoryConstPtr& msg, RealtimeGoalHandlePtr gh, std::string* error_string)
 {
   typedef InitJointTrajectoryOptions<Trajectory> Options;
@@ -515,98 +1048,785 @@ updateTrajectoryCommand(const JointTrajectoryConstPtr& msg, RealtimeGoalHandlePt
     return false;
   }
 
-  // Time data
-  TimeData* time_data = time_data_.readFromRT(); // TODO: Grrr, we need a lock-free data structure here!
-
-  // Time of the next update
-  const ros::Time next_update_time = time_data->time + time_data->period;
+  CONTROLLER_TRACEPOINT2(trajectory_command_received, name_.c_str(), msg->points.size());
 
-  // Uptime of the next update
-  ros::Time next_update_uptime = time_data->uptime + time_data->period;
+  // Time data
+  const TimeData time_data = getTimeData();
 
   // Hold current position if trajectory is empty
   if (msg->points.empty())
   {
-    setHoldPosition(time_data->uptime, gh);
+    setHoldPosition(time_data.uptime, gh);
     ROS_DEBUG_NAMED(name_, "Empty trajectory command, stopping.");
     return true;
   }
 
-  // Trajectory initialization options
-  TrajectoryPtr curr_traj_ptr;
-  curr_trajectory_box_.get(curr_traj_ptr);
+  // Update currently executing trajectory. Goals that continue it are blended into it
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  GoalBlend blend;
+  const bool blended = getGoalBlend(*msg, gh, *curr_traj_ptr, time_data.uptime + time_data.period, blend);
+  ros::Time splice_uptime;
+  std::size_t end_point = 0;
+  const ros::WallTime fit_start = ros::WallTime::now();
+  TrajectoryPtr traj_ptr = fitTrajectoryCommand(*msg, gh, time_data, ros::Duration(0.0), curr_traj_ptr.get(),
+                                                splice_uptime, end_point, error_string, blended ? &blend : 0);
+  if (!traj_ptr) {return false;}
+  fit_duration_.record(static_cast<std::uint64_t>((ros::WallTime::now() - fit_start).toNSec()));
+  CONTROLLER_TRACEPOINT2(trajectory_command_fitted, name_.c_str(), end_point);
+
+  curr_trajectory_box_.set(traj_ptr);
+  CONTROLLER_TRACEPOINT1(trajectory_swapped, name_.c_str());
+  setLazyCommand(msg, end_point, traj_ptr);
+  return true;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+updateStreamingCommand(const JointTrajectoryConstPtr& msg, std::string* error_string)
+{
+  typedef InitJointTrajectoryOptions<Trajectory> Options;
+  Options options;
+  options.error_string = error_string;
+  std::string error_string_tmp;
+
+  // Preconditions
+  if (!this->isRunning())
+  {
+    error_string_tmp = "Can't accept new commands. Controller is not running.";
+    ROS_ERROR_STREAM_NAMED(name_, error_string_tmp);
+    options.setErrorString(error_string_tmp);
+    return false;
+  }
+
+  // Splice at the next update
+  const TimeData time_data = getTimeData();
+  const ros::Time next_update_time = time_data.time + time_data.period;
+  ros::Time next_update_uptime = time_data.uptime + time_data.period;
+
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  TrajectoryPtr traj_ptr = trajectory_pool_.acquire();
+
+  options.other_time_base    = &next_update_uptime;
+  options.current_trajectory = curr_traj_ptr.get();
+  options.joint_names        = &joint_names_;
+  options.joint_name_index   = &joint_name_index_;
+  options.angle_wraparound   = &angle_wraparound_;
+
+  try
+  {
+    if (!appendJointTrajectory<Trajectory>(*msg, next_update_time, options, *traj_ptr)) {return false;}
+  }
+  catch(const std::exception& ex)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, ex.what());
+    options.setErrorString(ex.what());
+    return false;
+  }
+
+  traj_ptr->blendedGoals().clear();
+  traj_ptr->pack();
+  curr_trajectory_box_.set(traj_ptr);
+  return true;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+typename JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::TrajectoryPtr
+JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+fitTrajectoryCommand(const trajectory_msgs::JointTrajectory& msg,
+                     RealtimeGoalHandlePtr                   gh,
+                     const TimeData&                         time_data,
+                     const ros::Duration&                    splice_delay,
+                     Trajectory*                             current_trajectory,
+                     ros::Time&                              splice_uptime,
+                     std::size_t&                            end_point,
+                     std::string*                            error_string,
+                     const GoalBlend*                        blend)
+{
+  typedef InitJointTrajectoryOptions<Trajectory> Options;
+  Options options;
+  options.error_string              = error_string;
+  std::string error_string_tmp;
+
+  // Time of the splice, which defaults to the next update
+  const ros::Time next_update_time = time_data.time + time_data.period + splice_delay;
+
+  // Uptime of the splice
+  splice_uptime = time_data.uptime + time_data.period + splice_delay;
 
-  options.other_time_base           = &next_update_uptime;
-  options.current_trajectory        = curr_traj_ptr.get();
+  // Trajectory initialization options
+  options.other_time_base           = &splice_uptime;
+  options.current_trajectory        = current_trajectory;
   options.joint_names               = &joint_names_;
+  options.joint_name_index          = &joint_name_index_;
   options.angle_wraparound          = &angle_wraparound_;
   options.rt_goal_handle            = gh;
-  options.default_tolerances        = &default_tolerances_;
+  const SegmentTolerancesConstPtr default_tolerances = defaultTolerances();
+  options.default_tolerances        = default_tolerances.get();
   options.allow_partial_joints_goal = allow_partial_joints_goal_;
+  options.fitting_pool              = joint_fitting_pool_.get();
+  options.parallel_fitting_threshold = parallel_fitting_threshold_;
+  options.knot_tolerance            = knot_tolerance_;
+
+  // Blended goals start where they are blended, expressed in the time base of messages
+  const ros::Time blend_start_time = blend ? next_update_time + (blend->start_uptime - splice_uptime) : ros::Time();
+  if (blend) {options.start_time = &blend_start_time;}
+
+  // Points past the fitting window are fitted later on by lazyFittingCB
+  const ros::Time fitting_end_time = next_update_time + lazy_fitting_horizon_ * 2.0;
+  end_point = msg.points.empty() ? 0 : msg.points.size() - 1;
+  if (!lazy_fitting_horizon_.isZero())
+  {
+    options.fitting_end_time = &fitting_end_time;
+    options.end_point        = &end_point;
+  }
 
-  // Update currently executing trajectory
   try
   {
-    TrajectoryPtr traj_ptr(new Trajectory);
-    *traj_ptr = initJointTrajectory<Trajectory>(*msg, next_update_time, options);
-    if (!traj_ptr->empty())
-    {
-      curr_trajectory_box_.set(traj_ptr);
-    }
-    else
+    TrajectoryPtr traj_ptr = trajectory_pool_.acquire();
+    initJointTrajectory<Trajectory>(msg, next_update_time, options, *traj_ptr);
+    if (traj_ptr->empty()) {return TrajectoryPtr();}
+
+    traj_ptr->blendedGoals().clear();
+    if (blend)
     {
-      return false;
+      traj_ptr->blendedGoals() = blend->queued_goals;
+      traj_ptr->blendedGoals().push_back(gh);
     }
+
+    traj_ptr->pack(); // Fails for partial-joint goals with differing segment boundaries, which are sampled per joint
+    return traj_ptr;
   }
   catch(const std::exception& ex)
   {
     ROS_ERROR_STREAM_NAMED(name_, ex.what());
     options.setErrorString(ex.what());
-    return false;
   }
   catch(...)
   {
     error_string_tmp = "Unexpected exception caught when initializing trajectory from ROS message data.";
     ROS_ERROR_STREAM_NAMED(name_, error_string_tmp);
     options.setErrorString(error_string_tmp);
-    return false;
   }
+  return TrajectoryPtr();
+}
 
-  return true;
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+submitTrajectoryCommand(const JointTrajectoryConstPtr& msg, RealtimeGoalHandlePtr gh)
+{
+  TrajectoryRequestPtr request(new TrajectoryRequest);
+  request->msg      = msg;
+  request->gh       = gh;
+  request->canceled = false;
+  {
+    std::lock_guard<std::mutex> lock(command_mutex_);
+    request->sequence = ++command_sequence_;
+    request->deferred = gh && queue_goals_ && !pending_goals_.empty(); // Submitted once the goals ahead are fitted
+    if (gh) {pending_goals_.push_back(request);}
+  }
+  if (!request->deferred)
+  {
+    fitting_pool_->submit(std::bind(&JointTrajectoryController::processTrajectoryRequest, this, request));
+  }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-void JointTrajectoryController<SegmentImpl, HardwareInterface>::
-goalCB(GoalHandle gh)
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+processTrajectoryRequest(const TrajectoryRequestPtr& request)
 {
-  ROS_DEBUG_STREAM_NAMED(name_,"Received new action goal");
+  applyTrajectoryRequest(request);
 
-  // Precondition: Running controller
-  if (!this->isRunning())
+  // Queued goals are fitted one at a time, so that each one is queued behind the previous one
+  std::lock_guard<std::mutex> lock(command_mutex_);
+  if (!pending_goals_.empty() && pending_goals_.front()->deferred)
   {
-    ROS_ERROR_NAMED(name_, "Can't accept new action goals. Controller is not running.");
-    control_msgs::FollowJointTrajectoryResult result;
-    result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_GOAL; // TODO: Add better error status to msg?
-    gh.setRejected(result);
-    return;
+    const TrajectoryRequestPtr next_request = pending_goals_.front();
+    next_request->deferred = false;
+    fitting_pool_->submit(std::bind(&JointTrajectoryController::processTrajectoryRequest, this, next_request));
   }
+}
 
-  // If partial joints goals are not allowed, goal should specify all controller joints
-  if (!allow_partial_joints_goal_)
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+applyTrajectoryRequest(const TrajectoryRequestPtr& request)
+{
+  const RealtimeGoalHandlePtr& rt_goal = request->gh;
+  std::string error_string;
+  ros::Duration splice_delay(0.0);
+
+  for (unsigned int attempt = 1; ; ++attempt)
   {
-    if (gh.getGoal()->trajectory.joint_names.size() != joint_names_.size())
+    // Goals that continue the current trajectory are blended into it. The last attempt never blends, so that it can
+    // always be applied
+    const TimeData time_data = getTimeData();
+    TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+    GoalBlend blend;
+    bool blended = false;
+    if (rt_goal && attempt < max_fit_attempts_)
     {
-      ROS_ERROR_NAMED(name_, "Joints on incoming goal don't match the controller joints.");
-      control_msgs::FollowJointTrajectoryResult result;
-      result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_JOINTS;
-      gh.setRejected(result);
-      return;
+      std::lock_guard<std::mutex> lock(command_mutex_);
+      blended = getGoalBlend(*request->msg, rt_goal, *curr_traj_ptr,
+                             time_data.uptime + time_data.period + splice_delay, blend);
     }
-  }
 
-  // Goal should specify valid controller joints (they can be ordered differently). Reject if this is not the case
-  using internal::mapping;
-  std::vector<unsigned int> mapping_vector = mapping(gh.getGoal()->trajectory.joint_names, joint_names_);
+    // Fit without holding the lock, so that callbacks (e.g. cancel requests) are not blocked
+    ros::Time splice_uptime;
+    std::size_t end_point = 0;
+    const ros::WallTime fit_start = ros::WallTime::now();
+    TrajectoryPtr traj_ptr;
+    if (this->isRunning())
+    {
+      traj_ptr = fitTrajectoryCommand(*request->msg, rt_goal, time_data, splice_delay, curr_traj_ptr.get(),
+                                      splice_uptime, end_point, &error_string, blended ? &blend : 0);
+    }
+    else
+    {
+      error_string = "Can't accept new commands. Controller is not running.";
+      ROS_ERROR_STREAM_NAMED(name_, error_string);
+    }
+    const ros::WallDuration fit_duration = ros::WallTime::now() - fit_start;
+
+    std::lock_guard<std::mutex> lock(command_mutex_);
+    if (traj_ptr) {fit_duration_.record(static_cast<std::uint64_t>(fit_duration.toNSec()));}
+
+    // Canceled goals have already been reported by cancelCB
+    if (request->canceled) {return;}
+    if (rt_goal)
+    {
+      pending_goals_.erase(std::remove(pending_goals_.begin(), pending_goals_.end(), request), pending_goals_.end());
+    }
+
+    // Reject invalid commands
+    if (!traj_ptr || !this->isRunning())
+    {
+      if (rt_goal)
+      {
+        control_msgs::FollowJointTrajectoryResult result;
+        result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_GOAL;
+        result.error_string = error_string;
+        rt_goal->gh_.setRejected(result);
+        goals_rejected_metric_.increment();
+      }
+      return;
+    }
+
+    // A newer command has already been applied. This one has been superseded before it got the chance to run
+    if (request->sequence < committed_sequence_)
+    {
+      ROS_DEBUG_NAMED(name_, "Discarding trajectory command superseded by a newer one.");
+      if (rt_goal) {rt_goal->gh_.setCanceled();}
+      return;
+    }
+
+    // The splice is only valid if the trajectory it was computed from is still the current one, and the realtime
+    // loop has not sampled past the splice point yet. Blended trajectories only differ from the current one where the
+    // blend starts, and are also only valid if the goals they follow are unchanged
+    const TimeData now_data = getTimeData();
+    const ros::Time next_uptime = now_data.uptime + now_data.period;
+    const bool same_base = curr_traj_ptr == curr_trajectory_box_.get();
+    const bool on_time   = next_uptime <= (blended ? blend.start_uptime : splice_uptime);
+    GoalBlend now_blend;
+    const bool same_blend = !blended || (getGoalBlend(*request->msg, rt_goal, *curr_traj_ptr, next_uptime, now_blend) &&
+                                         now_blend.queued_goals == blend.queued_goals);
+    if ((same_base && on_time && same_blend) || attempt >= max_fit_attempts_)
+    {
+      if (!(same_base && on_time))
+      {
+        ROS_WARN_STREAM_NAMED(name_, "Trajectory fitting did not finish before the splice point after " << attempt <<
+                                     " attempts. The transition to the new trajectory may not be smooth.");
+      }
+      curr_trajectory_box_.set(traj_ptr);
+      setLazyCommand(request->msg, end_point, traj_ptr);
+      committed_sequence_ = request->sequence;
+      if      (!rt_goal)                                         {preemptGoals();}
+      else if (traj_ptr->blendedGoals().empty() ||
+               traj_ptr->blendedGoals().back() != rt_goal)        {acceptGoal(rt_goal);}
+      else                                                       {queueBlendedGoal(rt_goal);}
+      return;
+    }
+
+    // Retry, leaving enough headroom for the fit to complete before the splice point
+    splice_delay = ros::Duration(2.0 * fit_duration.toSec()) + now_data.period;
+    ROS_DEBUG_STREAM_NAMED(name_, "Trajectory fitting took " << fit_duration.toSec() << "s and missed the splice point. " <<
+                                  "Fitting again with a splice delay of " << splice_delay.toSec() << "s.");
+  }
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+acceptGoal(RealtimeGoalHandlePtr rt_goal)
+{
+  preemptGoals();
+  rt_goal->gh_.setAccepted();
+  goals_accepted_metric_.increment();
+  rt_active_goal_ = rt_goal;
+
+  // Setup goal status checking timer
+  goal_handle_timer_ = controller_nh_.createTimer(action_monitor_period_,
+                                                  &RealtimeGoalHandle::runNonRealtime,
+                                                  rt_goal);
+  goal_handle_timer_.start();
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+getGoalBlend(const trajectory_msgs::JointTrajectory& msg,
+             const RealtimeGoalHandlePtr&            gh,
+             const Trajectory&                       current_trajectory,
+             const ros::Time&                        splice_uptime,
+             GoalBlend&                              blend) const
+{
+  const unsigned int n_joints = jointCount();
+  if (!(blend_goals_ || queue_goals_) || !gh || !msg.header.stamp.isZero() || msg.points.empty()) {return false;}
+  if (msg.joint_names.size() != n_joints || current_trajectory.size() != n_joints) {return false;}
+
+  // Goals are blended behind the last goal queued for execution, which must still be executing
+  const std::size_t handed_over = handedOverBlendedGoals();
+  const RealtimeGoalHandlePtr last_goal = blended_goals_.size() > handed_over ? blended_goals_.back()
+                                                                             : RealtimeGoalHandlePtr(rt_active_goal_);
+  if (!last_goal) {return false;}
+
+  // Lazily fitted trajectories do not end where their goal does
+  if (lazy_command_ && lazy_command_->trajectory.get() == &current_trajectory) {return false;}
+
+  using internal::mapping;
+  const std::vector<unsigned int> permutation = mapping(msg.joint_names, joint_names_, &joint_name_index_);
+  if (permutation.size() != n_joints) {return false;}
+
+  const trajectory_msgs::JointTrajectoryPoint& first_point = msg.points.front();
+  if (first_point.positions.size() != n_joints) {return false;}
+  const bool queue = queue_goals_ && first_point.time_from_start > ros::Duration(0.0);
+
+  // All joints must end together with the last goal, after the splice
+  typename Segment::State end_state;
+  typename Segment::Time end_time = 0.0;
+  for (unsigned int j = 0; j < n_joints; ++j)
+  {
+    const unsigned int i = permutation[j];
+    const TrajectoryPerJoint& joint_traj = current_trajectory[i];
+    if (joint_traj.empty() || current_trajectory.goalHandle(i, joint_traj.end() - 1) != last_goal) {return false;}
+
+    const Segment& last_segment = joint_traj.back();
+    if (j == 0) {end_time = last_segment.endTime();}
+    if (last_segment.endTime() != end_time || end_time <= splice_uptime.toSec()) {return false;}
+
+    // Unless the goal is queued, the first point must continue the end state
+    if (queue) {continue;}
+    last_segment.sample(end_time, end_state);
+    const Scalar position_error = angle_wraparound_[i]
+                                ? angles::shortest_angular_distance(end_state.position[0], first_point.positions[j])
+                                : first_point.positions[j] - end_state.position[0];
+    const Scalar velocity     = first_point.velocities.empty()    ? 0.0 : first_point.velocities[j];
+    const Scalar acceleration = first_point.accelerations.empty() ? 0.0 : first_point.accelerations[j];
+    if (std::abs(position_error)                         > blend_tolerances_.position     ||
+        std::abs(velocity - end_state.velocity[0])         > blend_tolerances_.velocity     ||
+        std::abs(acceleration - end_state.acceleration[0]) > blend_tolerances_.acceleration)
+    {
+      return false;
+    }
+  }
+
+  blend.start_uptime = ros::Time(end_time);
+  blend.queued_goals.assign(blended_goals_.begin() + handed_over, blended_goals_.end());
+  return true;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+std::size_t JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+handedOverBlendedGoals() const
+{
+  const std::uint64_t handovers = blended_goal_handovers_.load() - released_blended_goals_;
+  return std::min(static_cast<std::size_t>(handovers), blended_goals_.size());
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+queueBlendedGoal(RealtimeGoalHandlePtr rt_goal)
+{
+  rt_goal->gh_.setAccepted();
+  goals_accepted_metric_.increment();
+  blended_goals_.push_back(rt_goal);
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+cancelBlendedGoals()
+{
+  const std::size_t handed_over = handedOverBlendedGoals();
+  for (std::size_t k = handed_over; k < blended_goals_.size(); ++k)
+  {
+    blended_goals_[k]->gh_.setCanceled();
+  }
+  blended_goals_.resize(handed_over);
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+cancelQueuedGoal(GoalHandle gh)
+{
+  const std::size_t handed_over = handedOverBlendedGoals();
+  typename std::vector<RealtimeGoalHandlePtr>::iterator goal_it = blended_goals_.begin() + handed_over;
+  for (; goal_it != blended_goals_.end() && (*goal_it)->gh_ != gh; ++goal_it) {}
+  if (goal_it == blended_goals_.end()) {return false;}
+
+  // Goals queued after the canceled one continue it, so they are dropped as well
+  const std::vector<RealtimeGoalHandlePtr> dropped_goals(goal_it, blended_goals_.end());
+  const auto is_dropped = [&dropped_goals](const RealtimeGoalHandlePtr& goal)
+  {
+    return std::find(dropped_goals.begin(), dropped_goals.end(), goal) != dropped_goals.end();
+  };
+
+  // Keep the current trajectory up to the segments of the dropped goals
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  const Trajectory& curr_traj = *curr_traj_ptr; // Read-only: Executed by the realtime thread
+  TrajectoryPtr traj_ptr = trajectory_pool_.acquire();
+  traj_ptr->resize(curr_traj.size());
+  typename Segment::Time drop_time = std::numeric_limits<typename Segment::Time>::max();
+  for (unsigned int i = 0; i < curr_traj.size(); ++i)
+  {
+    const TrajectoryPerJoint& curr_joint_traj = curr_traj[i];
+    typename TrajectoryPerJoint::const_iterator drop_it = curr_joint_traj.begin();
+    for (; drop_it != curr_joint_traj.end() && !is_dropped(curr_traj.goalHandle(i, drop_it)); ++drop_it) {}
+    if (drop_it == curr_joint_traj.end())
+    {
+      traj_ptr->share(i, curr_traj); // Joint not affected by the dropped goals
+      continue;
+    }
+    drop_time = std::min(drop_time, drop_it->startTime());
+    TrajectoryPerJoint& joint_traj = (*traj_ptr)[i];
+    for (typename TrajectoryPerJoint::const_iterator it = curr_joint_traj.begin(); it != drop_it; ++it)
+    {
+      joint_traj.push_back(*it);
+      joint_traj.back().setGoalHandle(curr_traj.goalHandle(i, it));
+    }
+  }
+  traj_ptr->blendedGoals() = curr_traj.blendedGoals();
+  traj_ptr->blendedGoals().erase(std::remove_if(traj_ptr->blendedGoals().begin(), traj_ptr->blendedGoals().end(),
+                                                is_dropped),
+                                 traj_ptr->blendedGoals().end());
+
+  // The realtime loop may already be executing the dropped segments, in which case all goals stop
+  const TimeData time_data = getTimeData();
+  const bool valid = traj_ptr->size() == jointCount() &&
+                     std::none_of(traj_ptr->begin(), traj_ptr->end(),
+                                  [](const TrajectoryPerJoint& joint_traj) {return joint_traj.empty();});
+  if (!valid || time_data.uptime.toSec() + time_data.period.toSec() > drop_time)
+  {
+    ROS_DEBUG_NAMED(name_, "Canceled queued action goal was about to start. Stopping all goals.");
+    setHoldPosition(time_data.uptime);
+    preemptGoals();
+    return true;
+  }
+
+  traj_ptr->pack();
+  curr_trajectory_box_.set(traj_ptr);
+
+  ROS_DEBUG_NAMED(name_, "Canceling queued action goal because cancel callback recieved from actionlib.");
+  for (const RealtimeGoalHandlePtr& goal : dropped_goals) {goal->gh_.setCanceled();}
+  blended_goals_.erase(goal_it, blended_goals_.end());
+  return true;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+preemptGoals()
+{
+  cancelBlendedGoals();
+  preemptActiveGoal();
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+blendedGoalsCB(const ros::TimerEvent& event)
+{
+  std::lock_guard<std::mutex> lock(command_mutex_);
+  if (!this->isRunning()) {cancelBlendedGoals();}
+
+  // Publish results set by the realtime thread
+  for (const RealtimeGoalHandlePtr& goal : blended_goals_) {goal->runNonRealtime(event);}
+
+  // Release handed over goals once they finished
+  while (handedOverBlendedGoals() > 0)
+  {
+    const unsigned int status = blended_goals_.front()->gh_.getGoalStatus().status;
+    if (status == actionlib_msgs::GoalStatus::ACTIVE || status == actionlib_msgs::GoalStatus::PREEMPTING) {break;}
+    blended_goals_.erase(blended_goals_.begin());
+    ++released_blended_goals_;
+  }
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+updateBlendedGoal(const Trajectory&            trajectory,
+                  const RealtimeGoalHandlePtr& segment_goal,
+                  RealtimeGoalHandlePtr&       active_goal)
+{
+  if (!segment_goal || segment_goal == active_goal || segment_goal.get() == rt_blended_goal_) {return;}
+
+  // Goals blended before the last one made active are not considered again
+  const std::vector<RealtimeGoalHandlePtr>& blended_goals = trajectory.blendedGoals();
+  typename std::vector<RealtimeGoalHandlePtr>::const_iterator first_it = blended_goals.begin();
+  for (typename std::vector<RealtimeGoalHandlePtr>::const_iterator it = blended_goals.begin();
+       it != blended_goals.end(); ++it)
+  {
+    if (it->get() == rt_blended_goal_) {first_it = it + 1;}
+  }
+  typename std::vector<RealtimeGoalHandlePtr>::const_iterator goal_it =
+      std::find(first_it, blended_goals.cend(), segment_goal);
+  if (goal_it == blended_goals.end()) {return;}
+
+  // The previous goal, and goals too short to be sampled, were blended into this one along their path
+  if (active_goal)
+  {
+    active_goal->preallocated_result_->error_code = control_msgs::FollowJointTrajectoryResult::SUCCESSFUL;
+    active_goal->setSucceeded(active_goal->preallocated_result_);
+    goals_succeeded_metric_.increment();
+  }
+  for (typename std::vector<RealtimeGoalHandlePtr>::const_iterator it = first_it; it != goal_it; ++it)
+  {
+    (*it)->preallocated_result_->error_code = control_msgs::FollowJointTrajectoryResult::SUCCESSFUL;
+    (*it)->setSucceeded((*it)->preallocated_result_);
+    goals_succeeded_metric_.increment();
+  }
+
+  rt_active_goal_  = segment_goal;
+  active_goal      = segment_goal;
+  rt_blended_goal_ = segment_goal.get();
+  successful_joint_traj_.reset();
+  blended_goal_handovers_ += std::distance(first_it, goal_it) + 1;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+speedScalingCB(const std_msgs::Float64ConstPtr& msg)
+{
+  if (!setSpeedScaling(msg->data))
+  {
+    ROS_WARN_STREAM_NAMED(name_, "Ignoring invalid speed scaling " << msg->data << ".");
+  }
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+trajectoryFileCB(const std_msgs::StringConstPtr& msg)
+{
+  // Trajectory files are played back through lazy fitting, one window of points at a time
+  if (lazy_fitting_horizon_.isZero())
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Can't play back trajectory files. Lazy fitting is disabled, set the " <<
+                                  "'lazy_fitting_horizon' parameter to enable it.");
+    return;
+  }
+
+  std::shared_ptr<TrajectoryFile> file(new TrajectoryFile);
+  std::string error_string;
+  if (!file->open(msg->data, &error_string))
+  {
+    ROS_ERROR_STREAM_NAMED(name_, error_string);
+    return;
+  }
+  if (file->size() == 0)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Trajectory file '" << msg->data << "' has no points.");
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(command_mutex_);
+  if (!this->isRunning())
+  {
+    ROS_ERROR_NAMED(name_, "Can't accept new commands. Controller is not running.");
+    return;
+  }
+
+  // First window, starting at the next update
+  trajectory_msgs::JointTrajectory::Ptr window(new trajectory_msgs::JointTrajectory);
+  file->readPoints(0, file->findPoint((lazy_fitting_horizon_ * 2.0).toSec()) + 1, *window);
+
+  const TimeData time_data = getTimeData();
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  ros::Time splice_uptime;
+  std::size_t end_point = 0;
+  TrajectoryPtr traj_ptr = fitTrajectoryCommand(*window, RealtimeGoalHandlePtr(), time_data, ros::Duration(0.0),
+                                                curr_traj_ptr.get(), splice_uptime, end_point, &error_string);
+  if (!traj_ptr) {return;}
+
+  curr_trajectory_box_.set(traj_ptr);
+  setLazyCommand(window, end_point, traj_ptr, file, 0);
+  committed_sequence_ = ++command_sequence_;
+  preemptGoals();
+  ROS_DEBUG_STREAM_NAMED(name_, "Playing back trajectory file '" << msg->data << "' of " << file->size() << " points.");
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+setLazyCommand(const JointTrajectoryConstPtr& msg, std::size_t end_point, const TrajectoryPtr& trajectory,
+               const TrajectoryFilePtr& file, std::size_t file_point)
+{
+  const std::size_t n_points = file ? file->size() - file_point : msg->points.size();
+  if (end_point + 1 >= n_points)
+  {
+    lazy_command_.reset();
+    return;
+  }
+
+  // The fitted points end with the last segment of any joint of the message
+  const unsigned int joint_id = joint_name_index_.find(msg->joint_names.front())->second;
+
+  if (!lazy_command_) {lazy_command_.reset(new LazyCommand);}
+  lazy_command_->msg        = msg;
+  lazy_command_->end_point  = end_point;
+  const Trajectory& fitted_traj = *trajectory; // Read-only: Executed by the realtime thread
+  lazy_command_->end_uptime = fitted_traj[joint_id].back().endTime();
+  lazy_command_->trajectory = trajectory;
+  lazy_command_->file       = file;
+  lazy_command_->file_point = file_point;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+tolerancesCB(const std::vector<double>& values)
+{
+  std::shared_ptr<SegmentTolerances<Scalar> > tolerances(new SegmentTolerances<Scalar>(jointCount()));
+  for (unsigned int i = 0; i < jointCount(); ++i)
+  {
+    tolerances->state_tolerance[i].position      = values[2 + 2 * i];
+    tolerances->goal_state_tolerance[i].position = values[3 + 2 * i];
+    tolerances->goal_state_tolerance[i].velocity = values[0];
+  }
+  tolerances->goal_time_tolerance = values[1];
+
+  std::lock_guard<std::mutex> lock(default_tolerances_mutex_);
+  default_tolerances_ = tolerances;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+std::vector<double> JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+toleranceValues(const SegmentTolerances<Scalar>& tolerances) const
+{
+  std::vector<double> values;
+  values.push_back(tolerances.goal_state_tolerance.empty() ? 0.0 : tolerances.goal_state_tolerance[0].velocity);
+  values.push_back(tolerances.goal_time_tolerance);
+  for (unsigned int i = 0; i < jointCount(); ++i)
+  {
+    values.push_back(tolerances.state_tolerance[i].position);
+    values.push_back(tolerances.goal_state_tolerance[i].position);
+  }
+  return values;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+lazyFittingCB(const ros::TimerEvent& /*event*/)
+{
+  std::lock_guard<std::mutex> lock(command_mutex_);
+  if (!lazy_command_) {return;}
+
+  // Stop extending once the trajectory has been replaced, e.g. by a newer command or a hold trajectory
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  if (curr_traj_ptr != lazy_command_->trajectory || !this->isRunning())
+  {
+    lazy_command_.reset();
+    return;
+  }
+
+  // Extend once less than the horizon remains ahead of the next update
+  const TimeData time_data = getTimeData();
+  const ros::Time next_update_uptime = time_data.uptime + time_data.period;
+  if (lazy_command_->end_uptime > (next_update_uptime + lazy_fitting_horizon_).toSec()) {return;}
+
+  typedef InitJointTrajectoryOptions<Trajectory> Options;
+  Options options;
+  const ros::Time fitting_end_time = next_update_uptime + lazy_fitting_horizon_ * 2.0;
+  std::size_t end_point = lazy_command_->end_point;
+  options.current_trajectory = curr_traj_ptr.get();
+  options.joint_names        = &joint_names_;
+  options.joint_name_index   = &joint_name_index_;
+  options.angle_wraparound   = &angle_wraparound_;
+  options.fitting_end_time   = &fitting_end_time;
+  options.end_point          = &end_point;
+  options.knot_tolerance     = knot_tolerance_;
+
+  // Points of trajectory files are read one window at a time, starting at the last fitted point
+  JointTrajectoryConstPtr msg = lazy_command_->msg;
+  std::size_t first_point = lazy_command_->end_point;
+  const TrajectoryFilePtr file = lazy_command_->file;
+  std::size_t file_point = 0;
+  if (file)
+  {
+    file_point = lazy_command_->file_point + lazy_command_->end_point;
+    const double file_start_uptime = lazy_command_->end_uptime - file->timeFromStart(file_point);
+    const std::size_t file_end = file->findPoint(fitting_end_time.toSec() - file_start_uptime) + 1;
+
+    trajectory_msgs::JointTrajectory::Ptr window(new trajectory_msgs::JointTrajectory);
+    file->readPoints(file_point, file_end, *window);
+    msg = window;
+    first_point = 0;
+    options.fitting_end_time = 0;
+  }
+
+  TrajectoryPtr traj_ptr = trajectory_pool_.acquire();
+  try
+  {
+    if (!extendJointTrajectory<Trajectory>(*msg, time_data.uptime, first_point, options, *traj_ptr))
+    {
+      lazy_command_.reset();
+      return;
+    }
+  }
+  catch(const std::exception& ex)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Could not fit the remaining points of the trajectory command: " << ex.what());
+    lazy_command_.reset();
+    return;
+  }
+
+  traj_ptr->blendedGoals() = curr_traj_ptr->blendedGoals();
+  traj_ptr->pack();
+
+  // The realtime thread may have swapped in the hold trajectory while fitting, which must not be undone
+  if (!curr_trajectory_box_.compareAndSet(curr_traj_ptr, traj_ptr))
+  {
+    lazy_command_.reset();
+    return;
+  }
+  setLazyCommand(msg, end_point, traj_ptr, file, file_point);
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+goalCB(GoalHandle gh)
+{
+  ROS_DEBUG_STREAM_NAMED(name_,"Received new action goal");
+
+  // Precondition: Running controller
+  if (!this->isRunning())
+  {
+    ROS_ERROR_NAMED(name_, "Can't accept new action goals. Controller is not running.");
+    control_msgs::FollowJointTrajectoryResult result;
+    result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_GOAL; // TODO: Add better error status to msg?
+    gh.setRejected(result);
+    goals_rejected_metric_.increment();
+    return;
+  }
+
+  // If partial joints goals are not allowed, goal should specify all controller joints
+  if (!allow_partial_joints_goal_)
+  {
+    if (gh.getGoal()->trajectory.joint_names.size() != joint_names_.size())
+    {
+      ROS_ERROR_NAMED(name_, "Joints on incoming goal don't match the controller joints.");
+      control_msgs::FollowJointTrajectoryResult result;
+      result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_JOINTS;
+      gh.setRejected(result);
+      goals_rejected_metric_.increment();
+      return;
+    }
+  }
+
+  // Goal should specify valid controller joints (they can be ordered differently). Reject if this is not the case
+  using internal::mapping;
+  std::vector<unsigned int> mapping_vector = mapping(gh.getGoal()->trajectory.joint_names, joint_names_,
+                                                     &joint_name_index_);
 
   if (mapping_vector.empty())
   {
@@ -614,29 +1834,45 @@ goalCB(GoalHandle gh)
     control_msgs::FollowJointTrajectoryResult result;
     result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_JOINTS;
     gh.setRejected(result);
+    goals_rejected_metric_.increment();
     return;
   }
 
   // Try to update new trajectory
   RealtimeGoalHandlePtr rt_goal(new RealtimeGoalHandle(gh));
-  std::string error_string;
-  const bool update_ok = updateTrajectoryCommand(internal::share_member(gh.getGoal(), gh.getGoal()->trajectory),
-                                                 rt_goal,
-                                                 &error_string);
   rt_goal->preallocated_feedback_->joint_names = joint_names_;
+  JointTrajectoryConstPtr msg = internal::share_member(gh.getGoal(), gh.getGoal()->trajectory);
 
-  if (update_ok)
+  // Retime to the joint limits before fitting
+  if (retime_goals_ && msg->points.size() > 1)
+  {
+    trajectory_msgs::JointTrajectory::Ptr retimed_msg(new trajectory_msgs::JointTrajectory(*msg));
+    const double speedup = retimeTrajectory(retiming_limits_, mapping_vector, *retimed_msg);
+    ROS_DEBUG_STREAM_NAMED(name_, "Retimed goal to the joint limits. Its duration changed from " <<
+                                  msg->points.back().time_from_start.toSec() << "s to " <<
+                                  retimed_msg->points.back().time_from_start.toSec() << "s (speedup: " <<
+                                  speedup << ").");
+    msg = retimed_msg;
+  }
+
+  // Fit in the background. The goal is accepted or rejected once fitting finishes
+  if (fitting_pool_ && !msg->points.empty())
   {
-    // Accept new goal
-    preemptActiveGoal();
-    gh.setAccepted();
-    rt_active_goal_ = rt_goal;
+    submitTrajectoryCommand(msg, rt_goal);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(command_mutex_);
+  std::string error_string;
+  const bool update_ok = updateTrajectoryCommand(msg, rt_goal, &error_string);
 
-    // Setup goal status checking timer
-    goal_handle_timer_ = controller_nh_.createTimer(action_monitor_period_,
-                                                    &RealtimeGoalHandle::runNonRealtime,
-                                                    rt_goal);
-    goal_handle_timer_.start();
+  if (update_ok)
+  {
+    // Accept new goal, or queue it if it was blended into the executing one
+    committed_sequence_ = ++command_sequence_;
+    const TrajectoryPtr traj_ptr = curr_trajectory_box_.get();
+    if (traj_ptr->blendedGoals().empty() || traj_ptr->blendedGoals().back() != rt_goal) {acceptGoal(rt_goal);}
+    else                                                                               {queueBlendedGoal(rt_goal);}
   }
   else
   {
@@ -645,13 +1881,32 @@ goalCB(GoalHandle gh)
     result.error_code = control_msgs::FollowJointTrajectoryResult::INVALID_GOAL;
     result.error_string = error_string;
     gh.setRejected(result);
+    goals_rejected_metric_.increment();
   }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 cancelCB(GoalHandle gh)
 {
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  // Goals still being fitted are dropped before they ever become active
+  for (typename std::vector<TrajectoryRequestPtr>::iterator it = pending_goals_.begin(); it != pending_goals_.end(); ++it)
+  {
+    if ((*it)->gh->gh_ == gh)
+    {
+      (*it)->canceled = true;
+      pending_goals_.erase(it);
+      ROS_DEBUG_NAMED(name_, "Canceling pending action goal because cancel callback recieved from actionlib.");
+      gh.setCanceled();
+      return;
+    }
+  }
+
+  // Queued goals are dropped from the trajectory, which the active goal keeps executing
+  if (cancelQueuedGoal(gh)) {return;}
+
   RealtimeGoalHandlePtr current_active_goal(rt_active_goal_);
 
   // Check that cancel request refers to currently active goal (if any)
@@ -661,10 +1916,11 @@ cancelCB(GoalHandle gh)
     rt_active_goal_.reset();
 
     // Controller uptime
-    const ros::Time uptime = time_data_.readFromRT()->uptime;
+    const ros::Time uptime = getTimeData().uptime;
 
-    // Enter hold current position mode
+    // Enter hold current position mode. Goals queued behind the canceled one are dropped with it
     setHoldPosition(uptime);
+    cancelBlendedGoals();
     ROS_DEBUG_NAMED(name_, "Canceling active action goal because cancel callback recieved from actionlib.");
 
     // Mark the current goal as canceled
@@ -672,8 +1928,8 @@ cancelCB(GoalHandle gh)
   }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-bool JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 queryStateService(control_msgs::QueryTrajectoryState::Request&  req,
                   control_msgs::QueryTrajectoryState::Response& resp)
 {
@@ -684,54 +1940,163 @@ queryStateService(control_msgs::QueryTrajectoryState::Request&  req,
     return false;
   }
 
-  // Convert request time to internal monotonic representation
-  TimeData* time_data = time_data_.readFromRT();
-  const ros::Duration time_offset = req.time - time_data->time;
-  const ros::Time sample_time = time_data->uptime + time_offset;
+  std::lock_guard<std::mutex> lock(query_mutex_);
+
+  // Queries for the current time are answered with the desired state of the last update cycle
+  if (query_state_snapshot_ && req.time.isZero())
+  {
+    const StateSnapshot& snapshot = state_snapshot_.read();
+    resp.name         = joint_names_;
+    resp.position     = snapshot.desired.position;
+    resp.velocity     = snapshot.desired.velocity;
+    resp.acceleration = snapshot.desired.acceleration;
+    return true;
+  }
 
-  // Sample trajectory at requested time
-  TrajectoryPtr curr_traj_ptr;
-  curr_trajectory_box_.get(curr_traj_ptr);
-  Trajectory& curr_traj = *curr_traj_ptr;
+  // Convert request time to internal monotonic representation
+  const TimeData time_data = getTimeData();
+  const ros::Duration time_offset = req.time - time_data.time;
+  const ros::Time sample_time = time_data.uptime + time_offset;
 
-  typename Segment::State response_point = typename Segment::State(joint_names_.size());
+  // Sample trajectory at requested time. Cursors speed up the segment search of successive queries at similar times
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  const Trajectory& curr_traj = *curr_traj_ptr;
 
-  for (unsigned int i = 0; i < joints_.size(); ++i)
+  if (!curr_traj.packed().empty())
   {
-    typename Segment::State state;
-    typename TrajectoryPerJoint::const_iterator segment_it = sample(curr_traj[i], sample_time.toSec(), state);
-    if (curr_traj[i].end() == segment_it)
+    if (curr_traj.packed().sample(sample_time.toSec(), query_state_, query_packed_cursor_) == curr_traj.packed().size())
     {
       ROS_ERROR_STREAM_NAMED(name_, "Requested sample time precedes trajectory start time.");
       return false;
     }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < joints_.size(); ++i)
+    {
+      typename TrajectoryPerJoint::const_iterator segment_it = sample(curr_traj[i], sample_time.toSec(),
+                                                                      query_joint_state_, query_cursors_[i]);
+      if (curr_traj[i].end() == segment_it)
+      {
+        ROS_ERROR_STREAM_NAMED(name_, "Requested sample time precedes trajectory start time.");
+        return false;
+      }
 
-    response_point.position[i]     = state.position[0];
-    response_point.velocity[i]     = state.velocity[0];
-    response_point.acceleration[i] = state.acceleration[0];
+      query_state_.position[i]     = query_joint_state_.position[0];
+      query_state_.velocity[i]     = query_joint_state_.velocity[0];
+      query_state_.acceleration[i] = query_joint_state_.acceleration[0];
+    }
   }
 
   // Populate response
   resp.name         = joint_names_;
-  resp.position     = response_point.position;
-  resp.velocity     = response_point.velocity;
-  resp.acceleration = response_point.acceleration;
+  resp.position     = query_state_.position;
+  resp.velocity     = query_state_.velocity;
+  resp.acceleration = query_state_.acceleration;
 
   return true;
 }
 
-template <class SegmentImpl, class HardwareInterface>
-void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+dumpFlightRecorderService(std_srvs::Trigger::Request&  /*req*/,
+                          std_srvs::Trigger::Response& resp)
+{
+  std::string path;
+  resp.success = flight_recorder_.dump("service", path);
+  resp.message = resp.success ? path : "Could not write flight recorder dump '" + path + "'.";
+  return true;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+bool JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+queryStatesService(QueryTrajectoryStates::Request&  req,
+                   QueryTrajectoryStates::Response& resp)
+{
+  // Preconditions
+  if (!this->isRunning())
+  {
+    ROS_ERROR_NAMED(name_, "Can't sample trajectory. Controller is not running.");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(query_mutex_);
+
+  // Convert request times to internal monotonic representation
+  const TimeData time_data = getTimeData();
+  const unsigned int n_joints = joints_.size();
+  const std::size_t n_times = req.times.size();
+  query_times_.resize(n_times);
+  for (std::size_t k = 0; k < n_times; ++k)
+  {
+    query_times_[k] = (time_data.uptime + (req.times[k] - time_data.time)).toSec();
+  }
+
+  resp.name = joint_names_;
+  resp.points.resize(n_times);
+  for (std::size_t k = 0; k < n_times; ++k)
+  {
+    trajectory_msgs::JointTrajectoryPoint& point = resp.points[k];
+    point.positions.resize(n_joints);
+    point.velocities.resize(n_joints);
+    point.accelerations.resize(n_joints);
+    point.effort.clear();
+    point.time_from_start = req.times[k] - req.times.front();
+  }
+
+  // Sample trajectory at requested times
+  TrajectoryPtr curr_traj_ptr = curr_trajectory_box_.get();
+  const Trajectory& curr_traj = *curr_traj_ptr;
+  bool all_found = true;
+
+  if (!curr_traj.packed().empty())
+  {
+    for (std::size_t k = 0; k < n_times; ++k)
+    {
+      all_found = curr_traj.packed().sample(query_times_[k], query_state_, query_packed_cursor_) !=
+                  curr_traj.packed().size() && all_found;
+      std::copy(query_state_.position.begin(),     query_state_.position.end(),     resp.points[k].positions.begin());
+      std::copy(query_state_.velocity.begin(),     query_state_.velocity.end(),     resp.points[k].velocities.begin());
+      std::copy(query_state_.acceleration.begin(), query_state_.acceleration.end(), resp.points[k].accelerations.begin());
+    }
+  }
+  else
+  {
+    // One pass per joint, so that each joint trajectory is walked in order
+    query_joint_states_.resize(n_times, query_joint_state_);
+    for (unsigned int i = 0; i < n_joints; ++i)
+    {
+      all_found = trajectory_interface::sampleTimes(curr_traj[i], query_times_.begin(), query_times_.end(),
+                                                    query_joint_states_.begin(), query_cursors_[i]) && all_found;
+      for (std::size_t k = 0; k < n_times; ++k)
+      {
+        resp.points[k].positions[i]     = query_joint_states_[k].position[0];
+        resp.points[k].velocities[i]    = query_joint_states_[k].velocity[0];
+        resp.points[k].accelerations[i] = query_joint_states_[k].acceleration[0];
+      }
+    }
+  }
+
+  if (!all_found)
+  {
+    ROS_ERROR_STREAM_NAMED(name_, "Requested sample time precedes trajectory start time.");
+    return false;
+  }
+  return true;
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 publishState(const ros::Time& time)
 {
   // Check if it's time to publish
   if (!state_publisher_period_.isZero() && last_state_publish_time_ + state_publisher_period_ < time)
   {
-    if (state_publisher_ && state_publisher_->trylock())
+    if (state_publisher_ && controller_instrumentation::tracedTrylock(*state_publisher_, "state"))
     {
       last_state_publish_time_ += state_publisher_period_;
 
-      state_publisher_->msg_.header.stamp          = time_data_.readFromRT()->time;
+      state_publisher_->msg_.header.stamp          = rt_time_data_.time;
       state_publisher_->msg_.desired.positions     = desired_state_.position;
       state_publisher_->msg_.desired.velocities    = desired_state_.velocity;
       state_publisher_->msg_.desired.accelerations = desired_state_.acceleration;
@@ -745,15 +2110,118 @@ publishState(const ros::Time& time)
   }
 }
 
-template <class SegmentImpl, class HardwareInterface>
-void JointTrajectoryController<SegmentImpl, HardwareInterface>::
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+setActionFeedback(const RealtimeGoalHandlePtr& rt_goal, const TimeData& time_data)
+{
+  // Feedback is sent by the goal handle timer. Refreshing it at twice the timer rate is enough for it to always find a
+  // sample at most half a monitor period old
+  if (time_data.unscaled_uptime < last_action_feedback_time_ + action_feedback_period_) {return;}
+  last_action_feedback_time_ = time_data.unscaled_uptime;
+
+  rt_goal->preallocated_feedback_->header.stamp          = time_data.time;
+  rt_goal->preallocated_feedback_->desired.positions     = desired_state_.position;
+  rt_goal->preallocated_feedback_->desired.velocities    = desired_state_.velocity;
+  rt_goal->preallocated_feedback_->desired.accelerations = desired_state_.acceleration;
+  rt_goal->preallocated_feedback_->actual.positions      = current_state_.position;
+  rt_goal->preallocated_feedback_->actual.velocities     = current_state_.velocity;
+  rt_goal->preallocated_feedback_->error.positions       = state_error_.position;
+  rt_goal->preallocated_feedback_->error.velocities      = state_error_.velocity;
+  rt_goal->setFeedback(rt_goal->preallocated_feedback_);
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+publishStateSummary(const ros::Time& time)
+{
+  if (!state_summary_publisher_) {return;}
+  state_error_summary_.add(state_error_);
+
+  // Check if it's time to publish
+  if (last_state_summary_publish_time_ + state_summary_publisher_period_ < time)
+  {
+    if (controller_instrumentation::tracedTrylock(*state_summary_publisher_, "state_summary"))
+    {
+      last_state_summary_publish_time_ += state_summary_publisher_period_;
+
+      state_error_summary_.write(state_summary_publisher_->msg_.data);
+      state_error_summary_.reset();
+
+      state_summary_publisher_->unlockAndPublish();
+    }
+  }
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+writeTelemetry(const ros::Time& time)
+{
+  // The flight recorder gets a copy of the telemetry ring record, if both are enabled
+  double* const telemetry_data = telemetry_ring_.beginWrite(time.toSec());
+  double* const recorder_data  = flight_recorder_.beginWrite(time.toSec());
+  double* data = telemetry_data ? telemetry_data : recorder_data;
+  if (!data) {return;}
+
+  data = std::copy(desired_state_.position.begin(),     desired_state_.position.end(),     data);
+  data = std::copy(desired_state_.velocity.begin(),     desired_state_.velocity.end(),     data);
+  data = std::copy(desired_state_.acceleration.begin(), desired_state_.acceleration.end(), data);
+  data = std::copy(current_state_.position.begin(),     current_state_.position.end(),     data);
+  data = std::copy(current_state_.velocity.begin(),     current_state_.velocity.end(),     data);
+  data = std::copy(state_error_.position.begin(),       state_error_.position.end(),       data);
+  std::copy(state_error_.velocity.begin(), state_error_.velocity.end(), data);
+  if (telemetry_data && recorder_data)
+  {
+    std::memcpy(recorder_data, telemetry_data, flight_recorder_.recordSize() * sizeof(double));
+  }
+  telemetry_ring_.commit();
+  flight_recorder_.commit();
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+setJointError(std::size_t i)
+{
+  state_joint_error_.position[0]     = state_error_.position[i];
+  state_joint_error_.velocity[0]     = state_error_.velocity[i];
+  state_joint_error_.acceleration[0] = state_error_.acceleration[i];
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+publishLookahead(const Trajectory& curr_traj, const TimeData& time_data)
+{
+  if (!lookahead_publisher_) {return;}
+
+  // Samples of the hold trajectory no longer apply once it is modified in place
+  if (lookahead_reset_.exchange(false)) {lookahead_.reset();}
+
+  // The window is kept up to date even when the message cannot be published, so that it never needs a full refresh
+  const std::size_t n_samples = lookahead_.update(curr_traj, time_data.uptime.toSec());
+  if (n_samples < lookahead_.capacity() ||
+      !controller_instrumentation::tracedTrylock(*lookahead_publisher_, "lookahead")) {return;}
+
+  // Sample times and states are those of the trajectory, ie. they are not speed-scaled
+  trajectory_msgs::JointTrajectory& msg = lookahead_publisher_->msg_;
+  msg.header.stamp = time_data.time;
+  for (std::size_t k = 0; k < n_samples; ++k)
+  {
+    const typename Segment::State& state = lookahead_.state(k);
+    trajectory_msgs::JointTrajectoryPoint& point = msg.points[k];
+    point.time_from_start = ros::Duration(lookahead_.time(k) - time_data.uptime.toSec());
+    std::copy(state.position.begin(),     state.position.end(),     point.positions.begin());
+    std::copy(state.velocity.begin(),     state.velocity.end(),     point.velocities.begin());
+    std::copy(state.acceleration.begin(), state.acceleration.end(), point.accelerations.begin());
+  }
+  lookahead_publisher_->unlockAndPublish();
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+void JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
 setHoldPosition(const ros::Time& time, RealtimeGoalHandlePtr gh)
 {
   assert(joint_names_.size() == hold_trajectory_ptr_->size());
 
-  typename Segment::State hold_start_state_ = typename Segment::State(1);
-  typename Segment::State hold_end_state_ = typename Segment::State(1);
-  const unsigned int n_joints = joints_.size();
+  const unsigned int n_joints = jointCount();
   const typename Segment::Time start_time  = time.toSec();
 
   if(stop_trajectory_duration_ == 0.0)
@@ -772,16 +2240,10 @@ setHoldPosition(const ros::Time& time, RealtimeGoalHandlePtr gh)
   }
   else
   {
-    // Settle position in a fixed time. We do the following:
-    // - Create segment that goes from current (pos,vel) to (pos,-vel) in 2x the desired stop time
-    // - Assuming segment symmetry, sample segment at its midpoint (desired stop time). It should have zero velocity
-    // - Create segment that goes from current state to above zero velocity state, in the desired time
-    // NOTE: The symmetry assumption from the second point above might not hold for all possible segment types
-
-    const typename Segment::Time end_time    = time.toSec() + stop_trajectory_duration_;
-    const typename Segment::Time end_time_2x = time.toSec() + 2.0 * stop_trajectory_duration_;
+    // Settle position in a fixed time: Create segment that goes from current state to the zero velocity state computed
+    // by the stop ramp policy of the segment type, in the desired time. See StopRampTraits
+    const typename Segment::Time end_time = time.toSec() + stop_trajectory_duration_;
 
-    // Create segment that goes from current (pos,vel) to (pos,-vel)
     for (unsigned int i = 0; i < n_joints; ++i)
     {
       // If there is a time delay in the system it is better to calculate the hold trajectory starting from the
@@ -790,25 +2252,33 @@ setHoldPosition(const ros::Time& time, RealtimeGoalHandlePtr gh)
       hold_start_state_.velocity[0]     =  desired_state_.velocity[i];
       hold_start_state_.acceleration[0] =  0.0;
 
-      hold_end_state_.position[0]       =  desired_state_.position[i];
-      hold_end_state_.velocity[0]       = -desired_state_.velocity[i];
-      hold_end_state_.acceleration[0]   =  0.0;
-
-      (*hold_trajectory_ptr_)[i].front().init(start_time,  hold_start_state_,
-                                                               end_time_2x, hold_end_state_);
-
-      // Sample segment at its midpoint, that should have zero velocity
-      (*hold_trajectory_ptr_)[i].front().sample(end_time, hold_end_state_);
-
-      // Now create segment that goes from current state to one with zero end velocity
-      (*hold_trajectory_ptr_)[i].front().init(start_time, hold_start_state_,
-                                                               end_time,   hold_end_state_);
+      Segment& hold_segment = (*hold_trajectory_ptr_)[i].front();
+      StopRampTraits<SegmentImpl>::stopState(hold_start_state_, stop_trajectory_duration_, hold_end_state_,
+                                             hold_segment);
+      hold_segment.init(start_time, hold_start_state_, end_time, hold_end_state_);
 
       // Set goal handle for the segment
-      (*hold_trajectory_ptr_)[i].front().setGoalHandle(gh);
+      hold_segment.setGoalHandle(gh);
     }
   }
-  curr_trajectory_box_.set(hold_trajectory_ptr_);
+  lookahead_reset_ = true;
+  curr_trajectory_box_.setDefault();
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+std::size_t JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+getPendingTrajectoryReleases() const
+{
+  return curr_trajectory_box_.pendingReleases();
+}
+
+template <class SegmentImpl, class HardwareInterface, unsigned int NumJoints>
+typename JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::TimeData
+JointTrajectoryController<SegmentImpl, HardwareInterface, NumJoints>::
+getTimeData()
+{
+  std::lock_guard<std::mutex> lock(time_data_mutex_);
+  return time_data_.read();
 }
 
 } // namespace
@@ -31,6 +31,7 @@
 #define JOINT_TRAJECTORY_CONTROLLER_JOINT_TRAJECTORY_MSG_UTILS_H
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <string>
 #include <vector>
@@ -165,6 +166,66 @@ findPoint(const trajectory_msgs::JointTrajectory& msg,
          : --std::upper_bound(first, last, time, isBeforePoint); // Notice decrement operator
 }
 
+/**
+ * \brief Outcome of a single pass over the points of a trajectory message, see \ref scanPoints.
+ */
+struct PointsScan
+{
+  bool        time_increasing;     ///< True if each point is reached at a later time than its predecessor.
+  std::size_t first_ahead;         ///< Index of the first point with a start time > the scan time.
+  std::size_t first_invalid;       ///< Index of the first point that fails validation.
+  std::size_t first_invalid_ahead; ///< Index of the first point at or after \p first_ahead that fails validation.
+};
+
+/**
+ * \brief Validate the points of a trajectory message and find where they start to occur after \p time, touching each
+ * point once.
+ *
+ * This fuses \ref isTimeStrictlyIncreasing, the validation of all points and \ref findPoint into a single linear pass,
+ * which is cheaper than separate passes for long messages.
+ *
+ * \param msg Trajectory message.
+ * \param time Time to search for, see \ref findPoint.
+ * \param is_valid_point Predicate that validates a point, e.g. its dimensions.
+ *
+ * \return Scan result. Indices are the number of points in \p msg when there is no such point. If the points in \p msg
+ * have monotonically increasing times, \p first_ahead is the index that follows the result of \ref findPoint, or zero
+ * if that result is the end of the points sequence. Otherwise it is not meaningful.
+ */
+template <class PointValidator>
+inline PointsScan scanPoints(const trajectory_msgs::JointTrajectory& msg,
+                             const ros::Time&                        time,
+                             PointValidator                          is_valid_point)
+{
+  const ros::Time msg_start_time = internal::startTime(msg, time);
+  const std::vector<trajectory_msgs::JointTrajectoryPoint>& points = msg.points;
+  const std::size_t n_points = points.size();
+
+  PointsScan scan;
+  scan.time_increasing     = true;
+  scan.first_ahead         = 0;
+  scan.first_invalid       = n_points;
+  scan.first_invalid_ahead = n_points;
+  for (std::size_t k = 0; k < n_points; ++k)
+  {
+    const trajectory_msgs::JointTrajectoryPoint& point = points[k];
+    if (k > 0 && point.time_from_start <= points[k - 1].time_from_start) {scan.time_increasing = false;}
+
+    // Points up to k occur before time. Invalid points found so far are not ahead of it
+    if (!(time < msg_start_time + point.time_from_start))
+    {
+      scan.first_ahead = k + 1;
+      scan.first_invalid_ahead = n_points;
+    }
+    if (!is_valid_point(point))
+    {
+      scan.first_invalid = std::min(scan.first_invalid, k);
+      if (k >= scan.first_ahead) {scan.first_invalid_ahead = std::min(scan.first_invalid_ahead, k);}
+    }
+  }
+  return scan;
+}
+
 } // namespace
 
 #endif // header guard
@@ -36,6 +36,9 @@
 #include <string>
 #include <vector>
 
+// Boost
+#include <boost/shared_ptr.hpp>
+
 // angles
 #include <angles/angles.h>
 
@@ -75,6 +78,7 @@ public:
 
   typedef realtime_tools::RealtimeServerGoalHandle<control_msgs::FollowJointTrajectoryAction> RealtimeGoalHandle;
   typedef boost::shared_ptr<RealtimeGoalHandle>                                               RealtimeGoalHandlePtr;
+  typedef boost::shared_ptr<const SegmentTolerancesPerJoint<Scalar> >                         TolerancesPtr;
 
   struct State : public Segment::State
   {
@@ -197,15 +201,33 @@ public:
   /** \brief Set the (realtime) goal handle associated to this segment. */
   void setGoalHandle(RealtimeGoalHandlePtr rt_goal_handle) {rt_goal_handle_ = rt_goal_handle;}
 
-  /** \return Tolerances this segment is associated to. */
-  const SegmentTolerancesPerJoint<Scalar>& getTolerances() const {return tolerances_;}
+  /** \return Tolerances this segment is associated to. Segments without tolerances return zero (unchecked) ones. */
+  const SegmentTolerancesPerJoint<Scalar>& getTolerances() const
+  {
+    static const SegmentTolerancesPerJoint<Scalar> no_tolerances;
+    return tolerances_ ? *tolerances_ : no_tolerances;
+  }
+
+  /** \return Shared pointer to the tolerances this segment is associated to. Null if it has none. */
+  const TolerancesPtr& getTolerancesPtr() const {return tolerances_;}
+
+  /**
+   * \brief Set the tolerances this segment is associated to.
+   *
+   * Tolerances are shared, not copied, so all the segments of a goal can refer to the same tolerance table entry.
+   * \sa makeSegmentTolerancesTable
+   */
+  void setTolerances(const TolerancesPtr& tolerances) {tolerances_ = tolerances;}
 
-  /** \brief Set the tolerances this segment is associated to. */
-  void setTolerances(const SegmentTolerancesPerJoint<Scalar>& tolerances) {tolerances_ = tolerances;}
+  /** \brief Set the tolerances this segment is associated to. Prefer the shared overload for multiple segments. */
+  void setTolerances(const SegmentTolerancesPerJoint<Scalar>& tolerances)
+  {
+    tolerances_.reset(new SegmentTolerancesPerJoint<Scalar>(tolerances));
+  }
 
 private:
-  RealtimeGoalHandlePtr     rt_goal_handle_;
-  SegmentTolerancesPerJoint<Scalar> tolerances_;
+  RealtimeGoalHandlePtr rt_goal_handle_;
+  TolerancesPtr         tolerances_;
 };
 
 /**
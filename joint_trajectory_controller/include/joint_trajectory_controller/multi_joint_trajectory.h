@@ -0,0 +1,362 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_MULTI_JOINT_TRAJECTORY_H
+#define JOINT_TRAJECTORY_CONTROLLER_MULTI_JOINT_TRAJECTORY_H
+
+// C++ standard
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Boost
+#include <boost/iterator/indirect_iterator.hpp>
+
+// Project
+#include <trajectory_interface/packed_quintic_spline_trajectory.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+#include <joint_trajectory_controller/joint_trajectory_segment.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Packed trajectory placeholder for segment types without a packed representation.
+ *
+ * Packing always fails, so users fall back to sampling per-joint trajectories.
+ */
+template <class State>
+class NullPackedTrajectory
+{
+public:
+  typedef typename State::Scalar Time;
+  typedef std::size_t            size_type;
+
+  template <class Trajectory>
+  bool init(const Trajectory& /*trajectory*/) {return false;}
+  void clear() {}
+  bool empty() const {return true;}
+  size_type size() const {return 0;}
+  size_type sample(const Time& /*time*/, State& /*state*/, size_type& /*cursor*/) const {return 0;}
+};
+
+/**
+ * \brief Trajectory packing policy: Maps a segment type to its packed multi-joint trajectory representation.
+ *
+ * Segment types are not packed by default. Specialize this class to provide a packed representation.
+ */
+template <class SegmentImpl>
+struct PackedTrajectoryTraits
+{
+  typedef NullPackedTrajectory<typename SegmentImpl::State> Type;
+};
+
+template <class Scalar>
+struct PackedTrajectoryTraits<trajectory_interface::QuinticSplineSegment<Scalar> >
+{
+  typedef trajectory_interface::PackedQuinticSplineTrajectory<Scalar> Type;
+};
+
+/**
+ * \brief Multi-joint trajectory: a sequence of per-joint trajectories, optionally complemented by a packed copy.
+ *
+ * Per-joint trajectories can have different segment boundaries, e.g. when a partial-joint goal is merged with the
+ * currently executed trajectory. When all joints share segment boundaries, \ref pack builds a structure-of-arrays copy
+ * of the trajectory (see \ref PackedTrajectoryTraits), which allows sampling all joints in a single pass.
+ *
+ * Per-joint trajectories are held by pointer, and can be shared with other multi-joint trajectories (see \ref share),
+ * so that a trajectory built from a partial-joint goal only copies the joints the goal names. Shared per-joint
+ * trajectories are copied on write: non-const access to a joint gives it its own copy first. Likewise, associating
+ * the segments of a shared joint to an action goal (see \ref setGoalHandle) is recorded in the multi-joint trajectory,
+ * and readers that care about the goal of a segment must query \ref goalHandle instead of the segment itself.
+ *
+ * \note The packed copy is not updated when per-joint data is modified. Call \ref pack again, or \ref unpack, after
+ * modifying a packed trajectory.
+ *
+ * \tparam SegmentImpl Trajectory segment representation, see \ref JointTrajectoryController.
+ */
+template <class SegmentImpl>
+class MultiJointTrajectory
+{
+public:
+  typedef JointTrajectorySegment<SegmentImpl>                 Segment;
+  typedef std::vector<Segment>                                value_type;
+  typedef std::shared_ptr<value_type>                         value_ptr;
+  typedef std::size_t                                         size_type;
+  typedef typename PackedTrajectoryTraits<SegmentImpl>::Type  Packed;
+  typedef typename Segment::RealtimeGoalHandlePtr             RealtimeGoalHandlePtr;
+  typedef boost::indirect_iterator<typename std::vector<value_ptr>::const_iterator, const value_type> const_iterator;
+
+  MultiJointTrajectory() : size_(0), shareable_(true) {}
+
+  MultiJointTrajectory(const MultiJointTrajectory& other) : size_(0), shareable_(true) {*this = other;}
+
+  /** \brief Copy assignment. Per-joint trajectories are shared with \p other, unless it is not shareable. */
+  MultiJointTrajectory& operator=(const MultiJointTrajectory& other)
+  {
+    if (this == &other) {return *this;}
+    resize(other.size_);
+    for (size_type i = 0; i < size_; ++i) {share(i, other);}
+    packed_        = other.packed_;
+    blended_goals_ = other.blended_goals_;
+    return *this;
+  }
+
+  /** \name Sequence of per-joint trajectories
+   * Read access never copies. Non-const access to a joint gives it its own copy of its segments if they are shared.
+   * \{
+   */
+  size_type size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+
+  const_iterator begin() const {return const_iterator(joints_.begin());}
+  const_iterator end() const {return const_iterator(joints_.begin() + size_);}
+
+  const value_type& front() const {return *joints_.front();}
+  const value_type& back() const {return *joints_[size_ - 1];}
+
+  const value_type& operator[](size_type i) const {return *joints_[i];}
+  value_type& operator[](size_type i)
+  {
+    value_ptr& joint_traj = joints_[i];
+    if (joint_traj.use_count() > 1) {joint_traj = std::make_shared<value_type>(*joint_traj);}
+    applyGoalOverride(i);
+    return *joint_traj;
+  }
+
+  /**
+   * \brief Resize the trajectory. Added joints are empty.
+   *
+   * Storage of the per-joint trajectories that are not shared is kept for later reuse.
+   * \note This method is \b not real-time safe.
+   */
+  void resize(size_type n)
+  {
+    for (size_type i = n; i < size_; ++i) {recycle(i);}
+    if (n > joints_.size())
+    {
+      joints_.resize(n);
+      goal_overrides_.resize(n);
+    }
+    for (size_type i = size_; i < n; ++i)
+    {
+      if (!joints_[i]) {joints_[i] = std::make_shared<value_type>();}
+    }
+    size_ = n;
+  }
+
+  /** \brief Remove all joints, keeping the storage of per-joint trajectories that are not shared. */
+  void clear() {resize(0);}
+
+  /** \brief Append a joint trajectory, which is copied. */
+  void push_back(const value_type& joint_traj)
+  {
+    resize(size_ + 1);
+    *joints_[size_ - 1] = joint_traj;
+  }
+  /** \} */
+
+  /**
+   * \brief Remove the segments of all joints, keeping the storage of per-joint trajectories that are not shared.
+   * \note This method is \b not real-time safe.
+   */
+  void clearSegments()
+  {
+    for (size_type i = 0; i < size_; ++i)
+    {
+      recycle(i);
+      if (!joints_[i]) {joints_[i] = std::make_shared<value_type>();}
+    }
+  }
+
+  /**
+   * \brief Make joint \p i follow the segments of joint \p i of \p other, without copying them.
+   *
+   * Segments are copied instead if \p other is not shareable. Goal handles set with \ref setGoalHandle on \p other
+   * carry over.
+   * \note This method is \b not real-time safe.
+   */
+  void share(size_type i, const MultiJointTrajectory& other)
+  {
+    if (other.shareable_)
+    {
+      joints_[i]         = other.joints_[i];
+      goal_overrides_[i] = other.goal_overrides_[i];
+    }
+    else
+    {
+      recycle(i);
+      if (!joints_[i]) {joints_[i] = std::make_shared<value_type>();}
+      *joints_[i] = *other.joints_[i];
+    }
+  }
+
+  /**
+   * \brief Set whether per-joint trajectories can be shared with other trajectories.
+   *
+   * Trajectories whose segments are modified in place while they are executed, like the hold trajectory of the
+   * controller, must not be shared: Copying on write would allocate memory, and would hide changes from the copies.
+   */
+  void setShareable(bool shareable) {shareable_ = shareable;}
+  bool isShareable() const {return shareable_;}
+
+  /**
+   * \brief Associate the segments of joint \p i from index \p first_segment on to an action goal.
+   *
+   * If the segments are shared, they are not modified. The goal is recorded instead, and it is reported by
+   * \ref goalHandle.
+   * \note This method is \b not real-time safe.
+   */
+  void setGoalHandle(size_type i, size_type first_segment, const RealtimeGoalHandlePtr& rt_goal_handle)
+  {
+    GoalOverride& goal_override = goal_overrides_[i];
+    const bool overridden = goal_override.first_segment != GoalOverride::NONE;
+    if (joints_[i].use_count() > 1 && (!overridden || goal_override.first_segment >= first_segment))
+    {
+      goal_override.first_segment = first_segment;
+      goal_override.goal          = rt_goal_handle;
+      return;
+    }
+    value_type& joint_traj = (*this)[i];
+    for (size_type k = first_segment; k < joint_traj.size(); ++k) {joint_traj[k].setGoalHandle(rt_goal_handle);}
+  }
+
+  /**
+   * \return Action goal that segment \p segment_it of joint \p i is associated to.
+   * \note This method is real-time safe.
+   */
+  RealtimeGoalHandlePtr goalHandle(size_type i, typename value_type::const_iterator segment_it) const
+  {
+    const GoalOverride& goal_override = goal_overrides_[i];
+    if (goal_override.first_segment != GoalOverride::NONE &&
+        static_cast<size_type>(segment_it - joints_[i]->begin()) >= goal_override.first_segment)
+    {
+      return goal_override.goal;
+    }
+    return segment_it->getGoalHandle();
+  }
+
+  /**
+   * \brief Build the packed copy of the trajectory.
+   * \return True if all joints share segment boundaries and a packed representation exists for \p SegmentImpl.
+   * \note This method is \b not real-time safe.
+   */
+  bool pack() {return packed_.init(*this);}
+
+  /** \brief Discard the packed copy of the trajectory. */
+  void unpack() {packed_.clear();}
+
+  /** \return Packed copy of the trajectory. Empty if the trajectory is not packed. */
+  const Packed& packed() const {return packed_;}
+
+  /**
+   * \return Action goals queued behind the goal being executed, in execution order. Their segments follow those of the
+   * goal they are blended into, and each of them becomes the active goal once its segments are reached.
+   */
+  const std::vector<RealtimeGoalHandlePtr>& blendedGoals() const {return blended_goals_;}
+  std::vector<RealtimeGoalHandlePtr>&       blendedGoals()       {return blended_goals_;}
+
+private:
+  /** Goal of the segments of a shared joint trajectory from a given index on. */
+  struct GoalOverride
+  {
+    static const size_type NONE = static_cast<size_type>(-1);
+
+    GoalOverride() : first_segment(NONE) {}
+
+    size_type             first_segment;
+    RealtimeGoalHandlePtr goal;
+  };
+
+  /** Write the recorded goal of a joint to its segments, which must not be shared. */
+  void applyGoalOverride(size_type i)
+  {
+    GoalOverride& goal_override = goal_overrides_[i];
+    if (goal_override.first_segment == GoalOverride::NONE) {return;}
+    value_type& joint_traj = *joints_[i];
+    for (size_type k = goal_override.first_segment; k < joint_traj.size(); ++k)
+    {
+      joint_traj[k].setGoalHandle(goal_override.goal);
+    }
+    goal_override = GoalOverride();
+  }
+
+  /** Empty joint \p i, keeping its storage if it is not shared, or dropping it otherwise. */
+  void recycle(size_type i)
+  {
+    goal_overrides_[i] = GoalOverride();
+    if (joints_[i].use_count() == 1) {joints_[i]->clear();}
+    else                             {joints_[i].reset();}
+  }
+
+  std::vector<value_ptr>             joints_; ///< Per-joint trajectories. Only the first size_ are in use.
+  std::vector<GoalOverride>          goal_overrides_;
+  size_type                          size_;
+  bool                               shareable_;
+  Packed                             packed_;
+  std::vector<RealtimeGoalHandlePtr> blended_goals_;
+};
+
+/**
+ * \name Per-joint trajectory sharing
+ * Overloads of the helpers in \ref init_joint_trajectory.h and \ref trajectory_pool.h that share segments instead of
+ * copying them.
+ * \{
+ */
+template <class SegmentImpl>
+void shareJointTrajectory(const MultiJointTrajectory<SegmentImpl>& source,
+                          unsigned int                             joint_id,
+                          MultiJointTrajectory<SegmentImpl>&       result)
+{
+  result.share(joint_id, source);
+}
+
+template <class SegmentImpl>
+void setJointGoalHandle(MultiJointTrajectory<SegmentImpl>&                                   trajectory,
+                        unsigned int                                                         joint_id,
+                        std::size_t                                                          first_segment,
+                        const typename MultiJointTrajectory<SegmentImpl>::RealtimeGoalHandlePtr& rt_goal_handle)
+{
+  trajectory.setGoalHandle(joint_id, first_segment, rt_goal_handle);
+}
+
+template <class SegmentImpl>
+typename MultiJointTrajectory<SegmentImpl>::RealtimeGoalHandlePtr
+jointGoalHandle(const MultiJointTrajectory<SegmentImpl>&                                    trajectory,
+                unsigned int                                                                joint_id,
+                typename MultiJointTrajectory<SegmentImpl>::value_type::const_iterator      segment_it)
+{
+  return trajectory.goalHandle(joint_id, segment_it);
+}
+
+template <class SegmentImpl>
+void clearSegments(MultiJointTrajectory<SegmentImpl>& trajectory) {trajectory.clearSegments();}
+/** \} */
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_PARALLEL_UPDATE_H
+#define JOINT_TRAJECTORY_CONTROLLER_PARALLEL_UPDATE_H
+
+// C++ standard
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// POSIX
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Fork-join execution of the update cycle of a controller over a fixed number of groups.
+ *
+ * Group zero is processed by the calling (realtime) thread, and each other group by its own helper thread, started
+ * once by \ref start. Helpers busy-wait for work, so that a cycle is handed over without system calls, and should be
+ * pinned to cores reserved for the control loop. Unlike \ref WorkerPool, no memory is allocated and no lock is taken
+ * once the helpers are started.
+ *
+ * Busy-waiting keeps each helper's core fully loaded, even between cycles. While no cycle is expected, e.g. while the
+ * controller is stopped, \ref park puts the helpers to sleep on a futex until \ref unpark.
+ */
+class ParallelUpdate
+{
+public:
+  ParallelUpdate() : stop_(false), parked_(0), generation_(0), done_(0), context_(0), call_(0) {}
+
+  ParallelUpdate(const ParallelUpdate&) = delete;
+  ParallelUpdate& operator=(const ParallelUpdate&) = delete;
+
+  ~ParallelUpdate() {stopThreads();}
+
+  /**
+   * \brief Start the helper threads of \p groups groups, replacing those of a previous call.
+   * \param groups Number of groups, including the one processed by the calling thread. Values smaller than one are
+   * clamped to one, in which case no thread is started.
+   * \param cpus CPU each helper thread is pinned to, in group order. Helpers without an entry keep the affinity
+   * inherited from the calling thread.
+   * \param priority \p SCHED_FIFO priority of the helper threads. Zero keeps the scheduling policy inherited from the
+   * calling thread.
+   * \return False if the affinity or priority of a helper could not be set. Helpers are started regardless.
+   * \note This method is \b not real-time safe.
+   */
+  bool start(std::size_t groups, const std::vector<int>& cpus, int priority)
+  {
+    stopThreads();
+    stop_ = false;
+    if (groups < 1) {groups = 1;}
+
+    bool placed = true;
+    threads_.reserve(groups - 1);
+    for (std::size_t group = 1; group < groups; ++group)
+    {
+      threads_.emplace_back(&ParallelUpdate::work, this, group, generation_.load());
+      const pthread_t handle = threads_.back().native_handle();
+
+      if (group - 1 < cpus.size())
+      {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpus[group - 1], &cpu_set);
+        placed = pthread_setaffinity_np(handle, sizeof(cpu_set), &cpu_set) == 0 && placed;
+      }
+      if (priority > 0)
+      {
+        sched_param param;
+        param.sched_priority = priority;
+        placed = pthread_setschedparam(handle, SCHED_FIFO, &param) == 0 && placed;
+      }
+    }
+    return placed;
+  }
+
+  /**
+   * \brief Put the helpers to sleep once they are done with the current cycle, instead of busy-waiting for the next.
+   * \note This method is realtime-safe.
+   */
+  void park() {parked_.store(1, std::memory_order_relaxed);}
+
+  /**
+   * \brief Wake the helpers put to sleep by \ref park, so that they busy-wait for work again.
+   * \note This method is realtime-safe: it makes a single non-blocking system call.
+   */
+  void unpark()
+  {
+    parked_.store(0, std::memory_order_release);
+    syscall(SYS_futex, futexWord(), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+  }
+
+  /**
+   * \brief Call <tt>function(group)</tt> for every group, and wait for all calls to complete.
+   *
+   * Calls for different groups run concurrently, so \p function must only write data specific to its group, and must
+   * not throw. Parked helpers are woken first.
+   * \note This method is realtime-safe if \p function is.
+   */
+  template <class Function>
+  void run(const Function& function)
+  {
+    if (threads_.empty())
+    {
+      function(std::size_t(0));
+      return;
+    }
+    if (parked_.load(std::memory_order_relaxed)) {unpark();}
+
+    context_ = &function;
+    call_    = &invoke<Function>;
+    done_.store(0, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release); // Publishes the work to the helpers
+
+    function(std::size_t(0));
+    while (done_.load(std::memory_order_acquire) != threads_.size()) {std::this_thread::yield();}
+  }
+
+  /** \return Number of groups, including the one processed by the calling thread. */
+  std::size_t groups() const {return threads_.size() + 1;}
+
+  /**
+   * \return Index of the first of \p size items processed by group \p group, when items are split into contiguous
+   * ranges of (almost) even size. The range of a group ends where the one of group <tt>group + 1</tt> begins.
+   */
+  std::size_t begin(std::size_t size, std::size_t group) const {return size * group / groups();}
+
+private:
+  std::atomic<bool>          stop_;       ///< Request helper thread termination.
+  std::atomic<int>           parked_;     ///< Futex word, non-zero while helpers must sleep instead of busy-waiting.
+  std::atomic<std::uint64_t> generation_; ///< Incremented for each cycle handed over to the helpers.
+  std::atomic<std::size_t>   done_;       ///< Number of helpers that completed the current cycle.
+  const void*                context_;    ///< Function of the current cycle. Published by \p generation_.
+  void                     (*call_)(const void*, std::size_t);
+  std::vector<std::thread>   threads_;    ///< Helper thread of each group but the first.
+
+  template <class Function>
+  static void invoke(const void* context, std::size_t group) {(*static_cast<const Function*>(context))(group);}
+
+  void work(std::size_t group, std::uint64_t generation)
+  {
+    while (true)
+    {
+      // Wait for the next cycle
+      std::uint64_t next;
+      while ((next = generation_.load(std::memory_order_acquire)) == generation)
+      {
+        if (stop_.load(std::memory_order_relaxed)) {return;}
+        if (parked_.load(std::memory_order_acquire))
+        {
+          // Returns at once if unparked in the meantime
+          syscall(SYS_futex, futexWord(), FUTEX_WAIT_PRIVATE, 1, nullptr, nullptr, 0);
+          continue;
+        }
+        std::this_thread::yield();
+      }
+      generation = next;
+
+      call_(context_, group);
+      done_.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  int* futexWord()
+  {
+    static_assert(sizeof(std::atomic<int>) == sizeof(int), "The futex word must be a plain int");
+    return reinterpret_cast<int*>(&parked_);
+  }
+
+  void stopThreads()
+  {
+    stop_ = true;
+    unpark();
+    for (std::thread& thread : threads_) {thread.join();}
+    threads_.clear();
+  }
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,347 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_PARAMETER_SERVER_H
+#define JOINT_TRAJECTORY_CONTROLLER_PARAMETER_SERVER_H
+
+// C++ standard
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ROS
+#include <ros/node_handle.h>
+
+// ROS messages
+#include <dynamic_reconfigure/Config.h>
+#include <dynamic_reconfigure/ConfigDescription.h>
+#include <dynamic_reconfigure/Reconfigure.h>
+
+namespace joint_trajectory_controller
+{
+
+class ParameterServer;
+
+/** \brief Double or boolean parameter of a \ref ParameterGroup. */
+struct ParameterDescription
+{
+  std::string name;        ///< Name in the dynamic_reconfigure interface, unique within the server.
+  std::string param;       ///< ROS parameter, relative to the server namespace, updated along with the value.
+  std::string description;
+  double      min;         ///< Updates are clamped to <tt>[min, max]</tt>.
+  double      max;
+  bool        is_bool;     ///< Booleans are passed as 0.0 or 1.0.
+};
+
+/**
+ * \brief Group of parameters served by the \ref ParameterServer of a namespace, and applied together.
+ *
+ * The group is registered by init(), and unregistered by shutdown() or on destruction.
+ */
+class ParameterGroup
+{
+public:
+  /// Called with the values of all parameters of the group, in order, when any of them is updated.
+  typedef std::function<void(const std::vector<double>&)> Callback;
+
+  ParameterGroup() {}
+  ~ParameterGroup() {shutdown();}
+
+  ParameterGroup(const ParameterGroup&) = delete;
+  ParameterGroup& operator=(const ParameterGroup&) = delete;
+
+  /**
+   * \brief Serve \p parameters in the namespace of \p nh.
+   * \param values Current values of \p parameters, also reported as their defaults.
+   * \param callback Applies updated values. Calls are serialized, and never made by this method.
+   * \note This method is \b not real-time safe.
+   */
+  void init(const ros::NodeHandle&                   nh,
+            const std::string&                       name,
+            const std::vector<ParameterDescription>& parameters,
+            const std::vector<double>&               values,
+            const Callback&                          callback);
+
+  /**
+   * \brief Stop serving the parameters. Once this returns, the callback is no longer called.
+   * \note This method is \b not real-time safe.
+   */
+  void shutdown();
+
+private:
+  friend class ParameterServer;
+
+  std::shared_ptr<ParameterServer>  server_;
+  std::string                       name_;
+  std::vector<ParameterDescription> parameters_;
+  std::vector<double>               defaults_;
+  std::vector<double>               values_;   ///< Guarded by the server mutex.
+  Callback                          callback_;
+};
+
+/**
+ * \brief dynamic_reconfigure server of the parameter groups of a namespace.
+ *
+ * Unlike \p dynamic_reconfigure::Server, parameters are not generated from a configuration file, so that their number
+ * can depend on the controlled joints. A single server, i.e. a single \p set_parameters service and pair of
+ * \p parameter_descriptions and \p parameter_updates topics, serves all groups of a namespace. It implements the
+ * dynamic_reconfigure protocol, so existing clients such as \p rqt_reconfigure can update the parameters.
+ *
+ * There is one server per namespace, shared by its groups, see \ref get.
+ */
+class ParameterServer
+{
+public:
+  /**
+   * \return The server of the namespace of \p nh, created if it does not exist. It is destroyed along with the last
+   * reference.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  static std::shared_ptr<ParameterServer> get(const ros::NodeHandle& nh)
+  {
+    static std::mutex instances_mutex;
+    static std::map<std::string, std::weak_ptr<ParameterServer> > instances;
+
+    std::lock_guard<std::mutex> lock(instances_mutex);
+    std::weak_ptr<ParameterServer>& instance = instances[nh.getNamespace()];
+    std::shared_ptr<ParameterServer> server = instance.lock();
+    if (!server)
+    {
+      server.reset(new ParameterServer(nh));
+      instance = server;
+    }
+    return server;
+  }
+
+  ~ParameterServer() {service_.shutdown();}
+
+  /** \return Number of registered groups. */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return groups_.size();
+  }
+
+  /**
+   * \brief Apply the parameter updates of \p request, as if received by the \p set_parameters service.
+   * \return The values of all parameters after the update.
+   * \note This method is thread-safe, but \b not real-time safe.
+   */
+  dynamic_reconfigure::Config update(const dynamic_reconfigure::Config& request)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (ParameterGroup* group : groups_)
+    {
+      bool changed = false;
+      for (std::size_t i = 0; i < group->parameters_.size(); ++i)
+      {
+        const ParameterDescription& parameter = group->parameters_[i];
+        double value;
+        if (!findValue(request, parameter, value)) {continue;}
+        value = std::min(std::max(value, parameter.min), parameter.max);
+        if (value == group->values_[i]) {continue;}
+
+        group->values_[i] = value;
+        if (parameter.is_bool) {nh_.setParam(parameter.param, value != 0.0);}
+        else                   {nh_.setParam(parameter.param, value);}
+        changed = true;
+      }
+      if (changed) {group->callback_(group->values_);}
+    }
+
+    const dynamic_reconfigure::Config config = makeConfig(VALUES);
+    updates_pub_.publish(config);
+    return config;
+  }
+
+private:
+  enum ConfigValues {VALUES, DEFAULTS, MINIMA, MAXIMA};
+
+  ros::NodeHandle     nh_;
+  ros::Publisher      descriptions_pub_;
+  ros::Publisher      updates_pub_;
+  ros::ServiceServer  service_;
+
+  mutable std::mutex           mutex_;  ///< Guards groups_ and their values, held while updating them.
+  std::vector<ParameterGroup*> groups_;
+
+  explicit ParameterServer(const ros::NodeHandle& nh)
+    : nh_(nh)
+  {
+    descriptions_pub_ = nh_.advertise<dynamic_reconfigure::ConfigDescription>("parameter_descriptions", 1, true);
+    updates_pub_      = nh_.advertise<dynamic_reconfigure::Config>("parameter_updates", 1, true);
+    service_          = nh_.advertiseService("set_parameters", &ParameterServer::setParametersCB, this);
+  }
+
+  friend class ParameterGroup;
+
+  void add(ParameterGroup* group)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    groups_.push_back(group);
+    publishAll();
+  }
+
+  void remove(ParameterGroup* group)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    groups_.erase(std::remove(groups_.begin(), groups_.end(), group), groups_.end());
+    publishAll();
+  }
+
+  bool setParametersCB(dynamic_reconfigure::Reconfigure::Request& request,
+                       dynamic_reconfigure::Reconfigure::Response& response)
+  {
+    response.config = update(request.config);
+    return true;
+  }
+
+  static bool findValue(const dynamic_reconfigure::Config& config, const ParameterDescription& parameter, double& value)
+  {
+    if (parameter.is_bool)
+    {
+      for (const dynamic_reconfigure::BoolParameter& entry : config.bools)
+      {
+        if (entry.name == parameter.name) {value = entry.value ? 1.0 : 0.0; return true;}
+      }
+      return false;
+    }
+    for (const dynamic_reconfigure::DoubleParameter& entry : config.doubles)
+    {
+      if (entry.name == parameter.name) {value = entry.value; return true;}
+    }
+    return false;
+  }
+
+  /** \pre \p mutex_ is locked. */
+  dynamic_reconfigure::Config makeConfig(ConfigValues which) const
+  {
+    dynamic_reconfigure::Config config;
+    config.groups.push_back(makeGroupState("Default", 0));
+    for (std::size_t g = 0; g < groups_.size(); ++g)
+    {
+      const ParameterGroup& group = *groups_[g];
+      config.groups.push_back(makeGroupState(group.name_, static_cast<int>(g) + 1));
+      for (std::size_t i = 0; i < group.parameters_.size(); ++i)
+      {
+        const ParameterDescription& parameter = group.parameters_[i];
+        const double value = which == VALUES   ? group.values_[i] :
+                             which == DEFAULTS ? group.defaults_[i] :
+                             which == MINIMA   ? parameter.min : parameter.max;
+        if (parameter.is_bool)
+        {
+          dynamic_reconfigure::BoolParameter entry;
+          entry.name  = parameter.name;
+          entry.value = value != 0.0;
+          config.bools.push_back(entry);
+        }
+        else
+        {
+          dynamic_reconfigure::DoubleParameter entry;
+          entry.name  = parameter.name;
+          entry.value = value;
+          config.doubles.push_back(entry);
+        }
+      }
+    }
+    return config;
+  }
+
+  static dynamic_reconfigure::GroupState makeGroupState(const std::string& name, int id)
+  {
+    dynamic_reconfigure::GroupState state;
+    state.name   = name;
+    state.state  = true;
+    state.id     = id;
+    state.parent = 0;
+    return state;
+  }
+
+  /** \pre \p mutex_ is locked. */
+  void publishAll() const
+  {
+    dynamic_reconfigure::ConfigDescription description;
+    dynamic_reconfigure::Group root;
+    root.name   = "Default";
+    root.id     = 0;
+    root.parent = 0;
+    description.groups.push_back(root);
+    for (std::size_t g = 0; g < groups_.size(); ++g)
+    {
+      dynamic_reconfigure::Group group;
+      group.name   = groups_[g]->name_;
+      group.id     = static_cast<int>(g) + 1;
+      group.parent = 0;
+      for (const ParameterDescription& parameter : groups_[g]->parameters_)
+      {
+        dynamic_reconfigure::ParamDescription entry;
+        entry.name        = parameter.name;
+        entry.type        = parameter.is_bool ? "bool" : "double";
+        entry.level       = 0;
+        entry.description = parameter.description;
+        group.parameters.push_back(entry);
+      }
+      description.groups.push_back(group);
+    }
+    description.dflt = makeConfig(DEFAULTS);
+    description.min  = makeConfig(MINIMA);
+    description.max  = makeConfig(MAXIMA);
+    descriptions_pub_.publish(description);
+    updates_pub_.publish(makeConfig(VALUES));
+  }
+};
+
+inline void ParameterGroup::init(const ros::NodeHandle&                   nh,
+                                 const std::string&                       name,
+                                 const std::vector<ParameterDescription>& parameters,
+                                 const std::vector<double>&               values,
+                                 const Callback&                          callback)
+{
+  shutdown();
+  name_       = name;
+  parameters_ = parameters;
+  defaults_   = values;
+  values_     = values;
+  callback_   = callback;
+  server_     = ParameterServer::get(nh);
+  server_->add(this);
+}
+
+inline void ParameterGroup::shutdown()
+{
+  if (!server_) {return;}
+  server_->remove(this);
+  server_.reset();
+}
+
+} // namespace
+
+#endif // header guard
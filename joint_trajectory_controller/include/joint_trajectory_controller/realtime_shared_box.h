@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_REALTIME_SHARED_BOX_H
+#define JOINT_TRAJECTORY_CONTROLLER_REALTIME_SHARED_BOX_H
+
+// C++ standard
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <joint_trajectory_controller/deferred_deleter.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Container of a shared pointer that can be read from a real-time thread without locking.
+ *
+ * Non real-time threads publish new values with \ref set. The real-time thread fetches the latest value with
+ * \ref getFromRT, which returns a raw pointer and neither locks nor modifies reference counts. Ownership of published
+ * values is retained by the box until the real-time thread has moved on to a newer value. Released values are then
+ * destroyed by a background thread, so neither the real-time thread nor the publishing thread pay for it.
+ *
+ * Additionally, a \e default value that stays alive for the whole lifetime of the box can be specified. It can be
+ * published from any thread, including the real-time one, with \ref setDefault.
+ *
+ * \tparam T Pointed-to data type.
+ */
+template <class T>
+class RealtimeSharedBox
+{
+public:
+  typedef std::shared_ptr<T> Ptr;
+
+  RealtimeSharedBox()
+    : published_(nullptr),
+      rt_hazard_(nullptr)
+  {}
+
+  RealtimeSharedBox(const RealtimeSharedBox&) = delete;
+  RealtimeSharedBox& operator=(const RealtimeSharedBox&) = delete;
+
+  /**
+   * \brief Publish \p ptr. Previously published values the real-time thread no longer uses are released.
+   * \note This method is \b not real-time safe.
+   */
+  void set(const Ptr& ptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ptr != default_ && std::find(retained_.begin(), retained_.end(), ptr) == retained_.end())
+    {
+      retained_.push_back(ptr);
+    }
+    published_.store(ptr.get());
+    release();
+  }
+
+  /**
+   * \brief Publish \p ptr only if \p expected is still the latest published value.
+   *
+   * Unlike a \ref get followed by a \ref set, the value can't have been replaced in between, e.g. by the real-time
+   * thread publishing the default value.
+   * \return True if \p ptr was published.
+   * \note This method is \b not real-time safe.
+   */
+  bool compareAndSet(const Ptr& expected, const Ptr& ptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    T* published = expected.get();
+    if (!published_.compare_exchange_strong(published, ptr.get())) {return false;}
+    if (ptr != default_ && std::find(retained_.begin(), retained_.end(), ptr) == retained_.end())
+    {
+      retained_.push_back(ptr);
+    }
+    release();
+    return true;
+  }
+
+  /**
+   * \brief Specify the default value.
+   * \note This method is \b not real-time safe, and should be called before the default value is first published.
+   */
+  void initDefault(const Ptr& ptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_ = ptr;
+  }
+
+  /**
+   * \brief Publish the default value.
+   * \pre \ref initDefault has been called.
+   * \note This method is realtime-safe.
+   */
+  void setDefault()
+  {
+    published_.store(default_.get());
+  }
+
+  /**
+   * \return Latest published value.
+   * \note This method is \b not real-time safe.
+   */
+  Ptr get() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const T* ptr = published_.load();
+    if (ptr == default_.get()) {return default_;}
+
+    typename std::vector<Ptr>::const_iterator it = std::find_if(retained_.begin(), retained_.end(),
+                                                                [ptr](const Ptr& p) {return p.get() == ptr;});
+    return (it != retained_.end()) ? *it : Ptr();
+  }
+
+  /**
+   * \return Latest published value. The pointed-to data remains valid until the next call to this method.
+   * \note This method is realtime-safe, and must only be called from a single (real-time) thread.
+   */
+  T* getFromRT()
+  {
+    // Announce which value is about to be used, and check that it was not replaced in the meantime. Writers never
+    // release an announced value.
+    T* ptr = published_.load();
+    T* announced;
+    do
+    {
+      announced = ptr;
+      rt_hazard_.store(announced);
+      ptr = published_.load();
+    } while (ptr != announced);
+    return ptr;
+  }
+
+  /**
+   * \return Number of released values still waiting to be destroyed.
+   * \note This method is realtime-safe.
+   */
+  std::size_t pendingReleases() const {return deleter_.pending();}
+
+private:
+  mutable std::mutex mutex_;     ///< Serializes non real-time accesses.
+  std::vector<Ptr>   retained_;  ///< Published values that might still be in use.
+  Ptr                default_;
+  std::atomic<T*>    published_;
+  std::atomic<T*>    rt_hazard_; ///< Value currently used by the real-time thread.
+  DeferredDeleter<T> deleter_;   ///< Destroys released values. Declared last so it is destroyed first.
+
+  /** Release retained values that are neither published nor in use. */
+  void release()
+  {
+    const T* published = published_.load();
+    const T* hazard    = rt_hazard_.load();
+    typename std::vector<Ptr>::iterator it = std::partition(retained_.begin(), retained_.end(),
+                                                            [published, hazard](const Ptr& p)
+                                                            {return p.get() == published || p.get() == hazard;});
+    for (typename std::vector<Ptr>::iterator released = it; released != retained_.end(); ++released)
+    {
+      deleter_.retire(std::move(*released));
+    }
+    retained_.erase(it, retained_.end());
+  }
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_REALTIME_TRIPLE_BUFFER_H
+#define JOINT_TRAJECTORY_CONTROLLER_REALTIME_TRIPLE_BUFFER_H
+
+// C++ standard
+#include <array>
+#include <atomic>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Wait-free single-writer, single-reader buffer.
+ *
+ * Three copies of the data are kept: one owned by the writer, one owned by the reader and one in the middle, which is
+ * exchanged atomically with the writer's copy on \ref write, and with the reader's copy on \ref read. Neither side
+ * ever blocks the other, so this class can be used to hand data over from a real-time thread to a non real-time one or
+ * vice versa.
+ *
+ * \note At most one thread may write and one thread may read at any time. Callers with several writer (or reader)
+ * threads must serialize them by other means.
+ *
+ * \tparam T Data type. Must be default-constructible and copy-assignable.
+ */
+template <class T>
+class RealtimeTripleBuffer
+{
+public:
+  RealtimeTripleBuffer()
+    : buffers_(),
+      middle_(1),
+      write_index_(0),
+      read_index_(2)
+  {}
+
+  /** \brief Initialize all copies of the data to \p data. */
+  explicit RealtimeTripleBuffer(const T& data)
+    : middle_(1),
+      write_index_(0),
+      read_index_(2)
+  {
+    buffers_.fill(data);
+  }
+
+  RealtimeTripleBuffer(const RealtimeTripleBuffer&) = delete;
+  RealtimeTripleBuffer& operator=(const RealtimeTripleBuffer&) = delete;
+
+  /**
+   * \brief Set all copies of the data to \p data, discarding unread writes.
+   *
+   * Useful to preallocate the storage of all copies, so that later writes of data of the same size don't allocate.
+   * \note This method is \b not thread-safe. Neither the writer nor the reader may access the buffer concurrently.
+   */
+  void reset(const T& data)
+  {
+    buffers_.fill(data);
+    middle_.store(1, std::memory_order_release);
+    write_index_ = 0;
+    read_index_  = 2;
+  }
+
+  /**
+   * \brief Make \p data available to the reader.
+   * \note This method is wait-free.
+   */
+  void write(const T& data)
+  {
+    buffers_[write_index_] = data;
+    const unsigned int prev = middle_.exchange(write_index_ | NEW_DATA, std::memory_order_acq_rel);
+    write_index_ = prev & INDEX_MASK;
+  }
+
+  /**
+   * \return Latest data made available by the writer. The returned reference remains valid until the next call to
+   * \ref read.
+   * \note This method is wait-free.
+   */
+  const T& read()
+  {
+    if (middle_.load(std::memory_order_relaxed) & NEW_DATA)
+    {
+      const unsigned int prev = middle_.exchange(read_index_, std::memory_order_acq_rel);
+      read_index_ = prev & INDEX_MASK;
+    }
+    return buffers_[read_index_];
+  }
+
+private:
+  static const unsigned int INDEX_MASK = 0x3;
+  static const unsigned int NEW_DATA   = 0x4;
+
+  std::array<T, 3>          buffers_;
+  std::atomic<unsigned int> middle_;      ///< Index of the middle copy, plus the NEW_DATA flag.
+  unsigned int              write_index_; ///< Only accessed by the writer.
+  unsigned int              read_index_;  ///< Only accessed by the reader.
+};
+
+} // namespace
+
+#endif // header guard
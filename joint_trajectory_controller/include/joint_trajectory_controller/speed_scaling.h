@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_SPEED_SCALING_H
+#define JOINT_TRAJECTORY_CONTROLLER_SPEED_SCALING_H
+
+// C++ standard
+#include <atomic>
+#include <cmath>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Speed override of an executing trajectory.
+ *
+ * The trajectory time progresses at \ref scale times the controller time, so a scale of zero pauses the trajectory and
+ * a scale of one executes it as commanded. The scale follows the latest target set with \ref setTarget through a
+ * critically damped second-order filter with time constant \ref setTimeConstant. Both the scale and its rate are thus
+ * continuous, and so are the velocity and acceleration of the scaled trajectory:
+ *
+ * <tt> v = s * v_traj,  a = s^2 * a_traj + ds/dt * v_traj </tt>
+ *
+ * The target can be set from any thread, without locks. All other methods must be called from the realtime thread.
+ */
+class SpeedScaling
+{
+public:
+  SpeedScaling() : target_(1.0), time_constant_(0.0), scale_(1.0), rate_(0.0) {}
+
+  /**
+   * \param time_constant Time constant of the scale filter. If zero, the scale jumps to its target.
+   * \note This method is \b not thread-safe, and must be called before the realtime thread uses the object.
+   */
+  void setTimeConstant(double time_constant) {time_constant_ = time_constant > 0.0 ? time_constant : 0.0;}
+
+  /**
+   * \param scale New target scale. Negative values are clamped to zero.
+   * \return False if \p scale is not finite, in which case the target is unchanged.
+   * \note This method is lock-free and can be called from any thread.
+   */
+  bool setTarget(double scale)
+  {
+    if (!std::isfinite(scale)) {return false;}
+    target_.store(scale > 0.0 ? scale : 0.0, std::memory_order_relaxed);
+    return true;
+  }
+
+  /** \return Latest target scale. */
+  double target() const {return target_.load(std::memory_order_relaxed);}
+
+  /** \brief Jump to the target scale, e.g. when the controller starts at rest. */
+  void reset()
+  {
+    scale_ = target();
+    rate_  = 0.0;
+  }
+
+  /**
+   * \brief Move the scale towards its target.
+   * \param period Time elapsed since the previous update.
+   * \return Trajectory time elapsed in \p period, integrated with the trapezoidal rule.
+   */
+  double update(double period)
+  {
+    const double target     = this->target();
+    const double prev_scale = scale_;
+    if (time_constant_ == 0.0 || period <= 0.0)
+    {
+      scale_ = target;
+      rate_  = 0.0;
+    }
+    else
+    {
+      // Exact solution of e'' = -2we' - w^2 e, with e = scale - target. Stable for any period
+      const double w     = 1.0 / time_constant_;
+      const double e0    = scale_ - target;
+      const double c     = rate_ + w * e0;
+      const double decay = std::exp(-w * period);
+      const double e     = (e0 + c * period) * decay;
+      rate_  = (rate_ - w * c * period) * decay;
+      scale_ = target + e;
+
+      // Settle exactly on the target, so that an unscaled trajectory is sampled unmodified
+      if (std::abs(e) < EPSILON && std::abs(rate_) < EPSILON)
+      {
+        scale_ = target;
+        rate_  = 0.0;
+      }
+      // Trajectories never run backwards
+      if (scale_ < 0.0)
+      {
+        scale_ = 0.0;
+        rate_  = 0.0;
+      }
+    }
+    return 0.5 * (prev_scale + scale_) * period;
+  }
+
+  /** \return Current scale. */
+  double scale() const {return scale_;}
+
+  /** \return Current scale rate of change, per second. */
+  double rate() const {return rate_;}
+
+  /** \return True if trajectory states must be scaled, i.e. unless the scale is one and constant. */
+  bool active() const {return scale_ != 1.0 || rate_ != 0.0;}
+
+  /**
+   * \brief Convert a trajectory state sampled in trajectory time to controller time.
+   * \param[in,out] velocity Velocity, per unit of trajectory time on input.
+   * \param[in,out] acceleration Acceleration, per unit of trajectory time squared on input.
+   */
+  template <class Scalar>
+  void scaleState(Scalar& velocity, Scalar& acceleration) const
+  {
+    acceleration = scale_ * scale_ * acceleration + rate_ * velocity;
+    velocity     = scale_ * velocity;
+  }
+
+private:
+  static constexpr double EPSILON = 1e-6; ///< Scale and rate errors below which the target is reached.
+
+  std::atomic<double> target_;        ///< Written by any thread.
+  double              time_constant_;
+  double              scale_;         ///< Only accessed by the realtime thread.
+  double              rate_;          ///< Only accessed by the realtime thread.
+};
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_STATE_ERROR_SUMMARY_H
+#define JOINT_TRAJECTORY_CONTROLLER_STATE_ERROR_SUMMARY_H
+
+// C++ standard
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Running minimum, maximum and mean of the position and velocity error of a group of joints.
+ *
+ * Accumulates the state error of every update cycle between two consecutive publications of a decimated state summary.
+ *
+ * \tparam State State type. Must define a \p Scalar type and have \p position and \p velocity vectors.
+ */
+template <class State>
+class StateErrorSummary
+{
+public:
+  typedef typename State::Scalar Scalar;
+
+  /** Statistics of each joint, in the order they are written by \ref write. */
+  enum Statistic
+  {
+    POSITION_MIN,
+    POSITION_MAX,
+    POSITION_MEAN,
+    VELOCITY_MIN,
+    VELOCITY_MAX,
+    VELOCITY_MEAN,
+    STATISTICS_SIZE
+  };
+
+  StateErrorSummary() : count_(0) {}
+
+  /**
+   * \brief Resize the summary to \p n_joints joints and reset it.
+   * \note This method is \b not real-time safe.
+   */
+  void resize(std::size_t n_joints)
+  {
+    position_.resize(n_joints);
+    velocity_.resize(n_joints);
+    reset();
+  }
+
+  /**
+   * \brief Forget all accumulated samples.
+   * \note This method is realtime-safe.
+   */
+  void reset()
+  {
+    std::fill(position_.begin(), position_.end(), Accumulator());
+    std::fill(velocity_.begin(), velocity_.end(), Accumulator());
+    count_ = 0;
+  }
+
+  /**
+   * \brief Add the state error of one update cycle.
+   * \note This method is realtime-safe.
+   */
+  void add(const State& error)
+  {
+    for (std::size_t i = 0; i < position_.size(); ++i)
+    {
+      position_[i].add(error.position[i]);
+      velocity_[i].add(error.velocity[i]);
+    }
+    ++count_;
+  }
+
+  /** \return Number of samples added since the last reset. */
+  std::size_t count() const {return count_;}
+
+  /** \return Number of joints. */
+  std::size_t size() const {return position_.size();}
+
+  /**
+   * \brief Write the statistics of all joints to \p data, in joint-major order.
+   * \param[out] data Statistics. The value of \p Statistic \p s of joint \p i is written to
+   * <tt>data[i * STATISTICS_SIZE + s]</tt>. Must be preallocated to <tt>size() * STATISTICS_SIZE</tt> values.
+   * \note This method is realtime-safe.
+   */
+  template <class Vector>
+  void write(Vector& data) const
+  {
+    for (std::size_t i = 0; i < position_.size(); ++i)
+    {
+      position_[i].write(count_, &data[i * STATISTICS_SIZE + POSITION_MIN]);
+      velocity_[i].write(count_, &data[i * STATISTICS_SIZE + VELOCITY_MIN]);
+    }
+  }
+
+private:
+  struct Accumulator
+  {
+    Accumulator()
+      : min(std::numeric_limits<Scalar>::infinity()),
+        max(-std::numeric_limits<Scalar>::infinity()),
+        sum(0.0)
+    {}
+
+    void add(const Scalar& value)
+    {
+      min = std::min(min, value);
+      max = std::max(max, value);
+      sum += value;
+    }
+
+    template <class T>
+    void write(std::size_t count, T* data) const
+    {
+      data[0] = count > 0 ? min : 0.0;
+      data[1] = count > 0 ? max : 0.0;
+      data[2] = count > 0 ? sum / count : 0.0;
+    }
+
+    Scalar min;
+    Scalar max;
+    Scalar sum;
+  };
+
+  std::vector<Accumulator> position_;
+  std::vector<Accumulator> velocity_;
+  std::size_t              count_;
+};
+
+} // namespace
+
+#endif // header guard
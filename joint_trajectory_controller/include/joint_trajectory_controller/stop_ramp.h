@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_STOP_RAMP_H
+#define JOINT_TRAJECTORY_CONTROLLER_STOP_RAMP_H
+
+// Project
+#include <trajectory_interface/quintic_spline_segment.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Stop ramp policy: Computes the state in which a segment type comes to rest when settling in a fixed time.
+ *
+ * The stop ramp starts in a moving state with zero acceleration, and ends in a state with zero velocity at the same
+ * time it would reach if it were the midpoint of a segment of twice the duration ending in the start position with
+ * opposite velocity.
+ *
+ * The default implementation fits that segment and samples its midpoint. Specialize this class to compute the stop
+ * state in closed form.
+ *
+ * \tparam SegmentImpl Trajectory segment representation, see \ref JointTrajectoryController.
+ */
+template <class SegmentImpl>
+struct StopRampTraits
+{
+  typedef typename SegmentImpl::State  State;
+  typedef typename SegmentImpl::Scalar Scalar;
+
+  /**
+   * \param start_state State in which the ramp starts. Its acceleration is assumed to be zero.
+   * \param duration Positive ramp duration.
+   * \param[out] stop_state State in which the ramp ends. Must be preallocated to the size of \p start_state.
+   * \param segment Scratch segment. Its contents are overwritten.
+   * \note This method is realtime-safe if \p segment can be initialized without allocating memory.
+   */
+  static void stopState(const State&  start_state,
+                        const Scalar& duration,
+                        State&        stop_state,
+                        SegmentImpl&  segment)
+  {
+    for (unsigned int i = 0; i < start_state.position.size(); ++i)
+    {
+      stop_state.position[i]     =  start_state.position[i];
+      stop_state.velocity[i]     = -start_state.velocity[i];
+      stop_state.acceleration[i] =  0.0;
+    }
+    segment.init(0.0, start_state, 2.0 * duration, stop_state);
+    segment.sample(duration, stop_state);
+  }
+};
+
+/**
+ * \brief Closed-form stop ramp of quintic splines.
+ *
+ * The quintic spline from <tt>(p, v, 0)</tt> to <tt>(p, -v, 0)</tt> over a duration \e 2T is even about its midpoint,
+ * where it reaches position <tt>p + 5vT/8</tt>, zero velocity and acceleration <tt>-3v/(2T)</tt>.
+ */
+template <class Scalar>
+struct StopRampTraits<trajectory_interface::QuinticSplineSegment<Scalar> >
+{
+  typedef trajectory_interface::QuinticSplineSegment<Scalar> SegmentImpl;
+  typedef typename SegmentImpl::State                        State;
+
+  /** \sa StopRampTraits::stopState \note This method is realtime-safe. \p segment is not used. */
+  static void stopState(const State&  start_state,
+                        const Scalar& duration,
+                        State&        stop_state,
+                        SegmentImpl&  /*segment*/)
+  {
+    for (unsigned int i = 0; i < start_state.position.size(); ++i)
+    {
+      const Scalar velocity = start_state.velocity[i];
+      stop_state.position[i]     = start_state.position[i] + 0.625 * velocity * duration;
+      stop_state.velocity[i]     = 0.0;
+      stop_state.acceleration[i] = -1.5 * velocity / duration;
+    }
+  }
+};
+
+} // namespace
+
+#endif // header guard
@@ -33,9 +33,22 @@
 // C++ standard
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+// Boost
+#include <boost/shared_ptr.hpp>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define JOINT_TRAJECTORY_CONTROLLER_TOLERANCES_AVX
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define JOINT_TRAJECTORY_CONTROLLER_TOLERANCES_NEON
+#endif
+
 // ROS
 #include <ros/node_handle.h>
 
@@ -110,6 +123,36 @@ struct SegmentTolerancesPerJoint
   Scalar goal_time_tolerance;
 };
 
+/**
+ * \brief Per-joint tolerances of a trajectory goal, indexed by joint.
+ *
+ * A single table is built per goal and shared by all of its segments, which refer to their joint's entry.
+ */
+template<class Scalar>
+using SegmentTolerancesTable = std::vector<SegmentTolerancesPerJoint<Scalar> >;
+
+/**
+ * \param tolerances Multi-joint segment tolerances.
+ * \return Table with the tolerances of each joint in \p tolerances.
+ * \note This method is \b not real-time safe.
+ */
+template<class Scalar>
+boost::shared_ptr<const SegmentTolerancesTable<Scalar> >
+makeSegmentTolerancesTable(const SegmentTolerances<Scalar>& tolerances)
+{
+  assert(tolerances.state_tolerance.size() == tolerances.goal_state_tolerance.size());
+
+  boost::shared_ptr<SegmentTolerancesTable<Scalar> > table(
+        new SegmentTolerancesTable<Scalar>(tolerances.state_tolerance.size()));
+  for (std::size_t i = 0; i < table->size(); ++i)
+  {
+    (*table)[i].state_tolerance      = tolerances.state_tolerance[i];
+    (*table)[i].goal_state_tolerance = tolerances.goal_state_tolerance[i];
+    (*table)[i].goal_time_tolerance  = tolerances.goal_time_tolerance;
+  }
+  return table;
+}
+
 /**
  * \param state_error State error to check.
  * \param state_tolerance State tolerances to check \p state_error against.
@@ -197,6 +240,183 @@ inline bool checkStateTolerancePerJoint(const State&
   return true;
 }
 
+/**
+ * \brief State tolerances of several joints, stored as structure of arrays for batched checking.
+ * \sa checkStateTolerances
+ */
+template<class Scalar>
+struct StateTolerancesArray
+{
+  std::vector<Scalar> position;
+  std::vector<Scalar> velocity;
+  std::vector<Scalar> acceleration;
+
+  /** \brief Resize to \p size joints, with all tolerances disabled. */
+  void resize(std::size_t size)
+  {
+    position.assign(size, static_cast<Scalar>(0.0));
+    velocity.assign(size, static_cast<Scalar>(0.0));
+    acceleration.assign(size, static_cast<Scalar>(0.0));
+  }
+
+  std::size_t size() const {return position.size();}
+
+  /** \brief Set the tolerances of joint \p i. \note This method is realtime-safe. */
+  void set(std::size_t i, const StateTolerances<Scalar>& tolerances)
+  {
+    position[i]     = tolerances.position;
+    velocity[i]     = tolerances.velocity;
+    acceleration[i] = tolerances.acceleration;
+  }
+
+  /** \brief Disable the tolerances of joint \p i. \note This method is realtime-safe. */
+  void reset(std::size_t i) {set(i, StateTolerances<Scalar>());}
+};
+
+/**
+ * \brief Joint tolerance violation flags: bit \p i % 64 of word \p i / 64 is set if joint \p i violates its tolerances.
+ */
+typedef std::vector<std::uint64_t> ToleranceViolationMask;
+
+/** \return Number of 64-bit words of a \ref ToleranceViolationMask for \p n_joints joints. */
+inline std::size_t toleranceViolationMaskSize(std::size_t n_joints) {return (n_joints + 63) / 64;}
+
+/** \return True if joint \p i is flagged in \p mask. */
+inline bool isToleranceViolated(const ToleranceViolationMask& mask, std::size_t i)
+{
+  return (mask[i / 64] >> (i % 64)) & 1u;
+}
+
+namespace internal
+{
+
+/** Portable batch tolerance check kernel, also used for the joints not covered by vector instructions. */
+template <class Scalar>
+inline void checkStateTolerancesScalar(const Scalar* position_error, const Scalar* velocity_error,
+                                       const Scalar* acceleration_error, const StateTolerancesArray<Scalar>& tol,
+                                       std::size_t first, std::uint64_t* mask)
+{
+  using std::abs;
+  const std::size_t n_joints = tol.size();
+  for (std::size_t i = first; i < n_joints; ++i)
+  {
+    // Bitwise operators keep the check free of branches
+    const bool violated = ((tol.position[i]     > 0.0) & (abs(position_error[i])     > tol.position[i]))     |
+                          ((tol.velocity[i]     > 0.0) & (abs(velocity_error[i])     > tol.velocity[i]))     |
+                          ((tol.acceleration[i] > 0.0) & (abs(acceleration_error[i]) > tol.acceleration[i]));
+    mask[i / 64] |= static_cast<std::uint64_t>(violated) << (i % 64);
+  }
+}
+
+/** \return Number of leading joints checked with vector instructions. */
+template <class Scalar>
+inline std::size_t checkStateTolerancesSimd(const Scalar* /*position_error*/, const Scalar* /*velocity_error*/,
+                                            const Scalar* /*acceleration_error*/,
+                                            const StateTolerancesArray<Scalar>& /*tol*/, std::uint64_t* /*mask*/)
+{
+  return 0; // No vectorized implementation for this scalar type
+}
+
+#if defined(JOINT_TRAJECTORY_CONTROLLER_TOLERANCES_AVX)
+template <>
+inline std::size_t checkStateTolerancesSimd<double>(const double* position_error, const double* velocity_error,
+                                                    const double* acceleration_error,
+                                                    const StateTolerancesArray<double>& tol, std::uint64_t* mask)
+{
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d zero = _mm256_setzero_pd();
+  const double* errors[3]     = {position_error, velocity_error, acceleration_error};
+  const double* tolerances[3] = {tol.position.data(), tol.velocity.data(), tol.acceleration.data()};
+
+  const std::size_t n_joints = tol.size();
+  std::size_t i = 0;
+  for (; i + 4 <= n_joints; i += 4)
+  {
+    __m256d violated = zero;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      const __m256d abs_error = _mm256_andnot_pd(sign, _mm256_loadu_pd(errors[k] + i));
+      const __m256d tolerance = _mm256_loadu_pd(tolerances[k] + i);
+      violated = _mm256_or_pd(violated, _mm256_and_pd(_mm256_cmp_pd(tolerance, zero,      _CMP_GT_OQ),
+                                                      _mm256_cmp_pd(abs_error, tolerance, _CMP_GT_OQ)));
+    }
+    // Groups of four joints never straddle mask words
+    mask[i / 64] |= static_cast<std::uint64_t>(_mm256_movemask_pd(violated)) << (i % 64);
+  }
+  return i;
+}
+#elif defined(JOINT_TRAJECTORY_CONTROLLER_TOLERANCES_NEON)
+template <>
+inline std::size_t checkStateTolerancesSimd<double>(const double* position_error, const double* velocity_error,
+                                                    const double* acceleration_error,
+                                                    const StateTolerancesArray<double>& tol, std::uint64_t* mask)
+{
+  const float64x2_t zero = vdupq_n_f64(0.0);
+  const double* errors[3]     = {position_error, velocity_error, acceleration_error};
+  const double* tolerances[3] = {tol.position.data(), tol.velocity.data(), tol.acceleration.data()};
+
+  const std::size_t n_joints = tol.size();
+  std::size_t i = 0;
+  for (; i + 2 <= n_joints; i += 2)
+  {
+    uint64x2_t violated = vdupq_n_u64(0);
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      const float64x2_t error     = vld1q_f64(errors[k] + i);
+      const float64x2_t tolerance = vld1q_f64(tolerances[k] + i);
+      // vcagtq_f64 compares absolute values
+      violated = vorrq_u64(violated, vandq_u64(vcgtq_f64(tolerance, zero), vcagtq_f64(error, tolerance)));
+    }
+    const std::uint64_t bits = (vgetq_lane_u64(violated, 0) & 1u) | ((vgetq_lane_u64(violated, 1) & 1u) << 1);
+    mask[i / 64] |= bits << (i % 64);
+  }
+  return i;
+}
+#endif
+
+} // namespace
+
+/**
+ * \brief Check the state errors of several joints against their tolerances in a single pass.
+ *
+ * Equivalent to calling \ref checkStateTolerancePerJoint for each joint, but working on contiguous arrays without
+ * per-joint branches. When the build targets AVX or aarch64 NEON, several joints are checked per instruction.
+ *
+ * \param state_error Multi-joint state error to check.
+ * \param tolerances Tolerances of each joint. Zero tolerances are not checked.
+ * \param[out] violations Joints that violate their tolerances. Resized if needed, which is a no-op (and realtime-safe)
+ * when it was preallocated with \ref toleranceViolationMaskSize words.
+ * \return True if all joints fulfill their tolerances.
+ *
+ * \note This function is realtime-safe.
+ */
+template <class State>
+inline bool checkStateTolerances(const State&                                           state_error,
+                                 const StateTolerancesArray<typename State::Scalar>&    tolerances,
+                                 ToleranceViolationMask&                                violations)
+{
+  const std::size_t n_joints = tolerances.size();
+  assert(n_joints == state_error.position.size());
+  assert(n_joints == state_error.velocity.size());
+  assert(n_joints == state_error.acceleration.size());
+
+  violations.resize(toleranceViolationMaskSize(n_joints));
+  for (std::uint64_t& word : violations) {word = 0;}
+
+  const typename State::Scalar* position_error     = state_error.position.data();
+  const typename State::Scalar* velocity_error     = state_error.velocity.data();
+  const typename State::Scalar* acceleration_error = state_error.acceleration.data();
+
+  const std::size_t first = internal::checkStateTolerancesSimd(position_error, velocity_error, acceleration_error,
+                                                               tolerances, violations.data());
+  internal::checkStateTolerancesScalar(position_error, velocity_error, acceleration_error, tolerances, first,
+                                       violations.data());
+
+  std::uint64_t any = 0;
+  for (const std::uint64_t& word : violations) {any |= word;}
+  return any == 0;
+}
+
 /**
  * \brief Update data in \p tols from data in \p msg_tol.
  *
@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_FILE_H
+#define JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_FILE_H
+
+// C++ standard
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ROS messages
+#include <trajectory_msgs/JointTrajectory.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Read-only, memory-mapped binary trajectory file.
+ *
+ * Recorded trajectories of millions of points are too large to send as messages. A trajectory file is mapped into
+ * memory instead, and windows of its points are read into messages as they are needed, so opening a file and reading a
+ * window take the same time and memory regardless of the file size. The file layout, in native byte order, is:
+ *
+ * - An 8-byte magic string, \c "JTCTRAJ" followed by a NUL character.
+ * - The format version (\c uint32_t), currently 1.
+ * - The number of joints \e n (\c uint32_t) and the number of points (\c uint64_t).
+ * - The \e n joint names, each terminated by a NUL character, padded with NUL characters to a multiple of 8 bytes.
+ * - One record of <tt>1 + 3 n</tt> doubles per point: its time from start, then the positions, velocities and
+ * accelerations of all joints.
+ *
+ * Files are written with \ref writeTrajectoryFile.
+ */
+class TrajectoryFile
+{
+public:
+  TrajectoryFile() : data_(nullptr), size_(0), n_joints_(0), n_points_(0), points_(nullptr) {}
+  ~TrajectoryFile() {close();}
+
+  TrajectoryFile(const TrajectoryFile&) = delete;
+  TrajectoryFile& operator=(const TrajectoryFile&) = delete;
+
+  /**
+   * \brief Map the trajectory file at \p path, closing the previously opened one.
+   * \param error_string If not null, the reason of a failure is written to it.
+   * \return True if the file was opened and has a valid layout.
+   * \note Only the header of the file is read. Point data is paged in as it is accessed.
+   */
+  bool open(const std::string& path, std::string* error_string = nullptr)
+  {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {return fail("Could not open trajectory file '" + path + "': " + std::strerror(errno), error_string);}
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+      ::close(fd);
+      return fail("Could not read the size of trajectory file '" + path + "', or it is empty.", error_string);
+    }
+
+    void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping remains valid
+    if (data == MAP_FAILED)
+    {
+      return fail("Could not map trajectory file '" + path + "': " + std::strerror(errno), error_string);
+    }
+    madvise(data, file_stat.st_size, MADV_SEQUENTIAL); // Playback reads points in order
+    data_ = static_cast<const char*>(data);
+    size_ = file_stat.st_size;
+
+    if (!parseHeader())
+    {
+      close();
+      return fail("Trajectory file '" + path + "' is not a valid trajectory file, or is truncated.", error_string);
+    }
+    return true;
+  }
+
+  /** \brief Unmap the file, if any. */
+  void close()
+  {
+    if (data_) {munmap(const_cast<char*>(data_), size_);}
+    data_     = nullptr;
+    size_     = 0;
+    n_joints_ = 0;
+    n_points_ = 0;
+    points_   = nullptr;
+    joint_names_.clear();
+  }
+
+  /** \return True if a file is open. */
+  bool isOpen() const {return data_ != nullptr;}
+
+  /** \return Names of the joints of the trajectory. */
+  const std::vector<std::string>& getJointNames() const {return joint_names_;}
+
+  /** \return Number of points of the trajectory. */
+  std::size_t size() const {return n_points_;}
+
+  /** \return Time from start of point \p index, in seconds. */
+  double timeFromStart(std::size_t index) const {return record(index)[0];}
+
+  /**
+   * \return Index of the first point with a time from start not earlier than \p time_from_start, or \ref size if
+   * there is none. Points are expected to be sorted by time, and the search only pages in a logarithmic number of
+   * records.
+   */
+  std::size_t findPoint(double time_from_start) const
+  {
+    std::size_t first = 0;
+    std::size_t count = n_points_;
+    while (count > 0)
+    {
+      const std::size_t step = count / 2;
+      if (timeFromStart(first + step) < time_from_start)
+      {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else
+      {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  /**
+   * \brief Read points <tt>[first, last)</tt> into \p msg, together with the joint names.
+   *
+   * The storage of \p msg is reused, so reading windows of similar size into the same message performs few memory
+   * allocations. The header of \p msg is left untouched.
+   */
+  void readPoints(std::size_t first, std::size_t last, trajectory_msgs::JointTrajectory& msg) const
+  {
+    last = std::min(last, n_points_);
+    first = std::min(first, last);
+
+    msg.joint_names = joint_names_;
+    msg.points.resize(last - first);
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const double* rec = record(i);
+      trajectory_msgs::JointTrajectoryPoint& point = msg.points[i - first];
+      point.time_from_start = ros::Duration(rec[0]);
+      point.positions.assign(rec + 1, rec + 1 + n_joints_);
+      point.velocities.assign(rec + 1 + n_joints_, rec + 1 + 2 * n_joints_);
+      point.accelerations.assign(rec + 1 + 2 * n_joints_, rec + 1 + 3 * n_joints_);
+      point.effort.clear();
+    }
+  }
+
+private:
+  static constexpr std::size_t   MAGIC_SIZE  = 8;
+  static constexpr std::uint32_t VERSION     = 1;
+  static constexpr std::size_t   HEADER_SIZE = MAGIC_SIZE + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+  static const char* magic() {return "JTCTRAJ";} // Includes the terminating NUL character
+
+  const char*              data_;        ///< Mapped file contents.
+  std::size_t              size_;        ///< Size of the mapped file in bytes.
+  std::size_t              n_joints_;
+  std::size_t              n_points_;
+  const char*              points_;      ///< First point record.
+  std::vector<std::string> joint_names_;
+
+  friend bool writeTrajectoryFile(const std::string&, const trajectory_msgs::JointTrajectory&, std::string*);
+
+  static bool fail(const std::string& error, std::string* error_string)
+  {
+    if (error_string) {*error_string = error;}
+    return false;
+  }
+
+  static std::size_t paddedSize(std::size_t size) {return (size + 7) / 8 * 8;}
+
+  const double* record(std::size_t index) const
+  {
+    return reinterpret_cast<const double*>(points_) + index * (1 + 3 * n_joints_);
+  }
+
+  bool parseHeader()
+  {
+    if (size_ < HEADER_SIZE || std::memcmp(data_, magic(), MAGIC_SIZE) != 0) {return false;}
+
+    std::uint32_t version  = 0;
+    std::uint32_t n_joints = 0;
+    std::uint64_t n_points = 0;
+    std::memcpy(&version,  data_ + MAGIC_SIZE, sizeof(version));
+    std::memcpy(&n_joints, data_ + MAGIC_SIZE + sizeof(version), sizeof(n_joints));
+    std::memcpy(&n_points, data_ + MAGIC_SIZE + sizeof(version) + sizeof(n_joints), sizeof(n_points));
+    if (version != VERSION || n_joints == 0) {return false;}
+
+    // Joint names
+    const char* it  = data_ + HEADER_SIZE;
+    const char* end = data_ + size_;
+    std::vector<std::string> joint_names;
+    joint_names.reserve(n_joints);
+    for (std::uint32_t i = 0; i < n_joints; ++i)
+    {
+      const char* name_end = std::find(it, end, '\0');
+      if (name_end == end) {return false;}
+      joint_names.push_back(std::string(it, name_end));
+      it = name_end + 1;
+    }
+    const std::size_t points_offset = paddedSize(it - data_);
+
+    // Point records. Mappings are page-aligned, so records are aligned for double access
+    const std::size_t record_size = (1 + 3 * static_cast<std::size_t>(n_joints)) * sizeof(double);
+    if (points_offset > size_ || (size_ - points_offset) / record_size < n_points) {return false;}
+
+    n_joints_    = n_joints;
+    n_points_    = n_points;
+    points_      = data_ + points_offset;
+    joint_names_ = joint_names;
+    return true;
+  }
+};
+
+typedef std::shared_ptr<const TrajectoryFile> TrajectoryFilePtr;
+
+/**
+ * \brief Write the points of \p msg to a trajectory file, see \ref TrajectoryFile.
+ *
+ * Every point must specify the positions, velocities and accelerations of all joints of \p msg.
+ * \param error_string If not null, the reason of a failure is written to it.
+ * \return True on success.
+ */
+inline bool writeTrajectoryFile(const std::string&                      path,
+                                const trajectory_msgs::JointTrajectory& msg,
+                                std::string*                            error_string = nullptr)
+{
+  const std::size_t n_joints = msg.joint_names.size();
+  if (n_joints == 0) {return TrajectoryFile::fail("Cannot write a trajectory without joints.", error_string);}
+  for (const trajectory_msgs::JointTrajectoryPoint& point : msg.points)
+  {
+    if (point.positions.size() != n_joints || point.velocities.size() != n_joints ||
+        point.accelerations.size() != n_joints)
+    {
+      return TrajectoryFile::fail("Cannot write trajectory file. Every point must have positions, velocities and "
+                                  "accelerations for all joints.", error_string);
+    }
+  }
+
+  std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+  if (!file) {return TrajectoryFile::fail("Could not create trajectory file '" + path + "'.", error_string);}
+
+  const std::uint32_t version      = TrajectoryFile::VERSION;
+  const std::uint32_t n_joints_u32 = n_joints;
+  const std::uint64_t n_points     = msg.points.size();
+  file.write(TrajectoryFile::magic(), TrajectoryFile::MAGIC_SIZE);
+  file.write(reinterpret_cast<const char*>(&version),      sizeof(version));
+  file.write(reinterpret_cast<const char*>(&n_joints_u32), sizeof(n_joints_u32));
+  file.write(reinterpret_cast<const char*>(&n_points),     sizeof(n_points));
+
+  std::size_t names_size = 0;
+  for (const std::string& name : msg.joint_names)
+  {
+    file.write(name.c_str(), name.size() + 1);
+    names_size += name.size() + 1;
+  }
+  const std::size_t padding = TrajectoryFile::paddedSize(TrajectoryFile::HEADER_SIZE + names_size) -
+                              (TrajectoryFile::HEADER_SIZE + names_size);
+  const char zeros[8] = {};
+  file.write(zeros, padding);
+
+  std::vector<double> rec(1 + 3 * n_joints);
+  for (const trajectory_msgs::JointTrajectoryPoint& point : msg.points)
+  {
+    rec[0] = point.time_from_start.toSec();
+    std::copy(point.positions.begin(),     point.positions.end(),     rec.begin() + 1);
+    std::copy(point.velocities.begin(),    point.velocities.end(),    rec.begin() + 1 + n_joints);
+    std::copy(point.accelerations.begin(), point.accelerations.end(), rec.begin() + 1 + 2 * n_joints);
+    file.write(reinterpret_cast<const char*>(rec.data()), rec.size() * sizeof(double));
+  }
+
+  file.close();
+  if (!file) {return TrajectoryFile::fail("Could not write trajectory file '" + path + "'.", error_string);}
+  return true;
+}
+
+} // namespace
+
+#endif // header guard
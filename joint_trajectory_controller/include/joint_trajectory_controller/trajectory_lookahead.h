@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_LOOKAHEAD_H
+#define JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_LOOKAHEAD_H
+
+// C++ standard
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Project
+#include <trajectory_interface/trajectory_interface.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Samples of a multi-joint trajectory over a fixed horizon ahead of the current time.
+ *
+ * Samples are taken at multiples of a fixed spacing, the first one being the earliest multiple not before the current
+ * time, up to a small fraction of the spacing that absorbs roundoff when time advances by multiples of it. As time progresses, samples the window moves past are dropped from its front, and only the new samples at its
+ * end are computed, each one continuing the segment search where the previous one stopped. When the control period
+ * matches the spacing, this amounts to computing a single sample per cycle.
+ *
+ * Samples are only valid for the trajectory they were computed from. The window is recomputed when \ref update is
+ * called with a different trajectory, and must be \ref reset if the trajectory is modified in place.
+ *
+ * \tparam Trajectory Multi-joint trajectory type, see \ref MultiJointTrajectory.
+ * \note All methods other than \ref init are realtime-safe.
+ */
+template <class Trajectory>
+class TrajectoryLookahead
+{
+public:
+  typedef typename Trajectory::Segment           Segment;
+  typedef typename Segment::Time                 Time;
+  typedef typename Segment::State                State;
+  typedef typename Trajectory::Packed::size_type PackedSizeType;
+
+  TrajectoryLookahead()
+    : spacing_(0.0),
+      head_(0),
+      size_(0),
+      computed_(0),
+      first_index_(0),
+      trajectory_(nullptr),
+      packed_cursor_(0)
+  {}
+
+  /**
+   * \param n_samples Number of samples of the window.
+   * \param spacing Positive time between consecutive samples.
+   * \param n_joints Number of joints of the sampled trajectories.
+   * \note This method is \b not realtime-safe.
+   */
+  void init(std::size_t n_samples, const Time& spacing, unsigned int n_joints)
+  {
+    spacing_ = spacing;
+    states_.assign(n_samples, State(n_joints));
+    joint_state_ = State(1);
+    cursors_.assign(n_joints, 0);
+    packed_cursor_ = 0;
+    reset();
+  }
+
+  /** \brief Discard all samples, so that the next \ref update recomputes the window. */
+  void reset()
+  {
+    head_       = 0;
+    size_       = 0;
+    computed_   = 0;
+    trajectory_ = nullptr;
+  }
+
+  /**
+   * \brief Move the window to \p time, and compute the samples it lacks.
+   * \param trajectory Trajectory to sample.
+   * \param time Current time, in the time base of \p trajectory.
+   * \return Number of valid samples. Less than \ref capacity if \p trajectory is not defined at some sample time, in
+   * which case the window ends at the first such sample.
+   */
+  std::size_t update(const Trajectory& trajectory, const Time& time)
+  {
+    const std::size_t capacity = states_.size();
+    computed_ = 0;
+    if (capacity == 0) {return 0;}
+
+    // Drop the samples the window moved past, or all of them if they no longer apply
+    const Time roundoff_tolerance = 1e-6;
+    const std::int64_t first_index = static_cast<std::int64_t>(std::ceil(time / spacing_ - roundoff_tolerance));
+    const std::int64_t advance     = first_index - first_index_;
+    if (&trajectory != trajectory_ || advance < 0 || advance >= static_cast<std::int64_t>(size_))
+    {
+      head_ = 0;
+      size_ = 0;
+    }
+    else
+    {
+      head_  = (head_ + advance) % capacity;
+      size_ -= advance;
+    }
+    first_index_ = first_index;
+    trajectory_  = &trajectory;
+
+    // Compute new samples at the end of the window
+    while (size_ < capacity)
+    {
+      State& state = states_[(head_ + size_) % capacity];
+      if (!sample(trajectory, this->time(size_), state)) {break;}
+      ++size_;
+      ++computed_;
+    }
+    return size_;
+  }
+
+  /** \return Number of samples of a full window. */
+  std::size_t capacity() const {return states_.size();}
+
+  /** \return Number of valid samples. */
+  std::size_t size() const {return size_;}
+
+  /** \return Number of samples computed by the last \ref update. */
+  std::size_t computed() const {return computed_;}
+
+  /** \return Time between consecutive samples. */
+  const Time& spacing() const {return spacing_;}
+
+  /** \return Time of the <tt>k</tt>-th sample of the window. */
+  Time time(std::size_t k) const {return static_cast<Time>(first_index_ + static_cast<std::int64_t>(k)) * spacing_;}
+
+  /** \return State of the <tt>k</tt>-th sample of the window, for \p k lower than \ref size. */
+  const State& state(std::size_t k) const {return states_[(head_ + k) % states_.size()];}
+
+private:
+  typedef std::vector<typename Trajectory::value_type::size_type> Cursors;
+
+  Time               spacing_;
+  std::vector<State> states_;        ///< Ring of samples, starting at index \p head_.
+  std::size_t        head_;
+  std::size_t        size_;
+  std::size_t        computed_;
+  std::int64_t       first_index_;   ///< Time of the first sample, in multiples of \p spacing_.
+  const Trajectory*  trajectory_;    ///< Trajectory the samples were computed from.
+  Cursors            cursors_;       ///< Per-joint index of last sampled segment.
+  PackedSizeType     packed_cursor_; ///< Index of last sampled packed trajectory knot.
+  State              joint_state_;   ///< Preallocated workspace variable.
+
+  bool sample(const Trajectory& trajectory, const Time& time, State& state)
+  {
+    // All joints at once when they share segment boundaries, otherwise joint by joint
+    if (!trajectory.packed().empty())
+    {
+      return trajectory.packed().sample(time, state, packed_cursor_) != trajectory.packed().size();
+    }
+    for (unsigned int i = 0; i < trajectory.size(); ++i)
+    {
+      const typename Trajectory::value_type& joint_traj = trajectory[i];
+      if (trajectory_interface::sample(joint_traj, time, joint_state_, cursors_[i]) == joint_traj.end()) {return false;}
+      state.position[i]     = joint_state_.position[0];
+      state.velocity[i]     = joint_state_.velocity[0];
+      state.acceleration[i] = joint_state_.acceleration[0];
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+#endif // header guard
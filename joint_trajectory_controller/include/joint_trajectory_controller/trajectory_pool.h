@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_POOL_H
+#define JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_POOL_H
+
+// C++ standard
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Remove the segments of all joints of a trajectory, keeping their storage.
+ *
+ * Trajectory types whose per-joint segments can be shared with other trajectories overload this function, see
+ * \ref MultiJointTrajectory.
+ */
+template <class Trajectory>
+void clearSegments(Trajectory& trajectory)
+{
+  for (typename Trajectory::value_type& joint_traj : trajectory) {joint_traj.clear();}
+}
+
+/**
+ * \brief Pool of preallocated trajectories.
+ *
+ * Building a trajectory into a pooled object reuses the storage of its per-joint segment containers, so that once the
+ * pool is warm (or sized upfront with \ref init), trajectory construction performs no memory allocations. Releasing a
+ * trajectory amounts to dropping the last reference to it, after which it becomes available again.
+ *
+ * A trajectory is available when the pool holds the only reference to it. If all pooled trajectories are in use,
+ * \ref acquire falls back to allocating a new, unpooled trajectory.
+ *
+ * \tparam Trajectory Multi-joint trajectory type: a sequence of per-joint sequence containers.
+ */
+template <class Trajectory>
+class TrajectoryPool
+{
+public:
+  typedef std::shared_ptr<Trajectory> Ptr;
+
+  /**
+   * \brief Preallocate the pool.
+   * \param size Number of pooled trajectories.
+   * \param n_joints Number of joints of each trajectory.
+   * \param max_segments Number of segments per joint to reserve storage for. Zero makes storage grow on demand.
+   * \note This method is \b not real-time safe.
+   */
+  void init(std::size_t size, std::size_t n_joints, std::size_t max_segments)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    trajectories_.clear();
+    trajectories_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      Ptr trajectory(new Trajectory);
+      trajectory->resize(n_joints);
+      for (std::size_t j = 0; j < n_joints; ++j) {(*trajectory)[j].reserve(max_segments);}
+      trajectories_.push_back(trajectory);
+    }
+  }
+
+  /**
+   * \return An empty trajectory, recycled from the pool if one is available.
+   * \note This method is \b not real-time safe.
+   */
+  Ptr acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Ptr& trajectory : trajectories_)
+    {
+      if (trajectory.use_count() == 1)
+      {
+        // Drop stale segments (and the goal handles they refer to), but keep their storage
+        clearSegments(*trajectory);
+        return trajectory;
+      }
+    }
+    return Ptr(new Trajectory);
+  }
+
+  /** \return Number of pooled trajectories. */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trajectories_.size();
+  }
+
+  /** \return Number of pooled trajectories not in use. */
+  std::size_t available() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t count = 0;
+    for (const Ptr& trajectory : trajectories_) {if (trajectory.use_count() == 1) {++count;}}
+    return count;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<Ptr>   trajectories_;
+};
+
+} // namespace
+
+#endif // header guard
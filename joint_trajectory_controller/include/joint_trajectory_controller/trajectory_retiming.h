@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_RETIMING_H
+#define JOINT_TRAJECTORY_CONTROLLER_TRAJECTORY_RETIMING_H
+
+// C++ standard
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// ROS
+#include <ros/node_handle.h>
+
+// URDF
+#include <urdf/model.h>
+
+// ROS messages
+#include <trajectory_msgs/JointTrajectory.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Velocity and acceleration limits of a joint, used to retime trajectories.
+ *
+ * A non-positive limit is not enforced.
+ */
+struct RetimingLimits
+{
+  RetimingLimits() : max_velocity(0.0), max_acceleration(0.0) {}
+
+  double max_velocity;
+  double max_acceleration;
+};
+
+namespace internal
+{
+
+/**
+ * \brief Time scale that brings a segment to its limits, assuming it is a cubic spline.
+ *
+ * Scaling the duration of a cubic spline by \e c, and its boundary velocities by \e 1/c, scales its velocity profile by
+ * \e 1/c and its acceleration profile by \e 1/c^2. The returned scale makes the tighter of both limits active.
+ *
+ * \param displacement Position change over the segment.
+ * \param start_vel Start velocity.
+ * \param end_vel End velocity.
+ * \param start_acc Start acceleration given in the message, if any. Only used to bound the peak acceleration.
+ * \param end_acc End acceleration given in the message, if any. Only used to bound the peak acceleration.
+ * \param duration Positive segment duration.
+ * \param limits Joint limits.
+ * \return Duration scale. Zero if the joint does not constrain the segment.
+ */
+inline double segmentTimeScale(double displacement,
+                               double start_vel,
+                               double end_vel,
+                               double start_acc,
+                               double end_acc,
+                               double duration,
+                               const RetimingLimits& limits)
+{
+  const double T = duration;
+
+  // Boundary accelerations and jerk of the cubic spline
+  const double acc0 = ( 6.0 * displacement - (4.0 * start_vel + 2.0 * end_vel) * T) / (T * T);
+  const double acc1 = (-6.0 * displacement + (2.0 * start_vel + 4.0 * end_vel) * T) / (T * T);
+  const double jerk = (acc1 - acc0) / T;
+
+  // Peak velocity is reached at a boundary or where the acceleration crosses zero
+  double peak_vel = std::max(std::abs(start_vel), std::abs(end_vel));
+  if (jerk != 0.0)
+  {
+    const double t = -acc0 / jerk;
+    if (t > 0.0 && t < T) {peak_vel = std::max(peak_vel, std::abs(start_vel + acc0 * t + 0.5 * jerk * t * t));}
+  }
+  const double peak_acc = std::max(std::max(std::abs(acc0), std::abs(acc1)),
+                                   std::max(std::abs(start_acc), std::abs(end_acc)));
+
+  double scale = 0.0;
+  if (limits.max_velocity > 0.0)     {scale = std::max(scale, peak_vel / limits.max_velocity);}
+  if (limits.max_acceleration > 0.0) {scale = std::max(scale, std::sqrt(peak_acc / limits.max_acceleration));}
+  return scale;
+}
+
+inline double pointValue(const std::vector<double>& values, unsigned int i)
+{
+  return values.empty() ? 0.0 : values[i];
+}
+
+} // namespace
+
+/**
+ * \brief Retime a trajectory to execute as fast as joint velocity and acceleration limits allow.
+ *
+ * Each segment between consecutive points is uniformly time-scaled, so that the peak velocity or acceleration of its
+ * slowest joint reaches its limit. Peak values are estimated from a cubic spline through the segment boundaries, which
+ * is exact for cubic segments and a close estimate for quintic ones. Point velocities and accelerations are scaled
+ * consistently with the slower of their two neighbouring segments. As that makes the neighbour slightly slower than
+ * its estimate, segments that are still over their limits are stretched in a few additional passes.
+ *
+ * Segments that no joint constrains, such as dwells, keep their duration. So does the segment that leads to the first
+ * point, as it starts from the state the controller is in when the trajectory is spliced, which is not known here.
+ *
+ * \param limits Limits of the controller joints.
+ * \param mapping Index in \p limits of each joint of \p msg, see \ref internal::mapping.
+ * \param[in,out] msg Trajectory to retime. Its times, velocities and accelerations are updated in place.
+ * \return Ratio of the original to the retimed trajectory duration. One if the trajectory was left unchanged, which
+ * is also the case if it has fewer than two points or inconsistent point data, to be reported by later validation.
+ */
+inline double retimeTrajectory(const std::vector<RetimingLimits>&  limits,
+                               const std::vector<unsigned int>&    mapping,
+                               trajectory_msgs::JointTrajectory&   msg)
+{
+  typedef std::vector<trajectory_msgs::JointTrajectoryPoint> Points;
+  Points& points = msg.points;
+  const unsigned int n_points = points.size();
+  const unsigned int n_joints = msg.joint_names.size();
+  if (n_points < 2 || mapping.size() != n_joints) {return 1.0;}
+
+  // Preconditions: Consistent point data and increasing times
+  for (unsigned int k = 0; k < n_points; ++k)
+  {
+    const trajectory_msgs::JointTrajectoryPoint& point = points[k];
+    if (point.positions.size() != n_joints) {return 1.0;}
+    if (!point.velocities.empty()    && point.velocities.size()    != n_joints) {return 1.0;}
+    if (!point.accelerations.empty() && point.accelerations.size() != n_joints) {return 1.0;}
+    if (k > 0 && point.time_from_start <= points[k - 1].time_from_start)       {return 1.0;}
+  }
+  for (unsigned int j = 0; j < n_joints; ++j)
+  {
+    if (mapping[j] >= limits.size()) {return 1.0;}
+  }
+
+  const ros::Duration original_duration = points.back().time_from_start;
+
+  // Segment k leads from point k - 1 to point k
+  std::vector<double> durations(n_points);
+  durations[0] = points[0].time_from_start.toSec();
+  for (unsigned int k = 1; k < n_points; ++k)
+  {
+    durations[k] = (points[k].time_from_start - points[k - 1].time_from_start).toSec();
+  }
+
+  // The first pass brings segments to their limits, subsequent ones only stretch segments that are still over them
+  const unsigned int max_passes = 4;
+  const double stretch_tolerance = 1e-3;
+  std::vector<double> scales(n_points, 1.0);
+  for (unsigned int pass = 0; pass < max_passes; ++pass)
+  {
+    bool stretched = false;
+    for (unsigned int k = 1; k < n_points; ++k)
+    {
+      const trajectory_msgs::JointTrajectoryPoint& start = points[k - 1];
+      const trajectory_msgs::JointTrajectoryPoint& end   = points[k];
+      double scale = 0.0;
+      for (unsigned int j = 0; j < n_joints; ++j)
+      {
+        using internal::pointValue;
+        scale = std::max(scale, internal::segmentTimeScale(end.positions[j] - start.positions[j],
+                                                           pointValue(start.velocities, j),
+                                                           pointValue(end.velocities, j),
+                                                           pointValue(start.accelerations, j),
+                                                           pointValue(end.accelerations, j),
+                                                           durations[k],
+                                                           limits[mapping[j]]));
+      }
+      if (scale <= 0.0) {scale = 1.0;} // Unconstrained segment
+      if (pass > 0)
+      {
+        if (scale < 1.0 + stretch_tolerance) {scale = 1.0;}
+        else                                 {stretched = true;}
+      }
+      scales[k] = scale;
+    }
+    if (pass > 0 && !stretched) {break;}
+
+    // Apply scales. Point k is the end of segment k and the start of segment k + 1
+    for (unsigned int k = 0; k < n_points; ++k)
+    {
+      durations[k] *= scales[k];
+      const double point_scale = (k + 1 < n_points) ? std::max(scales[k], scales[k + 1]) : scales[k];
+      trajectory_msgs::JointTrajectoryPoint& point = points[k];
+      for (double& vel : point.velocities)    {vel /= point_scale;}
+      for (double& acc : point.accelerations) {acc /= point_scale * point_scale;}
+    }
+    std::fill(scales.begin(), scales.end(), 1.0);
+  }
+
+  // Accumulate retimed durations
+  double time_from_start = 0.0;
+  for (unsigned int k = 0; k < n_points; ++k)
+  {
+    time_from_start += durations[k];
+    points[k].time_from_start = ros::Duration(time_from_start);
+  }
+
+  const double retimed_duration = points.back().time_from_start.toSec();
+  return retimed_duration > 0.0 ? original_duration.toSec() / retimed_duration : 1.0;
+}
+
+/**
+ * \brief Populate trajectory retiming limits from the URDF and data in the ROS parameter server.
+ *
+ * Limits are read as by \p joint_limits_interface::getJointLimits: velocity limits default to those of the URDF joints,
+ * and parameters only take effect if the flag of their kind of limit is set. Acceleration limits are not part of the
+ * URDF, and are not enforced unless specified. It is assumed that the following parameter structure is followed on the
+ * provided NodeHandle:
+ *
+ * \code
+ * joint_limits:
+ *  foo_joint:
+ *    has_velocity_limits: true     # False disables the URDF velocity limit
+ *    max_velocity: 2.0             # Overrides the URDF velocity limit
+ *    has_acceleration_limits: true
+ *    max_acceleration: 5.0
+ * \endcode
+ *
+ * \param nh NodeHandle where the limits are specified.
+ * \param joint_names Names of joints to look for in the parameter server for a limits specification.
+ * \param urdf_joints URDF joints, in the same order as \p joint_names.
+ * \return Joint limits.
+ */
+inline std::vector<RetimingLimits> getRetimingLimits(const ros::NodeHandle&                     nh,
+                                                     const std::vector<std::string>&            joint_names,
+                                                     const std::vector<urdf::JointConstSharedPtr>& urdf_joints)
+{
+  std::vector<RetimingLimits> limits(joint_names.size());
+  for (unsigned int i = 0; i < joint_names.size(); ++i)
+  {
+    const bool has_urdf_limits = i < urdf_joints.size() && urdf_joints[i] && urdf_joints[i]->limits;
+    limits[i].max_velocity = has_urdf_limits ? urdf_joints[i]->limits->velocity : 0.0;
+
+    const ros::NodeHandle joint_nh(nh, joint_names[i]);
+    bool has_velocity_limits = false;
+    if (joint_nh.getParam("has_velocity_limits", has_velocity_limits))
+    {
+      if (!has_velocity_limits) {limits[i].max_velocity = 0.0;}
+      else                      {joint_nh.getParam("max_velocity", limits[i].max_velocity);}
+    }
+    bool has_acceleration_limits = false;
+    if (joint_nh.getParam("has_acceleration_limits", has_acceleration_limits) && has_acceleration_limits)
+    {
+      joint_nh.getParam("max_acceleration", limits[i].max_acceleration);
+    }
+  }
+  return limits;
+}
+
+} // namespace
+
+#endif // header guard
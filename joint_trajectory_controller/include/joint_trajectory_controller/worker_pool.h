@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_WORKER_POOL_H
+#define JOINT_TRAJECTORY_CONTROLLER_WORKER_POOL_H
+
+// C++ standard
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Fixed-size pool of threads executing tasks in submission order.
+ *
+ * Used to move expensive, non-realtime work (e.g. fitting a trajectory to a large command message) out of ROS
+ * callbacks, so that the callback queue keeps being serviced while the work is carried out.
+ *
+ * Upon destruction, tasks that are still queued are executed before the worker threads are joined.
+ */
+class WorkerPool
+{
+public:
+  typedef std::function<void()> Task;
+
+  /**
+   * \param threads Number of worker threads. Values smaller than one are clamped to one.
+   */
+  explicit WorkerPool(std::size_t threads = 1)
+    : stop_(false),
+      pending_(0)
+  {
+    if (threads < 1) {threads = 1;}
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {workers_.emplace_back(&WorkerPool::run, this);}
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (std::thread& worker : workers_) {worker.join();}
+  }
+
+  /**
+   * \brief Queue \p task for execution by one of the worker threads.
+   * \note This method is \b not real-time safe.
+   */
+  void submit(Task task)
+  {
+    if (!task) {return;}
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(task));
+      ++pending_;
+    }
+    cond_.notify_one();
+  }
+
+  /**
+   * \brief Call \p function for every index in <tt>[0, size)</tt>, spreading the calls over the worker threads and the
+   * calling thread, and wait for all of them to complete.
+   *
+   * The calling thread takes part in the work, so this method can be safely called from a task running in this very
+   * pool: if all workers are busy, the caller performs all the calls by itself. The calls are not ordered, so
+   * \p function must only write data specific to its index for the result to be deterministic.
+   *
+   * If calls throw, the exception thrown by the call with the lowest index is rethrown once all calls completed.
+   * \note This method is \b not real-time safe.
+   */
+  void parallelFor(std::size_t size, const std::function<void(std::size_t)>& function)
+  {
+    if (size == 0) {return;}
+
+    std::shared_ptr<Loop> loop = std::make_shared<Loop>(size, function);
+    const std::size_t helpers = std::min(size - 1, workers_.size());
+    for (std::size_t i = 0; i < helpers; ++i) {submit([loop] {loop->work();});}
+    loop->work();
+
+    // Helpers that start after all calls completed return right away, and only touch the shared loop state
+    {
+      std::unique_lock<std::mutex> lock(loop->mutex);
+      loop->cond.wait(lock, [&loop] {return loop->done == loop->size;});
+    }
+    for (const std::exception_ptr& error : loop->errors)
+    {
+      if (error) {std::rethrow_exception(error);}
+    }
+  }
+
+  /**
+   * \return Number of submitted tasks that have not finished executing yet.
+   * \note This method is realtime-safe.
+   */
+  std::size_t pending() const {return pending_.load();}
+
+  /**
+   * \return Number of worker threads.
+   */
+  std::size_t size() const {return workers_.size();}
+
+private:
+  /** \brief State of a \ref parallelFor call, shared with the tasks helping to carry it out. */
+  struct Loop
+  {
+    Loop(std::size_t size, const std::function<void(std::size_t)>& function)
+      : size(size), function(&function), next(0), done(0), errors(size) {}
+
+    void work()
+    {
+      for (std::size_t i = next++; i < size; i = next++)
+      {
+        try {(*function)(i);}
+        catch (...) {errors[i] = std::current_exception();}
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (++done == size) {cond.notify_all();}
+      }
+    }
+
+    const std::size_t                         size;
+    const std::function<void(std::size_t)>*   function; ///< Only called while the caller waits for completion.
+    std::atomic<std::size_t>                  next;     ///< Next index to process.
+    std::size_t                               done;     ///< Number of completed calls. Guarded by \p mutex.
+    std::vector<std::exception_ptr>           errors;   ///< Exception thrown by each call, if any.
+    std::mutex                                mutex;
+    std::condition_variable                   cond;
+  };
+
+  std::mutex               mutex_;
+  std::condition_variable  cond_;
+  std::deque<Task>         queue_;   ///< Tasks waiting for a worker thread.
+  bool                     stop_;    ///< Request worker thread termination.
+  std::atomic<std::size_t> pending_;
+  std::vector<std::thread> workers_;
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+      cond_.wait(lock, [this] {return stop_ || !queue_.empty();});
+      if (queue_.empty()) {break;} // Only exit once the queue has been drained
+
+      Task task = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+      task();
+      task = Task(); // Release captured state before reporting completion
+      --pending_;
+      lock.lock();
+    }
+  }
+};
+
+} // namespace
+
+#endif // header guard
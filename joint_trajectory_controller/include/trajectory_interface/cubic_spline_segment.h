@@ -0,0 +1,245 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2013, PAL Robotics S.L.
+// Copyright (c) 2008, Willow Garage, Inc.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of PAL Robotics S.L. nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef TRAJECTORY_INTERFACE_CUBIC_SPLINE_SEGMENT_H
+#define TRAJECTORY_INTERFACE_CUBIC_SPLINE_SEGMENT_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <trajectory_interface/spline_segment_storage.h>
+
+namespace trajectory_interface
+{
+
+/**
+ * \brief Class representing a multi-dimensional cubic spline segment with a start and end time.
+ *
+ * Positions and velocities of the boundary conditions are interpolated, so that velocity is continuous across
+ * segments. Accelerations are ignored, which makes fitting and sampling cheaper than with \ref QuinticSplineSegment.
+ *
+ * \tparam ScalarType Scalar type
+ * \tparam Dim Segment dimension. If zero (the default), the dimension is specified at runtime by the boundary
+ * conditions. Otherwise, the segment and its state type (\ref FixedPosVelAccState) store their data inline.
+ */
+template<class ScalarType, unsigned int Dim = 0>
+class CubicSplineSegment
+{
+  typedef internal::SplineSegmentStorage<ScalarType, 4, Dim> Storage;
+
+public:
+  typedef ScalarType              Scalar;
+  typedef Scalar                  Time;
+  typedef typename Storage::State State;
+
+  /** Coefficients represent a cubic polynomial like so:
+   *
+   * <tt> coefs[0] + coefs[1]*x + coefs[2]*x^2 + coefs[3]*x^3 </tt>
+   */
+  typedef typename Storage::SplineCoefficients SplineCoefficients;
+
+  /**
+   * \brief Creates an empty segment.
+   *
+   * \note Calling <tt> size() </tt> on an empty segment will yield zero, and sampling it will yield a state with empty
+   * data. Fixed-dimension segments instead yield the fixed dimension, and sample a zero state.
+   */
+  CubicSplineSegment()
+    : coefs_(),
+      duration_(static_cast<Scalar>(0)),
+      start_time_(static_cast<Scalar>(0))
+  {}
+
+  /**
+   * \brief Construct segment from start and end states (boundary conditions).
+   *
+   * Please refer to the \ref init method documentation for the description of each parameter and the exceptions that
+   * can be thrown.
+   */
+  CubicSplineSegment(const Time&  start_time,
+                     const State& start_state,
+                     const Time&  end_time,
+                     const State& end_state)
+  {
+    init(start_time, start_state, end_time, end_state);
+  }
+
+  /**
+   * \brief Initialize segment from start and end states (boundary conditions).
+   *
+   * - If only \b positions are specified, linear interpolation will be used.
+   * - If \b positions and \b velocities are specified, a cubic spline will be used.
+   *
+   * Accelerations are ignored. If start and end states have different specifications, the lowest common specification
+   * will be used.
+   *
+   * \param start_time Time at which the segment state equals \p start_state.
+   * \param start_state State at \p start_time.
+   * \param end_time Time at which the segment state equals \p end_state.
+   * \param end_state State at time \p end_time.
+   *
+   * \throw std::invalid_argument If the \p end_time is earlier than \p start_time or if one of the states is
+   * uninitialized, or if the states dimension differs from a fixed segment dimension.
+   */
+  void init(const Time&  start_time,
+            const State& start_state,
+            const Time&  end_time,
+            const State& end_state);
+
+  /**
+   * \brief Sample the segment at a specified time.
+   *
+   * \note Within the <tt>[start_time, end_time]</tt> interval, spline interpolation takes place, outside it this method
+   * will output the start/end states with zero velocity and acceleration.
+   *
+   * \param[in] time Where the segment is to be sampled.
+   * \param[out] state Segment state at \p time.
+   */
+  void sample(const Time& time, State& state) const
+  {
+    // Resize state data, if not fixed-size
+    Storage::resize(state, coefs_.size());
+
+    const Time t = time - start_time_;
+    const bool within = t >= 0.0 && t <= duration_;
+    const Time t_clamped = t < 0.0 ? static_cast<Time>(0) : (within ? t : duration_);
+    for (std::size_t i = 0; i < coefs_.size(); ++i)
+    {
+      // Horner evaluation
+      const SplineCoefficients& c = coefs_[i];
+      state.position[i] = ((c[3] * t_clamped + c[2]) * t_clamped + c[1]) * t_clamped + c[0];
+      if (within)
+      {
+        state.velocity[i]     = (3.0 * c[3] * t_clamped + 2.0 * c[2]) * t_clamped + c[1];
+        state.acceleration[i] = 6.0 * c[3] * t_clamped + 2.0 * c[2];
+      }
+      else
+      {
+        state.velocity[i]     = static_cast<Scalar>(0);
+        state.acceleration[i] = static_cast<Scalar>(0);
+      }
+    }
+  }
+
+  /** \return Segment start time. */
+  Time startTime() const {return start_time_;}
+
+  /** \return Segment end time. */
+  Time endTime() const {return start_time_ + duration_;}
+
+  /** \return Segment duration. */
+  Time duration() const {return duration_;}
+
+  /** \return Segment size (dimension). */
+  unsigned int size() const {return coefs_.size();}
+
+  /**
+   * \return Spline coefficients of dimension \p dim, expressed in time relative to the segment start time.
+   * \pre <tt>dim < size()</tt>
+   */
+  const SplineCoefficients& coefficients(unsigned int dim) const {return coefs_[dim];}
+
+private:
+  typedef typename Storage::Coefficients Coefficients;
+
+  Coefficients coefs_;
+  Time duration_;
+  Time start_time_;
+};
+
+template<class ScalarType, unsigned int Dim>
+void CubicSplineSegment<ScalarType, Dim>::init(const Time&  start_time,
+                                               const State& start_state,
+                                               const Time&  end_time,
+                                               const State& end_state)
+{
+  // Preconditions
+  if (end_time < start_time)
+  {
+    throw(std::invalid_argument("Cubic spline segment can't be constructed: end_time < start_time."));
+  }
+  if (start_state.position.empty() || end_state.position.empty())
+  {
+    throw(std::invalid_argument("Cubic spline segment can't be constructed: Endpoint positions can't be empty."));
+  }
+  if (start_state.position.size() != end_state.position.size())
+  {
+    throw(std::invalid_argument("Cubic spline segment can't be constructed: Endpoint positions size mismatch."));
+  }
+
+  const unsigned int dim = start_state.position.size();
+  const bool has_velocity = !start_state.velocity.empty() && !end_state.velocity.empty();
+
+  if (has_velocity && dim != start_state.velocity.size())
+  {
+    throw(std::invalid_argument("Cubic spline segment can't be constructed: Start state velocity size mismatch."));
+  }
+  if (has_velocity && dim != end_state.velocity.size())
+  {
+    throw(std::invalid_argument("Cubic spline segment can't be constructed: End state velocity size mismatch."));
+  }
+
+  // Time data
+  start_time_ = start_time;
+  duration_   = end_time - start_time;
+
+  // Spline coefficients
+  Storage::resize(coefs_, dim);
+  const Scalar T  = duration_;
+  const Scalar T2 = T * T;
+  for (unsigned int i = 0; i < dim; ++i)
+  {
+    const Scalar start_pos = start_state.position[i];
+    const Scalar end_pos   = end_state.position[i];
+    SplineCoefficients& c = coefs_[i];
+    c[0] = start_pos;
+    if (T == 0.0)
+    {
+      c[1] = has_velocity ? start_state.velocity[i] : static_cast<Scalar>(0);
+      c[2] = 0.0;
+      c[3] = 0.0;
+    }
+    else if (!has_velocity)
+    {
+      // Linear interpolation
+      c[1] = (end_pos - start_pos) / T;
+      c[2] = 0.0;
+      c[3] = 0.0;
+    }
+    else
+    {
+      const Scalar start_vel = start_state.velocity[i];
+      const Scalar end_vel   = end_state.velocity[i];
+      c[1] = start_vel;
+      c[2] = (-3.0 * start_pos + 3.0 * end_pos - 2.0 * start_vel * T - end_vel * T) / T2;
+      c[3] = (2.0 * start_pos - 2.0 * end_pos + start_vel * T + end_vel * T) / (T2 * T);
+    }
+  }
+}
+
+} // namespace
+
+#endif // header guard
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2013, PAL Robotics S.L.
+// Copyright (c) 2008, Willow Garage, Inc.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of PAL Robotics S.L. nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef TRAJECTORY_INTERFACE_LINEAR_SEGMENT_H
+#define TRAJECTORY_INTERFACE_LINEAR_SEGMENT_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <trajectory_interface/spline_segment_storage.h>
+
+namespace trajectory_interface
+{
+
+/**
+ * \brief Class representing a multi-dimensional linear segment with a start and end time.
+ *
+ * Only the endpoint positions are interpolated: velocities and accelerations of the boundary conditions are ignored,
+ * and the sampled velocity is constant over the segment. This suits dense trajectories, whose points are close enough
+ * for the velocity steps between segments to be negligible, and makes fitting and sampling cheaper than with
+ * \ref QuinticSplineSegment.
+ *
+ * \tparam ScalarType Scalar type
+ * \tparam Dim Segment dimension. If zero (the default), the dimension is specified at runtime by the boundary
+ * conditions. Otherwise, the segment and its state type (\ref FixedPosVelAccState) store their data inline.
+ */
+template<class ScalarType, unsigned int Dim = 0>
+class LinearSegment
+{
+  typedef internal::SplineSegmentStorage<ScalarType, 2, Dim> Storage;
+
+public:
+  typedef ScalarType              Scalar;
+  typedef Scalar                  Time;
+  typedef typename Storage::State State;
+
+  /** Coefficients represent a line like so: <tt> coefs[0] + coefs[1]*x </tt> */
+  typedef typename Storage::SplineCoefficients SplineCoefficients;
+
+  /**
+   * \brief Creates an empty segment.
+   *
+   * \note Calling <tt> size() </tt> on an empty segment will yield zero, and sampling it will yield a state with empty
+   * data. Fixed-dimension segments instead yield the fixed dimension, and sample a zero state.
+   */
+  LinearSegment()
+    : coefs_(),
+      duration_(static_cast<Scalar>(0)),
+      start_time_(static_cast<Scalar>(0))
+  {}
+
+  /**
+   * \brief Construct segment from start and end states (boundary conditions).
+   *
+   * Please refer to the \ref init method documentation for the description of each parameter and the exceptions that
+   * can be thrown.
+   */
+  LinearSegment(const Time&  start_time,
+                const State& start_state,
+                const Time&  end_time,
+                const State& end_state)
+  {
+    init(start_time, start_state, end_time, end_state);
+  }
+
+  /**
+   * \brief Initialize segment from start and end states (boundary conditions).
+   *
+   * \param start_time Time at which the segment state equals \p start_state.
+   * \param start_state State at \p start_time. Only its positions are used.
+   * \param end_time Time at which the segment state equals \p end_state.
+   * \param end_state State at time \p end_time. Only its positions are used.
+   *
+   * \throw std::invalid_argument If the \p end_time is earlier than \p start_time or if one of the states is
+   * uninitialized, or if the states dimension differs from a fixed segment dimension.
+   */
+  void init(const Time&  start_time,
+            const State& start_state,
+            const Time&  end_time,
+            const State& end_state)
+  {
+    // Preconditions
+    if (end_time < start_time)
+    {
+      throw(std::invalid_argument("Linear segment can't be constructed: end_time < start_time."));
+    }
+    if (start_state.position.empty() || end_state.position.empty())
+    {
+      throw(std::invalid_argument("Linear segment can't be constructed: Endpoint positions can't be empty."));
+    }
+    if (start_state.position.size() != end_state.position.size())
+    {
+      throw(std::invalid_argument("Linear segment can't be constructed: Endpoint positions size mismatch."));
+    }
+
+    // Time data
+    start_time_ = start_time;
+    duration_   = end_time - start_time;
+
+    // Coefficients
+    const unsigned int dim = start_state.position.size();
+    Storage::resize(coefs_, dim);
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+      coefs_[i][0] = start_state.position[i];
+      coefs_[i][1] = (duration_ == 0.0) ? 0.0 : (end_state.position[i] - start_state.position[i]) / duration_;
+    }
+  }
+
+  /**
+   * \brief Sample the segment at a specified time.
+   *
+   * \note Within the <tt>[start_time, end_time]</tt> interval, linear interpolation takes place, outside it this method
+   * will output the start/end states with zero velocity and acceleration.
+   *
+   * \param[in] time Where the segment is to be sampled.
+   * \param[out] state Segment state at \p time.
+   */
+  void sample(const Time& time, State& state) const
+  {
+    // Resize state data, if not fixed-size
+    Storage::resize(state, coefs_.size());
+
+    const Time t = time - start_time_;
+    const bool within = t >= 0.0 && t <= duration_;
+    const Time t_clamped = t < 0.0 ? static_cast<Time>(0) : (within ? t : duration_);
+    for (std::size_t i = 0; i < coefs_.size(); ++i)
+    {
+      state.position[i]     = coefs_[i][0] + coefs_[i][1] * t_clamped;
+      state.velocity[i]     = within ? coefs_[i][1] : static_cast<Scalar>(0);
+      state.acceleration[i] = static_cast<Scalar>(0);
+    }
+  }
+
+  /** \return Segment start time. */
+  Time startTime() const {return start_time_;}
+
+  /** \return Segment end time. */
+  Time endTime() const {return start_time_ + duration_;}
+
+  /** \return Segment duration. */
+  Time duration() const {return duration_;}
+
+  /** \return Segment size (dimension). */
+  unsigned int size() const {return coefs_.size();}
+
+  /**
+   * \return Line coefficients of dimension \p dim, expressed in time relative to the segment start time.
+   * \pre <tt>dim < size()</tt>
+   */
+  const SplineCoefficients& coefficients(unsigned int dim) const {return coefs_[dim];}
+
+private:
+  typedef typename Storage::Coefficients Coefficients;
+
+  Coefficients coefs_;
+  Time duration_;
+  Time start_time_;
+};
+
+} // namespace
+
+#endif // header guard
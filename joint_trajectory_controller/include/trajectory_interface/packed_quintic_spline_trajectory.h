@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRAJECTORY_INTERFACE_PACKED_QUINTIC_SPLINE_TRAJECTORY_H
+#define TRAJECTORY_INTERFACE_PACKED_QUINTIC_SPLINE_TRAJECTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <trajectory_interface/pos_vel_acc_state.h>
+#include <trajectory_interface/quintic_spline_batch.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+#include <trajectory_interface/trajectory_interface.h>
+
+namespace trajectory_interface
+{
+
+namespace internal
+{
+
+/** Size in bytes of the alignment boundary of packed trajectory data. */
+const std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * \brief Standard-conforming allocator returning memory aligned to \p Alignment bytes.
+ *
+ * \note C++14 allocation functions do not honor alignments larger than that of \p std::max_align_t, so memory is
+ * over-allocated and the aligned address is offset from the one returned by <tt>::operator new</tt>.
+ */
+template <class T, std::size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator
+{
+public:
+  typedef T value_type;
+
+  template <class U> struct rebind {typedef AlignedAllocator<U, Alignment> other;};
+
+  AlignedAllocator() {}
+  template <class U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(std::size_t n)
+  {
+    if (n > (std::numeric_limits<std::size_t>::max() - Alignment - sizeof(void*)) / sizeof(T)) {throw std::bad_alloc();}
+
+    void* raw = ::operator new(n * sizeof(T) + Alignment + sizeof(void*));
+    const std::uintptr_t first   = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    const std::uintptr_t aligned = (first + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw; // Stash original address right before aligned block
+    return reinterpret_cast<T*>(aligned);
+  }
+
+  void deallocate(T* ptr, std::size_t /*n*/)
+  {
+    ::operator delete(reinterpret_cast<void**>(ptr)[-1]);
+  }
+};
+
+template <class T, class U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {return true;}
+
+template <class T, class U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {return false;}
+
+} // namespace
+
+/**
+ * \brief Multi-joint quintic spline trajectory stored in structure-of-arrays layout.
+ *
+ * A trajectory is usually stored as one sequence of one-dimensional segments per joint, which is flexible (joints may
+ * have different segment boundaries) but scatters data across many small heap blocks. When all joints share segment
+ * boundaries, which is the common case for full-joint goals, this class packs the spline coefficients of all joints
+ * contiguously per segment \e knot, such that sampling all joints at a given time is a single pass over
+ * cache-line-aligned memory.
+ *
+ * For every knot, coefficients are stored as six rows (one per polynomial order), each row holding the coefficient of
+ * every joint. Rows are padded to a multiple of the cache line size.
+ *
+ * All joints are evaluated at once with \ref sampleQuinticSplineBatch. Results match sampling each joint segment with
+ * \ref QuinticSplineSegment::sample up to floating-point rounding.
+ *
+ * \tparam ScalarType Scalar type
+ */
+template <class ScalarType>
+class PackedQuinticSplineTrajectory
+{
+public:
+  typedef ScalarType             Scalar;
+  typedef Scalar                 Time;
+  typedef PosVelAccState<Scalar> State;
+  typedef std::size_t            size_type;
+
+  PackedQuinticSplineTrajectory()
+    : dim_(0),
+      stride_(0)
+  {}
+
+  /**
+   * \brief Pack a per-joint trajectory.
+   *
+   * \param trajectory Sequence of per-joint trajectories, each being a sequence of one-dimensional segments derived from
+   * \ref QuinticSplineSegment.
+   *
+   * \return True if \p trajectory could be packed, that is, if all joints have the same number of segments with
+   * identical start times and durations. Otherwise the packed trajectory is left empty.
+   */
+  template <class Trajectory>
+  bool init(const Trajectory& trajectory);
+
+  /** \brief Remove all data. */
+  void clear()
+  {
+    knots_.clear();
+    coefs_.clear();
+    dim_    = 0;
+    stride_ = 0;
+  }
+
+  /** \return True if the trajectory contains no knots. */
+  bool empty() const {return knots_.empty();}
+
+  /** \return Number of knots (segments per joint). */
+  size_type size() const {return knots_.size();}
+
+  /** \return Number of joints. */
+  unsigned int dimension() const {return dim_;}
+
+  /**
+   * \brief Sample all joints at a specified time.
+   *
+   * \param[in] time Where the trajectory is to be sampled.
+   * \param[out] state Joint states at \p time. Should be sized to \ref dimension to avoid allocations.
+   * \param[in,out] cursor Index where the knot search starts, see
+   * \ref sample(const Trajectory&, const typename Trajectory::value_type::Time&, typename Trajectory::value_type::State&, typename Trajectory::size_type&) "sample".
+   *
+   * \return Index of the knot containing \p time, or \ref size if no knot contains it. In the latter case the state
+   * of the first knot is sampled, like for per-joint trajectories.
+   *
+   * \note This method is realtime-safe if \p state is appropriately sized.
+   */
+  size_type sample(const Time& time, State& state, size_type& cursor) const;
+
+private:
+  /** Segment boundaries common to all joints. */
+  struct Knot
+  {
+    Time start_time;
+    Time duration;
+    Time startTime() const {return start_time;}
+  };
+
+  typedef std::vector<Scalar, internal::AlignedAllocator<Scalar> > CoefficientVector;
+
+  std::vector<Knot> knots_;
+  CoefficientVector coefs_;  ///< Knot-major, then polynomial order, then joint.
+  unsigned int      dim_;    ///< Number of joints.
+  size_type         stride_; ///< Padded row size.
+
+  static const size_type ORDERS = 6;
+};
+
+template <class ScalarType>
+template <class Trajectory>
+bool PackedQuinticSplineTrajectory<ScalarType>::init(const Trajectory& trajectory)
+{
+  clear();
+  if (trajectory.empty() || trajectory.front().empty()) {return false;}
+
+  const typename Trajectory::value_type& ref_traj = trajectory.front();
+  const size_type n_knots = ref_traj.size();
+
+  // Check that segment boundaries are shared by all joints
+  for (const typename Trajectory::value_type& joint_traj : trajectory)
+  {
+    if (joint_traj.size() != n_knots) {return false;}
+    for (size_type k = 0; k < n_knots; ++k)
+    {
+      if (joint_traj[k].size() != 1 ||
+          joint_traj[k].startTime() != ref_traj[k].startTime() ||
+          joint_traj[k].duration()  != ref_traj[k].duration())
+      {
+        return false;
+      }
+    }
+  }
+
+  const size_type lane = internal::CACHE_LINE_SIZE / sizeof(Scalar);
+  dim_    = trajectory.size();
+  stride_ = ((dim_ + lane - 1) / lane) * lane;
+
+  knots_.resize(n_knots);
+  coefs_.assign(n_knots * ORDERS * stride_, static_cast<Scalar>(0));
+  for (size_type k = 0; k < n_knots; ++k)
+  {
+    knots_[k].start_time = ref_traj[k].startTime();
+    knots_[k].duration   = ref_traj[k].duration();
+
+    Scalar* knot_coefs = &coefs_[k * ORDERS * stride_];
+    for (unsigned int j = 0; j < dim_; ++j)
+    {
+      const typename QuinticSplineSegment<Scalar>::SplineCoefficients& coefs = trajectory[j][k].coefficients(0);
+      for (size_type order = 0; order < ORDERS; ++order) {knot_coefs[order * stride_ + j] = coefs[order];}
+    }
+  }
+  return true;
+}
+
+template <class ScalarType>
+typename PackedQuinticSplineTrajectory<ScalarType>::size_type
+PackedQuinticSplineTrajectory<ScalarType>::sample(const Time& time, State& state, size_type& cursor) const
+{
+  state.position.resize(dim_);
+  state.velocity.resize(dim_);
+  state.acceleration.resize(dim_);
+  if (knots_.empty()) {return 0;}
+
+  typename std::vector<Knot>::const_iterator hint = (cursor < knots_.size()) ? knots_.begin() + cursor
+                                                                             : knots_.begin();
+  typename std::vector<Knot>::const_iterator it = findSegment(knots_.begin(), knots_.end(), time, hint);
+  const size_type index = (it != knots_.end()) ? static_cast<size_type>(it - knots_.begin()) : knots_.size();
+  cursor = (it != knots_.end()) ? index : 0;
+
+  // Time bounds are common to all joints: same policy as QuinticSplineSegment, ie. hold start/end positions with zero
+  // velocity and acceleration outside the segment time interval
+  const Knot& knot = knots_[cursor];
+  Time t = time - knot.start_time;
+  bool in_bounds = true;
+  if (t < 0)                  {t = 0.0;           in_bounds = false;}
+  else if (t > knot.duration) {t = knot.duration; in_bounds = false;}
+
+  const Scalar* knot_coefs = &coefs_[cursor * ORDERS * stride_];
+  QuinticSplineBatch<Scalar> batch;
+  for (size_type order = 0; order < ORDERS; ++order) {batch.coefs[order] = knot_coefs + order * stride_;}
+  batch.size = dim_;
+
+  sampleQuinticSplineBatch(batch, t, &state.position[0], &state.velocity[0], &state.acceleration[0]);
+  if (!in_bounds)
+  {
+    for (unsigned int j = 0; j < dim_; ++j)
+    {
+      state.velocity[j]     = 0.0;
+      state.acceleration[j] = 0.0;
+    }
+  }
+  return index;
+}
+
+} // namespace
+
+#endif // header guard
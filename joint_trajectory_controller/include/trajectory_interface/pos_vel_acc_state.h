@@ -32,6 +32,7 @@
 #ifndef TRAJECTORY_INTERFACE_POS_VEL_ACC_STATE_H
 #define TRAJECTORY_INTERFACE_POS_VEL_ACC_STATE_H
 
+#include <array>
 #include <vector>
 
 namespace trajectory_interface
@@ -72,6 +73,34 @@ struct PosVelAccState
   std::vector<Scalar> acceleration;
 };
 
+/**
+ * \brief Fixed-dimension trajectory state containing position, velocity and acceleration data.
+ *
+ * Unlike \ref PosVelAccState, data is stored inline, so instances never allocate memory. Values are set to zero on
+ * construction.
+ *
+ * \note Since the dimension of every member is fixed, a state of this type always specifies positions, velocities and
+ * accelerations.
+ *
+ * \tparam Dim State dimension.
+ */
+template <class ScalarType, unsigned int Dim>
+struct FixedPosVelAccState
+{
+  typedef ScalarType Scalar;
+
+  FixedPosVelAccState()
+  {
+    position.fill(static_cast<Scalar>(0));
+    velocity.fill(static_cast<Scalar>(0));
+    acceleration.fill(static_cast<Scalar>(0));
+  }
+
+  std::array<Scalar, Dim> position;
+  std::array<Scalar, Dim> velocity;
+  std::array<Scalar, Dim> acceleration;
+};
+
 } // namespace
 
 #endif // header guard
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRAJECTORY_INTERFACE_QUINTIC_SPLINE_BATCH_H
+#define TRAJECTORY_INTERFACE_QUINTIC_SPLINE_BATCH_H
+
+#include <cstddef>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define TRAJECTORY_INTERFACE_BATCH_AVX2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TRAJECTORY_INTERFACE_BATCH_NEON
+#endif
+
+namespace trajectory_interface
+{
+
+/**
+ * \brief Quintic polynomial coefficients of several splines sharing the same time parametrization.
+ *
+ * Coefficients are stored in six rows, one per polynomial order: \p coefs[i][j] is the order-\p i coefficient of the
+ * \p j -th spline.
+ */
+template <class Scalar>
+struct QuinticSplineBatch
+{
+  const Scalar* coefs[6];
+  std::size_t   size; ///< Number of splines.
+};
+
+namespace internal
+{
+
+/** Portable batch evaluation kernel, also used for the elements not covered by vector instructions. */
+template <class Scalar>
+inline void sampleQuinticSplineBatchScalar(const QuinticSplineBatch<Scalar>& batch, std::size_t first,
+                                           const Scalar& t, Scalar* position, Scalar* velocity, Scalar* acceleration)
+{
+  const Scalar* const* c = batch.coefs;
+  for (std::size_t j = first; j < batch.size; ++j)
+  {
+    // Horner's scheme
+    position[j]     = c[0][j] + t*(c[1][j] + t*(c[2][j] + t*(c[3][j] + t*(c[4][j] + t*c[5][j]))));
+    velocity[j]     = c[1][j] + t*(2.0*c[2][j] + t*(3.0*c[3][j] + t*(4.0*c[4][j] + t*(5.0*c[5][j]))));
+    acceleration[j] = 2.0*c[2][j] + t*(6.0*c[3][j] + t*(12.0*c[4][j] + t*(20.0*c[5][j])));
+  }
+}
+
+/** \return Number of leading elements of \p batch evaluated with vector instructions. */
+template <class Scalar>
+inline std::size_t sampleQuinticSplineBatchSimd(const QuinticSplineBatch<Scalar>& /*batch*/, const Scalar& /*t*/,
+                                                Scalar* /*position*/, Scalar* /*velocity*/, Scalar* /*acceleration*/)
+{
+  return 0; // No vectorized implementation for this scalar type
+}
+
+#if defined(TRAJECTORY_INTERFACE_BATCH_AVX2)
+template <>
+inline std::size_t sampleQuinticSplineBatchSimd<double>(const QuinticSplineBatch<double>& batch, const double& t,
+                                                        double* position, double* velocity, double* acceleration)
+{
+  const double* const* c = batch.coefs;
+  const __m256d vt  = _mm256_set1_pd(t);
+  const __m256d k2  = _mm256_set1_pd(2.0);
+  const __m256d k3  = _mm256_set1_pd(3.0);
+  const __m256d k4  = _mm256_set1_pd(4.0);
+  const __m256d k5  = _mm256_set1_pd(5.0);
+  const __m256d k6  = _mm256_set1_pd(6.0);
+  const __m256d k12 = _mm256_set1_pd(12.0);
+  const __m256d k20 = _mm256_set1_pd(20.0);
+
+  std::size_t j = 0;
+  for (; j + 4 <= batch.size; j += 4)
+  {
+    const __m256d c0 = _mm256_loadu_pd(c[0] + j);
+    const __m256d c1 = _mm256_loadu_pd(c[1] + j);
+    const __m256d c2 = _mm256_loadu_pd(c[2] + j);
+    const __m256d c3 = _mm256_loadu_pd(c[3] + j);
+    const __m256d c4 = _mm256_loadu_pd(c[4] + j);
+    const __m256d c5 = _mm256_loadu_pd(c[5] + j);
+
+    __m256d pos = _mm256_fmadd_pd(vt, c5, c4);
+    pos = _mm256_fmadd_pd(vt, pos, c3);
+    pos = _mm256_fmadd_pd(vt, pos, c2);
+    pos = _mm256_fmadd_pd(vt, pos, c1);
+    pos = _mm256_fmadd_pd(vt, pos, c0);
+
+    __m256d vel = _mm256_fmadd_pd(vt, _mm256_mul_pd(k5, c5), _mm256_mul_pd(k4, c4));
+    vel = _mm256_fmadd_pd(vt, vel, _mm256_mul_pd(k3, c3));
+    vel = _mm256_fmadd_pd(vt, vel, _mm256_mul_pd(k2, c2));
+    vel = _mm256_fmadd_pd(vt, vel, c1);
+
+    __m256d acc = _mm256_fmadd_pd(vt, _mm256_mul_pd(k20, c5), _mm256_mul_pd(k12, c4));
+    acc = _mm256_fmadd_pd(vt, acc, _mm256_mul_pd(k6, c3));
+    acc = _mm256_fmadd_pd(vt, acc, _mm256_mul_pd(k2, c2));
+
+    _mm256_storeu_pd(position + j, pos);
+    _mm256_storeu_pd(velocity + j, vel);
+    _mm256_storeu_pd(acceleration + j, acc);
+  }
+  return j;
+}
+#elif defined(TRAJECTORY_INTERFACE_BATCH_NEON)
+template <>
+inline std::size_t sampleQuinticSplineBatchSimd<double>(const QuinticSplineBatch<double>& batch, const double& t,
+                                                        double* position, double* velocity, double* acceleration)
+{
+  const double* const* c = batch.coefs;
+  const float64x2_t vt = vdupq_n_f64(t);
+
+  std::size_t j = 0;
+  for (; j + 2 <= batch.size; j += 2)
+  {
+    const float64x2_t c0 = vld1q_f64(c[0] + j);
+    const float64x2_t c1 = vld1q_f64(c[1] + j);
+    const float64x2_t c2 = vld1q_f64(c[2] + j);
+    const float64x2_t c3 = vld1q_f64(c[3] + j);
+    const float64x2_t c4 = vld1q_f64(c[4] + j);
+    const float64x2_t c5 = vld1q_f64(c[5] + j);
+
+    // vfmaq_f64(a, b, c) computes a + b*c
+    float64x2_t pos = vfmaq_f64(c4, vt, c5);
+    pos = vfmaq_f64(c3, vt, pos);
+    pos = vfmaq_f64(c2, vt, pos);
+    pos = vfmaq_f64(c1, vt, pos);
+    pos = vfmaq_f64(c0, vt, pos);
+
+    float64x2_t vel = vfmaq_f64(vmulq_n_f64(c4, 4.0), vt, vmulq_n_f64(c5, 5.0));
+    vel = vfmaq_f64(vmulq_n_f64(c3, 3.0), vt, vel);
+    vel = vfmaq_f64(vmulq_n_f64(c2, 2.0), vt, vel);
+    vel = vfmaq_f64(c1, vt, vel);
+
+    float64x2_t acc = vfmaq_f64(vmulq_n_f64(c4, 12.0), vt, vmulq_n_f64(c5, 20.0));
+    acc = vfmaq_f64(vmulq_n_f64(c3, 6.0), vt, acc);
+    acc = vfmaq_f64(vmulq_n_f64(c2, 2.0), vt, acc);
+
+    vst1q_f64(position + j, pos);
+    vst1q_f64(velocity + j, vel);
+    vst1q_f64(acceleration + j, acc);
+  }
+  return j;
+}
+#endif
+
+} // namespace
+
+/**
+ * \brief Sample a batch of quintic splines at the same (segment-relative) time.
+ *
+ * Splines are evaluated with Horner's scheme. When the build targets AVX2 (with FMA) or aarch64 NEON, several splines
+ * are evaluated per instruction; otherwise, or for the remaining elements, a portable implementation is used.
+ * Vector instructions are only used for \p double scalars, and results may differ from the portable implementation in
+ * the last bits due to fused multiply-add operations.
+ *
+ * \param[in] batch Splines to sample.
+ * \param[in] t Sampling time, relative to the start of the splines.
+ * \param[out] position Spline values. Must have room for \p batch.size elements.
+ * \param[out] velocity Spline first derivatives. Must have room for \p batch.size elements.
+ * \param[out] acceleration Spline second derivatives. Must have room for \p batch.size elements.
+ *
+ * \note This function is realtime-safe.
+ */
+template <class Scalar>
+inline void sampleQuinticSplineBatch(const QuinticSplineBatch<Scalar>& batch, const Scalar& t,
+                                     Scalar* position, Scalar* velocity, Scalar* acceleration)
+{
+  const std::size_t first = internal::sampleQuinticSplineBatchSimd(batch, t, position, velocity, acceleration);
+  internal::sampleQuinticSplineBatchScalar(batch, first, t, position, velocity, acceleration);
+}
+
+/** \return True if \ref sampleQuinticSplineBatch uses vector instructions for \p double scalars in this build. */
+inline bool isQuinticSplineBatchVectorized()
+{
+#if defined(TRAJECTORY_INTERFACE_BATCH_AVX2) || defined(TRAJECTORY_INTERFACE_BATCH_NEON)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+#endif // header guard
@@ -31,10 +31,10 @@
 #ifndef TRAJECTORY_INTERFACE_QUINTIC_SPLINE_SEGMENT_H
 #define TRAJECTORY_INTERFACE_QUINTIC_SPLINE_SEGMENT_H
 
-#include <array>
 #include <iterator>
 #include <stdexcept>
-#include <trajectory_interface/pos_vel_acc_state.h>
+#include <vector>
+#include <trajectory_interface/spline_segment_storage.h>
 
 namespace trajectory_interface
 {
@@ -43,20 +43,31 @@ namespace trajectory_interface
  * \brief Class representing a multi-dimensional quintic spline segment with a start and end time.
  *
  * \tparam ScalarType Scalar type
+ * \tparam Dim Segment dimension. If zero (the default), the dimension is specified at runtime by the boundary
+ * conditions. Otherwise, the segment and its state type (\ref FixedPosVelAccState) store their data inline, and
+ * sampling neither allocates memory nor resizes the output state.
  */
-template<class ScalarType>
+template<class ScalarType, unsigned int Dim = 0>
 class QuinticSplineSegment
 {
+  typedef internal::SplineSegmentStorage<ScalarType, 6, Dim> Storage;
+
 public:
-  typedef ScalarType             Scalar;
-  typedef Scalar                 Time;
-  typedef PosVelAccState<Scalar> State;
+  typedef ScalarType              Scalar;
+  typedef Scalar                  Time;
+  typedef typename Storage::State State;
+
+  /** Coefficients represent a quintic polynomial like so:
+   *
+   * <tt> coefs[0] + coefs[1]*x + coefs[2]*x^2 + coefs[3]*x^3 + coefs[4]*x^4 + coefs[5]*x^5 </tt>
+   */
+  typedef typename Storage::SplineCoefficients SplineCoefficients;
 
   /**
    * \brief Creates an empty segment.
    *
    * \note Calling <tt> size() </tt> on an empty segment will yield zero, and sampling it will yield a state with empty
-   * data.
+   * data. Fixed-dimension segments instead yield the fixed dimension, and sample a zero state.
    */
   QuinticSplineSegment()
     : coefs_(),
@@ -96,7 +107,7 @@ public:
    * \param end_state State at time \p end_time.
    *
    * \throw std::invalid_argument If the \p end_time is earlier than \p start_time or if one of the states is
-   * uninitialized.
+   * uninitialized, or if the states dimension differs from a fixed segment dimension.
    */
   void init(const Time&  start_time,
             const State& start_state,
@@ -114,13 +125,11 @@ public:
    */
   void sample(const Time& time, State& state) const
   {
-    // Resize state data. Should be a no-op if appropriately sized
-    state.position.resize(coefs_.size());
-    state.velocity.resize(coefs_.size());
-    state.acceleration.resize(coefs_.size());
+    // Resize state data, if not fixed-size
+    Storage::resize(state, coefs_.size());
 
     // Sample each dimension
-    typedef typename std::vector<SplineCoefficients>::const_iterator ConstIterator;
+    typedef typename Coefficients::const_iterator ConstIterator;
     for(ConstIterator coefs_it = coefs_.begin(); coefs_it != coefs_.end(); ++coefs_it)
     {
       const typename std::vector<Scalar>::size_type id = std::distance(coefs_.begin(), coefs_it);
@@ -136,17 +145,22 @@ public:
   /** \return Segment end time. */
   Time endTime() const {return start_time_ + duration_;}
 
+  /** \return Segment duration. */
+  Time duration() const {return duration_;}
+
   /** \return Segment size (dimension). */
   unsigned int size() const {return coefs_.size();}
 
+  /**
+   * \return Spline coefficients of dimension \p dim, expressed in time relative to the segment start time.
+   * \pre <tt>dim < size()</tt>
+   */
+  const SplineCoefficients& coefficients(unsigned int dim) const {return coefs_[dim];}
+
 private:
-  typedef std::array<Scalar, 6> SplineCoefficients;
+  typedef typename Storage::Coefficients Coefficients;
 
-  /** Coefficients represent a quintic polynomial like so:
-   *
-   * <tt> coefs_[0] + coefs_[1]*x + coefs_[2]*x^2 + coefs_[3]*x^3 + coefs_[4]*x^4 + coefs_[5]*x^5 </tt>
-   */
-  std::vector<SplineCoefficients> coefs_;
+  Coefficients coefs_;
   Time duration_;
   Time start_time_;
 
@@ -176,8 +190,8 @@ private:
                                   Scalar& position, Scalar& velocity, Scalar& acceleration);
 };
 
-template<class ScalarType>
-void QuinticSplineSegment<ScalarType>::init(const Time&  start_time,
+template<class ScalarType, unsigned int Dim>
+void QuinticSplineSegment<ScalarType, Dim>::init(const Time&  start_time,
                                             const State& start_state,
                                             const Time&  end_time,
                                             const State& end_state)
@@ -222,9 +236,9 @@ void QuinticSplineSegment<ScalarType>::init(const Time&  start_time,
   duration_   = end_time - start_time;
 
   // Spline coefficients
-  coefs_.resize(dim);
+  Storage::resize(coefs_, dim);
 
-  typedef typename std::vector<SplineCoefficients>::iterator Iterator;
+  typedef typename Coefficients::iterator Iterator;
   if (!has_velocity)
   {
     // Linear interpolation
@@ -266,8 +280,8 @@ void QuinticSplineSegment<ScalarType>::init(const Time&  start_time,
   }
 }
 
-template<class ScalarType>
-inline void QuinticSplineSegment<ScalarType>::generatePowers(int n, const Scalar& x, Scalar* powers)
+template<class ScalarType, unsigned int Dim>
+inline void QuinticSplineSegment<ScalarType, Dim>::generatePowers(int n, const Scalar& x, Scalar* powers)
 {
   powers[0] = 1.0;
   for (int i=1; i<=n; ++i)
@@ -276,8 +290,8 @@ inline void QuinticSplineSegment<ScalarType>::generatePowers(int n, const Scalar
   }
 }
 
-template<class ScalarType>
-void QuinticSplineSegment<ScalarType>::
+template<class ScalarType, unsigned int Dim>
+void QuinticSplineSegment<ScalarType, Dim>::
 computeCoefficients(const Scalar& start_pos,
                     const Scalar& end_pos,
                     const Scalar& time,
@@ -291,8 +305,8 @@ computeCoefficients(const Scalar& start_pos,
   coefficients[5] = 0.0;
 }
 
-template<class ScalarType>
-void QuinticSplineSegment<ScalarType>::
+template<class ScalarType, unsigned int Dim>
+void QuinticSplineSegment<ScalarType, Dim>::
 computeCoefficients(const Scalar& start_pos, const Scalar& start_vel,
                     const Scalar& end_pos,   const Scalar& end_vel,
                     const Scalar& time,
@@ -319,8 +333,8 @@ computeCoefficients(const Scalar& start_pos, const Scalar& start_vel,
   coefficients[5] = 0.0;
 }
 
-template<class ScalarType>
-void QuinticSplineSegment<ScalarType>::
+template<class ScalarType, unsigned int Dim>
+void QuinticSplineSegment<ScalarType, Dim>::
 computeCoefficients(const Scalar& start_pos, const Scalar& start_vel, const Scalar& start_acc,
                     const Scalar& end_pos,   const Scalar& end_vel,   const Scalar& end_acc,
                     const Scalar& time,
@@ -352,8 +366,8 @@ computeCoefficients(const Scalar& start_pos, const Scalar& start_vel, const Scal
   }
 }
 
-template<class ScalarType>
-void QuinticSplineSegment<ScalarType>::
+template<class ScalarType, unsigned int Dim>
+void QuinticSplineSegment<ScalarType, Dim>::
 sample(const SplineCoefficients& coefficients, const Scalar& time,
        Scalar& position, Scalar& velocity, Scalar& acceleration)
 {
@@ -380,8 +394,8 @@ sample(const SplineCoefficients& coefficients, const Scalar& time,
                 20.0*t[3]*coefficients[5];
 }
 
-template<class ScalarType>
-void QuinticSplineSegment<ScalarType>::
+template<class ScalarType, unsigned int Dim>
+void QuinticSplineSegment<ScalarType, Dim>::
 sampleWithTimeBounds(const SplineCoefficients& coefficients, const Scalar& duration, const Scalar& time,
                      Scalar& position, Scalar& velocity, Scalar& acceleration)
 {
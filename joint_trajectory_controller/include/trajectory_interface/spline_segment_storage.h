@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRAJECTORY_INTERFACE_SPLINE_SEGMENT_STORAGE_H
+#define TRAJECTORY_INTERFACE_SPLINE_SEGMENT_STORAGE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <trajectory_interface/pos_vel_acc_state.h>
+
+namespace trajectory_interface
+{
+
+namespace internal
+{
+
+/**
+ * \brief Storage of polynomial segments with a fixed dimension: Data is stored inline, and never resized.
+ *
+ * \tparam NumCoefs Number of polynomial coefficients per dimension, i.e. the polynomial order plus one.
+ */
+template<class Scalar, std::size_t NumCoefs, unsigned int Dim>
+struct SplineSegmentStorage
+{
+  typedef std::array<Scalar, NumCoefs>            SplineCoefficients;
+  typedef FixedPosVelAccState<Scalar, Dim>        State;
+  typedef std::array<SplineCoefficients, Dim>     Coefficients;
+
+  static void resize(Coefficients& /*coefs*/, unsigned int dim)
+  {
+    if (dim != Dim)
+    {
+      throw(std::invalid_argument("Spline segment can't be constructed: Endpoint and segment size mismatch."));
+    }
+  }
+
+  static void resize(State& /*state*/, unsigned int /*dim*/) {}
+};
+
+/**
+ * \brief Sequence container that stores up to \p N elements inline, and moves to the heap for larger sizes.
+ *
+ * Used for the spline coefficients of segments with a runtime dimension, which is often one (e.g. per-joint
+ * trajectories). Such segments can then be created, copied and destroyed without memory allocations.
+ */
+template<class T, std::size_t N>
+class SmallVector
+{
+public:
+  typedef T*          iterator;
+  typedef const T*    const_iterator;
+  typedef std::size_t size_type;
+
+  SmallVector() : size_(0) {}
+
+  SmallVector(const SmallVector& other) : size_(0) {*this = other;}
+
+  SmallVector(SmallVector&& other) : size_(0) {*this = std::move(other);}
+
+  SmallVector& operator=(const SmallVector& other)
+  {
+    if (this != &other)
+    {
+      resize(other.size_);
+      std::copy(other.begin(), other.end(), begin());
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other)
+  {
+    if (this == &other) {return *this;}
+    if (other.size_ > N)
+    {
+      heap_.swap(other.heap_);
+      size_ = other.size_;
+    }
+    else {*this = static_cast<const SmallVector&>(other);}
+    other.heap_.clear();
+    other.size_ = 0;
+    return *this;
+  }
+
+  /** \brief Resize the container, preserving the values of existing elements. */
+  void resize(size_type size)
+  {
+    if (size > N)
+    {
+      if (size_ <= N) {heap_.assign(inline_.begin(), inline_.begin() + size_);}
+      heap_.resize(size);
+    }
+    else if (size_ > N)
+    {
+      std::copy(heap_.begin(), heap_.begin() + size, inline_.begin());
+      heap_.clear();
+    }
+    size_ = size;
+  }
+
+  size_type size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+
+  T*       data()       {return size_ > N ? heap_.data() : inline_.data();}
+  const T* data() const {return size_ > N ? heap_.data() : inline_.data();}
+
+  iterator       begin()       {return data();}
+  const_iterator begin() const {return data();}
+  iterator       end()         {return data() + size_;}
+  const_iterator end()   const {return data() + size_;}
+
+  T&       operator[](size_type i)       {return data()[i];}
+  const T& operator[](size_type i) const {return data()[i];}
+
+private:
+  std::array<T, N> inline_;
+  std::vector<T>   heap_;
+  size_type        size_;
+};
+
+/**
+ * \brief Storage of polynomial segments with a dimension specified at runtime.
+ *
+ * Single-dimension coefficients are stored inline.
+ */
+template<class Scalar, std::size_t NumCoefs>
+struct SplineSegmentStorage<Scalar, NumCoefs, 0>
+{
+  typedef std::array<Scalar, NumCoefs>            SplineCoefficients;
+  typedef PosVelAccState<Scalar>                  State;
+  typedef SmallVector<SplineCoefficients, 1>      Coefficients;
+
+  static void resize(Coefficients& coefs, unsigned int dim) {coefs.resize(dim);}
+
+  static void resize(State& state, unsigned int dim)
+  {
+    // Should be a no-op if appropriately sized
+    state.position.resize(dim);
+    state.velocity.resize(dim);
+    state.acceleration.resize(dim);
+  }
+};
+
+} // namespace
+
+} // namespace
+
+#endif // header guard
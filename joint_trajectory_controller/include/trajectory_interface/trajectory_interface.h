@@ -58,6 +58,9 @@ inline bool isBeforeSegment(const Time& time, const Segment& segment)
   return time < segment.startTime();
 }
 
+/** Maximum number of segments walked forward from a search hint before falling back to binary search. */
+const unsigned int MAX_HINT_STEPS = 4;
+
 } // namespace
 
 /**
@@ -85,6 +88,48 @@ inline TrajectoryIterator findSegment(TrajectoryIterator first, TrajectoryIterat
          : --std::upper_bound(first, last, time, internal::isBeforeSegment<Time, Segment>); // Notice decrement operator
 }
 
+/**
+ * \brief Find an iterator to the segment containing a specified \p time, starting the search at \p hint.
+ *
+ * Control loops sample trajectories at monotonically increasing times, so the segment containing \p time is usually
+ * the one found in the previous cycle, or one shortly after it. This overload checks \p hint and walks forward a few
+ * segments from it, and only falls back to binary search when \p time jumps backwards or far ahead.
+ *
+ * \param first Input iterator to the initial position in the segment sequence.
+ * \param last Input iterator to the final position in the segment sequence.
+ * The range searched is <tt>[first,last)</tt>.
+ * \param time Time to search for in the range.
+ * \param hint Iterator to the segment where the search starts, typically the result of a previous search. Any value
+ * in the range <tt>[first,last]</tt> yields a correct result.
+ *
+ * \return Same as \ref findSegment(TrajectoryIterator first, TrajectoryIterator last, const Time& time) "findSegment".
+ *
+ * \pre The range <tt>[first,last)</tt> should be sorted by segment start time.
+ *
+ * \note This method has amortized constant time complexity for monotonically increasing \p time values, and
+ * logarithmic time complexity otherwise when used on \b random-access iterators.
+ */
+template<class TrajectoryIterator, class Time>
+inline TrajectoryIterator findSegment(TrajectoryIterator first,
+                                      TrajectoryIterator last,
+                                      const Time&        time,
+                                      TrajectoryIterator hint)
+{
+  if (hint == last || internal::isBeforeSegment(time, *hint))
+  {
+    return findSegment(first, last, time); // Time preceeds hint, search whole range
+  }
+
+  for (unsigned int i = 0; i < internal::MAX_HINT_STEPS; ++i)
+  {
+    TrajectoryIterator next = hint;
+    ++next;
+    if (next == last || internal::isBeforeSegment(time, *next)) {return hint;}
+    hint = next;
+  }
+  return findSegment(hint, last, time); // Time jumped far ahead of hint
+}
+
 /**
  * \brief Find an iterator to the segment containing a specified \p time.
  *
@@ -151,6 +196,79 @@ inline typename Trajectory::const_iterator sample(const Trajectory&
   return it;
 }
 
+/**
+ * \brief Sample a trajectory at a specified time, using a cursor to speed up segment lookup.
+ *
+ * Equivalent to \ref sample(const Trajectory&, const typename Trajectory::value_type::Time&, typename Trajectory::value_type::State&) "sample",
+ * but the segment search starts at \p cursor, which is updated to the index of the segment containing \p time.
+ * Callers sampling a trajectory at increasing times (e.g. once per control cycle) should keep \p cursor between calls.
+ *
+ * \tparam Trajectory Trajectory type. Should be a \e random-access \e sequence container \e sorted by segment start
+ * time.
+ * \param[in] trajectory Holds a sequence of segments.
+ * \param[in] time Where the trajectory is to be sampled.
+ * \param[out] state Segment state at \p time.
+ * \param[in,out] cursor Index where the segment search starts. Any value is valid input, so the same cursor can be
+ * kept when \p trajectory is replaced. Set to zero when no segment contains \p time.
+ *
+ * \sa findSegment(TrajectoryIterator first, TrajectoryIterator last, const Time& time, TrajectoryIterator hint)
+ */
+template<class Trajectory>
+inline typename Trajectory::const_iterator sample(const Trajectory&                             trajectory,
+                                                  const typename Trajectory::value_type::Time&  time,
+                                                        typename Trajectory::value_type::State& state,
+                                                        typename Trajectory::size_type&         cursor)
+{
+  typename Trajectory::const_iterator hint = (cursor < trajectory.size()) ? trajectory.begin() + cursor
+                                                                          : trajectory.begin();
+  typename Trajectory::const_iterator it = findSegment(trajectory.begin(), trajectory.end(), time, hint);
+  if (it != trajectory.end())
+  {
+    it->sample(time, state); // Segment found at specified time
+    cursor = it - trajectory.begin();
+  }
+  else
+  {
+    if (!trajectory.empty()) {trajectory.front().sample(time, state);} // Specified time preceeds trajectory start time
+    cursor = 0;
+  }
+  return it;
+}
+
+/**
+ * \brief Sample a trajectory at several times, using a cursor to speed up segment lookup.
+ *
+ * Each time in <tt>[first,last)</tt> is sampled with
+ * \ref sample(const Trajectory&, const typename Trajectory::value_type::Time&, typename Trajectory::value_type::State&, typename Trajectory::size_type&) "sample",
+ * and the segment search of each starts where the previous one ended. When times are sorted in increasing order, the
+ * trajectory is walked once instead of binary-searched for every time.
+ *
+ * \tparam Trajectory Trajectory type. Should be a \e random-access \e sequence container \e sorted by segment start
+ * time.
+ * \param[in] trajectory Holds a sequence of segments.
+ * \param[in] first Input iterator to the first time to sample.
+ * \param[in] last Input iterator past the last time to sample.
+ * \param[out] states Output iterator to the states written for each time, in order.
+ * \param[in,out] cursor Index where the first segment search starts, updated as in \ref sample.
+ *
+ * \return True if every time is contained in a segment of \p trajectory. Times that precede the trajectory start
+ * time are still sampled, as in \ref sample.
+ */
+template<class Trajectory, class TimeIterator, class StateIterator>
+inline bool sampleTimes(const Trajectory&               trajectory,
+                        TimeIterator                    first,
+                        TimeIterator                    last,
+                        StateIterator                   states,
+                        typename Trajectory::size_type& cursor)
+{
+  bool all_found = true;
+  for (; first != last; ++first, ++states)
+  {
+    all_found = (sample(trajectory, *first, *states, cursor) != trajectory.end()) && all_found;
+  }
+  return all_found;
+}
+
 } // namespace
 
 #endif // header guard
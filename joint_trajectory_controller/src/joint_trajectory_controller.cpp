@@ -30,6 +30,8 @@
 #include <pluginlib/class_list_macros.hpp>
 
 // Project
+#include <trajectory_interface/cubic_spline_segment.h>
+#include <trajectory_interface/linear_segment.h>
 #include <trajectory_interface/quintic_spline_segment.h>
 #include <joint_trajectory_controller/joint_trajectory_controller.h>
 
@@ -42,6 +44,36 @@ namespace position_controllers
   typedef joint_trajectory_controller::JointTrajectoryController<trajectory_interface::QuinticSplineSegment<double>,
                                                                  hardware_interface::PositionJointInterface>
           JointTrajectoryController;
+
+  /**
+   * \brief Joint trajectory controller that represents trajectory segments as <b>quintic splines</b> and sends
+   * commands to a \b position interface, for a number of joints \p N fixed at compile time.
+   */
+  template <unsigned int N>
+  using FixedJointTrajectoryController =
+      joint_trajectory_controller::JointTrajectoryController<trajectory_interface::QuinticSplineSegment<double>,
+                                                             hardware_interface::PositionJointInterface,
+                                                             N>;
+
+  typedef FixedJointTrajectoryController<6>  JointTrajectoryController6;
+  typedef FixedJointTrajectoryController<7>  JointTrajectoryController7;
+  typedef FixedJointTrajectoryController<12> JointTrajectoryController12;
+
+  /**
+   * \brief Joint trajectory controller that represents trajectory segments as <b>lines</b> and sends
+   * commands to a \b position interface. Suited to dense trajectories, it is cheaper to fit and sample.
+   */
+  typedef joint_trajectory_controller::JointTrajectoryController<trajectory_interface::LinearSegment<double>,
+                                                                 hardware_interface::PositionJointInterface>
+          JointTrajectoryControllerLinear;
+
+  /**
+   * \brief Joint trajectory controller that represents trajectory segments as <b>cubic splines</b> and sends
+   * commands to a \b position interface. Suited to dense trajectories, it is cheaper to fit and sample.
+   */
+  typedef joint_trajectory_controller::JointTrajectoryController<trajectory_interface::CubicSplineSegment<double>,
+                                                                 hardware_interface::PositionJointInterface>
+          JointTrajectoryControllerCubic;
 }
 
 namespace velocity_controllers
@@ -93,3 +125,10 @@ PLUGINLIB_EXPORT_CLASS(velocity_controllers::JointTrajectoryController, controll
 PLUGINLIB_EXPORT_CLASS(effort_controllers::JointTrajectoryController,   controller_interface::ControllerBase)
 PLUGINLIB_EXPORT_CLASS(pos_vel_controllers::JointTrajectoryController,   controller_interface::ControllerBase)
 PLUGINLIB_EXPORT_CLASS(pos_vel_acc_controllers::JointTrajectoryController,   controller_interface::ControllerBase)
+
+PLUGINLIB_EXPORT_CLASS(position_controllers::JointTrajectoryController6,  controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(position_controllers::JointTrajectoryController7,  controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(position_controllers::JointTrajectoryController12, controller_interface::ControllerBase)
+
+PLUGINLIB_EXPORT_CLASS(position_controllers::JointTrajectoryControllerLinear, controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(position_controllers::JointTrajectoryControllerCubic,  controller_interface::ControllerBase)
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/batch_pid.h>
+
+using joint_trajectory_controller::BatchPid;
+
+const double EPS = 1e-9;
+
+BatchPid::Gains makeGains(std::size_t size, double p, double i, double d, double i_max, double i_min, bool antiwindup)
+{
+  BatchPid::Gains gains;
+  gains.resize(size);
+  std::fill(gains.p.begin(),          gains.p.end(),          p);
+  std::fill(gains.i.begin(),          gains.i.end(),          i);
+  std::fill(gains.d.begin(),          gains.d.end(),          d);
+  std::fill(gains.i_max.begin(),      gains.i_max.end(),      i_max);
+  std::fill(gains.i_min.begin(),      gains.i_min.end(),      i_min);
+  std::fill(gains.antiwindup.begin(), gains.antiwindup.end(), antiwindup);
+  return gains;
+}
+
+TEST(BatchPidTest, ZeroGains)
+{
+  BatchPid pid;
+  pid.init(3);
+  EXPECT_EQ(3u, pid.size());
+
+  std::vector<double> error(3, 1.0), error_dot(3, 2.0), command(3, 5.0);
+  pid.computeCommands(error, error_dot, 0.01, command);
+  for (double value : command) {EXPECT_EQ(0.0, value);}
+}
+
+TEST(BatchPidTest, ProportionalDerivative)
+{
+  BatchPid pid;
+  pid.init(2);
+  BatchPid::Gains gains = makeGains(2, 10.0, 0.0, 1.0, 0.0, 0.0, false);
+  gains.p[1] = 20.0;
+  pid.setGains(gains);
+
+  const std::vector<double> error     = {1.0, -0.5};
+  const std::vector<double> error_dot = {0.5,  2.0};
+  std::vector<double> command(2);
+  pid.computeCommands(error, error_dot, 0.01, command);
+  EXPECT_NEAR(10.5, command[0], EPS);
+  EXPECT_NEAR(-8.0, command[1], EPS);
+
+  // Non-positive time step: Zero commands
+  pid.computeCommands(error, error_dot, 0.0, command);
+  EXPECT_EQ(0.0, command[0]);
+  EXPECT_EQ(0.0, command[1]);
+}
+
+TEST(BatchPidTest, IntegralClamp)
+{
+  const double dt = 0.1;
+  const std::vector<double> error(2, 1.0), error_dot(2, 0.0);
+  std::vector<double> command(2);
+
+  // Without antiwindup the integral term is clamped, but the integrator keeps growing
+  {
+    BatchPid pid;
+    pid.init(2);
+    pid.setGains(makeGains(2, 0.0, 2.0, 0.0, 1.0, -1.0, false));
+    for (unsigned int i = 0; i < 10; ++i) {pid.computeCommands(error, error_dot, dt, command);}
+    EXPECT_NEAR(1.0, command[0], EPS);
+
+    const std::vector<double> neg_error(2, -1.0);
+    pid.computeCommands(neg_error, error_dot, dt, command);
+    EXPECT_NEAR(1.0, command[0], EPS); // Integrator at 0.9: Clamped integral term 1.8
+  }
+
+  // With antiwindup the integrator is clamped
+  {
+    BatchPid pid;
+    pid.init(2);
+    pid.setGains(makeGains(2, 0.0, 2.0, 0.0, 1.0, -1.0, true));
+    for (unsigned int i = 0; i < 10; ++i) {pid.computeCommands(error, error_dot, dt, command);}
+    EXPECT_NEAR(1.0, command[0], EPS);
+
+    const std::vector<double> neg_error(2, -1.0);
+    pid.computeCommands(neg_error, error_dot, dt, command);
+    EXPECT_NEAR(0.8, command[0], EPS); // Integrator at 0.4
+  }
+
+  // Reset zeroes the integrators
+  {
+    BatchPid pid;
+    pid.init(2);
+    pid.setGains(makeGains(2, 0.0, 2.0, 0.0, 10.0, -10.0, false));
+    pid.computeCommands(error, error_dot, dt, command);
+    EXPECT_NEAR(0.2, command[0], EPS);
+    pid.reset();
+    pid.computeCommands(error, error_dot, dt, command);
+    EXPECT_NEAR(0.2, command[0], EPS);
+  }
+}
+
+TEST(BatchPidTest, InvalidError)
+{
+  BatchPid pid;
+  pid.init(2);
+  pid.setGains(makeGains(2, 1.0, 1.0, 0.0, 10.0, -10.0, false));
+
+  // Invalid inputs only affect their joint, whose integrator is left unchanged
+  std::vector<double> error = {1.0, std::numeric_limits<double>::quiet_NaN()};
+  const std::vector<double> error_dot(2, 0.0);
+  std::vector<double> command(2);
+  pid.computeCommands(error, error_dot, 1.0, command);
+  EXPECT_NEAR(2.0, command[0], EPS);
+  EXPECT_EQ(0.0, command[1]);
+
+  error[1] = 1.0;
+  pid.computeCommands(error, error_dot, 1.0, command);
+  EXPECT_NEAR(3.0, command[0], EPS);
+  EXPECT_NEAR(2.0, command[1], EPS);
+}
+
+TEST(BatchPidTest, GainsUpdate)
+{
+  BatchPid pid;
+  pid.init(1);
+  const std::vector<double> error(1, 1.0), error_dot(1, 0.0);
+  std::vector<double> command(1);
+
+  pid.setGains(makeGains(1, 1.0, 0.0, 0.0, 0.0, 0.0, false));
+  pid.computeCommands(error, error_dot, 0.01, command);
+  EXPECT_NEAR(1.0, command[0], EPS);
+
+  // Several updates between cycles: The latest one is used
+  pid.setGains(makeGains(1, 2.0, 0.0, 0.0, 0.0, 0.0, false));
+  pid.setGains(makeGains(1, 3.0, 0.0, 0.0, 0.0, 0.0, false));
+  pid.computeCommands(error, error_dot, 0.01, command);
+  EXPECT_NEAR(3.0, command[0], EPS);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2013, PAL Robotics S.L.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of PAL Robotics S.L. nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <gtest/gtest.h>
+#include <trajectory_interface/cubic_spline_segment.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+
+using namespace trajectory_interface;
+
+// Floating-point value comparison threshold
+const double EPS = 1e-9;
+
+typedef CubicSplineSegment<double> Segment;
+typedef typename Segment::State State;
+typedef typename Segment::Time  Time;
+
+typedef CubicSplineSegment<double, 2> FixedSegment;
+typedef typename FixedSegment::State FixedState;
+
+typedef QuinticSplineSegment<double> QuinticSegment;
+
+namespace
+{
+
+/** Expect that \p segment samples like the quintic spline with the same boundary conditions. */
+void expectQuinticSamples(const Time& start_time, const State& start_state, const Time& end_time, const State& end_state)
+{
+  const Segment        cubic(start_time, start_state, end_time, end_state);
+  const QuinticSegment quintic(start_time, start_state, end_time, end_state);
+
+  const Time duration = end_time - start_time;
+  for (Time time = start_time - 0.5 * duration; time <= end_time + 0.5 * duration; time += duration / 16.0)
+  {
+    State cubic_state;
+    State quintic_state;
+    cubic.sample(time, cubic_state);
+    quintic.sample(time, quintic_state);
+    ASSERT_EQ(quintic_state.position.size(), cubic_state.position.size());
+    for (unsigned int i = 0; i < cubic_state.position.size(); ++i)
+    {
+      EXPECT_NEAR(quintic_state.position[i],     cubic_state.position[i],     EPS);
+      EXPECT_NEAR(quintic_state.velocity[i],     cubic_state.velocity[i],     EPS);
+      EXPECT_NEAR(quintic_state.acceleration[i], cubic_state.acceleration[i], EPS);
+    }
+  }
+}
+
+} // namespace
+
+TEST(CubicSplineSegmentTest, InvalidSegmentConstruction)
+{
+  State valid_state(1);
+  const Time start_time     = 1.0;
+  const Time valid_end_time = 2.0;
+
+  State empty_state;
+  EXPECT_THROW(Segment(start_time, empty_state, valid_end_time, valid_state), std::invalid_argument);
+  EXPECT_THROW(Segment(start_time, valid_state, valid_end_time, empty_state), std::invalid_argument);
+
+  State bad_size_state(2);
+  EXPECT_THROW(Segment(start_time, bad_size_state, valid_end_time, valid_state), std::invalid_argument);
+
+  State bad_vel_state = valid_state;
+  bad_vel_state.velocity.push_back(0.0);
+  EXPECT_THROW(Segment(start_time, bad_vel_state, valid_end_time, valid_state), std::invalid_argument);
+  EXPECT_THROW(Segment(start_time, valid_state, valid_end_time, bad_vel_state), std::invalid_argument);
+
+  EXPECT_THROW(Segment(start_time, valid_state, -1.0, valid_state), std::invalid_argument);
+
+  // Accelerations are ignored, so their sizes are not checked
+  State bad_acc_state = valid_state;
+  bad_acc_state.acceleration.push_back(0.0);
+  EXPECT_NO_THROW(Segment(start_time, bad_acc_state, valid_end_time, valid_state));
+}
+
+TEST(CubicSplineSegmentTest, ZeroDurationSampler)
+{
+  State start_state(1);
+  start_state.position[0] = 1.0;
+  start_state.velocity[0] = 2.0;
+  State end_state(1);
+  end_state.position[0] = 2.0;
+
+  Segment segment(1.0, start_state, 1.0, end_state);
+  State state;
+  segment.sample(1.0, state);
+  EXPECT_NEAR(start_state.position[0], state.position[0], EPS);
+  EXPECT_NEAR(start_state.velocity[0], state.velocity[0], EPS);
+  EXPECT_NEAR(0.0, state.acceleration[0], EPS);
+}
+
+TEST(CubicSplineSegmentTest, PosVelEnpointsSampler)
+{
+  // Start and end state taken from x^3 - 2x
+  const Time start_time = 1.0;
+  State start_state(1);
+  start_state.position[0] =  0.0;
+  start_state.velocity[0] = -2.0;
+
+  const Time end_time = 3.0;
+  State end_state(1);
+  end_state.position[0]     =  4.0;
+  end_state.velocity[0]     = 10.0;
+  end_state.acceleration[0] = 50.0; // Should be ignored
+
+  Segment segment(start_time, start_state, end_time, end_state);
+
+  // Sample at mid-segment: Zero-crossing
+  State state;
+  segment.sample(start_time + std::sqrt(2.0), state);
+  EXPECT_NEAR(0.0, state.position[0], EPS);
+  EXPECT_NEAR(4.0, state.velocity[0], EPS);
+  EXPECT_NEAR(6.0 * std::sqrt(2.0), state.acceleration[0], EPS);
+
+  // Sample at segment end
+  segment.sample(end_time, state);
+  EXPECT_NEAR(end_state.position[0], state.position[0], EPS);
+  EXPECT_NEAR(end_state.velocity[0], state.velocity[0], EPS);
+  EXPECT_NEAR(12.0, state.acceleration[0], EPS);
+}
+
+TEST(CubicSplineSegmentTest, MatchesQuinticSplineWithoutAccelerations)
+{
+  // Quintic splines fall back to cubic interpolation when accelerations are not specified
+  State start_state(2);
+  start_state.position[0] =  1.0;
+  start_state.position[1] = -2.0;
+  start_state.velocity[0] =  0.5;
+  start_state.velocity[1] = -1.5;
+  start_state.acceleration.clear();
+  State end_state(2);
+  end_state.position[0] = -3.0;
+  end_state.position[1] =  0.5;
+  end_state.velocity[0] =  2.0;
+  end_state.velocity[1] =  0.0;
+  end_state.acceleration.clear();
+  expectQuinticSamples(0.5, start_state, 2.5, end_state);
+
+  // ...and to linear interpolation when velocities are not specified either
+  start_state.velocity.clear();
+  expectQuinticSamples(0.5, start_state, 2.5, end_state);
+}
+
+TEST(CubicSplineSegmentTest, FixedDimension)
+{
+  FixedState start_state;
+  start_state.position[0] = 1.0;
+  start_state.velocity[1] = 1.0;
+  FixedState end_state;
+  end_state.position[0] = 3.0;
+  end_state.position[1] = 1.0;
+
+  FixedSegment segment(0.0, start_state, 2.0, end_state);
+  EXPECT_EQ(2u, segment.size());
+
+  State dynamic_start_state(2);
+  State dynamic_end_state(2);
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    dynamic_start_state.position[i] = start_state.position[i];
+    dynamic_start_state.velocity[i] = start_state.velocity[i];
+    dynamic_end_state.position[i]   = end_state.position[i];
+  }
+  const Segment dynamic_segment(0.0, dynamic_start_state, 2.0, dynamic_end_state);
+
+  FixedState state;
+  State dynamic_state;
+  segment.sample(0.75, state);
+  dynamic_segment.sample(0.75, dynamic_state);
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    EXPECT_NEAR(dynamic_state.position[i],     state.position[i],     EPS);
+    EXPECT_NEAR(dynamic_state.velocity[i],     state.velocity[i],     EPS);
+    EXPECT_NEAR(dynamic_state.acceleration[i], state.acceleration[i], EPS);
+  }
+
+  // Trivially copyable types can't own heap memory: Segments store all their data inline
+  EXPECT_TRUE(std::is_trivially_copyable<FixedSegment>::value);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/deferred_deleter.h>
+
+using joint_trajectory_controller::DeferredDeleter;
+
+typedef DeferredDeleter<int> Deleter;
+
+struct DestructionTracker
+{
+  DestructionTracker(std::thread::id& id) : destroyer_id(id) {}
+  ~DestructionTracker() {destroyer_id = std::this_thread::get_id();}
+  std::thread::id& destroyer_id;
+};
+
+void waitForReleases(const DeferredDeleter<DestructionTracker>& deleter)
+{
+  const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (deleter.pending() > 0 && std::chrono::steady_clock::now() < timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(DeferredDeleterTest, IgnoreNull)
+{
+  Deleter deleter;
+  deleter.retire(Deleter::Ptr());
+  EXPECT_EQ(0u, deleter.pending());
+}
+
+TEST(DeferredDeleterTest, ReleaseInBackground)
+{
+  std::thread::id destroyer_id;
+  DeferredDeleter<DestructionTracker> deleter;
+
+  std::weak_ptr<DestructionTracker> weak;
+  {
+    std::shared_ptr<DestructionTracker> ptr(new DestructionTracker(destroyer_id));
+    weak = ptr;
+    deleter.retire(std::move(ptr));
+  }
+  waitForReleases(deleter);
+
+  EXPECT_EQ(0u, deleter.pending());
+  EXPECT_TRUE(weak.expired());
+  EXPECT_NE(std::thread::id(), destroyer_id);
+  EXPECT_NE(std::this_thread::get_id(), destroyer_id);
+}
+
+TEST(DeferredDeleterTest, SharedOwnership)
+{
+  Deleter deleter;
+  Deleter::Ptr ptr(new int(1));
+  deleter.retire(ptr);
+
+  const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (deleter.pending() > 0 && std::chrono::steady_clock::now() < timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Only the reference held by the deleter is dropped
+  EXPECT_EQ(1, ptr.use_count());
+  EXPECT_EQ(1, *ptr);
+}
+
+TEST(DeferredDeleterTest, ReleaseOnDestruction)
+{
+  std::weak_ptr<int> weak;
+  {
+    Deleter deleter;
+    for (int i = 0; i < 100; ++i)
+    {
+      Deleter::Ptr ptr(new int(i));
+      weak = ptr;
+      deleter.retire(std::move(ptr));
+    }
+  }
+  EXPECT_TRUE(weak.expired());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -115,6 +115,35 @@ TEST(MappingTest, Mapping)
   }
 }
 
+TEST(MappingTest, IndexedMapping)
+{
+  vector<string> t2(4);
+  t2[0] = "A";
+  t2[1] = "B";
+  t2[2] = "C";
+  t2[3] = "D";
+  const JointNameIndex t2_index = makeJointNameIndex(t2);
+  ASSERT_EQ(t2.size(), t2_index.size());
+
+  // Indexed and linear lookups yield the same mapping vector
+  vector<vector<string> > t1_cases(5);
+  t1_cases[0] = t2;                                         // Same order
+  t1_cases[1] = vector<string>(t2.rbegin(), t2.rend());     // Reversed order
+  t1_cases[2] = vector<string>(t2.begin(), t2.begin() + 2); // Ordered partial trajectory
+  t1_cases[3].push_back("A");                               // Ordered prefix, then unordered
+  t1_cases[3].push_back("D");
+  t1_cases[3].push_back("B");
+  t1_cases[4].push_back("A");                               // Unknown element
+  t1_cases[4].push_back("E");
+  for (const vector<string>& t1 : t1_cases)
+  {
+    EXPECT_EQ(internal::mapping(t1, t2), internal::mapping(t1, t2, &t2_index));
+  }
+
+  EXPECT_EQ(vector<unsigned int>({0, 3, 1}), internal::mapping(t1_cases[3], t2, &t2_index));
+  EXPECT_TRUE(internal::mapping(t1_cases[4], t2, &t2_index).empty());
+}
+
 class InitTrajectoryTest : public ::testing::Test
 {
 public:
@@ -576,7 +605,7 @@ TEST_F(InitTrajectoryTest, WrappingSpec)
 
   // Before first point: Return 4 segments: Last of current + bridge + full message
   const ros::Time time(curr_traj[0][0].startTime());
-  std::vector<bool> angle_wraparound(1, true);
+  std::vector<char> angle_wraparound(1, true);
   InitJointTrajectoryOptions<Trajectory> options;
   options.current_trajectory = &curr_traj;
   options.angle_wraparound      = &angle_wraparound;
@@ -694,7 +723,7 @@ TEST_F(InitTrajectoryTest, WrappingSpec)
 
   // Reference joint names size mismatch
   {
-    std::vector<bool> angle_wraparound(2, true);
+    std::vector<char> angle_wraparound(2, true);
     InitJointTrajectoryOptions<Trajectory> options;
     options.current_trajectory = &curr_traj;
     options.angle_wraparound      = &angle_wraparound;
@@ -719,7 +748,7 @@ TEST_F(InitTrajectoryTest, IgnoreWrappingSpec)
 
   // Before first point: Return 2 segments: Full message
   const ros::Time time(curr_traj[0][0].startTime());
-  std::vector<bool> angle_wraparound(1, true);
+  std::vector<char> angle_wraparound(1, true);
   InitJointTrajectoryOptions<Trajectory> options;
   options.angle_wraparound = &angle_wraparound;
 
@@ -791,6 +820,49 @@ TEST_F(InitTrajectoryTest, GoalHandleTest)
   }
 }
 
+TEST_F(InitTrajectoryTest, SharedTolerancesTest)
+{
+  typedef actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction>                  ActionServer;
+  typedef ActionServer::GoalHandle                                                            GoalHandle;
+  typedef realtime_tools::RealtimeServerGoalHandle<control_msgs::FollowJointTrajectoryAction> RealtimeGoalHandle;
+  typedef boost::shared_ptr<RealtimeGoalHandle>                                               RealtimeGoalHandlePtr;
+
+  GoalHandle gh;
+  RealtimeGoalHandlePtr rt_goal(new RealtimeGoalHandle(gh));
+
+  SegmentTolerances<double> default_tolerances(1);
+  default_tolerances.state_tolerance[0]      = StateTolerances<double>(1.0, 2.0, 3.0);
+  default_tolerances.goal_state_tolerance[0] = StateTolerances<double>(4.0, 5.0, 6.0);
+  default_tolerances.goal_time_tolerance     = 7.0;
+
+  const ros::Time time(curr_traj[0][0].startTime());
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory = &curr_traj;
+  options.rt_goal_handle     = rt_goal;
+  options.default_tolerances = &default_tolerances;
+
+  Trajectory trajectory = initJointTrajectory<Trajectory>(trajectory_msg, time, options);
+  ASSERT_EQ(points.size() + 1, trajectory[0].size());
+
+  // Segment of current trajectory has no tolerances
+  EXPECT_EQ(0.0, trajectory[0][0].getTolerances().state_tolerance.position);
+  EXPECT_EQ(0.0, trajectory[0][0].getTolerances().goal_time_tolerance);
+
+  // All further segments refer to the same tolerances
+  const SegmentTolerancesPerJoint<double>& tolerances = trajectory[0][1].getTolerances();
+  EXPECT_EQ(1.0, tolerances.state_tolerance.position);
+  EXPECT_EQ(2.0, tolerances.state_tolerance.velocity);
+  EXPECT_EQ(3.0, tolerances.state_tolerance.acceleration);
+  EXPECT_EQ(4.0, tolerances.goal_state_tolerance.position);
+  EXPECT_EQ(5.0, tolerances.goal_state_tolerance.velocity);
+  EXPECT_EQ(6.0, tolerances.goal_state_tolerance.acceleration);
+  EXPECT_EQ(7.0, tolerances.goal_time_tolerance);
+  for (unsigned int i = 2; i < trajectory[0].size(); ++i)
+  {
+    EXPECT_EQ(&tolerances, &trajectory[0][i].getTolerances());
+  }
+}
+
 TEST_F(InitTrajectoryTest, OtherTimeBase)
 {
   const ros::Time msg_start_time = trajectory_msg.header.stamp;
@@ -858,6 +930,453 @@ TEST_F(InitTrajectoryTest, OtherTimeBase)
   }
 }
 
+void expectSameTrajectory(const Trajectory& expected, const Trajectory& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (unsigned int joint_id = 0; joint_id < expected.size(); ++joint_id)
+  {
+    ASSERT_EQ(expected[joint_id].size(), actual[joint_id].size());
+    for (unsigned int i = 0; i < expected[joint_id].size(); ++i)
+    {
+      const Segment& ref_segment = expected[joint_id][i];
+      const Segment& segment     = actual[joint_id][i];
+      EXPECT_NEAR(ref_segment.startTime(), segment.startTime(), EPS);
+      EXPECT_NEAR(ref_segment.endTime(),   segment.endTime(),   EPS);
+      EXPECT_EQ(ref_segment.getGoalHandle(), segment.getGoalHandle());
+
+      const double times[] = {segment.startTime(), 0.5 * (segment.startTime() + segment.endTime()), segment.endTime()};
+      for (double time : times)
+      {
+        typename Segment::State ref_state, state;
+        ref_segment.sample(time, ref_state);
+        segment.sample(time, state);
+        EXPECT_NEAR(ref_state.position[0],     state.position[0],     EPS);
+        EXPECT_NEAR(ref_state.velocity[0],     state.velocity[0],     EPS);
+        EXPECT_NEAR(ref_state.acceleration[0], state.acceleration[0], EPS);
+      }
+    }
+  }
+}
+
+TEST_F(InitTrajectoryTest, AppendMatchesInit)
+{
+  const ros::Time msg_start_time = trajectory_msg.header.stamp;
+  std::vector<char> angle_wraparound(1, true);
+  for (unsigned int i = 0; i < trajectory_msg.points.size(); ++i)
+  {
+    trajectory_msg.points[i].positions[0] += 4 * M_PI; // Exercise wraparound offsets
+  }
+
+  const ros::Time times[] = {ros::Time(curr_traj[0][0].startTime()),                               // Before first point
+                             msg_start_time + points[0].time_from_start + ros::Duration(0.5)}; // Between points
+  for (const ros::Time& time : times)
+  {
+    InitJointTrajectoryOptions<Trajectory> options;
+    options.current_trajectory = &curr_traj;
+    options.angle_wraparound   = &angle_wraparound;
+
+    const Trajectory ref_trajectory = initJointTrajectory<Trajectory>(trajectory_msg, time, options);
+    Trajectory trajectory;
+    EXPECT_TRUE(appendJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory));
+    expectSameTrajectory(ref_trajectory, trajectory);
+  }
+
+  // No current trajectory
+  {
+    const ros::Time time(0.0);
+    const Trajectory ref_trajectory = initJointTrajectory<Trajectory>(trajectory_msg, time);
+    Trajectory trajectory;
+    EXPECT_TRUE(appendJointTrajectory<Trajectory>(trajectory_msg, time, InitJointTrajectoryOptions<Trajectory>(),
+                                                  trajectory));
+    expectSameTrajectory(ref_trajectory, trajectory);
+  }
+}
+
+TEST_F(InitTrajectoryTest, StartTimeOverridesStamp)
+{
+  // Start the message where the current trajectory ends, as if it was stamped with that time
+  const ros::Time start_time(curr_traj[0].back().endTime());
+  const ros::Time time(curr_traj[0][0].startTime());
+
+  trajectory_msgs::JointTrajectory stamped_msg = trajectory_msg;
+  stamped_msg.header.stamp = start_time;
+
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory = &curr_traj;
+  const Trajectory ref_trajectory = initJointTrajectory<Trajectory>(stamped_msg, time, options);
+
+  options.start_time = &start_time;
+  const Trajectory trajectory = initJointTrajectory<Trajectory>(trajectory_msg, time, options);
+  expectSameTrajectory(ref_trajectory, trajectory);
+  ASSERT_FALSE(trajectory[0].empty());
+  EXPECT_NEAR((start_time + points.back().time_from_start).toSec(), trajectory[0].back().endTime(), EPS);
+}
+
+TEST_F(InitTrajectoryTest, ParallelFitMatchesSequential)
+{
+  // Add extra joints to the trajectory message created in the fixture
+  const unsigned int joints = 4;
+  for (unsigned int joint_id = 1; joint_id < joints; ++joint_id)
+  {
+    for (unsigned int i = 0; i < trajectory_msg.points.size(); ++i)
+    {
+      trajectory_msg.points[i].positions.push_back(joint_id * trajectory_msg.points[i].positions[0]);
+      trajectory_msg.points[i].velocities.push_back(-trajectory_msg.points[i].velocities[0]);
+      trajectory_msg.points[i].accelerations.push_back(0.0);
+    }
+    trajectory_msg.joint_names.push_back("joint_" + std::to_string(joint_id));
+  }
+
+  vector<string> joint_names(trajectory_msg.joint_names.rbegin(), trajectory_msg.joint_names.rend());
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.joint_names = &joint_names;
+  const Trajectory ref_trajectory = initJointTrajectory<Trajectory>(trajectory_msg, trajectory_msg.header.stamp, options);
+
+  WorkerPool pool(2);
+  options.fitting_pool = &pool;
+
+  // Below the threshold: Sequential fitting
+  options.parallel_fitting_threshold = joints * trajectory_msg.points.size() + 1;
+  expectSameTrajectory(ref_trajectory,
+                       initJointTrajectory<Trajectory>(trajectory_msg, trajectory_msg.header.stamp, options));
+
+  // Above the threshold: Joints are fitted in parallel, with the same result
+  options.parallel_fitting_threshold = 0;
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    expectSameTrajectory(ref_trajectory,
+                         initJointTrajectory<Trajectory>(trajectory_msg, trajectory_msg.header.stamp, options));
+  }
+}
+
+TEST_F(InitTrajectoryTest, AppendReusesStorage)
+{
+  const ros::Time time(curr_traj[0][0].startTime());
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory = &curr_traj;
+
+  Trajectory trajectory;
+  ASSERT_TRUE(appendJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory));
+  const Segment* segments = trajectory[0].data();
+  const void*    coefs    = &trajectory[0].back().coefficients(0);
+
+  // Update with a command of the same size: No reallocations
+  trajectory_msg.points.back().positions[0] = 5.0;
+  const Trajectory ref_trajectory = initJointTrajectory<Trajectory>(trajectory_msg, time, options);
+  ASSERT_TRUE(appendJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory));
+  EXPECT_EQ(segments, trajectory[0].data());
+  EXPECT_EQ(coefs,    &trajectory[0].back().coefficients(0));
+  expectSameTrajectory(ref_trajectory, trajectory);
+
+  // Shorter command: Trailing segments are dropped
+  trajectory_msg.points.pop_back();
+  ASSERT_TRUE(appendJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory));
+  EXPECT_EQ(segments, trajectory[0].data());
+  expectSameTrajectory(initJointTrajectory<Trajectory>(trajectory_msg, time, options), trajectory);
+}
+
+TEST_F(InitTrajectoryTest, InitReusesStorage)
+{
+  const ros::Time time(curr_traj[0][0].startTime());
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory = &curr_traj;
+
+  Trajectory trajectory;
+  initJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory);
+  expectSameTrajectory(initJointTrajectory<Trajectory>(trajectory_msg, time, options), trajectory);
+  const Segment* segments = trajectory[0].data();
+
+  // Same-size update: No reallocations
+  trajectory_msg.points.back().positions[0] = 5.0;
+  initJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory);
+  EXPECT_EQ(segments, trajectory[0].data());
+  expectSameTrajectory(initJointTrajectory<Trajectory>(trajectory_msg, time, options), trajectory);
+
+  // No current trajectory: Previous contents are discarded
+  initJointTrajectory<Trajectory>(trajectory_msg, time, InitJointTrajectoryOptions<Trajectory>(), trajectory);
+  expectSameTrajectory(initJointTrajectory<Trajectory>(trajectory_msg, time), trajectory);
+
+  // Invalid message: Output is emptied
+  trajectory_msg.points.front().time_from_start = trajectory_msg.points.back().time_from_start;
+  initJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory);
+  EXPECT_TRUE(trajectory.empty());
+}
+
+TEST_F(InitTrajectoryTest, AppendInvalid)
+{
+  const ros::Time time(curr_traj[0][0].startTime());
+  std::string error_string;
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory = &curr_traj;
+  options.error_string       = &error_string;
+
+  Trajectory trajectory;
+  ASSERT_TRUE(appendJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory));
+
+  // Partial-joint message
+  {
+    vector<string> joint_names(2, "foo_joint");
+    joint_names[1] = "bar_joint";
+    InitJointTrajectoryOptions<Trajectory> partial_options = options;
+    partial_options.joint_names = &joint_names;
+    EXPECT_FALSE(appendJointTrajectory<Trajectory>(trajectory_msg, time, partial_options, trajectory));
+    EXPECT_TRUE(trajectory.empty());
+    EXPECT_FALSE(error_string.empty());
+  }
+
+  // Empty message
+  {
+    trajectory_msgs::JointTrajectory empty_msg = trajectory_msg;
+    empty_msg.points.clear();
+    EXPECT_FALSE(appendJointTrajectory<Trajectory>(empty_msg, time, options, trajectory));
+    EXPECT_TRUE(trajectory.empty());
+  }
+
+  // Message in the past
+  {
+    const ros::Time future_time = trajectory_msg.header.stamp + points.back().time_from_start + ros::Duration(1.0);
+    EXPECT_FALSE(appendJointTrajectory<Trajectory>(trajectory_msg, future_time, options, trajectory));
+    EXPECT_TRUE(trajectory.empty());
+  }
+
+  // Inconsistent point sizes
+  trajectory_msg.points.back().velocities.push_back(0.0);
+  EXPECT_THROW(appendJointTrajectory<Trajectory>(trajectory_msg, time, options, trajectory), std::invalid_argument);
+}
+
+TEST(WindowedFitTest, ExtendMatchesFullFit)
+{
+  // Long two-joint message, the first joint wraps around
+  JointTrajectory msg;
+  msg.header.stamp = ros::Time(1.0);
+  msg.joint_names.push_back("foo_joint");
+  msg.joint_names.push_back("bar_joint");
+  msg.points.resize(30);
+  for (unsigned int i = 0; i < msg.points.size(); ++i)
+  {
+    JointTrajectoryPoint& point = msg.points[i];
+    point.time_from_start = ros::Duration(0.1 * (i + 1));
+    point.positions.push_back(std::sin(0.3 * i));
+    point.positions.push_back(0.1 * i);
+    point.velocities.resize(2, 0.0);
+  }
+
+  // Current trajectory several turns away from the message positions of the wrapping joint
+  Trajectory curr_traj(2);
+  for (unsigned int joint_id = 0; joint_id < 2; ++joint_id)
+  {
+    typename Segment::State state(1);
+    state.position[0] = joint_id == 0 ? 4.0 * M_PI : 0.0;
+    curr_traj[joint_id].push_back(Segment(0.0, state, 1.0, state));
+  }
+  vector<char> angle_wraparound(2, false);
+  angle_wraparound[0] = true;
+
+  ros::Time time(1.05);
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory = &curr_traj;
+  options.angle_wraparound   = &angle_wraparound;
+  const Trajectory full_traj = initJointTrajectory<Trajectory>(msg, time, options);
+  ASSERT_EQ(2u, full_traj.size());
+
+  // Windowed fit
+  ros::Time fitting_end_time = time + ros::Duration(0.5);
+  std::size_t end_point = 0;
+  options.fitting_end_time = &fitting_end_time;
+  options.end_point        = &end_point;
+  Trajectory traj = initJointTrajectory<Trajectory>(msg, time, options);
+  ASSERT_EQ(2u, traj.size());
+  EXPECT_EQ(5u, end_point); // First point reached after the fitting end time
+  EXPECT_GT(full_traj[0].size(), traj[0].size());
+
+  unsigned int windows = 1;
+  while (true)
+  {
+    // Fitted part of the trajectory matches the full fit
+    for (unsigned int joint_id = 0; joint_id < 2; ++joint_id)
+    {
+      for (double t = time.toSec(); t <= traj[joint_id].back().endTime(); t += 0.01)
+      {
+        typename Segment::State ref_state, state;
+        trajectory_interface::sample(full_traj[joint_id], t, ref_state);
+        trajectory_interface::sample(traj[joint_id], t, state);
+        EXPECT_NEAR(ref_state.position[0], state.position[0], EPS);
+        EXPECT_NEAR(ref_state.velocity[0], state.velocity[0], EPS);
+      }
+    }
+    if (end_point + 1 == msg.points.size()) {break;}
+
+    // Extend from a later time, dropping the segments before it
+    time += ros::Duration(0.3);
+    fitting_end_time = time + ros::Duration(0.5);
+    InitJointTrajectoryOptions<Trajectory> extend_options;
+    extend_options.current_trajectory = &traj;
+    extend_options.angle_wraparound   = &angle_wraparound;
+    extend_options.fitting_end_time   = &fitting_end_time;
+    extend_options.end_point          = &end_point;
+
+    const std::size_t first_point = end_point;
+    Trajectory next_traj;
+    ASSERT_TRUE(extendJointTrajectory<Trajectory>(msg, time, first_point, extend_options, next_traj));
+    EXPECT_LT(first_point, end_point);
+    EXPECT_GE(time.toSec(), next_traj[0].front().endTime() - 0.1 - EPS);   // Only the active segment is kept before time
+    EXPECT_LE(time.toSec(), next_traj[0].front().endTime());
+    EXPECT_EQ(traj[0].back().endTime(), next_traj[0][next_traj[0].size() - (end_point - first_point) - 1].endTime());
+    traj.swap(next_traj);
+    ++windows;
+  }
+  EXPECT_LT(3u, windows);
+  EXPECT_NEAR(full_traj[0].back().endTime(), traj[0].back().endTime(), EPS);
+
+  // Complete trajectories can not be extended
+  InitJointTrajectoryOptions<Trajectory> extend_options;
+  extend_options.current_trajectory = &traj;
+  Trajectory next_traj;
+  EXPECT_FALSE(extendJointTrajectory<Trajectory>(msg, time, end_point, extend_options, next_traj));
+  EXPECT_TRUE(next_traj.empty());
+}
+
+TEST(WindowedFitTest, ExtendWindowBoundaryMatchesInit)
+{
+  JointTrajectory msg;
+  msg.header.stamp = ros::Time(1.0);
+  msg.joint_names.push_back("foo_joint");
+  msg.points.resize(20);
+  for (unsigned int i = 0; i < msg.points.size(); ++i)
+  {
+    JointTrajectoryPoint& point = msg.points[i];
+    point.time_from_start = ros::Duration(0.1 * (i + 1));
+    point.positions.push_back(0.1 * i);
+    point.velocities.push_back(0.0);
+  }
+
+  // A window ending exactly at a point ends at that point, both when initializing and when extending
+  ros::Time time(1.05);
+  ros::Time fitting_end_time = msg.header.stamp + msg.points[4].time_from_start;
+  std::size_t end_point = 0;
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.fitting_end_time = &fitting_end_time;
+  options.end_point        = &end_point;
+  Trajectory traj = initJointTrajectory<Trajectory>(msg, time, options);
+  ASSERT_EQ(1u, traj.size());
+  EXPECT_EQ(4u, end_point);
+  EXPECT_NEAR(fitting_end_time.toSec(), traj[0].back().endTime(), EPS);
+
+  fitting_end_time = msg.header.stamp + msg.points[9].time_from_start;
+  InitJointTrajectoryOptions<Trajectory> extend_options;
+  extend_options.current_trajectory = &traj;
+  extend_options.fitting_end_time   = &fitting_end_time;
+  extend_options.end_point          = &end_point;
+  Trajectory next_traj;
+  ASSERT_TRUE(extendJointTrajectory<Trajectory>(msg, time, 4, extend_options, next_traj));
+  EXPECT_EQ(9u, end_point);
+  EXPECT_NEAR(fitting_end_time.toSec(), next_traj[0].back().endTime(), EPS);
+}
+
+TEST(KnotReductionTest, DenseTrajectory)
+{
+  // Dense two-joint message, sampled at 1ms
+  JointTrajectory msg;
+  msg.header.stamp = ros::Time(1.0);
+  msg.joint_names.push_back("foo_joint");
+  msg.joint_names.push_back("bar_joint");
+  msg.points.resize(2000);
+  for (unsigned int i = 0; i < msg.points.size(); ++i)
+  {
+    JointTrajectoryPoint& point = msg.points[i];
+    const double t = 0.001 * (i + 1);
+    point.time_from_start = ros::Duration(t);
+    point.positions.push_back(std::sin(t));
+    point.positions.push_back(0.5 * t);
+    point.velocities.push_back(std::cos(t));
+    point.velocities.push_back(0.5);
+  }
+
+  const ros::Time time(1.0);
+  InitJointTrajectoryOptions<Trajectory> options;
+  const Trajectory full_traj = initJointTrajectory<Trajectory>(msg, time, options);
+  ASSERT_EQ(2u, full_traj.size());
+  EXPECT_EQ(msg.points.size() - 1, full_traj[0].size());
+
+  const double tolerance = 1e-4;
+  options.knot_tolerance = tolerance;
+  const Trajectory traj = initJointTrajectory<Trajectory>(msg, time, options);
+  ASSERT_EQ(2u, traj.size());
+
+  // Order of magnitude fewer segments, with the same boundaries for all joints
+  EXPECT_GT(full_traj[0].size(), 10 * traj[0].size());
+  ASSERT_EQ(traj[0].size(), traj[1].size());
+  for (unsigned int i = 0; i < traj[0].size(); ++i)
+  {
+    EXPECT_EQ(traj[0][i].startTime(), traj[1][i].startTime());
+    EXPECT_EQ(traj[0][i].endTime(),   traj[1][i].endTime());
+  }
+  EXPECT_EQ(full_traj[0].front().startTime(), traj[0].front().startTime());
+  EXPECT_EQ(full_traj[0].back().endTime(),    traj[0].back().endTime());
+
+  // All points are reproduced within tolerance
+  for (unsigned int joint_id = 0; joint_id < 2; ++joint_id)
+  {
+    for (const JointTrajectoryPoint& point : msg.points)
+    {
+      typename Segment::State state;
+      trajectory_interface::sample(traj[joint_id], (msg.header.stamp + point.time_from_start).toSec(), state);
+      EXPECT_NEAR(point.positions[joint_id], state.position[0], tolerance + EPS);
+    }
+  }
+
+  // Windowed fits reduce knots as well, and cover the same points
+  ros::Time fitting_end_time = time + ros::Duration(0.5);
+  std::size_t end_point = 0;
+  options.fitting_end_time = &fitting_end_time;
+  options.end_point        = &end_point;
+  Trajectory windowed_traj = initJointTrajectory<Trajectory>(msg, time, options);
+  ASSERT_EQ(2u, windowed_traj.size());
+  EXPECT_EQ((msg.header.stamp + msg.points[end_point].time_from_start).toSec(), windowed_traj[0].back().endTime());
+
+  fitting_end_time = ros::Time(10.0);
+  InitJointTrajectoryOptions<Trajectory> extend_options;
+  extend_options.current_trajectory = &windowed_traj;
+  extend_options.fitting_end_time   = &fitting_end_time;
+  extend_options.end_point          = &end_point;
+  extend_options.knot_tolerance     = tolerance;
+  const std::size_t first_point = end_point;
+  Trajectory extended_traj;
+  ASSERT_TRUE(extendJointTrajectory<Trajectory>(msg, time, first_point, extend_options, extended_traj));
+  EXPECT_EQ(msg.points.size() - 1, end_point);
+  EXPECT_GT(full_traj[0].size(), 10 * extended_traj[0].size());
+  EXPECT_EQ(full_traj[0].back().endTime(), extended_traj[0].back().endTime());
+  for (unsigned int joint_id = 0; joint_id < 2; ++joint_id)
+  {
+    for (std::size_t i = first_point; i < msg.points.size(); ++i)
+    {
+      typename Segment::State state;
+      trajectory_interface::sample(extended_traj[joint_id], (msg.header.stamp + msg.points[i].time_from_start).toSec(),
+                                   state);
+      EXPECT_NEAR(msg.points[i].positions[joint_id], state.position[0], tolerance + EPS);
+    }
+  }
+}
+
+TEST(KnotReductionTest, KeepsEveryPointOutOfTolerance)
+{
+  // Alternating positions, which no segment skipping a point follows within tolerance
+  JointTrajectory msg;
+  msg.joint_names.push_back("foo_joint");
+  msg.points.resize(10);
+  for (unsigned int i = 0; i < msg.points.size(); ++i)
+  {
+    msg.points[i].time_from_start = ros::Duration(0.1 * (i + 1));
+    msg.points[i].positions.push_back(i % 2 == 0 ? 0.0 : 1.0);
+  }
+
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.knot_tolerance = 0.1;
+  const Trajectory traj = initJointTrajectory<Trajectory>(msg, ros::Time(0.0), options);
+  ASSERT_EQ(1u, traj.size());
+  EXPECT_EQ(msg.points.size() - 1, traj[0].size());
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/joint_command_writer.h>
+
+using joint_trajectory_controller::JointCommandWriter;
+using hardware_interface::JointHandle;
+using hardware_interface::JointStateHandle;
+
+class JointCommandWriterTest : public ::testing::Test
+{
+public:
+  JointCommandWriterTest()
+    : state(3, 0.0),
+      commands(6, 0.0)
+  {}
+
+protected:
+  std::vector<JointHandle> makeHandles(const std::vector<unsigned int>& command_indices)
+  {
+    std::vector<JointHandle> handles;
+    for (unsigned int i = 0; i < command_indices.size(); ++i)
+    {
+      const JointStateHandle state_handle("joint_" + std::to_string(i), &state[0], &state[1], &state[2]);
+      handles.push_back(JointHandle(state_handle, &commands[command_indices[i]]));
+    }
+    return handles;
+  }
+
+  std::vector<double> state;
+  std::vector<double> commands;
+};
+
+TEST_F(JointCommandWriterTest, Contiguous)
+{
+  std::vector<JointHandle> handles = makeHandles({2, 3, 4});
+  JointCommandWriter writer;
+  writer.init(handles);
+  EXPECT_EQ(3u, writer.size());
+  EXPECT_TRUE(writer.isContiguous());
+
+  writer.write({1.0, 2.0, 3.0});
+  EXPECT_EQ(std::vector<double>({0.0, 0.0, 1.0, 2.0, 3.0, 0.0}), commands);
+}
+
+TEST_F(JointCommandWriterTest, Scattered)
+{
+  std::vector<JointHandle> handles = makeHandles({4, 0, 2});
+  JointCommandWriter writer;
+  writer.init(handles);
+  EXPECT_FALSE(writer.isContiguous());
+
+  writer.write({1.0, 2.0, 3.0});
+  EXPECT_EQ(std::vector<double>({2.0, 0.0, 3.0, 0.0, 1.0, 0.0}), commands);
+  for (unsigned int i = 0; i < handles.size(); ++i) {EXPECT_EQ(i + 1.0, handles[i].getCommand());}
+}
+
+TEST_F(JointCommandWriterTest, Empty)
+{
+  std::vector<JointHandle> handles;
+  JointCommandWriter writer;
+  writer.init(handles);
+  EXPECT_EQ(0u, writer.size());
+  writer.write(std::vector<double>());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2013, PAL Robotics S.L.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of PAL Robotics S.L. nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+#include <actionlib/client/simple_action_client.h>
+
+#include <control_msgs/FollowJointTrajectoryAction.h>
+#include <control_msgs/JointTrajectoryControllerState.h>
+
+// Floating-point value comparison threshold
+const double EPS = 0.01;
+
+using actionlib::SimpleClientGoalState;
+
+/**
+ * \brief Goals sent while another goal executes, to a controller that blends goals continuing the executing one.
+ *
+ * Built with \p TEST_QUEUE_GOALS, the controller queues goals behind the executing one instead, which also blends the
+ * goals continuing it.
+ */
+class JointTrajectoryControllerGoalsTest : public ::testing::Test
+{
+public:
+  JointTrajectoryControllerGoalsTest()
+    : nh("rrbot_controller"),
+      short_timeout(1.0),
+      long_timeout(10.0)
+  {
+    joint_names.push_back("joint1");
+    joint_names.push_back("joint2");
+
+    state_sub = nh.subscribe<control_msgs::JointTrajectoryControllerState>("state", 1,
+                                                                           &JointTrajectoryControllerGoalsTest::stateCB,
+                                                                           this);
+
+    // One client per goal, as a client only tracks its last goal
+    const std::string action_server_name = nh.getNamespace() + "/follow_joint_trajectory";
+    for (auto& action_client : action_clients)
+    {
+      action_client.reset(new ActionClient(action_server_name));
+    }
+  }
+
+  ~JointTrajectoryControllerGoalsTest()
+  {
+    state_sub.shutdown(); // This is important, to make sure that the callback is not woken up later in the destructor
+  }
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(initState());
+    for (const auto& action_client : action_clients)
+    {
+      ASSERT_TRUE(action_client->waitForServer(long_timeout));
+    }
+
+    // Start every test at rest, at home
+    action_clients[0]->sendGoal(goal({0.0}, 1.0));
+    ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  }
+
+protected:
+  typedef actionlib::SimpleActionClient<control_msgs::FollowJointTrajectoryAction> ActionClient;
+  typedef std::shared_ptr<ActionClient> ActionClientPtr;
+  typedef control_msgs::FollowJointTrajectoryGoal ActionGoal;
+  typedef control_msgs::JointTrajectoryControllerStateConstPtr StateConstPtr;
+
+  std::mutex mutex;
+  ros::NodeHandle nh;
+  std::vector<std::string> joint_names;
+
+  ros::Duration short_timeout;
+  ros::Duration long_timeout;
+
+  ros::Subscriber state_sub;
+  ActionClientPtr action_clients[3];
+
+  StateConstPtr controller_state;
+
+  void stateCB(const StateConstPtr& state)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    controller_state = state;
+  }
+
+  StateConstPtr getState()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return controller_state;
+  }
+
+  bool initState(const ros::Duration& timeout = ros::Duration(5.0))
+  {
+    bool init_ok = false;
+    ros::Time start_time = ros::Time::now();
+    while (!init_ok && (ros::Time::now() - start_time) < timeout)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        init_ok = controller_state && !controller_state->joint_names.empty();
+      }
+      ros::Duration(0.1).sleep();
+    }
+    return init_ok;
+  }
+
+  static bool waitForState(const ActionClientPtr& action_client,
+                           const actionlib::SimpleClientGoalState& state,
+                           const ros::Duration& timeout)
+  {
+    using ros::Time;
+    using ros::Duration;
+
+    Time start_time = Time::now();
+    while (action_client->getState() != state && ros::ok())
+    {
+      if (timeout >= Duration(0.0) && (Time::now() - start_time) > timeout) {return false;} // Timed-out
+      ros::Duration(0.01).sleep();
+    }
+    return true;
+  }
+
+  /**
+   * \return Goal without start time, moving both joints through \p positions, at rest, one point every \p spacing
+   * seconds. The first point is at \p first_time, zero if it continues the end of the executing goal.
+   */
+  ActionGoal goal(const std::vector<double>& positions, double spacing, double first_time = -1.0) const
+  {
+    ActionGoal action_goal;
+    action_goal.trajectory.joint_names = joint_names;
+    for (std::size_t k = 0; k < positions.size(); ++k)
+    {
+      trajectory_msgs::JointTrajectoryPoint point;
+      point.positions.resize(joint_names.size(), positions[k]);
+      point.velocities.resize(joint_names.size(), 0.0);
+      point.accelerations.resize(joint_names.size(), 0.0);
+      point.time_from_start = ros::Duration(first_time < 0.0 ? (k + 1) * spacing : first_time + k * spacing);
+      action_goal.trajectory.points.push_back(point);
+    }
+    return action_goal;
+  }
+
+  void expectDesiredPositions(double position)
+  {
+    StateConstPtr state = getState();
+    for (std::size_t i = 0; i < joint_names.size(); ++i)
+    {
+      EXPECT_NEAR(position, state->desired.positions[i], EPS);
+      EXPECT_NEAR(0.0,      state->desired.velocities[i], EPS);
+    }
+  }
+};
+
+TEST_F(JointTrajectoryControllerGoalsTest, blendedGoalSucceedsPreviousGoal)
+{
+  // Second goal starting at rest where the first one ends
+  action_clients[0]->sendGoal(goal({0.5}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[1]->sendGoal(goal({0.5, -0.5}, 1.0, 0.0));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+
+  // Both goals execute, the first one succeeds once the second one takes over
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[0]->getState().state_);
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  EXPECT_EQ(control_msgs::FollowJointTrajectoryResult::SUCCESSFUL, action_clients[0]->getResult()->error_code);
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[1]->getState().state_);
+
+  // The second goal was timed from the end of the first one
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  EXPECT_EQ(control_msgs::FollowJointTrajectoryResult::SUCCESSFUL, action_clients[1]->getResult()->error_code);
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(-0.5);
+}
+
+TEST_F(JointTrajectoryControllerGoalsTest, blendedGoalsChain)
+{
+  action_clients[0]->sendGoal(goal({0.5}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[1]->sendGoal(goal({0.5, -0.5}, 1.0, 0.0));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[2]->sendGoal(goal({-0.5, 0.2}, 1.0, 0.0));
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::ACTIVE, short_timeout));
+
+  // Goals hand over in the order they were blended
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[2]->getState().state_);
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(0.2);
+}
+
+TEST_F(JointTrajectoryControllerGoalsTest, discontinuousGoalPreempts)
+{
+  action_clients[0]->sendGoal(goal({0.5}, 2.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+
+  // First point away from the end of the executing goal, close to where the joints still are
+  action_clients[1]->sendGoal(goal({0.0, -0.5}, 1.0, 0.0));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::PREEMPTED, short_timeout));
+
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(-0.5);
+}
+
+TEST_F(JointTrajectoryControllerGoalsTest, stampedGoalPreempts)
+{
+  action_clients[0]->sendGoal(goal({0.5}, 2.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+
+  // Continues the executing goal, but has a start time of its own
+  ActionGoal stamped_goal = goal({0.5, -0.5}, 1.0);
+  stamped_goal.trajectory.header.stamp = ros::Time::now();
+  action_clients[1]->sendGoal(stamped_goal);
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::PREEMPTED, short_timeout));
+
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(-0.5);
+}
+
+#if TEST_QUEUE_GOALS
+TEST_F(JointTrajectoryControllerGoalsTest, queuedGoalsRunInOrder)
+{
+  // Goals whose first point has a transition time, not continuing the executing goal
+  action_clients[0]->sendGoal(goal({0.5}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[1]->sendGoal(goal({0.0}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[2]->sendGoal(goal({-0.5}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::ACTIVE, short_timeout));
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[0]->getState().state_);
+
+  // Each goal succeeds once the next one takes over
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[1]->getState().state_);
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[2]->getState().state_);
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[2]->getState().state_);
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  EXPECT_EQ(control_msgs::FollowJointTrajectoryResult::SUCCESSFUL, action_clients[2]->getResult()->error_code);
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(-0.5);
+}
+
+TEST_F(JointTrajectoryControllerGoalsTest, cancelQueuedGoalDropsLaterGoals)
+{
+  action_clients[0]->sendGoal(goal({0.5}, 2.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[1]->sendGoal(goal({0.0}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[2]->sendGoal(goal({-0.5}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::ACTIVE, short_timeout));
+
+  // The goal queued after the canceled one is dropped with it, the executing goal continues
+  action_clients[1]->cancelGoal();
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::PREEMPTED, short_timeout));
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::PREEMPTED, short_timeout));
+  EXPECT_EQ(SimpleClientGoalState::ACTIVE, action_clients[0]->getState().state_);
+
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(0.5);
+}
+
+TEST_F(JointTrajectoryControllerGoalsTest, untimedGoalPreemptsQueuedGoals)
+{
+  action_clients[0]->sendGoal(goal({0.5}, 2.0));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::ACTIVE, short_timeout));
+  action_clients[1]->sendGoal(goal({0.0}, 1.0));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::ACTIVE, short_timeout));
+
+  // First point without transition time, away from the end of the queue: Can't be queued
+  action_clients[2]->sendGoal(goal({0.0, -0.5}, 1.0, 0.0));
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::ACTIVE, short_timeout));
+  ASSERT_TRUE(waitForState(action_clients[0], SimpleClientGoalState::PREEMPTED, short_timeout));
+  ASSERT_TRUE(waitForState(action_clients[1], SimpleClientGoalState::PREEMPTED, short_timeout));
+
+  ASSERT_TRUE(waitForState(action_clients[2], SimpleClientGoalState::SUCCEEDED, long_timeout));
+  ros::Duration(0.5).sleep(); // Allows values to settle to within EPS
+  expectDesiredPositions(-0.5);
+}
+#endif
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "joint_trajectory_controller_goals_test");
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+  int ret = RUN_ALL_TESTS();
+  spinner.stop();
+  ros::shutdown();
+  return ret;
+}
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 
@@ -43,10 +44,14 @@
 #include <control_msgs/FollowJointTrajectoryAction.h>
 #include <control_msgs/JointTrajectoryControllerState.h>
 #include <control_msgs/QueryTrajectoryState.h>
+#include <joint_trajectory_controller/QueryTrajectoryStates.h>
 
 #include <controller_manager_msgs/LoadController.h>
 #include <controller_manager_msgs/UnloadController.h>
 #include <controller_manager_msgs/SwitchController.h>
+#include <dynamic_reconfigure/Reconfigure.h>
+
+#include <controller_instrumentation/realtime_audit_listener.h>
 
 // Floating-point value comparison threshold
 const double EPS = 0.01;
@@ -122,6 +127,7 @@ public:
 
     // Query state service client
     query_state_service = nh.serviceClient<control_msgs::QueryTrajectoryState>("query_state");
+    query_states_service = nh.serviceClient<joint_trajectory_controller::QueryTrajectoryStates>("query_states");
 
     // Controller management services
     load_controller_service = nh.serviceClient<controller_manager_msgs::LoadController>("/controller_manager/load_controller");
@@ -168,6 +174,7 @@ protected:
   ros::Publisher     traj_pub;
   ros::Subscriber    state_sub;
   ros::ServiceClient query_state_service;
+  ros::ServiceClient query_states_service;
   ros::ServiceClient load_controller_service;
   ros::ServiceClient unload_controller_service;
   ros::ServiceClient switch_controller_service;
@@ -338,6 +345,38 @@ TEST_F(JointTrajectoryControllerTest, queryStateServiceConsistency)
   EXPECT_EQ(n_joints, srv.response.acceleration.size());
 }
 
+TEST_F(JointTrajectoryControllerTest, queryStatesServiceConsistency)
+{
+  query_states_service.waitForExistence(ros::Duration(2.0));
+  ASSERT_TRUE(query_states_service.isValid());
+
+  // Batch query matches single queries at each time
+  const ros::Time now = ros::Time::now();
+  joint_trajectory_controller::QueryTrajectoryStates srv;
+  srv.request.times.push_back(now);
+  srv.request.times.push_back(now + ros::Duration(0.5));
+  srv.request.times.push_back(now + ros::Duration(1.0));
+  ASSERT_TRUE(query_states_service.call(srv));
+
+  EXPECT_EQ(joint_names, srv.response.name);
+  ASSERT_EQ(srv.request.times.size(), srv.response.points.size());
+  for (unsigned int k = 0; k < srv.request.times.size(); ++k)
+  {
+    control_msgs::QueryTrajectoryState single_srv;
+    single_srv.request.time = srv.request.times[k];
+    ASSERT_TRUE(query_state_service.call(single_srv));
+
+    const trajectory_msgs::JointTrajectoryPoint& point = srv.response.points[k];
+    ASSERT_EQ(n_joints, point.positions.size());
+    for (unsigned int i = 0; i < n_joints; ++i)
+    {
+      EXPECT_NEAR(single_srv.response.position[i],     point.positions[i],     EPS);
+      EXPECT_NEAR(single_srv.response.velocity[i],     point.velocities[i],    EPS);
+      EXPECT_NEAR(single_srv.response.acceleration[i], point.accelerations[i], EPS);
+    }
+  }
+}
+
 // Invalid messages ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 TEST_F(JointTrajectoryControllerTest, invalidMessages)
@@ -1297,6 +1336,82 @@ TEST_F(JointTrajectoryControllerTest, goalToleranceViolation)
   }
 }
 
+// Parameter reconfiguration ///////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(JointTrajectoryControllerTest, reconfigureTolerances)
+{
+  ASSERT_TRUE(initState());
+  ros::ServiceClient reconfigure_service = nh.serviceClient<dynamic_reconfigure::Reconfigure>("set_parameters");
+  ASSERT_TRUE(reconfigure_service.waitForExistence(long_timeout));
+
+  double goal_time = 0.0;
+  ASSERT_TRUE(nh.getParam("constraints/goal_time", goal_time));
+
+  // Updates are clamped to the parameter range and mirrored to the parameter server. Unknown names are ignored
+  dynamic_reconfigure::Reconfigure srv;
+  dynamic_reconfigure::DoubleParameter parameter;
+  parameter.name  = "goal_time";
+  parameter.value = 2.0;
+  srv.request.config.doubles.push_back(parameter);
+  parameter.name  = "joint1_trajectory";
+  parameter.value = -1.0;
+  srv.request.config.doubles.push_back(parameter);
+  parameter.name  = "unknown";
+  srv.request.config.doubles.push_back(parameter);
+  ASSERT_TRUE(reconfigure_service.call(srv));
+
+  std::map<std::string, double> values;
+  for (const dynamic_reconfigure::DoubleParameter& value : srv.response.config.doubles) {values[value.name] = value.value;}
+  EXPECT_EQ(0u, values.count("unknown"));
+  EXPECT_EQ(2.0, values["goal_time"]);
+  EXPECT_EQ(0.0, values["joint1_trajectory"]);
+  EXPECT_EQ(0.05, values["joint2_trajectory"]);
+
+  double param = 0.0;
+  EXPECT_TRUE(nh.getParam("constraints/goal_time", param));
+  EXPECT_EQ(2.0, param);
+
+  // Restore the configured tolerances
+  srv.request.config.doubles.clear();
+  parameter.name  = "goal_time";
+  parameter.value = goal_time;
+  srv.request.config.doubles.push_back(parameter);
+  parameter.name  = "joint1_trajectory";
+  parameter.value = 0.05;
+  srv.request.config.doubles.push_back(parameter);
+  ASSERT_TRUE(reconfigure_service.call(srv));
+}
+
+#ifdef CONTROLLER_INSTRUMENTATION_RT_AUDIT
+// Realtime audit //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(JointTrajectoryControllerTest, realtimeAudit)
+{
+  controller_instrumentation::RealtimeAuditListener audit(nh, "rrbot_controller");
+  ASSERT_TRUE(initState());
+  ASSERT_TRUE(action_client->waitForServer(long_timeout));
+
+  // Exercise trajectory execution and replacement through both the topic and action interfaces
+  traj.header.stamp = ros::Time(0);
+  traj_pub.publish(traj);
+  ros::Duration(0.5).sleep();
+
+  traj_goal.trajectory.header.stamp = ros::Time(0);
+  action_client->sendGoal(traj_goal);
+  ASSERT_TRUE(waitForState(action_client, SimpleClientGoalState::SUCCEEDED, long_timeout));
+
+  // Wait for audit results covering the above
+  ros::Duration(2.0 * controller_instrumentation::RealtimeAudit::PUBLISH_PERIOD).sleep();
+  ASSERT_TRUE(audit.received());
+  EXPECT_GT(audit.cycles(), 0u);
+
+  const controller_instrumentation::RealtimeAuditCounts totals = audit.totals();
+  EXPECT_EQ(0u, totals.allocations);
+  EXPECT_EQ(0u, totals.deallocations);
+  EXPECT_EQ(0u, totals.mutex_locks);
+}
+#endif
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
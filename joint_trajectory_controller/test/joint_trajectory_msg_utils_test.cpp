@@ -231,6 +231,80 @@ TEST_F(TrajectoryInterfaceRosTest, FindPoint)
   }
 }
 
+TEST_F(TrajectoryInterfaceRosTest, ScanPoints)
+{
+  const ros::Time msg_start_time = trajectory_msg.header.stamp;
+  const vector<JointTrajectoryPoint>& msg_points = trajectory_msg.points;
+  const std::size_t n_points = msg_points.size();
+  const std::size_t n_joints = trajectory_msg.joint_names.size();
+  auto is_valid_point = [n_joints](const JointTrajectoryPoint& point)
+  {
+    return point.positions.size() == n_joints && isValid(point, n_joints);
+  };
+
+  // Empty trajectory
+  {
+    JointTrajectory msg;
+    const PointsScan scan = scanPoints(msg, msg_start_time, is_valid_point);
+    EXPECT_TRUE(scan.time_increasing);
+    EXPECT_EQ(0, scan.first_ahead);
+    EXPECT_EQ(0, scan.first_invalid);
+    EXPECT_EQ(0, scan.first_invalid_ahead);
+  }
+
+  // First point ahead agrees with findPoint
+  {
+    const ros::Duration eps(1e-6);
+    vector<ros::Time> times;
+    times.push_back(msg_start_time);
+    for (const JointTrajectoryPoint& point : msg_points)
+    {
+      times.push_back(msg_start_time + point.time_from_start - eps);
+      times.push_back(msg_start_time + point.time_from_start);
+      times.push_back(msg_start_time + point.time_from_start + eps);
+    }
+
+    for (const ros::Time& time : times)
+    {
+      const PointsScan scan = scanPoints(trajectory_msg, time, is_valid_point);
+      vector<JointTrajectoryPoint>::const_iterator it = findPoint(trajectory_msg, time);
+      const std::size_t expected_first_ahead = (it == msg_points.end()) ? 0 : std::distance(msg_points.begin(), it) + 1;
+      EXPECT_TRUE(scan.time_increasing);
+      EXPECT_EQ(expected_first_ahead, scan.first_ahead);
+      EXPECT_EQ(n_points, scan.first_invalid);
+      EXPECT_EQ(n_points, scan.first_invalid_ahead);
+    }
+  }
+
+  // Time monotonicity agrees with isTimeStrictlyIncreasing
+  {
+    JointTrajectory msg = trajectory_msg;
+    msg.points[2].time_from_start = msg.points[1].time_from_start;
+    EXPECT_FALSE(scanPoints(msg, msg_start_time, is_valid_point).time_increasing);
+
+    msg.points[2].time_from_start = msg.points[0].time_from_start;
+    EXPECT_FALSE(scanPoints(msg, msg_start_time, is_valid_point).time_increasing);
+  }
+
+  // Invalid points before and after current time
+  {
+    JointTrajectory msg = trajectory_msg;
+    msg.points[0].velocities.push_back(0.0);
+    msg.points[2].positions.clear();
+
+    const ros::Time time = msg_start_time + msg_points[1].time_from_start;
+    const PointsScan scan = scanPoints(msg, time, is_valid_point);
+    EXPECT_EQ(2, scan.first_ahead);
+    EXPECT_EQ(0, scan.first_invalid);
+    EXPECT_EQ(2, scan.first_invalid_ahead);
+
+    msg.points[2] = msg_points[2];
+    const PointsScan scan_valid_ahead = scanPoints(msg, time, is_valid_point);
+    EXPECT_EQ(0, scan_valid_ahead.first_invalid);
+    EXPECT_EQ(n_points, scan_valid_ahead.first_invalid_ahead);
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
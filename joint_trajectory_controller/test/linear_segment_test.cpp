@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2013, PAL Robotics S.L.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of PAL Robotics S.L. nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <gtest/gtest.h>
+#include <trajectory_interface/linear_segment.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+
+using namespace trajectory_interface;
+
+// Floating-point value comparison threshold
+const double EPS = 1e-9;
+
+typedef LinearSegment<double> Segment;
+typedef typename Segment::State State;
+typedef typename Segment::Time  Time;
+
+typedef LinearSegment<double, 2> FixedSegment;
+typedef typename FixedSegment::State FixedState;
+
+TEST(LinearSegmentTest, InvalidSegmentConstruction)
+{
+  State valid_state(1);
+  const Time start_time     = 1.0;
+  const Time valid_end_time = 2.0;
+
+  State empty_state;
+  EXPECT_THROW(Segment(start_time, empty_state, valid_end_time, valid_state), std::invalid_argument);
+  EXPECT_THROW(Segment(start_time, valid_state, valid_end_time, empty_state), std::invalid_argument);
+
+  State bad_size_state(2);
+  EXPECT_THROW(Segment(start_time, bad_size_state, valid_end_time, valid_state), std::invalid_argument);
+
+  EXPECT_THROW(Segment(start_time, valid_state, -1.0, valid_state), std::invalid_argument);
+
+  // Velocities and accelerations are ignored, so their sizes are not checked
+  State bad_vel_state = valid_state;
+  bad_vel_state.velocity.push_back(0.0);
+  EXPECT_NO_THROW(Segment(start_time, bad_vel_state, valid_end_time, valid_state));
+}
+
+TEST(LinearSegmentTest, DefaultConstructor)
+{
+  Segment segment;
+  EXPECT_EQ(0.0, segment.startTime());
+  EXPECT_EQ(0.0, segment.endTime());
+  EXPECT_EQ(0u, segment.size());
+
+  State state;
+  segment.sample(0.0, state);
+  EXPECT_TRUE(state.position.empty());
+}
+
+TEST(LinearSegmentTest, ZeroDurationSampler)
+{
+  State start_state(1);
+  start_state.position[0] = 1.0;
+  State end_state(1);
+  end_state.position[0] = 2.0;
+
+  Segment segment(1.0, start_state, 1.0, end_state);
+  State state;
+  segment.sample(1.0, state);
+  EXPECT_NEAR(start_state.position[0], state.position[0], EPS);
+  EXPECT_NEAR(0.0, state.velocity[0], EPS);
+  EXPECT_NEAR(0.0, state.acceleration[0], EPS);
+}
+
+TEST(LinearSegmentTest, Sampler)
+{
+  // Velocities and accelerations are ignored
+  const Time start_time = 1.0;
+  State start_state(1);
+  start_state.position[0]     = 1.0;
+  start_state.velocity[0]     = 5.0;
+  start_state.acceleration[0] = 5.0;
+
+  const Time end_time = 3.0;
+  State end_state(1);
+  end_state.position[0]     = 5.0;
+  end_state.velocity[0]     = -5.0;
+  end_state.acceleration[0] = -5.0;
+
+  Segment segment(start_time, start_state, end_time, end_state);
+  EXPECT_EQ(start_time, segment.startTime());
+  EXPECT_EQ(end_time, segment.endTime());
+  EXPECT_EQ(1u, segment.size());
+
+  State state;
+  segment.sample(0.0, state);
+  EXPECT_NEAR(1.0, state.position[0], EPS);
+  EXPECT_NEAR(0.0, state.velocity[0], EPS);
+  EXPECT_NEAR(0.0, state.acceleration[0], EPS);
+
+  segment.sample(1.5, state);
+  EXPECT_NEAR(2.0, state.position[0], EPS);
+  EXPECT_NEAR(2.0, state.velocity[0], EPS);
+  EXPECT_NEAR(0.0, state.acceleration[0], EPS);
+
+  segment.sample(end_time, state);
+  EXPECT_NEAR(5.0, state.position[0], EPS);
+  EXPECT_NEAR(2.0, state.velocity[0], EPS);
+
+  segment.sample(4.0, state);
+  EXPECT_NEAR(5.0, state.position[0], EPS);
+  EXPECT_NEAR(0.0, state.velocity[0], EPS);
+  EXPECT_NEAR(0.0, state.acceleration[0], EPS);
+}
+
+TEST(LinearSegmentTest, MatchesPositionOnlyQuinticSpline)
+{
+  // Quintic splines fall back to linear interpolation when only positions are specified
+  typedef QuinticSplineSegment<double> QuinticSegment;
+
+  State start_state(2);
+  start_state.position[0] = 1.0;
+  start_state.position[1] = -2.0;
+  start_state.velocity.clear();
+  start_state.acceleration.clear();
+  State end_state(2);
+  end_state.position[0] = -3.0;
+  end_state.position[1] = 0.5;
+
+  const Segment linear(0.5, start_state, 2.5, end_state);
+  const QuinticSegment quintic(0.5, start_state, 2.5, end_state);
+
+  for (double time = 0.0; time <= 3.0; time += 0.125)
+  {
+    State linear_state;
+    State quintic_state;
+    linear.sample(time, linear_state);
+    quintic.sample(time, quintic_state);
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      EXPECT_NEAR(quintic_state.position[i],     linear_state.position[i],     EPS);
+      EXPECT_NEAR(quintic_state.velocity[i],     linear_state.velocity[i],     EPS);
+      EXPECT_NEAR(quintic_state.acceleration[i], linear_state.acceleration[i], EPS);
+    }
+  }
+}
+
+TEST(LinearSegmentTest, FixedDimension)
+{
+  FixedState start_state;
+  start_state.position[0] = 1.0;
+  start_state.position[1] = 2.0;
+  FixedState end_state;
+  end_state.position[0] = 3.0;
+  end_state.position[1] = 0.0;
+
+  FixedSegment segment(0.0, start_state, 2.0, end_state);
+  EXPECT_EQ(2u, segment.size());
+
+  FixedState state;
+  segment.sample(1.0, state);
+  EXPECT_NEAR(2.0,  state.position[0], EPS);
+  EXPECT_NEAR(1.0,  state.position[1], EPS);
+  EXPECT_NEAR(1.0,  state.velocity[0], EPS);
+  EXPECT_NEAR(-1.0, state.velocity[1], EPS);
+
+  // Trivially copyable types can't own heap memory: Segments store all their data inline
+  EXPECT_TRUE(std::is_trivially_copyable<FixedSegment>::value);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <actionlib/server/action_server.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+#include <joint_trajectory_controller/init_joint_trajectory.h>
+#include <joint_trajectory_controller/multi_joint_trajectory.h>
+#include <joint_trajectory_controller/trajectory_pool.h>
+
+using namespace joint_trajectory_controller;
+using std::string;
+using std::vector;
+
+typedef MultiJointTrajectory<trajectory_interface::QuinticSplineSegment<double> > Trajectory;
+typedef Trajectory::Segment                                                       Segment;
+typedef Trajectory::value_type                                                    TrajectoryPerJoint;
+typedef Trajectory::RealtimeGoalHandlePtr                                         RealtimeGoalHandlePtr;
+
+class MultiJointTrajectoryTest : public ::testing::Test
+{
+public:
+  typedef actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction>                  ActionServer;
+  typedef ActionServer::GoalHandle                                                            GoalHandle;
+  typedef realtime_tools::RealtimeServerGoalHandle<control_msgs::FollowJointTrajectoryAction> RealtimeGoalHandle;
+
+  MultiJointTrajectoryTest()
+    : old_goal(new RealtimeGoalHandle(gh)),
+      new_goal(new RealtimeGoalHandle(gh))
+  {
+    // Two joints with three one-second segments each, associated to the old goal
+    traj.resize(2);
+    for (unsigned int i = 0; i < traj.size(); ++i)
+    {
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        Segment::State start_state(1), end_state(1);
+        start_state.position[0] = i + k;
+        end_state.position[0]   = i + k + 1;
+        traj[i].push_back(Segment(k, start_state, k + 1.0, end_state));
+        traj[i].back().setGoalHandle(old_goal);
+      }
+    }
+  }
+
+protected:
+  GoalHandle            gh;
+  RealtimeGoalHandlePtr old_goal;
+  RealtimeGoalHandlePtr new_goal;
+  Trajectory            traj;
+};
+
+TEST_F(MultiJointTrajectoryTest, CopyOnWrite)
+{
+  const Trajectory& const_traj = traj;
+  Trajectory copy = traj;
+  const Trajectory& const_copy = copy;
+  ASSERT_EQ(2u, copy.size());
+
+  // Copies share per-joint trajectories
+  EXPECT_EQ(&const_traj[0], &const_copy[0]);
+  EXPECT_EQ(&const_traj[1], &const_copy[1]);
+
+  // Writing to a joint copies it first, leaving the original untouched
+  copy[1].pop_back();
+  EXPECT_EQ(&const_traj[0], &const_copy[0]);
+  EXPECT_NE(&const_traj[1], &const_copy[1]);
+  EXPECT_EQ(3u, const_traj[1].size());
+  EXPECT_EQ(2u, const_copy[1].size());
+
+  // Unshared joints are written in place
+  const TrajectoryPerJoint* joint_traj = &const_copy[1];
+  copy[1].pop_back();
+  EXPECT_EQ(joint_traj, &const_copy[1]);
+
+  // Iteration is read-only, and does not copy
+  unsigned int joint_id = 0;
+  for (const TrajectoryPerJoint& each_joint_traj : const_traj) {EXPECT_EQ(&const_traj[joint_id++], &each_joint_traj);}
+  EXPECT_EQ(2u, joint_id);
+}
+
+TEST_F(MultiJointTrajectoryTest, Share)
+{
+  const Trajectory& const_traj = traj;
+  Trajectory result;
+  result.resize(2);
+  result.share(0, traj);
+  result[1] = const_traj[1];
+
+  const Trajectory& const_result = result;
+  EXPECT_EQ(&const_traj[0], &const_result[0]);
+  EXPECT_NE(&const_traj[1], &const_result[1]);
+
+  // Unshareable trajectories are copied
+  traj.setShareable(false);
+  result.share(0, traj);
+  EXPECT_NE(&const_traj[0], &const_result[0]);
+  EXPECT_EQ(const_traj[0].size(), const_result[0].size());
+
+  const Trajectory copy = traj;
+  EXPECT_NE(&const_traj[1], &copy[1]);
+  EXPECT_TRUE(copy.isShareable());
+}
+
+TEST_F(MultiJointTrajectoryTest, GoalHandle)
+{
+  const Trajectory& const_traj = traj;
+  Trajectory result = traj;
+  const Trajectory& const_result = result;
+
+  // Associating shared segments to a goal neither copies nor modifies them
+  result.setGoalHandle(0, 1, new_goal);
+  EXPECT_EQ(&const_traj[0], &const_result[0]);
+  EXPECT_EQ(old_goal, const_traj[0][1].getGoalHandle());
+  EXPECT_EQ(old_goal, const_result[0][1].getGoalHandle());
+
+  EXPECT_EQ(old_goal, result.goalHandle(0, const_result[0].begin()));
+  EXPECT_EQ(new_goal, result.goalHandle(0, const_result[0].begin() + 1));
+  EXPECT_EQ(new_goal, result.goalHandle(0, const_result[0].begin() + 2));
+  EXPECT_EQ(old_goal, result.goalHandle(1, const_result[1].begin() + 2));
+  EXPECT_EQ(old_goal, traj.goalHandle(0, const_traj[0].begin() + 2));
+
+  // The goal carries over when sharing further
+  Trajectory next;
+  next.resize(2);
+  next.share(0, result);
+  EXPECT_EQ(new_goal, next.goalHandle(0, next[0].begin() + 1));
+
+  // Writing to the joint copies it, and applies the goal to the copy
+  result[0];
+  EXPECT_NE(&const_traj[0], &const_result[0]);
+  EXPECT_EQ(old_goal, const_result[0][0].getGoalHandle());
+  EXPECT_EQ(new_goal, const_result[0][1].getGoalHandle());
+  EXPECT_EQ(new_goal, const_result[0][2].getGoalHandle());
+  EXPECT_EQ(old_goal, const_traj[0][2].getGoalHandle());
+
+  // Unshared segments are modified in place
+  result[1];
+  const TrajectoryPerJoint* joint_traj = &const_result[1];
+  result.setGoalHandle(1, 0, new_goal);
+  EXPECT_EQ(joint_traj, &const_result[1]);
+  EXPECT_EQ(new_goal, const_result[1][0].getGoalHandle());
+}
+
+TEST_F(MultiJointTrajectoryTest, Recycle)
+{
+  const Trajectory& const_traj = traj;
+  const std::size_t capacity = const_traj[1].capacity();
+
+  Trajectory copy = traj;
+  copy[1]; // Stops sharing the second joint
+  traj.clearSegments();
+  ASSERT_EQ(2u, traj.size());
+  EXPECT_TRUE(const_traj[0].empty());
+  EXPECT_TRUE(const_traj[1].empty());
+  EXPECT_EQ(3u, copy[0].size()); // Shared segments are released, not cleared
+
+  // Storage of unshared joints is reused when they are added again
+  copy.clear();
+  traj.clear();
+  EXPECT_TRUE(traj.empty());
+  traj.resize(2);
+  EXPECT_EQ(capacity, const_traj[1].capacity());
+}
+
+TEST_F(MultiJointTrajectoryTest, TrajectoryPool)
+{
+  TrajectoryPool<Trajectory> pool;
+  pool.init(1, 2, 10);
+  TrajectoryPool<Trajectory>::Ptr pooled = pool.acquire();
+  pooled->share(0, traj);
+  pooled.reset();
+
+  // Acquiring the trajectory releases the segments it shared
+  pooled = pool.acquire();
+  const Trajectory& const_pooled = *pooled;
+  ASSERT_EQ(2u, pooled->size());
+  EXPECT_TRUE(const_pooled[0].empty());
+  EXPECT_NE(&static_cast<const Trajectory&>(traj)[0], &const_pooled[0]);
+  EXPECT_LE(10u, const_pooled[1].capacity());
+}
+
+TEST_F(MultiJointTrajectoryTest, PartialJointsGoal)
+{
+  vector<string> joint_names;
+  joint_names.push_back("foo_joint");
+  joint_names.push_back("bar_joint");
+
+  // Goal for the second joint only
+  trajectory_msgs::JointTrajectory msg;
+  msg.joint_names.push_back("bar_joint");
+  msg.points.resize(2);
+  msg.points[0].positions.resize(1, 5.0);
+  msg.points[0].time_from_start = ros::Duration(1.0);
+  msg.points[1].positions.resize(1, 6.0);
+  msg.points[1].time_from_start = ros::Duration(2.0);
+  msg.header.stamp = ros::Time(1.5);
+
+  InitJointTrajectoryOptions<Trajectory> options;
+  options.current_trajectory        = &traj;
+  options.joint_names               = &joint_names;
+  options.rt_goal_handle            = new_goal;
+  options.allow_partial_joints_goal = true;
+
+  const ros::Time time(1.5);
+  Trajectory result;
+  initJointTrajectory(msg, time, options, result);
+  ASSERT_EQ(2u, result.size());
+
+  // The joint missing from the goal shares its segments with the current trajectory, which are associated to the new
+  // goal from the active segment on
+  const Trajectory& const_traj   = traj;
+  const Trajectory& const_result = result;
+  EXPECT_EQ(&const_traj[0], &const_result[0]);
+  EXPECT_EQ(old_goal, result.goalHandle(0, const_result[0].begin()));
+  EXPECT_EQ(new_goal, result.goalHandle(0, const_result[0].begin() + 1));
+  EXPECT_EQ(new_goal, result.goalHandle(0, const_result[0].begin() + 2));
+  EXPECT_EQ(old_goal, const_traj[0][1].getGoalHandle());
+
+  // The joint in the goal is rebuilt
+  EXPECT_NE(&const_traj[1], &const_result[1]);
+  ASSERT_EQ(3u, const_result[1].size()); // Active segment + bridge + message
+  EXPECT_EQ(old_goal, result.goalHandle(1, const_result[1].begin()));
+  EXPECT_EQ(new_goal, result.goalHandle(1, const_result[1].begin() + 1));
+  EXPECT_EQ(new_goal, result.goalHandle(1, const_result[1].begin() + 2));
+
+  // A further partial goal for the other joint keeps the goal of the segments it does not replace
+  msg.joint_names[0] = "foo_joint";
+  options.current_trajectory = &result;
+  options.rt_goal_handle     = old_goal;
+  Trajectory next;
+  initJointTrajectory(msg, time, options, next);
+  ASSERT_EQ(2u, next.size());
+  EXPECT_EQ(&const_result[1], &static_cast<const Trajectory&>(next)[1]);
+  EXPECT_EQ(new_goal, next[0].front().getGoalHandle());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JOINT_TRAJECTORY_CONTROLLER_OFFLINE_TRAJECTORY_HARNESS_H
+#define JOINT_TRAJECTORY_CONTROLLER_OFFLINE_TRAJECTORY_HARNESS_H
+
+// C++ standard
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ROS
+#include <ros/node_handle.h>
+
+// ros_control
+#include <hardware_interface/joint_command_interface.h>
+#include <hardware_interface/joint_state_interface.h>
+#include <hardware_interface/robot_hw.h>
+
+// Project
+#include <joint_trajectory_controller/joint_trajectory_controller.h>
+
+namespace joint_trajectory_controller
+{
+
+/**
+ * \brief Position-controlled \ref JointTrajectoryController whose commands are fed directly, without ROS callbacks.
+ */
+template <class SegmentImpl>
+class OfflineTrajectoryController
+  : public JointTrajectoryController<SegmentImpl, hardware_interface::PositionJointInterface>
+{
+public:
+  typedef JointTrajectoryController<SegmentImpl, hardware_interface::PositionJointInterface> Base;
+  typedef typename Base::Segment::State                                                         State;
+  typedef typename Base::RealtimeGoalHandle                                                     RealtimeGoalHandle;
+  typedef typename Base::RealtimeGoalHandlePtr                                                  RealtimeGoalHandlePtr;
+
+  // Lifecycle requests normally issued by the controller manager
+  using Base::initRequest;
+
+  /** \brief Apply \p msg as the \p command topic callback would. */
+  void command(const trajectory_msgs::JointTrajectory::ConstPtr& msg) {this->trajectoryCommandCB(msg);}
+
+  /**
+   * \brief Execute \p msg as an accepted action goal, without an action server. The goal handle records the outcome
+   * requested by update cycles, which is never reported.
+   * \return The goal handle, or a null pointer if \p msg was rejected.
+   */
+  RealtimeGoalHandlePtr goal(const trajectory_msgs::JointTrajectory::ConstPtr& msg)
+  {
+    typename Base::GoalHandle gh;
+    RealtimeGoalHandlePtr rt_goal(new RealtimeGoalHandle(gh));
+    std::lock_guard<std::mutex> lock(this->command_mutex_);
+    if (!this->updateTrajectoryCommand(msg, rt_goal)) {return RealtimeGoalHandlePtr();}
+    this->committed_sequence_ = ++this->command_sequence_;
+    this->rt_active_goal_ = rt_goal;
+    return rt_goal;
+  }
+
+  /** \return Action goal being executed, if any. */
+  RealtimeGoalHandlePtr activeGoal() const {return this->rt_active_goal_;}
+
+  /** \return State desired by the last update cycle. */
+  const State& desiredState() const {return this->desired_state_;}
+};
+
+/**
+ * \brief One update cycle recorded by \ref OfflineTrajectoryHarness.
+ */
+struct OfflineTrajectorySample
+{
+  ros::Time           time;
+  std::vector<double> desired_positions;
+  std::vector<double> desired_velocities;
+  std::vector<double> actual_positions;
+  std::vector<double> actual_velocities;
+};
+
+/**
+ * \brief Deterministic offline execution of trajectories by a position-controlled \ref JointTrajectoryController.
+ *
+ * The harness owns simulated joints and the controller, and runs the controller update loop on a simulated clock, as
+ * fast as the CPU allows. Commands are applied synchronously between update cycles, so that runs are reproducible.
+ *
+ * Simulated joints track their position command with a first-order lag, like the joints of the RRbot test robot:
+ * \code
+ * next_position = smoothing * position + (1 - smoothing) * command
+ * \endcode
+ *
+ * The controller is initialized from the parameters of \p controller_nh, which must not enable background fitting
+ * (\p trajectory_fitting_threads left at zero) for runs to be deterministic. No callbacks need to be spun.
+ *
+ * \code
+ * OfflineTrajectoryHarness<SegmentImpl> harness(joint_names);
+ * ASSERT_TRUE(harness.init(root_nh, controller_nh));
+ * harness.command(msg);
+ * harness.run(ros::Duration(5.0));
+ * \endcode
+ */
+template <class SegmentImpl>
+class OfflineTrajectoryHarness
+{
+public:
+  typedef OfflineTrajectoryController<SegmentImpl> Controller;
+  typedef std::vector<OfflineTrajectorySample>     Samples;
+
+  /**
+   * \param joint_names Names of the simulated joints, which must include those of the controller.
+   * \param period Simulated control period.
+   */
+  explicit OfflineTrajectoryHarness(const std::vector<std::string>& joint_names,
+                                    const ros::Duration&            period = ros::Duration(0.01))
+    : controller_(new Controller),
+      period_(period),
+      time_(0.0),
+      smoothing_(0.0),
+      recording_(false),
+      positions_(joint_names.size(), 0.0),
+      velocities_(joint_names.size(), 0.0),
+      efforts_(joint_names.size(), 0.0),
+      commands_(joint_names.size(), 0.0)
+  {
+    for (unsigned int i = 0; i < joint_names.size(); ++i)
+    {
+      hardware_interface::JointStateHandle state_handle(joint_names[i], &positions_[i], &velocities_[i], &efforts_[i]);
+      state_interface_.registerHandle(state_handle);
+      position_interface_.registerHandle(hardware_interface::JointHandle(state_handle, &commands_[i]));
+    }
+    robot_hw_.registerInterface(&state_interface_);
+    robot_hw_.registerInterface(&position_interface_);
+  }
+
+  /**
+   * \brief Initialize and start the controller, with the joints at rest at \p positions (all zero by default).
+   * \return False if the controller failed to initialize.
+   */
+  bool init(ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh,
+            const std::vector<double>& positions = std::vector<double>())
+  {
+    if (!positions.empty() && positions.size() != positions_.size()) {return false;}
+    if (!positions.empty()) {positions_ = positions;}
+    commands_ = positions_;
+    std::fill(velocities_.begin(), velocities_.end(), 0.0);
+
+    typename Controller::ClaimedResources claimed_resources;
+    return controller_->initRequest(&robot_hw_, root_nh, controller_nh, claimed_resources) &&
+           controller_->startRequest(time_);
+  }
+
+  /** \brief Apply \p msg before the next update cycle. */
+  void command(const trajectory_msgs::JointTrajectory& msg)
+  {
+    controller_->command(trajectory_msgs::JointTrajectory::ConstPtr(new trajectory_msgs::JointTrajectory(msg)));
+  }
+
+  /** \brief Apply \p msg as an action goal before the next update cycle, see \ref OfflineTrajectoryController::goal. */
+  typename Controller::RealtimeGoalHandlePtr goal(const trajectory_msgs::JointTrajectory& msg)
+  {
+    return controller_->goal(trajectory_msgs::JointTrajectory::ConstPtr(new trajectory_msgs::JointTrajectory(msg)));
+  }
+
+  /** \brief Run a single update cycle, then let the simulated joints follow their commands for one period. */
+  void step()
+  {
+    time_ += period_;
+    controller_->updateRequest(time_, period_);
+
+    const double dt = period_.toSec();
+    for (unsigned int i = 0; i < positions_.size(); ++i)
+    {
+      const double next_position = smoothing_ * positions_[i] + (1.0 - smoothing_) * commands_[i];
+      velocities_[i] = (next_position - positions_[i]) / dt;
+      positions_[i]  = next_position;
+    }
+
+    if (recording_) {record();}
+  }
+
+  /** \brief Run update cycles for \p duration of simulated time. */
+  void run(const ros::Duration& duration)
+  {
+    const ros::Time end_time = time_ + duration;
+    while (time_ + period_ <= end_time) {step();}
+  }
+
+  /** \brief Record a sample after each update cycle, or stop doing so. */
+  void setRecording(bool recording) {recording_ = recording;}
+
+  /** \brief Set how closely simulated joints track their command: zero tracks it exactly, one never moves. */
+  void setSmoothing(double smoothing) {smoothing_ = smoothing;}
+
+  const Samples&             samples()    const {return samples_;}
+  void                       clearSamples()     {samples_.clear();}
+  const ros::Time&           time()       const {return time_;}
+  const std::vector<double>& positions()  const {return positions_;}
+  const std::vector<double>& velocities() const {return velocities_;}
+  Controller&                controller()       {return *controller_;}
+
+private:
+  std::unique_ptr<Controller>                controller_;
+  hardware_interface::JointStateInterface    state_interface_;
+  hardware_interface::PositionJointInterface position_interface_;
+  hardware_interface::RobotHW                robot_hw_;
+
+  ros::Duration period_;
+  ros::Time     time_;
+  double        smoothing_;
+  bool          recording_;
+  Samples       samples_;
+
+  std::vector<double> positions_;
+  std::vector<double> velocities_;
+  std::vector<double> efforts_;
+  std::vector<double> commands_;
+
+  void record()
+  {
+    const typename Controller::State& desired_state = controller_->desiredState();
+    OfflineTrajectorySample sample;
+    sample.time               = time_;
+    sample.desired_positions  = desired_state.position;
+    sample.desired_velocities = desired_state.velocity;
+    sample.actual_positions   = positions_;
+    sample.actual_velocities  = velocities_;
+    samples_.push_back(sample);
+  }
+};
+
+} // namespace
+
+#endif // header guard
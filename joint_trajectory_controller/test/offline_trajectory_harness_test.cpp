@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <trajectory_interface/quintic_spline_segment.h>
+
+#include "offline_trajectory_harness.h"
+
+using namespace joint_trajectory_controller;
+
+typedef OfflineTrajectoryHarness<trajectory_interface::QuinticSplineSegment<double> > Harness;
+
+// Floating-point value comparison threshold
+const double EPS = 1e-6;
+
+class OfflineTrajectoryHarnessTest : public ::testing::Test
+{
+public:
+  OfflineTrajectoryHarnessTest()
+    : controller_nh("offline_controller"),
+      joint_names({"joint1", "joint2"})
+  {
+    trajectory_msgs::JointTrajectoryPoint point;
+    point.positions.resize(2, 0.0);
+    point.velocities.resize(2, 0.0);
+    point.accelerations.resize(2, 0.0);
+
+    // Three-point trajectory
+    traj.joint_names = joint_names;
+    traj.points.resize(3, point);
+    traj.points[0].positions[0] =  M_PI / 4.0;
+    traj.points[0].positions[1] =  0.0;
+    traj.points[0].time_from_start = ros::Duration(1.0);
+
+    traj.points[1].positions[0] =  0.0;
+    traj.points[1].positions[1] = -M_PI / 4.0;
+    traj.points[1].time_from_start = ros::Duration(2.0);
+
+    traj.points[2].positions[0] = -M_PI / 4.0;
+    traj.points[2].positions[1] =  M_PI / 4.0;
+    traj.points[2].time_from_start = ros::Duration(4.0);
+  }
+
+protected:
+  ros::NodeHandle root_nh;
+  ros::NodeHandle controller_nh;
+  std::vector<std::string> joint_names;
+  trajectory_msgs::JointTrajectory traj;
+
+  Harness::Samples runTrajectory(double smoothing)
+  {
+    Harness harness(joint_names);
+    EXPECT_TRUE(harness.init(root_nh, controller_nh));
+    harness.setSmoothing(smoothing);
+    harness.setRecording(true);
+    harness.command(traj);
+    harness.run(ros::Duration(5.0));
+    return harness.samples();
+  }
+};
+
+TEST_F(OfflineTrajectoryHarnessTest, ExecuteTrajectory)
+{
+  Harness harness(joint_names);
+  ASSERT_TRUE(harness.init(root_nh, controller_nh));
+  harness.setRecording(true);
+  harness.command(traj);
+
+  // Desired states pass through the trajectory points, which the joints track exactly
+  for (const trajectory_msgs::JointTrajectoryPoint& point : traj.points)
+  {
+    harness.run(point.time_from_start - (harness.time() - ros::Time(0.0)));
+    const OfflineTrajectorySample& sample = harness.samples().back();
+    for (unsigned int i = 0; i < joint_names.size(); ++i)
+    {
+      EXPECT_NEAR(point.positions[i], sample.desired_positions[i], EPS);
+      EXPECT_NEAR(0.0,                sample.desired_velocities[i], EPS);
+    }
+  }
+
+  // One sample per update cycle, at the simulated time
+  harness.run(ros::Duration(1.0));
+  ASSERT_EQ(500u, harness.samples().size());
+  EXPECT_NEAR(5.0, harness.samples().back().time.toSec(), EPS);
+  for (unsigned int i = 0; i < joint_names.size(); ++i)
+  {
+    EXPECT_NEAR(traj.points.back().positions[i], harness.positions()[i], EPS);
+    EXPECT_NEAR(0.0,                             harness.velocities()[i], EPS);
+  }
+}
+
+TEST_F(OfflineTrajectoryHarnessTest, Deterministic)
+{
+  const Harness::Samples samples = runTrajectory(0.5);
+  const Harness::Samples other_samples = runTrajectory(0.5);
+
+  ASSERT_EQ(samples.size(), other_samples.size());
+  for (unsigned int k = 0; k < samples.size(); ++k)
+  {
+    EXPECT_EQ(samples[k].time,               other_samples[k].time);
+    EXPECT_EQ(samples[k].desired_positions,  other_samples[k].desired_positions);
+    EXPECT_EQ(samples[k].desired_velocities, other_samples[k].desired_velocities);
+    EXPECT_EQ(samples[k].actual_positions,   other_samples[k].actual_positions);
+    EXPECT_EQ(samples[k].actual_velocities,  other_samples[k].actual_velocities);
+  }
+
+  // Lagging joints trail the desired state
+  ASSERT_FALSE(samples.empty());
+  EXPECT_NE(samples[50].desired_positions, samples[50].actual_positions);
+}
+
+TEST_F(OfflineTrajectoryHarnessTest, CommandThroughput)
+{
+  Harness harness(joint_names);
+  ASSERT_TRUE(harness.init(root_nh, controller_nh));
+
+  // Short back-to-back motions, each one replacing the previous one halfway through
+  const unsigned int n_commands = 5000;
+  trajectory_msgs::JointTrajectory msg;
+  msg.joint_names = joint_names;
+  msg.points.resize(1);
+  msg.points[0].positions.resize(2);
+  msg.points[0].velocities.resize(2, 0.0);
+  msg.points[0].time_from_start = ros::Duration(0.1);
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned int k = 0; k < n_commands; ++k)
+  {
+    msg.points[0].positions[0] = std::sin(0.01 * k);
+    msg.points[0].positions[1] = std::cos(0.01 * k);
+    harness.command(msg);
+    harness.run(ros::Duration(0.05));
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  RecordProperty("commands_per_second", static_cast<int>(n_commands / elapsed.count()));
+
+  // The last command is completed
+  harness.run(ros::Duration(1.0));
+  for (unsigned int i = 0; i < joint_names.size(); ++i)
+  {
+    EXPECT_NEAR(msg.points[0].positions[i], harness.positions()[i], EPS);
+  }
+}
+
+TEST_F(OfflineTrajectoryHarnessTest, ToleranceCheckStride)
+{
+  const double path_tolerance = 0.05; // See offline_controllers.yaml
+  for (int stride : {1, 4})
+  {
+    controller_nh.setParam("tolerance_check_stride", stride);
+    Harness harness(joint_names);
+    ASSERT_TRUE(harness.init(root_nh, controller_nh));
+    controller_nh.deleteParam("tolerance_check_stride");
+
+    // Joints that don't move fall behind the goal until they violate its path tolerance, which aborts it
+    harness.setSmoothing(1.0);
+    harness.setRecording(true);
+    ASSERT_TRUE(harness.goal(traj));
+    while (harness.controller().activeGoal() && harness.samples().size() < 500) {harness.step();}
+    ASSERT_FALSE(harness.controller().activeGoal()) << "stride " << stride;
+
+    // First cycle with a state error past the tolerance. The joints stay at rest at zero
+    const Harness::Samples& samples = harness.samples();
+    std::size_t violation_cycle = 0;
+    while (violation_cycle < samples.size() &&
+           std::abs(samples[violation_cycle].desired_positions[0]) <= path_tolerance &&
+           std::abs(samples[violation_cycle].desired_positions[1]) <= path_tolerance)
+    {
+      ++violation_cycle;
+    }
+
+    // Tolerances are only checked on every stride-th cycle, starting with the first one, so the violation is detected
+    // on the first of them at or after it
+    const std::size_t abort_cycle = samples.size() - 1;
+    EXPECT_EQ(0u, abort_cycle % stride) << "stride " << stride;
+    EXPECT_LE(violation_cycle, abort_cycle) << "stride " << stride;
+    EXPECT_GT(violation_cycle + stride, abort_cycle) << "stride " << stride;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "offline_trajectory_harness_test");
+  int ret = RUN_ALL_TESTS();
+  ros::shutdown();
+  return ret;
+}
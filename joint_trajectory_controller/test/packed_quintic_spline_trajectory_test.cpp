@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trajectory_interface/packed_quintic_spline_trajectory.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+#include <trajectory_interface/trajectory_interface.h>
+
+using namespace trajectory_interface;
+
+// Floating-point value comparison threshold
+const double EPS = 1e-9;
+
+typedef QuinticSplineSegment<double>          Segment;
+typedef Segment::State                        State;
+typedef std::vector<Segment>                  TrajectoryPerJoint;
+typedef std::vector<TrajectoryPerJoint>       Trajectory;
+typedef PackedQuinticSplineTrajectory<double> PackedTrajectory;
+
+State makeState(double pos, double vel, double acc)
+{
+  State state(1);
+  state.position[0]     = pos;
+  state.velocity[0]     = vel;
+  state.acceleration[0] = acc;
+  return state;
+}
+
+/** Trajectory with \p n_joints joints sharing segment boundaries, and a gap between the first and second segments. */
+Trajectory makeTrajectory(unsigned int n_joints, unsigned int n_segments)
+{
+  Trajectory trajectory(n_joints);
+  for (unsigned int j = 0; j < n_joints; ++j)
+  {
+    for (unsigned int k = 0; k < n_segments; ++k)
+    {
+      const double j_val      = j;
+      const double k_val      = k;
+      const double start_time = (k == 0) ? 0.0 : k_val + 0.5;
+      const double end_time   = k_val + 1.0;
+      trajectory[j].push_back(Segment(start_time, makeState(j_val + k_val, 0.1 * j_val, -0.2 * k_val),
+                                      end_time,   makeState(j_val - k_val, 0.5 * k_val, 0.3 * j_val)));
+    }
+  }
+  return trajectory;
+}
+
+void checkSamplesMatch(const Trajectory& trajectory, const PackedTrajectory& packed, double time,
+                       PackedTrajectory::size_type& cursor)
+{
+  State packed_state(trajectory.size());
+  const PackedTrajectory::size_type index = packed.sample(time, packed_state, cursor);
+  for (unsigned int j = 0; j < trajectory.size(); ++j)
+  {
+    State state;
+    TrajectoryPerJoint::const_iterator it = sample(trajectory[j], time, state);
+    const PackedTrajectory::size_type ref_index = (it == trajectory[j].end()) ? packed.size()
+                                                                              : it - trajectory[j].begin();
+    EXPECT_EQ(ref_index, index);
+    EXPECT_NEAR(state.position[0],     packed_state.position[j],     EPS);
+    EXPECT_NEAR(state.velocity[0],     packed_state.velocity[j],     EPS);
+    EXPECT_NEAR(state.acceleration[0], packed_state.acceleration[j], EPS);
+  }
+}
+
+TEST(PackedQuinticSplineTrajectoryTest, EmptyTrajectory)
+{
+  PackedTrajectory packed;
+  EXPECT_TRUE(packed.empty());
+  EXPECT_EQ(0u, packed.size());
+  EXPECT_EQ(0u, packed.dimension());
+
+  EXPECT_FALSE(packed.init(Trajectory()));
+  EXPECT_FALSE(packed.init(Trajectory(3)));
+  EXPECT_TRUE(packed.empty());
+}
+
+TEST(PackedQuinticSplineTrajectoryTest, MismatchingSegmentBoundaries)
+{
+  PackedTrajectory packed;
+
+  // Different number of segments
+  {
+    Trajectory trajectory = makeTrajectory(3, 4);
+    trajectory[1].pop_back();
+    EXPECT_FALSE(packed.init(trajectory));
+    EXPECT_TRUE(packed.empty());
+  }
+
+  // Different segment start time
+  {
+    Trajectory trajectory = makeTrajectory(3, 4);
+    trajectory[2][1] = Segment(1.25, makeState(0.0, 0.0, 0.0), 2.0, makeState(1.0, 0.0, 0.0));
+    EXPECT_FALSE(packed.init(trajectory));
+  }
+
+  // Different segment duration
+  {
+    Trajectory trajectory = makeTrajectory(3, 4);
+    trajectory[0][3] = Segment(3.5, makeState(0.0, 0.0, 0.0), 5.0, makeState(1.0, 0.0, 0.0));
+    EXPECT_FALSE(packed.init(trajectory));
+  }
+
+  // Multi-dimensional segments
+  {
+    Trajectory trajectory = makeTrajectory(2, 1);
+    trajectory[0][0] = Segment(0.0, State(2), 1.0, State(2));
+    EXPECT_FALSE(packed.init(trajectory));
+  }
+
+  // A failed initialization discards previous data
+  EXPECT_TRUE(packed.init(makeTrajectory(3, 4)));
+  EXPECT_FALSE(packed.init(Trajectory(3)));
+  EXPECT_TRUE(packed.empty());
+}
+
+TEST(PackedQuinticSplineTrajectoryTest, SampleMatchesPerJointTrajectory)
+{
+  // Joint counts smaller than, equal to and larger than a cache line worth of scalars
+  const unsigned int joint_counts[] = {1, 7, 8, 9, 20};
+  for (unsigned int n_joints : joint_counts)
+  {
+    const unsigned int n_segments = 10;
+    const Trajectory trajectory = makeTrajectory(n_joints, n_segments);
+
+    PackedTrajectory packed;
+    ASSERT_TRUE(packed.init(trajectory));
+    EXPECT_EQ(n_segments, packed.size());
+    EXPECT_EQ(n_joints, packed.dimension());
+
+    // Monotonic sampling, including before start, gaps between segments, and after end
+    PackedTrajectory::size_type cursor = 0;
+    for (double time = -1.0; time < n_segments + 1.0; time += 0.05)
+    {
+      checkSamplesMatch(trajectory, packed, time, cursor);
+    }
+
+    // Time jumps
+    const double jump_times[] = {8.75, 0.25, 5.0, 5.5, -3.0, 2.7};
+    for (double time : jump_times)
+    {
+      checkSamplesMatch(trajectory, packed, time, cursor);
+    }
+  }
+}
+
+TEST(PackedQuinticSplineTrajectoryTest, Copy)
+{
+  const Trajectory trajectory = makeTrajectory(5, 3);
+  PackedTrajectory packed;
+  ASSERT_TRUE(packed.init(trajectory));
+
+  const PackedTrajectory packed_copy = packed;
+  PackedTrajectory::size_type cursor = 0;
+  checkSamplesMatch(trajectory, packed_copy, 1.75, cursor);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/parallel_update.h>
+
+using joint_trajectory_controller::ParallelUpdate;
+
+namespace
+{
+
+/** \return CPU time of all threads of the process [s]. */
+double processCpuTime()
+{
+  timespec time;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+  return time.tv_sec + 1e-9 * time.tv_nsec;
+}
+
+} // namespace
+
+TEST(ParallelUpdateTest, Groups)
+{
+  ParallelUpdate parallel_update;
+  EXPECT_EQ(1u, parallel_update.groups());
+
+  parallel_update.start(0, std::vector<int>(), 0);
+  EXPECT_EQ(1u, parallel_update.groups());
+
+  parallel_update.start(3, std::vector<int>(), 0);
+  EXPECT_EQ(3u, parallel_update.groups());
+
+  parallel_update.start(2, std::vector<int>(), 0);
+  EXPECT_EQ(2u, parallel_update.groups());
+}
+
+TEST(ParallelUpdateTest, SerialWithoutHelpers)
+{
+  ParallelUpdate parallel_update;
+  std::vector<std::size_t> calls;
+  auto function = [&calls](std::size_t group) {calls.push_back(group);};
+  parallel_update.run(function);
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ(0u, calls[0]);
+}
+
+TEST(ParallelUpdateTest, CallsEveryGroupOncePerRun)
+{
+  ParallelUpdate parallel_update;
+  parallel_update.start(4, std::vector<int>(), 0);
+
+  std::vector<unsigned int> calls(4, 0);
+  std::vector<std::thread::id> threads(4);
+  auto function = [&](std::size_t group)
+  {
+    ++calls[group];
+    threads[group] = std::this_thread::get_id();
+  };
+
+  for (unsigned int run = 1; run <= 1000; ++run)
+  {
+    parallel_update.run(function);
+    for (std::size_t group = 0; group < calls.size(); ++group) {ASSERT_EQ(run, calls[group]);}
+  }
+
+  // The first group is processed by the calling thread, the others by distinct helpers
+  EXPECT_EQ(std::this_thread::get_id(), threads[0]);
+  EXPECT_EQ(4u, std::set<std::thread::id>(threads.begin(), threads.end()).size());
+}
+
+TEST(ParallelUpdateTest, WritesAreVisibleAfterRun)
+{
+  ParallelUpdate parallel_update;
+  parallel_update.start(3, std::vector<int>(), 0);
+
+  const std::size_t size = 100;
+  std::vector<double> data(size, 0.0);
+  for (unsigned int run = 1; run <= 100; ++run)
+  {
+    auto function = [&](std::size_t group)
+    {
+      const std::size_t end = parallel_update.begin(size, group + 1);
+      for (std::size_t i = parallel_update.begin(size, group); i < end; ++i) {data[i] += i;}
+    };
+    parallel_update.run(function);
+    for (std::size_t i = 0; i < size; ++i) {ASSERT_EQ(static_cast<double>(run * i), data[i]);}
+  }
+}
+
+TEST(ParallelUpdateTest, EvenRanges)
+{
+  ParallelUpdate parallel_update;
+  parallel_update.start(3, std::vector<int>(), 0);
+  EXPECT_EQ(0u,  parallel_update.begin(10, 0));
+  EXPECT_EQ(3u,  parallel_update.begin(10, 1));
+  EXPECT_EQ(6u,  parallel_update.begin(10, 2));
+  EXPECT_EQ(10u, parallel_update.begin(10, 3));
+
+  // Groups without items have empty ranges
+  EXPECT_EQ(0u, parallel_update.begin(2, 1));
+  EXPECT_EQ(1u, parallel_update.begin(2, 2));
+  EXPECT_EQ(2u, parallel_update.begin(2, 3));
+}
+
+TEST(ParallelUpdateTest, InvalidPlacement)
+{
+  ParallelUpdate parallel_update;
+  EXPECT_FALSE(parallel_update.start(2, std::vector<int>(1, CPU_SETSIZE - 1), 0));
+  EXPECT_EQ(2u, parallel_update.groups());
+
+  std::vector<unsigned int> calls(2, 0);
+  auto function = [&calls](std::size_t group) {++calls[group];};
+  parallel_update.run(function);
+  EXPECT_EQ(1u, calls[0]);
+  EXPECT_EQ(1u, calls[1]);
+}
+
+TEST(ParallelUpdateTest, ParkedHelpersSleep)
+{
+  ParallelUpdate parallel_update;
+  parallel_update.start(3, std::vector<int>(), 0);
+  std::vector<unsigned int> calls(3, 0);
+  auto function = [&calls](std::size_t group) {++calls[group];};
+  parallel_update.run(function);
+
+  // Busy-waiting helpers would take about as much CPU time as the wall-clock time each
+  parallel_update.park();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Let the helpers go to sleep
+  const double cpu_time = processCpuTime();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_LT(processCpuTime() - cpu_time, 0.05);
+
+  // Woken on demand
+  parallel_update.unpark();
+  parallel_update.run(function);
+  EXPECT_EQ(std::vector<unsigned int>(3, 2), calls);
+
+  // Woken by a run while parked, and joined while parked
+  parallel_update.park();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  parallel_update.run(function);
+  EXPECT_EQ(std::vector<unsigned int>(3, 3), calls);
+  parallel_update.park();
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trajectory_interface/quintic_spline_batch.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+
+using namespace trajectory_interface;
+
+// Floating-point value comparison threshold
+const double EPS = 1e-9;
+
+typedef QuinticSplineSegment<double> Segment;
+typedef Segment::State               State;
+
+class QuinticSplineBatchTest : public ::testing::Test
+{
+public:
+  QuinticSplineBatchTest()
+    : duration(1.5)
+  {
+    std::srand(42);
+    for (unsigned int j = 0; j < MAX_SIZE; ++j)
+    {
+      State start_state(1);
+      start_state.position[0]     = random();
+      start_state.velocity[0]     = random();
+      start_state.acceleration[0] = random();
+      State end_state(1);
+      end_state.position[0]     = random();
+      end_state.velocity[0]     = random();
+      end_state.acceleration[0] = random();
+      segments.push_back(Segment(0.0, start_state, duration, end_state));
+
+      for (unsigned int order = 0; order < 6; ++order)
+      {
+        rows[order].push_back(segments.back().coefficients(0)[order]);
+      }
+    }
+  }
+
+protected:
+  static const unsigned int MAX_SIZE = 19;
+
+  double duration;
+  std::vector<Segment> segments;
+  std::vector<double>  rows[6];
+
+  static double random() {return 10.0 * std::rand() / RAND_MAX - 5.0;}
+
+  QuinticSplineBatch<double> makeBatch(std::size_t size) const
+  {
+    QuinticSplineBatch<double> batch;
+    for (unsigned int order = 0; order < 6; ++order) {batch.coefs[order] = rows[order].data();}
+    batch.size = size;
+    return batch;
+  }
+};
+
+TEST_F(QuinticSplineBatchTest, MatchesSegmentSampling)
+{
+  // All sizes up to several vector widths, to exercise vectorized and remainder code paths
+  for (std::size_t size = 0; size <= MAX_SIZE; ++size)
+  {
+    const QuinticSplineBatch<double> batch = makeBatch(size);
+    for (double t = 0.0; t <= duration; t += 0.1)
+    {
+      std::vector<double> pos(size), vel(size), acc(size);
+      sampleQuinticSplineBatch(batch, t, pos.data(), vel.data(), acc.data());
+      for (std::size_t j = 0; j < size; ++j)
+      {
+        State state;
+        segments[j].sample(t, state);
+        EXPECT_NEAR(state.position[0],     pos[j], EPS);
+        EXPECT_NEAR(state.velocity[0],     vel[j], EPS);
+        EXPECT_NEAR(state.acceleration[0], acc[j], EPS);
+      }
+    }
+  }
+}
+
+TEST_F(QuinticSplineBatchTest, OutputBounds)
+{
+  // Elements past the batch size are not written
+  const std::size_t size = 5;
+  const QuinticSplineBatch<double> batch = makeBatch(size);
+  const double sentinel = 1234.0;
+  std::vector<double> pos(size + 4, sentinel), vel(size + 4, sentinel), acc(size + 4, sentinel);
+  sampleQuinticSplineBatch(batch, 0.5, pos.data(), vel.data(), acc.data());
+  for (std::size_t j = size; j < pos.size(); ++j)
+  {
+    EXPECT_EQ(sentinel, pos[j]);
+    EXPECT_EQ(sentinel, vel[j]);
+    EXPECT_EQ(sentinel, acc[j]);
+  }
+}
+
+TEST(QuinticSplineBatchScalarTest, FloatScalars)
+{
+  // Non-double scalar types use the portable implementation
+  float c[6][2] = {{1.0f, 2.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 1.0f}};
+  QuinticSplineBatch<float> batch;
+  for (unsigned int order = 0; order < 6; ++order) {batch.coefs[order] = c[order];}
+  batch.size = 2;
+
+  float pos[2], vel[2], acc[2];
+  sampleQuinticSplineBatch(batch, 2.0f, pos, vel, acc);
+  EXPECT_FLOAT_EQ(3.0f,  pos[0]); // 1 + t
+  EXPECT_FLOAT_EQ(1.0f,  vel[0]);
+  EXPECT_FLOAT_EQ(0.0f,  acc[0]);
+  EXPECT_FLOAT_EQ(38.0f, pos[1]); // 2 + t^2 + t^5
+  EXPECT_FLOAT_EQ(84.0f, vel[1]); // 2t + 5t^4
+  EXPECT_FLOAT_EQ(162.0f, acc[1]); // 2 + 20t^3
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
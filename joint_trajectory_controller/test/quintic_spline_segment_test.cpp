@@ -29,6 +29,7 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <type_traits>
 #include <gtest/gtest.h>
 #include <ros/console.h>
 #include <trajectory_interface/quintic_spline_segment.h>
@@ -42,6 +43,9 @@ typedef QuinticSplineSegment<double> Segment;
 typedef typename Segment::State State;
 typedef typename Segment::Time  Time;
 
+typedef QuinticSplineSegment<double, 2> FixedSegment;
+typedef typename FixedSegment::State    FixedState;
+
 TEST(QuinticSplineSegmentTest, StateConstructor)
 {
   const unsigned int size = 5;
@@ -551,6 +555,69 @@ TEST(QuinticSplineSegmentTest, MultiDofTest)
   }
 }
 
+TEST(QuinticSplineSegmentTest, FixedDimension)
+{
+  const Time start_time = 1.0;
+  const Time end_time   = 3.0;
+
+  FixedState fixed_start_state;
+  fixed_start_state.position     = {{0.5, -1.0}};
+  fixed_start_state.velocity     = {{0.0,  1.0}};
+  fixed_start_state.acceleration = {{2.0,  0.0}};
+  FixedState fixed_end_state;
+  fixed_end_state.position     = {{1.5, -2.0}};
+  fixed_end_state.velocity     = {{0.5,  0.0}};
+  fixed_end_state.acceleration = {{0.0, -1.0}};
+
+  State start_state(2);
+  start_state.position.assign(fixed_start_state.position.begin(), fixed_start_state.position.end());
+  start_state.velocity.assign(fixed_start_state.velocity.begin(), fixed_start_state.velocity.end());
+  start_state.acceleration.assign(fixed_start_state.acceleration.begin(), fixed_start_state.acceleration.end());
+  State end_state(2);
+  end_state.position.assign(fixed_end_state.position.begin(), fixed_end_state.position.end());
+  end_state.velocity.assign(fixed_end_state.velocity.begin(), fixed_end_state.velocity.end());
+  end_state.acceleration.assign(fixed_end_state.acceleration.begin(), fixed_end_state.acceleration.end());
+
+  const FixedSegment fixed_segment(start_time, fixed_start_state, end_time, fixed_end_state);
+  const Segment      segment(start_time, start_state, end_time, end_state);
+  EXPECT_EQ(2u, fixed_segment.size());
+  EXPECT_EQ(segment.startTime(), fixed_segment.startTime());
+  EXPECT_EQ(segment.endTime(),   fixed_segment.endTime());
+
+  // Fixed and dynamic segments are sampled identically
+  for (Time time = start_time - 1.0; time <= end_time + 1.0; time += 0.1)
+  {
+    FixedState fixed_state;
+    State      state;
+    fixed_segment.sample(time, fixed_state);
+    segment.sample(time, state);
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      EXPECT_EQ(state.position[i],     fixed_state.position[i]);
+      EXPECT_EQ(state.velocity[i],     fixed_state.velocity[i]);
+      EXPECT_EQ(state.acceleration[i], fixed_state.acceleration[i]);
+    }
+  }
+
+  // Default-constructed fixed segments have the fixed size
+  EXPECT_EQ(2u, FixedSegment().size());
+}
+
+TEST(QuinticSplineSegmentTest, FixedDimensionStorage)
+{
+  // Trivially copyable types can't own heap memory: Segments and states store all their data inline
+  EXPECT_TRUE(std::is_trivially_copyable<FixedSegment>::value);
+  EXPECT_TRUE(std::is_trivially_copyable<FixedState>::value);
+}
+
+TEST(QuinticSplineSegmentTest, InvalidFixedDimensionSegmentConstruction)
+{
+  // Fixed-dimension states can't be empty nor have a different size, so only time bounds are checked
+  FixedState state;
+  EXPECT_THROW(FixedSegment(1.0, state, 0.0, state), std::invalid_argument);
+  EXPECT_NO_THROW(FixedSegment(0.0, state, 0.0, state));
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/realtime_shared_box.h>
+
+using joint_trajectory_controller::RealtimeSharedBox;
+
+typedef RealtimeSharedBox<int> Box;
+typedef Box::Ptr               Ptr;
+
+void waitForReleases(const Box& box)
+{
+  const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (box.pendingReleases() > 0 && std::chrono::steady_clock::now() < timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(RealtimeSharedBoxTest, Empty)
+{
+  Box box;
+  EXPECT_FALSE(box.get());
+  EXPECT_EQ(nullptr, box.getFromRT());
+}
+
+TEST(RealtimeSharedBoxTest, SetAndGet)
+{
+  Box box;
+  Ptr a(new int(1));
+  Ptr b(new int(2));
+
+  box.set(a);
+  EXPECT_EQ(a, box.get());
+  EXPECT_EQ(a.get(), box.getFromRT());
+
+  box.set(b);
+  EXPECT_EQ(b, box.get());
+  EXPECT_EQ(b.get(), box.getFromRT());
+}
+
+TEST(RealtimeSharedBoxTest, Default)
+{
+  Box box;
+  Ptr def(new int(0));
+  Ptr a(new int(1));
+  box.initDefault(def);
+
+  box.setDefault();
+  EXPECT_EQ(def, box.get());
+  EXPECT_EQ(def.get(), box.getFromRT());
+
+  box.set(a);
+  EXPECT_EQ(a.get(), box.getFromRT());
+
+  box.setDefault();
+  EXPECT_EQ(def, box.get());
+  EXPECT_EQ(def.get(), box.getFromRT());
+
+  // Publishing the default value explicitly is equivalent
+  box.set(a);
+  box.set(def);
+  EXPECT_EQ(def, box.get());
+  EXPECT_EQ(def.get(), box.getFromRT());
+}
+
+TEST(RealtimeSharedBoxTest, CompareAndSet)
+{
+  Box box;
+  Ptr def(new int(0));
+  Ptr a(new int(1));
+  Ptr b(new int(2));
+  box.initDefault(def);
+  box.set(a);
+
+  // Publishes if the expected value is still the latest one
+  EXPECT_TRUE(box.compareAndSet(a, b));
+  EXPECT_EQ(b, box.get());
+  EXPECT_EQ(b.get(), box.getFromRT());
+
+  // Doesn't undo a newer value, e.g. the default value published from the real-time thread
+  box.setDefault();
+  EXPECT_FALSE(box.compareAndSet(b, a));
+  EXPECT_EQ(def, box.get());
+  EXPECT_EQ(def.get(), box.getFromRT());
+
+  // Values published this way are kept alive by the box
+  std::weak_ptr<int> c_weak;
+  {
+    Ptr c(new int(3));
+    c_weak = c;
+    EXPECT_TRUE(box.compareAndSet(def, c));
+  }
+  EXPECT_FALSE(c_weak.expired());
+  EXPECT_EQ(3, *box.getFromRT());
+}
+
+TEST(RealtimeSharedBoxTest, Ownership)
+{
+  Box box;
+  std::weak_ptr<int> a_weak;
+  {
+    Ptr a(new int(1));
+    a_weak = a;
+    box.set(a);
+    EXPECT_EQ(a.get(), box.getFromRT());
+  }
+  // The box keeps published values alive
+  EXPECT_FALSE(a_weak.expired());
+
+  // The real-time thread still uses the previous value, which must not be released
+  box.set(Ptr(new int(2)));
+  EXPECT_FALSE(a_weak.expired());
+
+  // Once the real-time thread moved on, the previous value is released on the next publication
+  EXPECT_EQ(2, *box.getFromRT());
+  box.set(Ptr(new int(3)));
+  waitForReleases(box);
+  EXPECT_TRUE(a_weak.expired());
+}
+
+TEST(RealtimeSharedBoxTest, DeferredDestruction)
+{
+  Box box;
+  std::weak_ptr<int> a_weak;
+  {
+    Ptr a(new int(1));
+    a_weak = a;
+    box.set(a);
+  }
+
+  // Releasing a value destroys it in the background, without blocking the publishing thread
+  box.set(Ptr(new int(2)));
+  waitForReleases(box);
+  EXPECT_TRUE(a_weak.expired());
+  EXPECT_EQ(0u, box.pendingReleases());
+}
+
+TEST(RealtimeSharedBoxTest, ConcurrentAccess)
+{
+  const int n = 20000;
+  Box box;
+  box.set(Ptr(new int(0)));
+  std::atomic<bool> done(false);
+
+  std::thread writer([&box, &done, n]()
+  {
+    for (int i = 1; i <= n; ++i) {box.set(Ptr(new int(i)));}
+    done = true;
+  });
+
+  // Values are always alive and never go back in time
+  int last = 0;
+  bool ok = true;
+  while (!done)
+  {
+    const int value = *box.getFromRT();
+    ok = ok && (value >= last);
+    last = value;
+  }
+  writer.join();
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(n, *box.getFromRT());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
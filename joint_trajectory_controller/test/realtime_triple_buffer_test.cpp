@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/realtime_triple_buffer.h>
+
+using joint_trajectory_controller::RealtimeTripleBuffer;
+
+TEST(RealtimeTripleBufferTest, InitialValue)
+{
+  RealtimeTripleBuffer<int> buffer(3);
+  EXPECT_EQ(3, buffer.read());
+  EXPECT_EQ(3, buffer.read());
+}
+
+TEST(RealtimeTripleBufferTest, ReadLatestWrite)
+{
+  RealtimeTripleBuffer<int> buffer(0);
+
+  buffer.write(1);
+  EXPECT_EQ(1, buffer.read());
+
+  // Reading without new data keeps returning the last value
+  EXPECT_EQ(1, buffer.read());
+
+  // Only the latest of several writes is observed
+  buffer.write(2);
+  buffer.write(3);
+  buffer.write(4);
+  EXPECT_EQ(4, buffer.read());
+  EXPECT_EQ(4, buffer.read());
+}
+
+TEST(RealtimeTripleBufferTest, Reset)
+{
+  RealtimeTripleBuffer<int> buffer(0);
+  buffer.write(1);
+  buffer.reset(5);
+  EXPECT_EQ(5, buffer.read());
+
+  buffer.write(6);
+  EXPECT_EQ(6, buffer.read());
+}
+
+struct Pair
+{
+  Pair(long v = 0) : first(v), second(v) {}
+  long first;
+  long second;
+};
+
+TEST(RealtimeTripleBufferTest, ConcurrentAccess)
+{
+  const long n = 100000;
+  RealtimeTripleBuffer<Pair> buffer(Pair(0));
+  std::atomic<bool> done(false);
+
+  std::thread writer([&buffer, &done, n]()
+  {
+    for (long i = 1; i <= n; ++i) {buffer.write(Pair(i));}
+    done = true;
+  });
+
+  // Values are never torn, and never go back in time
+  long last = 0;
+  bool ok = true;
+  while (!done)
+  {
+    const Pair& value = buffer.read();
+    ok = ok && (value.first == value.second) && (value.first >= last);
+    last = value.first;
+  }
+  writer.join();
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(n, buffer.read().first);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
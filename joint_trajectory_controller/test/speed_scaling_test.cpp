@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/speed_scaling.h>
+
+using joint_trajectory_controller::SpeedScaling;
+
+const double EPS = 1e-9;
+
+TEST(SpeedScalingTest, Default)
+{
+  SpeedScaling scaling;
+  EXPECT_EQ(1.0, scaling.target());
+  EXPECT_EQ(1.0, scaling.scale());
+  EXPECT_EQ(0.0, scaling.rate());
+  EXPECT_FALSE(scaling.active());
+
+  // Unscaled trajectories progress with the controller time
+  EXPECT_NEAR(0.01, scaling.update(0.01), EPS);
+  EXPECT_FALSE(scaling.active());
+}
+
+TEST(SpeedScalingTest, InvalidTarget)
+{
+  SpeedScaling scaling;
+  EXPECT_FALSE(scaling.setTarget(std::numeric_limits<double>::quiet_NaN()));
+  EXPECT_FALSE(scaling.setTarget(std::numeric_limits<double>::infinity()));
+  EXPECT_EQ(1.0, scaling.target());
+
+  // Trajectories never run backwards
+  EXPECT_TRUE(scaling.setTarget(-1.0));
+  EXPECT_EQ(0.0, scaling.target());
+}
+
+TEST(SpeedScalingTest, Step)
+{
+  // Without time constant, the scale jumps to its target
+  SpeedScaling scaling;
+  scaling.setTarget(0.5);
+  EXPECT_NEAR(0.0075, scaling.update(0.01), EPS); // Trapezoidal integration of the step
+  EXPECT_EQ(0.5, scaling.scale());
+  EXPECT_EQ(0.0, scaling.rate());
+  EXPECT_TRUE(scaling.active());
+  EXPECT_NEAR(0.005, scaling.update(0.01), EPS);
+}
+
+TEST(SpeedScalingTest, Reset)
+{
+  SpeedScaling scaling;
+  scaling.setTimeConstant(0.1);
+  scaling.setTarget(0.0);
+  scaling.reset();
+  EXPECT_EQ(0.0, scaling.scale());
+  EXPECT_EQ(0.0, scaling.rate());
+
+  // Paused trajectories don't progress
+  EXPECT_EQ(0.0, scaling.update(0.01));
+}
+
+TEST(SpeedScalingTest, SmoothTransition)
+{
+  const double period = 0.001;
+  SpeedScaling scaling;
+  scaling.setTimeConstant(0.05);
+  scaling.setTarget(0.0);
+
+  // The scale and its rate are continuous, and the scale decreases monotonically without undershooting
+  double prev_scale = scaling.scale();
+  double prev_rate  = scaling.rate();
+  double max_rate_step = 0.0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double elapsed = scaling.update(period);
+    EXPECT_LE(scaling.scale(), prev_scale);
+    EXPECT_GE(scaling.scale(), 0.0);
+    EXPECT_LT(std::abs(scaling.scale() - prev_scale), 1.0 / 0.05 * period);
+    EXPECT_NEAR(0.5 * (prev_scale + scaling.scale()) * period, elapsed, EPS);
+    max_rate_step = std::max(max_rate_step, std::abs(scaling.rate() - prev_rate));
+    prev_scale = scaling.scale();
+    prev_rate  = scaling.rate();
+  }
+  EXPECT_LT(max_rate_step, 1.0 / (0.05 * 0.05) * period);
+
+  // Settles exactly on the target
+  EXPECT_EQ(0.0, scaling.scale());
+  EXPECT_EQ(0.0, scaling.rate());
+
+  // ...and back to unscaled execution
+  scaling.setTarget(1.0);
+  for (int i = 0; i < 1000; ++i) {scaling.update(period);}
+  EXPECT_FALSE(scaling.active());
+}
+
+TEST(SpeedScalingTest, LargePeriod)
+{
+  // The filter solution is exact, so it neither overshoots nor diverges with periods larger than the time constant
+  SpeedScaling scaling;
+  scaling.setTimeConstant(0.01);
+  scaling.setTarget(2.0);
+  for (int i = 0; i < 100; ++i)
+  {
+    scaling.update(0.1);
+    EXPECT_LE(scaling.scale(), 2.0 + EPS);
+  }
+  EXPECT_EQ(2.0, scaling.scale());
+}
+
+TEST(SpeedScalingTest, ScaleState)
+{
+  SpeedScaling scaling;
+  scaling.setTimeConstant(0.1);
+  scaling.setTarget(0.0);
+  scaling.update(0.05);
+  const double s  = scaling.scale();
+  const double ds = scaling.rate();
+  ASSERT_LT(ds, 0.0);
+
+  double velocity     = 2.0;
+  double acceleration = 3.0;
+  scaling.scaleState(velocity, acceleration);
+  EXPECT_NEAR(s * 2.0, velocity, EPS);
+  EXPECT_NEAR(s * s * 3.0 + ds * 2.0, acceleration, EPS);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
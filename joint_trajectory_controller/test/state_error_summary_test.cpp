@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/state_error_summary.h>
+#include <trajectory_interface/pos_vel_acc_state.h>
+
+using joint_trajectory_controller::StateErrorSummary;
+
+typedef trajectory_interface::PosVelAccState<double> State;
+typedef StateErrorSummary<State> Summary;
+
+TEST(StateErrorSummaryTest, Empty)
+{
+  Summary summary;
+  summary.resize(2);
+  EXPECT_EQ(2u, summary.size());
+  EXPECT_EQ(0u, summary.count());
+
+  // No samples: All statistics are zero
+  std::vector<double> data(2 * Summary::STATISTICS_SIZE, 1.0);
+  summary.write(data);
+  for (double value : data) {EXPECT_EQ(0.0, value);}
+}
+
+TEST(StateErrorSummaryTest, Statistics)
+{
+  Summary summary;
+  summary.resize(2);
+
+  State error(2);
+  const double position_errors[] = {1.0, -2.0, 4.0};
+  for (double position_error : position_errors)
+  {
+    error.position[0] = position_error;
+    error.position[1] = 10.0 * position_error;
+    error.velocity[0] = -position_error;
+    error.velocity[1] = 0.5;
+    summary.add(error);
+  }
+  EXPECT_EQ(3u, summary.count());
+
+  std::vector<double> data(2 * Summary::STATISTICS_SIZE);
+  summary.write(data);
+  EXPECT_EQ(-2.0, data[Summary::POSITION_MIN]);
+  EXPECT_EQ( 4.0, data[Summary::POSITION_MAX]);
+  EXPECT_EQ( 1.0, data[Summary::POSITION_MEAN]);
+  EXPECT_EQ(-4.0, data[Summary::VELOCITY_MIN]);
+  EXPECT_EQ( 2.0, data[Summary::VELOCITY_MAX]);
+  EXPECT_EQ(-1.0, data[Summary::VELOCITY_MEAN]);
+
+  const std::size_t offset = Summary::STATISTICS_SIZE; // Second joint
+  EXPECT_EQ(-20.0, data[offset + Summary::POSITION_MIN]);
+  EXPECT_EQ( 40.0, data[offset + Summary::POSITION_MAX]);
+  EXPECT_EQ( 10.0, data[offset + Summary::POSITION_MEAN]);
+  EXPECT_EQ(  0.5, data[offset + Summary::VELOCITY_MIN]);
+  EXPECT_EQ(  0.5, data[offset + Summary::VELOCITY_MAX]);
+  EXPECT_EQ(  0.5, data[offset + Summary::VELOCITY_MEAN]);
+
+  // Reset forgets all samples
+  summary.reset();
+  EXPECT_EQ(0u, summary.count());
+  error.position[0] = 3.0;
+  summary.add(error);
+  summary.write(data);
+  EXPECT_EQ(3.0, data[Summary::POSITION_MIN]);
+  EXPECT_EQ(3.0, data[Summary::POSITION_MAX]);
+  EXPECT_EQ(3.0, data[Summary::POSITION_MEAN]);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/stop_ramp.h>
+
+using joint_trajectory_controller::StopRampTraits;
+
+typedef trajectory_interface::QuinticSplineSegment<double> QuinticSegment;
+typedef QuinticSegment::State State;
+
+const double EPS = 1e-9;
+
+/** Segment type without a stop ramp specialization, that behaves as a quintic spline. */
+class GenericSegment : public QuinticSegment {};
+
+TEST(StopRampTest, ClosedFormMatchesFit)
+{
+  const double durations[]  = {0.05, 0.5, 2.0};
+  const double velocities[] = {-3.0, 0.0, 0.1, 1.5};
+  for (double duration : durations)
+  {
+    for (double velocity : velocities)
+    {
+      State start_state(2);
+      start_state.position[0] = 1.0;
+      start_state.position[1] = -2.0;
+      start_state.velocity[0] = velocity;
+      start_state.velocity[1] = -0.5 * velocity;
+
+      State ref_stop_state(2);
+      GenericSegment generic_segment;
+      StopRampTraits<GenericSegment>::stopState(start_state, duration, ref_stop_state, generic_segment);
+
+      State stop_state(2);
+      QuinticSegment segment;
+      StopRampTraits<QuinticSegment>::stopState(start_state, duration, stop_state, segment);
+
+      for (unsigned int i = 0; i < 2; ++i)
+      {
+        EXPECT_NEAR(ref_stop_state.position[i],     stop_state.position[i],     EPS);
+        EXPECT_NEAR(ref_stop_state.velocity[i],     stop_state.velocity[i],     EPS);
+        EXPECT_NEAR(ref_stop_state.acceleration[i], stop_state.acceleration[i], EPS);
+        EXPECT_EQ(0.0, stop_state.velocity[i]);
+      }
+    }
+  }
+}
+
+TEST(StopRampTest, RampComesToRest)
+{
+  const double duration = 0.5;
+  State start_state(1);
+  start_state.position[0] = 1.0;
+  start_state.velocity[0] = 2.0;
+
+  State stop_state(1);
+  QuinticSegment segment;
+  StopRampTraits<QuinticSegment>::stopState(start_state, duration, stop_state, segment);
+  segment.init(0.0, start_state, duration, stop_state);
+
+  // Velocity keeps its sign until the robot comes to rest
+  State state;
+  for (unsigned int i = 1; i < 10; ++i)
+  {
+    segment.sample(0.1 * i * duration, state);
+    EXPECT_LT(0.0, state.velocity[0]);
+  }
+  segment.sample(duration, state);
+  EXPECT_NEAR(0.0, state.velocity[0], EPS);
+  EXPECT_NEAR(1.625, state.position[0], EPS);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -27,6 +27,9 @@
 
 /// \author Adolfo Rodriguez Tsouroukdissian
 
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <ros/ros.h>
 #include <trajectory_interface/pos_vel_acc_state.h>
@@ -118,6 +121,62 @@ TEST(TolerancesTest, CheckStateTolerance)
   }
 }
 
+TEST(TolerancesTest, CheckStateTolerances)
+{
+  // Pseudo-random errors and tolerances, including disabled (zero) tolerances. Sizes cover vector tails and mask words
+  unsigned int seed = 1;
+  auto next = [&seed]() {seed = seed * 1103515245u + 12345u; return static_cast<double>((seed >> 16) % 200) / 100.0 - 1.0;};
+  for (unsigned int n_joints = 1; n_joints <= 70; ++n_joints)
+  {
+    State state_error(n_joints);
+    StateTolerancesArray<double> tolerances;
+    tolerances.resize(n_joints);
+    std::vector<StateTols> joint_tolerances(n_joints);
+    for (unsigned int i = 0; i < n_joints; ++i)
+    {
+      state_error.position[i]     = next();
+      state_error.velocity[i]     = next();
+      state_error.acceleration[i] = next();
+      joint_tolerances[i] = StateTols(std::max(0.0, next()), std::max(0.0, next()), std::max(0.0, next()));
+      tolerances.set(i, joint_tolerances[i]);
+    }
+
+    ToleranceViolationMask violations;
+    const bool ok = checkStateTolerances(state_error, tolerances, violations);
+    ASSERT_EQ(toleranceViolationMaskSize(n_joints), violations.size());
+
+    bool ref_ok = true;
+    for (unsigned int i = 0; i < n_joints; ++i)
+    {
+      State joint_error(1);
+      joint_error.position[0]     = state_error.position[i];
+      joint_error.velocity[0]     = state_error.velocity[i];
+      joint_error.acceleration[0] = state_error.acceleration[i];
+      const bool joint_ok = checkStateTolerancePerJoint(joint_error, joint_tolerances[i]);
+      EXPECT_EQ(!joint_ok, isToleranceViolated(violations, i)) << "n_joints: " << n_joints << ", joint: " << i;
+      ref_ok = ref_ok && joint_ok;
+    }
+    EXPECT_EQ(ref_ok, ok);
+  }
+
+  // Disabled tolerances always pass
+  {
+    State state_error(5);
+    for (unsigned int i = 0; i < 5; ++i) {state_error.position[i] = 1e3;}
+    StateTolerancesArray<double> tolerances;
+    tolerances.resize(5);
+    ToleranceViolationMask violations;
+    EXPECT_TRUE(checkStateTolerances(state_error, tolerances, violations));
+
+    tolerances.set(3, StateTols(1.0));
+    EXPECT_FALSE(checkStateTolerances(state_error, tolerances, violations));
+    EXPECT_EQ(1u << 3, violations[0]);
+
+    tolerances.reset(3);
+    EXPECT_TRUE(checkStateTolerances(state_error, tolerances, violations));
+  }
+}
+
 TEST(TolerancesTest, UpdateStateTolerances)
 {
   StateTols default_state_tols(1.0, 2.0, 3.0);
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/trajectory_file.h>
+
+using joint_trajectory_controller::TrajectoryFile;
+using joint_trajectory_controller::writeTrajectoryFile;
+
+class TrajectoryFileTest : public ::testing::Test
+{
+public:
+  TrajectoryFileTest()
+    : path(std::string(P_tmpdir) + "/trajectory_file_test_" + std::to_string(getpid()) + ".traj")
+  {
+    msg.joint_names.push_back("foo_joint");
+    msg.joint_names.push_back("bar");
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      trajectory_msgs::JointTrajectoryPoint point;
+      point.time_from_start = ros::Duration(0.5 * (i + 1));
+      point.positions.push_back(1.0 * i);
+      point.positions.push_back(-1.0 * i);
+      point.velocities.push_back(2.0 * i);
+      point.velocities.push_back(-2.0 * i);
+      point.accelerations.push_back(3.0 * i);
+      point.accelerations.push_back(-3.0 * i);
+      msg.points.push_back(point);
+    }
+  }
+
+  ~TrajectoryFileTest() {std::remove(path.c_str());}
+
+protected:
+  std::string path;
+  trajectory_msgs::JointTrajectory msg;
+};
+
+TEST_F(TrajectoryFileTest, WriteAndRead)
+{
+  std::string error_string;
+  ASSERT_TRUE(writeTrajectoryFile(path, msg, &error_string)) << error_string;
+
+  TrajectoryFile file;
+  ASSERT_TRUE(file.open(path, &error_string)) << error_string;
+  EXPECT_TRUE(file.isOpen());
+  EXPECT_EQ(msg.joint_names, file.getJointNames());
+  ASSERT_EQ(msg.points.size(), file.size());
+  for (unsigned int i = 0; i < file.size(); ++i)
+  {
+    EXPECT_EQ(msg.points[i].time_from_start.toSec(), file.timeFromStart(i));
+  }
+
+  // Windows
+  trajectory_msgs::JointTrajectory window;
+  file.readPoints(1, 3, window);
+  EXPECT_EQ(msg.joint_names, window.joint_names);
+  ASSERT_EQ(2u, window.points.size());
+  for (unsigned int i = 0; i < window.points.size(); ++i)
+  {
+    const trajectory_msgs::JointTrajectoryPoint& ref = msg.points[i + 1];
+    EXPECT_EQ(ref.time_from_start.toSec(), window.points[i].time_from_start.toSec());
+    EXPECT_EQ(ref.positions,     window.points[i].positions);
+    EXPECT_EQ(ref.velocities,    window.points[i].velocities);
+    EXPECT_EQ(ref.accelerations, window.points[i].accelerations);
+  }
+
+  file.readPoints(4, 100, window); // Clamped to the last point
+  ASSERT_EQ(1u, window.points.size());
+  EXPECT_EQ(msg.points.back().positions, window.points.front().positions);
+
+  file.close();
+  EXPECT_FALSE(file.isOpen());
+  EXPECT_EQ(0u, file.size());
+}
+
+TEST_F(TrajectoryFileTest, FindPoint)
+{
+  ASSERT_TRUE(writeTrajectoryFile(path, msg));
+  TrajectoryFile file;
+  ASSERT_TRUE(file.open(path));
+
+  EXPECT_EQ(0u, file.findPoint(0.0));
+  EXPECT_EQ(0u, file.findPoint(0.5));
+  EXPECT_EQ(1u, file.findPoint(0.6));
+  EXPECT_EQ(4u, file.findPoint(2.5));
+  EXPECT_EQ(5u, file.findPoint(3.0));
+}
+
+TEST_F(TrajectoryFileTest, InvalidFiles)
+{
+  TrajectoryFile file;
+  std::string error_string;
+
+  // Missing file
+  EXPECT_FALSE(file.open(path, &error_string));
+  EXPECT_FALSE(error_string.empty());
+
+  // Wrong magic string
+  {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out << "not a trajectory file, but long enough to hold a header";
+  }
+  EXPECT_FALSE(file.open(path));
+  EXPECT_FALSE(file.isOpen());
+
+  // Truncated point data
+  ASSERT_TRUE(writeTrajectoryFile(path, msg));
+  ASSERT_EQ(0, truncate(path.c_str(), 100));
+  EXPECT_FALSE(file.open(path));
+
+  // Incomplete points can't be written
+  msg.points[2].accelerations.clear();
+  error_string.clear();
+  EXPECT_FALSE(writeTrajectoryFile(path, msg, &error_string));
+  EXPECT_FALSE(error_string.empty());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -356,6 +356,114 @@ TEST(OverlappingTrajectoryInterfaceTest, SampleTrajectory)
   }
 }
 
+TEST_F(TrajectoryInterfaceTest, FindSegmentWithHint)
+{
+  // Any hint yields the same result as the unhinted search
+  const Trajectory& trajectory = this->trajectory;
+  const Time sample_times[] = {times[0] - 1.0, times[0], (times[0] + times[1]) / 2.0, times[1],
+                               (times[2] + times[3]) / 2.0, times[3], times[4], times[4] + 1.0};
+  for (const Time& time : sample_times)
+  {
+    for (Trajectory::const_iterator hint = trajectory.begin(); hint != trajectory.end(); ++hint)
+    {
+      EXPECT_EQ(findSegment(trajectory, time), findSegment(trajectory.begin(), trajectory.end(), time, hint));
+    }
+    EXPECT_EQ(findSegment(trajectory, time),
+              findSegment(trajectory.begin(), trajectory.end(), time, trajectory.end()));
+  }
+}
+
+TEST(LongTrajectoryInterfaceTest, SampleWithCursor)
+{
+  // Trajectory with more segments than walked forward from a hint
+  Trajectory trajectory;
+  const unsigned int n_segments = 100;
+  for (unsigned int i = 0; i < n_segments; ++i)
+  {
+    State start_state;
+    start_state.position.push_back(i);
+    State end_state;
+    end_state.position.push_back(i + 1);
+    trajectory.push_back(Segment(i, start_state, (i + 1), end_state));
+  }
+
+  Trajectory::size_type cursor = 0;
+  State state;
+  State ref_state;
+
+  // Monotonically increasing times, both small and large steps
+  for (Time time = -1.0; time < n_segments + 1.0; time += 0.3)
+  {
+    Trajectory::const_iterator ref_it = sample(trajectory, time, ref_state);
+    EXPECT_EQ(ref_it, sample(trajectory, time, state, cursor));
+    EXPECT_NEAR(ref_state.position[0], state.position[0], EPS);
+    EXPECT_EQ(ref_it == trajectory.end() ? 0 : ref_it - trajectory.begin(), cursor);
+  }
+
+  const Time jump_times[] = {10.5, 90.5, 3.5, 3.6, 99.9, -2.0, 50.0};
+  for (const Time& time : jump_times)
+  {
+    Trajectory::const_iterator ref_it = sample(trajectory, time, ref_state);
+    EXPECT_EQ(ref_it, sample(trajectory, time, state, cursor));
+    EXPECT_NEAR(ref_state.position[0], state.position[0], EPS);
+  }
+
+  // Out of range cursors (e.g. left over from a longer trajectory) are valid input
+  cursor = 2 * n_segments;
+  EXPECT_EQ(trajectory.begin() + 42, sample(trajectory, 42.5, state, cursor));
+  EXPECT_EQ(42u, cursor);
+}
+
+TEST(EmptyTrajectoryInterfaceTest, SampleWithCursor)
+{
+  Trajectory trajectory;
+  State state;
+  Trajectory::size_type cursor = 3;
+
+  EXPECT_EQ(trajectory.end(), sample(trajectory, 0.0, state, cursor));
+  EXPECT_EQ(0u, cursor);
+}
+
+TEST(LongTrajectoryInterfaceTest, SampleTimes)
+{
+  Trajectory trajectory;
+  const unsigned int n_segments = 100;
+  for (unsigned int i = 0; i < n_segments; ++i)
+  {
+    State start_state;
+    start_state.position.push_back(i);
+    State end_state;
+    end_state.position.push_back(i + 1);
+    trajectory.push_back(Segment(i, start_state, (i + 1), end_state));
+  }
+
+  // Sorted times, both small and large steps
+  std::vector<Time> times;
+  for (Time time = 0.0; time < n_segments + 1.0; time += 0.7) {times.push_back(time);}
+  times.push_back(n_segments + 20.0);
+
+  std::vector<State> states(times.size());
+  Trajectory::size_type cursor = 0;
+  EXPECT_TRUE(sampleTimes(trajectory, times.begin(), times.end(), states.begin(), cursor));
+  EXPECT_EQ(n_segments - 1, cursor);
+
+  State ref_state;
+  for (unsigned int i = 0; i < times.size(); ++i)
+  {
+    sample(trajectory, times[i], ref_state);
+    EXPECT_NEAR(ref_state.position[0], states[i].position[0], EPS);
+  }
+
+  // Unsorted times, some preceding the trajectory start time
+  const Time jump_times[] = {10.5, -1.0, 90.5, 3.5};
+  EXPECT_FALSE(sampleTimes(trajectory, jump_times, jump_times + 4, states.begin(), cursor));
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    sample(trajectory, jump_times[i], ref_state);
+    EXPECT_NEAR(ref_state.position[0], states[i].position[0], EPS);
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <trajectory_interface/quintic_spline_segment.h>
+#include <joint_trajectory_controller/multi_joint_trajectory.h>
+#include <joint_trajectory_controller/trajectory_lookahead.h>
+
+using namespace joint_trajectory_controller;
+using std::vector;
+
+typedef MultiJointTrajectory<trajectory_interface::QuinticSplineSegment<double> > Trajectory;
+typedef Trajectory::Segment                                                       Segment;
+typedef TrajectoryLookahead<Trajectory>                                           Lookahead;
+
+const double EPS = 1e-9;
+
+class TrajectoryLookaheadTest : public ::testing::Test
+{
+public:
+  TrajectoryLookaheadTest()
+  {
+    // Two joints with three one-second segments each
+    traj.resize(2);
+    for (unsigned int i = 0; i < traj.size(); ++i)
+    {
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        Segment::State start_state(1), end_state(1);
+        start_state.position[0] = i + k;
+        end_state.position[0]   = i + k + 1;
+        traj[i].push_back(Segment(k, start_state, k + 1.0, end_state));
+      }
+    }
+  }
+
+protected:
+  Trajectory traj;
+
+  // Compare the window against the trajectory sampled from scratch
+  void checkSamples(const Lookahead& lookahead, const Trajectory& trajectory)
+  {
+    Segment::State joint_state(1);
+    for (std::size_t k = 0; k < lookahead.size(); ++k)
+    {
+      for (unsigned int i = 0; i < trajectory.size(); ++i)
+      {
+        trajectory_interface::sample(trajectory[i], lookahead.time(k), joint_state);
+        EXPECT_NEAR(joint_state.position[0],     lookahead.state(k).position[i],     EPS);
+        EXPECT_NEAR(joint_state.velocity[0],     lookahead.state(k).velocity[i],     EPS);
+        EXPECT_NEAR(joint_state.acceleration[0], lookahead.state(k).acceleration[i], EPS);
+      }
+    }
+  }
+};
+
+TEST_F(TrajectoryLookaheadTest, SlidingWindow)
+{
+  Lookahead lookahead;
+  lookahead.init(5, 0.1, 2);
+  EXPECT_EQ(5u, lookahead.capacity());
+  EXPECT_EQ(0u, lookahead.size());
+
+  // First update computes the whole window
+  EXPECT_EQ(5u, lookahead.update(traj, 0.0));
+  EXPECT_EQ(5u, lookahead.computed());
+  EXPECT_NEAR(0.0, lookahead.time(0), EPS);
+  EXPECT_NEAR(0.4, lookahead.time(4), EPS);
+  checkSamples(lookahead, traj);
+
+  // Advancing by one spacing computes one sample
+  EXPECT_EQ(5u, lookahead.update(traj, 0.1));
+  EXPECT_EQ(1u, lookahead.computed());
+  EXPECT_NEAR(0.1, lookahead.time(0), EPS);
+  checkSamples(lookahead, traj);
+
+  // The window starts at the first sample not before the current time
+  EXPECT_EQ(5u, lookahead.update(traj, 0.25));
+  EXPECT_EQ(2u, lookahead.computed());
+  EXPECT_NEAR(0.3, lookahead.time(0), EPS);
+  checkSamples(lookahead, traj);
+
+  // Times within the same spacing compute nothing
+  EXPECT_EQ(5u, lookahead.update(traj, 0.3));
+  EXPECT_EQ(0u, lookahead.computed());
+
+  // Windows spanning several segments, including samples past the trajectory end
+  for (double time = 0.4; time < 4.0; time += 0.1)
+  {
+    EXPECT_EQ(5u, lookahead.update(traj, time));
+    EXPECT_EQ(1u, lookahead.computed()); // Accumulated roundoff does not skip samples
+    checkSamples(lookahead, traj);
+  }
+}
+
+TEST_F(TrajectoryLookaheadTest, Refresh)
+{
+  Lookahead lookahead;
+  lookahead.init(5, 0.1, 2);
+  lookahead.update(traj, 1.0);
+
+  // Jump beyond the window
+  EXPECT_EQ(5u, lookahead.update(traj, 2.0));
+  EXPECT_EQ(5u, lookahead.computed());
+  checkSamples(lookahead, traj);
+
+  // Jump backwards
+  EXPECT_EQ(5u, lookahead.update(traj, 1.5));
+  EXPECT_EQ(5u, lookahead.computed());
+  checkSamples(lookahead, traj);
+
+  // Different trajectory
+  Trajectory other_traj = traj;
+  other_traj[0].front().init(0.0, Segment::State(1), 2.0, Segment::State(1));
+  EXPECT_EQ(5u, lookahead.update(other_traj, 1.5));
+  EXPECT_EQ(5u, lookahead.computed());
+  checkSamples(lookahead, other_traj);
+
+  // Reset
+  lookahead.reset();
+  EXPECT_EQ(0u, lookahead.size());
+  EXPECT_EQ(5u, lookahead.update(other_traj, 1.5));
+  EXPECT_EQ(5u, lookahead.computed());
+}
+
+TEST_F(TrajectoryLookaheadTest, Packed)
+{
+  ASSERT_TRUE(traj.pack());
+
+  Lookahead lookahead;
+  lookahead.init(7, 0.05, 2);
+  for (double time = 0.0; time < 4.0; time += 0.01)
+  {
+    EXPECT_EQ(7u, lookahead.update(traj, time));
+    checkSamples(lookahead, traj);
+  }
+}
+
+TEST_F(TrajectoryLookaheadTest, UndefinedTrajectory)
+{
+  // Trajectory starting after the window. The window ends at its first undefined sample
+  for (unsigned int i = 0; i < traj.size(); ++i) {traj[i].erase(traj[i].begin());}
+
+  Lookahead lookahead;
+  lookahead.init(5, 0.1, 2);
+  EXPECT_EQ(0u, lookahead.update(traj, 0.5));
+
+  // Trajectory starts with the window
+  EXPECT_EQ(5u, lookahead.update(traj, 1.0));
+  checkSamples(lookahead, traj);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
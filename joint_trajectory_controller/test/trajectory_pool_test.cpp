@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/trajectory_pool.h>
+
+using joint_trajectory_controller::TrajectoryPool;
+
+typedef std::vector<std::vector<int> > Trajectory;
+typedef TrajectoryPool<Trajectory>     Pool;
+
+TEST(TrajectoryPoolTest, Init)
+{
+  Pool pool;
+  EXPECT_EQ(0u, pool.size());
+
+  pool.init(3, 2, 100);
+  EXPECT_EQ(3u, pool.size());
+  EXPECT_EQ(3u, pool.available());
+
+  Pool::Ptr trajectory = pool.acquire();
+  ASSERT_EQ(2u, trajectory->size());
+  for (const std::vector<int>& joint_traj : *trajectory)
+  {
+    EXPECT_TRUE(joint_traj.empty());
+    EXPECT_LE(100u, joint_traj.capacity());
+  }
+  EXPECT_EQ(2u, pool.available());
+}
+
+TEST(TrajectoryPoolTest, Recycle)
+{
+  Pool pool;
+  pool.init(1, 1, 0);
+
+  Pool::Ptr trajectory = pool.acquire();
+  trajectory->front().assign(10, 1);
+  const Trajectory* address = trajectory.get();
+  const int*        data    = trajectory->front().data();
+
+  // In use: Fall back to unpooled trajectories
+  Pool::Ptr other = pool.acquire();
+  EXPECT_NE(address, other.get());
+  EXPECT_EQ(0u, pool.available());
+  other.reset();
+  EXPECT_EQ(0u, pool.available());
+
+  // Released: Recycled with its storage, but without stale contents
+  trajectory.reset();
+  EXPECT_EQ(1u, pool.available());
+  trajectory = pool.acquire();
+  EXPECT_EQ(address, trajectory.get());
+  EXPECT_TRUE(trajectory->front().empty());
+  trajectory->front().assign(10, 2);
+  EXPECT_EQ(data, trajectory->front().data());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/trajectory_retiming.h>
+
+using namespace joint_trajectory_controller;
+using trajectory_msgs::JointTrajectory;
+using trajectory_msgs::JointTrajectoryPoint;
+
+const double EPS = 1e-9;
+
+JointTrajectoryPoint makePoint(double time, const std::vector<double>& pos, const std::vector<double>& vel = {})
+{
+  JointTrajectoryPoint point;
+  point.time_from_start = ros::Duration(time);
+  point.positions = pos;
+  point.velocities = vel;
+  return point;
+}
+
+RetimingLimits makeLimits(double max_velocity, double max_acceleration)
+{
+  RetimingLimits limits;
+  limits.max_velocity = max_velocity;
+  limits.max_acceleration = max_acceleration;
+  return limits;
+}
+
+/** Largest time scale over all segments after the first. Values above one mean limits are exceeded. */
+double maxTimeScale(const JointTrajectory& msg, const std::vector<RetimingLimits>& limits)
+{
+  double max_scale = 0.0;
+  for (unsigned int k = 1; k < msg.points.size(); ++k)
+  {
+    const JointTrajectoryPoint& start = msg.points[k - 1];
+    const JointTrajectoryPoint& end   = msg.points[k];
+    const double duration = (end.time_from_start - start.time_from_start).toSec();
+    for (unsigned int j = 0; j < msg.joint_names.size(); ++j)
+    {
+      using internal::pointValue;
+      max_scale = std::max(max_scale, internal::segmentTimeScale(end.positions[j] - start.positions[j],
+                                                                 pointValue(start.velocities, j),
+                                                                 pointValue(end.velocities, j),
+                                                                 0.0, 0.0, duration, limits[j]));
+    }
+  }
+  return max_scale;
+}
+
+TEST(TrajectoryRetimingTest, SpeedUpToAccelerationLimit)
+{
+  JointTrajectory msg;
+  msg.joint_names = {"joint1"};
+  msg.points.push_back(makePoint(1.0, {0.0}));
+  msg.points.push_back(makePoint(5.0, {1.0}));
+
+  // Rest-to-rest cubic peak acceleration is 6 * d / T^2
+  const std::vector<RetimingLimits> limits(1, makeLimits(10.0, 1.0));
+  const double speedup = retimeTrajectory(limits, {0}, msg);
+
+  const double duration = std::sqrt(6.0);
+  EXPECT_NEAR(1.0, msg.points[0].time_from_start.toSec(), EPS); // Leading segment is unchanged
+  EXPECT_NEAR(1.0 + duration, msg.points[1].time_from_start.toSec(), EPS);
+  EXPECT_NEAR(5.0 / (1.0 + duration), speedup, EPS);
+  EXPECT_NEAR(1.0, maxTimeScale(msg, limits), 1e-6);
+}
+
+TEST(TrajectoryRetimingTest, SlowDownToVelocityLimit)
+{
+  JointTrajectory msg;
+  msg.joint_names = {"joint1"};
+  msg.points.push_back(makePoint(0.5, {0.0}));
+  msg.points.push_back(makePoint(1.5, {1.0}));
+
+  // Rest-to-rest cubic peak velocity is 1.5 * d / T
+  const std::vector<RetimingLimits> limits(1, makeLimits(0.5, 0.0));
+  const double speedup = retimeTrajectory(limits, {0}, msg);
+
+  EXPECT_NEAR(0.5 + 3.0, msg.points[1].time_from_start.toSec(), EPS);
+  EXPECT_LT(speedup, 1.0);
+}
+
+TEST(TrajectoryRetimingTest, DwellsAreKept)
+{
+  JointTrajectory msg;
+  msg.joint_names = {"joint1"};
+  msg.points.push_back(makePoint(1.0, {0.0}));
+  msg.points.push_back(makePoint(3.0, {0.0}));
+  msg.points.push_back(makePoint(7.0, {1.0}));
+
+  const std::vector<RetimingLimits> limits(1, makeLimits(10.0, 1.0));
+  retimeTrajectory(limits, {0}, msg);
+
+  EXPECT_NEAR(3.0, msg.points[1].time_from_start.toSec(), EPS);
+  EXPECT_NEAR(3.0 + std::sqrt(6.0), msg.points[2].time_from_start.toSec(), EPS);
+}
+
+TEST(TrajectoryRetimingTest, ViaPointsRespectLimits)
+{
+  JointTrajectory msg;
+  msg.joint_names = {"joint1", "joint2"};
+  msg.points.push_back(makePoint(1.0, {0.0, 0.0}, {0.0, 0.0}));
+  msg.points.push_back(makePoint(3.0, {1.0, 0.2}, {0.5, 0.1}));
+  msg.points.push_back(makePoint(4.0, {1.2, 2.0}, {0.1, 1.0}));
+  msg.points.push_back(makePoint(8.0, {1.5, 2.5}, {0.0, 0.0}));
+
+  std::vector<RetimingLimits> limits;
+  limits.push_back(makeLimits(1.0, 2.0));
+  limits.push_back(makeLimits(1.5, 3.0));
+  const double speedup = retimeTrajectory(limits, {0, 1}, msg);
+
+  EXPECT_GT(speedup, 1.0);
+  EXPECT_LE(maxTimeScale(msg, limits), 1.0 + 1e-3);
+  for (unsigned int k = 1; k < msg.points.size(); ++k)
+  {
+    EXPECT_LT(msg.points[k - 1].time_from_start, msg.points[k].time_from_start);
+  }
+
+  // Velocity directions are preserved
+  EXPECT_GT(msg.points[1].velocities[0], 0.0);
+  EXPECT_GT(msg.points[2].velocities[1], 0.0);
+}
+
+TEST(TrajectoryRetimingTest, MappedJointLimits)
+{
+  JointTrajectory msg;
+  msg.joint_names = {"joint2", "joint1"};
+  msg.points.push_back(makePoint(1.0, {0.0, 0.0}));
+  msg.points.push_back(makePoint(2.0, {1.0, 0.0}));
+
+  // Only the second controller joint moves, and is mapped to the first message joint
+  std::vector<RetimingLimits> limits;
+  limits.push_back(makeLimits(100.0, 0.0));
+  limits.push_back(makeLimits(0.75, 0.0));
+  retimeTrajectory(limits, {1, 0}, msg);
+
+  EXPECT_NEAR(3.0, msg.points[1].time_from_start.toSec(), EPS);
+}
+
+TEST(TrajectoryRetimingTest, UnchangedTrajectories)
+{
+  JointTrajectory msg;
+  msg.joint_names = {"joint1"};
+  msg.points.push_back(makePoint(1.0, {0.0}));
+  msg.points.push_back(makePoint(2.0, {1.0}));
+
+  // No limits
+  const std::vector<RetimingLimits> no_limits(1);
+  EXPECT_EQ(1.0, retimeTrajectory(no_limits, {0}, msg));
+  EXPECT_EQ(ros::Duration(2.0), msg.points[1].time_from_start);
+
+  // Inconsistent point data
+  const std::vector<RetimingLimits> limits(1, makeLimits(1.0, 1.0));
+  msg.points[1].velocities = {0.0, 0.0};
+  EXPECT_EQ(1.0, retimeTrajectory(limits, {0}, msg));
+  EXPECT_EQ(ros::Duration(2.0), msg.points[1].time_from_start);
+
+  // Single point
+  msg.points.resize(1);
+  EXPECT_EQ(1.0, retimeTrajectory(limits, {0}, msg));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
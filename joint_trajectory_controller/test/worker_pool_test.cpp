@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <joint_trajectory_controller/worker_pool.h>
+
+using joint_trajectory_controller::WorkerPool;
+
+void waitForTasks(const WorkerPool& pool)
+{
+  const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (pool.pending() > 0 && std::chrono::steady_clock::now() < timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(WorkerPoolTest, Size)
+{
+  EXPECT_EQ(1u, WorkerPool().size());
+  EXPECT_EQ(1u, WorkerPool(0).size());
+  EXPECT_EQ(3u, WorkerPool(3).size());
+}
+
+TEST(WorkerPoolTest, IgnoreEmptyTask)
+{
+  WorkerPool pool;
+  pool.submit(WorkerPool::Task());
+  EXPECT_EQ(0u, pool.pending());
+}
+
+TEST(WorkerPoolTest, RunInBackground)
+{
+  std::thread::id runner_id;
+  WorkerPool pool;
+  pool.submit([&runner_id] {runner_id = std::this_thread::get_id();});
+  waitForTasks(pool);
+
+  EXPECT_EQ(0u, pool.pending());
+  EXPECT_NE(std::thread::id(), runner_id);
+  EXPECT_NE(std::this_thread::get_id(), runner_id);
+}
+
+TEST(WorkerPoolTest, SingleThreadPreservesOrder)
+{
+  std::vector<int> order;
+  {
+    WorkerPool pool(1);
+    for (int i = 0; i < 100; ++i) {pool.submit([&order, i] {order.push_back(i);});}
+  }
+  ASSERT_EQ(100u, order.size());
+  for (int i = 0; i < 100; ++i) {EXPECT_EQ(i, order[i]);}
+}
+
+TEST(WorkerPoolTest, RunConcurrently)
+{
+  // Each task blocks until all of them have started, which requires one thread per task
+  const unsigned int threads = 4;
+  std::mutex mutex;
+  std::condition_variable cond;
+  unsigned int started = 0;
+  std::set<std::thread::id> runner_ids;
+
+  WorkerPool pool(threads);
+  for (unsigned int i = 0; i < threads; ++i)
+  {
+    pool.submit([&]
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ++started;
+      runner_ids.insert(std::this_thread::get_id());
+      cond.notify_all();
+      cond.wait_for(lock, std::chrono::seconds(5), [&] {return started == threads;});
+    });
+  }
+  waitForTasks(pool);
+
+  EXPECT_EQ(threads, started);
+  EXPECT_EQ(threads, runner_ids.size());
+}
+
+TEST(WorkerPoolTest, RunPendingOnDestruction)
+{
+  std::atomic<unsigned int> runs(0);
+  {
+    WorkerPool pool;
+    pool.submit([] {std::this_thread::sleep_for(std::chrono::milliseconds(50));});
+    for (unsigned int i = 0; i < 10; ++i) {pool.submit([&runs] {++runs;});}
+    EXPECT_LT(0u, pool.pending());
+  }
+  EXPECT_EQ(10u, runs.load());
+}
+
+TEST(WorkerPoolTest, ParallelForVisitsAllIndices)
+{
+  WorkerPool pool(3);
+  std::vector<unsigned int> visits(100, 0);
+  pool.parallelFor(visits.size(), [&visits](std::size_t i) {++visits[i];});
+  for (unsigned int visit : visits) {EXPECT_EQ(1u, visit);}
+
+  // Empty loops are no-ops
+  pool.parallelFor(0, [](std::size_t) {FAIL();});
+}
+
+TEST(WorkerPoolTest, ParallelForFromWorker)
+{
+  // The calling thread takes part in the loop, so nesting in a busy pool can not deadlock
+  WorkerPool pool(1);
+  std::atomic<unsigned int> runs(0);
+  pool.submit([&pool, &runs] {pool.parallelFor(10, [&runs](std::size_t) {++runs;});});
+  waitForTasks(pool);
+  EXPECT_EQ(10u, runs.load());
+}
+
+TEST(WorkerPoolTest, ParallelForRethrowsLowestIndex)
+{
+  WorkerPool pool(2);
+  std::atomic<unsigned int> runs(0);
+  try
+  {
+    pool.parallelFor(20, [&runs](std::size_t i)
+    {
+      ++runs;
+      if (i % 5 == 3) {throw std::runtime_error(std::to_string(i));}
+    });
+    FAIL();
+  }
+  catch (const std::runtime_error& ex)
+  {
+    EXPECT_EQ(std::string("3"), ex.what());
+  }
+  EXPECT_EQ(20u, runs.load());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
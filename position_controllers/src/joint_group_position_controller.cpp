@@ -42,11 +42,12 @@ template <class T>
 void forward_command_controller::ForwardJointGroupCommandController<T>::starting(const ros::Time& time)
 {
   // Start controller with current joint positions
-  std::vector<double> & commands = *commands_buffer_.readFromRT();
+  std::vector<double> & commands = commands_buffer_.readFromRT()->data;
   for(unsigned int i=0; i<joints_.size(); i++)
   {
     commands[i]=joints_[i].getPosition();
   }
+  resetCommands(time);
 }
 
 
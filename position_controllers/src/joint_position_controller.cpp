@@ -41,7 +41,8 @@ template <class T>
 void forward_command_controller::ForwardCommandController<T>::starting(const ros::Time& time)
 {
   // Start controller with current joint position
-  command_buffer_.writeFromNonRT(joint_.getPosition());
+  command_buffer_.initRT(forward_command_controller::StampedCommand<double>(joint_.getPosition(), time));
+  command_timeout_.reset(time);
 }
 
 PLUGINLIB_EXPORT_CLASS(position_controllers::JointPositionController,controller_interface::ControllerBase)
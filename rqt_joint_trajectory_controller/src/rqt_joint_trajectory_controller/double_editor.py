@@ -111,7 +111,9 @@ class DoubleEditor(QWidget):
         self.valueChanged.emit(val)
 
     def setValue(self, val):
-        if val != self.spin_box.value():
+        # The spin box rounds values to its displayed decimals, so comparing
+        # rounded values avoids repainting when the display would not change
+        if round(val, self.spin_box.decimals()) != self.spin_box.value():
             self.spin_box.blockSignals(True)
             self.spin_box.setValue(val)  # Update spin box first
             self._on_spinbox_changed()  # Sync slider with spin box
@@ -26,6 +26,8 @@
 # POSSIBILITY OF SUCH DAMAGE.
 
 import os
+import struct
+import time
 import rospy
 import rospkg
 
@@ -101,10 +103,16 @@ class JointTrajectoryController(Plugin):
     available in the C{joint_trajectory_controller} ROS package.
     """
     _cmd_pub_freq = 10.0  # Hz
+    _stream_cmd_pub_freq = 30.0  # Hz, for controllers that stream commands
     _widget_update_freq = 30.0  # Hz
+    _state_update_freq = _widget_update_freq  # Hz, faster states are dropped
     _ctrlrs_update_freq = 1  # Hz
     _min_traj_dur = 5.0 / _cmd_pub_freq  # Minimum trajectory duration
 
+    # Subscribe to raw controller states, and extract only the actual joint
+    # positions from them instead of deserializing the whole message
+    _light_state_sub = True
+
     jointStateChanged = Signal([dict])
 
     def __init__(self, context):
@@ -149,6 +157,9 @@ class JointTrajectoryController(Plugin):
         self._joint_pos = {}  # name->pos map for joints of selected controller
         self._joint_names = []  # Ordered list of selected controller joints
         self._robot_joint_limits = {} # Lazily evaluated on first use
+        self._last_state_time = 0.0  # Wall time of last processed state
+        self._last_cmd = None  # Last sent command positions
+        self._joint_pos_changed = False  # Widgets are out of date
 
         # Timer for sending commands to active controller
         self._update_cmd_timer = QTimer(self)
@@ -254,11 +265,13 @@ class JointTrajectoryController(Plugin):
 
     def _on_speed_scaling_change(self, val):
         self._speed_scale = val / self._speed_scaling_widget.slider.maximum()
+        self._last_cmd = None  # Resend the command with the new duration
 
     def _on_joint_state_change(self, actual_pos):
         assert(len(actual_pos) == len(self._joint_pos))
         for name in actual_pos.keys():
             self._joint_pos[name]['position'] = actual_pos[name]
+        self._joint_pos_changed = True
 
     def _on_cm_change(self, cm_ns):
         self._cm_ns = cm_ns
@@ -294,6 +307,7 @@ class JointTrajectoryController(Plugin):
         if val:
             # Widgets send desired position commands to controller
             self._update_act_pos_timer.stop()
+            self._last_cmd = None  # First command is always sent
             self._update_cmd_timer.start()
         else:
             # Controller updates widgets with actual position
@@ -333,12 +347,26 @@ class JointTrajectoryController(Plugin):
 
         # Setup ROS interfaces
         jtc_ns = _resolve_controller_ns(self._cm_ns, self._jtc_name)
+
+        # Controllers that stream commands append them to the trajectory being
+        # executed instead of rebuilding it, so jogging can be smoother
+        stream_cmds = rospy.get_param(jtc_ns + '/stream_commands', False)
+        cmd_pub_freq = (self._stream_cmd_pub_freq if stream_cmds
+                        else self._cmd_pub_freq)
+        self._update_cmd_timer.setInterval(1000.0 / cmd_pub_freq)
+        self._min_traj_dur = 5.0 / cmd_pub_freq
         state_topic = jtc_ns + '/state'
         cmd_topic = jtc_ns + '/command'
-        self._state_sub = rospy.Subscriber(state_topic,
-                                           JointTrajectoryControllerState,
-                                           self._state_cb,
-                                           queue_size=1)
+        if self._light_state_sub:
+            self._state_sub = rospy.Subscriber(state_topic,
+                                               rospy.AnyMsg,
+                                               self._raw_state_cb,
+                                               queue_size=1)
+        else:
+            self._state_sub = rospy.Subscriber(state_topic,
+                                               JointTrajectoryControllerState,
+                                               self._state_cb,
+                                               queue_size=1)
         self._cmd_pub = rospy.Publisher(cmd_topic,
                                         JointTrajectory,
                                         queue_size=1)
@@ -396,7 +424,17 @@ class JointTrajectoryController(Plugin):
             self._state_sub.unregister()
             self._state_sub = None
 
+    def _throttle_state(self):
+        # States arriving faster than the widgets are updated are dropped
+        now = time.time()
+        if now - self._last_state_time < 1.0 / self._state_update_freq:
+            return True
+        self._last_state_time = now
+        return False
+
     def _state_cb(self, msg):
+        if self._throttle_state():
+            return
         actual_pos = {}
         for i in range(len(msg.joint_names)):
             joint_name = msg.joint_names[i]
@@ -404,6 +442,16 @@ class JointTrajectoryController(Plugin):
             actual_pos[joint_name] = joint_pos
         self.jointStateChanged.emit(actual_pos)
 
+    def _raw_state_cb(self, msg):
+        if self._throttle_state():
+            return
+        try:
+            joint_names, positions = _actual_positions(msg._buff)
+        except (struct.error, ValueError):
+            rospy.logwarn_throttle(10.0, 'Malformed controller state message')
+            return
+        self.jointStateChanged.emit(dict(zip(joint_names, positions)))
+
     def _update_single_cmd_cb(self, val, name):
         self._joint_pos[name]['command'] = val
 
@@ -422,12 +470,23 @@ class JointTrajectoryController(Plugin):
             max_vel = self._robot_joint_limits[name]['max_velocity']
             dur.append(max(abs(cmd - pos) / max_vel, self._min_traj_dur))
             point.positions.append(cmd)
+
+        # Commands are only sent when they change, as each one replaces the
+        # trajectory being executed
+        if point.positions == self._last_cmd:
+            return
+        self._last_cmd = point.positions
+
         point.time_from_start = rospy.Duration(max(dur) / self._speed_scale)
         traj.points.append(point)
 
         self._cmd_pub.publish(traj)
 
     def _update_joint_widgets(self):
+        # Widgets are only repainted when a new state was received
+        if not self._joint_pos_changed:
+            return
+        self._joint_pos_changed = False
         joint_widgets = self._joint_widgets()
         for id in range(len(joint_widgets)):
             joint_name = self._joint_names[id]
@@ -445,6 +504,52 @@ class JointTrajectoryController(Plugin):
                                          QFormLayout.FieldRole).widget())
         return widgets
 
+def _read_string(buff, offset):
+    (length,) = struct.unpack_from('<I', buff, offset)
+    offset += 4
+    if offset + length > len(buff):
+        raise ValueError('String past end of buffer')
+    return buff[offset:offset + length], offset + length
+
+def _read_float64_array(buff, offset):
+    (length,) = struct.unpack_from('<I', buff, offset)
+    offset += 4
+    values = struct.unpack_from('<%dd' % length, buff, offset)
+    return values, offset + 8 * length
+
+def _actual_positions(buff):
+    """
+    Extract the joint names and actual joint positions from a serialized
+    C{JointTrajectoryControllerState} message, skipping all other fields.
+
+    @param buff Serialized message
+    @type buff str
+    @return Joint names and actual positions
+    @rtype tuple
+    @raise struct.error, ValueError: If C{buff} is not a valid message
+    """
+    offset = 12  # Header sequence number and stamp
+    _, offset = _read_string(buff, offset)  # Header frame id
+
+    (n_joints,) = struct.unpack_from('<I', buff, offset)
+    offset += 4
+    joint_names = []
+    for _ in range(n_joints):
+        name, offset = _read_string(buff, offset)
+        joint_names.append(name.decode('utf-8'))
+
+    # Skip the desired point: positions, velocities, accelerations, effort and
+    # time from start
+    for _ in range(4):
+        (length,) = struct.unpack_from('<I', buff, offset)
+        offset += 4 + 8 * length
+    offset += 8
+
+    positions, _ = _read_float64_array(buff, offset)
+    if len(positions) != n_joints:
+        raise ValueError('Unexpected number of actual positions')
+    return joint_names, positions
+
 def _jtc_joint_names(jtc_info):
     # NOTE: We assume that there is at least one hardware interface that
     # claims resources (there should be), and the resource list is fetched
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SENSOR_SNAPSHOT_CONTROLLER_SENSOR_SNAPSHOT_CONTROLLER_H
+#define SENSOR_SNAPSHOT_CONTROLLER_SENSOR_SNAPSHOT_CONTROLLER_H
+
+#include <atomic>
+#include <controller_instrumentation/publish_schedule.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/spsc_queue.h>
+#include <controller_instrumentation/telemetry_ring.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_interface/multi_interface_controller.h>
+#include <hardware_interface/force_torque_sensor_interface.h>
+#include <hardware_interface/imu_sensor_interface.h>
+#include <hardware_interface/joint_state_interface.h>
+#include <pluginlib/class_list_macros.hpp>
+#include <sensor_snapshot_controller/SensorSnapshot.h>
+#include <thread>
+#include <vector>
+
+namespace sensor_snapshot_controller
+{
+
+/**
+ * \brief Controller that publishes the state of all joints, IMUs and force-torque sensors of a robot, read in the same
+ * update cycle.
+ *
+ * The state of every resource of the \c hardware_interface::JointStateInterface,
+ * \c hardware_interface::ImuSensorInterface and \c hardware_interface::ForceTorqueSensorInterface is published in a
+ * single \c sensor_snapshot_controller/SensorSnapshot message, with one time stamp. Any of the interfaces may be absent.
+ * This replaces a joint_state_controller, an imu_sensor_controller and a force_torque_sensor_controller for consumers
+ * that need time-coherent samples, such as state estimators.
+ *
+ * \code
+ * sensor_snapshot_controller:
+ *   type: sensor_snapshot_controller/SensorSnapshotController
+ *   publish_rate: 100
+ * \endcode
+ *
+ * On the publish cycles, the control loop only packs the sensor readings into a preallocated lock-free queue; a
+ * dedicated thread builds and publishes the messages. The packed readings of every update cycle can also be recorded
+ * to a shared memory telemetry ring (see \c controller_instrumentation::TelemetryRingWriter) by setting the
+ * \c telemetry_ring_name parameter. Both use the record layout of \ref recordLabels.
+ */
+class SensorSnapshotController
+    : public controller_interface::MultiInterfaceController<hardware_interface::JointStateInterface,
+                                                            hardware_interface::ImuSensorInterface,
+                                                            hardware_interface::ForceTorqueSensorInterface>
+{
+public:
+  SensorSnapshotController();
+  ~SensorSnapshotController();
+
+  bool init(hardware_interface::RobotHW* robot_hw, ros::NodeHandle& root_nh, ros::NodeHandle& controller_nh);
+  void starting(const ros::Time& time);
+  void update(const ros::Time& time, const ros::Duration& /*period*/);
+  void stopping(const ros::Time& /*time*/);
+
+private:
+  /// Number of packed values per joint (position, velocity, effort), IMU (orientation, angular velocity, linear
+  /// acceleration) and force-torque sensor (force, torque).
+  static constexpr unsigned JOINT_SIZE  = 3;
+  static constexpr unsigned IMU_SIZE    = 10;
+  static constexpr unsigned WRENCH_SIZE = 6;
+
+  static constexpr std::size_t RECORD_QUEUE_SIZE = 64; ///< Publish cycles the publisher thread may lag behind
+
+  /// Sensor readings of a publish cycle, queued for the publisher thread.
+  struct Record
+  {
+    ros::Time stamp;
+    std::vector<double> data; ///< Packed readings, see \ref recordLabels
+  };
+
+  std::vector<hardware_interface::JointStateHandle>       joints_;
+  std::vector<hardware_interface::ImuSensorHandle>        imus_;
+  std::vector<hardware_interface::ForceTorqueSensorHandle> wrenches_;
+
+  double publish_rate_;
+  controller_instrumentation::PublishSchedule publish_schedule_;
+
+  controller_instrumentation::SpscQueue<Record> records_;
+  std::atomic<std::size_t> dropped_records_; ///< Publish cycles lost because the queue was full
+  std::atomic<bool> keep_running_;
+  std::thread publisher_thread_;
+  ros::Publisher pub_;
+  SensorSnapshot msg_; ///< Owned by the publisher thread. Names, frame ids and covariances are filled in init()
+
+  controller_instrumentation::TelemetryRingWriter telemetry_ring_; ///< Readings of every update cycle, if enabled
+  controller_instrumentation::RealtimeAudit rt_audit_; ///< Audit of realtime-unsafe operations in update()
+
+  /// \return Number of packed values of a record.
+  std::size_t recordSize() const;
+
+  /**
+   * \return Name of each packed value of a record: the position, velocity and effort of all joints, in this order,
+   * followed by the orientation (x, y, z, w), angular velocity and linear acceleration of each IMU, and by the force
+   * and torque of each force-torque sensor.
+   */
+  std::vector<std::string> recordLabels() const;
+
+  /// Pack the current sensor readings into \p data, of \ref recordSize values. Realtime-safe.
+  void pack(double* data) const;
+
+  /// Fill msg_ from a packed record.
+  void unpack(const Record& record);
+
+  void initMessage();
+
+  /// Publisher thread main loop.
+  void run();
+};
+
+}
+
+#endif
@@ -0,0 +1,313 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2026, the ros_controllers contributors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived from
+//     this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+
+#include <sensor_snapshot_controller/sensor_snapshot_controller.h>
+
+namespace sensor_snapshot_controller
+{
+
+  namespace
+  {
+    // Covariance of an IMU measurement following the sensor_msgs/Imu conventions: zero if the measurement is
+    // available but its covariance is unknown, -1 in the first element if the measurement is not available at all.
+    template <class Covariance>
+    void initCovariance(const double* data, const double* covariance, Covariance& msg_covariance)
+    {
+      for (unsigned j=0; j<msg_covariance.size(); ++j){
+        msg_covariance[j] = covariance ? covariance[j] : 0.0;
+      }
+      if (!data && !covariance){
+        msg_covariance[0] = -1.0;
+      }
+    }
+
+    // Copy \p n values of a reading, or zeros if the sensor does not provide it
+    double* packReading(const double* reading, unsigned n, double* data)
+    {
+      for (unsigned j=0; j<n; ++j){
+        *data++ = reading ? reading[j] : 0.0;
+      }
+      return data;
+    }
+  }
+
+  constexpr unsigned SensorSnapshotController::JOINT_SIZE;
+  constexpr unsigned SensorSnapshotController::IMU_SIZE;
+  constexpr unsigned SensorSnapshotController::WRENCH_SIZE;
+  constexpr std::size_t SensorSnapshotController::RECORD_QUEUE_SIZE;
+
+  SensorSnapshotController::SensorSnapshotController()
+    : controller_interface::MultiInterfaceController<hardware_interface::JointStateInterface,
+                                                     hardware_interface::ImuSensorInterface,
+                                                     hardware_interface::ForceTorqueSensorInterface>(true),
+      publish_rate_(0.0), dropped_records_(0), keep_running_(false)
+  {}
+
+  SensorSnapshotController::~SensorSnapshotController()
+  {
+    keep_running_.store(false);
+    if (publisher_thread_.joinable())
+      publisher_thread_.join();
+  }
+
+  bool SensorSnapshotController::init(hardware_interface::RobotHW* robot_hw,
+                                      ros::NodeHandle&           root_nh,
+                                      ros::NodeHandle&           controller_nh)
+  {
+    // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+    const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(controller_nh);
+    if (!thread_placement_scope) {return false;}
+
+    // get the handles of all sensors of the interfaces present in the hardware
+    if (hardware_interface::JointStateInterface* hw = robot_hw->get<hardware_interface::JointStateInterface>()){
+      const std::vector<std::string> names = hw->getNames();
+      for (const std::string& name : names)
+        joints_.push_back(hw->getHandle(name));
+    }
+    if (hardware_interface::ImuSensorInterface* hw = robot_hw->get<hardware_interface::ImuSensorInterface>()){
+      const std::vector<std::string> names = hw->getNames();
+      for (const std::string& name : names)
+        imus_.push_back(hw->getHandle(name));
+    }
+    if (hardware_interface::ForceTorqueSensorInterface* hw = robot_hw->get<hardware_interface::ForceTorqueSensorInterface>()){
+      const std::vector<std::string> names = hw->getNames();
+      for (const std::string& name : names)
+        wrenches_.push_back(hw->getHandle(name));
+    }
+    ROS_DEBUG_STREAM("Got " << joints_.size() << " joints, " << imus_.size() << " IMUs and "
+                     << wrenches_.size() << " force-torque sensors");
+
+    // get publishing period
+    if (!controller_nh.getParam("publish_rate", publish_rate_)){
+      ROS_ERROR("Parameter 'publish_rate' not set");
+      return false;
+    }
+
+    // spread publish cycles across controllers
+    bool stagger_publish = false;
+    controller_nh.param("stagger_publish", stagger_publish, stagger_publish);
+    publish_schedule_.init(publish_rate_, stagger_publish);
+
+    rt_audit_.init(controller_nh);
+
+    // shared memory ring, with the readings of every update cycle
+    if (!telemetry_ring_.init(controller_nh, recordLabels()))
+      return false;
+
+    // record queue, preallocated for all sensors, and publisher thread
+    initMessage();
+    pub_ = root_nh.advertise<SensorSnapshot>("sensor_snapshot", 4);
+    Record prototype;
+    prototype.data.assign(recordSize(), 0.0);
+    records_.reset(RECORD_QUEUE_SIZE, prototype);
+    keep_running_.store(true);
+    publisher_thread_ = std::thread(&SensorSnapshotController::run, this);
+
+    return true;
+  }
+
+  void SensorSnapshotController::initMessage()
+  {
+    // joint names, and message storage of all sensors
+    msg_.joints.name.clear();
+    for (const hardware_interface::JointStateHandle& joint : joints_)
+      msg_.joints.name.push_back(joint.getName());
+    msg_.joints.position.assign(joints_.size(), 0.0);
+    msg_.joints.velocity.assign(joints_.size(), 0.0);
+    msg_.joints.effort.assign(joints_.size(), 0.0);
+
+    // frame ids and covariances, which do not change
+    msg_.imus.resize(imus_.size());
+    for (unsigned i=0; i<imus_.size(); i++){
+      sensor_msgs::Imu& imu = msg_.imus[i];
+      imu.header.frame_id = imus_[i].getFrameId();
+      initCovariance(imus_[i].getOrientation(), imus_[i].getOrientationCovariance(), imu.orientation_covariance);
+      initCovariance(imus_[i].getAngularVelocity(), imus_[i].getAngularVelocityCovariance(),
+                     imu.angular_velocity_covariance);
+      initCovariance(imus_[i].getLinearAcceleration(), imus_[i].getLinearAccelerationCovariance(),
+                     imu.linear_acceleration_covariance);
+    }
+
+    msg_.wrenches.resize(wrenches_.size());
+    for (unsigned i=0; i<wrenches_.size(); i++)
+      msg_.wrenches[i].header.frame_id = wrenches_[i].getFrameId();
+  }
+
+  void SensorSnapshotController::starting(const ros::Time& time)
+  {
+    // initialize time
+    publish_schedule_.reset(time);
+  }
+
+  void SensorSnapshotController::update(const ros::Time& time, const ros::Duration& /*period*/)
+  {
+    controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
+    // every cycle goes to the telemetry ring
+    if (double* data = telemetry_ring_.beginWrite(time.toSec())){
+      pack(data);
+      telemetry_ring_.commit();
+    }
+
+    // limit rate of publishing: the cycle is published, or lost if the queue is full, so increment time
+    if (!publish_schedule_.due(time))
+      return;
+    publish_schedule_.advance();
+
+    Record* record = records_.beginPush();
+    if (!record){
+      dropped_records_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    record->stamp = time;
+    pack(record->data.data());
+    records_.commitPush();
+  }
+
+  void SensorSnapshotController::stopping(const ros::Time& /*time*/)
+  {}
+
+  std::size_t SensorSnapshotController::recordSize() const
+  {
+    return JOINT_SIZE * joints_.size() + IMU_SIZE * imus_.size() + WRENCH_SIZE * wrenches_.size();
+  }
+
+  std::vector<std::string> SensorSnapshotController::recordLabels() const
+  {
+    std::vector<std::string> labels;
+    const char* const joint_quantities[] = {"position", "velocity", "effort"};
+    for (const char* quantity : joint_quantities)
+      for (const hardware_interface::JointStateHandle& joint : joints_)
+        labels.push_back(joint.getName() + "/" + quantity);
+
+    const char* const imu_quantities[] = {"orientation/x", "orientation/y", "orientation/z", "orientation/w",
+                                          "angular_velocity/x", "angular_velocity/y", "angular_velocity/z",
+                                          "linear_acceleration/x", "linear_acceleration/y", "linear_acceleration/z"};
+    for (const hardware_interface::ImuSensorHandle& imu : imus_)
+      for (const char* quantity : imu_quantities)
+        labels.push_back(imu.getName() + "/" + quantity);
+
+    const char* const wrench_quantities[] = {"force/x", "force/y", "force/z", "torque/x", "torque/y", "torque/z"};
+    for (const hardware_interface::ForceTorqueSensorHandle& wrench : wrenches_)
+      for (const char* quantity : wrench_quantities)
+        labels.push_back(wrench.getName() + "/" + quantity);
+
+    return labels;
+  }
+
+  void SensorSnapshotController::pack(double* data) const
+  {
+    const std::size_t num_joints = joints_.size();
+    for (unsigned i=0; i<num_joints; i++){
+      data[i]                  = joints_[i].getPosition();
+      data[i + num_joints]     = joints_[i].getVelocity();
+      data[i + 2 * num_joints] = joints_[i].getEffort();
+    }
+    data += JOINT_SIZE * num_joints;
+
+    for (const hardware_interface::ImuSensorHandle& imu : imus_){
+      data = packReading(imu.getOrientation(), 4, data);
+      data = packReading(imu.getAngularVelocity(), 3, data);
+      data = packReading(imu.getLinearAcceleration(), 3, data);
+    }
+
+    for (const hardware_interface::ForceTorqueSensorHandle& wrench : wrenches_){
+      data = packReading(wrench.getForce(), 3, data);
+      data = packReading(wrench.getTorque(), 3, data);
+    }
+  }
+
+  void SensorSnapshotController::unpack(const Record& record)
+  {
+    const double* data = record.data.data();
+    msg_.header.stamp = record.stamp;
+
+    const std::size_t num_joints = joints_.size();
+    msg_.joints.header.stamp = record.stamp;
+    std::copy(data, data + num_joints, msg_.joints.position.begin());
+    std::copy(data + num_joints, data + 2 * num_joints, msg_.joints.velocity.begin());
+    std::copy(data + 2 * num_joints, data + 3 * num_joints, msg_.joints.effort.begin());
+    data += JOINT_SIZE * num_joints;
+
+    for (sensor_msgs::Imu& imu : msg_.imus){
+      imu.header.stamp = record.stamp;
+      imu.orientation.x = data[0];
+      imu.orientation.y = data[1];
+      imu.orientation.z = data[2];
+      imu.orientation.w = data[3];
+      imu.angular_velocity.x = data[4];
+      imu.angular_velocity.y = data[5];
+      imu.angular_velocity.z = data[6];
+      imu.linear_acceleration.x = data[7];
+      imu.linear_acceleration.y = data[8];
+      imu.linear_acceleration.z = data[9];
+      data += IMU_SIZE;
+    }
+
+    for (geometry_msgs::WrenchStamped& wrench : msg_.wrenches){
+      wrench.header.stamp = record.stamp;
+      wrench.wrench.force.x  = data[0];
+      wrench.wrench.force.y  = data[1];
+      wrench.wrench.force.z  = data[2];
+      wrench.wrench.torque.x = data[3];
+      wrench.wrench.torque.y = data[4];
+      wrench.wrench.torque.z = data[5];
+      data += WRENCH_SIZE;
+    }
+  }
+
+  void SensorSnapshotController::run()
+  {
+    // poll several times per publish period, so that publication latency stays a fraction of it
+    const double poll_period = publish_rate_ > 0.0 ? std::min(std::max(0.25/publish_rate_, 0.001), 0.01) : 0.01;
+
+    std::size_t reported_dropped_records = 0;
+    Record record;
+    record.data.assign(recordSize(), 0.0);
+    while (keep_running_.load()){
+      while (records_.pop(record)){
+        unpack(record);
+        pub_.publish(msg_);
+      }
+
+      const std::size_t dropped_records = dropped_records_.load(std::memory_order_relaxed);
+      if (dropped_records != reported_dropped_records){
+        ROS_WARN_STREAM_THROTTLE(1.0, "Sensor snapshot queue full: " << dropped_records - reported_dropped_records
+                                 << " publish cycles dropped.");
+        reported_dropped_records = dropped_records;
+      }
+
+      std::this_thread::sleep_for(std::chrono::duration<double>(poll_period));
+    }
+  }
+
+}
+
+PLUGINLIB_EXPORT_CLASS(sensor_snapshot_controller::SensorSnapshotController, controller_interface::ControllerBase)
@@ -0,0 +1,120 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2008, Willow Garage, Inc.
+ *  Copyright (c) 2012, hiDOF, Inc.
+ *  Copyright (c) 2013, PAL Robotics, S.L.
+ *  Copyright (c) 2014, Fraunhofer IPA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef VELOCITY_CONTROLLERS_JOINT_GROUP_POSITION_CONTROLLER_H
+#define VELOCITY_CONTROLLERS_JOINT_GROUP_POSITION_CONTROLLER_H
+
+#include <control_msgs/JointTrajectoryControllerState.h>
+#include <control_toolbox/pid.h>
+#include <controller_instrumentation/realtime_audit.h>
+#include <controller_instrumentation/thread_placement.h>
+#include <controller_interface/controller.h>
+#include <forward_command_controller/joint_position_errors.h>
+#include <forward_command_controller/pid_group.h>
+#include <hardware_interface/joint_command_interface.h>
+#include <memory>
+#include <realtime_tools/realtime_buffer.h>
+#include <realtime_tools/realtime_publisher.h>
+#include <ros/node_handle.h>
+#include <std_msgs/Float64MultiArray.h>
+#include <urdf/model.h>
+
+namespace velocity_controllers
+{
+
+/**
+ * \brief Position controller for a set of velocity controlled joints.
+ *
+ * This class converts the commanded positions of a set of joints into velocity commands, using one PID loop per joint.
+ *
+ * \section ROS interface
+ *
+ * \param type Must be "velocity_controllers/JointGroupPositionController".
+ * \param joints List of names of the joints to control.
+ * \param <joint>/pid PID gains of each joint, as for \c velocity_controllers::JointPositionController.
+ *
+ * Subscribes to:
+ * - \b command (std_msgs::Float64MultiArray) : The joint positions to achieve
+ *
+ * Publishes:
+ * - \b state (control_msgs::JointTrajectoryControllerState) : State of all joints, every 10 cycles. \c desired holds the
+ *   position setpoints and the commanded velocities, \c actual the measured positions and velocities, and \c error the
+ *   position errors.
+ */
+class JointGroupPositionController : public controller_interface::Controller<hardware_interface::VelocityJointInterface>
+{
+public:
+  JointGroupPositionController();
+  ~JointGroupPositionController();
+
+  bool init(hardware_interface::VelocityJointInterface* hw, ros::NodeHandle &n);
+  void starting(const ros::Time& time);
+  void update(const ros::Time& time, const ros::Duration& period);
+
+  std::vector< std::string > joint_names_;
+  std::vector< hardware_interface::JointHandle > joints_;
+  realtime_tools::RealtimeBuffer<std::vector<double> > commands_buffer_;
+  unsigned int n_joints_;
+
+private:
+  typedef realtime_tools::RealtimePublisher<control_msgs::JointTrajectoryControllerState> StatePublisher;
+
+  int loop_count_;
+  ros::Subscriber sub_command_;
+  std::unique_ptr<StatePublisher> controller_state_publisher_;
+
+  controller_instrumentation::RealtimeAudit rt_audit_; /**< Audit of realtime-unsafe operations in update(). */
+
+  std::vector<control_toolbox::Pid> pid_controllers_;               /**< Internal PID controllers, holding the gains. */
+  forward_command_controller::PidGroup pid_group_;                  /**< PID state of all joints. */
+
+  /** Joint types and limits, flattened from the URDF in init() so that update() does not dereference it. */
+  forward_command_controller::JointPositionErrors<> position_errors_;
+
+  // Per joint scratch arrays of update(), allocated in init()
+  std::vector<double> positions_;
+  std::vector<double> command_positions_;
+  std::vector<double> errors_;
+  std::vector<double> velocities_;
+
+  void commandCB(const std_msgs::Float64MultiArrayConstPtr& msg);
+  void publishState(const ros::Time& time);
+}; // class
+
+} // namespace
+
+#endif
@@ -52,6 +52,8 @@ namespace velocity_controllers
  *
  * \param type Must be "JointGroupVelocityController".
  * \param joints List of names of the joints to control.
+ * \param command_limits/<joint>/max_acceleration Optional acceleration limit of \c <joint> [rad/s^2 or m/s^2].
+ * \param command_limits/<joint>/max_jerk Optional jerk limit of \c <joint> [rad/s^3 or m/s^3].
  *
  * Subscribes to:
  * - \b command (std_msgs::Float64MultiArray) : The joint velocities to apply
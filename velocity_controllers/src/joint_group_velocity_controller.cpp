@@ -42,7 +42,8 @@ template <class T>
 void forward_command_controller::ForwardJointGroupCommandController<T>::starting(const ros::Time& time)
 {
   // Start controller with 0.0 velocities
-  commands_buffer_.readFromRT()->assign(n_joints_, 0.0);
+  commands_buffer_.readFromRT()->data.assign(n_joints_, 0.0);
+  resetCommands(time);
 }
 
 
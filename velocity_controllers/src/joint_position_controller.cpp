@@ -41,13 +41,11 @@
 */
 
 #include <velocity_controllers/joint_position_controller.h>
-#include <angles/angles.h>
 #include <pluginlib/class_list_macros.hpp>
 
 namespace velocity_controllers {
 
 JointPositionController::JointPositionController()
-  : loop_count_(0)
 {}
 
 JointPositionController::~JointPositionController()
@@ -57,6 +55,10 @@ JointPositionController::~JointPositionController()
 
 bool JointPositionController::init(hardware_interface::VelocityJointInterface *robot, ros::NodeHandle &n)
 {
+  // Placement of the non-realtime threads, inherited by all threads created until the end of initialization
+  const auto thread_placement_scope = controller_instrumentation::ThreadPlacement::scopeFromParam(n);
+  if (!thread_placement_scope) {return false;}
+
   // Get joint name from parameter server
   std::string joint_name;
   if (!n.getParam("joint", joint_name))
@@ -70,8 +72,8 @@ bool JointPositionController::init(hardware_interface::VelocityJointInterface *r
     return false;
 
   // Start realtime state publisher
-  controller_state_publisher_.reset(
-    new realtime_tools::RealtimePublisher<control_msgs::JointControllerState>(n, "state", 1));
+  if (!state_publisher_.init(n, pid_controller_))
+    return false;
 
   // Start command subscriber
   sub_command_ = n.subscribe<std_msgs::Float64>("command", 1, &JointPositionController::setCommandCB, this);
@@ -92,6 +94,12 @@ bool JointPositionController::init(hardware_interface::VelocityJointInterface *r
     ROS_ERROR("Could not find joint '%s' in urdf", joint_name.c_str());
     return false;
   }
+  if (!position_error_.init(urdf, std::vector<std::string>(1, joint_name)))
+  {
+    return false;
+  }
+
+  rt_audit_.init(n);
 
   return true;
 }
@@ -151,10 +159,8 @@ void JointPositionController::setCommand(double pos_command, double vel_command)
 
 void JointPositionController::starting(const ros::Time& time)
 {
-  double pos_command = joint_.getPosition();
-
   // Make sure joint is within limits if applicable
-  enforceJointLimits(pos_command);
+  double pos_command = position_error_.clamp(0, joint_.getPosition());
 
   command_struct_.position_ = pos_command;
   command_struct_.has_velocity_ = false;
@@ -166,6 +172,8 @@ void JointPositionController::starting(const ros::Time& time)
 
 void JointPositionController::update(const ros::Time& time, const ros::Duration& period)
 {
+  controller_instrumentation::RealtimeAuditScope audit_scope(rt_audit_, time);
+
   command_struct_ = *(command_.readFromRT());
   double command_position = command_struct_.position_;
   double command_velocity = command_struct_.velocity_;
@@ -176,27 +184,8 @@ void JointPositionController::update(const ros::Time& time, const ros::Duration&
 
   double current_position = joint_.getPosition();
 
-  // Make sure joint is within limits if applicable
-  enforceJointLimits(command_position);
-
-  // Compute position error
-  if (joint_urdf_->type == urdf::Joint::REVOLUTE)
-  {
-   angles::shortest_angular_distance_with_limits(
-      current_position,
-      command_position,
-      joint_urdf_->limits->lower,
-      joint_urdf_->limits->upper,
-      error);
-  }
-  else if (joint_urdf_->type == urdf::Joint::CONTINUOUS)
-  {
-    error = angles::shortest_angular_distance(current_position, command_position);
-  }
-  else //prismatic
-  {
-    error = command_position - current_position;
-  }
+  // Make sure joint is within limits if applicable, and compute position error
+  position_error_.compute(&current_position, &command_position, &error);
 
   // Decide which of the two PID computeCommand() methods to call
   if (has_velocity_)
@@ -218,31 +207,15 @@ void JointPositionController::update(const ros::Time& time, const ros::Duration&
   joint_.setCommand(commanded_velocity);
 
   // publish state
-  if (loop_count_ % 10 == 0)
-  {
-    if(controller_state_publisher_ && controller_state_publisher_->trylock())
-    {
-      controller_state_publisher_->msg_.header.stamp = time;
-      controller_state_publisher_->msg_.set_point = command_position;
-      controller_state_publisher_->msg_.process_value = current_position;
-      controller_state_publisher_->msg_.process_value_dot = joint_.getVelocity();
-      controller_state_publisher_->msg_.error = error;
-      controller_state_publisher_->msg_.time_step = period.toSec();
-      controller_state_publisher_->msg_.command = commanded_velocity;
-
-      double dummy;
-      bool antiwindup;
-      getGains(controller_state_publisher_->msg_.p,
-        controller_state_publisher_->msg_.i,
-        controller_state_publisher_->msg_.d,
-        controller_state_publisher_->msg_.i_clamp,
-        dummy,
-        antiwindup);
-      controller_state_publisher_->msg_.antiwindup = static_cast<char>(antiwindup);
-      controller_state_publisher_->unlockAndPublish();
-    }
-  }
-  loop_count_++;
+  forward_command_controller::PidStatePublisher::State state;
+  state.stamp = time;
+  state.set_point = command_position;
+  state.process_value = current_position;
+  state.process_value_dot = joint_.getVelocity();
+  state.error = error;
+  state.time_step = period.toSec();
+  state.command = commanded_velocity;
+  state_publisher_.update(state);
 }
 
 void JointPositionController::setCommandCB(const std_msgs::Float64ConstPtr& msg)
@@ -250,23 +223,6 @@ void JointPositionController::setCommandCB(const std_msgs::Float64ConstPtr& msg)
   setCommand(msg->data);
 }
 
-// Note: we may want to remove this function once issue https://github.com/ros/angles/issues/2 is resolved
-void JointPositionController::enforceJointLimits(double &command)
-{
-  // Check that this joint has applicable limits
-  if (joint_urdf_->type == urdf::Joint::REVOLUTE || joint_urdf_->type == urdf::Joint::PRISMATIC)
-  {
-    if( command > joint_urdf_->limits->upper ) // above upper limnit
-    {
-      command = joint_urdf_->limits->upper;
-    }
-    else if( command < joint_urdf_->limits->lower ) // below lower limit
-    {
-      command = joint_urdf_->limits->lower;
-    }
-  }
-}
-
 } // namespace
 
 PLUGINLIB_EXPORT_CLASS( velocity_controllers::JointPositionController, controller_interface::ControllerBase)